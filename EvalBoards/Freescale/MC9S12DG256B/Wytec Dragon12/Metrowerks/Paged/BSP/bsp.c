@@ -41,6 +41,9 @@
 * Notes       : 1) RW is permanently pulled LOW in hardware. Under normal circumstances, 
 *                  it too should be declared below and referenced in the LCD Write functions
 *                  below.
+*               2) On boards that wire RW (to PORTK, bit 7 below), DISP_BUSY_FLAG_EN may be set in
+*                  app_cfg.h. uC/LCD then polls the busy flag through DispStatRd() and the data
+*                  strobes only need to meet the E pulse width.
 *********************************************************************************************************
 */
 
@@ -51,6 +54,42 @@
 #define  LCD_BIT_DATA1                       (INT8U)(1 <<  3)           /* LCD Screen bit D5 maps to PORTK, bit 3                   */   
 #define  LCD_BIT_DATA2                       (INT8U)(1 <<  4)			/* LCD Screen bit D6 maps to PORTK, bit 4                   */   
 #define  LCD_BIT_DATA3                       (INT8U)(1 <<  5)    	    /* LCD Screen bit D7 maps to PORTK, bit 5                   */
+#define  LCD_BIT_RW                          (INT8U)(1 <<  7)           /* LCD Screen bit RW maps to PORTK, bit 7 (if wired)        */
+#define  LCD_DATA_MASK                       (INT8U)(LCD_BIT_DATA0 | LCD_BIT_DATA1 | LCD_BIT_DATA2 | LCD_BIT_DATA3)
+
+#if (DISP_BUSY_FLAG_EN > 0)
+#define  LCD_STROBE_US                               1                  /* E pulse only, uC/LCD polls the busy flag afterwards      */
+#else
+#define  LCD_STROBE_US                             100                  /* Also covers the execution time of most instructions      */
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                 PRECISION DELAY CONSTANT DATA
+*********************************************************************************************************
+*/
+
+#define  BSP_DLY_OC_MASK                     (INT8U)(1 << BSP_DLY_OC)   /* TIOS, TIE and TFLG1 bit of the delay channel             */
+#define  BSP_DLY_CHUNK_CNTS                  (INT16U)0x8000             /* Max. counts per compare, well inside the 16 bit TCNT     */
+
+#if   BSP_DLY_OC == 0
+#define  BSP_DLY_TC                          TC0
+#elif BSP_DLY_OC == 1
+#define  BSP_DLY_TC                          TC1
+#elif BSP_DLY_OC == 2
+#define  BSP_DLY_TC                          TC2
+#elif BSP_DLY_OC == 3
+#define  BSP_DLY_TC                          TC3
+#elif BSP_DLY_OC == 4
+#define  BSP_DLY_TC                          TC4
+#elif BSP_DLY_OC == 5
+#define  BSP_DLY_TC                          TC5
+#elif BSP_DLY_OC == 6
+#define  BSP_DLY_TC                          TC6
+#else
+#define  BSP_DLY_TC                          TC7
+#endif
 
 
 /*
@@ -61,6 +100,11 @@
 
 static  INT16U  OSTickCnts;			                                    /* Holds the number of timer increments for the OS Ticker   */  
 
+static  INT16U     BSP_DlyCntsPerUS;                                    /* TCNT increments per microsecond                          */
+static  INT32U     BSP_DlyCntsRem;                                      /* Counts left in the current one-shot delay                */
+static  OS_EVENT  *BSP_DlyLock;                                         /* Guards the single delay Output Compare channel           */
+static  OS_EVENT  *BSP_DlySem;                                          /* Signaled by BSP_DlyISR_Handler() when the delay expires  */
+
 
 /*
 *********************************************************************************************************
@@ -73,6 +117,8 @@ static  void     OSTickISR_Init(void);                                  /* Initi
 static  void     LED_Init(void);                                        /* Initialize the LED hardware                              */
 static  void     Sw_Init(void);                                         /* Initialize Switch hardware                               */
 static  void     BSP_SetECT_Prescaler(INT8U prescaler);                 /* Initialize the ECT Prescaler                             */
+static  void     BSP_DlyInit(void);                                     /* Initialize the precision delay service                   */
+static  void     BSP_DlyBusy(INT32U cnts);                              /* Busy-wait a number of TCNT counts                        */
 
 
 /*
@@ -88,10 +134,11 @@ void BSP_Init (void)
 {
 #if PLL_EN > 0
     PLL_Init();                                                         /* Initialize the PLL. This must come before CalcPrescaler  */
-    BSP_SetECT_Prescaler(4);                                            /* When using the PLL, an ECT prescaler > 4 MUST be set in  */    
+    BSP_SetECT_Prescaler(BSP_ECT_PRESCALER);                            /* When using the PLL, an ECT prescaler > 4 MUST be set in  */    
 #endif                                                                  /* order to prevent OSTickCnts overflow during Tick Init    */ 
     
     OSTickISR_Init();
+    BSP_DlyInit();                                                      /* Must follow OSTickISR_Init(), which starts TCNT          */
     LED_Init();   
 }
 
@@ -252,6 +299,181 @@ void  BSP_DlyMS (INT8U ms)
 }
 
 
+/*
+*********************************************************************************************************
+*                                 BSP PRECISION DELAY INITIALIZATION
+*
+* Description : This function derives the TCNT rate from the bus clock and ECT prescaler, creates the
+*               kernel objects used by BSP_DlyUS() and makes BSP_DLY_OC an output compare channel.
+*               The channel interrupt stays disabled until a delay needs it.
+*
+* Callers     : BSP_Init()
+*
+* Notes       : 1) THE BSP_DLY_OC ISR VECTOR MUST BE SET TO BSP_DlyISR WITHIN VECTORS.C.
+*               2) bsp.h rejects a clock setup that does not give a whole number of TCNT increments per
+*                  uS.  Should the prescaler be changed at run time, e.g. 16 at a 24 MHz bus (1.5 per uS),
+*                  the count is rounded up: truncating it would make every delay 33% short.
+*********************************************************************************************************
+*/
+
+static  void  BSP_DlyInit (void)
+{
+    INT32U  bus_frq;
+    INT8U   ECT_Prescaler;
+
+
+    bus_frq          = BSP_CPU_ClkFreq() / 2;                           /* Derive the BUS frequency from the CPU frequency          */
+    ECT_Prescaler    = (1 << (TSCR2 & 0x07));                           /* Calculate the correct prescaler value from the reg val   */
+    BSP_DlyCntsPerUS = (INT16U)((bus_frq + (INT32U)ECT_Prescaler * 1000000L - 1)
+                     / ((INT32U)ECT_Prescaler * 1000000L));             /* Round up, a delay may be long but never short (Note #2)  */
+
+    BSP_DlyLock      = OSSemCreate(1);
+    BSP_DlySem       = OSSemCreate(0);
+
+    TIE             &= ~BSP_DLY_OC_MASK;                                /* Keep the channel interrupt off until a delay is started  */
+    TIOS            |=  BSP_DLY_OC_MASK;                                /* Make channel an output compare                           */
+}
+
+
+/*
+*********************************************************************************************************
+*                                 BSP PRECISION DELAY (Microseconds)
+*
+* Description : This function delays the calling task for at least 'us' microseconds, timed by the ECT
+*               free running counter (TCNT) rather than the OS tick.
+*
+*               (1) Delays of up to BSP_DLY_BUSY_MAX_US spin on TCNT. These are the bus strobe and
+*                   settle times of the LCD, keypad and EEPROM drivers, which are far shorter than a
+*                   tick and shorter than the cost of two context switches.
+*
+*               (2) Longer delays program a one-shot on BSP_DLY_OC and pend on a semaphore, so the CPU
+*                   is given to other tasks. Delays longer than the 16 bit TCNT range are split into
+*                   BSP_DLY_CHUNK_CNTS compares by the ISR.
+*
+* Arguments   : us      is the number of microseconds to delay.
+*
+* Callers     : DispDly_uS(), KeypadReadPort(), EEPROM driver and application code.
+*
+* Notes       : 1) BSP_Init() must have been called.
+*               2) From an ISR, before multitasking has started or while the scheduler is locked, the
+*                  delay always busy-waits.
+*               3) While another task owns the one-shot channel, a long delay falls back to OSTimeDly()
+*                  rounded up to the next tick, so it never ends early.
+*********************************************************************************************************
+*/
+
+void  BSP_DlyUS (INT32U us)
+{
+    INT32U  cnts;
+    INT16U  chunk;
+    INT16U  ticks;
+    INT8U   err;
+#if OS_CRITICAL_METHOD == 3
+    OS_CPU_SR  cpu_sr = 0;
+#endif
+
+
+    if (us == 0) {
+        return;
+    }
+
+    cnts = us * BSP_DlyCntsPerUS;
+
+    if ((us          <= BSP_DLY_BUSY_MAX_US) ||                         /* Short delay, or not allowed to pend                      */
+        (OSRunning   == OS_FALSE)            ||
+        (OSIntNesting > 0)                   ||
+        (OSLockNesting > 0)) {
+        BSP_DlyBusy(cnts);
+        return;
+    }
+
+    ticks = (INT16U)(us / (1000000L / OS_TICKS_PER_SEC) + 1);
+    if (OSSemAccept(BSP_DlyLock) == 0) {                                /* Channel in use by another task, use the OS tick instead  */
+        OSTimeDly(ticks);
+        return;
+    }
+
+    chunk          = (cnts > BSP_DLY_CHUNK_CNTS) ? BSP_DLY_CHUNK_CNTS : (INT16U)cnts;
+    OS_ENTER_CRITICAL();
+    BSP_DlyCntsRem = cnts - chunk;
+    BSP_DLY_TC     = TCNT + chunk;                                      /* Set the compare to present time + first chunk            */
+    TFLG1          = BSP_DLY_OC_MASK;                                   /* Clear a stale flag, writing 1 clears only this channel   */
+    TIE           |= BSP_DLY_OC_MASK;                                   /* Enable the delay channel interrupt                       */
+    OS_EXIT_CRITICAL();
+
+    OSSemPend(BSP_DlySem, ticks + 1, &err);                             /* Timeout only guards against a missing vector             */
+    if (err != OS_ERR_NONE) {
+        OS_ENTER_CRITICAL();
+        TIE       &= ~BSP_DLY_OC_MASK;
+        OS_EXIT_CRITICAL();
+        (void)OSSemAccept(BSP_DlySem);                                  /* Discard a post that raced with the timeout               */
+    }
+
+    (void)OSSemPost(BSP_DlyLock);
+}
+
+
+/*
+*********************************************************************************************************
+*                                 BSP PRECISION DELAY BUSY-WAIT
+*
+* Description : This function spins until 'cnts' TCNT increments have elapsed. The wait is split into
+*               chunks so that each comparison stays well within the 16 bit wrap of the counter.
+*
+* Arguments   : cnts    is the number of TCNT increments to wait.
+*
+* Callers     : BSP_DlyUS()
+*********************************************************************************************************
+*/
+
+static  void  BSP_DlyBusy (INT32U cnts)
+{
+    INT16U  start;
+    INT16U  chunk;
+
+
+    start = TCNT;
+    while (cnts > 0) {
+        chunk = (cnts > BSP_DLY_CHUNK_CNTS) ? BSP_DLY_CHUNK_CNTS : (INT16U)cnts;
+        while ((INT16U)(TCNT - start) < chunk) {                        /* Unsigned difference is immune to TCNT wrap around        */
+            ;
+        }
+        start += chunk;
+        cnts  -= chunk;
+    }
+}
+
+
+/*
+*********************************************************************************************************
+*                                 BSP PRECISION DELAY ISR HANDLER
+*
+* Description : This function is called by BSP_DlyISR() (located in bsp_isr.s) when the delay output
+*               compare matches. It re-arms the channel for the next chunk of a long delay, or disables
+*               the channel and readies the waiting task.
+*
+* Arguments   : none
+*********************************************************************************************************
+*/
+
+void  BSP_DlyISR_Handler (void)
+{
+    INT16U  chunk;
+
+
+    TFLG1 = BSP_DLY_OC_MASK;                                            /* Clear interrupt, writing 1 clears only this channel      */
+
+    if (BSP_DlyCntsRem > 0) {
+        chunk           = (BSP_DlyCntsRem > BSP_DLY_CHUNK_CNTS) ? BSP_DLY_CHUNK_CNTS : (INT16U)BSP_DlyCntsRem;
+        BSP_DlyCntsRem -= chunk;
+        BSP_DLY_TC     += chunk;                                        /* Set the compare to the end of the next chunk             */
+    } else {
+        TIE            &= ~BSP_DLY_OC_MASK;                             /* One-shot, disable the channel interrupt                  */
+        (void)OSSemPost(BSP_DlySem);
+    }
+}
+
+
 /*
 *********************************************************************************************************
 *                                     uC/OS-II TICK ISR INITIALIZATION
@@ -356,42 +578,42 @@ static void  OSTickISR_Init (void)
 void  OSTickISR_Handler (void)
 {
 #if OS_TICK_OC == 0
-    TFLG1 |= 0x01;                                                      /* Clear interrupt                                          */
+    TFLG1  = 0x01;                                                      /* Clear interrupt, writing 1 clears only this channel      */
     TC0   += OSTickCnts;                                                /* Set TC0 to present time + OS_TICK_OC_CNTS                */
 #endif
 
 #if OS_TICK_OC == 1 
-    TFLG1 |= 0x02;                                                      /* Clear interrupt                                          */
+    TFLG1  = 0x02;                                                      /* Clear interrupt, writing 1 clears only this channel      */
     TC1   += OSTickCnts;                                                /* Set TC1 to present time + OS_TICK_OC_CNTS                */
 #endif
 
 #if OS_TICK_OC == 2
-    TFLG1 |= 0x04;                                                      /* Clear interrupt                                          */
+    TFLG1  = 0x04;                                                      /* Clear interrupt, writing 1 clears only this channel      */
     TC2   += OSTickCnts;                                                /* Set TC2 to present time + OS_TICK_OC_CNTS                */
 #endif
 
 #if OS_TICK_OC == 3
-    TFLG1 |= 0x08;                                                      /* Clear interrupt                                          */
+    TFLG1  = 0x08;                                                      /* Clear interrupt, writing 1 clears only this channel      */
     TC3   += OSTickCnts;                                                /* Set TC3 to present time + OS_TICK_OC_CNTS                */
 #endif
 
 #if OS_TICK_OC == 4
-    TFLG1 |= 0x10;                                                      /* Clear interrupt                                          */
+    TFLG1  = 0x10;                                                      /* Clear interrupt, writing 1 clears only this channel      */
     TC4   += OSTickCnts;                                                /* Set TC4 to present time + OS_TICK_OC_CNTS                */
 #endif
 
 #if OS_TICK_OC == 5
-    TFLG1 |= 0x20;                                                      /* Clear interrupt                                          */
+    TFLG1  = 0x20;                                                      /* Clear interrupt, writing 1 clears only this channel      */
     TC5   += OSTickCnts;                                                /* Set TC5 to present time + OS_TICK_OC_CNTS                */
 #endif
 
 #if OS_TICK_OC == 6
-    TFLG1 |= 0x40;                                                      /* Clear interrupt                                          */
+    TFLG1  = 0x40;                                                      /* Clear interrupt, writing 1 clears only this channel      */
     TC6   += OSTickCnts;                                                /* Set TC6 to present time + OS_TICK_OC_CNTS                */
 #endif
 
 #if OS_TICK_OC == 7
-    TFLG1 |= 0x80;                                                      /* Clear interrupt                                          */
+    TFLG1  = 0x80;                                                      /* Clear interrupt, writing 1 clears only this channel      */
     TC7   += OSTickCnts;                                                /* Set TC7 to present time + OS_TICK_OC_CNTS                */
 #endif
 
@@ -478,6 +700,10 @@ void DispInitPort (void)
 {                                                                       
     DDRK |= LCD_BIT_RS    | LCD_BIT_E     | LCD_BIT_DATA0 |             /* Setup RS, E and Data bit 0 lines as outputs              */
             LCD_BIT_DATA1 | LCD_BIT_DATA2 | LCD_BIT_DATA3;				/* Setup the Data Lines 1, 2, 3 as outputs                  */
+#if (DISP_BUSY_FLAG_EN > 0)
+    PORTK &= ~LCD_BIT_RW;                                               /* RW LOW selects a write                                   */
+    DDRK  |=  LCD_BIT_RW;                                               /* Setup RW as an output                                    */
+#endif
 }
 #endif
 
@@ -531,13 +757,13 @@ void DispDataWr (INT8U data)
     PORTK &=    LCD_BIT_RS;                                             /* Clear all PORTK data bits, RW = 0, preserve RS           */
     PORTK |= (((data >> 4) & 0x0F) << LCD_LOWEST_DATA_BIT);             /* Write the UPPER nibble of data to D7..D4               */ 
     PORTK |=    LCD_BIT_E;                                              /* Set the E control line HIGH                              */
-    DispDly_uS(100);                                                    /* Delay for about 100 uS                                   */
+    DispDly_uS(LCD_STROBE_US);                                          /* Delay for the E pulse (and execution time)               */
     PORTK &=   ~LCD_BIT_E;                                              /* Set the E control line LOW                               */
-    DispDly_uS(100);                                                    /* Delay for about 100 uS                                   */
+    DispDly_uS(LCD_STROBE_US);                                          /* Delay for the E pulse (and execution time)               */
     PORTK &=    LCD_BIT_RS;                                             /* Clear all PORTK data bits, RW = 0, preserve RS           */
     PORTK |=  ((data & 0x0F)       << LCD_LOWEST_DATA_BIT);             /* Write the LOWER nibble of data to D7..D4               */
     PORTK |=    LCD_BIT_E;                                              /* Set the E control line HIGH                              */
-    DispDly_uS(100);                                                    /* Delay for about 100 uS                                   */    
+    DispDly_uS(LCD_STROBE_US);                                          /* Delay for the E pulse (and execution time)               */    
     PORTK &=   ~LCD_BIT_E;                                              /* Set the E control line LOW                               */
 }
 #endif
@@ -573,6 +799,52 @@ void  DispDataWrOneNibble (INT8U data)
 #endif
 
 
+/*
+*********************************************************************************************************
+*                                 uC/LCD Display Status Read
+*
+* Description : DispStatRd() reads the HD44780 busy flag and address counter in two nibbles. RS is 
+*               driven LOW for the read and restored afterwards, so the register selected by DispSel()
+*               is preserved.
+*
+* Arguments   : None
+*
+* Returns     : The busy flag in bit 7 and the address counter in bits 6..0.
+*
+* Callers     : DispRdyWait() from lcd.c
+*
+* Notes       : 1) Only available when RW is wired to the MCU and DISP_BUSY_FLAG_EN is set.
+*********************************************************************************************************
+*/
+#if (uC_LCD_MODULE > 0) && (DISP_BUSY_FLAG_EN > 0)
+INT8U  DispStatRd (void)
+{
+    INT8U  rs;
+    INT8U  stat;
+
+
+    rs     =    PORTK & LCD_BIT_RS;                                     /* Save RS, the status is read with RS LOW                  */
+    DDRK  &=   ~LCD_DATA_MASK;                                          /* Release D7..D4 so the LCD can drive them                 */
+    PORTK &=  ~(LCD_BIT_RS | LCD_BIT_E);                                /* Select the instruction register                          */
+    PORTK |=    LCD_BIT_RW;                                             /* Set the RW control line HIGH to read                     */
+    PORTK |=    LCD_BIT_E;                                              /* Set the E control line HIGH                              */
+    DispDly_uS(1);                                                      /* Wait for the data delay time                             */
+    stat   =  ((PORTK & LCD_DATA_MASK) >> LCD_LOWEST_DATA_BIT) << 4;    /* Read the UPPER nibble: busy flag and AC6..AC4            */
+    PORTK &=   ~LCD_BIT_E;                                              /* Set the E control line LOW                               */
+    DispDly_uS(1);
+    PORTK |=    LCD_BIT_E;                                              /* Set the E control line HIGH                              */
+    DispDly_uS(1);                                                      /* Wait for the data delay time                             */
+    stat  |=   (PORTK & LCD_DATA_MASK) >> LCD_LOWEST_DATA_BIT;          /* Read the LOWER nibble: AC3..AC0                          */
+    PORTK &=   ~LCD_BIT_E;                                              /* Set the E control line LOW                               */
+    PORTK &=   ~LCD_BIT_RW;                                             /* Back to write                                            */
+    DDRK  |=    LCD_DATA_MASK;                                          /* Drive D7..D4 again                                       */
+    PORTK |=    rs;                                                     /* Restore RS                                               */
+
+    return (stat);
+}
+#endif
+
+
 /*
 *********************************************************************************************************
 *                                 uC/LCD Delay Functionality
@@ -585,18 +857,15 @@ void  DispDataWrOneNibble (INT8U data)
 * Arguments   : us determines the amount of delay (in microseconds)
 *
 * Callers     : lcd.c: DispInit(), DispClrScr()
+*
+* Notes       : 1) Delays are timed by BSP_DlyUS() from the ECT free running counter. Strobe delays
+*                  busy-wait for the requested time instead of sleeping for one or two OS ticks.
 *********************************************************************************************************
 */
 #if (uC_LCD_MODULE > 0)
 void DispDly_uS (INT32U us)
 {
-    INT32U  us_per_tick;
-    INT32U  ticks;
-							
-
-    us_per_tick =  1000000L / OS_TICKS_PER_SEC;
-    ticks       =  us / us_per_tick + 1;
-    OSTimeDly(ticks); 
+    BSP_DlyUS(us);
 }
 #endif
 
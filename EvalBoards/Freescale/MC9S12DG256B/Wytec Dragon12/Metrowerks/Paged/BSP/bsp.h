@@ -29,6 +29,8 @@ void     LED_Off(INT8U led);
 void     LED_On(INT8U led);
 void     LED_Toggle(INT8U led);
 void     BSP_DlyMS(INT8U ms);
+void     BSP_DlyUS(INT32U us);
+void     BSP_DlyISR_Handler(void);
 
 INT32U   BSP_CPU_ClkFreq(void);
 
@@ -46,6 +48,17 @@ INT32U   BSP_CPU_ClkFreq(void);
 #define  OS_TICK_OC                  7        /* ECT Output Compare channel # used to generate OS Tick   */
                                               /* Must be configured between 0-7 depending on derivative  */
                                               
+/*-----------------------------------------------------*/
+/*                 PRECISION DELAY SETUP               */
+/*-----------------------------------------------------*/                    
+
+#define  BSP_DLY_OC                  6        /* ECT Output Compare channel # used by BSP_DlyUS() to     */
+                                              /* wake the calling task. Must differ from OS_TICK_OC and  */
+                                              /* SEVEN_SEG_OC. The vector must be set in vectors.c.      */
+
+#define  BSP_DLY_BUSY_MAX_US       250        /* Delays up to this many uS busy-wait on TCNT. Longer     */
+                                              /* delays pend on an Output Compare one-shot instead.      */
+
 /*-----------------------------------------------------*/
 /*                   SYSTEM CLOCK SETUP                */
 /*-----------------------------------------------------*/                    
@@ -71,6 +84,12 @@ INT32U   BSP_CPU_ClkFreq(void);
 #define  BUS_CLK_FREQ         (PLLCLK  / 2)   /* BUSCLK = PLLCLK / 2                                     */
 #endif
 
+#if PLL_EN == 0
+#define  BSP_ECT_PRESCALER           1        /* ECT prescaler out of reset.                             */
+#else
+#define  BSP_ECT_PRESCALER           4        /* ECT prescaler set by BSP_Init(), see bsp.c              */
+#endif
+
 
 /*
 *********************************************************************************************************
@@ -113,6 +132,24 @@ INT32U   BSP_CPU_ClkFreq(void);
 #error "OS_TICK_OC is illegally defined in bsp.h. Expected valued between 0-7."
 #endif
 
+#if    (BSP_DLY_OC < 0) || (BSP_DLY_OC > 7)
+#error "BSP_DLY_OC is illegally defined in bsp.h. Expected valued between 0-7."
+#endif
+
+#if   ((BUS_CLK_FREQ / BSP_ECT_PRESCALER) % 1000000L) != 0
+#error "BUS_CLK_FREQ / BSP_ECT_PRESCALER must be a whole number of MHz, BSP_DlyUS() counts whole TCNT increments per uS."
+#endif
+
+#if    (BSP_DLY_OC == OS_TICK_OC)
+#error "BSP_DLY_OC must not be defined the same as OS_TICK_OC in bsp.h."
+#endif
+
+#ifdef  SEVEN_SEG_OC
+#if    (BSP_DLY_OC == SEVEN_SEG_OC)
+#error "BSP_DLY_OC must not be defined the same as SEVEN_SEG_OC in app_cfg.h."
+#endif
+#endif
+
 
 #endif
 
@@ -0,0 +1,74 @@
+;
+;********************************************************************************************************
+;                                     BSP PRECISION DELAY ISR
+; 
+;                                        Freescale MC9S12
+;                                       Wytec Dragon12 EVB
+;
+; File         : bsp_isr.s
+;
+; Description  : This file contains the ISR for the BSP_DlyUS() output compare one-shot.
+;                The ISR informs the operating system of the interrupt, and calls
+;                BSP_DlyISR_Handler() in bsp.c to re-arm the channel or ready the
+;                delayed task.
+;
+; Notes        : 1) THIS FILE *MUST* BE LINKED INTO NON_BANKED MEMORY!
+;********************************************************************************************************
+
+NON_BANKED:       section
+  
+;********************************************************************************************************
+;                                           I/O PORT ADDRESSES
+;********************************************************************************************************
+
+PPAGE:            equ    $0030         ; Addres of PPAGE register (assuming MC9S12 (non XGATE part)
+
+;********************************************************************************************************
+;                                          PUBLIC DECLARATIONS
+;********************************************************************************************************
+
+    xdef   BSP_DlyISR   
+    
+;********************************************************************************************************
+;                                         EXTERNAL DECLARATIONS
+;********************************************************************************************************
+   
+    xref   OSIntExit
+    xref   OSIntNesting  
+    xref   OSTCBCur     
+    xref   BSP_DlyISR_Handler 
+
+
+;********************************************************************************************************
+;                                       Precision Delay ISR
+;
+; Description : This routine is the ISR for the BSP_DLY_OC output compare channel. It is modeled
+;               exactly like SevenSegDisp_ISR in sevenSegment.s.
+;
+; Arguments   : none
+;********************************************************************************************************
+
+BSP_DlyISR:
+    ldaa   PPAGE                       ;  Get current value of PPAGE register                                
+    psha                               ;  Push PPAGE register onto current task's stack
+
+    inc    OSIntNesting                ;  Notify uC/OS-II about ISR
+
+    ldab   OSIntNesting                ;  if (OSIntNesting == 1) {    
+    cmpb   #$01                        ;  
+    bne    BSP_DlyISR1                 ;  
+
+    ldy    OSTCBCur                    ;      OSTCBCur->OSTCBStkPtr = Stack Pointer     
+    sts    0,y                         ;  }                                          
+
+BSP_DlyISR1:
+    call   BSP_DlyISR_Handler          ;  Call the Precision Delay ISR Handler in bsp.c
+
+    cli                                ;  Enable interrupts to allow interrupt nesting
+       
+    call   OSIntExit                   ;  Notify uC/OS-II about end of ISR
+    
+    pula                               ;  Get value of PPAGE register
+    staa   PPAGE                       ;  Store into CPU's PPAGE register                                
+        
+    rti                                ;  Return from interrupt, no higher priority tasks ready.
@@ -38,6 +38,8 @@
 #define  KEYPAD_IN_MASK               (INT8U)(KEYPAD_COL_0 | KEYPAD_COL_1 | KEYPAD_COL_2 | KEYPAD_COL_3)
 #define  KEYPAD_OUT_MASK              (INT8U)(KEYPAD_ROW_0 | KEYPAD_ROW_1 | KEYPAD_ROW_2 | KEYPAD_ROW_3)
 
+#define  KEYPAD_SETTLE_US                      2                        /* Time for a column to follow a driven row via pull-ups    */
+
 /*
 *********************************************************************************************************
 *                                 Keypad Hardware Initialization
@@ -110,6 +112,7 @@ INT8U  KeypadReadPort (void)
     for (row = 0; row < 4; row++) {                                     /* Start scanning from row 0.                               */
         PORTA   =   KEYPAD_OUT_MASK;                                    /* Initialize all rows to non-active (set HIGH).            */
         PORTA  &= ~(KEYPAD_ROW_0 << row);                               /* Clear the pin of the desired row to scan.                */
+        BSP_DlyUS(KEYPAD_SETTLE_US);                                    /* Let the column inputs settle before sampling them.       */
         for (col = 0; col < 4; col++) {                                 /* Scan the columns from left to right.                     */
             input = (PORTA & KEYPAD_IN_MASK);                           /* Read PORTA and ignore the value of the output pins       */
             if ((input & (1 << col)) == 0) {                            /* If a col bit is found low, then the key is pressed       */
@@ -32,6 +32,8 @@
 *********************************************************************************************************
 */
 
+#define  NVM_EEPROM_POLL_US          20                                 /* Poll period while the access controller is busy          */
+
 /*
 *********************************************************************************************************
 *                                        EEPROM INITIALIZATION
@@ -86,7 +88,7 @@ void  EEPROM_Init (INT32U sysclk)
 INT8S  EEPROM_Write_Word (INT16U address, INT16U data)
 {
     while (!ESTAT_CBEIF) {                                              /* Wait for EEPROM access controller to become ready        */
-        ;
+        BSP_DlyUS(NVM_EEPROM_POLL_US);
     }
     
     ESTAT = (ESTAT_ACCERR_MASK | ESTAT_PVIOL_MASK);                     /* Clear existing error flags                               */
@@ -124,14 +126,15 @@ INT8S  EEPROM_Write_Word (INT16U address, INT16U data)
 *               NVM_ACCESS_ERR       - EEPROM Write Error, Access Violation
 *               NVM_PROTECTION_ERR   - EEPROM Write Error, Attempted to write a protected sector
 *
-* Notes       : None.
+* Notes       : 1) Returns as soon as the erase has been launched. The erase itself completes in the
+*                  background, the next EEPROM access waits for the access controller (CBEIF).
 *********************************************************************************************************
 */
 
 INT8S  EEPROM_Erase_Sector (INT16U address)
 {
     while (!ESTAT_CBEIF) {                                              /* Wait for EEPROM access controller to become ready        */
-        ;
+        BSP_DlyUS(NVM_EEPROM_POLL_US);
     }
     
     ESTAT = (ESTAT_ACCERR_MASK | ESTAT_PVIOL_MASK);                     /* Clear existing error flags                               */
@@ -176,7 +179,7 @@ INT16U  EEPROM_Read_Word (INT16U address)
     
     
     while (!ESTAT_CBEIF) {                                              /* Wait for EEPROM access controller to become ready        */
-        ;
+        BSP_DlyUS(NVM_EEPROM_POLL_US);
     }
 	
 	data = (*(INT16U *)address);                                        /* Read the data at location 'address'                      */
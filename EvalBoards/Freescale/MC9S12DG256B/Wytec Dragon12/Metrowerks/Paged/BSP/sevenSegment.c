@@ -34,11 +34,59 @@
 #define  SSD_8  0x7F                                                    /* Seven segment display, character '8'                     */
 #define  SSD_9  0x6F                                                    /* Seven segment display, character '9'                     */
 #define  SSD_A  0x77                                                    /* Seven segment display, character 'A'                     */
-#define  SSD_B  0x7F                                                    /* Seven segment display, character 'B'                     */
+#define  SSD_B  0x7C                                                    /* Seven segment display, character 'b'                     */
 #define  SSD_C  0x39                                                    /* Seven segment display, character 'C'                     */
-#define  SSD_D  0x5E                                                    /* Seven segment display, character 'D'                     */
-#define  SSD_E  0x59                                                    /* Seven segment display, character 'E'                     */
+#define  SSD_D  0x5E                                                    /* Seven segment display, character 'd'                     */
+#define  SSD_E  0x79                                                    /* Seven segment display, character 'E'                     */
 #define  SSD_F  0x71                                                    /* Seven segment display, character 'F'                     */
+#define  SSD_DP 0x80                                                    /* Seven segment display, decimal point                     */
+#define  SSD_MINUS  0x40                                                /* Seven segment display, character '-'                     */
+
+#define  SEVEN_SEG_NBR_DIG          4                                   /* Number of 7-Segment LED blocks on the Dragon12           */
+#define  SEVEN_SEG_DIG_MASK      0x0F                                   /* PTP bits that enable the LED blocks, active LOW          */
+#define  SEVEN_SEG_OC_MASK      (INT8U)(1 << SEVEN_SEG_OC)              /* TIOS, TIE and TFLG1 bit of the multiplexing channel      */
+#define  SEVEN_SEG_PHASE_MIN_US   50                                    /* Shortest on or off phase, longer than the ISR latency    */
+
+#if   SEVEN_SEG_OC == 0
+#define  SEVEN_SEG_TC           TC0
+#elif SEVEN_SEG_OC == 1
+#define  SEVEN_SEG_TC           TC1
+#elif SEVEN_SEG_OC == 2
+#define  SEVEN_SEG_TC           TC2
+#elif SEVEN_SEG_OC == 3
+#define  SEVEN_SEG_TC           TC3
+#elif SEVEN_SEG_OC == 4
+#define  SEVEN_SEG_TC           TC4
+#elif SEVEN_SEG_OC == 5
+#define  SEVEN_SEG_TC           TC5
+#elif SEVEN_SEG_OC == 6
+#define  SEVEN_SEG_TC           TC6
+#else
+#define  SEVEN_SEG_TC           TC7
+#endif
+
+#if     (SEVEN_SEG_REFRESH_HZ < 1)
+#error "SEVEN_SEG_REFRESH_HZ is illegally defined in app_cfg.h. Expected value: 1 or more"
+#endif
+                                                                        /* One LED block slot, nbrCnts + 1, must fit the 16-bit TC  */
+#if    ((BUS_CLK_FREQ / (BSP_ECT_PRESCALER * SEVEN_SEG_NBR_DIG * SEVEN_SEG_REFRESH_HZ)) > 65536L)
+#error "SEVEN_SEG_REFRESH_HZ too low in app_cfg.h: a LED block slot overflows the 16-bit output compare (nbrCnts)."
+#endif
+
+#define  SEVEN_SEG_GLYPH_FIRST   ' '                                    /* First and last character in glyphTbl[]                  */
+#define  SEVEN_SEG_GLYPH_LAST    '_'
+
+static  const  INT8U  glyphTbl[] = {                                    /* Segment pattern of each character, 0x00 = not shown      */
+    0x00,      0x00,      0x22,      0x00,      0x00,      0x00,      0x00,      0x02,       /*    ! " # $ % & '   */
+    0x39,      0x0F,      0x00,      0x00,      0x00,      SSD_MINUS, SSD_DP,    0x00,       /*  ( ) * + , - . /   */
+    SSD_0,     SSD_1,     SSD_2,     SSD_3,     SSD_4,     SSD_5,     SSD_6,     SSD_7,      /*  0 1 2 3 4 5 6 7   */
+    SSD_8,     SSD_9,     0x00,      0x00,      0x00,      0x48,      0x00,      0x53,       /*  8 9 : ; < = > ?   */
+    0x00,      SSD_A,     SSD_B,     SSD_C,     SSD_D,     SSD_E,     SSD_F,     0x3D,       /*  @ A b C d E F G   */
+    0x76,      0x06,      0x1E,      0x00,      0x38,      0x00,      0x54,      0x3F,       /*  H I J K L M n O   */
+    0x73,      0x67,      0x50,      0x6D,      0x78,      0x3E,      0x00,      0x00,       /*  P q r S t U V W   */
+    0x00,      0x6E,      0x5B,      0x39,      0x00,      0x0F,      0x00,      0x08        /*  X y Z [ \ ] ^ _   */
+};
+
 
 /*
 *********************************************************************************************************
@@ -46,9 +94,19 @@
 *********************************************************************************************************
 */
 
-static  INT16U  nbrCnts;                                                /* Holds the number of timer increments for the 7-Seg Disp  */
-static  INT16U  outputNum;                                              /* Holds the number between 0000 and 9999 to be displayed   */
+static  INT16U  nbrCnts;                                                /* Holds the number of timer increments per LED block slot  */
+static  INT16U  onCnts;                                                 /* Part of the slot the LED block is lit, sets brightness   */
+static  INT16U  offCnts;                                                /* Dark part of the current slot                            */
+static  INT16U  minCnts;                                                /* Timer increments in SEVEN_SEG_PHASE_MIN_US               */
+static  INT8U   segPat[2][SEVEN_SEG_NBR_DIG];                           /* Double buffered segment patterns, most significant first */
+static  INT8U   segPatIx;                                               /* Index of the buffer displayed by the ISR                 */
 static  INT8U   actBlockNum;                                            /* Holds the number of the active 7-Segment LED Block (0-3) */
+static  INT8U   offPhase;                                               /* DEF_TRUE when the next interrupt ends the lit phase      */
+static  INT8U   dpMask;                                                 /* Decimal points shown by the numeric writes, see DPSet()  */
+
+#if SEVEN_SEG_ISR_TIME_EN > 0
+        INT16U  SevenSegISRCntsMax;                                     /* Longest SevenSegDisp_ISR_Handler() run, in TCNT counts   */
+#endif
 
 
 /*
@@ -57,7 +115,8 @@ static  INT8U   actBlockNum;                                            /* Holds
 *********************************************************************************************************
 */
 
-static  void     SevenSegOut(INT8U digit);                              /* Internal function for writing to the 7-Seg Disp data bus */
+static  INT8U    SevenSegGlyph(CPU_CHAR c);                             /* Internal function, segment pattern of a character        */
+static  void     SevenSegPatSet(INT8U *pat, INT8U dp);                  /* Internal function, hands new patterns to the ISR         */
 
 
 /*
@@ -77,6 +136,9 @@ static  void     SevenSegOut(INT8U digit);                              /* Inter
 *               This involves plugging the right vector number with the name of
 *               the ISR function below. A prototype at the top of vectors.c must
 *               also be created.
+*
+*               Each LED block is lit for 1 / (4 * SEVEN_SEG_REFRESH_HZ) seconds per refresh, less
+*               the dark part set by SevenSegBrightnessSet().
 *********************************************************************************************************
 */
 
@@ -85,10 +147,16 @@ void  SevenSegDisp_Init (void)
     INT32U cpu_frq;
     INT32U bus_frq;
     INT8U  ECT_Prescaler;    
+    INT8U  i;
 
 
-    DDRP         |= 0x0F;                                               /* Set the 7-Segment Enable I/O pins to output              */
+    DDRP         |= SEVEN_SEG_DIG_MASK;                                 /* Set the 7-Segment Enable I/O pins to output              */
     actBlockNum   = 0;                                                  /* Set display 0 as the first active LED display block      */
+    offPhase      = DEF_FALSE;
+    segPatIx      = 0;
+    for (i = 0; i < SEVEN_SEG_NBR_DIG; i++) {                           /* Show 0000 until the first SevenSegWrite()                */
+        segPat[0][i] = SSD_0;
+    }
 
     cpu_frq = BSP_CPU_ClkFreq();                                        /* Get the current CPU frequency                            */
     bus_frq = cpu_frq / 2;                                              /* Derive the BUS frequency from the CPU frequency          */
@@ -96,56 +164,14 @@ void  SevenSegDisp_Init (void)
     ECT_Prescaler = TSCR2 & 0x07;                                       /* Get the prescaler value in the control register          */
     ECT_Prescaler = (1 << ECT_Prescaler);                               /* Calculate the correct prescaler value from the reg val   */
     
-                                                                        /* Calculate the # of ticks for an interrupt period of 1ms  */                                                                        
-    nbrCnts       = (INT16U)((bus_frq / (ECT_Prescaler * 225)) - 1);    /* 225 represents 225 ticks in 1 second, each tick ~4ms     */ 
-
-#if SEVEN_SEG_OC == 0
-    TIOS  |= 0x01;                                                      /* Make channel an output compare                           */
-    TC0    = TCNT + nbrCnts;                                            /* Set TC0 to present time + nbrCnts                        */
-    TIE |= 0x01;                                                        /* Enable OC0 interrupt.                                    */
-#endif
-
-#if SEVEN_SEG_OC == 1
-    TIOS  |= 0x02;                                                      /* Make channel an output compare                           */
-    TC1    = TCNT + nbrCnts;                                            /* Set TC1 to present time + nbrCnts                        */
-    TIE |= 0x02;                                                        /* Enable OC1 interrupt.                                    */
-#endif
-
-#if SEVEN_SEG_OC == 2
-    TIOS  |= 0x04;                                                      /* Make channel an output compare                           */
-    TC2    = TCNT + nbrCnts;                                            /* Set TC2 to present time + nbrCnts                        */
-    TIE |= 0x04;                                                        /* Enable OC2 interrupt.                                    */
-#endif
+                                                                        /* Calculate the # of ticks for one LED block slot          */
+    nbrCnts       = (INT16U)((bus_frq / ((INT32U)ECT_Prescaler * SEVEN_SEG_NBR_DIG * SEVEN_SEG_REFRESH_HZ)) - 1);
+    minCnts       = (INT16U)( bus_frq / ((INT32U)ECT_Prescaler * (1000000L / SEVEN_SEG_PHASE_MIN_US)));
+    SevenSegBrightnessSet(SEVEN_SEG_BRIGHTNESS);
 
-#if SEVEN_SEG_OC == 3
-    TIOS  |= 0x08;                                                      /* Make channel an output compare                           */
-    TC3    = TCNT + nbrCnts;                                            /* Set TC3 to present time + nbrCnts                        */
-    TIE |= 0x08;                                                        /* Enable OC3 interrupt.                                    */
-#endif
-
-#if SEVEN_SEG_OC == 4
-    TIOS  |= 0x10;                                                      /* Make channel an output compare                           */
-    TC4    = TCNT + nbrCnts;                                            /* Set TC4 to present time + nbrCnts                        */
-    TIE |= 0x10;                                                        /* Enable OC4 interrupt.                                    */
-#endif
-
-#if SEVEN_SEG_OC == 5
-    TIOS  |= 0x20;                                                      /* Make channel an output compare                           */
-    TC5    = TCNT + nbrCnts;                                            /* Set TC5 to present time + nbrCnts                        */
-    TIE |= 0x20;                                                        /* Enable OC5 interrupt.                                    */
-#endif
-
-#if SEVEN_SEG_OC == 6
-    TIOS  |= 0x40;                                                      /* Make channel an output compare                           */
-    TC6    = TCNT + nbrCnts;                                            /* Set TC6 to present time + nbrCnts                        */
-    TIE |= 0x40;                                                        /* Enable OC6 interrupt.                                    */
-#endif
-
-#if SEVEN_SEG_OC == 7
-    TIOS  |= 0x80;                                                      /* Make channel an output compare                           */
-    TC7    = TCNT + nbrCnts;                                            /* Set TC7 to present time + nbrCnts                        */
-    TIE |= 0x80;                                                        /* Enable OC7 interrupt.                                    */
-#endif
+    TIOS         |= SEVEN_SEG_OC_MASK;                                  /* Make channel an output compare                           */
+    SEVEN_SEG_TC  = TCNT + nbrCnts;                                     /* Set the compare to present time + nbrCnts                */
+    TIE          |= SEVEN_SEG_OC_MASK;                                  /* Enable the channel interrupt                             */
 
     TSCR1 = 0xC0;                                                       /* Enable counter & disable counter in background mode      */
 }
@@ -169,181 +195,315 @@ void  SevenSegDisp_Init (void)
 *               This involves plugging the right vector number with the name of
 *               the ISR function below. A prototype at the top of vectors.c must
 *               also be created.
+*
+*               The segment patterns are prepared by SevenSegWrite(), a slot only costs an indexed
+*               load and the port writes.  When dimmed, a second interrupt in the middle of the slot
+*               turns the LED block off.
 *********************************************************************************************************
 */
 
 void  SevenSegDisp_ISR_Handler (void) 
 {
-   INT8U digits[4];
-   INT8U currDispNum;
-   
-   
-   PTP        |=   0x0F;                                                /* Shut off all 7-Segment LED blocks by removing the ground */   
-   currDispNum = ((actBlockNum) % 4);                                   /* Get the number of the current LED block to display on    */
-   actBlockNum++;                                                       /* Increment the display # used for the next interrupt      */
-   
-                                                                        /* Calculate all the digits for each display even though    */
-                                                                        /* only one of these digits will be used during this ISR    */
-                                                                        
-   digits[0]   =  (INT8U) (outputNum / 1000);	                        /* Calculate digit 4 (most significant) 1000's place        */
-   digits[1]   =  (INT8U)((outputNum % 1000) / 100);                    /* Calculate digit 3, the 100's place                       */
-   digits[2]   =  (INT8U)((outputNum % 100)  / 10);                     /* Calculate digit 2, the 10's place                        */
-   digits[3]   =  (INT8U) (outputNum % 10);                             /* Calculate digit 1 (lease significant) 1's place          */
-      
-   SevenSegOut(digits[currDispNum]);                                    /* Put the value on the 7-Segment LED data bus              */
-   PTP        &= ~(1 << currDispNum);                                   /* Enable the current LED block, by supplying the ground    */
-   
-#if SEVEN_SEG_OC == 0
-    TFLG1 |= 0x01;                                                      /* Clear interrupt                                          */
-    TC0   += nbrCnts;                                                   /* Set TC0 to present time + nbrCnts                        */
+#if SEVEN_SEG_ISR_TIME_EN > 0
+    INT16U  start;
 #endif
 
-#if SEVEN_SEG_OC == 1 
-    TFLG1 |= 0x02;                                                      /* Clear interrupt                                          */
-    TC1   += nbrCnts;                                                   /* Set TC1 to present time + nbrCnts                        */
-#endif
 
-#if SEVEN_SEG_OC == 2
-    TFLG1 |= 0x04;                                                      /* Clear interrupt                                          */
-    TC2   += nbrCnts;                                                   /* Set TC2 to present time + nbrCnts                        */
+#if SEVEN_SEG_ISR_TIME_EN > 0
+    start          = TCNT;
 #endif
+    TFLG1          = SEVEN_SEG_OC_MASK;                                 /* Clear interrupt, writing 1 clears only this channel      */
+    PTP           |= SEVEN_SEG_DIG_MASK;                                /* Shut off all 7-Segment LED blocks by removing the ground */
+
+    if (offPhase == DEF_FALSE) {
+        PTJ       |= (1 << 1);                                          /* Shut off the other regular LED's while displaying        */
+        PORTB      = segPat[segPatIx][actBlockNum];                     /* Put the pattern on the 7-Segment LED data bus            */
+        if (onCnts > 0) {
+            PTP   &= ~(1 << actBlockNum);                               /* Enable the current LED block, by supplying the ground    */
+        }
+        actBlockNum = (actBlockNum + 1) & (SEVEN_SEG_NBR_DIG - 1);      /* Select the LED block used for the next slot              */
+        if ((onCnts > 0) && (onCnts < nbrCnts)) {                       /* Dimmed: come back to end the lit phase                   */
+            offPhase      = DEF_TRUE;
+            offCnts       = nbrCnts - onCnts;                           /* Latched, SevenSegBrightnessSet() may change onCnts       */
+            SEVEN_SEG_TC += onCnts;
+        } else {
+            SEVEN_SEG_TC += nbrCnts;                                    /* Set the compare to the start of the next slot            */
+        }
+    } else {
+        offPhase           = DEF_FALSE;                                 /* LED blocks stay dark for the rest of the slot            */
+        SEVEN_SEG_TC      += offCnts;
+    }
 
-#if SEVEN_SEG_OC == 3
-    TFLG1 |= 0x08;                                                      /* Clear interrupt                                          */
-    TC3   += nbrCnts;                                                   /* Set TC3 to present time + nbrCnts                        */
+#if SEVEN_SEG_ISR_TIME_EN > 0
+    start = TCNT - start;
+    if (start > SevenSegISRCntsMax) {
+        SevenSegISRCntsMax = start;
+    }
 #endif
+}
 
-#if SEVEN_SEG_OC == 4
-    TFLG1 |= 0x10;                                                      /* Clear interrupt                                          */
-    TC4   += nbrCnts;                                                   /* Set TC4 to present time + nbrCnts                        */
-#endif
 
-#if SEVEN_SEG_OC == 5
-    TFLG1 |= 0x20;                                                      /* Clear interrupt                                          */
-    TC5   += nbrCnts;                                                   /* Set TC5 to present time + nbrCnts                        */
-#endif
+/*
+*********************************************************************************************************
+*                                        Multiple 7-Seg Output
+*
+* Description : This function converts 'num' to the segment patterns of the four LED blocks and hands
+*               them to the SevenSegDisp_ISR, see SevenSegPatSet().  This function is thread safe.
+*
+* Notes       : This function only allows decimal numbers between 0000 and 9999 inclusive to be
+*               written to the global output variable. Any number < 0 or > 9999 can not be
+*               represented on four, 7-Segment LED blocks.  Ex: [9][1][2][3], 9123.
+*
+*               The divisions are done here, once per call, instead of on every interrupt.  The decimal
+*               points set by SevenSegDPSet() are added.
+*********************************************************************************************************
+*/
 
-#if SEVEN_SEG_OC == 6
-    TFLG1 |= 0x40;                                                      /* Clear interrupt                                          */
-    TC6   += nbrCnts;                                                   /* Set TC6 to present time + nbrCnts                        */
-#endif
+void  SevenSegWrite (INT16U num) 
+{
+    INT8U   pat[SEVEN_SEG_NBR_DIG];
+    
+    
+    if (num <= 9999) {                                                  /* Only display numbers between 0000 and 9999 inclusive     */        
+        pat[0] = SevenSegGlyph('0' +  num / 1000);                      /* Digit 4 (most significant) 1000's place                  */
+        pat[1] = SevenSegGlyph('0' + (num % 1000) / 100);               /* Digit 3, the 100's place                                 */
+        pat[2] = SevenSegGlyph('0' + (num % 100)  / 10);                /* Digit 2, the 10's place                                  */
+        pat[3] = SevenSegGlyph('0' +  num % 10);                        /* Digit 1 (least significant) 1's place                    */
+        SevenSegPatSet(pat, dpMask);
+    }
+}
+
+
+/*
+*********************************************************************************************************
+*                                        Hexadecimal 7-Seg Output
+*
+* Description : This function displays 'num' as four hexadecimal digits, 0000 to FFFF.
+*
+* Notes       : B and D are shown in lower case, b and d, to tell them from 8 and 0.  The decimal points
+*               set by SevenSegDPSet() are added.  This function is thread safe.
+*********************************************************************************************************
+*/
 
-#if SEVEN_SEG_OC == 7
-    TFLG1 |= 0x80;                                                      /* Clear interrupt                                          */
-    TC7   += nbrCnts;                                                   /* Set TC7 to present time + nbrCnts                        */   
-#endif    
+void  SevenSegWriteHex (INT16U num)
+{
+    INT8U   pat[SEVEN_SEG_NBR_DIG];
+    INT8U   nibble;
+    INT8U   i;
+
+
+    for (i = SEVEN_SEG_NBR_DIG; i > 0; i--) {                           /* Least significant nibble goes to the rightmost block     */
+        nibble     = (INT8U)(num & 0x0F);
+        pat[i - 1] = SevenSegGlyph((nibble < 10) ? ('0' + nibble) : ('A' + nibble - 10));
+        num      >>= 4;
+    }
+    SevenSegPatSet(pat, dpMask);
 }
 
 
 /*
 *********************************************************************************************************
-*                                        7-Segment Display Write
+*                                        Signed 7-Seg Output
 *
-* Description : This function puts data on PORTB, the 7-Segment LED data bus.
+* Description : This function displays 'num', right aligned, with a minus sign in front of negative
+*               values.  Leading zeros are blanked.  Ex: [ ][ ][-][5], -5.
+*
+* Notes       : Only -999 to 9999 inclusive fit on four, 7-Segment LED blocks.  Other values are
+*               clamped to -999 or 9999.  The decimal points set by SevenSegDPSet() are added, also on
+*               blanked blocks.  This function is thread safe.
 *********************************************************************************************************
 */
 
-static  void  SevenSegOut (INT8U digit)
+void  SevenSegWriteSigned (INT16S num)
 {
-    PTJ |= (1 << 1);                                                    /* Shut off the other regular LED's while displaying        */
-    
-    switch (digit) {
-        case 0:
-             PORTB = SSD_0;
-             break;
-
-        case 1:
-             PORTB = SSD_1;
-             break;
-
-        case 2:
-             PORTB = SSD_2;
-             break;
-
-        case 3:
-             PORTB = SSD_3;
-             break;
-
-        case 4:
-             PORTB = SSD_4;
-             break;
-
-        case 5:
-             PORTB = SSD_5;
-             break;
-
-        case 6:
-             PORTB = SSD_6;
-             break;
-
-        case 7:
-             PORTB = SSD_7;
-             break;
-
-        case 8:
-             PORTB = SSD_8;
-             break;
-
-        case 9:
-             PORTB = SSD_9;
-             break;
-
-        case 'A':
-             PORTB = SSD_A;
-             break;
-
-        case 'B':
-             PORTB = SSD_B;
-             break;
-        
-        case 'C':
-             PORTB = SSD_C;
-             break;
-        
-        case 'D':
-             PORTB = SSD_D;
-             break;
-        
-        case 'E':
-             PORTB = SSD_E;
-             break;
-        
-        case 'F':
-             PORTB = SSD_F;
-             break;
-        
-        default:
-             break; 
+    INT8U    pat[SEVEN_SEG_NBR_DIG];
+    INT16U   val;
+    INT8U    i;
+
+
+    if (num < -999) {                                                   /* Clamp to what four LED blocks can show                   */
+        num = -999;
+    } else if (num > 9999) {
+        num =  9999;
     }
+
+    val = (num < 0) ? (INT16U)-num : (INT16U)num;
+    i   = SEVEN_SEG_NBR_DIG;
+    do {                                                                /* Digits from the right, at least one                      */
+        i--;
+        pat[i] = SevenSegGlyph('0' + val % 10);
+        val   /= 10;
+    } while (val > 0);
+
+    if (num < 0) {
+        i--;
+        pat[i] = SSD_MINUS;
+    }
+    while (i > 0) {                                                     /* Blank the unused blocks on the left                      */
+        i--;
+        pat[i] = 0x00;
+    }
+    SevenSegPatSet(pat, dpMask);
 }
 
 
 /*
 *********************************************************************************************************
-*                                        Multiple 7-Seg Output
+*                                        Text 7-Seg Output
 *
-* Description : This function updates a global variable used to pass the desired
-*               value of the digit to be displayed on the 7-Segment LEDs to the
-*               SevenSegDisp_ISR. A critical section must be used to ensure exclusive
-*               access to the global variable while it is being updated. This function
-*               is thread safe.
+* Description : This function displays up to four characters of 'pstr', left aligned.  A '.' turns on
+*               the decimal point of the character before it, so "12.34" uses four blocks.  Unused blocks
+*               are blank.  Ex: "STOP", "SAFE", "-1.5", "Err".
 *
-* Notes       : This function only allows decimal numbers between 0000 and 9999 inclusive to be
-*               written to the global output variable. Any number < 0 or > 9999 can not be
-*               represented on four, 7-Segment LED blocks.  Ex: [9][1][2][3], 9123.
+* Arguments   : pstr    is a NUL terminated string
+*
+* Notes       : The characters are converted to segment patterns here, once; the ISR only reads them.
+*               Lower case letters are shown like upper case ones.  Letters a 7-Segment LED block can
+*               not draw (K, M, V, W, X) and unknown characters are blank.  The decimal points come
+*               from 'pstr' only, SevenSegDPSet() does not apply.  This function is thread safe.
 *********************************************************************************************************
 */
 
-void  SevenSegWrite (INT16U num) 
+void  SevenSegWriteStr (const CPU_CHAR *pstr)
+{
+    INT8U   pat[SEVEN_SEG_NBR_DIG];
+    INT8U   pos;
+
+
+    pos = 0;
+    while (*pstr != (CPU_CHAR)0) {
+        if ((*pstr == '.') && (pos > 0) && ((pat[pos - 1] & SSD_DP) == 0)) {
+            pat[pos - 1] |= SSD_DP;                                     /* Decimal point shares the block of the previous character */
+        } else if (pos < SEVEN_SEG_NBR_DIG) {
+            pat[pos]      = SevenSegGlyph(*pstr);
+            pos++;
+        } else {
+            break;                                                      /* Display full                                             */
+        }
+        pstr++;
+    }
+    while (pos < SEVEN_SEG_NBR_DIG) {
+        pat[pos] = 0x00;
+        pos++;
+    }
+    SevenSegPatSet(pat, 0x00);
+}
+
+
+/*
+*********************************************************************************************************
+*                                        7-Seg Glyph Lookup
+*
+* Description : This function returns the segment pattern of 'c', 0x00 (blank) if it can not be shown.
+*********************************************************************************************************
+*/
+
+static  INT8U  SevenSegGlyph (CPU_CHAR c)
 {
+    if ((c >= 'a') && (c <= 'z')) {                                     /* Lower case letters share the upper case glyphs           */
+        c -= 'a' - 'A';
+    }
+    if ((c < SEVEN_SEG_GLYPH_FIRST) || (c > SEVEN_SEG_GLYPH_LAST)) {
+        return (0x00);
+    }
+    return (glyphTbl[c - SEVEN_SEG_GLYPH_FIRST]);
+}
+
+
+/*
+*********************************************************************************************************
+*                                        7-Seg Decimal Points
+*
+* Description : This function selects the decimal points shown by SevenSegWrite(), SevenSegWriteHex() and
+*               SevenSegWriteSigned().  Ex: SevenSegDPSet(0x04) then SevenSegWrite(1234) shows 12.34.
+*
+* Arguments   : mask    has one bit per LED block, bit 0 for the rightmost (least significant) block and
+*                       bit 3 for the leftmost.  0x00, the default, shows no decimal point.
+*
+* Notes       : The new mask is used from the next numeric write on; the value on display is not changed.
+*               This function is thread safe.
+*********************************************************************************************************
+*/
+
+void  SevenSegDPSet (INT8U mask)
+{
+    dpMask = mask & ((1 << SEVEN_SEG_NBR_DIG) - 1);                     /* Single byte store, atomic                                */
+}
+
+
+/*
+*********************************************************************************************************
+*                                        7-Seg Pattern Update
+*
+* Description : This function copies four segment patterns into the buffer the SevenSegDisp_ISR is not
+*               using, and then switches the ISR to that buffer.  A critical section makes the fill and
+*               the switch atomic so that the ISR never shows a mix of two values.
+*
+* Arguments   : pat     are the segment patterns, most significant block first
+*
+*               dp      is the decimal point mask to add, see SevenSegDPSet()
+*********************************************************************************************************
+*/
+
+static  void  SevenSegPatSet (INT8U *pat, INT8U dp)
+{
+    INT8U   ix;
+    INT8U   i;
     CPU_SR  cpu_sr;
-    
-    
-    if (num <= 9999) {                                                      /* Only display numbers between 0000 and 9999 inclusive     */        
-        CPU_CRITICAL_ENTER();                                               /* Lock access to the global output variable                */
-        outputNum = num;                                                    /* Update the variable with the new output value            */
-        CPU_CRITICAL_EXIT();                                                /* Unlock access to the global output variable              */
+
+
+    for (i = SEVEN_SEG_NBR_DIG; i > 0; i--) {                           /* Bit 0 of 'dp' is the rightmost block                     */
+        if ((dp & 0x01) != 0) {
+            pat[i - 1] |= SSD_DP;
+        }
+        dp >>= 1;
     }
+
+    CPU_CRITICAL_ENTER();                                               /* Lock access to the segment pattern buffers               */
+    ix            = segPatIx ^ 1;                                       /* Fill the buffer the ISR is not reading ...               */
+    segPat[ix][0] = pat[0];
+    segPat[ix][1] = pat[1];
+    segPat[ix][2] = pat[2];
+    segPat[ix][3] = pat[3];
+    segPatIx      = ix;                                                 /* ... then swap buffers                                    */
+    CPU_CRITICAL_EXIT();                                                /* Unlock access to the segment pattern buffers             */
 }
 
 
+/*
+*********************************************************************************************************
+*                                        7-Seg Brightness
+*
+* Description : This function sets the part of each slot the LED blocks are lit.
+*
+* Arguments   : pct     is the brightness in percent, 0 (off) to 100 (full).  Larger values mean 100.
+*
+* Notes       : Phases shorter than SEVEN_SEG_PHASE_MIN_US are stretched so the compare is never set in
+*               the past.  This function is thread safe.
+*********************************************************************************************************
+*/
+
+void  SevenSegBrightnessSet (INT8U pct)
+{
+    INT16U  cnts;
+    CPU_SR  cpu_sr;
+
+
+    if (pct >= 100) {
+        cnts = nbrCnts;
+    } else if (pct == 0) {
+        cnts = 0;
+    } else {
+        cnts = (INT16U)(((INT32U)nbrCnts * pct) / 100);
+        if (cnts < minCnts) {                                           /* Lit phase must outlast the ISR latency ...               */
+            cnts = minCnts;
+        }
+        if (cnts > (nbrCnts - minCnts)) {                               /* ... and so must the dark phase                           */
+            cnts = nbrCnts - minCnts;
+        }
+    }
+
+    CPU_CRITICAL_ENTER();
+    onCnts = cnts;
+    CPU_CRITICAL_EXIT();
+}
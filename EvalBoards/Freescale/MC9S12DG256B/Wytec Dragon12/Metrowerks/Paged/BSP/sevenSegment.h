@@ -13,6 +13,38 @@
 *********************************************************************************************************
 */
 
+/*
+*********************************************************************************************************
+*                                     DEFAULT CONFIGURATION
+*
+* Notes: Override these in app_cfg.h.
+*********************************************************************************************************
+*/
+
+#ifndef  SEVEN_SEG_REFRESH_HZ
+#define  SEVEN_SEG_REFRESH_HZ      60                                   /* Times per second each LED block is lit                   */
+#endif
+
+#ifndef  SEVEN_SEG_BRIGHTNESS
+#define  SEVEN_SEG_BRIGHTNESS     100                                   /* Brightness after SevenSegDisp_Init(), in percent         */
+#endif
+
+#ifndef  SEVEN_SEG_ISR_TIME_EN
+#define  SEVEN_SEG_ISR_TIME_EN      0                                   /* Record the longest ISR run in SevenSegISRCntsMax         */
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                        GLOBALS
+*********************************************************************************************************
+*/
+
+#if SEVEN_SEG_ISR_TIME_EN > 0
+extern  INT16U  SevenSegISRCntsMax;
+#endif
+
+
 /*
 *********************************************************************************************************
 *                                        PROTOTYPES
@@ -21,6 +53,11 @@
 
 void  SevenSegDisp_Init(void);
 void  SevenSegWrite(INT16U num);
+void  SevenSegWriteHex(INT16U num);
+void  SevenSegWriteSigned(INT16S num);
+void  SevenSegWriteStr(const CPU_CHAR *pstr);
+void  SevenSegDPSet(INT8U mask);
+void  SevenSegBrightnessSet(INT8U pct);
 void  SevenSegDisp_ISR_Handler(void);
 
 
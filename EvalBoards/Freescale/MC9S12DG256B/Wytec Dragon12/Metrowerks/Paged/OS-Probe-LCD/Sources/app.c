@@ -16,7 +16,6 @@
 */
 
 #include    <includes.h>
-#define MY_LCD_TASK_STK_SIZE 1000
 
 
 
@@ -26,6 +25,14 @@
 *********************************************************************************************************
 */
 
+#define  RANGE_STR_DIG_IX      7                                /* Index of the range digits in "Range: NNcm"           */
+#define  RANGE_STR_NBR_DIG     2                                /* get_ir_range() never returns more than 80 cm         */
+#define  STATUS_COL           13                                /* Status follows the range on the scrolling line       */
+#define  SCROLL_PERIOD         3                                /* Marquee step, in timer ticks (100 mS each)           */
+#define  SAMPLE_PERIOD_MS    100                                /* Sensor sampling period, see change_LCD()             */
+#define  RANGE_SAFE_CM        20                                /* Default of AppRangeSafeCm                            */
+#define  RANGE_SLOW_CM        13                                /* Default of AppRangeSlowCm                            */
+
 
 /*
 *********************************************************************************************************
@@ -42,6 +49,13 @@
 
     OS_STK        AppStartTaskStk[APP_TASK_START_STK_SIZE];
     OS_STK        LCD_TestTaskStk[LCD_TASK_STK_SIZE];
+
+                                                                /* Range thresholds, uC/Probe may set them while the    */
+                                                                /* ... car runs: see 'probe_com_region.c' Note #5       */
+#pragma DATA_SEG PROBE_DATA
+    CPU_INT08U    AppRangeSafeCm = RANGE_SAFE_CM;               /* At or above: SAFE, motor at full speed               */
+    CPU_INT08U    AppRangeSlowCm = RANGE_SLOW_CM;               /* At or above: SLOW DOWN, below: DANGEROUS             */
+#pragma DATA_SEG DEFAULT
   
      
   
@@ -239,36 +253,22 @@ static  void  AppTaskCreate (void)
 
 static  void  change_LCD(void *p_arg)
 {    
-  /*String to map to the LCD display*/
-  const  CPU_INT08U  RangeStr[46][18]  = {"Range: 0cm", "Range: 1cm",                                                                          
-                                         "Range: 2cm", "Range: 3cm",  
-                                         "Range: 4cm", "Range: 5cm",
-                                         "Range: 6cm","Range: 7cm",
-                                         "Range: 8cm","Range: 9cm",
-                                         "Range: 10cm","Range: 11cm",
-                                         "Range: 12cm","Range: 13cm",
-                                         "Range: 14cm","Range: 15cm",
-                                         "Range: 16cm","Range: 17cm",
-                                         "Range: 18cm","Range: 19cm",
-                                         "Range: 20cm","Range: 21cm",
-                                         "Range: 22cm","Range: 23cm",
-                                         "Range: 24cm","Range: 25cm",
-                                         "Range: 26cm","Range: 27cm",
-                                         "Range: 28cm","Range: 29cm",
-                                         "Range: 30cm","Range: 31cm",
-                                         "Range: 32cm","Range: 33cm",
-                                         "Range: 34cm","Range: 35cm",
-                                         "Range: 36cm","Range: 37cm",
-                                         "Range: 38cm","Range: 39cm",
-                                         "Range: 40cm","Range: 41cm",
-                                         "Range: 42cm","Range: 43cm",
-                                         "Range: 44cm","Range: 45cm"};
+  /*Range line, the digits at RANGE_STR_DIG_IX are re-formatted in place each sample*/
+  CPU_CHAR  range_str[] = "Range:   cm";
+  /*Status messages are all 10 characters wide so a new one overwrites the previous one*/
+  CPU_INT08U *status;
+  CPU_INT08U *status_last;
   int range_cm;
+  int range_last;
   (void)p_arg;
   /*Initialize ATD and LCD Display 2-rows and 16-coloumns*/
   atd_init();
 DispInit(2, 16);
+/*Range and status share line 0, which is too short for both: scroll it, the LCD shifts it by itself*/
+DispScrollStart(SCROLL_PERIOD);
 range_cm = 0;
+range_last = -1;
+status_last = (CPU_INT08U *)0;
 pwm_init();
 PWMPRCLK=0x04; //ClockA=Fbus/2**4=24MHz/16=1.5MHz 
 PWMSCLA=125; //ClockSA=1.5MHz/2x125=6000 Hz
@@ -287,46 +287,56 @@ while (DEF_TRUE) { /* All tasks bodies include an infinite loop */
           /*Acquire range from function get_ir_range, input is ATD0DR6 because we are using channel 6 of ATD*/
           range_cm = get_ir_range(ATD0DR6);
           if (range_cm == 0) {
-             DispClrLine(1);
-             DispStr(1,0,"CRASH");
+             status = (CPU_INT08U *)"CRASH     ";
              PORTB=0xFF;
           }
           /*limits the IR detection range to 35cm*/
           else if(range_cm <= 80 && range_cm > 0) 
           {
               /*Displays the Range on LCD*/
-              DispStr(0,0,RangeStr[range_cm]);
+              /*Only rewrite the range when it changed, scrolling itself costs no data bytes*/
+              if (range_cm != range_last) {
+                Str_FmtNbr_Int32U((CPU_INT32U)range_cm, RANGE_STR_NBR_DIG, ' ', DEF_NO, &range_str[RANGE_STR_DIG_IX]);
+                DispScrollStr(0,0,(CPU_INT08U *)range_str);
+                range_last = range_cm;
+              }
               OSTimeDlyHMSM(0,0,1,0);
               
               /*clears the screen to make it readable*/
               if(range_cm == 0) DispClrScr();
-              /*If range is greater then 20cm then turn on motor*/
-              if(range_cm >= 20) {
-                DispClrLine(1);
-                DispStr(1,0,"SAFE");
+              /*If range is at least AppRangeSafeCm (20cm) then turn on motor*/
+              if(range_cm >= AppRangeSafeCm) {
+                status = (CPU_INT08U *)"SAFE      ";
                 PORTB=0xFF;
                 PWMPER5=50; //PWM_Freq=ClockSA/100=6000Hz/100=60Hz.
                 PWMCNT5=0;
               }
-              /*If range is between 20 and 13 then slow down*/ 
-              else if(range_cm >= 13) {
-                DispClrLine(1);
-                DispStr(1,0,"SLOW DOWN");
+              /*If range is between AppRangeSafeCm and AppRangeSlowCm (13cm) then slow down*/ 
+              else if(range_cm >= AppRangeSlowCm) {
+                status = (CPU_INT08U *)"SLOW DOWN ";
                 PWMPER5=250; //PWM_Freq=ClockSA/100=6000Hz/100=60Hz. 
               }
-              /*if range is less then 13cm then stop the motor*/
+              /*if range is less then AppRangeSlowCm then stop the motor*/
               else {
-                DispClrLine(1);
-                DispStr(1,0,"DANGEROUS");
+                status = (CPU_INT08U *)"DANGEROUS ";
                 PORTB=0x00;
                 PWMPER5=600; //PWM_Freq=ClockSA/100=6000Hz/100=60Hz.
               }
               
           } else {
-                DispClrLine(1);
-                DispStr(1,0,"Moving...");
+                status = (CPU_INT08U *)"Moving... ";
                 PORTB=0xFF;
           }
+          if (status != status_last) {
+                DispScrollStr(0,STATUS_COL,status);
+                status_last = status;
+          }
+          /*sends only the characters that changed to the LCD*/
+          DispFlush();
+          /*The LCD writes used to block this task for ~85ms per sample (3 OS ticks per byte, see
+            Tests/uC-LCD/test_lcd_shadow.c). Now only changes are sent, by the uC/LCD Task, so without
+            this delay the out-of-range path would spin and starve the lower priority tasks*/
+          OSTimeDlyHMSM(0,0,0,SAMPLE_PERIOD_MS);
                 
 
   }
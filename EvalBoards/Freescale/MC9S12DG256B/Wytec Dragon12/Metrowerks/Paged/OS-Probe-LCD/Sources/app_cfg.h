@@ -30,11 +30,14 @@
 *********************************************************************************************************
 */
 
+#define  OS_TASK_DPC_PRIO                   0                           /* Set the prio of the DPC task, highest                    */
+
 #define  APP_TASK_START_PRIO                1                           /* Set the prio for the startup task                        */
 
 #define  LCD_TEST_TASK_PRIO                 2                           /* Set the prio for the LCD Test Task                       */
 #define  SEVEN_SEG_TEST_TASK_PRIO           4                           /* Set the prio for Seven Segment Test Task                 */
 #define  KEYPAD_RD_TASK_PRIO                6                           /* Set the prio for the Keypad Read Task                    */
+#define  DISP_TASK_PRIO                     7                           /* Set the prio for the uC/LCD Task (owns the LCD bus)      */
 #define  OS_PROBE_TASK_PRIO                 8
 #define  PROBE_COMM_RS232_PRIO_RESERVED     9                           /* See probe_com_cfg.h, for Probe Parse Task priority       */
 #define  OS_TASK_TMR_PRIO                  10                           /* Set the prio of the tmr task, near lowest                */
@@ -47,10 +50,11 @@
 */
 
 #define  APP_TASK_START_STK_SIZE          256                           /* Set the stack size for the startup task                  */
-#define  LCD_TASK_STK_SIZE	              1000                           /* Set the stack size for the LCD Test task                 */
+#define  LCD_TASK_STK_SIZE	              256                            /* Set the stack size for the LCD Test task                 */
 #define  SEVEN_SEG_TEST_TASK_STK_SIZE     256                           /* Set the stack size for the 7-Segment Test task           */
 #define  KEYPAD_RD_TASK_STK_SIZE          256                           /* Set the stack size for the Keypad Read task              */
 #define  OS_PROBE_TASK_STK_SIZE           256
+#define  DISP_TASK_STK_SIZE               256                           /* Set the stack size for the uC/LCD Task                   */
 
 
 /*
@@ -71,6 +75,14 @@
 
 #define  uC_LCD_MODULE                  DEF_ENABLED
 #define  DISP_BUS_WIDTH                     4                           /* Data bus width: 4 or 8 bit                               */
+#define  DISP_SHADOW_EN                     1                           /* Buffer the screen in RAM, send changes with DispFlush()  */
+#define  DISP_SHADOW_MAX_ROWS               2                           /* Size of the RAM buffer, must cover DispInit() arguments  */
+#define  DISP_SHADOW_MAX_COLS              16
+#define  DISP_TASK_EN                       1                           /* Draw from the uC/LCD Task, callers only queue commands   */
+#define  DISP_TASK_Q_SIZE                  16                           /* Number of commands that can be queued                    */
+#define  DISP_TASK_STR_SIZE                17                           /* Max. string length in a command + 1 (at least 9)         */
+#define  DISP_BUSY_FLAG_EN                  0                           /* Poll the busy flag. Needs RW wired, Dragon12 ties it LOW */
+#define  DISP_SCROLL_EN                     1                           /* Marquee with the display shift command, needs OS_TMR_EN  */
 
 
 /*
@@ -83,6 +95,9 @@
                                                                         /* interrupt for switching the enabled 7-Segment display    */
                                                                         /* WARNING: This must never be defined the same as          */
                                                                         /* OS_TICK_OC which is defined in bsp.h                     */
+#define  SEVEN_SEG_REFRESH_HZ              60                           /* Refresh rate of the display, 4 interrupts per refresh    */
+#define  SEVEN_SEG_BRIGHTNESS             100                           /* Initial brightness in percent, see SevenSegBrightnessSet */
+#define  SEVEN_SEG_ISR_TIME_EN              0                           /* Record the longest multiplexing ISR run, in TCNT counts  */
 
 
 /*
@@ -58,6 +58,10 @@
 #if (PROBE_COM_METHOD_RS232 > 0)
 #include  <probe_rs232.h>
 #endif
+
+#if (PROBE_COM_METHOD_TCPIP > 0)
+#include  <probe_tcpip.h>
+#endif
 #endif
 
                                                                 /* ------------ APPLICATION INCLUDE FILES ------------- */
@@ -46,6 +46,8 @@
 #define OS_MAX_TASKS             20    /* Max. number of tasks in your application, MUST be >= 2       */
 
 #define OS_SCHED_LOCK_EN          1    /* Include code for OSSchedLock() and OSSchedUnlock()           */
+#define OS_SCHED_RR_EN            0    /* Round-robin among tasks created with OS_TASK_OPT_SCHED_RR    */
+#define OS_SCHED_RR_QUANTA       10    /* Round-robin time quantum (# of ticks)                        */
 
 #define OS_TICK_STEP_EN           1    /* Enable tick stepping feature for uC/OS-View                  */
 #define OS_TICKS_PER_SEC       1000    /* Set the number of ticks in one second                        */
@@ -53,6 +55,7 @@
 
                                        /* --------------------- TASK STACK SIZE ---------------------- */
 #define OS_TASK_TMR_STK_SIZE    160    /* Timer      task stack size (# of OS_STK wide entries)        */
+#define OS_TASK_DPC_STK_SIZE    160    /* DPC        task stack size (# of OS_STK wide entries)        */
 #define OS_TASK_STAT_STK_SIZE   160    /* Statistics task stack size (# of OS_STK wide entries)        */
 #define OS_TASK_IDLE_STK_SIZE   160    /* Idle       task stack size (# of OS_STK wide entries)        */
 
@@ -71,6 +74,11 @@
 #define OS_TASK_SW_HOOK_EN        1    /*     Include code for OSTaskSwHook()                          */
 
 
+                                       /* ----------------- DEFERRED PROCEDURE CALLS ----------------- */
+#define OS_DPC_EN                 0    /* Enable (1) or Disable (0) code generation for DPCs           */
+#define OS_DPC_Q_SIZE            16    /*     Number of entries in the DPC queue (2 .. 255)            */
+
+
                                        /* ----------------------- EVENT FLAGS ------------------------ */
 #define OS_FLAG_EN                1    /* Enable (1) or Disable (0) code generation for EVENT FLAGS    */
 #define OS_FLAG_ACCEPT_EN         1    /*     Include code for OSFlagAccept()                          */
@@ -102,6 +110,13 @@
 #define OS_MUTEX_ACCEPT_EN        1    /*     Include code for OSMutexAccept()                         */
 #define OS_MUTEX_DEL_EN           1    /*     Include code for OSMutexDel()                            */
 #define OS_MUTEX_QUERY_EN         1    /*     Include code for OSMutexQuery()                          */
+#define OS_MUTEX_CEILING_EN       0    /*     Raise owner to the PIP at acquire time (prio. ceiling)   */
+
+
+                                       /* -------------------- READER-WRITER LOCKS ------------------- */
+#define OS_RWLOCK_EN              0    /* Enable (1) or Disable (0) code generation for RW LOCKS       */
+#define OS_RWLOCK_DEL_EN          1    /*     Include code for OSRWLockDel()                           */
+#define OS_RWLOCK_QUERY_EN        1    /*     Include code for OSRWLockQuery()                         */
 
 
                                        /* ---------------------- MESSAGE QUEUES ---------------------- */
@@ -43,12 +43,40 @@
 #define  PROBE_COM_RX_MAX_SIZE               64
 #define  PROBE_COM_TX_MAX_SIZE               64
 
-#define  PROBE_COM_SUPPORT_WR              DEF_FALSE
+#define  PROBE_COM_SUPPORT_WR              DEF_TRUE             /* Writes confined to PROBE_RAM, see 'probe_com_region.c'   */
 #define  PROBE_COM_SUPPORT_STR             DEF_FALSE
 #if     (PROBE_COM_SUPPORT_STR  == DEF_TRUE)                    /* If strings are supported                                 */
 #define  PROBE_COM_STR_BUF_SIZE             128                 /*   (a) Set size of string buffer                          */
 #endif
 
+#define  PROBE_COM_SUPPORT_TELEMETRY       DEF_FALSE
+#if     (PROBE_COM_SUPPORT_TELEMETRY == DEF_TRUE)               /* If telemetry is supported                                */
+#define  PROBE_COM_TELEMETRY_NBR              8                 /*   (a) Set nbr of telemetry buffers                       */
+#define  PROBE_COM_TELEMETRY_BUF_LEN         32                 /*   (b) Set size of each telemetry buffer                  */
+#endif
+
+#define  PROBE_COM_SUPPORT_STREAM          DEF_TRUE
+#if     (PROBE_COM_SUPPORT_STREAM == DEF_TRUE)                  /* If symbol streaming is supported                         */
+#define  PROBE_COM_STREAM_SYM_NBR             8                 /*   (a) Set max nbr of symbols in the stream set           */
+#endif
+
+#define  PROBE_COM_SUPPORT_DELTA           DEF_TRUE
+#if     (PROBE_COM_SUPPORT_DELTA  == DEF_TRUE)                  /* If delta reads are supported                             */
+#define  PROBE_COM_DELTA_KEY_PERIOD          32                 /*   (a) Set nbr of delta responses between keyframes       */
+#endif
+
+#define  PROBE_COM_SUPPORT_SG              DEF_TRUE
+#if     (PROBE_COM_SUPPORT_SG     == DEF_TRUE)                  /* If scattered (zero-copy) read responses are supported    */
+#define  PROBE_COM_SG_SEG_NBR                13                 /*   (a) Set max nbr of segments per response               */
+#define  PROBE_COM_SG_MAX_SIZE             4096                 /*   (b) Set max size of a scattered response               */
+#endif
+
+#define  PROBE_COM_SUPPORT_CRC16           DEF_TRUE             /* Accept packets framed with a CRC-16 (RS-232)             */
+
+#define  PROBE_COM_SUPPORT_SYM             DEF_FALSE            /* Answer symbol lookups from 'probe_com_sym.c'             */
+
+#define  PROBE_COM_SUPPORT_REGION          DEF_TRUE             /* Check memory accesses against 'probe_com_region.c'       */
+
 /*
 *********************************************************************************************************
 *                               CONFIGURE STATISTICS AND COUNTERS
@@ -74,6 +102,7 @@
 
 #define  PROBE_RS232_RX_BUF_SIZE       PROBE_COM_RX_MAX_SIZE    /*  (c) Set Rx buffer size                                  */
 #define  PROBE_RS232_TX_BUF_SIZE       PROBE_COM_TX_MAX_SIZE    /*  (d) Set Tx buffer size                                  */
+#define  PROBE_RS232_PIPE_DEPTH               2                 /*  (e) Set nbr of Rx & Tx buffers (requests in flight)     */
 
 #define  PROBE_RS232_UART_0                   1
 #define  PROBE_RS232_UART_1                   2
@@ -86,7 +115,7 @@
 #define  PROBE_RS232_UART_8                   9
 #define  PROBE_RS232_UART_9                  10
 #define  PROBE_RS232_UART_DBG                63
-#define  PROBE_RS232_COMM_SEL           PROBE_RS232_UART_1      /*  (e) Configure UART selection                            */
+#define  PROBE_RS232_COMM_SEL           PROBE_RS232_UART_1      /*  (f) Configure UART selection                            */
 
 #endif
 
@@ -0,0 +1,117 @@
+/*
+*********************************************************************************************************
+*                                      uC/Probe Communication
+*
+*                                  Memory Regions for the MC9S12DG256B
+*
+* Filename      : probe_com_region.c
+* Note(s)       : (1) The regions follow the memory map in the linker PRM files.  Addresses are given as in
+*                     the PRM & MAP files; paged flash is named by page, e.g., 0x3C8000 for offset 0x8000
+*                     of page 0x3C (see 'probe_com.c  MEMORY REGIONS  Note #2').
+*
+*                 (2) Registers are read-only, & the SCI registers (0x00C8-0x00D7) are left out altogether:
+*                     reading a status or data register clears receive flags & would corrupt the serial
+*                     link to the host or to the serial monitor.
+*
+*                 (3) The 0x8000-0xBFFF window is left out; which page it shows depends on PPAGE at the
+*                     instant of the read.  Pages 0x30-0x3D are read by page number instead.  Pages 0x3E
+*                     & 0x3F are the unpaged flash at 0x4000 & 0xC000.
+*
+*                 (4) The table is 'const'; compile this file with -Cc so it is allocated in ROM_VAR
+*                     (flash) rather than copied down to RAM.
+*
+*                 (5) Only PROBE_RAM (0x3FC0-0x3FFF) may be written.  The PRM places the PROBE_DATA
+*                     segment there; a variable the host may set is defined after
+*
+*                         #pragma DATA_SEG PROBE_DATA
+*
+*                     as the range thresholds in 'app.c' are.  PROBE_RAM is kept to 64 bytes, room for a
+*                     few more such variables; the rest of RAM holds the stack, the kernel & all other
+*                     data, so it may be read but not written.  If either PRM file moves or resizes
+*                     PROBE_RAM, this table must follow it.
+*********************************************************************************************************
+*/
+
+#include  <includes.h>
+#include  <probe_com.h>
+
+
+#if (PROBE_COM_SUPPORT_REGION == DEF_TRUE)
+
+/*
+*********************************************************************************************************
+*                                             REGION TABLE
+*********************************************************************************************************
+*/
+
+const  PROBE_COM_REGION  ProbeCom_RegionTbl[] = {
+    {0x00000000L, 0x000000C7L, PROBE_COM_REGION_RD                          },  /* Registers (see Note #2).             */
+    {0x000000D8L, 0x000003FFL, PROBE_COM_REGION_RD                          },
+    {0x00000400L, 0x00000FEFL, PROBE_COM_REGION_RD                          },  /* EEPROM.                              */
+    {0x00001000L, 0x00003FBFL, PROBE_COM_REGION_RD                          },  /* RAM (see Note #5).                   */
+    {0x00003FC0L, 0x00003FFFL, PROBE_COM_REGION_RD | PROBE_COM_REGION_WR    },  /* PROBE_RAM (see Note #5).             */
+    {0x00004000L, 0x00007FFFL, PROBE_COM_REGION_RD                          },  /* Unpaged flash (page 0x3E).           */
+    {0x0000C000L, 0x0000FFFFL, PROBE_COM_REGION_RD                          },  /* Unpaged flash (page 0x3F).           */
+    {0x00308000L, 0x0030BFFFL, PROBE_COM_REGION_RD | PROBE_COM_REGION_PAGED },  /* Paged flash (see Note #3).           */
+    {0x00318000L, 0x0031BFFFL, PROBE_COM_REGION_RD | PROBE_COM_REGION_PAGED },
+    {0x00328000L, 0x0032BFFFL, PROBE_COM_REGION_RD | PROBE_COM_REGION_PAGED },
+    {0x00338000L, 0x0033BFFFL, PROBE_COM_REGION_RD | PROBE_COM_REGION_PAGED },
+    {0x00348000L, 0x0034BFFFL, PROBE_COM_REGION_RD | PROBE_COM_REGION_PAGED },
+    {0x00358000L, 0x0035BFFFL, PROBE_COM_REGION_RD | PROBE_COM_REGION_PAGED },
+    {0x00368000L, 0x0036BFFFL, PROBE_COM_REGION_RD | PROBE_COM_REGION_PAGED },
+    {0x00378000L, 0x0037BFFFL, PROBE_COM_REGION_RD | PROBE_COM_REGION_PAGED },
+    {0x00388000L, 0x0038BFFFL, PROBE_COM_REGION_RD | PROBE_COM_REGION_PAGED },
+    {0x00398000L, 0x0039BFFFL, PROBE_COM_REGION_RD | PROBE_COM_REGION_PAGED },
+    {0x003A8000L, 0x003ABFFFL, PROBE_COM_REGION_RD | PROBE_COM_REGION_PAGED },
+    {0x003B8000L, 0x003BBFFFL, PROBE_COM_REGION_RD | PROBE_COM_REGION_PAGED },
+    {0x003C8000L, 0x003CBFFFL, PROBE_COM_REGION_RD | PROBE_COM_REGION_PAGED },
+    {0x003D8000L, 0x003DBFFFL, PROBE_COM_REGION_RD | PROBE_COM_REGION_PAGED }
+};
+
+const  CPU_INT16U        ProbeCom_RegionTblNbr = sizeof(ProbeCom_RegionTbl) / sizeof(ProbeCom_RegionTbl[0]);
+
+
+/*
+*********************************************************************************************************
+*                                          ProbeCom_PagedRd()
+*
+* Description : Read paged flash.
+*
+* Argument(s) : pdest       Pointer to the buffer which will receive the data.
+*
+*               addr        Paged address of the data (see Note #1).
+*
+*               nbytes      Number of bytes to read.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : ProbeCom_MemRd().
+*
+* Note(s)     : (1) The address is used as a '__far' pointer, so each byte is loaded by the non-banked
+*                   runtime routine _LOAD_FAR_8 (see 'datapage.c'), which saves PPAGE, selects the page &
+*                   restores PPAGE.  The page is never switched under this code, wherever it is placed.
+*
+*               (2) '__far' pointer arithmetic does not carry into the page, so the data must lie within
+*                   one page.  Each paged region is a single page.
+*********************************************************************************************************
+*/
+
+void  ProbeCom_PagedRd (void        *pdest,
+                        CPU_INT32U   addr,
+                        CPU_INT16U   nbytes)
+{
+    CPU_INT08U         *pdest_08;
+    CPU_INT08U *__far   psrc_08;
+
+
+    pdest_08 = (CPU_INT08U *)pdest;
+    psrc_08  = (CPU_INT08U *__far)addr;                         /* See Note #1.                                         */
+    while (nbytes > 0) {
+       *pdest_08 = *psrc_08;
+        pdest_08++;
+        psrc_08++;
+        nbytes--;
+    }
+}
+
+#endif
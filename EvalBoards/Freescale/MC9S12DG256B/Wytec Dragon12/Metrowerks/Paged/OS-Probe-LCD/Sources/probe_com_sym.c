@@ -0,0 +1,36 @@
+/*
+*********************************************************************************************************
+*                                      uC/Probe Communication
+*
+*                                        Symbol Directory
+*
+* Filename      : probe_com_sym.c
+* Note(s)       : (1) GENERATED by probe_com_sym.py from probe_com_sym.lst; do NOT edit.
+*********************************************************************************************************
+*/
+
+#include  <includes.h>
+#include  <probe_com.h>
+
+
+#if (PROBE_COM_SUPPORT_SYM == DEF_TRUE)
+
+const  PROBE_COM_SYM  ProbeCom_SymTbl[] = {
+    {0x0587AB7CL, (void *)&ProbeCom_ErrPktCtr,    (CPU_INT16U)sizeof(ProbeCom_ErrPktCtr),    PROBE_COM_SYM_TYPE_INT32U},
+    {0x2E5DE8A9L, (void *)&ProbeCom_TxPktCtr,     (CPU_INT16U)sizeof(ProbeCom_TxPktCtr),     PROBE_COM_SYM_TYPE_INT32U},
+    {0x4326EC61L, (void *)&OSTaskCtr,             (CPU_INT16U)sizeof(OSTaskCtr),             PROBE_COM_SYM_TYPE_INT08U},
+    {0x501FC7C0L, (void *)&OSIdleCtr,             (CPU_INT16U)sizeof(OSIdleCtr),             PROBE_COM_SYM_TYPE_INT32U},
+    {0x5301E226L, (void *)&OSRunning,             (CPU_INT16U)sizeof(OSRunning),             PROBE_COM_SYM_TYPE_BOOLEAN},
+    {0x5FA70F83L, (void *)&ProbeRS232_RxCtr,      (CPU_INT16U)sizeof(ProbeRS232_RxCtr),      PROBE_COM_SYM_TYPE_INT32U},
+    {0x6CB51915L, (void *)&ProbeRS232_TxCtr,      (CPU_INT16U)sizeof(ProbeRS232_TxCtr),      PROBE_COM_SYM_TYPE_INT32U},
+    {0x94C7C0A6L, (void *)&OSTime,                (CPU_INT16U)sizeof(OSTime),                PROBE_COM_SYM_TYPE_INT32U},
+    {0x9F0C02DDL, (void *)&OSCtxSwCtr,            (CPU_INT16U)sizeof(OSCtxSwCtr),            PROBE_COM_SYM_TYPE_INT32U},
+    {0xAA78EF45L, (void *)&ProbeCom_TxSymCtr,     (CPU_INT16U)sizeof(ProbeCom_TxSymCtr),     PROBE_COM_SYM_TYPE_INT32U},
+    {0xCE4FE607L, (void *)&ProbeCom_RxPktCtr,     (CPU_INT16U)sizeof(ProbeCom_RxPktCtr),     PROBE_COM_SYM_TYPE_INT32U},
+    {0xCFB49E27L, (void *)&ProbeCom_TxSymByteCtr, (CPU_INT16U)sizeof(ProbeCom_TxSymByteCtr), PROBE_COM_SYM_TYPE_INT32U},
+    {0xFFCFC4E2L, (void *)&OSCPUUsage,            (CPU_INT16U)sizeof(OSCPUUsage),            PROBE_COM_SYM_TYPE_INT08U},
+};
+
+const  CPU_INT16U     ProbeCom_SymTblNbr = sizeof(ProbeCom_SymTbl) / sizeof(ProbeCom_SymTbl[0]);
+
+#endif
@@ -18,6 +18,7 @@ extern void near _Startup(void);                                /* Startup Routi
 extern void near  OSTickISR(void);                              /* OS Time Tick Routine.                                */
 extern void near  OSCtxSw(void);                                /* OS Contect Switch Routine.                           */
 extern void near  SevenSegDisp_ISR(void);                       /* Seven Segment Display ISR.                           */
+extern void near  BSP_DlyISR(void);                             /* BSP Precision Delay ISR.                             */
 extern void near  ProbeRS232_RxTxISR(void);                     /* Probe SCI ISR.                                       */
 
 
@@ -159,7 +160,7 @@ const tIsrFunc _vect[] @0xFF80 = {     /* Interrupt table
         software_trap17,               /* 17 Pulse accumulator A overflow           */
         software_trap16,               /* 16 Enhanced Capture Timer Overflow        */
         OSTickISR,                     /* 15 Enhanced Capture Timer channel 7       */        
-        software_trap14,               /* 14 Enhanced Capture Timer channel 6       */
+        BSP_DlyISR,                    /* 14 Enhanced Capture Timer channel 6       */
         software_trap13,               /* 13 Enhanced Capture Timer channel 5       */
         software_trap12,               /* 12 Enhanced Capture Timer channel 4       */
         software_trap11,               /* 11 Enhanced Capture Timer channel 3       */
@@ -0,0 +1,292 @@
+/*
+*********************************************************************************************************
+*                                             HOST TESTS
+*
+*                                Dragon12 BSP Precision Delay, BSP_DlyUS()
+*
+* Filename      : test_bsp_dly.c
+* Note(s)       : (1) The Dragon12 'bsp.c' is included unchanged, over simulated MC9S12 ECT & CRG registers.
+*                     TCNT advances one count each time it is read, i.e. time passes as fast as the code
+*                     polls it.  A compare match sets the channel's TFLG1 flag; the channel's handler
+*                     (BSP_DlyISR_Handler() or OSTickISR_Handler()) is run through OS_CPU_SimISR() while
+*                     the flag is set, its interrupt enabled & interrupts are enabled, lowest channel first
+*                     as the MC9S12 does.  Writing a 1 to TFLG1 clears that flag only.
+*
+*                 (2) BgTask() stands for the rest of the application: it polls TCNT whenever it gets the
+*                     CPU, so the share of TCNT counts it reads during a delay is the CPU the delay gave
+*                     away.  The OS tick comes from the simulated OS_TICK_OC channel only.
+*
+*                 (3) For each requested delay the achieved delay MUST be at least the request, within
+*                     DLY_ERR_MAX_US of it.  Busy-waits give no CPU away; one-shot delays give nearly all.
+*                     This checks the arithmetic of the delay (rounding, chunking, TCNT wrap, fallback);
+*                     the CPU cycles of the ISR & context switches are not modelled.
+*
+*                 (4) With the ECT prescaler changed to 16 at run time (1.5 TCNT counts per uS), the
+*                     counts per uS MUST be rounded up: truncated to 1, every delay was 33% short.
+*********************************************************************************************************
+*/
+
+#include  <includes.h>
+
+
+/*
+*********************************************************************************************************
+*                                    SIMULATED MC9S12 REGISTERS
+*********************************************************************************************************
+*/
+
+typedef  union {
+    INT8U   Byte;
+    struct {
+        INT8U         : 7;
+        INT8U  PLLSEL : 1;
+    } Bits;
+} SIM_CLKSEL;
+
+static  SIM_CLKSEL  Sim_CLKSEL;
+static  INT8U       TSCR1, TSCR2, TIE, TIOS, TFLG1;
+static  INT8U       SYNR, REFDV, PLLCTL, CRGFLG = 0x08, Sim_BDMSTS;
+static  INT8U       PORTB, PTJ, DDRB, DDRJ;
+static  INT16U      TC0, TC1, TC2, TC3, TC4, TC5, TC6, TC7;
+
+#define  CLKSEL                 Sim_CLKSEL.Byte
+#define  CLKSEL_PLLSEL          Sim_CLKSEL.Bits.PLLSEL
+#define  CLKSEL_PLLSEL_MASK     0x80
+#define  TSCR2_PR_MASK          0x07
+#define  BDMSTS                 Sim_BDMSTS
+#define  BDMSTS_CLKSW_MASK      0x04
+#define  TCNT                   Sim_TCNTRd()
+
+static  INT16U  Sim_TCNTRd(void);
+
+#include  <bsp.h>
+#include  <bsp.c>
+
+
+/*
+*********************************************************************************************************
+*                                            LOCAL DEFINES
+*********************************************************************************************************
+*/
+
+#define  BG_TASK_PRIO                     20
+#define  HOLD_TASK_PRIO                    6
+
+#define  DLY_ERR_MAX_US                    2                    /* Busy-wait & one-shot, see Note #3.                   */
+#define  DLY_TICK_US      (1000000L / OS_TICKS_PER_SEC)
+
+
+/*
+*********************************************************************************************************
+*                                        LOCAL GLOBAL VARIABLES
+*********************************************************************************************************
+*/
+
+static  OS_STK               TestTaskStk[TEST_TASK_STK_SIZE];
+static  OS_STK               HoldTaskStk[TEST_TASK_STK_SIZE];
+static  OS_STK               BgTaskStk[TEST_TASK_STK_SIZE];
+
+static  unsigned  long  long  Sim_Cnt;                          /* TCNT, without the wrap.                              */
+static  INT8U                Sim_Flg;                           /* Compare flags set (TFLG1 as read).                   */
+static  unsigned  long  long  BgCtr;                            /* TCNT reads by BgTask().                              */
+static  double               CntsPerUS;                         /* Actual TCNT rate.                                    */
+
+static  OS_EVENT            *HoldSem;
+static  OS_EVENT            *HoldDoneSem;
+static  double               HoldUS;
+
+static  INT16U        *const Sim_TC[8]  = {&TC0, &TC1, &TC2, &TC3, &TC4, &TC5, &TC6, &TC7};
+
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                            Sim_TCNTRd()
+*
+* Description : Read TCNT: advance it, latch the compare matches & take a pending interrupt (see Note #1).
+*********************************************************************************************************
+*/
+
+static  INT16U  Sim_TCNTRd (void)
+{
+    INT16U  cnt;
+    INT8U   ch;
+
+
+    Sim_Flg &= ~TFLG1;                                          /* Writes of 1 since the last read clear those flags.   */
+    TFLG1    = 0;
+
+    Sim_Cnt++;
+    cnt = (INT16U)Sim_Cnt;
+    for (ch = 0; ch < 8; ch++) {
+        if (((TIOS & (1 << ch)) != 0) && (*Sim_TC[ch] == cnt)) {
+            Sim_Flg |= (INT8U)(1 << ch);
+        }
+    }
+
+    for (ch = 0; ch < 8; ch++) {                                /* Channel 0 has the highest priority.                  */
+        if ((Sim_Flg & TIE & (1 << ch)) != 0) {
+            if (ch == BSP_DLY_OC) {
+                OS_CPU_SimISR(BSP_DlyISR_Handler);
+            } else if (ch == OS_TICK_OC) {
+                OS_CPU_SimISR(OSTickISR_Handler);
+            }
+            Sim_Flg &= ~TFLG1;
+            TFLG1    = 0;
+            break;
+        }
+    }
+    return (cnt);
+}
+
+
+/*
+*********************************************************************************************************
+*                                         BgTask(), HoldTask()
+*
+* Description : BgTask() polls TCNT (see Note #2).  HoldTask() owns the one-shot channel for a 5 mS delay
+*               when signaled.
+*********************************************************************************************************
+*/
+
+static  void  BgTask (void *p_arg)
+{
+    (void)p_arg;
+    for (;;) {
+        (void)TCNT;
+        BgCtr++;
+    }
+}
+
+
+static  void  HoldTask (void *p_arg)
+{
+    unsigned  long  long  t0;
+    INT8U                err;
+
+
+    (void)p_arg;
+    for (;;) {
+        OSSemPend(HoldSem, 0, &err);
+        t0     = Sim_Cnt;
+        BSP_DlyUS(5000);
+        HoldUS = (double)(Sim_Cnt - t0) / CntsPerUS;
+        (void)OSSemPost(HoldDoneSem);
+    }
+}
+
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                             Test_Dly()
+*
+* Description : Delay & check the achieved delay against the request (see Note #3).
+*
+* Argument(s) : us          Requested delay.
+*
+*               err_max     Max. error allowed, in uS.
+*
+* Return(s)   : The achieved delay, in uS.
+*********************************************************************************************************
+*/
+
+static  double  Test_Dly (INT32U  us,
+                          double  err_max)
+{
+    unsigned  long  long  t0;
+    unsigned  long  long  bg0;
+    unsigned  long  long  cnts;
+    double               got;
+    double               bg;
+
+
+    t0   = Sim_Cnt;
+    bg0  = BgCtr;
+    BSP_DlyUS(us);
+    cnts = Sim_Cnt - t0;
+    got  = (double)cnts / CntsPerUS;
+    bg   = (double)(BgCtr - bg0) / (double)cnts;
+
+    TEST_CHK(got >= (double)us);
+    TEST_CHK(got <= (double)us + err_max);
+    if (us <= BSP_DLY_BUSY_MAX_US) {
+        TEST_CHK(BgCtr == bg0);                                 /* Busy-wait: no CPU given away.                        */
+    } else {
+        TEST_CHK(bg > 0.95);                                    /* One-shot: the rest of the system ran.                */
+    }
+    printf("req %6lu us  got %9.2f us  err %+8.2f us  other tasks %5.1f%%\n",
+           (unsigned long)us, got, got - (double)us, 100.0 * bg);
+    return (got);
+}
+
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                             TestTask()
+*********************************************************************************************************
+*/
+
+static  void  TestTask (void *p_arg)
+{
+    static  const  INT32U  req[] = {1, 2, 5, 40, 100, 250, 251, 300, 1000, 5000, 15000, 50000};
+    CPU_INT08U             i;
+    INT8U                  err;
+
+
+    (void)p_arg;
+    BSP_Init();
+    CntsPerUS = (double)BUS_CLK_FREQ / BSP_ECT_PRESCALER / 1000000.0;
+    TEST_CHK(BSP_DlyCntsPerUS * 1000000L == BUS_CLK_FREQ / BSP_ECT_PRESCALER);
+
+    HoldSem     = OSSemCreate(0);
+    HoldDoneSem = OSSemCreate(0);
+    (void)OSTaskCreate(BgTask,   (void *)0, &BgTaskStk[TEST_TASK_STK_SIZE - 1],   BG_TASK_PRIO);
+    (void)OSTaskCreate(HoldTask, (void *)0, &HoldTaskStk[TEST_TASK_STK_SIZE - 1], HOLD_TASK_PRIO);
+    OSTimeDly(1);
+
+    printf("ECT prescaler %u, %.2f TCNT counts per uS:\n", (unsigned)BSP_ECT_PRESCALER, CntsPerUS);
+    for (i = 0; i < sizeof(req) / sizeof(req[0]); i++) {
+        OSTimeDly(1);
+        (void)Test_Dly(req[i], DLY_ERR_MAX_US);
+    }
+
+    printf("channel owned by another task (OSTimeDly() fallback):\n");
+    OSTimeDly(1);
+    (void)OSSemPost(HoldSem);                                   /* HoldTask() takes the channel ...                     */
+    OSTimeDly(1);
+    (void)Test_Dly(2000, 2 * DLY_TICK_US);                      /* ... this delay is rounded up to whole ticks.         */
+    OSSemPend(HoldDoneSem, OS_TICKS_PER_SEC, &err);
+    TEST_CHK(err == OS_ERR_NONE);
+    TEST_CHK((HoldUS >= 5000) && (HoldUS <= 5000 + DLY_ERR_MAX_US));
+
+    printf("ECT prescaler changed to 16 at run time (Note #4):\n");
+    BSP_SetECT_Prescaler(16);
+    BSP_DlyInit();
+    CntsPerUS = (double)BUS_CLK_FREQ / 16 / 1000000.0;
+    TEST_CHK(BSP_DlyCntsPerUS == 2);
+    OSTimeDly(1);
+    (void)Test_Dly(100,  100 / 3 + DLY_ERR_MAX_US);             /* Long by up to a third, never short.                  */
+    OSTimeDly(1);
+    (void)Test_Dly(1000, 1000 / 3 + DLY_ERR_MAX_US);
+
+    Test_Done("test_bsp_dly");
+}
+
+
+int  main (void)
+{
+    OSInit();
+    (void)OSTaskCreateExt(TestTask,
+                          (void *)0,
+                          &TestTaskStk[TEST_TASK_STK_SIZE - 1],
+                          TEST_TASK_PRIO,
+                          TEST_TASK_PRIO,
+                          &TestTaskStk[0],
+                          TEST_TASK_STK_SIZE,
+                          (void *)0,
+                          OS_TASK_OPT_NONE);
+    OSStart();
+    return (0);
+}
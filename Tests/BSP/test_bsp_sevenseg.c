@@ -0,0 +1,472 @@
+/*
+*********************************************************************************************************
+*                                             HOST TESTS
+*
+*                            Dragon12 BSP 7-Segment Multiplexing, SevenSegDisp_ISR_Handler()
+*
+* Filename      : test_bsp_sevenseg.c
+* Note(s)       : (1) The Dragon12 'sevenSegment.c' is included unchanged, over simulated MC9S12 port & ECT
+*                     registers.  The ISR is called directly, as the OC channel's vector would.
+*
+*                 (2) Old_ISR_Handler() is the ISR 'sevenSegment.c' had before the patterns were prepared
+*                     by SevenSegWrite(): the 4 digits divided out of 'outputNum' & looked up in a switch
+*                     on every interrupt.  At full brightness both MUST drive the same port values, slot
+*                     after slot, for every number 0 to 9999.
+*
+*                 (3) Slots: SevenSegWrite() MUST show the most significant digit on block 0.  At 100%
+*                     one interrupt per slot, nbrCnts counts apart; dimmed, a lit & a dark phase adding up
+*                     to nbrCnts, neither shorter than SEVEN_SEG_PHASE_MIN_US; at 0% no block is lit.
+*
+*                 (4) Benchmark, in host ns: both ISRs called through a vector, & SevenSegWrite() which now
+*                     does the divisions once per value.  These are HOST figures: gcc turns the divisions
+*                     by constants of the old ISR into multiplies, the HCS12 runs them as IDIV/EDIV, so the
+*                     host understates the saving.  On the board, SEVEN_SEG_ISR_TIME_EN records the ISR's
+*                     TCNT counts.
+*
+*                 (5) Glyphs: hexadecimal A to F, with lower case b & d; signed values right aligned behind
+*                     blanks, a minus sign in front & clamped to -999..9999; text with the '.' folded into
+*                     the previous block; blank for characters without a glyph; & the decimal points of
+*                     SevenSegDPSet() on the numeric writes only.
+*
+*                 (6) The Makefile also checks that a SEVEN_SEG_REFRESH_HZ too low for the 16-bit output
+*                     compare (nbrCnts) stops the build with the #error of 'sevenSegment.c'.
+*********************************************************************************************************
+*/
+
+#include  <includes.h>
+
+
+/*
+*********************************************************************************************************
+*                                    SIMULATED MC9S12 REGISTERS
+*********************************************************************************************************
+*/
+
+#define  SEVEN_SEG_OC                      0
+
+static  volatile  INT8U   PTP, DDRP, PORTB, PTJ;
+static  volatile  INT8U   TIOS, TIE, TFLG1, TSCR1, TSCR2 = 2;   /* ECT prescaler 4, as BSP_Init() sets it.              */
+static  volatile  INT16U  TCNT, TC0, TC1, TC2, TC3, TC4, TC5, TC6, TC7;
+
+#include  <bsp.h>
+#include  <sevenSegment.h>
+#include  <sevenSegment.c>
+
+
+/*
+*********************************************************************************************************
+*                                            LOCAL DEFINES
+*********************************************************************************************************
+*/
+
+#define  SLOT_CNTS     (BUS_CLK_FREQ / (BSP_ECT_PRESCALER * SEVEN_SEG_NBR_DIG * SEVEN_SEG_REFRESH_HZ) - 1)
+#define  PHASE_MIN_CNTS (BUS_CLK_FREQ / (BSP_ECT_PRESCALER * (1000000L / SEVEN_SEG_PHASE_MIN_US)))
+
+#define  MEAS_NBR                   10000000
+
+
+/*
+*********************************************************************************************************
+*                                        LOCAL GLOBAL VARIABLES
+*********************************************************************************************************
+*/
+
+static  OS_STK            TestTaskStk[TEST_TASK_STK_SIZE];
+
+static  INT16U            outputNum;                            /* Old ISR's state, see Note #2.                        */
+static  INT8U             oldBlockNum;
+
+static  void   (*volatile Vect)(void);                          /* Keeps the ISR out of the benchmark loop.             */
+
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                          Old_ISR_Handler()
+*
+* Description : The multiplexing ISR before the segment patterns were precomputed (see Note #2).
+*********************************************************************************************************
+*/
+
+static  void  Old_SevenSegOut (INT8U digit)
+{
+    PTJ |= (1 << 1);
+
+    switch (digit) {
+        case 0:    PORTB = SSD_0;  break;
+        case 1:    PORTB = SSD_1;  break;
+        case 2:    PORTB = SSD_2;  break;
+        case 3:    PORTB = SSD_3;  break;
+        case 4:    PORTB = SSD_4;  break;
+        case 5:    PORTB = SSD_5;  break;
+        case 6:    PORTB = SSD_6;  break;
+        case 7:    PORTB = SSD_7;  break;
+        case 8:    PORTB = SSD_8;  break;
+        case 9:    PORTB = SSD_9;  break;
+        case 'A':  PORTB = SSD_A;  break;
+        case 'B':  PORTB = SSD_B;  break;
+        case 'C':  PORTB = SSD_C;  break;
+        case 'D':  PORTB = SSD_D;  break;
+        case 'E':  PORTB = SSD_E;  break;
+        case 'F':  PORTB = SSD_F;  break;
+        default:                   break;
+    }
+}
+
+
+static  void  Old_ISR_Handler (void)
+{
+    INT8U  digits[4];
+    INT8U  currDispNum;
+
+
+    PTP         |= 0x0F;
+    currDispNum  = ((oldBlockNum) % 4);
+    oldBlockNum++;
+
+    digits[0]    = (INT8U) (outputNum / 1000);
+    digits[1]    = (INT8U)((outputNum % 1000) / 100);
+    digits[2]    = (INT8U)((outputNum % 100)  / 10);
+    digits[3]    = (INT8U) (outputNum % 10);
+
+    Old_SevenSegOut(digits[currDispNum]);
+    PTP         &= ~(1 << currDispNum);
+
+    TFLG1       |= 0x01;
+    TC0         += nbrCnts;
+}
+
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                             Test_Same()
+*
+* Description : See Note #2.
+*********************************************************************************************************
+*/
+
+static  void  Test_Same (void)
+{
+    INT16U      num;
+    INT8U       slot;
+    INT8U       old_portb;
+    INT8U       old_ptp;
+    INT16U      old_tc;
+    INT16U      tc;
+    CPU_INT32U  bad;
+
+
+    SevenSegBrightnessSet(100);
+    oldBlockNum = actBlockNum;
+    bad         = 0;
+    for (num = 0; num <= 9999; num++) {
+        outputNum = num;
+        SevenSegWrite(num);
+        for (slot = 0; slot < SEVEN_SEG_NBR_DIG; slot++) {
+            tc = TC0;
+            Old_ISR_Handler();
+            old_portb = PORTB;
+            old_ptp   = PTP;
+            old_tc    = TC0 - tc;
+
+            PORTB = 0;
+            PTP   = 0;
+            tc    = TC0;
+            SevenSegDisp_ISR_Handler();
+            if ((PORTB != old_portb) || (PTP != old_ptp) || ((INT16U)(TC0 - tc) != old_tc)) {
+                bad++;
+            }
+        }
+    }
+    TEST_CHK(bad == 0);
+}
+
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                            Test_Slots()
+*
+* Description : See Note #3.
+*********************************************************************************************************
+*/
+
+static  void  Test_Slots (void)
+{
+    static  const  INT8U  pat_1234[] = {SSD_1, SSD_2, SSD_3, SSD_4};
+    INT8U                 slot;
+    INT16U                on;
+    INT16U                off;
+    INT16U                tc;
+    CPU_INT32U            bad;
+
+
+    TEST_CHK(nbrCnts == SLOT_CNTS);
+    TEST_CHK(minCnts == PHASE_MIN_CNTS);
+
+    SevenSegBrightnessSet(100);
+    SevenSegWrite(1234);
+    bad = 0;
+    for (slot = 0; slot < SEVEN_SEG_NBR_DIG; slot++) {          /* Most significant digit on block 0.                   */
+        tc = TC0;
+        SevenSegDisp_ISR_Handler();
+        if ((PORTB != pat_1234[slot]) || ((PTP & 0x0F) != (0x0F & ~(1 << slot))) ||
+            ((INT16U)(TC0 - tc) != nbrCnts) || (TFLG1 != SEVEN_SEG_OC_MASK)) {
+            bad++;
+        }
+    }
+    TEST_CHK(bad == 0);
+
+    SevenSegBrightnessSet(50);                                  /* Lit, then dark for the rest of the slot.             */
+    bad = 0;
+    for (slot = 0; slot < SEVEN_SEG_NBR_DIG; slot++) {
+        tc  = TC0;
+        SevenSegDisp_ISR_Handler();
+        on  = TC0 - tc;
+        if (((PTP & 0x0F) != (0x0F & ~(1 << slot))) || (on != nbrCnts / 2)) {
+            bad++;
+        }
+        tc  = TC0;
+        SevenSegDisp_ISR_Handler();
+        off = TC0 - tc;
+        if (((PTP & 0x0F) != 0x0F) || (on + off != nbrCnts)) {
+            bad++;
+        }
+    }
+    TEST_CHK(bad == 0);
+
+    SevenSegBrightnessSet(1);                                   /* Phases stretched to SEVEN_SEG_PHASE_MIN_US.          */
+    tc  = TC0;
+    SevenSegDisp_ISR_Handler();
+    on  = TC0 - tc;
+    SevenSegDisp_ISR_Handler();
+    TEST_CHK(on == minCnts);
+    SevenSegBrightnessSet(99);
+    tc  = TC0;
+    SevenSegDisp_ISR_Handler();
+    SevenSegDisp_ISR_Handler();
+    off = TC0 - tc;
+    TEST_CHK(off == nbrCnts);
+    TEST_CHK(onCnts == nbrCnts - minCnts);
+
+    SevenSegBrightnessSet(0);                                   /* No block ever lit.                                   */
+    bad = 0;
+    for (slot = 0; slot < 2 * SEVEN_SEG_NBR_DIG; slot++) {
+        tc = TC0;
+        SevenSegDisp_ISR_Handler();
+        if (((PTP & 0x0F) != 0x0F) || ((INT16U)(TC0 - tc) != nbrCnts)) {
+            bad++;
+        }
+    }
+    TEST_CHK(bad == 0);
+    SevenSegBrightnessSet(100);
+}
+
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                           Test_Glyphs()
+*
+* Description : See Note #5.  Test_Pat() compares the patterns handed to the ISR, most significant first.
+*********************************************************************************************************
+*/
+
+static  CPU_BOOLEAN  Test_Pat (INT8U pat0, INT8U pat1, INT8U pat2, INT8U pat3)
+{
+    INT8U  *pat;
+
+
+    pat = &segPat[segPatIx][0];
+    return ((pat[0] == pat0) && (pat[1] == pat1) && (pat[2] == pat2) && (pat[3] == pat3));
+}
+
+
+static  void  Test_Str (const char *pstr)                       /* CPU_CHAR is unsigned on the host.                    */
+{
+    SevenSegWriteStr((const CPU_CHAR *)pstr);
+}
+
+
+static  void  Test_Glyphs (void)
+{
+                                                                /* b, d & E: segments a..g are bits 0..6.               */
+    TEST_CHK((SSD_B == 0x7C) && (SSD_D == 0x5E) && (SSD_E == 0x79));
+
+    SevenSegWriteHex(0xABCD);                                   /* ---------------- HEXADECIMAL ----------------------- */
+    TEST_CHK(Test_Pat(SSD_A, SSD_B, SSD_C, SSD_D));
+    SevenSegWriteHex(0xEF09);
+    TEST_CHK(Test_Pat(SSD_E, SSD_F, SSD_0, SSD_9));
+
+    SevenSegWriteSigned(-999);                                  /* ------------------- SIGNED ------------------------- */
+    TEST_CHK(Test_Pat(SSD_MINUS, SSD_9, SSD_9, SSD_9));
+    SevenSegWriteSigned(-1);
+    TEST_CHK(Test_Pat(0x00, 0x00, SSD_MINUS, SSD_1));
+    SevenSegWriteSigned(0);
+    TEST_CHK(Test_Pat(0x00, 0x00, 0x00, SSD_0));
+    SevenSegWriteSigned(42);
+    TEST_CHK(Test_Pat(0x00, 0x00, SSD_4, SSD_2));
+    SevenSegWriteSigned(-1000);                                 /* Clamped.                                             */
+    TEST_CHK(Test_Pat(SSD_MINUS, SSD_9, SSD_9, SSD_9));
+    SevenSegWriteSigned(-32768);
+    TEST_CHK(Test_Pat(SSD_MINUS, SSD_9, SSD_9, SSD_9));
+    SevenSegWriteSigned(10000);
+    TEST_CHK(Test_Pat(SSD_9, SSD_9, SSD_9, SSD_9));
+    SevenSegWriteSigned(32767);
+    TEST_CHK(Test_Pat(SSD_9, SSD_9, SSD_9, SSD_9));
+
+    Test_Str("STOP");                                           /* -------------------- TEXT -------------------------- */
+    TEST_CHK(Test_Pat(SSD_5, 0x78, SSD_0, 0x73));
+    Test_Str("SAFE");
+    TEST_CHK(Test_Pat(SSD_5, SSD_A, SSD_F, SSD_E));
+    Test_Str("safe");
+    TEST_CHK(Test_Pat(SSD_5, SSD_A, SSD_F, SSD_E));
+    Test_Str("Err");
+    TEST_CHK(Test_Pat(SSD_E, 0x50, 0x50, 0x00));
+    Test_Str("12.34");                                          /* DP folded into the previous block ...                */
+    TEST_CHK(Test_Pat(SSD_1, SSD_2 | SSD_DP, SSD_3, SSD_4));
+    Test_Str("-1.5");
+    TEST_CHK(Test_Pat(SSD_MINUS, SSD_1 | SSD_DP, SSD_5, 0x00));
+    Test_Str(".5");                                             /* ... or a block of its own when there is none ...     */
+    TEST_CHK(Test_Pat(SSD_DP, SSD_5, 0x00, 0x00));
+    Test_Str("1..2");                                           /* ... or it already has one.                           */
+    TEST_CHK(Test_Pat(SSD_1 | SSD_DP, SSD_DP, SSD_2, 0x00));
+    Test_Str("1234.");
+    TEST_CHK(Test_Pat(SSD_1, SSD_2, SSD_3, SSD_4 | SSD_DP));
+    Test_Str("123456");                                         /* Extra characters dropped.                            */
+    TEST_CHK(Test_Pat(SSD_1, SSD_2, SSD_3, SSD_4));
+    Test_Str("KmW");                                            /* No glyph: blank.                                     */
+    TEST_CHK(Test_Pat(0x00, 0x00, 0x00, 0x00));
+    Test_Str("#~\001");
+    TEST_CHK(Test_Pat(0x00, 0x00, 0x00, 0x00));
+    Test_Str("");
+    TEST_CHK(Test_Pat(0x00, 0x00, 0x00, 0x00));
+
+    SevenSegDPSet(0x04);                                        /* -------------- DECIMAL POINTS ---------------------- */
+    SevenSegWrite(1234);
+    TEST_CHK(Test_Pat(SSD_1, SSD_2 | SSD_DP, SSD_3, SSD_4));
+    SevenSegDPSet(0x09);
+    SevenSegWriteHex(0xBEEF);
+    TEST_CHK(Test_Pat(SSD_B | SSD_DP, SSD_E, SSD_E, SSD_F | SSD_DP));
+    SevenSegDPSet(0x02);
+    SevenSegWriteSigned(-15);
+    TEST_CHK(Test_Pat(0x00, SSD_MINUS, SSD_1 | SSD_DP, SSD_5));
+    Test_Str("STOP");                                           /* Not applied to text.                                 */
+    TEST_CHK(Test_Pat(SSD_5, 0x78, SSD_0, 0x73));
+    SevenSegDPSet(0xFF);                                        /* Only 4 blocks.                                       */
+    TEST_CHK(dpMask == 0x0F);
+    SevenSegDPSet(0x00);
+    SevenSegWrite(1234);
+    TEST_CHK(Test_Pat(SSD_1, SSD_2, SSD_3, SSD_4));
+}
+
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                            Test_Bench()
+*
+* Description : See Note #4.
+*********************************************************************************************************
+*/
+
+static  double  Test_BenchISR (void (*isr)(void))
+{
+    CPU_INT32U          i;
+    unsigned long long  t0;
+
+
+    Vect = isr;
+    t0   = Test_TimeNs();
+    for (i = 0; i < MEAS_NBR; i++) {
+        outputNum = (INT16U)(i % 10000);                        /* Same bookkeeping for both ISRs.                      */
+        (*Vect)();
+    }
+    return ((double)(Test_TimeNs() - t0) / MEAS_NBR);
+}
+
+
+static  void  Test_Bench (void)
+{
+    CPU_INT32U          i;
+    unsigned long long  t0;
+    double              ns_old;
+    double              ns_new;
+    double              ns_wr;
+    double              isr_per_sec;
+
+
+    ns_old = Test_BenchISR(Old_ISR_Handler);
+    ns_new = Test_BenchISR(SevenSegDisp_ISR_Handler);
+
+    t0 = Test_TimeNs();
+    for (i = 0; i < MEAS_NBR / 10; i++) {
+        SevenSegWrite((INT16U)(i % 10000));
+    }
+    ns_wr = (double)(Test_TimeNs() - t0) / (MEAS_NBR / 10);
+
+    isr_per_sec = (double)SEVEN_SEG_NBR_DIG * SEVEN_SEG_REFRESH_HZ;
+    printf("host, per interrupt: old ISR %5.2f ns, new ISR %5.2f ns (%.1fx); SevenSegWrite() %5.2f ns\n",
+           ns_old, ns_new, ns_old / ns_new, ns_wr);
+    printf("host, per second at %.0f interrupts: old %6.0f ns, new %6.0f ns + %5.2f ns per SevenSegWrite()\n",
+           isr_per_sec, ns_old * isr_per_sec, ns_new * isr_per_sec, ns_wr);
+    printf("%u-bit TC, prescaler %u: %u Hz refresh is the lowest that fits (nbrCnts %lu at %u Hz)\n",
+           16u, (unsigned)BSP_ECT_PRESCALER,
+           (unsigned)((BUS_CLK_FREQ / (BSP_ECT_PRESCALER * SEVEN_SEG_NBR_DIG * 65536L)) + 1),
+           (unsigned long)nbrCnts, (unsigned)SEVEN_SEG_REFRESH_HZ);
+}
+
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                             TestTask()
+*********************************************************************************************************
+*/
+
+static  void  TestTask (void *p_arg)
+{
+    (void)p_arg;
+    SevenSegDisp_Init();
+    TEST_CHK((TIOS & TIE & SEVEN_SEG_OC_MASK) != 0);
+    TEST_CHK((DDRP & SEVEN_SEG_DIG_MASK) == SEVEN_SEG_DIG_MASK);
+
+    Test_Slots();
+    Test_Glyphs();
+    Test_Same();
+    Test_Bench();
+
+    Test_Done("test_bsp_sevenseg");
+}
+
+
+int  main (void)
+{
+    OSInit();
+    (void)OSTaskCreateExt(TestTask,
+                          (void *)0,
+                          &TestTaskStk[TEST_TASK_STK_SIZE - 1],
+                          TEST_TASK_PRIO,
+                          TEST_TASK_PRIO,
+                          &TestTaskStk[0],
+                          TEST_TASK_STK_SIZE,
+                          (void *)0,
+                          OS_TASK_OPT_NONE);
+    OSStart();
+    return (0);
+}
+
+
+/*
+*********************************************************************************************************
+*                                          BSP_CPU_ClkFreq()
+*
+* Description : Stand-in for 'bsp.c': the CPU runs at twice the bus clock.
+*********************************************************************************************************
+*/
+
+INT32U  BSP_CPU_ClkFreq (void)
+{
+    return (2 * BUS_CLK_FREQ);
+}
@@ -0,0 +1,72 @@
+/*
+*********************************************************************************************************
+*                                    Host Test Application Configuration
+*
+*                                   CHANGE SETTINGS ACCORDINGLY
+*
+*
+* File : app_cfg.h
+* By   : Eric Shufro
+*
+* Note(s) : (1) Settings wrapped in #ifndef can be overridden with -D (see 'Tests/Makefile').
+*********************************************************************************************************
+*/
+
+#ifndef  APP_CFG_H
+#define  APP_CFG_H
+
+/*
+*********************************************************************************************************
+*                                        INCLUDES
+*********************************************************************************************************
+*/
+
+#include  <lib_def.h>
+
+
+/*
+*********************************************************************************************************
+*                                    TASK PRIORITIES!
+*********************************************************************************************************
+*/
+
+#define  OS_TASK_DPC_PRIO                   0                           /* Set the prio of the DPC task, highest                    */
+#define  TEST_TASK_PRIO                     5                           /* Set the prio of the task that drives each test           */
+#define  DISP_TASK_PRIO                     7                           /* Set the prio for the uC/LCD Task (owns the LCD bus)      */
+#define  OS_TASK_TMR_PRIO                  40                           /* Set the prio of the tmr task, near lowest                */
+
+
+/*
+*********************************************************************************************************
+*                                    TASK STACK SIZES!
+*********************************************************************************************************
+*/
+
+#define  TEST_TASK_STK_SIZE               256                           /* Stack sizes are nominal, see 'os_cpu_c.c'                */
+#define  DISP_TASK_STK_SIZE               256
+
+
+/*
+*********************************************************************************************************
+*                                  uC/LIB CONFIGURATION
+*********************************************************************************************************
+*/
+
+#define  uC_CFG_OPTIMIZE_ASM_EN         DEF_DISABLED
+#define  LIB_STR_CFG_FP_EN              DEF_ENABLED
+
+
+/*
+*********************************************************************************************************
+*                                          uC/LCD
+*********************************************************************************************************
+*/
+
+#define  DISP_BUS_WIDTH                     4                           /* Same as the Dragon12, see 'uC-LCD/lcd_sim.c'             */
+#define  DISP_SHADOW_MAX_ROWS               2
+#define  DISP_SHADOW_MAX_COLS              16
+#define  DISP_TASK_Q_SIZE                  16
+#define  DISP_TASK_STR_SIZE                17
+
+
+#endif
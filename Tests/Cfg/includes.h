@@ -0,0 +1,43 @@
+#ifndef INCLUDES_H
+#define INCLUDES_H
+
+/*
+*********************************************************************************************************
+*                                           Master Include File
+*
+* File : includes.h
+* By   : Eric Shufro
+*
+* Note(s) : (1) Host test build (see 'Tests/Makefile').
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*                                           FILES TO INCLUDE
+*********************************************************************************************************
+*/
+
+                                                                /* ---------------- STD INCLUDE FILES ----------------- */
+#include  <string.h>
+#include  <stddef.h>
+#include  <stdio.h>
+#include  <stdlib.h>
+
+                                                                /* -------------- MICRIUM INCLUDE FILES --------------- */
+#include  <cpu_def.h>                                           /* uC/CPU, processor specifics.                         */
+#include  <cpu.h>
+
+#include  <lib_def.h>                                           /* uC/LIB.                                              */
+#include  <lib_str.h>
+#include  <lib_mem.h>
+
+#include  <ucos_ii.h>                                           /* uC/OS-II.                                            */
+
+#include  <lcd.h>                                               /* uC/LCD.                                              */
+
+                                                                /* -------------- TEST INCLUDE FILES ------------------ */
+#include  <test.h>
+
+
+#endif                                                          /* End of file.                                         */
@@ -0,0 +1,175 @@
+/*
+*********************************************************************************************************
+*                                      uC/Probe Communication
+*
+*                           (c) Copyright 2007; Micrium, Inc.; Weston, FL
+*
+*               All rights reserved.  Protected by international copyright laws.
+*               Knowledge of the source code may NOT be used to develop a similar product.
+*               Please help us continue to provide the Embedded community with the finest
+*               software available.  Your honesty is greatly appreciated.
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*
+*                                              uC/Probe
+*
+*                                Communication: Host Test Configuration
+*
+* Filename      : probe_com_cfg.h
+* Version       : V1.00
+* Programmer(s) : BAN
+* Note(s)       : (1) The Dragon12 settings ('OS-Probe-LCD/Sources/probe_com_cfg.h').  Settings wrapped in
+*                     #ifndef can be overridden with -D (see 'Tests/Makefile').
+*
+*                 (2) The parse task runs above TEST_TASK_PRIO, so it takes a packet signalled by the
+*                     simulated SCI at once, as it would on the target (see 'Tests/uC-Probe/probe_sim.c').
+*
+*                 (3) With -DPROBE_COM_ATOMIC_GCC the telemetry pool uses the GCC atomic builtins, as a port
+*                     with compare-and-swap would, instead of the critical sections of the default
+*                     PROBE_COM_ATOMIC_LD/ST/CAS.
+*
+*                 (4) PROBE_COM_SUPPORT_REGION is DEF_FALSE here, though the board enables it: the other
+*                     tests read host memory that the Dragon12 table does not describe.  test_probe_region
+*                     enables it with -D.
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*                                    CHOOSE COMMUNICATION METHOD
+*********************************************************************************************************
+*/
+
+#ifndef  PROBE_COM_METHOD_RS232
+#define  PROBE_COM_METHOD_RS232           DEF_TRUE
+#endif
+#ifndef  PROBE_COM_METHOD_TCPIP
+#define  PROBE_COM_METHOD_TCPIP           DEF_FALSE
+#endif
+
+/*
+*********************************************************************************************************
+*                            CONFIGURE GENERAL COMMUNICATION PARAMETERS
+*********************************************************************************************************
+*/
+
+#ifndef  PROBE_COM_RX_MAX_SIZE
+#define  PROBE_COM_RX_MAX_SIZE               64
+#endif
+#ifndef  PROBE_COM_TX_MAX_SIZE
+#define  PROBE_COM_TX_MAX_SIZE               64
+#endif
+
+#ifndef  PROBE_COM_SUPPORT_WR
+#define  PROBE_COM_SUPPORT_WR              DEF_FALSE
+#endif
+#define  PROBE_COM_SUPPORT_STR             DEF_FALSE
+
+#ifndef  PROBE_COM_SUPPORT_TELEMETRY
+#define  PROBE_COM_SUPPORT_TELEMETRY       DEF_FALSE
+#endif
+#if     (PROBE_COM_SUPPORT_TELEMETRY == DEF_TRUE)               /* If telemetry is supported                                */
+#ifndef  PROBE_COM_TELEMETRY_NBR
+#define  PROBE_COM_TELEMETRY_NBR              8                 /*   (a) Set nbr of telemetry buffers                       */
+#endif
+#define  PROBE_COM_TELEMETRY_BUF_LEN         32                 /*   (b) Set size of each telemetry buffer                  */
+#ifdef   PROBE_COM_ATOMIC_GCC                                   /*   (c) Use the GCC atomic builtins (see Note #3)          */
+#define  PROBE_COM_ATOMIC_LD(pvar)                   __atomic_load_n((pvar), __ATOMIC_ACQUIRE)
+#define  PROBE_COM_ATOMIC_ST(pvar, val)              __atomic_store_n((pvar), (val), __ATOMIC_RELEASE)
+#define  PROBE_COM_ATOMIC_CAS(pvar, val_old, val_new)  ((__sync_bool_compare_and_swap((pvar), (val_old), (val_new))) ? DEF_YES : DEF_NO)
+#endif
+#endif
+
+#ifndef  PROBE_COM_SUPPORT_STREAM
+#define  PROBE_COM_SUPPORT_STREAM          DEF_TRUE
+#endif
+#if     (PROBE_COM_SUPPORT_STREAM == DEF_TRUE)                  /* If symbol streaming is supported                         */
+#define  PROBE_COM_STREAM_SYM_NBR             8                 /*   (a) Set max nbr of symbols in the stream set           */
+#endif
+
+#ifndef  PROBE_COM_SUPPORT_DELTA
+#define  PROBE_COM_SUPPORT_DELTA           DEF_TRUE
+#endif
+#if     (PROBE_COM_SUPPORT_DELTA  == DEF_TRUE)                  /* If delta reads are supported                             */
+#define  PROBE_COM_DELTA_KEY_PERIOD          32                 /*   (a) Set nbr of delta responses between keyframes       */
+#endif
+
+#ifndef  PROBE_COM_SUPPORT_SG
+#define  PROBE_COM_SUPPORT_SG              DEF_TRUE
+#endif
+#if     (PROBE_COM_SUPPORT_SG     == DEF_TRUE)                  /* If scattered (zero-copy) read responses are supported    */
+#ifndef  PROBE_COM_SG_SEG_NBR
+#define  PROBE_COM_SG_SEG_NBR                13                 /*   (a) Set max nbr of segments per response               */
+#endif
+#define  PROBE_COM_SG_MAX_SIZE             4096                 /*   (b) Set max size of a scattered response               */
+#endif
+
+#ifndef  PROBE_COM_SUPPORT_CRC16
+#define  PROBE_COM_SUPPORT_CRC16           DEF_TRUE             /* Accept packets framed with a CRC-16 (RS-232)             */
+#endif
+
+#ifndef  PROBE_COM_SUPPORT_SYM
+#define  PROBE_COM_SUPPORT_SYM             DEF_FALSE            /* Answer symbol lookups from 'probe_com_sym.c'             */
+#endif
+
+#ifndef  PROBE_COM_SUPPORT_REGION
+#define  PROBE_COM_SUPPORT_REGION          DEF_FALSE            /* Check memory accesses against 'probe_com_region.c'       */
+#endif
+
+/*
+*********************************************************************************************************
+*                               CONFIGURE STATISTICS AND COUNTERS
+*********************************************************************************************************
+*/
+
+#define  PROBE_COM_STAT_EN                 DEF_ENABLED
+
+/*
+*********************************************************************************************************
+*                              CONFIGURE RS-232 SPECIFIC PARAMETERS
+*********************************************************************************************************
+*/
+
+#if     (PROBE_COM_METHOD_RS232 == DEF_TRUE)                    /* For the RS-232 communication method                      */
+
+#ifndef  PROBE_RS232_PARSE_TASK
+#define  PROBE_RS232_PARSE_TASK            DEF_TRUE             /*  (a) Set whether a task will handle parsing              */
+#endif
+
+#if     (PROBE_RS232_PARSE_TASK == DEF_TRUE)                    /*  (b) If a task will handle parsing                       */
+#define  PROBE_RS232_TASK_PRIO                4                 /*       (i) Set task priority (see Note #2)                */
+#define  PROBE_RS232_TASK_STK_SIZE          160                 /*      (ii) Set task stack size                            */
+#endif
+
+#define  PROBE_RS232_RX_BUF_SIZE       PROBE_COM_RX_MAX_SIZE    /*  (c) Set Rx buffer size                                  */
+#define  PROBE_RS232_TX_BUF_SIZE       PROBE_COM_TX_MAX_SIZE    /*  (d) Set Tx buffer size                                  */
+#ifndef  PROBE_RS232_PIPE_DEPTH
+#define  PROBE_RS232_PIPE_DEPTH               2                 /*  (e) Set nbr of Rx & Tx buffers (requests in flight)     */
+#endif
+
+#define  PROBE_RS232_UART_0                   1
+#define  PROBE_RS232_UART_1                   2
+#define  PROBE_RS232_COMM_SEL           PROBE_RS232_UART_1      /*  (f) Configure UART selection                            */
+
+#endif
+
+/*
+*********************************************************************************************************
+*                              CONFIGURE TCP-IP SPECIFIC PARAMETERS
+*********************************************************************************************************
+*/
+
+#if     (PROBE_COM_METHOD_TCPIP == DEF_TRUE)                    /* For the TCP-IP communication method                      */
+
+#define  PROBE_TCPIP_PORT                   9930                /*  (a) Set listening port of the UDP server                */
+
+#define  PROBE_TCPIP_RX_BUF_SIZE       PROBE_COM_RX_MAX_SIZE    /*  (b) Set Rx buffer size                                  */
+#define  PROBE_TCPIP_TX_BUF_SIZE       PROBE_COM_TX_MAX_SIZE    /*  (c) Set Tx buffer size                                  */
+
+#define  PROBE_TCPIP_TASK_PRIO                11                /*  (d) Set task priority                                   */
+#define  PROBE_TCPIP_TASK_STK_SIZE          1024                /*  (e) Set task stack size                                 */
+
+#endif
@@ -0,0 +1,96 @@
+/*
+*********************************************************************************************************
+*                                             HOST TESTS
+*
+*                                           Test Helpers
+*
+* Filename      : test.h
+* Note(s)       : (1) Each test is a host program.  It prints what it measures, & exits with a non-zero
+*                     status if any TEST_CHK() failed (see 'Tests/Makefile').
+*********************************************************************************************************
+*/
+
+#ifndef  TEST_H
+#define  TEST_H
+
+#include  <stdio.h>
+#include  <stdlib.h>
+#include  <time.h>
+
+
+/*
+*********************************************************************************************************
+*                                               MACRO'S
+*********************************************************************************************************
+*/
+
+#define  TEST_CHK(cond)         Test_Chk((cond) ? 1 : 0, #cond, __FILE__, __LINE__)
+
+
+/*
+*********************************************************************************************************
+*                                          GLOBAL VARIABLES
+*********************************************************************************************************
+*/
+
+static  unsigned  long  Test_NbrChk;
+static  unsigned  long  Test_NbrFail;
+
+
+/*
+*********************************************************************************************************
+*                                             Test_Chk()
+*
+* Description : Record the result of one check; print it if it failed.
+*********************************************************************************************************
+*/
+
+static  inline  void  Test_Chk (int          ok,
+                                const char  *expr,
+                                const char  *file,
+                                int          line)
+{
+    Test_NbrChk++;
+    if (ok == 0) {
+        Test_NbrFail++;
+        printf("%s:%d: FAILED: %s\n", file, line, expr);
+    }
+}
+
+
+/*
+*********************************************************************************************************
+*                                             Test_Done()
+*
+* Description : Print the summary & end the program.
+*
+* Note(s)     : (1) Tests running under uC/OS-II call this from a task; it does not return.
+*********************************************************************************************************
+*/
+
+static  inline  void  Test_Done (const char  *name)
+{
+    printf("%s: %lu checks, %lu failed\n", name, Test_NbrChk, Test_NbrFail);
+    fflush(stdout);
+    exit((Test_NbrFail == 0) ? 0 : 1);
+}
+
+
+/*
+*********************************************************************************************************
+*                                            Test_TimeNs()
+*
+* Description : Read a monotonic clock, in nanoseconds.
+*********************************************************************************************************
+*/
+
+static  inline  unsigned  long  long  Test_TimeNs (void)
+{
+    struct  timespec  ts;
+
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ((unsigned long long)ts.tv_sec * 1000000000uLL + (unsigned long long)ts.tv_nsec);
+}
+
+#endif
@@ -0,0 +1,402 @@
+/*
+*********************************************************************************************************
+*                                             HOST TESTS
+*
+*                                   Simulated HD44780 on the Dragon12 Port
+*
+* Filename      : lcd_sim.c
+* Note(s)       : (1) See 'lcd_sim.h'.  The port functions below follow the Dragon12 'bsp.c' line for line:
+*                     only D7..D4 are wired, so in 8 bit mode (after power up) every nibble strobed is a
+*                     whole instruction whose lower bits read 0.  The module switches to 4 bit transfers
+*                     on the 'function set' with DL = 0.
+*
+*                 (2) Only what uC/LCD uses is modelled: DDRAM of a 2 line module (DISP_LINE_LEN characters
+*                     at 0x00 & 0x40), CGRAM, the address counter, the display shift & the busy flag.
+*********************************************************************************************************
+*/
+
+#include  <includes.h>
+#include  "lcd_sim.h"
+
+
+/*
+*********************************************************************************************************
+*                                            LOCAL DEFINES
+*********************************************************************************************************
+*/
+
+#if (DISP_BUSY_FLAG_EN > 0)                                     /* Same strobe delays as 'bsp.c'.                       */
+#define  LCD_STROBE_US                     1
+#else
+#define  LCD_STROBE_US                   100
+#endif
+
+#define  DISP_SIM_LINE2_ADDR            0x40                    /* DDRAM address of the second line.                    */
+#define  DISP_SIM_PWR_UP_CHAR            '?'                    /* DDRAM content is undefined after power up.           */
+
+
+/*
+*********************************************************************************************************
+*                                        LOCAL GLOBAL VARIABLES
+*********************************************************************************************************
+*/
+
+static  CPU_INT08U     DispSimDDRAM[2][DISP_LINE_LEN];
+static  CPU_INT08U     DispSimCGRAM[8][8];
+
+static  CPU_INT08U     DispSimRS;                               /* Register selected with DispSel().                    */
+static  CPU_BOOLEAN    DispSimBus8;                             /* DEF_YES until the 4 bit 'function set'.              */
+static  CPU_BOOLEAN    DispSimNibblePend;                       /* Upper nibble of a 4 bit transfer was latched.        */
+static  CPU_INT08U     DispSimNibble;
+static  CPU_INT08U     DispSimAC;                               /* Address counter.                                     */
+static  CPU_BOOLEAN    DispSimACInCG;                           /* AC points into CGRAM.                                */
+static  CPU_BOOLEAN    DispSimInc;                              /* Entry mode: increment the AC.                        */
+static  CPU_INT08U     DispSimShift;                            /* Columns the display is shifted left.                 */
+
+static  CPU_INT32U     DispSimClk;                              /* Simulated time, in us.                               */
+static  CPU_INT32U     DispSimBusyEnd;                          /* Busy flag is set until then.                         */
+#if (DISP_BUSY_FLAG_EN > 0)
+static  CPU_BOOLEAN    DispSimBusyStuck;                        /* Busy flag always reads 1, see DispSimBusyStuckSet(). */
+#endif
+
+static  DISP_SIM_STAT  DispSimStat;
+
+
+/*
+*********************************************************************************************************
+*                                       LOCAL FUNCTION PROTOTYPES
+*********************************************************************************************************
+*/
+
+static  void  DispSimNibbleWr(CPU_INT08U  nibble);
+static  void  DispSimExec    (CPU_INT08U  data);
+static  void  DispSimACInc   (void);
+
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                           DispSimStatClr()
+*                                           DispSimStatGet()
+*
+* Description : Clear / read the counters of the simulated module (see DISP_SIM_STAT).
+*********************************************************************************************************
+*/
+
+void  DispSimStatClr (void)
+{
+    Mem_Clr((void *)&DispSimStat, sizeof(DispSimStat));
+}
+
+
+void  DispSimStatGet (DISP_SIM_STAT  *pstat)
+{
+    *pstat = DispSimStat;
+}
+
+
+/*
+*********************************************************************************************************
+*                                           DispSimRowGet()
+*
+* Description : Read the characters a row of the display shows, taking the display shift into account.
+*
+* Argument(s) : row         Row of the display, 0 to 3 (rows 2 & 3 follow rows 0 & 1 in DDRAM).
+*
+*               nbr_cols    Number of characters per row.
+*
+*               pbuf        Buffer of at least 'nbr_cols + 1' characters, NUL terminated on return.
+*********************************************************************************************************
+*/
+
+void  DispSimRowGet (CPU_INT08U   row,
+                     CPU_INT08U   nbr_cols,
+                     CPU_CHAR    *pbuf)
+{
+    CPU_INT08U  base;
+    CPU_INT08U  col;
+
+
+    base = (row >> 1) * nbr_cols;
+    for (col = 0; col < nbr_cols; col++) {
+        pbuf[col] = (CPU_CHAR)DispSimDDRAM[row & 1][(base + col + DispSimShift) % DISP_LINE_LEN];
+    }
+    pbuf[nbr_cols] = (CPU_CHAR)0;
+}
+
+
+/*
+*********************************************************************************************************
+*                                          DispSimDDRAMGet()
+*                                           DispSimCGGet()
+*                                          DispSimShiftGet()
+*
+* Description : Read a DDRAM character, the dot pattern of a CGRAM slot & the display shift.
+*********************************************************************************************************
+*/
+
+CPU_INT08U  DispSimDDRAMGet (CPU_INT08U  line,
+                             CPU_INT08U  col)
+{
+    return (DispSimDDRAM[line & 1][col % DISP_LINE_LEN]);
+}
+
+
+CPU_INT08U  *DispSimCGGet (CPU_INT08U  slot)
+{
+    return (&DispSimCGRAM[slot & 0x07][0]);
+}
+
+
+CPU_INT08U  DispSimShiftGet (void)
+{
+    return (DispSimShift);
+}
+
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                            PORT FUNCTIONS
+*
+* Description : Stand-ins for the uC/LCD port functions of the Dragon12 'bsp.c' (see Note #1).
+*
+* Note(s)     : (1) DispInitPort() also powers the module up: the display is busy for DISP_SIM_PWR_UP_US
+*                   & back in 8 bit mode.
+*
+*               (2) DispDly_uS() accounts the ticks the delay took before 'BSP_DlyUS()', when it was
+*                   'OSTimeDly(us / us_per_tick + 1)', in 'DlyTicks'.
+*********************************************************************************************************
+*/
+
+void  DispInitPort (void)
+{
+    CPU_INT08U  line;
+    CPU_INT08U  col;
+
+
+    for (line = 0; line < 2; line++) {
+        for (col = 0; col < DISP_LINE_LEN; col++) {
+            DispSimDDRAM[line][col] = DISP_SIM_PWR_UP_CHAR;
+        }
+    }
+    Mem_Set((void *)&DispSimCGRAM[0][0], 0xFF, sizeof(DispSimCGRAM));
+    DispSimRS         = DISP_SEL_CMD_REG;
+    DispSimBus8       = DEF_YES;
+    DispSimNibblePend = DEF_NO;
+    DispSimAC         = 0;
+    DispSimACInCG     = DEF_NO;
+    DispSimInc        = DEF_YES;
+    DispSimShift      = 0;
+    DispSimBusyEnd    = DispSimClk + DISP_SIM_PWR_UP_US;
+}
+
+
+void  DispSel (CPU_INT08U  sel)
+{
+    DispSimRS = sel;
+}
+
+
+void  DispDataWr (CPU_INT08U  data)
+{
+    DispDly_uS(LCD_STROBE_US);
+    DispSimNibbleWr(data & 0xF0);                               /* E falls: upper nibble.                               */
+    DispDly_uS(LCD_STROBE_US);
+    DispDly_uS(LCD_STROBE_US);
+    DispSimNibbleWr((CPU_INT08U)(data << 4));                   /* E falls: lower nibble.                               */
+}
+
+
+#if (DISP_BUS_WIDTH == 4)
+void  DispDataWrOneNibble (CPU_INT08U  data)
+{
+    DispDly_uS(100);
+    DispSimNibbleWr(data & 0xF0);
+}
+#endif
+
+
+#if (DISP_BUSY_FLAG_EN > 0)
+CPU_INT08U  DispStatRd (void)
+{
+    CPU_INT08U  stat;
+
+
+    DispSimStat.StatRdCtr++;
+    DispDly_uS(1);
+    stat = DispSimAC & 0x7F;
+    if ((DispSimClk < DispSimBusyEnd) || (DispSimBusyStuck == DEF_YES)) {
+        stat |= 0x80;
+    }
+    DispDly_uS(1);
+    DispDly_uS(1);
+    return (stat);
+}
+#endif
+
+
+void  DispDly_uS (CPU_INT32U  us)
+{
+    DispSimClk                += us;
+    DispSimStat.Time_uS       += us;
+    DispSimStat.DlyTicks      += us / DISP_SIM_US_PER_TICK + 1; /* See Note #2.                                         */
+}
+
+
+/*
+*********************************************************************************************************
+*                                        DispSimBusyStuckSet()
+*
+* Description : Make the busy flag read 1 whatever the controller does, as on a board where the status
+*               read does not reach the module (e.g. RW is not actually wired).
+*
+* Argument(s) : stuck       DEF_YES to make the flag stick, DEF_NO for the modelled flag.
+*********************************************************************************************************
+*/
+
+#if (DISP_BUSY_FLAG_EN > 0)
+void  DispSimBusyStuckSet (CPU_BOOLEAN  stuck)
+{
+    DispSimBusyStuck = stuck;
+}
+#endif
+
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                          DispSimNibbleWr()
+*
+* Description : Latch the nibble on D7..D4 (upper 4 bits of 'nibble') at the falling edge of E.
+*********************************************************************************************************
+*/
+
+static  void  DispSimNibbleWr (CPU_INT08U  nibble)
+{
+    if (DispSimBus8 == DEF_YES) {                               /* D3..D0 are not wired, they read 0.                   */
+        DispSimExec(nibble & 0xF0);
+    } else if (DispSimNibblePend == DEF_NO) {
+        DispSimNibble     = nibble & 0xF0;
+        DispSimNibblePend = DEF_YES;
+    } else {
+        DispSimNibblePend = DEF_NO;
+        DispSimExec((CPU_INT08U)(DispSimNibble | (nibble >> 4)));
+    }
+}
+
+
+/*
+*********************************************************************************************************
+*                                            DispSimExec()
+*
+* Description : Execute a byte written to the register selected with DispSel().
+*********************************************************************************************************
+*/
+
+static  void  DispSimExec (CPU_INT08U  data)
+{
+    CPU_INT32U  exec_us;
+    CPU_INT08U  line;
+    CPU_INT08U  col;
+
+
+    if (DispSimClk < DispSimBusyEnd) {                          /* Dropped, see 'lcd_sim.h  Note #2'.                   */
+        DispSimStat.BusyWrCtr++;
+        return;
+    }
+
+    exec_us = DISP_SIM_EXEC_US;
+    if (DispSimRS == DISP_SEL_DATA_REG) {                       /* ------------------ DATA WRITE ---------------------- */
+        DispSimStat.DataCtr++;
+        exec_us = DISP_SIM_DATA_US;
+        if (DispSimACInCG == DEF_YES) {
+            DispSimStat.CGWrCtr++;
+            DispSimCGRAM[(DispSimAC >> 3) & 0x07][DispSimAC & 0x07] = data & 0x1F;
+        } else {
+            line = (DispSimAC >= DISP_SIM_LINE2_ADDR) ? 1 : 0;
+            col  = (DispSimAC & 0x3F) % DISP_LINE_LEN;
+            DispSimDDRAM[line][col] = data;
+        }
+        DispSimACInc();
+
+    } else {                                                    /* ------------------- INSTRUCTION -------------------- */
+        DispSimStat.CmdCtr++;
+        if ((data & 0x80) != 0) {                               /* Set DDRAM address.                                   */
+            DispSimAC     = data & 0x7F;
+            DispSimACInCG = DEF_NO;
+
+        } else if ((data & 0x40) != 0) {                        /* Set CGRAM address.                                   */
+            DispSimAC     = data & 0x3F;
+            DispSimACInCG = DEF_YES;
+
+        } else if ((data & 0x20) != 0) {                        /* Function set.                                        */
+            DispSimBus8 = ((data & 0x10) != 0) ? DEF_YES : DEF_NO;
+
+        } else if ((data & 0x10) != 0) {                        /* Cursor / display shift.                              */
+            if ((data & 0x08) != 0) {
+                if ((data & 0x04) != 0) {                       /* Display right: text moves right.                     */
+                    DispSimShift = (DispSimShift + DISP_LINE_LEN - 1) % DISP_LINE_LEN;
+                } else {
+                    DispSimShift = (DispSimShift + 1) % DISP_LINE_LEN;
+                }
+            }
+
+        } else if ((data & 0x08) != 0) {                        /* Display on/off control.                              */
+
+        } else if ((data & 0x04) != 0) {                        /* Entry mode set.                                      */
+            DispSimInc = ((data & 0x02) != 0) ? DEF_YES : DEF_NO;
+
+        } else if ((data & 0x02) != 0) {                        /* Return home.                                         */
+            DispSimAC     = 0;
+            DispSimACInCG = DEF_NO;
+            DispSimShift  = 0;
+            exec_us       = DISP_SIM_CLR_US;
+
+        } else if ((data & 0x01) != 0) {                        /* Clear display.                                       */
+            DispSimStat.ClrCtr++;
+            for (line = 0; line < 2; line++) {
+                for (col = 0; col < DISP_LINE_LEN; col++) {
+                    DispSimDDRAM[line][col] = ' ';
+                }
+            }
+            DispSimAC     = 0;
+            DispSimACInCG = DEF_NO;
+            DispSimInc    = DEF_YES;
+            DispSimShift  = 0;
+            exec_us       = DISP_SIM_CLR_US;
+        }
+    }
+    DispSimBusyEnd = DispSimClk + exec_us;
+}
+
+
+/*
+*********************************************************************************************************
+*                                           DispSimACInc()
+*
+* Description : Move the address counter after a data write, as set by the entry mode.
+*********************************************************************************************************
+*/
+
+static  void  DispSimACInc (void)
+{
+    if (DispSimACInCG == DEF_YES) {
+        DispSimAC = (DispSimInc == DEF_YES) ? ((DispSimAC + 1) & 0x3F) : ((DispSimAC - 1) & 0x3F);
+    } else if (DispSimInc == DEF_YES) {
+        DispSimAC++;
+        if (DispSimAC == DISP_LINE_LEN) {                       /* End of line 1 continues on line 2 ...                */
+            DispSimAC = DISP_SIM_LINE2_ADDR;
+        } else if (DispSimAC == DISP_SIM_LINE2_ADDR + DISP_LINE_LEN) {
+            DispSimAC = 0;                                      /* ... & the end of line 2 on line 1.                   */
+        }
+    } else {
+        if (DispSimAC == 0) {
+            DispSimAC = DISP_SIM_LINE2_ADDR + DISP_LINE_LEN - 1;
+        } else if (DispSimAC == DISP_SIM_LINE2_ADDR) {
+            DispSimAC = DISP_LINE_LEN - 1;
+        } else {
+            DispSimAC--;
+        }
+    }
+}
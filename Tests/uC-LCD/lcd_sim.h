@@ -0,0 +1,80 @@
+/*
+*********************************************************************************************************
+*                                             HOST TESTS
+*
+*                                   Simulated HD44780 on the Dragon12 Port
+*
+* Filename      : lcd_sim.h
+* Note(s)       : (1) 'lcd_sim.c' provides the port functions of the BSP (DispInitPort(), DispSel(),
+*                     DispDataWr(), DispDataWrOneNibble(), DispStatRd() & DispDly_uS()) with the same
+*                     strobe delays as the Dragon12 'bsp.c', wired to a model of the HD44780.  lcd.c &
+*                     lcd_hd44780.c are linked unchanged.
+*
+*                 (2) Time is simulated: DispDly_uS() advances a microsecond clock instead of waiting.
+*                     Each byte is latched when its last nibble is strobed.  A byte latched while the
+*                     controller is still busy is counted in 'BusyWrCtr' & dropped, as real modules do
+*                     not reliably accept it.
+*********************************************************************************************************
+*/
+
+#ifndef  LCD_SIM_H
+#define  LCD_SIM_H
+
+
+/*
+*********************************************************************************************************
+*                                               DEFINES
+*********************************************************************************************************
+*/
+
+#define  DISP_SIM_EXEC_US                 37                    /* Instruction execution time, fosc = 270 kHz.          */
+#define  DISP_SIM_DATA_US                 41                    /* Data write, incl. the address counter update.        */
+#define  DISP_SIM_CLR_US                1520                    /* 'Clear display' & 'return home'.                     */
+#define  DISP_SIM_PWR_UP_US            15000                    /* Busy after power up.                                 */
+
+#define  DISP_SIM_US_PER_TICK           1000                    /* OS tick of the Dragon12 build (1000 Hz).             */
+
+
+/*
+*********************************************************************************************************
+*                                              DATA TYPES
+*********************************************************************************************************
+*/
+
+typedef  struct  disp_sim_stat {
+    CPU_INT32U  CmdCtr;                                         /* Instruction bytes executed.                          */
+    CPU_INT32U  DataCtr;                                        /* Data bytes written (DDRAM & CGRAM).                  */
+    CPU_INT32U  CGWrCtr;                                        /* ... of which CGRAM pattern bytes.                    */
+    CPU_INT32U  ClrCtr;                                         /* 'Clear display' instructions.                        */
+    CPU_INT32U  BusyWrCtr;                                      /* Bytes dropped, latched while busy (Note #2).         */
+    CPU_INT32U  StatRdCtr;                                      /* Busy flag reads.                                     */
+    CPU_INT32U  Time_uS;                                        /* Simulated time spent in the port functions.          */
+    CPU_INT32U  DlyTicks;                                       /* OS ticks the same delays took before 'BSP_DlyUS()'.  */
+} DISP_SIM_STAT;
+
+
+/*
+*********************************************************************************************************
+*                                          FUNCTION PROTOTYPES
+*********************************************************************************************************
+*/
+
+void        DispSimStatClr  (void);
+void        DispSimStatGet  (DISP_SIM_STAT  *pstat);
+
+void        DispSimRowGet   (CPU_INT08U      row,
+                             CPU_INT08U      nbr_cols,
+                             CPU_CHAR       *pbuf);
+
+CPU_INT08U  DispSimDDRAMGet (CPU_INT08U      line,
+                             CPU_INT08U      col);
+
+CPU_INT08U *DispSimCGGet    (CPU_INT08U      slot);
+
+CPU_INT08U  DispSimShiftGet (void);
+
+#if (DISP_BUSY_FLAG_EN > 0)
+void        DispSimBusyStuckSet(CPU_BOOLEAN  stuck);
+#endif
+
+#endif
@@ -0,0 +1,202 @@
+/*
+*********************************************************************************************************
+*                                             HOST TESTS
+*
+*                                  uC/LCD Busy Flag Polling vs. Fixed Delays
+*
+* Filename      : test_lcd_busy.c
+* Note(s)       : (1) Built twice, with DISP_BUSY_FLAG_EN 1 & 0, against the simulated HD44780 of 'lcd_sim.c'.
+*                     The time each operation keeps the bus is printed for both, so the two builds compare
+*                     polling the busy flag with the worst case delays of the Dragon12 port.
+*
+*                 (2) Either way, no byte may be written while the controller is busy.  Polling, a byte
+*                     MUST take no longer than its execution time plus the strobes & two status reads: the
+*                     last one seeing the flag set & the one seeing it clear.  DispClrScr() waits once more
+*                     after the clear, one more status read.
+*
+*                 (3) Polling, with a busy flag that never clears (RW not actually wired), the driver MUST
+*                     fall back to the fixed delays after DISP_BUSY_POLL_MAX reads & keep the display right.
+*********************************************************************************************************
+*/
+
+#include  <includes.h>
+#include  "lcd_sim.h"
+
+
+/*
+*********************************************************************************************************
+*                                            LOCAL DEFINES
+*********************************************************************************************************
+*/
+
+#define  ROWS                              2
+#define  COLS                             16
+
+#define  POLL_US                           3                    /* One status read in 'lcd_sim.c'.                      */
+#define  STROBE_US                         3                    /* Strobes of one byte, DispDataWr().                   */
+
+
+/*
+*********************************************************************************************************
+*                                        LOCAL GLOBAL VARIABLES
+*********************************************************************************************************
+*/
+
+static  OS_STK  TestTaskStk[TEST_TASK_STK_SIZE];
+
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                             Test_RowChk()
+*
+* Description : Check the characters a row of the simulated module shows.
+*********************************************************************************************************
+*/
+
+static  void  Test_RowChk (CPU_INT08U   row,
+                           const char  *pexp)
+{
+    CPU_CHAR  buf[COLS + 1];
+
+
+    DispSimRowGet(row, COLS, buf);
+    TEST_CHK(strcmp((char *)buf, pexp) == 0);
+    if (strcmp((char *)buf, pexp) != 0) {
+        printf("  row %u: \"%s\", expected \"%s\"\n", (unsigned)row, buf, pexp);
+    }
+}
+
+
+/*
+*********************************************************************************************************
+*                                             Test_Stat()
+*
+* Description : Read & clear the counters of the simulated module, print the bus time of an operation.
+*********************************************************************************************************
+*/
+
+static  void  Test_Stat (const char     *name,
+                         DISP_SIM_STAT  *pstat)
+{
+    CPU_INT32U  bytes;
+
+
+    DispSimStatGet(pstat);
+    DispSimStatClr();
+    TEST_CHK(pstat->BusyWrCtr == 0);
+    bytes = pstat->CmdCtr + pstat->DataCtr;
+    printf("%-24s %8lu us on the bus, %3lu bytes, %6.1f us/byte, %5lu status reads\n",
+           name, (unsigned long)pstat->Time_uS, (unsigned long)bytes,
+           (bytes == 0) ? 0.0 : (double)pstat->Time_uS / bytes, (unsigned long)pstat->StatRdCtr);
+}
+
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                             Test_Ops()
+*
+* Description : Time DispInit(), a two line redraw & DispClrScr() (see Note #1 & #2).
+*********************************************************************************************************
+*/
+
+static  void  Test_Ops (void)
+{
+    DISP_SIM_STAT  stat;
+
+
+    DispSimStatClr();
+    DispInit(ROWS, COLS);
+    Test_Stat("DispInit()", &stat);
+    TEST_CHK(stat.ClrCtr == 1);
+    Test_RowChk(0, "                ");
+
+    DispStr(0, 0, (CPU_INT08U *)"Range: 42cm     ");
+    DispStr(1, 0, (CPU_INT08U *)"SAFE            ");
+    Test_Stat("Redraw, 2 lines", &stat);
+    TEST_CHK(stat.DataCtr == 2 * COLS);
+    Test_RowChk(0, "Range: 42cm     ");
+    Test_RowChk(1, "SAFE            ");
+#if DISP_BUSY_FLAG_EN > 0
+    TEST_CHK(stat.Time_uS <= stat.CmdCtr  * (DISP_SIM_EXEC_US + STROBE_US + 2 * POLL_US)
+                           + stat.DataCtr * (DISP_SIM_DATA_US + STROBE_US + 2 * POLL_US));
+#endif
+
+    DispClrScr();
+    Test_Stat("DispClrScr()", &stat);
+    TEST_CHK(stat.ClrCtr == 1);
+    Test_RowChk(0, "                ");
+    Test_RowChk(1, "                ");
+#if DISP_BUSY_FLAG_EN > 0
+    TEST_CHK(stat.Time_uS <= DISP_SIM_CLR_US + STROBE_US + 3 * POLL_US);
+#else
+    TEST_CHK(stat.Time_uS >= 2000);
+#endif
+}
+
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                             Test_Stuck()
+*
+* Description : See Note #3.
+*********************************************************************************************************
+*/
+
+#if DISP_BUSY_FLAG_EN > 0
+static  void  Test_Stuck (void)
+{
+    DISP_SIM_STAT  stat;
+
+
+    DispSimBusyStuckSet(DEF_YES);
+    DispStr(0, 0, (CPU_INT08U *)"RW not wired");
+    Test_Stat("Stuck flag, 13 bytes", &stat);
+    TEST_CHK(stat.StatRdCtr == (stat.CmdCtr + stat.DataCtr) * DISP_BUSY_POLL_MAX);
+    Test_RowChk(0, "RW not wired    ");
+
+    DispClrScr();
+    Test_Stat("Stuck flag, DispClrScr()", &stat);
+    Test_RowChk(0, "                ");
+    DispSimBusyStuckSet(DEF_NO);
+}
+#endif
+
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                             TestTask()
+*********************************************************************************************************
+*/
+
+static  void  TestTask (void *p_arg)
+{
+    (void)p_arg;
+    Test_Ops();
+#if DISP_BUSY_FLAG_EN > 0
+    Test_Stuck();
+    Test_Done("test_lcd_busy (DISP_BUSY_FLAG_EN 1)");
+#else
+    Test_Done("test_lcd_busy (DISP_BUSY_FLAG_EN 0)");
+#endif
+}
+
+
+int  main (void)
+{
+    OSInit();
+    (void)OSTaskCreateExt(TestTask,
+                          (void *)0,
+                          &TestTaskStk[TEST_TASK_STK_SIZE - 1],
+                          TEST_TASK_PRIO,
+                          TEST_TASK_PRIO,
+                          &TestTaskStk[0],
+                          TEST_TASK_STK_SIZE,
+                          (void *)0,
+                          OS_TASK_OPT_NONE);
+    OSStart();
+    return (0);
+}
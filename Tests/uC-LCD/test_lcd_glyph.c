@@ -0,0 +1,289 @@
+/*
+*********************************************************************************************************
+*                                             HOST TESTS
+*
+*                                     uC/LCD CGRAM Glyph Cache (LRU)
+*
+* Filename      : test_lcd_glyph.c
+* Note(s)       : (1) Built twice, with DISP_SHADOW_EN 1 & 0, against the simulated HD44780 of 'lcd_sim.c'.
+*                     Every glyph lookup is a hit or a miss; a miss uploads 8 pattern bytes to CGRAM, so
+*                     the misses are the CGRAM bytes written / 8.
+*
+*                 (2) Proximity bar: a bar sweeping 0 to 80 & back, redrawn each frame.  Every cell MUST show
+*                     the dot pattern expected for the frame, & each of the 5 bar glyphs MUST be uploaded
+*                     once only.  The same with 3 icons shown beside the bar: 8 glyphs fill the 8 slots.
+*
+*                 (3) Working sets: n glyphs drawn in turn.  Up to the number of free slots, only the first
+*                     use of each glyph misses.  Beyond it LRU misses on every lookup (printed).  A slot
+*                     defined with DispDefChar() is never replaced.
+*********************************************************************************************************
+*/
+
+#include  <includes.h>
+#include  "lcd_sim.h"
+
+
+/*
+*********************************************************************************************************
+*                                            LOCAL DEFINES
+*********************************************************************************************************
+*/
+
+#define  ROWS                              2
+#define  COLS                             16
+
+#define  BAR_ROW                           1
+#define  BAR_MAX                   (COLS * 5)
+#define  ICON_COL                  (COLS - 1)
+#define  ICON_NBR_MAX                     10
+#define  ROUND_NBR                        20
+
+
+/*
+*********************************************************************************************************
+*                                        LOCAL GLOBAL VARIABLES
+*********************************************************************************************************
+*/
+
+static  OS_STK      TestTaskStk[TEST_TASK_STK_SIZE];
+
+static  CPU_INT08U  BarPat[5][8];                               /* 1 to 5 columns lit, as in lcd.c.                     */
+static  CPU_INT08U  IconPat[ICON_NBR_MAX][8];
+
+static  CPU_INT32U  LookupCtr;                                  /* Glyph lookups.                                       */
+static  CPU_INT32U  CellFailCtr;                                /* Cells showing the wrong pattern.                     */
+
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                            Test_Update()
+*
+* Description : End an update: flush the shadow buffer if there is one.
+*********************************************************************************************************
+*/
+
+static  void  Test_Update (void)
+{
+#if DISP_SHADOW_EN > 0
+    DispFlush();
+#endif
+}
+
+
+/*
+*********************************************************************************************************
+*                                            Test_CellChk()
+*
+* Description : Check that a cell shows the dot pattern 'ppat', or a blank if 'ppat' is NULL.
+*********************************************************************************************************
+*/
+
+static  void  Test_CellChk (CPU_INT08U   row,
+                            CPU_INT08U   col,
+                            CPU_INT08U  *ppat)
+{
+    CPU_CHAR    buf[COLS + 1];
+    CPU_INT08U  c;
+
+
+    DispSimRowGet(row, COLS, buf);
+    c = (CPU_INT08U)buf[col];
+    if (ppat == (CPU_INT08U *)0) {
+        if (c != ' ') {
+            CellFailCtr++;
+        }
+    } else if ((c >= 8) || (memcmp(DispSimCGGet(c), ppat, 8) != 0)) {
+        CellFailCtr++;
+    }
+}
+
+
+/*
+*********************************************************************************************************
+*                                            Test_Misses()
+*
+* Description : Return the glyph misses since the last call (see Note #1).
+*********************************************************************************************************
+*/
+
+static  CPU_INT32U  Test_Misses (void)
+{
+    DISP_SIM_STAT  stat;
+
+
+    DispSimStatGet(&stat);
+    DispSimStatClr();
+    TEST_CHK(stat.BusyWrCtr == 0);
+    TEST_CHK(stat.CGWrCtr % 8 == 0);
+    return (stat.CGWrCtr / 8);
+}
+
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                             Test_Bar()
+*
+* Description : See Note #2.
+*
+* Argument(s) : icon_nbr    Number of icons shown in turn beside the bar (0 for none).
+*
+* Return(s)   : The glyph misses.
+*********************************************************************************************************
+*/
+
+static  CPU_INT32U  Test_Bar (CPU_INT08U  icon_nbr)
+{
+    CPU_INT16U  frame;
+    CPU_INT08U  val;
+    CPU_INT08U  col;
+    CPU_INT08U  icon;
+    CPU_INT32U  misses;
+
+
+    DispInit(ROWS, COLS);
+    (void)Test_Misses();
+    LookupCtr   = 0;
+    CellFailCtr = 0;
+    for (frame = 0; frame <= 2 * BAR_MAX; frame++) {
+        val = (frame <= BAR_MAX) ? frame : (2 * BAR_MAX - frame);
+        DispClrLine(BAR_ROW);
+        DispHorBar(BAR_ROW, 0, val);
+        LookupCtr += ((val / 5) > 0) ? 1 : 0;
+        LookupCtr += ((val % 5) > 0) ? 1 : 0;
+        if (icon_nbr > 0) {
+            icon = frame % icon_nbr;
+            DispGlyph(0, ICON_COL, DISP_GLYPH_USER + icon, IconPat[icon]);
+            LookupCtr++;
+        }
+        Test_Update();
+
+        for (col = 0; col < COLS; col++) {
+            if (col < val / 5) {
+                Test_CellChk(BAR_ROW, col, BarPat[4]);
+            } else if ((col == val / 5) && ((val % 5) > 0)) {
+                Test_CellChk(BAR_ROW, col, BarPat[(val % 5) - 1]);
+            } else {
+                Test_CellChk(BAR_ROW, col, (CPU_INT08U *)0);
+            }
+        }
+        if (icon_nbr > 0) {
+            Test_CellChk(0, ICON_COL, IconPat[icon]);
+        }
+    }
+    misses = Test_Misses();
+    TEST_CHK(CellFailCtr == 0);
+    printf("bar sweep, %2u icons: %4lu lookups, %2lu misses, hit rate %5.1f%%, %3lu CGRAM bytes\n",
+           (unsigned)icon_nbr, (unsigned long)LookupCtr, (unsigned long)misses,
+           100.0 * (double)(LookupCtr - misses) / LookupCtr, (unsigned long)(misses * 8));
+    return (misses);
+}
+
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                           Test_WorkSet()
+*
+* Description : See Note #3.
+*
+* Argument(s) : n           Number of glyphs drawn in turn.
+*
+*               rsvd        DEF_YES to reserve slot 0 with DispDefChar() first.
+*
+* Return(s)   : The glyph misses.
+*********************************************************************************************************
+*/
+
+static  CPU_INT32U  Test_WorkSet (CPU_INT08U   n,
+                                  CPU_BOOLEAN  rsvd)
+{
+    static  CPU_INT08U  rsvd_pat[8] = {0x0A, 0x15, 0x0A, 0x15, 0x0A, 0x15, 0x0A, 0x15};
+    CPU_INT08U          round;
+    CPU_INT08U          k;
+    CPU_INT32U          misses;
+
+
+    DispInit(ROWS, COLS);
+    if (rsvd == DEF_YES) {
+        DispDefChar(0, rsvd_pat);
+    }
+    (void)Test_Misses();
+    CellFailCtr = 0;
+    for (round = 0; round < ROUND_NBR; round++) {
+        for (k = 0; k < n; k++) {
+            DispGlyph(0, 0, DISP_GLYPH_USER + k, IconPat[k]);
+            Test_Update();
+            Test_CellChk(0, 0, IconPat[k]);
+        }
+    }
+    misses = Test_Misses();
+    TEST_CHK(CellFailCtr == 0);
+    if (rsvd == DEF_YES) {
+        TEST_CHK(memcmp(DispSimCGGet(0), rsvd_pat, 8) == 0);
+    }
+    printf("working set %2u%s: %4u lookups, %3lu misses, hit rate %5.1f%%\n",
+           (unsigned)n, (rsvd == DEF_YES) ? " (1 slot reserved)" : "                  ",
+           (unsigned)(n * ROUND_NBR), (unsigned long)misses,
+           100.0 * (double)(n * ROUND_NBR - misses) / (n * ROUND_NBR));
+    return (misses);
+}
+
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                             TestTask()
+*********************************************************************************************************
+*/
+
+static  void  TestTask (void *p_arg)
+{
+    CPU_INT08U  i;
+    CPU_INT08U  k;
+
+
+    (void)p_arg;
+    for (i = 0; i < 8; i++) {
+        for (k = 0; k < 5; k++) {
+            BarPat[k][i] = (CPU_INT08U)(0x1F & ~(0x0F >> k));
+        }
+        for (k = 0; k < ICON_NBR_MAX; k++) {
+            IconPat[k][i] = (CPU_INT08U)(k + 1);
+        }
+    }
+
+    TEST_CHK(Test_Bar(0) == 5);                                 /* Each bar glyph uploaded once.                        */
+    TEST_CHK(Test_Bar(3) == 5 + 3);                             /* 8 glyphs fit the 8 slots.                            */
+
+    for (k = 2; k <= 8; k++) {
+        TEST_CHK(Test_WorkSet(k, DEF_NO) == k);
+    }
+    TEST_CHK(Test_WorkSet(7, DEF_YES) == 7);
+    (void)Test_WorkSet(8, DEF_YES);
+    (void)Test_WorkSet(9, DEF_NO);
+
+#if DISP_SHADOW_EN > 0
+    Test_Done("test_lcd_glyph (DISP_SHADOW_EN 1)");
+#else
+    Test_Done("test_lcd_glyph (DISP_SHADOW_EN 0)");
+#endif
+}
+
+
+int  main (void)
+{
+    OSInit();
+    (void)OSTaskCreateExt(TestTask,
+                          (void *)0,
+                          &TestTaskStk[TEST_TASK_STK_SIZE - 1],
+                          TEST_TASK_PRIO,
+                          TEST_TASK_PRIO,
+                          &TestTaskStk[0],
+                          TEST_TASK_STK_SIZE,
+                          (void *)0,
+                          OS_TASK_OPT_NONE);
+    OSStart();
+    return (0);
+}
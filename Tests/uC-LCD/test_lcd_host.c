@@ -0,0 +1,203 @@
+/*
+*********************************************************************************************************
+*                                             HOST TESTS
+*
+*                                     uC/LCD Host Display Back End
+*
+* Filename      : test_lcd_host.c
+* Note(s)       : (1) Built twice, with DISP_SHADOW_EN 1 & 0, with DISP_DRV_SEL DispDrvHost: 'lcd_host.c' is
+*                     linked instead of 'lcd_hd44780.c' & the BSP's port functions.  DISP_HOST_ANSI_EN is 0
+*                     so the frames drawn on each update scroll by in the test's output.
+*
+*                 (2) For each operation the host back end MUST count the instruction & data bytes
+*                     DispDrvHD44780 would have sent, DISP_HOST_BYTE_US each on the bus, DISP_HOST_CLR_US
+*                     for the 'clear display' command, & one update per DispDrv Flush.
+*
+*                 (3) A run crossing the middle of a 1 line display costs one more 'set DDRAM address',
+*                     as in 'lcd_hd44780.c'.
+*********************************************************************************************************
+*/
+
+#include  <includes.h>
+
+
+/*
+*********************************************************************************************************
+*                                            LOCAL DEFINES
+*********************************************************************************************************
+*/
+
+#define  ROWS                              2
+#define  COLS                             16
+
+
+/*
+*********************************************************************************************************
+*                                        LOCAL GLOBAL VARIABLES
+*********************************************************************************************************
+*/
+
+static  OS_STK  TestTaskStk[TEST_TASK_STK_SIZE];
+
+static  CPU_INT08U  GlyphPat[8] = {0x04, 0x0E, 0x1F, 0x04, 0x04, 0x04, 0x04, 0x00};
+
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                             Test_Update()
+*
+* Description : End an update: flush the shadow buffer if there is one.
+*********************************************************************************************************
+*/
+
+static  void  Test_Update (void)
+{
+#if DISP_SHADOW_EN > 0
+    DispFlush();
+#endif
+}
+
+
+/*
+*********************************************************************************************************
+*                                             Test_RowChk()
+*
+* Description : Check the characters a row of the emulated display shows.
+*********************************************************************************************************
+*/
+
+static  void  Test_RowChk (CPU_INT08U   row,
+                           const char  *pexp)
+{
+    CPU_INT08U  *prow;
+
+
+    prow = DispHostRowGet(row);
+    TEST_CHK(strcmp((char *)prow, pexp) == 0);
+    if (strcmp((char *)prow, pexp) != 0) {
+        printf("  row %u: \"%s\", expected \"%s\"\n", (unsigned)row, prow, pexp);
+    }
+}
+
+
+/*
+*********************************************************************************************************
+*                                             Test_StatChk()
+*
+* Description : Check & clear the counters of the host back end (see Note #2).
+*
+* Argument(s) : name        Operation, printed with its counters.
+*
+*               cmd         Expected instruction bytes.
+*
+*               data        Expected data bytes.
+*
+*               clr         Expected 'clear display' commands, part of 'cmd'.
+*
+*               flush       Expected updates.
+*********************************************************************************************************
+*/
+
+static  void  Test_StatChk (const char  *name,
+                            CPU_INT32U   cmd,
+                            CPU_INT32U   data,
+                            CPU_INT32U   clr,
+                            CPU_INT32U   flush)
+{
+    DISP_HOST_STAT  stat;
+
+
+    DispHostStatGet(&stat);
+    DispHostStatClr();
+    printf("%-24s cmd %3lu  data %3lu  bus %5lu us  updates %lu\n",
+           name, (unsigned long)stat.CmdCtr, (unsigned long)stat.DataCtr,
+           (unsigned long)stat.BusTime_uS, (unsigned long)stat.FlushCtr);
+    TEST_CHK(stat.CmdCtr     == cmd);
+    TEST_CHK(stat.DataCtr    == data);
+    TEST_CHK(stat.BusTime_uS == (cmd + data - clr) * DISP_HOST_BYTE_US + clr * DISP_HOST_CLR_US);
+    TEST_CHK(stat.FlushCtr   == flush);
+}
+
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                             TestTask()
+*********************************************************************************************************
+*/
+
+static  void  TestTask (void *p_arg)
+{
+    (void)p_arg;
+    DispInit(ROWS, COLS);                                       /* Reset clears the counters, then one update.          */
+    Test_StatChk("DispInit()", 0, 0, 0, 1);
+    Test_RowChk(0, "                ");
+    Test_RowChk(1, "                ");
+    TEST_CHK(strcmp((char *)DispHostRowGet(ROWS), "") == 0);
+
+    DispStr(0, 0, (CPU_INT08U *)"Range: 42cm");
+    Test_Update();
+#if DISP_SHADOW_EN > 0
+    Test_StatChk("DispStr(), 11 chars", 2, 10, 0, 1);           /* Blank at col 6 unchanged: 2 runs.                    */
+#else
+    Test_StatChk("DispStr(), 11 chars", 1, 11, 0, 1);
+#endif
+    Test_RowChk(0, "Range: 42cm     ");
+
+    DispStr(0, 0, (CPU_INT08U *)"Range: 43cm");
+    Test_Update();
+#if DISP_SHADOW_EN > 0
+    Test_StatChk("DispStr(), 1 change", 1, 1, 0, 1);
+#else
+    Test_StatChk("DispStr(), 1 change", 1, 11, 0, 1);
+#endif
+    Test_RowChk(0, "Range: 43cm     ");
+
+    DispClrScr();
+    Test_Update();
+#if DISP_SHADOW_EN > 0
+    Test_StatChk("DispClrScr()", 2, 10, 0, 1);                  /* Only the non-blank cells are blanked.                */
+#else
+    Test_StatChk("DispClrScr()", 1, 0, 1, 1);
+#endif
+    Test_RowChk(0, "                ");
+
+    DispDefChar(0, GlyphPat);                                   /* 'set CGRAM address' & 8 pattern bytes.               */
+    Test_StatChk("DispDefChar()", 1, 8, 0, 0);
+
+#if DISP_SHADOW_EN > 0
+    DispFlush();                                                /* A flush with no change sends nothing.                */
+    Test_StatChk("DispFlush(), no change", 0, 0, 0, 1);
+#endif
+
+    DispInit(1, COLS);                                          /* See Note #3.                                         */
+    Test_StatChk("DispInit(), 1 line", 0, 0, 0, 1);
+    DispStr(0, 0, (CPU_INT08U *)"0123456789ABCDEF");
+    Test_Update();
+    Test_StatChk("DispStr(), 1 line, 16", 2, 16, 0, 1);
+    Test_RowChk(0, "0123456789ABCDEF");
+
+#if DISP_SHADOW_EN > 0
+    Test_Done("test_lcd_host (DISP_SHADOW_EN 1)");
+#else
+    Test_Done("test_lcd_host (DISP_SHADOW_EN 0)");
+#endif
+}
+
+
+int  main (void)
+{
+    OSInit();
+    (void)OSTaskCreateExt(TestTask,
+                          (void *)0,
+                          &TestTaskStk[TEST_TASK_STK_SIZE - 1],
+                          TEST_TASK_PRIO,
+                          TEST_TASK_PRIO,
+                          &TestTaskStk[0],
+                          TEST_TASK_STK_SIZE,
+                          (void *)0,
+                          OS_TASK_OPT_NONE);
+    OSStart();
+    return (0);
+}
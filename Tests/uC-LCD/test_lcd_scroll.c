@@ -0,0 +1,185 @@
+/*
+*********************************************************************************************************
+*                                             HOST TESTS
+*
+*                                   uC/LCD Clear Screen While Scrolling
+*
+* Filename      : test_lcd_scroll.c
+* Note(s)       : (1) Built twice with DISP_SCROLL_EN, with DISP_SHADOW_EN 1 & 0, against the simulated HD44780
+*                     of 'lcd_sim.c'.  The steps are taken by calling DispScrollStep() directly, as the
+*                     scroll timer does.
+*
+*                 (2) With text in the off screen DDRAM columns & the display shifted, DispClrScr() MUST
+*                     blank all DISP_LINE_LEN columns of both lines & cancel the shift, with one 'clear
+*                     display' command.  The off-screen copy only covers the visible columns, so the
+*                     shadow buffer build MUST NOT blank them cell by cell.
+*
+*                 (3) After the clear, DispScrollStop() has no shift to undo, & text written at column 0
+*                     MUST show at the left edge.
+*********************************************************************************************************
+*/
+
+#include  <includes.h>
+#include  "lcd_sim.h"
+
+
+/*
+*********************************************************************************************************
+*                                            LOCAL DEFINES
+*********************************************************************************************************
+*/
+
+#define  ROWS                              2
+#define  COLS                             16
+
+#define  STEP_NBR                          5
+
+
+/*
+*********************************************************************************************************
+*                                        LOCAL GLOBAL VARIABLES
+*********************************************************************************************************
+*/
+
+static  OS_STK  TestTaskStk[TEST_TASK_STK_SIZE];
+
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                             Test_Update()
+*
+* Description : End an update: flush the shadow buffer if there is one.
+*********************************************************************************************************
+*/
+
+static  void  Test_Update (void)
+{
+#if DISP_SHADOW_EN > 0
+    DispFlush();
+#endif
+}
+
+
+/*
+*********************************************************************************************************
+*                                             Test_RowChk()
+*
+* Description : Check the characters a row of the simulated module shows.
+*********************************************************************************************************
+*/
+
+static  void  Test_RowChk (CPU_INT08U   row,
+                           const char  *pexp)
+{
+    CPU_CHAR  buf[COLS + 1];
+
+
+    DispSimRowGet(row, COLS, buf);
+    TEST_CHK(strcmp((char *)buf, pexp) == 0);
+    if (strcmp((char *)buf, pexp) != 0) {
+        printf("  row %u: \"%s\", expected \"%s\"\n", (unsigned)row, buf, pexp);
+    }
+}
+
+
+/*
+*********************************************************************************************************
+*                                            Test_Blank()
+*
+* Description : Return the number of DDRAM characters, visible or not, that are not blank.
+*********************************************************************************************************
+*/
+
+static  CPU_INT32U  Test_Blank (void)
+{
+    CPU_INT08U  line;
+    CPU_INT08U  col;
+    CPU_INT32U  n;
+
+
+    n = 0;
+    for (line = 0; line < ROWS; line++) {
+        for (col = 0; col < DISP_LINE_LEN; col++) {
+            if (DispSimDDRAMGet(line, col) != ' ') {
+                n++;
+            }
+        }
+    }
+    return (n);
+}
+
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                             TestTask()
+*********************************************************************************************************
+*/
+
+static  void  TestTask (void *p_arg)
+{
+    DISP_SIM_STAT  stat;
+    CPU_INT08U     i;
+
+
+    (void)p_arg;
+    DispInit(ROWS, COLS);
+    DispStr(0, 0, (CPU_INT08U *)"Range: 42cm");
+    Test_Update();
+    DispScrollStr(1, 0, (CPU_INT08U *)"Scrolling text past the visible columns");
+    for (i = 0; i < STEP_NBR; i++) {
+        DispScrollStep();
+    }
+    TEST_CHK(DispSimShiftGet() == STEP_NBR);
+    Test_RowChk(1, "ling text past t");
+    TEST_CHK(Test_Blank() > DISP_LINE_LEN);
+
+    DispSimStatClr();                                           /* See Note #2.                                         */
+    DispClrScr();
+    Test_Update();
+    DispSimStatGet(&stat);
+    printf("DispClrScr(), shifted %u: %lu cmd, %lu data, %lu 'clear display', %lu us on the bus\n",
+           (unsigned)STEP_NBR, (unsigned long)stat.CmdCtr, (unsigned long)stat.DataCtr,
+           (unsigned long)stat.ClrCtr, (unsigned long)stat.Time_uS);
+    TEST_CHK(stat.ClrCtr    == 1);
+    TEST_CHK(stat.CmdCtr    == 1);
+    TEST_CHK(stat.DataCtr   == 0);
+    TEST_CHK(stat.BusyWrCtr == 0);
+    TEST_CHK(DispSimShiftGet() == 0);
+    TEST_CHK(Test_Blank() == 0);
+    Test_RowChk(0, "                ");
+    Test_RowChk(1, "                ");
+
+    DispSimStatClr();                                           /* See Note #3.                                         */
+    DispScrollStop();
+    DispSimStatGet(&stat);
+    TEST_CHK(stat.CmdCtr == 0);
+    DispStr(0, 0, (CPU_INT08U *)"Range: 42cm");
+    Test_Update();
+    Test_RowChk(0, "Range: 42cm     ");
+    Test_RowChk(1, "                ");
+
+#if DISP_SHADOW_EN > 0
+    Test_Done("test_lcd_scroll (DISP_SHADOW_EN 1)");
+#else
+    Test_Done("test_lcd_scroll (DISP_SHADOW_EN 0)");
+#endif
+}
+
+
+int  main (void)
+{
+    OSInit();
+    (void)OSTaskCreateExt(TestTask,
+                          (void *)0,
+                          &TestTaskStk[TEST_TASK_STK_SIZE - 1],
+                          TEST_TASK_PRIO,
+                          TEST_TASK_PRIO,
+                          &TestTaskStk[0],
+                          TEST_TASK_STK_SIZE,
+                          (void *)0,
+                          OS_TASK_OPT_NONE);
+    OSStart();
+    return (0);
+}
@@ -0,0 +1,299 @@
+/*
+*********************************************************************************************************
+*                                             HOST TESTS
+*
+*                                uC/LCD Shadow Buffer & Dirty-Cell Flush
+*
+* Filename      : test_lcd_shadow.c
+* Note(s)       : (1) Built twice, with DISP_SHADOW_EN 1 & 0, against the simulated HD44780 of 'lcd_sim.c'.
+*                     With the shadow buffer, DispFlush() MUST send only the cells that changed: nothing
+*                     for an unchanged screen, one 'set DDRAM address' per run of changed cells.
+*
+*                 (2) Both builds replay the update pattern of the range demo ('app.c', before the shadow
+*                     buffer) & MUST leave the same characters on the module.  Bus bytes & time are printed
+*                     per sample.
+*
+*                 (3) 'OS ticks' are what the same LCD writes blocked the demo task for when DispDly_uS()
+*                     slept 'us / us_per_tick + 1' ticks: the 'Moving...' sample took about 85 mS, which
+*                     was the demo's sample period.  With the shadow buffer the demo waits SAMPLE_PERIOD_MS
+*                     (100 mS) instead.
+*********************************************************************************************************
+*/
+
+#include  <includes.h>
+#include  "lcd_sim.h"
+
+
+/*
+*********************************************************************************************************
+*                                            LOCAL DEFINES
+*********************************************************************************************************
+*/
+
+#define  ROWS                              2
+#define  COLS                             16
+
+#define  REPLAY_NBR                      100
+
+
+/*
+*********************************************************************************************************
+*                                        LOCAL GLOBAL VARIABLES
+*********************************************************************************************************
+*/
+
+static  OS_STK      TestTaskStk[TEST_TASK_STK_SIZE];
+
+static  CPU_INT08U  ReplayRange[] = {42, 42, 42, 18, 18, 11, 90, 90, 90, 0, 35, 90};
+
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                             Test_Update()
+*
+* Description : End an update: flush the shadow buffer if there is one.
+*********************************************************************************************************
+*/
+
+static  void  Test_Update (void)
+{
+#if DISP_SHADOW_EN > 0
+    DispFlush();
+#endif
+}
+
+
+/*
+*********************************************************************************************************
+*                                             Test_RowChk()
+*
+* Description : Check the characters a row of the simulated module shows.
+*********************************************************************************************************
+*/
+
+static  void  Test_RowChk (CPU_INT08U   row,
+                           const char  *pexp)
+{
+    CPU_CHAR  buf[COLS + 1];
+
+
+    DispSimRowGet(row, COLS, buf);
+    TEST_CHK(strcmp((char *)buf, pexp) == 0);
+    if (strcmp((char *)buf, pexp) != 0) {
+        printf("  row %u: \"%s\", expected \"%s\"\n", (unsigned)row, buf, pexp);
+    }
+}
+
+
+#if DISP_SHADOW_EN > 0
+/*
+*********************************************************************************************************
+*                                             Test_Bytes()
+*
+* Description : Return the bytes sent to the module since the last call.
+*********************************************************************************************************
+*/
+
+static  void  Test_Bytes (CPU_INT32U  *pcmd,
+                          CPU_INT32U  *pdata)
+{
+    DISP_SIM_STAT  stat;
+
+
+    DispSimStatGet(&stat);
+    *pcmd  = stat.CmdCtr;
+    *pdata = stat.DataCtr;
+    TEST_CHK(stat.BusyWrCtr == 0);
+    DispSimStatClr();
+}
+
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                             Test_Flush()
+*
+* Description : Check the bytes DispFlush() sends (see Note #1).
+*********************************************************************************************************
+*/
+
+static  void  Test_Flush (void)
+{
+    CPU_INT32U  cmd;
+    CPU_INT32U  data;
+
+
+    DispSimStatClr();
+    DispFlush();                                                /* Unchanged screen: nothing is sent.                   */
+    Test_Bytes(&cmd, &data);
+    TEST_CHK(cmd == 0 && data == 0);
+
+    DispStr(0, 0, (CPU_INT08U *)"Range: 42cm");                 /* The blank already shown splits the line in 2 runs.   */
+    Test_Bytes(&cmd, &data);
+    TEST_CHK(cmd == 0 && data == 0);                            /* Nothing before the flush ...                         */
+    DispFlush();
+    Test_Bytes(&cmd, &data);
+    TEST_CHK(cmd == 2 && data == 10);                           /* ... then one address per run.                        */
+    Test_RowChk(0, "Range: 42cm     ");
+
+    DispStr(0, 0, (CPU_INT08U *)"Range: 43cm");                 /* Rewriting a line only sends what changed.            */
+    DispFlush();
+    Test_Bytes(&cmd, &data);
+    TEST_CHK(cmd == 1 && data == 1);
+    Test_RowChk(0, "Range: 43cm     ");
+
+    DispChar(0, 0, 'r');                                        /* Two runs.                                            */
+    DispChar(1, 15, '!');
+    DispFlush();
+    Test_Bytes(&cmd, &data);
+    TEST_CHK(cmd == 2 && data == 2);
+    Test_RowChk(0, "range: 43cm     ");
+    Test_RowChk(1, "               !");
+
+    DispChar(0, 0, 'R');                                        /* Changed & changed back: nothing to send.             */
+    DispChar(0, 0, 'r');
+    DispFlush();
+    Test_Bytes(&cmd, &data);
+    TEST_CHK(cmd == 0 && data == 0);
+
+    DispClrLine(1);                                             /* Clear + rewrite: only the cells that differ.         */
+    DispStr(1, 0, (CPU_INT08U *)"SAFE");
+    DispFlush();
+    Test_Bytes(&cmd, &data);
+    TEST_CHK(cmd == 2 && data == 5);
+    Test_RowChk(1, "SAFE            ");
+
+    DispClrScr();                                               /* No 'clear display': blanks what is not blank.        */
+    DispFlush();
+    Test_Bytes(&cmd, &data);
+    TEST_CHK(cmd == 3 && data == 14);
+    Test_RowChk(0, "                ");
+    Test_RowChk(1, "                ");
+}
+#endif
+
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                            Test_Replay()
+*
+* Description : Replay the range demo (see Note #2 & #3).
+*********************************************************************************************************
+*/
+
+static  void  Test_Replay (void)
+{
+    CPU_CHAR        range_str[] = "Range:   cm";
+    CPU_INT08U     *status;
+    CPU_INT08U      range;
+    CPU_INT32U      i;
+    CPU_INT32U      moving_ticks;
+    DISP_SIM_STAT   stat;
+    DISP_SIM_STAT   tot;
+
+
+    Mem_Clr((void *)&tot, sizeof(tot));
+    moving_ticks = 0;
+    for (i = 0; i < REPLAY_NBR * sizeof(ReplayRange); i++) {
+        range = ReplayRange[i % sizeof(ReplayRange)];
+        DispSimStatClr();
+        if (range == 0) {
+            status = (CPU_INT08U *)"CRASH";
+        } else if (range <= 80) {
+            (void)Str_FmtNbr_Int32U((CPU_INT32U)range, 2, ' ', DEF_NO, &range_str[7]);
+            DispStr(0, 0, (CPU_INT08U *)range_str);
+            Test_Update();
+            if (range >= 20) {
+                status = (CPU_INT08U *)"SAFE";
+            } else if (range >= 13) {
+                status = (CPU_INT08U *)"SLOW DOWN";
+            } else {
+                status = (CPU_INT08U *)"DANGEROUS";
+            }
+        } else {
+            status = (CPU_INT08U *)"Moving...";
+        }
+        DispClrLine(1);
+        DispStr(1, 0, status);
+        Test_Update();
+
+        DispSimStatGet(&stat);
+        tot.CmdCtr    += stat.CmdCtr;
+        tot.DataCtr   += stat.DataCtr;
+        tot.BusyWrCtr += stat.BusyWrCtr;
+        tot.Time_uS   += stat.Time_uS;
+        tot.DlyTicks  += stat.DlyTicks;
+        if ((range > 80) && (moving_ticks == 0)) {
+            moving_ticks = stat.DlyTicks;
+        }
+    }
+    TEST_CHK(tot.BusyWrCtr == 0);
+    Test_RowChk(0, "Range: 35cm     ");
+    Test_RowChk(1, "Moving...       ");
+
+    printf("replay:  %6lu bytes (%lu instructions), %7.1f bytes/sample, %8.1f us/sample on the bus\n",
+           (unsigned long)(tot.CmdCtr + tot.DataCtr), (unsigned long)tot.CmdCtr,
+           (double)(tot.CmdCtr + tot.DataCtr) / (REPLAY_NBR * sizeof(ReplayRange)),
+           (double)tot.Time_uS / (REPLAY_NBR * sizeof(ReplayRange)));
+    printf("         first 'Moving...' sample: %lu OS ticks with the old DispDly_uS() (Note #3)\n",
+           (unsigned long)moving_ticks);
+#if DISP_SHADOW_EN > 0
+    TEST_CHK(moving_ticks == 3 * (1 + 9));                      /* Only 'Moving...' over 'DANGEROUS' is sent.           */
+    TEST_CHK(tot.CmdCtr + tot.DataCtr < REPLAY_NBR * sizeof(ReplayRange) * 10);
+#else
+    TEST_CHK(moving_ticks == 3 * (1 + COLS + 1 + 1 + 9));       /* 3 strobes per byte, 1 tick each.                     */
+#endif
+}
+
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                             TestTask()
+*********************************************************************************************************
+*/
+
+static  void  TestTask (void *p_arg)
+{
+    DISP_SIM_STAT  stat;
+
+
+    (void)p_arg;
+    DispSimStatClr();
+    DispInit(ROWS, COLS);
+    DispSimStatGet(&stat);
+    TEST_CHK(stat.ClrCtr    == 1);
+    TEST_CHK(stat.BusyWrCtr == 0);
+    Test_RowChk(0, "                ");
+    Test_RowChk(1, "                ");
+
+#if DISP_SHADOW_EN > 0
+    Test_Flush();
+#endif
+    Test_Replay();
+
+#if DISP_SHADOW_EN > 0
+    Test_Done("test_lcd_shadow (DISP_SHADOW_EN 1)");
+#else
+    Test_Done("test_lcd_shadow (DISP_SHADOW_EN 0)");
+#endif
+}
+
+
+int  main (void)
+{
+    OSInit();
+    (void)OSTaskCreateExt(TestTask,
+                          (void *)0,
+                          &TestTaskStk[TEST_TASK_STK_SIZE - 1],
+                          TEST_TASK_PRIO,
+                          TEST_TASK_PRIO,
+                          &TestTaskStk[0],
+                          TEST_TASK_STK_SIZE,
+                          (void *)0,
+                          OS_TASK_OPT_NONE);
+    OSStart();
+    return (0);
+}
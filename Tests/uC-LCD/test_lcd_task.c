@@ -0,0 +1,237 @@
+/*
+*********************************************************************************************************
+*                                             HOST TESTS
+*
+*                                   uC/LCD Task & Command Queue
+*
+* Filename      : test_lcd_task.c
+* Note(s)       : (1) Built with DISP_TASK_EN & DISP_SHADOW_EN, against the simulated HD44780 of 'lcd_sim.c'.
+*                     The test task runs above DISP_TASK_PRIO, so the uC/LCD Task only runs when the test
+*                     task waits.  The drawing calls MUST neither block nor touch the bus.
+*
+*                 (2) Ordering: the queued commands MUST be performed in the order they were called, & the
+*                     batch sent with a single flush once the queue is empty.
+*
+*                 (3) Queue full: with DISP_TASK_Q_SIZE commands queued, the next ones are dropped & counted
+*                     in DispCmdOvfCtr, DispNotify() returns DEF_FAIL.  Once drained, every command block
+*                     MUST be available again.
+*********************************************************************************************************
+*/
+
+#include  <includes.h>
+#include  "lcd_sim.h"
+
+
+/*
+*********************************************************************************************************
+*                                            LOCAL DEFINES
+*********************************************************************************************************
+*/
+
+#define  ROWS                              2
+#define  COLS                             16
+
+#define  OVF_NBR                           4                    /* Commands posted past a full queue.                   */
+#define  MEAS_NBR                      10000
+
+
+/*
+*********************************************************************************************************
+*                                        LOCAL GLOBAL VARIABLES
+*********************************************************************************************************
+*/
+
+static  OS_STK      TestTaskStk[TEST_TASK_STK_SIZE];
+
+static  OS_EVENT   *DoneSem;
+
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                             Test_RowChk()
+*
+* Description : Check the characters a row of the simulated module shows.
+*********************************************************************************************************
+*/
+
+static  void  Test_RowChk (CPU_INT08U   row,
+                           const char  *pexp)
+{
+    CPU_CHAR  buf[COLS + 1];
+
+
+    DispSimRowGet(row, COLS, buf);
+    TEST_CHK(strcmp((char *)buf, pexp) == 0);
+    if (strcmp((char *)buf, pexp) != 0) {
+        printf("  row %u: \"%s\", expected \"%s\"\n", (unsigned)row, buf, pexp);
+    }
+}
+
+
+/*
+*********************************************************************************************************
+*                                             Test_Wait()
+*
+* Description : Wait until the uC/LCD Task performed every command queued so far.
+*********************************************************************************************************
+*/
+
+static  void  Test_Wait (void)
+{
+    INT8U  err;
+
+
+    TEST_CHK(DispNotify((void *)DoneSem) == DEF_OK);
+    OSSemPend(DoneSem, OS_TICKS_PER_SEC, &err);
+    TEST_CHK(err == OS_ERR_NONE);
+}
+
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                             Test_Order()
+*
+* Description : See Note #2.
+*********************************************************************************************************
+*/
+
+static  void  Test_Order (void)
+{
+    INT32U         ctx_sw;
+    DISP_SIM_STAT  stat;
+
+
+    DispSimStatClr();
+    ctx_sw = OSCtxSwCtr;
+    DispStr(0, 0, (CPU_INT08U *)"0123456789ABCDEF");
+    DispClrLine(0);
+    DispStr(0, 0, (CPU_INT08U *)"order");
+    DispChar(0, 0, 'O');
+    DispStr(1, 0, (CPU_INT08U *)"abc");
+    DispClrLine(1);
+    DispStr(1, 2, (CPU_INT08U *)"xyz");
+    DispChar(1, 3, 'Y');
+    DispFlush();
+    TEST_CHK(OSCtxSwCtr == ctx_sw);                             /* The caller was not blocked ...                       */
+    DispSimStatGet(&stat);
+    TEST_CHK(stat.CmdCtr + stat.DataCtr == 0);                  /* ... & nothing was sent yet.                          */
+
+    Test_Wait();
+    Test_RowChk(0, "Order           ");
+    Test_RowChk(1, "  xYz           ");
+    DispSimStatGet(&stat);
+    TEST_CHK(stat.CmdCtr  == 2);                                /* Only the end result is sent: 1 run per line.         */
+    TEST_CHK(stat.DataCtr == 5 + 3);
+    TEST_CHK(stat.BusyWrCtr == 0);
+}
+
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                             Test_Full()
+*
+* Description : See Note #3.
+*********************************************************************************************************
+*/
+
+static  void  Test_Full (void)
+{
+    CPU_INT16U  ovf;
+    CPU_INT08U  i;
+
+
+    DispClrScr();
+    Test_Wait();
+
+    ovf = DispCmdOvfCtr;
+    for (i = 0; i < DISP_TASK_Q_SIZE + OVF_NBR; i++) {         /* Characters past the queue's size are dropped.        */
+        DispChar(1, i, (CPU_INT08U)('a' + i));
+    }
+    TEST_CHK(DispCmdOvfCtr == ovf + OVF_NBR);
+    TEST_CHK(DispNotify((void *)DoneSem) == DEF_FAIL);
+    TEST_CHK(DispCmdOvfCtr == ovf + OVF_NBR + 1);
+
+    OSTimeDly(2);                                               /* Let the uC/LCD Task drain the queue.                 */
+    Test_RowChk(0, "                ");
+    Test_RowChk(1, "abcdefghijklmnop");
+
+    ovf = DispCmdOvfCtr;                                        /* Every block is free again ...                        */
+    for (i = 0; i < DISP_TASK_Q_SIZE - 1; i++) {
+        DispChar(0, i, (CPU_INT08U)('A' + i));
+    }
+    Test_Wait();                                                /* ... including the one for the notification.          */
+    TEST_CHK(DispCmdOvfCtr == ovf);
+    Test_RowChk(0, "ABCDEFGHIJKLMNO ");
+}
+
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                             Test_Cost()
+*
+* Description : Print the time a drawing call takes the caller.
+*********************************************************************************************************
+*/
+
+static  void  Test_Cost (void)
+{
+    CPU_INT32U          i;
+    CPU_INT08U          n;
+    unsigned long long  t0;
+    unsigned long long  ns;
+
+
+    ns = 0;
+    for (i = 0; i < MEAS_NBR; i += DISP_TASK_Q_SIZE - 1) {
+        t0 = Test_TimeNs();
+        for (n = 0; n < DISP_TASK_Q_SIZE - 1; n++) {
+            DispStr(1, 0, (CPU_INT08U *)"Moving...");
+        }
+        ns += Test_TimeNs() - t0;
+        Test_Wait();
+    }
+    TEST_CHK(DispCmdOvfCtr == OVF_NBR + 1);                     /* Only the drops of Test_Full().                       */
+    printf("caller:  %6.1f host ns per queued DispStr()\n", (double)ns / i);
+}
+
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                             TestTask()
+*********************************************************************************************************
+*/
+
+static  void  TestTask (void *p_arg)
+{
+    (void)p_arg;
+    DoneSem = OSSemCreate(0);
+    DispInit(ROWS, COLS);
+
+    Test_Order();
+    Test_Full();
+    Test_Cost();
+
+    Test_Done("test_lcd_task");
+}
+
+
+int  main (void)
+{
+    OSInit();
+    (void)OSTaskCreateExt(TestTask,
+                          (void *)0,
+                          &TestTaskStk[TEST_TASK_STK_SIZE - 1],
+                          TEST_TASK_PRIO,
+                          TEST_TASK_PRIO,
+                          &TestTaskStk[0],
+                          TEST_TASK_STK_SIZE,
+                          (void *)0,
+                          OS_TASK_OPT_NONE);
+    OSStart();
+    return (0);
+}
@@ -0,0 +1,168 @@
+/*
+*********************************************************************************************************
+*                                             HOST TESTS
+*
+*                                     uC/LIB Memory Sequence Locks
+*
+* Filename      : test_lib_mem_seq.c
+* Note(s)       : (1) One host thread publishes a record with Mem_SeqWr() as fast as it can (standing in for
+*                     the ISR of 'Mem_SeqWr()  Note #1') while RD_NBR threads take snapshots with Mem_SeqRd()
+*                     on other cores.  Every field of a record holds the same generation number, so a torn
+*                     snapshot is seen at once.  Generations seen by one reader MUST never go backwards.
+*
+*                 (2) Also built with '-fsanitize=thread'.  The reads in Mem_SeqRd() race with the writer by
+*                     design; 'tsan.supp' suppresses only those (see 'Tests/Makefile').  GCC's ThreadSanitizer
+*                     does not model the fences of CPU_RMB()/CPU_WMB(), so the ordering itself is checked by
+*                     the torn-snapshot test of the plain build, which runs on real cores.
+*********************************************************************************************************
+*/
+
+#include  <includes.h>
+#include  <pthread.h>
+
+
+/*
+*********************************************************************************************************
+*                                            LOCAL DEFINES
+*********************************************************************************************************
+*/
+
+#define  RD_NBR                            2
+#define  REC_NBR_FIELDS                    8
+
+#ifdef   __SANITIZE_THREAD__
+#define  WR_NBR                       200000                    /* ThreadSanitizer runs ~10x slower.                    */
+#else
+#define  WR_NBR                      5000000
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                           LOCAL DATA TYPES
+*********************************************************************************************************
+*/
+
+typedef  struct  test_rec {
+    CPU_INT32U  Field[REC_NBR_FIELDS];
+} TEST_REC;
+
+typedef  struct  test_rd {                                      /* Results of one reader.                               */
+    CPU_INT32U  NbrRd;
+    CPU_INT32U  NbrRetry;
+    CPU_INT32U  NbrTorn;
+    CPU_INT32U  NbrBack;
+} TEST_RD;
+
+
+/*
+*********************************************************************************************************
+*                                        LOCAL GLOBAL VARIABLES
+*********************************************************************************************************
+*/
+
+static  MEM_SEQ             RecSeq;
+static  TEST_REC            Rec;
+static  volatile  CPU_INT32U  WrDone;
+
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                             WrThread()
+*                                             RdThread()
+*
+* Description : Writer & readers of Note #1.
+*********************************************************************************************************
+*/
+
+static  void  *WrThread (void *p_arg)
+{
+    TEST_REC    rec;
+    CPU_INT32U  gen;
+    CPU_INT32U  ix;
+
+
+    (void)p_arg;
+    for (gen = 1; gen <= WR_NBR; gen++) {
+        for (ix = 0; ix < REC_NBR_FIELDS; ix++) {
+            rec.Field[ix] = gen;
+        }
+        Mem_SeqWr(&RecSeq, (void *)&Rec, (void *)&rec, sizeof(rec));
+    }
+    __atomic_store_n(&WrDone, 1, __ATOMIC_RELEASE);
+    return ((void *)0);
+}
+
+
+static  void  *RdThread (void *p_arg)
+{
+    TEST_RD     *p_rd;
+    TEST_REC     rec;
+    CPU_INT32U   gen_last;
+    CPU_INT32U   ix;
+
+
+    p_rd     = (TEST_RD *)p_arg;
+    gen_last = 0;
+    while (__atomic_load_n(&WrDone, __ATOMIC_ACQUIRE) == 0) {
+        p_rd->NbrRetry += Mem_SeqRd(&RecSeq, (void *)&rec, (void *)&Rec, sizeof(rec));
+        p_rd->NbrRd++;
+        for (ix = 1; ix < REC_NBR_FIELDS; ix++) {
+            if (rec.Field[ix] != rec.Field[0]) {
+                p_rd->NbrTorn++;
+                break;
+            }
+        }
+        if (rec.Field[0] < gen_last) {
+            p_rd->NbrBack++;
+        }
+        gen_last = rec.Field[0];
+    }
+    return ((void *)0);
+}
+
+
+/*$PAGE*/
+int  main (void)
+{
+    pthread_t           wr;
+    pthread_t           rd[RD_NBR];
+    TEST_RD             res[RD_NBR];
+    TEST_REC            rec;
+    CPU_INT32U          ix;
+    unsigned long long  t0;
+    unsigned long long  t1;
+
+
+    Mem_Clr((void *)res, sizeof(res));
+    for (ix = 0; ix < RD_NBR; ix++) {
+        TEST_CHK(pthread_create(&rd[ix], NULL, RdThread, (void *)&res[ix]) == 0);
+    }
+    t0 = Test_TimeNs();
+    TEST_CHK(pthread_create(&wr, NULL, WrThread, NULL) == 0);
+    (void)pthread_join(wr, NULL);
+    t1 = Test_TimeNs();
+    for (ix = 0; ix < RD_NBR; ix++) {
+        (void)pthread_join(rd[ix], NULL);
+        printf("reader %u: %8u snapshots, %8u retried, %u torn, %u backwards\n",
+               (unsigned)ix, (unsigned)res[ix].NbrRd, (unsigned)res[ix].NbrRetry,
+               (unsigned)res[ix].NbrTorn, (unsigned)res[ix].NbrBack);
+        TEST_CHK(res[ix].NbrRd    >  0);
+        TEST_CHK(res[ix].NbrTorn  == 0);
+        TEST_CHK(res[ix].NbrBack  == 0);
+    }
+    printf("writer  : %8u updates, %.1f ns each with %u readers\n",
+           (unsigned)WR_NBR, (double)(t1 - t0) / WR_NBR, (unsigned)RD_NBR);
+
+    (void)Mem_SeqRd(&RecSeq, (void *)&rec, (void *)&Rec, sizeof(rec));
+    TEST_CHK(rec.Field[0] == WR_NBR);                           /* Last update is seen ...                              */
+    TEST_CHK((RecSeq & 0x0001) == 0);                           /* ... & the counter is left even.                      */
+
+#ifdef   __SANITIZE_THREAD__
+    Test_Done("test_lib_mem_seq (ThreadSanitizer)");
+#else
+    Test_Done("test_lib_mem_seq");
+#endif
+    return (0);
+}
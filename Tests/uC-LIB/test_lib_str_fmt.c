@@ -0,0 +1,223 @@
+/*
+*********************************************************************************************************
+*                                             HOST TESTS
+*
+*                                 uC/LIB Integer Formatting, Str_FmtNbr_Int32U()
+*
+* Filename      : test_lib_str_fmt.c
+* Note(s)       : (1) Str_FmtNbr_Int32U() MUST format exactly what snprintf("%0*u") formats, truncated to
+*                     'nbr_dig' digits, with the lead zeros replaced by 'lead_char' but for the one's digit.
+*                     Checked for widths 0 to 12 & a sweep of the whole 32 bit range.  With 'nul' DEF_NO,
+*                     nothing past the digits is written.
+*
+*                 (2) The range demo ('app.c') used to show a range by picking "Range: NNcm" from RangeStr[],
+*                     46 strings of 18 bytes on the LCD task's stack.  The line formatted in place MUST be
+*                     the same for the ranges the table held (blank padded below 10).
+*
+*                 (3) Benchmark, in host ns per line: the RangeStr[] lookup, Str_FmtNbr_Int32U() & the FP
+*                     based Str_FmtNbr_32() formatting the 2 digits in place; then 7 digit numbers.  The
+*                     host has an FPU: on the HCS12 Str_FmtNbr_32() runs in soft-float, & the lookup costs
+*                     828 bytes of stack (1458 to cover the 80 cm the sensor returns) against the 200 byte
+*                     digit pair table of Str_FmtNbr_Int32U() in ROM.
+*********************************************************************************************************
+*/
+
+#include  <includes.h>
+
+
+/*
+*********************************************************************************************************
+*                                            LOCAL DEFINES
+*********************************************************************************************************
+*/
+
+#define  RANGE_TBL_NBR                    46                    /* As the RangeStr[] table of 'app.c'.                  */
+#define  RANGE_TBL_LEN                    18
+#define  RANGE_DIG_IX                      7
+
+#define  MEAS_NBR                    3000000
+
+
+/*
+*********************************************************************************************************
+*                                        LOCAL GLOBAL VARIABLES
+*********************************************************************************************************
+*/
+
+static  CPU_CHAR            RangeTbl[RANGE_TBL_NBR][RANGE_TBL_LEN];
+
+static  volatile  CPU_CHAR  Sink;
+
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                             Test_Fmt()
+*
+* Description : Format 'nbr' both ways & compare with snprintf() (see Note #1).
+*
+* Return(s)   : 1 if the strings differ, 0 otherwise.
+*********************************************************************************************************
+*/
+
+static  CPU_INT32U  Test_Fmt (CPU_INT32U  nbr,
+                              CPU_INT08U  nbr_dig)
+{
+    char        ref[24];
+    char        exp[24];
+    CPU_CHAR    buf[24];
+    size_t      len;
+    CPU_INT08U  i;
+    CPU_INT32U  bad;
+
+
+    snprintf(ref, sizeof(ref), "%0*lu", (int)nbr_dig, (unsigned long)nbr);
+    len = strlen(ref);
+    if (len > nbr_dig) {                                        /* Most-significant digits truncated.                   */
+        memmove(ref, ref + len - nbr_dig, nbr_dig + 1);
+    }
+
+    bad = 0;
+    (void)Str_FmtNbr_Int32U(nbr, nbr_dig, '0', DEF_YES, buf);
+    if (strcmp((char *)buf, ref) != 0) {
+        bad = 1;
+    }
+
+    strcpy(exp, ref);
+    for (i = 0; (i + 1 < nbr_dig) && (exp[i] == '0'); i++) {
+        exp[i] = ' ';
+    }
+    (void)Str_FmtNbr_Int32U(nbr, nbr_dig, ' ', DEF_YES, buf);
+    if (strcmp((char *)buf, exp) != 0) {
+        bad = 1;
+    }
+
+    memset(buf, '#', sizeof(buf));                              /* Without 'nul', nothing past the digits.              */
+    (void)Str_FmtNbr_Int32U(nbr, nbr_dig, ' ', DEF_NO, buf);
+    if ((memcmp(buf, exp, nbr_dig) != 0) || (buf[nbr_dig] != '#')) {
+        bad = 1;
+    }
+
+    if (bad != 0) {
+        printf("  %lu, %u digits: \"%s\", expected \"%s\"\n", (unsigned long)nbr, (unsigned)nbr_dig, buf, ref);
+    }
+    return (bad);
+}
+
+
+/*
+*********************************************************************************************************
+*                                            Test_Check()
+*
+* Description : See Note #1 & #2.
+*********************************************************************************************************
+*/
+
+static  void  Test_Check (void)
+{
+    static  const  CPU_INT32U  nbr_tbl[] = {0, 1, 9, 10, 42, 80, 99, 100, 9999, 10000, 12345, 99999999,
+                                            100000000, 42949672, 4294967295u};
+    CPU_CHAR            line[] = "Range:   cm";
+    CPU_INT08U          nbr_dig;
+    CPU_INT08U          i;
+    unsigned long long  nbr;
+    CPU_INT32U          bad;
+
+
+    bad = 0;
+    for (nbr_dig = 0; nbr_dig <= 12; nbr_dig++) {
+        for (i = 0; i < sizeof(nbr_tbl) / sizeof(nbr_tbl[0]); i++) {
+            bad += Test_Fmt(nbr_tbl[i], nbr_dig);
+        }
+    }
+    for (nbr = 0; nbr <= 0xFFFFFFFFuLL; nbr += 65521) {
+        bad += Test_Fmt((CPU_INT32U)nbr, 10);
+    }
+    TEST_CHK(bad == 0);
+
+    for (i = 0; i < RANGE_TBL_NBR; i++) {                       /* Same line as the table (see Note #2).                */
+        snprintf((char *)RangeTbl[i], RANGE_TBL_LEN, (i < 10) ? "Range:  %ucm" : "Range: %ucm", (unsigned)i);
+        (void)Str_FmtNbr_Int32U(i, 2, ' ', DEF_NO, &line[RANGE_DIG_IX]);
+        TEST_CHK(strcmp((char *)line, (char *)RangeTbl[i]) == 0);
+    }
+}
+
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                            Test_Bench()
+*
+* Description : See Note #3.
+*********************************************************************************************************
+*/
+
+static  void  Test_Bench (void)
+{
+    CPU_CHAR            line[] = "Range:   cm";
+    CPU_CHAR            buf[16];
+    CPU_CHAR           *pline;
+    CPU_INT32U          i;
+    unsigned long long  t0;
+    double              ns_tbl;
+    double              ns_int;
+    double              ns_fp;
+
+
+    t0 = Test_TimeNs();
+    for (i = 0; i < MEAS_NBR; i++) {
+        pline = RangeTbl[i % RANGE_TBL_NBR];
+        Sink  = pline[RANGE_DIG_IX];
+    }
+    ns_tbl = (double)(Test_TimeNs() - t0) / MEAS_NBR;
+
+    t0 = Test_TimeNs();
+    for (i = 0; i < MEAS_NBR; i++) {
+        (void)Str_FmtNbr_Int32U(i % 81, 2, ' ', DEF_NO, &line[RANGE_DIG_IX]);
+        Sink = line[RANGE_DIG_IX];
+    }
+    ns_int = (double)(Test_TimeNs() - t0) / MEAS_NBR;
+
+    t0 = Test_TimeNs();
+    for (i = 0; i < MEAS_NBR; i++) {
+        (void)Str_FmtNbr_32((CPU_FP32)(i % 81), 2, 0, DEF_NO, DEF_NO, &line[RANGE_DIG_IX]);
+        Sink = line[RANGE_DIG_IX];
+    }
+    ns_fp = (double)(Test_TimeNs() - t0) / MEAS_NBR;
+    printf("\"Range: NNcm\": RangeStr[] %5.1f ns, Str_FmtNbr_Int32U() %5.1f ns, Str_FmtNbr_32() %5.1f ns\n",
+           ns_tbl, ns_int, ns_fp);
+
+    t0 = Test_TimeNs();
+    for (i = 0; i < MEAS_NBR; i++) {
+        (void)Str_FmtNbr_Int32U(i % 1000000, 7, '0', DEF_YES, buf);
+        Sink = buf[0];
+    }
+    ns_int = (double)(Test_TimeNs() - t0) / MEAS_NBR;
+
+    t0 = Test_TimeNs();
+    for (i = 0; i < MEAS_NBR; i++) {
+        (void)Str_FmtNbr_32((CPU_FP32)(i % 1000000), 7, 0, DEF_YES, DEF_YES, buf);
+        Sink = buf[0];
+    }
+    ns_fp = (double)(Test_TimeNs() - t0) / MEAS_NBR;
+    printf("7 digits     :                   Str_FmtNbr_Int32U() %5.1f ns, Str_FmtNbr_32() %5.1f ns\n",
+           ns_int, ns_fp);
+    printf("memory       : RangeStr[] %u bytes of stack, digit pairs %u bytes of ROM\n",
+           (unsigned)sizeof(RangeTbl), 200u);
+}
+
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                               main()
+*********************************************************************************************************
+*/
+
+int  main (void)
+{
+    Test_Check();
+    Test_Bench();
+    Test_Done("test_lib_str_fmt");
+    return (0);
+}
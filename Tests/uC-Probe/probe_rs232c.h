@@ -0,0 +1,16 @@
+/*
+*********************************************************************************************************
+*                                             HOST TESTS
+*
+*                                   uC/Probe RS-232 Port for the Host
+*
+* Filename      : probe_rs232c.h
+* Note(s)       : (1) Stands in for the port header 'probe_rs232.h' includes.  The port functions are
+*                     provided by 'probe_sim.c'.
+*********************************************************************************************************
+*/
+
+#ifndef  PROBE_RS232C_H
+#define  PROBE_RS232C_H
+
+#endif
@@ -0,0 +1,932 @@
+/*
+*********************************************************************************************************
+*                                             HOST TESTS
+*
+*                                  Simulated SCI for uC/Probe RS-232
+*
+* Filename      : probe_sim.c
+* Note(s)       : (1) See 'probe_sim.h'.  Only what 'probe_rs232.c' uses is modelled: the transmit data
+*                     register, the shift register, TIE & RIE, 8N1 framing (10 bits per byte) & the line in
+*                     both directions.  Received bytes are handed to ProbeRS232_RxHandler() as they arrive.
+*
+*                 (2) The host decodes the frames of 'probe_rs232.c  RS-232 PACKET FORMAT' & checks the
+*                     CRC-16 of frames framed with one with its own, bitwise, CRC-16/CCITT.  The checksum
+*                     is not checked: the target sends 0 (PROBE_RS232_USE_CHECKSUM is DEF_FALSE).
+*********************************************************************************************************
+*/
+
+#define  _DEFAULT_SOURCE
+#define  _XOPEN_SOURCE  600
+
+#include  <includes.h>
+#include  <probe_com.h>
+#include  <probe_rs232.h>
+#include  "probe_sim.h"
+
+#include  <fcntl.h>
+#include  <poll.h>
+#include  <termios.h>
+#include  <unistd.h>
+#include  <errno.h>
+
+
+/*
+*********************************************************************************************************
+*                                            LOCAL DEFINES
+*********************************************************************************************************
+*/
+
+#define  PROBE_SIM_RX_Q_SIZE           16384                    /* Bytes on their way to the SCI.                       */
+#define  PROBE_SIM_REQ_TMO_MS           1000                    /* ProbeSim_Req() timeout.                              */
+#define  PROBE_SIM_PTY_TMO_MS           2000                    /* A pty read this late means the harness is broken.    */
+
+#define  PROBE_SIM_TIME_NONE     0xFFFFFFFFFFFFFFFFuLL
+
+                                                                /* Host decoder states.                                 */
+#define  PROBE_SIM_RX_SD0                  0
+#define  PROBE_SIM_RX_SD1                  1
+#define  PROBE_SIM_RX_SD2                  2
+#define  PROBE_SIM_RX_SD3                  3
+#define  PROBE_SIM_RX_LEN1                 4
+#define  PROBE_SIM_RX_LEN2                 5
+#define  PROBE_SIM_RX_PAD1                 6
+#define  PROBE_SIM_RX_PAD2                 7
+#define  PROBE_SIM_RX_DATA                 8
+#define  PROBE_SIM_RX_CHK1                 9
+#define  PROBE_SIM_RX_CHK2                10
+#define  PROBE_SIM_RX_ED                  11
+
+
+/*
+*********************************************************************************************************
+*                                        LOCAL GLOBAL VARIABLES
+*********************************************************************************************************
+*/
+
+static  int                   ProbeSimFdSCI = -1;               /* Master side of the pty (see 'probe_sim.h' Note #2). */
+static  int                   ProbeSimFdHost = -1;              /* Slave  side.                                         */
+
+static  CPU_INT08U            ProbeSimMode;
+static  CPU_INT32U            ProbeSimISRNs;
+static  CPU_INT32U            ProbeSimHostLatNs;
+static  CPU_INT32U            ProbeSimByteNs;
+static  unsigned  long long   ProbeSimNow;                      /* Simulated time, in ns.                               */
+
+                                                                /* ------------------- TRANSMITTER -------------------- */
+static  CPU_BOOLEAN           ProbeSimTIE;
+static  unsigned  long long   ProbeSimTIETime;                  /* When TIE was last set.                               */
+static  CPU_BOOLEAN           ProbeSimDRFull;
+static  CPU_INT08U            ProbeSimDR;
+static  unsigned  long long   ProbeSimDREmptyTime;              /* When the data register last emptied.                 */
+static  CPU_BOOLEAN           ProbeSimShiftBusy;
+static  CPU_INT08U            ProbeSimShift;
+static  unsigned  long long   ProbeSimShiftEnd;                 /* When the byte being shifted out is done.             */
+static  unsigned  long long   ProbeSimIdleTime;                 /* When the shift register last went idle.              */
+
+                                                                /* --------------------- RECEIVER --------------------- */
+static  CPU_BOOLEAN           ProbeSimRIE;
+static  CPU_INT08U            ProbeSimRxQ[PROBE_SIM_RX_Q_SIZE];
+static  unsigned  long long   ProbeSimRxQTime[PROBE_SIM_RX_Q_SIZE];
+static  CPU_INT32U            ProbeSimRxQRdIx;
+static  CPU_INT32U            ProbeSimRxQNbr;
+static  unsigned  long long   ProbeSimRxLineFree;               /* When the host may start the next byte.               */
+static  CPU_INT08U            ProbeSimRxData;
+
+                                                                /* ---------------------- HOST ------------------------ */
+static  CPU_INT08U            ProbeSimHostState;
+static  CPU_INT16U            ProbeSimHostLen;
+static  CPU_INT16U            ProbeSimHostIx;
+static  CPU_INT08U            ProbeSimHostHdr[4];               /* Length & padding, for the CRC-16.                    */
+static  CPU_INT16U            ProbeSimHostCRC;
+static  PROBE_SIM_PKT         ProbeSimHostPkt;
+static  PROBE_SIM_HNDLR_FNCT  ProbeSimHndlr;
+static  PROBE_SIM_PKT        *ProbeSimRspPtr;                   /* Response awaited by ProbeSim_Req().                  */
+static  CPU_BOOLEAN           ProbeSimRspRdy;
+
+static  PROBE_SIM_STAT        ProbeSimStat;
+
+
+/*
+*********************************************************************************************************
+*                                       LOCAL FUNCTION PROTOTYPES
+*********************************************************************************************************
+*/
+
+static  void                ProbeSim_FdWr     (int                 fd,
+                                               const CPU_INT08U   *p,
+                                               CPU_INT32U          len);
+
+static  void                ProbeSim_FdRd     (int                 fd,
+                                               CPU_INT08U         *p,
+                                               CPU_INT32U          len);
+
+static  unsigned  long long ProbeSim_TxIntTime(void);
+
+static  void                ProbeSim_TxByte   (CPU_INT08U          c);
+
+static  void                ProbeSim_ShiftDone(void);
+
+static  void                ProbeSim_RxISR    (void);
+
+static  void                ProbeSim_TxISR    (void);
+
+static  void                ProbeSim_HostRx   (CPU_INT08U          c);
+
+static  void                ProbeSim_HostPkt  (CPU_BOOLEAN         ok);
+
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                           ProbeSim_Init()
+*
+* Description : Open the line (see 'probe_sim.h' Note #2) & reset the SCI & the host, in PROBE_SIM_MODE_TDRE
+*               with no interrupt or host latency.  Call before ProbeRS232_Init().
+*********************************************************************************************************
+*/
+
+void  ProbeSim_Init (void)
+{
+    struct  termios  tio;
+    int              fd;
+
+
+    if (ProbeSimFdSCI < 0) {
+        fd = posix_openpt(O_RDWR | O_NOCTTY);
+        if ((fd < 0) || (grantpt(fd) != 0) || (unlockpt(fd) != 0)) {
+            printf("probe_sim: no pty\n");
+            exit(1);
+        }
+        ProbeSimFdSCI  = fd;
+        ProbeSimFdHost = open(ptsname(fd), O_RDWR | O_NOCTTY);
+        if (ProbeSimFdHost < 0) {
+            printf("probe_sim: cannot open %s\n", ptsname(fd));
+            exit(1);
+        }
+        (void)tcgetattr(ProbeSimFdHost, &tio);
+        cfmakeraw(&tio);
+        (void)tcsetattr(ProbeSimFdHost, TCSANOW, &tio);
+        (void)fcntl(ProbeSimFdSCI,  F_SETFL, O_NONBLOCK);
+        (void)fcntl(ProbeSimFdHost, F_SETFL, O_NONBLOCK);
+    }
+
+    ProbeSimNow        = (unsigned long long)OSTimeGet() * 1000000uLL;
+    ProbeSimByteNs     = 86806;                                 /* 115200 baud until ProbeRS232_InitTarget().           */
+    ProbeSimTIE        = DEF_NO;
+    ProbeSimDRFull     = DEF_NO;
+    ProbeSimShiftBusy  = DEF_NO;
+    ProbeSimIdleTime   = ProbeSimNow;
+    ProbeSimRIE        = DEF_NO;
+    ProbeSimRxQRdIx    = 0;
+    ProbeSimRxQNbr     = 0;
+    ProbeSimRxLineFree = ProbeSimNow;
+    ProbeSimHostState  = PROBE_SIM_RX_SD0;
+    ProbeSimHndlr      = (PROBE_SIM_HNDLR_FNCT)0;
+    ProbeSimRspPtr     = (PROBE_SIM_PKT *)0;
+    ProbeSim_Cfg(PROBE_SIM_MODE_TDRE, 0, 0);
+    ProbeSim_StatClr();
+}
+
+
+/*
+*********************************************************************************************************
+*                                            ProbeSim_Cfg()
+*
+* Description : Select when the TX interrupt is raised (see 'probe_sim.h' Note #4).
+*
+* Argument(s) : mode            PROBE_SIM_MODE_TDRE or PROBE_SIM_MODE_TC.
+*
+*               isr_ns          Latency of the TX interrupt, in ns.
+*
+*               host_lat_us     Time the host takes to send a packet, from the call to ProbeSim_HostTx().
+*********************************************************************************************************
+*/
+
+void  ProbeSim_Cfg (CPU_INT08U  mode,
+                    CPU_INT32U  isr_ns,
+                    CPU_INT32U  host_lat_us)
+{
+    ProbeSimMode      = mode;
+    ProbeSimISRNs     = isr_ns;
+    ProbeSimHostLatNs = host_lat_us * 1000;
+}
+
+
+/*
+*********************************************************************************************************
+*                                         ProbeSim_HndlrSet()
+*
+* Description : Set the function called with each packet the host decodes, as it is decoded.  The function
+*               may send further requests with ProbeSim_HostTx().
+*********************************************************************************************************
+*/
+
+void  ProbeSim_HndlrSet (PROBE_SIM_HNDLR_FNCT  hndlr)
+{
+    ProbeSimHndlr = hndlr;
+}
+
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                          ProbeSim_HostTx()
+*                                        ProbeSim_HostTxRaw()
+*
+* Description : Frame & send a request, or send bytes as they are.
+*
+* Argument(s) : pdata           Data segment of the request (or raw bytes).
+*
+*               len             Its length.
+*
+*               crc_en          DEF_YES to frame the request with a CRC-16, DEF_NO with a checksum.
+*
+* Note(s)     : (1) The host starts sending 'host_lat_us' after the call, or once it is done sending what
+*                   it sent before.
+*********************************************************************************************************
+*/
+
+void  ProbeSim_HostTx (const void   *pdata,
+                       CPU_INT16U    len,
+                       CPU_BOOLEAN   crc_en)
+{
+    static  CPU_INT08U  frame[PROBE_SIM_PKT_SIZE + 11];
+    const   CPU_INT08U *pdata_08;
+    CPU_INT16U          crc;
+    CPU_INT08U          chk_sum;
+    CPU_INT16U          ix;
+    CPU_INT16U          n;
+
+
+    pdata_08 = (const CPU_INT08U *)pdata;
+    frame[0] = 'u';
+    frame[1] = 'C';
+    frame[2] = 'P';
+    frame[3] = 'r';
+    frame[4] = len & 0xFF;
+    frame[5] = len >> 8;
+    frame[6] = (crc_en == DEF_YES) ? 0x01 : 0x00;
+    frame[7] = 0;
+    memcpy(&frame[8], pdata_08, len);
+    n        = 8 + len;
+    if (crc_en == DEF_YES) {
+        crc        = ProbeSim_CRC16(&frame[4], len + 4);
+        frame[n++] = crc >> 8;
+        frame[n++] = crc & 0xFF;
+    } else {
+        chk_sum    = frame[4] + frame[5];
+        for (ix = 0; ix < len; ix++) {
+            chk_sum += pdata_08[ix];
+        }
+        frame[n++] = chk_sum;
+    }
+    frame[n++] = '/';
+    ProbeSim_HostTxRaw(frame, n);
+}
+
+
+void  ProbeSim_HostTxRaw (const void  *pdata,
+                          CPU_INT16U   len)
+{
+    CPU_INT08U           buf[256];
+    const  CPU_INT08U   *pdata_08;
+    unsigned  long long  t;
+    CPU_INT32U           ix;
+    CPU_INT16U           n;
+    CPU_INT16U           i;
+
+
+    pdata_08 = (const CPU_INT08U *)pdata;
+    t        = ProbeSimNow + ProbeSimHostLatNs;                 /* See Note #1.                                         */
+    if (t < ProbeSimRxLineFree) {
+        t = ProbeSimRxLineFree;
+    }
+    while (len > 0) {                                           /* Through the pty, in chunks it can hold.              */
+        n = (len < sizeof(buf)) ? len : sizeof(buf);
+        ProbeSim_FdWr(ProbeSimFdHost, pdata_08, n);
+        ProbeSim_FdRd(ProbeSimFdSCI,  buf,      n);
+        for (i = 0; i < n; i++) {
+            if (ProbeSimRxQNbr >= PROBE_SIM_RX_Q_SIZE) {
+                printf("probe_sim: host sends too much\n");
+                exit(1);
+            }
+            t                     += ProbeSimByteNs;
+            ix                     = (ProbeSimRxQRdIx + ProbeSimRxQNbr) % PROBE_SIM_RX_Q_SIZE;
+            ProbeSimRxQ[ix]        = buf[i];
+            ProbeSimRxQTime[ix]    = t;
+            ProbeSimRxQNbr++;
+        }
+        pdata_08 += n;
+        len      -= n;
+    }
+    ProbeSimRxLineFree = t;
+}
+
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                            ProbeSim_Req()
+*
+* Description : Send a request & run until the host has decoded the response.
+*
+* Argument(s) : preq            Data segment of the request.
+*
+*               len             Its length.
+*
+*               crc_en          DEF_YES to frame the request with a CRC-16.
+*
+*               prsp            Where to store the response.  Stream snapshots are not responses.
+*
+* Return(s)   : DEF_OK if the response came within PROBE_SIM_REQ_TMO_MS, DEF_FAIL otherwise.
+*
+* Note(s)     : (1) Returns at the end of the tick in which the response was decoded ('Time_ns' tells
+*                   when it was).
+*********************************************************************************************************
+*/
+
+CPU_BOOLEAN  ProbeSim_Req (const void     *preq,
+                           CPU_INT16U      len,
+                           CPU_BOOLEAN     crc_en,
+                           PROBE_SIM_PKT  *prsp)
+{
+    CPU_INT32U  ms;
+
+
+    ProbeSimRspPtr = prsp;
+    ProbeSimRspRdy = DEF_NO;
+    ProbeSim_HostTx(preq, len, crc_en);
+    for (ms = 0; (ms < PROBE_SIM_REQ_TMO_MS) && (ProbeSimRspRdy == DEF_NO); ms++) {
+        ProbeSim_Run(1);
+    }
+    ProbeSimRspPtr = (PROBE_SIM_PKT *)0;
+    return ((ProbeSimRspRdy == DEF_YES) ? DEF_OK : DEF_FAIL);
+}
+
+
+/*
+*********************************************************************************************************
+*                                        ProbeSim_FmtSupport()
+*
+* Description : Ask the target whether it supports a format, as the host does with a
+*               PROBE_SIM_QUERY_FMT_SUPPORT query.
+*
+* Return(s)   : DEF_YES if the format is listed, DEF_NO otherwise.
+*********************************************************************************************************
+*/
+
+CPU_BOOLEAN  ProbeSim_FmtSupport (CPU_INT16U  fmt)
+{
+    static  const  CPU_INT08U  req[4] = {PROBE_SIM_FMT_QUERY & 0xFF, PROBE_SIM_FMT_QUERY >> 8,
+                                         PROBE_SIM_QUERY_FMT_SUPPORT & 0xFF, PROBE_SIM_QUERY_FMT_SUPPORT >> 8};
+    static  PROBE_SIM_PKT      rsp;
+    CPU_INT16U                 ix;
+
+
+    if ((ProbeSim_Req(req, sizeof(req), DEF_NO, &rsp) != DEF_OK) ||
+        (rsp.Data[2] != PROBE_SIM_STATUS_OK)) {
+        return (DEF_NO);
+    }
+    for (ix = 4; ix + 1 < rsp.Len; ix += 2) {
+        if (ProbeSim_GetINT16U(&rsp.Data[ix]) == fmt) {
+            return (DEF_YES);
+        }
+    }
+    return (DEF_NO);
+}
+
+
+/*
+*********************************************************************************************************
+*                                            ProbeSim_Run()
+*
+* Description : Let 'ms' ticks of simulated time pass (see 'probe_sim.h' Note #3).
+*
+* Note(s)     : (1) The events of each tick are raised from the calling task, then it delays for the
+*                   tick.  The RS-232 task runs above it, so it parses a packet as soon as it is
+*                   signalled & takes a snapshot as soon as the tick it is due in has been raised.
+*********************************************************************************************************
+*/
+
+void  ProbeSim_Run (CPU_INT32U  ms)
+{
+    unsigned  long long  end;
+    unsigned  long long  t_rx;
+    unsigned  long long  t_shift;
+    unsigned  long long  t_isr;
+
+
+    while (ms > 0) {
+        end = ((unsigned long long)OSTimeGet() + 1) * 1000000uLL;
+        while (DEF_TRUE) {
+            t_rx    = (ProbeSimRxQNbr    > 0     ) ? ProbeSimRxQTime[ProbeSimRxQRdIx] : PROBE_SIM_TIME_NONE;
+            t_shift = (ProbeSimShiftBusy == DEF_YES) ? ProbeSimShiftEnd                 : PROBE_SIM_TIME_NONE;
+            t_isr   =  ProbeSim_TxIntTime();
+            if ((t_rx >= end) && (t_shift >= end) && (t_isr >= end)) {
+                break;
+            }
+            if ((t_rx <= t_shift) && (t_rx <= t_isr)) {         /* Byte received.                                       */
+                ProbeSimNow    = t_rx;
+                ProbeSimRxData = ProbeSimRxQ[ProbeSimRxQRdIx];
+                ProbeSimRxQRdIx = (ProbeSimRxQRdIx + 1) % PROBE_SIM_RX_Q_SIZE;
+                ProbeSimRxQNbr--;
+                ProbeSimStat.RxByteCtr++;
+                if (ProbeSimRIE == DEF_YES) {
+                    OS_CPU_SimISR(ProbeSim_RxISR);
+                } else {
+                    ProbeSimStat.RxLostCtr++;
+                }
+            } else if (t_shift <= t_isr) {                      /* Stop bit shifted out.                                */
+                ProbeSimNow = t_shift;
+                ProbeSim_ShiftDone();
+            } else {                                            /* TX interrupt.                                        */
+                ProbeSimNow = t_isr;
+                OS_CPU_SimISR(ProbeSim_TxISR);
+            }
+        }
+        ProbeSimNow = end;
+        OSTimeDly(1);                                           /* See Note #1.                                         */
+        ms--;
+    }
+}
+
+
+/*
+*********************************************************************************************************
+*                                          ProbeSim_TimeNs()
+*                                          ProbeSim_ByteNs()
+*
+* Description : Return the simulated time, & the time a byte takes on the line, in ns.
+*********************************************************************************************************
+*/
+
+unsigned  long long  ProbeSim_TimeNs (void)
+{
+    return (ProbeSimNow);
+}
+
+
+CPU_INT32U  ProbeSim_ByteNs (void)
+{
+    return (ProbeSimByteNs);
+}
+
+
+/*
+*********************************************************************************************************
+*                                          ProbeSim_StatClr()
+*                                          ProbeSim_StatGet()
+*
+* Description : Clear / read the counters of the line & the host (see PROBE_SIM_STAT).
+*********************************************************************************************************
+*/
+
+void  ProbeSim_StatClr (void)
+{
+    memset(&ProbeSimStat, 0, sizeof(ProbeSimStat));
+}
+
+
+void  ProbeSim_StatGet (PROBE_SIM_STAT  *pstat)
+{
+    *pstat = ProbeSimStat;
+}
+
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                         ProbeSim_ReqItems()
+*
+* Description : Form the data segment of a request naming a list of items: the format, an optional
+*               16-bit word (the stream period, the delta options), then a length & 32-bit address per
+*               item.
+*
+* Return(s)   : Length of the data segment.
+*********************************************************************************************************
+*/
+
+CPU_INT16U  ProbeSim_ReqItems (CPU_INT08U            *preq,
+                               CPU_INT16U             fmt,
+                               CPU_BOOLEAN            word_en,
+                               CPU_INT16U             word,
+                               const PROBE_SIM_ITEM  *pitem,
+                               CPU_INT16U             nbr)
+{
+    CPU_INT08U  *p;
+    CPU_INT32U   addr;
+
+
+    p    = preq;
+    *p++ = fmt & 0xFF;
+    *p++ = fmt >> 8;
+    if (word_en == DEF_YES) {
+        *p++ = word & 0xFF;
+        *p++ = word >> 8;
+    }
+    while (nbr > 0) {
+        addr  = (CPU_INT32U)(unsigned long)pitem->DataPtr;
+        *p++  = pitem->Len;
+        *p++  = (CPU_INT08U)(addr);
+        *p++  = (CPU_INT08U)(addr >>  8);
+        *p++  = (CPU_INT08U)(addr >> 16);
+        *p++  = (CPU_INT08U)(addr >> 24);
+        pitem++;
+        nbr--;
+    }
+    return ((CPU_INT16U)(p - preq));
+}
+
+
+/*
+*********************************************************************************************************
+*                                        ProbeSim_GetINT16U()
+*                                        ProbeSim_GetINT32U()
+*
+* Description : Read a little-endian value from a packet.
+*********************************************************************************************************
+*/
+
+CPU_INT16U  ProbeSim_GetINT16U (const CPU_INT08U  *p)
+{
+    return ((CPU_INT16U)(p[0] | (p[1] << 8)));
+}
+
+
+CPU_INT32U  ProbeSim_GetINT32U (const CPU_INT08U  *p)
+{
+    return ((CPU_INT32U)p[0] | ((CPU_INT32U)p[1] << 8) | ((CPU_INT32U)p[2] << 16) | ((CPU_INT32U)p[3] << 24));
+}
+
+
+/*
+*********************************************************************************************************
+*                                          ProbeSim_CRC16()
+*
+* Description : CRC-16/CCITT (polynomial 0x1021, initial value 0xFFFF) of a buffer, bit by bit (see Note #2).
+*********************************************************************************************************
+*/
+
+CPU_INT16U  ProbeSim_CRC16 (const CPU_INT08U  *p,
+                            CPU_INT16U         len)
+{
+    CPU_INT16U  crc;
+    CPU_INT08U  bit;
+
+
+    crc = 0xFFFF;
+    while (len > 0) {
+        crc ^= (CPU_INT16U)(*p << 8);
+        for (bit = 0; bit < 8; bit++) {
+            crc = (crc & 0x8000) ? (CPU_INT16U)((crc << 1) ^ 0x1021) : (CPU_INT16U)(crc << 1);
+        }
+        p++;
+        len--;
+    }
+    return (crc);
+}
+
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                            PORT FUNCTIONS
+*
+* Description : Stand-ins for the port functions of 'probe_rs232c.c' (see 'probe_sim.h' Note #1).
+*
+* Note(s)     : (1) A byte written while the shift register is idle moves into it at once, so the data
+*                   register is empty again straight away; otherwise it waits in the data register.
+*********************************************************************************************************
+*/
+
+void  ProbeRS232_InitTarget (CPU_INT32U  baud_rate)
+{
+    ProbeSimByteNs = (CPU_INT32U)((10000000000uLL + baud_rate / 2) / baud_rate);
+}
+
+
+void  ProbeRS232_Tx1 (CPU_INT08U  c)
+{
+    ProbeSim_TxByte(c);
+}
+
+
+void  ProbeRS232_TxIntEn (void)
+{
+    if (ProbeSimTIE == DEF_NO) {
+        ProbeSimTIE     = DEF_YES;
+        ProbeSimTIETime = ProbeSimNow;
+    }
+}
+
+
+void  ProbeRS232_TxIntDis (void)
+{
+    ProbeSimTIE = DEF_NO;
+}
+
+
+void  ProbeRS232_RxIntEn (void)
+{
+    ProbeSimRIE = DEF_YES;
+}
+
+
+void  ProbeRS232_RxIntDis (void)
+{
+    ProbeSimRIE = DEF_NO;
+}
+
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                             LOCAL FUNCTIONS
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*                                           ProbeSim_FdWr()
+*                                           ProbeSim_FdRd()
+*
+* Description : Write / read 'len' bytes to / from one side of the pty, waiting for them if need be.
+*********************************************************************************************************
+*/
+
+static  void  ProbeSim_FdWr (int                 fd,
+                             const CPU_INT08U   *p,
+                             CPU_INT32U          len)
+{
+    ssize_t  n;
+
+
+    while (len > 0) {
+        n = write(fd, p, len);
+        if (n < 0) {
+            printf("probe_sim: pty write failed (%d)\n", errno);
+            exit(1);
+        }
+        p   += n;
+        len -= (CPU_INT32U)n;
+    }
+}
+
+
+static  void  ProbeSim_FdRd (int          fd,
+                             CPU_INT08U  *p,
+                             CPU_INT32U   len)
+{
+    struct  pollfd  pfd;
+    ssize_t         n;
+
+
+    while (len > 0) {
+        n = read(fd, p, len);
+        if (n > 0) {
+            p   += n;
+            len -= (CPU_INT32U)n;
+        } else if ((n < 0) && (errno == EAGAIN)) {
+            pfd.fd     = fd;
+            pfd.events = POLLIN;
+            if (poll(&pfd, 1, PROBE_SIM_PTY_TMO_MS) <= 0) {
+                printf("probe_sim: %lu bytes lost on the pty\n", (unsigned long)len);
+                exit(1);
+            }
+        } else {
+            printf("probe_sim: pty read failed (%d)\n", errno);
+            exit(1);
+        }
+    }
+}
+
+
+/*
+*********************************************************************************************************
+*                                        ProbeSim_TxIntTime()
+*
+* Description : Return when the TX interrupt is next raised, or PROBE_SIM_TIME_NONE if it is not pending
+*               (see 'probe_sim.h' Note #4).
+*********************************************************************************************************
+*/
+
+static  unsigned  long long  ProbeSim_TxIntTime (void)
+{
+    unsigned  long long  t;
+
+
+    if ((ProbeSimTIE == DEF_NO) || (ProbeSimDRFull == DEF_YES)) {
+        return (PROBE_SIM_TIME_NONE);
+    }
+    if (ProbeSimMode == PROBE_SIM_MODE_TC) {
+        if (ProbeSimShiftBusy == DEF_YES) {
+            return (PROBE_SIM_TIME_NONE);
+        }
+        t = ProbeSimIdleTime;
+    } else {
+        t = ProbeSimDREmptyTime;
+    }
+    if (t < ProbeSimTIETime) {
+        t = ProbeSimTIETime;
+    }
+    return (t + ProbeSimISRNs);
+}
+
+
+/*
+*********************************************************************************************************
+*                                          ProbeSim_TxByte()
+*                                         ProbeSim_ShiftDone()
+*
+* Description : Write a byte to the data register (see 'PORT FUNCTIONS  Note #1'); finish shifting a byte
+*               out, put it on the line & load the next one, if any.
+*********************************************************************************************************
+*/
+
+static  void  ProbeSim_TxByte (CPU_INT08U  c)
+{
+    if (ProbeSimShiftBusy == DEF_NO) {
+        if (ProbeSimHostState != PROBE_SIM_RX_SD0) {            /* Line idle within a frame.                            */
+            ProbeSimStat.TxIdle_ns += ProbeSimNow - ProbeSimIdleTime;
+        }
+        ProbeSimShift       = c;
+        ProbeSimShiftBusy   = DEF_YES;
+        ProbeSimShiftEnd    = ProbeSimNow + ProbeSimByteNs;
+        ProbeSimDREmptyTime = ProbeSimNow;
+    } else {
+        if (ProbeSimDRFull == DEF_YES) {
+            ProbeSimStat.TxOvrCtr++;
+        }
+        ProbeSimDR          = c;
+        ProbeSimDRFull      = DEF_YES;
+    }
+}
+
+
+static  void  ProbeSim_ShiftDone (void)
+{
+    CPU_INT08U  c;
+
+
+    c = ProbeSimShift;
+    ProbeSim_FdWr(ProbeSimFdSCI,  &c, 1);
+    ProbeSim_FdRd(ProbeSimFdHost, &c, 1);
+    ProbeSimStat.TxByteCtr++;
+
+    if (ProbeSimDRFull == DEF_YES) {
+        ProbeSimShift       = ProbeSimDR;
+        ProbeSimDRFull      = DEF_NO;
+        ProbeSimShiftEnd    = ProbeSimNow + ProbeSimByteNs;
+        ProbeSimDREmptyTime = ProbeSimNow;
+    } else {
+        ProbeSimShiftBusy   = DEF_NO;
+        ProbeSimIdleTime    = ProbeSimNow;
+    }
+    ProbeSim_HostRx(c);                                         /* Host may send a request from its handler.            */
+}
+
+
+/*
+*********************************************************************************************************
+*                                          ProbeSim_RxISR()
+*                                          ProbeSim_TxISR()
+*
+* Description : Handlers of the simulated SCI interrupts.
+*********************************************************************************************************
+*/
+
+static  void  ProbeSim_RxISR (void)
+{
+    ProbeRS232_RxHandler(ProbeSimRxData);
+}
+
+
+static  void  ProbeSim_TxISR (void)
+{
+    ProbeSimStat.TxISRCtr++;
+    ProbeRS232_TxHandler();
+}
+
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                          ProbeSim_HostRx()
+*
+* Description : Decode a byte the host received (see Note #2).
+*********************************************************************************************************
+*/
+
+static  void  ProbeSim_HostRx (CPU_INT08U  c)
+{
+    switch (ProbeSimHostState) {
+        case PROBE_SIM_RX_SD0:
+             ProbeSimHostState = (c == 'u') ? PROBE_SIM_RX_SD1 : PROBE_SIM_RX_SD0;
+             break;
+
+        case PROBE_SIM_RX_SD1:
+             ProbeSimHostState = (c == 'C') ? PROBE_SIM_RX_SD2 : PROBE_SIM_RX_SD0;
+             break;
+
+        case PROBE_SIM_RX_SD2:
+             ProbeSimHostState = (c == 'P') ? PROBE_SIM_RX_SD3 : PROBE_SIM_RX_SD0;
+             break;
+
+        case PROBE_SIM_RX_SD3:
+             ProbeSimHostState = (c == 'r') ? PROBE_SIM_RX_LEN1 : PROBE_SIM_RX_SD0;
+             break;
+
+        case PROBE_SIM_RX_LEN1:
+             ProbeSimHostHdr[0] = c;
+             ProbeSimHostState  = PROBE_SIM_RX_LEN2;
+             break;
+
+        case PROBE_SIM_RX_LEN2:
+             ProbeSimHostHdr[1] = c;
+             ProbeSimHostLen    = ProbeSim_GetINT16U(&ProbeSimHostHdr[0]);
+             ProbeSimHostState  = PROBE_SIM_RX_PAD1;
+             break;
+
+        case PROBE_SIM_RX_PAD1:
+             ProbeSimHostHdr[2] = c;
+             ProbeSimHostState  = PROBE_SIM_RX_PAD2;
+             break;
+
+        case PROBE_SIM_RX_PAD2:
+             ProbeSimHostHdr[3]     = c;
+             ProbeSimHostPkt.CRCEn  = ((ProbeSimHostHdr[2] & 0x01) != 0) ? DEF_YES : DEF_NO;
+             ProbeSimHostIx         = 0;
+             if (ProbeSimHostLen > PROBE_SIM_PKT_SIZE) {
+                 ProbeSim_HostPkt(DEF_NO);
+             } else {
+                 ProbeSimHostState  = (ProbeSimHostLen > 0) ? PROBE_SIM_RX_DATA : PROBE_SIM_RX_CHK1;
+             }
+             break;
+
+        case PROBE_SIM_RX_DATA:
+             ProbeSimHostPkt.Data[ProbeSimHostIx++] = c;
+             if (ProbeSimHostIx >= ProbeSimHostLen) {
+                 ProbeSimHostState = PROBE_SIM_RX_CHK1;
+             }
+             break;
+
+        case PROBE_SIM_RX_CHK1:
+             ProbeSimHostCRC   = (CPU_INT16U)(c << 8);
+             ProbeSimHostState = (ProbeSimHostPkt.CRCEn == DEF_YES) ? PROBE_SIM_RX_CHK2 : PROBE_SIM_RX_ED;
+             break;
+
+        case PROBE_SIM_RX_CHK2:
+             ProbeSimHostCRC  |= c;
+             ProbeSimHostState = PROBE_SIM_RX_ED;
+             break;
+
+        case PROBE_SIM_RX_ED:
+        default:
+             ProbeSimHostPkt.Len = ProbeSimHostLen;
+             ProbeSim_HostPkt((c == '/') ? DEF_YES : DEF_NO);
+             break;
+    }
+}
+
+
+/*
+*********************************************************************************************************
+*                                          ProbeSim_HostPkt()
+*
+* Description : End the frame being decoded & hand the packet on if it is good.
+*
+* Note(s)     : (1) The CRC-16 covers the length, the padding & the data.
+*********************************************************************************************************
+*/
+
+static  void  ProbeSim_HostPkt (CPU_BOOLEAN  ok)
+{
+    static  CPU_INT08U  crc_buf[PROBE_SIM_PKT_SIZE + 4];
+
+
+    ProbeSimHostState = PROBE_SIM_RX_SD0;
+    if ((ok == DEF_YES) && (ProbeSimHostPkt.CRCEn == DEF_YES)) {  /* See Note #1.                                         */
+        memcpy(&crc_buf[0], ProbeSimHostHdr, 4);
+        memcpy(&crc_buf[4], ProbeSimHostPkt.Data, ProbeSimHostPkt.Len);
+        ok = (ProbeSim_CRC16(crc_buf, ProbeSimHostPkt.Len + 4) == ProbeSimHostCRC) ? DEF_YES : DEF_NO;
+    }
+    if (ok == DEF_NO) {
+        ProbeSimStat.PktErrCtr++;
+        return;
+    }
+
+    ProbeSimStat.PktCtr++;
+    ProbeSimHostPkt.Time_ns = ProbeSimNow;
+    if ((ProbeSimRspPtr != (PROBE_SIM_PKT *)0) &&
+        (ProbeSimRspRdy == DEF_NO)              &&
+        (ProbeSimHostPkt.Len >= 2)              &&
+        (ProbeSim_GetINT16U(&ProbeSimHostPkt.Data[0]) != PROBE_SIM_FMT_STREAM_DATA)) {
+        *ProbeSimRspPtr = ProbeSimHostPkt;
+        ProbeSimRspRdy  = DEF_YES;
+    }
+    if (ProbeSimHndlr != (PROBE_SIM_HNDLR_FNCT)0) {
+        ProbeSimHndlr(&ProbeSimHostPkt);
+    }
+}
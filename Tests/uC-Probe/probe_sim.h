@@ -0,0 +1,145 @@
+/*
+*********************************************************************************************************
+*                                             HOST TESTS
+*
+*                                  Simulated SCI for uC/Probe RS-232
+*
+* Filename      : probe_sim.h
+* Note(s)       : (1) 'probe_sim.c' provides the port functions of 'probe_rs232c.c' (ProbeRS232_InitTarget(),
+*                     ProbeRS232_Tx1(), ProbeRS232_TxIntEn() ...) on a model of the MC9S12 SCI, & plays the
+*                     uC/Probe host on the other end of the line.  probe_com.c, probe_rs232.c &
+*                     probe_rs232_os.c are linked unchanged.
+*
+*                 (2) The line is a pseudo terminal: the SCI owns the master side, the host the slave side,
+*                     set raw.  A byte is written to the line when its stop bit has been shifted out & the
+*                     host reads it then; each request the host writes is read back by the SCI & received
+*                     one byte time per byte.
+*
+*                 (3) Time is simulated, in ns, at the baud rate given to ProbeRS232_InitTarget().  The
+*                     test task advances it with ProbeSim_Run(), one OS tick at a time, & the SCI events
+*                     (byte received, byte shifted out, TX interrupt) of each tick are raised in time order
+*                     with OS_CPU_SimISR().  Parsing takes no simulated time.
+*
+*                 (4) The TX interrupt is raised PROBE_SIM_MODE_TDRE, when the data register is empty, as
+*                     the MC9S12 port does, or PROBE_SIM_MODE_TC, when the shift register is empty too;
+*                     either way 'isr_ns' after the condition, for the interrupt latency.
+*********************************************************************************************************
+*/
+
+#ifndef  PROBE_SIM_H
+#define  PROBE_SIM_H
+
+
+/*
+*********************************************************************************************************
+*                                               DEFINES
+*********************************************************************************************************
+*/
+
+#define  PROBE_SIM_MODE_TDRE               0                    /* TX int when the data register is empty (Note #4).    */
+#define  PROBE_SIM_MODE_TC                 1                    /* TX int when the transmission is complete.            */
+
+#define  PROBE_SIM_PKT_SIZE             4608                    /* Largest data segment the host decodes.               */
+
+                                                                /* Formats & statuses, as in 'probe_com.c'.             */
+#define  PROBE_SIM_FMT_QUERY          0x0001
+#define  PROBE_SIM_FMT_SIMPLE_RD      0x0002
+#define  PROBE_SIM_FMT_MULTIPLE_RD    0x0007
+#define  PROBE_SIM_FMT_STREAM_CFG     0x000C
+#define  PROBE_SIM_FMT_STREAM_DATA    0x800D
+#define  PROBE_SIM_FMT_DELTA          0x000E
+#define  PROBE_SIM_FMT_CRC16          0x000F
+#define  PROBE_SIM_FMT_SYM_LOOKUP     0x0010
+#define  PROBE_SIM_FMT_TX             0x8000                    /* Set in the format of each response.                  */
+
+#define  PROBE_SIM_QUERY_MAX_TX_SIZE  0x0102
+#define  PROBE_SIM_QUERY_FMT_SUPPORT  0x1001
+
+#define  PROBE_SIM_STATUS_OK            0x01
+#define  PROBE_SIM_STATUS_FORBIDDEN     0xFA
+#define  PROBE_SIM_STATUS_TOO_LARGE     0xFD
+#define  PROBE_SIM_STATUS_WRONG_SIZE    0xFE
+
+
+/*
+*********************************************************************************************************
+*                                              DATA TYPES
+*********************************************************************************************************
+*/
+
+typedef  struct  probe_sim_pkt {                                /* Packet decoded by the host.                          */
+    CPU_INT08U          Data[PROBE_SIM_PKT_SIZE];               /* Data segment.                                        */
+    CPU_INT16U          Len;
+    CPU_BOOLEAN         CRCEn;                                  /* Framed with a CRC-16.                                */
+    unsigned  long long Time_ns;                                /* End delimiter received.                              */
+} PROBE_SIM_PKT;
+
+typedef  struct  probe_sim_item {                               /* Item of a read request.                              */
+    void               *DataPtr;
+    CPU_INT08U          Len;
+} PROBE_SIM_ITEM;
+
+typedef  struct  probe_sim_stat {
+    CPU_INT32U          TxByteCtr;                              /* Bytes the SCI shifted out.                           */
+    CPU_INT32U          TxISRCtr;                               /* TX interrupts taken.                                 */
+    CPU_INT32U          TxOvrCtr;                               /* Bytes written over a full data register.             */
+    CPU_INT32U          RxByteCtr;                              /* Bytes the host sent.                                 */
+    CPU_INT32U          RxLostCtr;                              /* ... received with the RX interrupt disabled.         */
+    CPU_INT32U          PktCtr;                                 /* Packets the host decoded.                            */
+    CPU_INT32U          PktErrCtr;                              /* Frames the host rejected (end delimiter, CRC).       */
+    unsigned  long long TxIdle_ns;                              /* Line idle between bytes of a packet.                 */
+} PROBE_SIM_STAT;
+
+typedef  void  (*PROBE_SIM_HNDLR_FNCT)(PROBE_SIM_PKT  *ppkt);
+
+
+/*
+*********************************************************************************************************
+*                                          FUNCTION PROTOTYPES
+*********************************************************************************************************
+*/
+
+void                ProbeSim_Init     (void);
+
+void                ProbeSim_Cfg      (CPU_INT08U             mode,
+                                       CPU_INT32U             isr_ns,
+                                       CPU_INT32U             host_lat_us);
+
+void                ProbeSim_HndlrSet (PROBE_SIM_HNDLR_FNCT   hndlr);
+
+void                ProbeSim_HostTx   (const void            *pdata,
+                                       CPU_INT16U             len,
+                                       CPU_BOOLEAN            crc_en);
+
+void                ProbeSim_HostTxRaw(const void            *pdata,
+                                       CPU_INT16U             len);
+
+CPU_BOOLEAN         ProbeSim_Req      (const void            *preq,
+                                       CPU_INT16U             len,
+                                       CPU_BOOLEAN            crc_en,
+                                       PROBE_SIM_PKT         *prsp);
+
+CPU_BOOLEAN         ProbeSim_FmtSupport(CPU_INT16U            fmt);
+
+void                ProbeSim_Run      (CPU_INT32U             ms);
+
+unsigned  long long ProbeSim_TimeNs   (void);
+CPU_INT32U          ProbeSim_ByteNs   (void);
+
+void                ProbeSim_StatClr  (void);
+void                ProbeSim_StatGet  (PROBE_SIM_STAT        *pstat);
+
+CPU_INT16U          ProbeSim_ReqItems (CPU_INT08U            *preq,
+                                       CPU_INT16U             fmt,
+                                       CPU_BOOLEAN            word_en,
+                                       CPU_INT16U             word,
+                                       const PROBE_SIM_ITEM  *pitem,
+                                       CPU_INT16U             nbr);
+
+CPU_INT16U          ProbeSim_GetINT16U(const CPU_INT08U      *p);
+CPU_INT32U          ProbeSim_GetINT32U(const CPU_INT08U      *p);
+
+CPU_INT16U          ProbeSim_CRC16    (const CPU_INT08U      *p,
+                                       CPU_INT16U             len);
+
+#endif
@@ -0,0 +1,434 @@
+/*
+*********************************************************************************************************
+*                                             HOST TESTS
+*
+*                                  uC/Probe RS-232 CRC-16 Framing
+*
+* Filename      : test_probe_crc.c
+* Note(s)       : (1) probe_com.c & probe_rs232.c at 115200 baud on the simulated SCI of 'probe_sim.c', built
+*                     with PROBE_COM_SUPPORT_CRC16 DEF_TRUE (test_probe_crc_on) & DEF_FALSE
+*                     (test_probe_crc_off).
+*
+*                 (2) With CRC-16, QUERY_FMT_SUPPORT MUST list the marker 0x000F.  Each response MUST be
+*                     framed like its request, also when requests with either framing are in flight
+*                     together, & snapshots like the last request.  A corrupted CRC-framed request MUST be
+*                     dropped, counted in ProbeRS232_RxCRCErrCtr & not answered.  Without CRC-16, the
+*                     marker is absent & CRC-framed requests are not answered.
+*
+*                 (3) Errors missed, out of ERR_NBR random 66-byte frames fed to ProbeRS232_RxHandler(), by
+*                     the CRC-16 of the frame & by the 8-bit sum of the checksum framing: 2 random bit
+*                     flips, 2 different bytes swapped, +1 & -1 on two bytes.
+*
+*                 (4) ProbeRS232_RxHandler() time per byte, checksum & CRC-16 framing, best of BENCH_RUN_NBR
+*                     runs.  The frames end with a wrong end delimiter, so each is received in full but not
+*                     parsed.
+*********************************************************************************************************
+*/
+
+#include  <includes.h>
+#include  <probe_com.h>
+#include  <probe_rs232.h>
+#include  "probe_sim.h"
+
+
+/*
+*********************************************************************************************************
+*                                            LOCAL DEFINES
+*********************************************************************************************************
+*/
+
+#define  DATA_LEN                         56                    /* 66-byte frames with CRC-16.                          */
+#define  FRAME_MAX        (8 + PROBE_COM_RX_MAX_SIZE + 3)
+
+#define  ERR_NBR                       20000
+#define  BENCH_FRAME_NBR                2000
+#define  BENCH_RUN_NBR                     9
+
+#define  ERR_BIT_FLIP                      0
+#define  ERR_SWAP                          1
+#define  ERR_ADD_SUB                       2
+
+
+/*
+*********************************************************************************************************
+*                                        LOCAL GLOBAL VARIABLES
+*********************************************************************************************************
+*/
+
+static  OS_STK          TestTaskStk[TEST_TASK_STK_SIZE];
+
+static  CPU_INT32U      AppVar[3] = {0x11223344, 0x55667788, 0x99AABBCC};
+
+static  CPU_INT32U      Seed = 1;
+
+static  CPU_INT32U      RspCtr;                                 /* Responses decoded, by framing.                       */
+static  CPU_INT32U      RspCRCCtr;
+static  CPU_INT32U      SnapCtr;                                /* Snapshots decoded, by framing.                       */
+static  CPU_INT32U      SnapCRCCtr;
+
+static  PROBE_SIM_PKT   Rsp;
+
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                             Test_Rand()
+*
+* Description : Return a pseudo-random number, the same on every run.
+*********************************************************************************************************
+*/
+
+static  CPU_INT32U  Test_Rand (void)
+{
+    Seed = Seed * 1103515245uL + 12345;
+    return (Seed >> 16);
+}
+
+
+/*
+*********************************************************************************************************
+*                                             Test_Rx()
+*
+* Description : Count the packets the host decodes by framing.
+*********************************************************************************************************
+*/
+
+static  void  Test_Rx (PROBE_SIM_PKT  *ppkt)
+{
+    if (ProbeSim_GetINT16U(&ppkt->Data[0]) == PROBE_SIM_FMT_STREAM_DATA) {
+        SnapCtr++;
+        if (ppkt->CRCEn == DEF_YES) {
+            SnapCRCCtr++;
+        }
+    } else {
+        RspCtr++;
+        if (ppkt->CRCEn == DEF_YES) {
+            RspCRCCtr++;
+        }
+    }
+}
+
+
+/*
+*********************************************************************************************************
+*                                            Test_Frame()
+*
+* Description : Frame a data segment as the host does.
+*
+* Argument(s) : pframe          Buffer for the frame.
+*
+*               pdata           Data segment.
+*
+*               len             Length of the data segment.
+*
+*               crc_en          DEF_YES to frame with a CRC-16, DEF_NO with a checksum.
+*
+*               ed              End delimiter.
+*
+* Return(s)   : Length of the frame.
+*********************************************************************************************************
+*/
+
+static  CPU_INT16U  Test_Frame (CPU_INT08U        *pframe,
+                                const CPU_INT08U  *pdata,
+                                CPU_INT16U         len,
+                                CPU_BOOLEAN        crc_en,
+                                CPU_INT08U         ed)
+{
+    CPU_INT16U  crc;
+    CPU_INT08U  sum;
+    CPU_INT16U  ix;
+    CPU_INT16U  i;
+
+
+    pframe[0] = 'u';
+    pframe[1] = 'C';
+    pframe[2] = 'P';
+    pframe[3] = 'r';
+    pframe[4] = (CPU_INT08U)(len);
+    pframe[5] = (CPU_INT08U)(len >> 8);
+    pframe[6] = (crc_en == DEF_YES) ? 0x01 : 0x00;
+    pframe[7] = 0;
+    memcpy(&pframe[8], pdata, len);
+    ix        = 8 + len;
+    if (crc_en == DEF_YES) {
+        crc            = ProbeSim_CRC16(&pframe[4], len + 4);
+        pframe[ix++]   = (CPU_INT08U)(crc >> 8);
+        pframe[ix++]   = (CPU_INT08U)(crc);
+    } else {
+        sum = 0;
+        for (i = 0; i < len; i++) {
+            sum += pdata[i];
+        }
+        pframe[ix++]   = sum;
+    }
+    pframe[ix++] = ed;
+    return (ix);
+}
+
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                             Test_Err()
+*
+* Description : Corrupt ERR_NBR random frames & feed them to ProbeRS232_RxHandler() (see Note #3).
+*
+* Argument(s) : err             ERR_BIT_FLIP, ERR_SWAP or ERR_ADD_SUB.
+*
+*               psum_missed     Returns the errors the 8-bit sum of the data misses.
+*
+* Return(s)   : Errors the CRC-16 misses.
+*********************************************************************************************************
+*/
+
+#if (PROBE_COM_SUPPORT_CRC16 == DEF_TRUE)
+static  CPU_INT32U  Test_Err (CPU_INT08U   err,
+                              CPU_INT32U  *psum_missed)
+{
+    CPU_INT08U  data[DATA_LEN];
+    CPU_INT08U  frame[FRAME_MAX];
+    CPU_INT16U  len;
+    CPU_INT16U  a;
+    CPU_INT16U  b;
+    CPU_INT08U  sum;
+    CPU_INT08U  c;
+    CPU_INT32U  err_ctr;
+    CPU_INT32U  missed;
+    CPU_INT32U  n;
+    CPU_INT16U  i;
+
+
+    missed       = 0;
+    *psum_missed = 0;
+    for (n = 0; n < ERR_NBR; n++) {
+        for (i = 0; i < DATA_LEN; i++) {
+            data[i] = (CPU_INT08U)Test_Rand();
+        }
+        len = Test_Frame(frame, data, DATA_LEN, DEF_YES, 'x');
+        a   = (CPU_INT16U)(Test_Rand() % DATA_LEN);
+        do {
+            b = (CPU_INT16U)(Test_Rand() % DATA_LEN);
+        } while ((b == a) || ((err == ERR_SWAP) && (data[b] == data[a])));
+
+        switch (err) {
+            case ERR_BIT_FLIP:
+                 frame[8 + a] ^= (CPU_INT08U)(1 << (Test_Rand() % 8));
+                 frame[8 + b] ^= (CPU_INT08U)(1 << (Test_Rand() % 8));
+                 break;
+
+            case ERR_SWAP:
+                 c             = frame[8 + a];
+                 frame[8 + a]  = frame[8 + b];
+                 frame[8 + b]  = c;
+                 break;
+
+            case ERR_ADD_SUB:
+            default:
+                 frame[8 + a] += 1;
+                 frame[8 + b] -= 1;
+                 break;
+        }
+
+        sum = 0;
+        for (i = 0; i < DATA_LEN; i++) {
+            sum += (CPU_INT08U)(frame[8 + i] - data[i]);
+        }
+        if (sum == 0) {
+            (*psum_missed)++;
+        }
+
+        err_ctr = ProbeRS232_RxCRCErrCtr;
+        for (i = 0; i < len; i++) {
+            ProbeRS232_RxHandler(frame[i]);
+        }
+        if (ProbeRS232_RxCRCErrCtr == err_ctr) {
+            missed++;
+        }
+    }
+    return (missed);
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                            Test_Bench()
+*
+* Description : Return the ProbeRS232_RxHandler() time per byte, in 0.01 ns (see Note #4).
+*********************************************************************************************************
+*/
+
+static  CPU_INT32U  Test_Bench (CPU_BOOLEAN  crc_en)
+{
+    CPU_INT08U           data[DATA_LEN];
+    CPU_INT08U           frame[FRAME_MAX];
+    CPU_INT16U           len;
+    unsigned  long long  t;
+    unsigned  long long  best;
+    CPU_INT32U           run;
+    CPU_INT32U           n;
+    CPU_INT16U           i;
+
+
+    for (i = 0; i < DATA_LEN; i++) {
+        data[i] = (CPU_INT08U)Test_Rand();
+    }
+    len  = Test_Frame(frame, data, DATA_LEN, crc_en, 'x');
+    best = ~0uLL;
+    for (run = 0; run < BENCH_RUN_NBR; run++) {
+        t = Test_TimeNs();
+        for (n = 0; n < BENCH_FRAME_NBR; n++) {
+            for (i = 0; i < len; i++) {
+                ProbeRS232_RxHandler(frame[i]);
+            }
+        }
+        t = Test_TimeNs() - t;
+        if (t < best) {
+            best = t;
+        }
+    }
+    return ((CPU_INT32U)(best * 100 / ((unsigned long long)BENCH_FRAME_NBR * len)));
+}
+
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                             TestTask()
+*********************************************************************************************************
+*/
+
+static  void  TestTask (void *p_arg)
+{
+    PROBE_SIM_ITEM  item[3];
+    CPU_INT08U      req[PROBE_COM_RX_MAX_SIZE];
+    CPU_INT16U      req_len;
+    CPU_INT32U      ns_chk;
+#if (PROBE_COM_SUPPORT_CRC16 == DEF_TRUE)
+    PROBE_SIM_STAT  stat;
+    CPU_INT08U      frame[FRAME_MAX];
+    CPU_INT16U      len;
+    CPU_INT32U      err_ctr;
+    CPU_INT32U      pkt_ctr;
+    CPU_INT32U      ns_crc;
+    CPU_INT32U      crc_missed;
+    CPU_INT32U      sum_missed;
+    CPU_INT08U      err;
+    CPU_INT16U      i;
+#endif
+    CPU_INT08U      j;
+
+
+    (void)p_arg;
+    ProbeSim_Init();
+    ProbeCom_Init();
+    ProbeRS232_Init(115200);
+    ProbeRS232_RxIntEn();
+    ProbeSim_HndlrSet(Test_Rx);
+
+    for (j = 0; j < 3; j++) {
+        item[j].DataPtr = (void *)&AppVar[j];
+        item[j].Len     = 4;
+    }
+    req_len = ProbeSim_ReqItems(req, PROBE_SIM_FMT_MULTIPLE_RD, DEF_NO, 0, item, 3);
+
+#if (PROBE_COM_SUPPORT_CRC16 == DEF_TRUE)                       /* See Note #2.                                         */
+    TEST_CHK(ProbeSim_FmtSupport(PROBE_SIM_FMT_CRC16) == DEF_YES);
+
+    TEST_CHK(ProbeSim_Req(req, req_len, DEF_YES, &Rsp) == DEF_OK);
+    TEST_CHK((Rsp.CRCEn == DEF_YES) && (Rsp.Data[2] == PROBE_SIM_STATUS_OK) &&
+             (ProbeSim_GetINT32U(&Rsp.Data[4]) == AppVar[0]));
+    TEST_CHK(ProbeSim_Req(req, req_len, DEF_NO,  &Rsp) == DEF_OK);
+    TEST_CHK((Rsp.CRCEn == DEF_NO)  && (Rsp.Data[2] == PROBE_SIM_STATUS_OK));
+
+    RspCtr    = 0;                                              /* Both framings in flight.                             */
+    RspCRCCtr = 0;
+    for (j = 0; j < 8; j++) {
+        ProbeSim_HostTx(req, req_len, DEF_YES);
+        ProbeSim_HostTx(req, req_len, DEF_NO);
+        ProbeSim_Run(10);
+    }
+    TEST_CHK((RspCtr == 16) && (RspCRCCtr == 8));
+
+    len = ProbeSim_ReqItems(frame, PROBE_SIM_FMT_STREAM_CFG, DEF_YES, 10, item, 3);
+    TEST_CHK(ProbeSim_Req(frame, len, DEF_YES, &Rsp) == DEF_OK);
+    ProbeSim_Run(10);
+    SnapCtr    = 0;
+    SnapCRCCtr = 0;
+    ProbeSim_Run(100);
+    TEST_CHK((SnapCtr >= 9) && (SnapCRCCtr == SnapCtr));        /* Snapshots framed like the cfg ...                    */
+    TEST_CHK(ProbeSim_Req(req, req_len, DEF_NO, &Rsp) == DEF_OK);
+    ProbeSim_Run(10);
+    SnapCtr    = 0;
+    SnapCRCCtr = 0;
+    ProbeSim_Run(100);
+    TEST_CHK((SnapCtr >= 9) && (SnapCRCCtr == 0));              /* ... then like the last request.                      */
+    len = ProbeSim_ReqItems(frame, PROBE_SIM_FMT_STREAM_CFG, DEF_YES, 0, item, 0);
+    TEST_CHK(ProbeSim_Req(frame, len, DEF_NO, &Rsp) == DEF_OK);
+
+    for (err = ERR_BIT_FLIP; err <= ERR_ADD_SUB; err++) {       /* A corrupted request is dropped.                      */
+        len = Test_Frame(frame, req, req_len, DEF_YES, '/');
+        i   = (CPU_INT16U)(8 + Test_Rand() % req_len);
+        switch (err) {
+            case ERR_BIT_FLIP: frame[i] ^= 0x10;                                      break;
+            case ERR_SWAP:     frame[8] = frame[9]; frame[9] = (CPU_INT08U)req[0];    break;
+            default:           frame[i] += 1;  frame[8 + (i - 7) % req_len] -= 1;    break;
+        }
+        err_ctr = ProbeRS232_RxCRCErrCtr;
+        ProbeSim_StatGet(&stat);
+        pkt_ctr = stat.PktCtr;
+        ProbeSim_HostTxRaw(frame, len);
+        ProbeSim_Run(20);
+        ProbeSim_StatGet(&stat);
+        TEST_CHK(ProbeRS232_RxCRCErrCtr == err_ctr + 1);
+        TEST_CHK(stat.PktCtr            == pkt_ctr);
+        TEST_CHK(ProbeSim_Req(req, req_len, DEF_YES, &Rsp) == DEF_OK);
+    }
+
+    for (err = ERR_BIT_FLIP; err <= ERR_ADD_SUB; err++) {       /* See Note #3.                                         */
+        crc_missed = Test_Err(err, &sum_missed);
+        printf("%-22s missed: 8-bit sum %5.1f%%, CRC-16 %5.1f%% of %u frames\n",
+               (err == ERR_BIT_FLIP) ? "2 random bit flips" : (err == ERR_SWAP) ? "2 bytes swapped" : "+1/-1 on two bytes",
+               100.0 * sum_missed / ERR_NBR, 100.0 * crc_missed / ERR_NBR, (unsigned)ERR_NBR);
+        TEST_CHK(crc_missed == 0);
+    }
+
+    ns_chk = Test_Bench(DEF_NO);                                /* See Note #4.                                         */
+    ns_crc = Test_Bench(DEF_YES);
+    printf("ProbeRS232_RxHandler(): checksum framing %lu.%02lu ns/byte, CRC-16 framing %lu.%02lu ns/byte\n",
+           (unsigned long)(ns_chk / 100), (unsigned long)(ns_chk % 100),
+           (unsigned long)(ns_crc / 100), (unsigned long)(ns_crc % 100));
+    printf("                        at 115200 baud a byte lasts %lu ns\n", (unsigned long)ProbeSim_ByteNs());
+
+    Test_Done("test_probe_crc (PROBE_COM_SUPPORT_CRC16 DEF_TRUE)");
+#else
+    TEST_CHK(ProbeSim_FmtSupport(PROBE_SIM_FMT_CRC16) == DEF_NO);
+    TEST_CHK(ProbeSim_Req(req, req_len, DEF_NO,  &Rsp) == DEF_OK);
+    TEST_CHK(ProbeSim_Req(req, req_len, DEF_YES, &Rsp) == DEF_FAIL);
+    TEST_CHK(ProbeSim_Req(req, req_len, DEF_NO,  &Rsp) == DEF_OK);
+
+    ns_chk = Test_Bench(DEF_NO);
+    printf("ProbeRS232_RxHandler(): checksum framing %lu.%02lu ns/byte\n",
+           (unsigned long)(ns_chk / 100), (unsigned long)(ns_chk % 100));
+
+    Test_Done("test_probe_crc (PROBE_COM_SUPPORT_CRC16 DEF_FALSE)");
+#endif
+}
+
+
+int  main (void)
+{
+    OSInit();
+    (void)OSTaskCreateExt(TestTask,
+                          (void *)0,
+                          &TestTaskStk[TEST_TASK_STK_SIZE - 1],
+                          TEST_TASK_PRIO,
+                          TEST_TASK_PRIO,
+                          &TestTaskStk[0],
+                          TEST_TASK_STK_SIZE,
+                          (void *)0,
+                          OS_TASK_OPT_NONE);
+    OSStart();
+    return (0);
+}
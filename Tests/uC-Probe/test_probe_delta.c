@@ -0,0 +1,383 @@
+/*
+*********************************************************************************************************
+*                                             HOST TESTS
+*
+*                                  uC/Probe Delta Reads (MULTIPLE_RD_DELTA)
+*
+* Filename      : test_probe_delta.c
+* Note(s)       : (1) probe_com.c & probe_rs232.c at 115200 baud on the simulated SCI of 'probe_sim.c'.  The
+*                     host keeps its copy of each item & applies each delta response to it.  After every
+*                     response the copy MUST match target memory, & the bitmap MUST name exactly the items
+*                     whose data differ from the copy.
+*
+*                 (2) A response MUST be a keyframe for the first request, every PROBE_COM_DELTA_KEY_PERIOD
+*                     responses, when the item list changes & when the host asks for one after losing a
+*                     response.
+*
+*                 (3) Bytes on the line per update, of the response & both ways, polling the same watch list
+*                     with MULTIPLE_RD & with MULTIPLE_RD_DELTA (simulated line, framing included):
+*
+*                     (a) A dashboard of 10 items, 26 bytes: a counter & a 16-bit value change every poll,
+*                         the others one poll in 8;
+*                     (b) A configuration page of 8 items, 32 bytes, that do not change;
+*                     (c) 4 items, 16 bytes, that all change every poll: the worst case, the flags & the
+*                         bitmap cost 2 bytes more each way.
+*
+*                 (4) A list whose keyframe would not fit in the TX buffer is rejected, however few items
+*                     changed.
+*********************************************************************************************************
+*/
+
+#include  <includes.h>
+#include  <probe_com.h>
+#include  <probe_rs232.h>
+#include  "probe_sim.h"
+
+
+/*
+*********************************************************************************************************
+*                                            LOCAL DEFINES
+*********************************************************************************************************
+*/
+
+#define  ITEM_MAX                         16
+#define  POLL_NBR                        256
+
+#define  DELTA_FLAG_KEY                 0x01                    /* As in 'probe_com.c'.                                 */
+#define  DELTA_OPT_KEY                0x0001
+
+
+/*
+*********************************************************************************************************
+*                                        LOCAL GLOBAL VARIABLES
+*********************************************************************************************************
+*/
+
+static  OS_STK          TestTaskStk[TEST_TASK_STK_SIZE];
+
+static  CPU_INT32U      Dash32[4];                              /* Dashboard (see Note #3a).                            */
+static  CPU_INT16U      Dash16[4];
+static  CPU_INT08U      Dash08[2];
+static  CPU_INT32U      Cfg32[8] = {1, 2, 3, 4, 5, 6, 7, 8};    /* Configuration page (see Note #3b).                   */
+static  CPU_INT32U      Hot32[4];                               /* All changing (see Note #3c).                         */
+static  CPU_INT08U      Big[60];
+
+static  CPU_INT08U      HostCopy[ITEM_MAX][8];                  /* Host copy of each item (see Note #1).                */
+static  CPU_INT32U      Seed = 1;
+
+static  PROBE_SIM_PKT   Rsp;
+
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                             Test_Rand()
+*
+* Description : Return a pseudo-random number, the same on every run.
+*********************************************************************************************************
+*/
+
+static  CPU_INT32U  Test_Rand (void)
+{
+    Seed = Seed * 1103515245uL + 12345;
+    return (Seed >> 16);
+}
+
+
+/*
+*********************************************************************************************************
+*                                            Test_Mutate()
+*
+* Description : Change the watched variables between two polls (see Note #3).
+*********************************************************************************************************
+*/
+
+static  void  Test_Mutate (void)
+{
+    CPU_INT08U  i;
+
+
+    Dash32[0]++;
+    Dash16[0] = (CPU_INT16U)Test_Rand();
+    for (i = 1; i < 4; i++) {
+        if ((Test_Rand() & 7) == 0) {
+            Dash32[i] = Test_Rand();
+        }
+        if ((Test_Rand() & 7) == 0) {
+            Dash16[i] = (CPU_INT16U)Test_Rand();
+        }
+    }
+    for (i = 0; i < 2; i++) {
+        if ((Test_Rand() & 7) == 0) {
+            Dash08[i] = (CPU_INT08U)Test_Rand();
+        }
+    }
+    for (i = 0; i < 4; i++) {
+        Hot32[i] += 1 + (Test_Rand() & 0xFF);
+    }
+}
+
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                          Test_DeltaPoll()
+*
+* Description : Send a delta request for a watch list & apply the response to the host copy.
+*
+* Argument(s) : pitem           Watch list.
+*
+*               nbr             Number of items.
+*
+*               opt             Options of the request.
+*
+*               pkey            Returns DEF_YES if the response is a keyframe.
+*
+* Return(s)   : DEF_OK if the copy matches memory & the bitmap names exactly the changed items (see
+*               Note #1), DEF_FAIL otherwise.
+*********************************************************************************************************
+*/
+
+static  CPU_BOOLEAN  Test_DeltaPoll (const PROBE_SIM_ITEM  *pitem,
+                                     CPU_INT16U             nbr,
+                                     CPU_INT16U             opt,
+                                     CPU_BOOLEAN           *pkey)
+{
+    CPU_INT08U   req[PROBE_COM_RX_MAX_SIZE];
+    CPU_INT08U  *pbitmap;
+    CPU_INT08U  *pdata;
+    CPU_INT16U   len;
+    CPU_INT16U   i;
+    CPU_BOOLEAN  incl;
+    CPU_BOOLEAN  diff;
+    CPU_BOOLEAN  ok;
+
+
+    len   = ProbeSim_ReqItems(req, PROBE_SIM_FMT_DELTA, DEF_YES, opt, pitem, nbr);
+    *pkey = DEF_NO;
+    if ((ProbeSim_Req(req, len, DEF_NO, &Rsp) != DEF_OK) ||
+        (Rsp.Data[2] != PROBE_SIM_STATUS_OK)) {
+        return (DEF_FAIL);
+    }
+
+    *pkey   = ((Rsp.Data[4] & DELTA_FLAG_KEY) != 0) ? DEF_YES : DEF_NO;
+    pbitmap = &Rsp.Data[5];
+    pdata   = &Rsp.Data[5 + (nbr + 7) / 8];
+    ok      = DEF_OK;
+    for (i = 0; i < nbr; i++) {
+        incl = ((pbitmap[i / 8] & (1 << (i % 8))) != 0) ? DEF_YES : DEF_NO;
+        diff = (memcmp(HostCopy[i], pitem[i].DataPtr, pitem[i].Len) != 0) ? DEF_YES : DEF_NO;
+        if ((*pkey == DEF_YES) && (incl == DEF_NO)) {           /* A keyframe includes every item.                      */
+            ok = DEF_FAIL;
+        }
+        if ((*pkey == DEF_NO) && (incl != diff)) {
+            ok = DEF_FAIL;
+        }
+        if (incl == DEF_YES) {
+            memcpy(HostCopy[i], pdata, pitem[i].Len);
+            pdata += pitem[i].Len;
+        }
+        if (memcmp(HostCopy[i], pitem[i].DataPtr, pitem[i].Len) != 0) {
+            ok = DEF_FAIL;
+        }
+    }
+    if (pdata != &Rsp.Data[Rsp.Len]) {
+        ok = DEF_FAIL;
+    }
+    return (ok);
+}
+
+
+/*
+*********************************************************************************************************
+*                                             Test_Poll()
+*
+* Description : Poll a watch list POLL_NBR times with MULTIPLE_RD, then with MULTIPLE_RD_DELTA, & print the
+*               bytes per update (see Note #3).
+*
+* Argument(s) : name            Name of the watch list.
+*
+*               pitem           Watch list.
+*
+*               nbr             Number of items.
+*
+*               prd             Returns the response bytes per update with MULTIPLE_RD, times 10.
+*
+*               prd_all         Returns the bytes per update both ways with MULTIPLE_RD, times 10.
+*
+*               pdelta_all      Returns the bytes per update both ways with MULTIPLE_RD_DELTA, times 10.
+*
+* Return(s)   : Response bytes per update with MULTIPLE_RD_DELTA, times 10.
+*********************************************************************************************************
+*/
+
+static  CPU_INT32U  Test_Poll (const char            *name,
+                               const PROBE_SIM_ITEM  *pitem,
+                               CPU_INT16U             nbr,
+                               CPU_INT32U            *prd,
+                               CPU_INT32U            *prd_all,
+                               CPU_INT32U            *pdelta_all)
+{
+    PROBE_SIM_STAT  stat;
+    CPU_INT08U      req[PROBE_COM_RX_MAX_SIZE];
+    CPU_INT16U      len;
+    CPU_INT16U      poll;
+    CPU_INT32U      bad;
+    CPU_INT32U      key_ctr;
+    CPU_INT32U      rd;
+    CPU_INT32U      rd_all;
+    CPU_INT32U      delta;
+    CPU_INT32U      delta_all;
+    CPU_BOOLEAN     key;
+
+
+    bad = 0;
+    len = ProbeSim_ReqItems(req, PROBE_SIM_FMT_MULTIPLE_RD, DEF_NO, 0, pitem, nbr);
+    ProbeSim_StatClr();
+    for (poll = 0; poll < POLL_NBR; poll++) {
+        Test_Mutate();
+        if ((ProbeSim_Req(req, len, DEF_NO, &Rsp) != DEF_OK) || (Rsp.Data[2] != PROBE_SIM_STATUS_OK)) {
+            bad++;
+        }
+    }
+    ProbeSim_StatGet(&stat);
+    rd     =  stat.TxByteCtr                    * 10 / POLL_NBR;
+    rd_all = (stat.TxByteCtr + stat.RxByteCtr) * 10 / POLL_NBR;
+
+    key_ctr = 0;
+    ProbeSim_StatClr();
+    for (poll = 0; poll < POLL_NBR; poll++) {
+        Test_Mutate();
+        if (Test_DeltaPoll(pitem, nbr, 0, &key) != DEF_OK) {
+            bad++;
+        }
+        if (key == DEF_YES) {
+            key_ctr++;
+        }
+    }
+    ProbeSim_StatGet(&stat);
+    delta     =  stat.TxByteCtr                    * 10 / POLL_NBR;
+    delta_all = (stat.TxByteCtr + stat.RxByteCtr) * 10 / POLL_NBR;
+
+    printf("%-26s response %2lu.%lu -> %2lu.%lu B, both ways %3lu.%lu -> %3lu.%lu B per update (%lu keyframes)\n",
+           name,
+           (unsigned long)(rd        / 10), (unsigned long)(rd        % 10),
+           (unsigned long)(delta     / 10), (unsigned long)(delta     % 10),
+           (unsigned long)(rd_all    / 10), (unsigned long)(rd_all    % 10),
+           (unsigned long)(delta_all / 10), (unsigned long)(delta_all % 10),
+           (unsigned long)key_ctr);
+    TEST_CHK(bad == 0);
+    TEST_CHK(key_ctr == POLL_NBR / PROBE_COM_DELTA_KEY_PERIOD);
+    *prd        = rd;
+    *prd_all    = rd_all;
+    *pdelta_all = delta_all;
+    return (delta);
+}
+
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                             TestTask()
+*********************************************************************************************************
+*/
+
+static  void  TestTask (void *p_arg)
+{
+    PROBE_SIM_ITEM  dash[10];
+    PROBE_SIM_ITEM  cfg[8];
+    PROBE_SIM_ITEM  hot[4];
+    PROBE_SIM_ITEM  big;
+    CPU_INT08U      req[PROBE_COM_RX_MAX_SIZE];
+    CPU_INT16U      len;
+    CPU_INT16U      poll;
+    CPU_INT32U      rd;
+    CPU_INT32U      rd_all;
+    CPU_INT32U      delta;
+    CPU_INT32U      delta_all;
+    CPU_BOOLEAN     key;
+    CPU_BOOLEAN     ok;
+    CPU_INT08U      i;
+
+
+    (void)p_arg;
+    ProbeSim_Init();
+    ProbeCom_Init();
+    ProbeRS232_Init(115200);
+    ProbeRS232_RxIntEn();
+
+    for (i = 0; i < 4; i++) {
+        dash[i].DataPtr     = (void *)&Dash32[i];
+        dash[i].Len         = 4;
+        dash[4 + i].DataPtr = (void *)&Dash16[i];
+        dash[4 + i].Len     = 2;
+        hot[i].DataPtr      = (void *)&Hot32[i];
+        hot[i].Len          = 4;
+    }
+    for (i = 0; i < 2; i++) {
+        dash[8 + i].DataPtr = (void *)&Dash08[i];
+        dash[8 + i].Len     = 1;
+    }
+    for (i = 0; i < 8; i++) {
+        cfg[i].DataPtr      = (void *)&Cfg32[i];
+        cfg[i].Len          = 4;
+    }
+
+    TEST_CHK(ProbeSim_FmtSupport(PROBE_SIM_FMT_DELTA) == DEF_YES);
+
+    ok = Test_DeltaPoll(dash, 10, 0, &key);                     /* See Note #2.                                         */
+    TEST_CHK((ok == DEF_OK) && (key == DEF_YES));
+    for (poll = 1; poll < 2 * PROBE_COM_DELTA_KEY_PERIOD + 1; poll++) {
+        Test_Mutate();
+        ok = Test_DeltaPoll(dash, 10, 0, &key);
+        TEST_CHK(ok == DEF_OK);
+        TEST_CHK(key == (((poll % PROBE_COM_DELTA_KEY_PERIOD) == 0) ? DEF_YES : DEF_NO));
+    }
+    ok = Test_DeltaPoll(hot, 4, 0, &key);                       /* New list.                                            */
+    TEST_CHK((ok == DEF_OK) && (key == DEF_YES));
+    Test_Mutate();
+    len = ProbeSim_ReqItems(req, PROBE_SIM_FMT_DELTA, DEF_YES, 0, hot, 4);
+    TEST_CHK(ProbeSim_Req(req, len, DEF_NO, &Rsp) == DEF_OK);   /* Response lost: the host copy is stale.               */
+    Test_Mutate();
+    ok = Test_DeltaPoll(hot, 4, DELTA_OPT_KEY, &key);
+    TEST_CHK((ok == DEF_OK) && (key == DEF_YES));
+    ok = Test_DeltaPoll(hot, 4, 0, &key);                       /* Nothing changed.                                     */
+    TEST_CHK((ok == DEF_OK) && (key == DEF_NO) && (Rsp.Len == 6));
+
+    big.DataPtr = (void *)&Big[0];                              /* See Note #4.                                         */
+    big.Len     = sizeof(Big);
+    len = ProbeSim_ReqItems(req, PROBE_SIM_FMT_DELTA, DEF_YES, 0, &big, 1);
+    TEST_CHK((ProbeSim_Req(req, len, DEF_NO, &Rsp) == DEF_OK) && (Rsp.Data[2] == PROBE_SIM_STATUS_TOO_LARGE));
+
+    ok = Test_DeltaPoll(dash, 10, DELTA_OPT_KEY, &key);         /* Realign the keyframe period.                         */
+    TEST_CHK(ok == DEF_OK);
+    delta = Test_Poll("dashboard, 10 items:", dash, 10, &rd, &rd_all, &delta_all);
+    TEST_CHK((delta < rd) && (delta_all < rd_all));             /* See Note #3a.                                        */
+    ok = Test_DeltaPoll(cfg, 8, DELTA_OPT_KEY, &key);
+    TEST_CHK(ok == DEF_OK);
+    delta = Test_Poll("config page, 8 constant:", cfg, 8, &rd, &rd_all, &delta_all);
+    TEST_CHK((delta < rd) && (delta_all < rd_all));             /* See Note #3b.                                        */
+    ok = Test_DeltaPoll(hot, 4, DELTA_OPT_KEY, &key);
+    TEST_CHK(ok == DEF_OK);
+    delta = Test_Poll("4 items, all changing:", hot, 4, &rd, &rd_all, &delta_all);
+    TEST_CHK((delta == rd + 20) && (delta_all == rd_all + 40)); /* See Note #3c.                                        */
+
+    Test_Done("test_probe_delta");
+}
+
+
+int  main (void)
+{
+    OSInit();
+    (void)OSTaskCreateExt(TestTask,
+                          (void *)0,
+                          &TestTaskStk[TEST_TASK_STK_SIZE - 1],
+                          TEST_TASK_PRIO,
+                          TEST_TASK_PRIO,
+                          &TestTaskStk[0],
+                          TEST_TASK_STK_SIZE,
+                          (void *)0,
+                          OS_TASK_OPT_NONE);
+    OSStart();
+    return (0);
+}
@@ -0,0 +1,250 @@
+/*
+*********************************************************************************************************
+*                                             HOST TESTS
+*
+*                                 uC/Probe RS-232 Request Pipelining
+*
+* Filename      : test_probe_pipe.c
+* Note(s)       : (1) probe_com.c & probe_rs232.c at 115200 baud on the simulated SCI of 'probe_sim.c', built
+*                     with PROBE_RS232_PIPE_DEPTH 1, 2 & 3, parsed in the task (test_probe_pipe_1 .. _3),
+*                     & with PROBE_RS232_PARSE_TASK DEF_FALSE, depth 1 (test_probe_pipe_isr).
+*
+*                 (2) The host keeps 'depth' requests in flight, sending the next one 1 ms after each
+*                     response is decoded, as over a USB-serial adapter.  Every request MUST be answered
+*                     with the right data & none dropped; the polls per second are compared with what a
+*                     1 ms round trip allows & with the line ceiling.
+*
+*                 (3) With one more request in flight than TX packets, a request arrives while every TX
+*                     packet is in use.  It MUST be held in its RX buffer & answered once a TX packet is
+*                     free, whether parsed by the task or in the ISR.
+*********************************************************************************************************
+*/
+
+#include  <includes.h>
+#include  <probe_com.h>
+#include  <probe_rs232.h>
+#include  "probe_sim.h"
+
+
+/*
+*********************************************************************************************************
+*                                            LOCAL DEFINES
+*********************************************************************************************************
+*/
+
+#define  RUN_MS                         1000
+#define  HOST_LAT_US                    1000
+
+#define  SYM_NBR                           3
+#define  RD_LEN                           56
+
+
+/*
+*********************************************************************************************************
+*                                        LOCAL GLOBAL VARIABLES
+*********************************************************************************************************
+*/
+
+static  OS_STK          TestTaskStk[TEST_TASK_STK_SIZE];
+
+static  CPU_INT32U      AppSym[SYM_NBR] = {0x01234567, 0x89ABCDEF, 0x5A5AA5A5};
+static  CPU_INT08U      AppBuf[RD_LEN];
+
+static  CPU_INT08U      PollReq[PROBE_COM_RX_MAX_SIZE];
+static  CPU_INT16U      PollReqLen;
+static  CPU_INT16U      PollRspLen;                             /* Data segment of a correct response.                  */
+static  CPU_INT08U      PollRspData[PROBE_COM_TX_MAX_SIZE];
+static  CPU_BOOLEAN     PollEn;
+static  CPU_INT32U      PollCtr;
+static  CPU_INT32U      PollErrCtr;
+
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                             Test_Rx()
+*
+* Description : Check each response & send the next request (see Note #2).
+*********************************************************************************************************
+*/
+
+static  void  Test_Rx (PROBE_SIM_PKT  *ppkt)
+{
+    if ((ppkt->Len != PollRspLen) || (memcmp(ppkt->Data, PollRspData, PollRspLen) != 0)) {
+        PollErrCtr++;
+    }
+    PollCtr++;
+    if (PollEn == DEF_YES) {
+        ProbeSim_HostTx(PollReq, PollReqLen, DEF_NO);
+    }
+}
+
+
+/*
+*********************************************************************************************************
+*                                             Test_Poll()
+*
+* Description : Poll for RUN_MS with 'inflight' requests in flight & print the polls per second.
+*
+* Argument(s) : name            Name of the request.
+*
+*               inflight        Requests in flight.
+*
+* Return(s)   : Polls per second.
+*********************************************************************************************************
+*/
+
+static  CPU_INT32U  Test_Poll (const char  *name,
+                               CPU_INT08U   inflight)
+{
+    CPU_INT32U  drop;
+    CPU_INT32U  sent;
+    CPU_INT32U  rate;
+    CPU_INT32U  rtt_ns;
+    CPU_INT32U  exp;
+    CPU_INT32U  ceil;
+    CPU_INT08U  i;
+
+
+    ProbeSim_Cfg(PROBE_SIM_MODE_TDRE, 0, HOST_LAT_US);
+    drop       = ProbeRS232_RxDropCtr;
+    PollCtr    = 0;
+    PollErrCtr = 0;
+    PollEn     = DEF_YES;
+    for (i = 0; i < inflight; i++) {
+        ProbeSim_HostTx(PollReq, PollReqLen, DEF_NO);
+    }
+    ProbeSim_Run(RUN_MS);
+    rate       = PollCtr;
+    sent       = PollCtr + inflight;
+    PollEn     = DEF_NO;
+    ProbeSim_Run(100);                                          /* Drain the requests in flight.                        */
+    drop       = ProbeRS232_RxDropCtr - drop;
+
+                                                                /* Request & response each way, then the host latency.  */
+    rtt_ns = (8 + PollReqLen + 2 + 8 + PollRspLen + 2) * ProbeSim_ByteNs() + HOST_LAT_US * 1000;
+    ceil   = 1000000000uL / ((8 + ((PollReqLen > PollRspLen) ? PollReqLen : PollRspLen) + 2) * ProbeSim_ByteNs());
+    exp    = (CPU_INT32U)((unsigned long long)inflight * 1000000000uLL / rtt_ns);
+    if (exp > ceil) {
+        exp = ceil;
+    }
+    printf("depth %u, %u in flight, %-16s %3lu polls/s (%3lu for a 1 ms host round trip, line ceiling %3lu)\n",
+           (unsigned)PROBE_RS232_PIPE_DEPTH, (unsigned)inflight, name,
+           (unsigned long)rate, (unsigned long)exp, (unsigned long)ceil);
+
+    TEST_CHK(PollErrCtr == 0);
+    TEST_CHK(PollCtr    == sent);                               /* Every request answered.                              */
+    TEST_CHK(drop       == 0);
+    if (inflight <= PROBE_RS232_PIPE_DEPTH) {                   /* Within 3% of what the round trip allows.             */
+        TEST_CHK((rate * 100 >= exp * 97) && (rate <= exp + 1));
+    }
+    return (rate);
+}
+
+
+/*
+*********************************************************************************************************
+*                                             Test_Req()
+*
+* Description : Set the request polled & the response it MUST get.
+*********************************************************************************************************
+*/
+
+static  void  Test_Req (const PROBE_SIM_ITEM  *pitem,
+                        CPU_INT16U             nbr,
+                        CPU_INT16U             fmt)
+{
+    CPU_INT32U  addr;
+    CPU_INT16U  ix;
+    CPU_INT16U  i;
+
+
+    if (fmt == PROBE_SIM_FMT_SIMPLE_RD) {                       /* Nbr of bytes (2) & addr, of one item.                */
+        addr           = (CPU_INT32U)(unsigned long)pitem->DataPtr;
+        PollReq[0]     = PROBE_SIM_FMT_SIMPLE_RD & 0xFF;
+        PollReq[1]     = PROBE_SIM_FMT_SIMPLE_RD >> 8;
+        PollReq[2]     = pitem->Len;
+        PollReq[3]     = 0;
+        PollReq[4]     = (CPU_INT08U)(addr);
+        PollReq[5]     = (CPU_INT08U)(addr >>  8);
+        PollReq[6]     = (CPU_INT08U)(addr >> 16);
+        PollReq[7]     = (CPU_INT08U)(addr >> 24);
+        PollReqLen     = 8;
+    } else {
+        PollReqLen     = ProbeSim_ReqItems(PollReq, fmt, DEF_NO, 0, pitem, nbr);
+    }
+    PollRspData[0] = (CPU_INT08U)(fmt | PROBE_SIM_FMT_TX);
+    PollRspData[1] = (CPU_INT08U)((fmt | PROBE_SIM_FMT_TX) >> 8);
+    PollRspData[2] = PROBE_SIM_STATUS_OK;
+    PollRspData[3] = 0;
+    ix             = 4;
+    for (i = 0; i < nbr; i++) {
+        memcpy(&PollRspData[ix], pitem[i].DataPtr, pitem[i].Len);
+        ix        += pitem[i].Len;
+    }
+    PollRspLen     = ix;
+}
+
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                             TestTask()
+*********************************************************************************************************
+*/
+
+static  void  TestTask (void *p_arg)
+{
+    PROBE_SIM_ITEM  sym[SYM_NBR];
+    PROBE_SIM_ITEM  buf;
+    CPU_INT08U      i;
+
+
+    (void)p_arg;
+    ProbeSim_Init();
+    ProbeCom_Init();
+    ProbeRS232_Init(115200);
+    ProbeRS232_RxIntEn();
+    ProbeSim_HndlrSet(Test_Rx);
+
+    for (i = 0; i < SYM_NBR; i++) {
+        sym[i].DataPtr = (void *)&AppSym[i];
+        sym[i].Len     = 4;
+    }
+    for (i = 0; i < RD_LEN; i++) {
+        AppBuf[i]      = (CPU_INT08U)(i * 13);
+    }
+    buf.DataPtr = (void *)&AppBuf[0];
+    buf.Len     = RD_LEN;
+
+    Test_Req(sym, SYM_NBR, PROBE_SIM_FMT_MULTIPLE_RD);          /* See Note #2.                                         */
+    (void)Test_Poll("MULTIPLE_RD, 3 syms:", PROBE_RS232_PIPE_DEPTH);
+    Test_Req(&buf, 1, PROBE_SIM_FMT_SIMPLE_RD);
+    (void)Test_Poll("SIMPLE_RD, 56 B:",     PROBE_RS232_PIPE_DEPTH);
+
+    Test_Req(&buf, 1, PROBE_SIM_FMT_SIMPLE_RD);                 /* See Note #3.                                         */
+    (void)Test_Poll("SIMPLE_RD, 56 B:",     PROBE_RS232_PIPE_DEPTH + 1);
+
+#if (PROBE_RS232_PARSE_TASK == DEF_TRUE)
+    Test_Done("test_probe_pipe (PROBE_RS232_PARSE_TASK DEF_TRUE)");
+#else
+    Test_Done("test_probe_pipe (PROBE_RS232_PARSE_TASK DEF_FALSE)");
+#endif
+}
+
+
+int  main (void)
+{
+    OSInit();
+    (void)OSTaskCreateExt(TestTask,
+                          (void *)0,
+                          &TestTaskStk[TEST_TASK_STK_SIZE - 1],
+                          TEST_TASK_PRIO,
+                          TEST_TASK_PRIO,
+                          &TestTaskStk[0],
+                          TEST_TASK_STK_SIZE,
+                          (void *)0,
+                          OS_TASK_OPT_NONE);
+    OSStart();
+    return (0);
+}
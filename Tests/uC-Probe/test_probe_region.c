@@ -0,0 +1,659 @@
+/*
+*********************************************************************************************************
+*                                             HOST TESTS
+*
+*                                    uC/Probe Memory Region Table
+*
+* Filename      : test_probe_region.c
+* Note(s)       : (1) probe_com.c with the Dragon12 table ('OS-Probe-LCD/Sources/probe_com_region.c', its
+*                     '__far' pointer taken as a plain one), queried through ProbeCom_ParseRxPkt().  Built
+*                     with PROBE_COM_SUPPORT_WR DEF_TRUE as on the board (test_probe_region_wr), & without
+*                     writes (test_probe_region).
+*
+*                 (2) The target's memory is mapped at the addresses the requests name: paged flash at
+*                     0x308000-0x3DBFFF, each page filled with its own pattern, & RAM & unpaged flash at
+*                     0x1000-0xFFFF.  The page at 0x0000 (registers & EEPROM) cannot be mapped, so only
+*                     requests that MUST be refused are sent there.  Where vm.mmap_min_addr is above
+*                     0x1000, the checks that touch 0x1000-0xFFFF are skipped.
+*
+*                 (3) The table MUST be sorted, without overlaps, & grant WR only to PROBE_RAM
+*                     (0x3FC0-0x3FFF): never to the stack, the kernel or the other RAM, nor to a paged
+*                     region.  The SCI registers & the 0x8000-0xBFFF window MUST NOT be covered.
+*
+*                 (4) Each item MUST lie within one region granting the access, else the request is
+*                     answered with ADDR_FORBIDDEN & no memory is touched.  Paged flash MUST be read from
+*                     the page named, never sent in place in a scattered response.
+*
+*                 (5) A rejected delta or stream request MUST leave the shadow & the running stream as
+*                     they were.
+*
+*                 (6) SIMPLE_RD time, with the region last found hit & with the tbl searched each time.
+*********************************************************************************************************
+*/
+
+#include  <includes.h>
+#include  <probe_com.h>
+#include  <sys/mman.h>
+
+
+/*
+*********************************************************************************************************
+*                                            LOCAL DEFINES
+*********************************************************************************************************
+*/
+
+#define  FMT_SIMPLE_RD                0x0002
+#define  FMT_SIMPLE_WR                0x0003
+#define  FMT_MULTIPLE_RD              0x0007
+#define  FMT_MULTIPLE_WR              0x0008
+#define  FMT_STREAM_CFG               0x000C
+#define  FMT_MULTIPLE_RD_DELTA        0x000E
+
+#define  STATUS_OK                      0x01
+#define  STATUS_UNKNOWN_REQUEST         0xF9
+#define  STATUS_ADDR_FORBIDDEN          0xFA
+#define  STATUS_TX_PKT_TOO_LARGE        0xFD
+
+#if (PROBE_COM_SUPPORT_WR == DEF_TRUE)                          /* Status of a wr that may NOT be done.                 */
+#define  STATUS_WR_REFUSED      STATUS_ADDR_FORBIDDEN
+#else
+#define  STATUS_WR_REFUSED      STATUS_UNKNOWN_REQUEST
+#endif
+
+                                                                /* Memory map of the PRM files (see Note #2).           */
+#define  LOW_BASE                 0x00001000uL
+#define  LOW_SIZE                 0x0000F000uL
+#define  PAGED_BASE               0x00300000uL
+#define  PAGED_SIZE               0x000E0000uL
+#define  PAGE_FIRST                     0x30
+#define  PAGE_LAST                      0x3D
+
+#define  RAM_START                0x00001000uL                  /* SSTACK, then the kernel & application data.          */
+#define  RAM_END                  0x00003FBFuL
+#define  PROBE_RAM_START          0x00003FC0uL
+#define  PROBE_RAM_END            0x00003FFFuL
+#define  FLASH_4000               0x00004000uL
+#define  FLASH_C000               0x0000C000uL
+#define  SCI_START                0x000000C8uL
+#define  SCI_END                  0x000000D7uL
+#define  EEPROM_START             0x00000400uL
+#define  WINDOW_START             0x00008000uL
+
+#define  PAGED_ADDR(pg, off)    (((CPU_INT32U)(pg) << 16) | (CPU_INT32U)(off))
+
+#define  BENCH_NBR                    1000000
+
+
+/*
+*********************************************************************************************************
+*                                        LOCAL GLOBAL VARIABLES
+*********************************************************************************************************
+*/
+
+static  CPU_INT08U   Req[PROBE_COM_RX_MAX_SIZE];
+static  CPU_INT16U   ReqLen;
+static  CPU_INT08U   Rsp[PROBE_COM_TX_MAX_SIZE];
+
+static  CPU_BOOLEAN  LowMapped;                                 /* 0x1000-0xFFFF mapped (see Note #2).                  */
+
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                             Test_Pat()
+*
+* Description : Return the byte the target's memory holds at 'addr'.
+*********************************************************************************************************
+*/
+
+static  CPU_INT08U  Test_Pat (CPU_INT32U  addr)
+{
+    return ((CPU_INT08U)(addr * 7 + (addr >> 8) * 3 + (addr >> 16) * 29));
+}
+
+
+/*
+*********************************************************************************************************
+*                                             Test_Mem()
+*
+* Description : Return a pointer to the target's memory at 'addr'.
+*********************************************************************************************************
+*/
+
+static  CPU_INT08U  *Test_Mem (CPU_INT32U  addr)
+{
+    return ((CPU_INT08U *)(unsigned long)addr);
+}
+
+
+/*
+*********************************************************************************************************
+*                                             Test_Map()
+*
+* Description : Map & fill the target's memory (see Note #2).
+*
+* Argument(s) : base            Address of the first byte.
+*
+*               size            Number of bytes.
+*
+* Return(s)   : DEF_OK,   if the memory was mapped at 'base';
+*               DEF_FAIL, otherwise.
+*********************************************************************************************************
+*/
+
+static  CPU_BOOLEAN  Test_Map (CPU_INT32U  base,
+                               CPU_INT32U  size)
+{
+    void        *pmem;
+    CPU_INT32U   addr;
+
+
+    pmem = mmap((void *)(unsigned long)base, size, PROT_READ | PROT_WRITE,
+                MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED_NOREPLACE, -1, 0);
+    if (pmem == MAP_FAILED) {
+        return (DEF_FAIL);
+    }
+    if (pmem != (void *)(unsigned long)base) {                  /* Kernel before 4.17: taken as a hint.                 */
+        (void)munmap(pmem, size);
+        return (DEF_FAIL);
+    }
+    for (addr = base; addr < base + size; addr++) {
+        *Test_Mem(addr) = Test_Pat(addr);
+    }
+    return (DEF_OK);
+}
+
+
+/*
+*********************************************************************************************************
+*                                          Test_Put08U/16U/32U()
+*
+* Description : Append to the request in Req[].
+*********************************************************************************************************
+*/
+
+static  void  Test_Put08U (CPU_INT08U  val)
+{
+    Req[ReqLen++] = val;
+}
+
+
+static  void  Test_Put16U (CPU_INT16U  val)
+{
+    Test_Put08U((CPU_INT08U)(val));
+    Test_Put08U((CPU_INT08U)(val >> 8));
+}
+
+
+static  void  Test_Put32U (CPU_INT32U  val)
+{
+    Test_Put16U((CPU_INT16U)(val));
+    Test_Put16U((CPU_INT16U)(val >> 16));
+}
+
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                            Test_Item()
+*
+* Description : Append an item descriptor of 'len' bytes at 'addr' to the request in Req[].
+*********************************************************************************************************
+*/
+
+static  void  Test_Item (CPU_INT32U  addr,
+                         CPU_INT08U  len)
+{
+    Test_Put08U(len);
+    Test_Put32U(addr);
+}
+
+
+/*
+*********************************************************************************************************
+*                                            Test_Parse()
+*
+* Description : Parse the request in Req[] & return the status of the response in Rsp[].
+*********************************************************************************************************
+*/
+
+static  CPU_INT08U  Test_Parse (void)
+{
+    (void)ProbeCom_ParseRxPkt((void *)Req, (void *)Rsp, ReqLen, PROBE_COM_TX_MAX_SIZE);
+    return (Rsp[2]);
+}
+
+
+/*
+*********************************************************************************************************
+*                                           Test_SimpleRd()
+*                                           Test_SimpleWr()
+*
+* Description : Send a SIMPLE_RD of 'len' bytes at 'addr', or a SIMPLE_WR of 'len' bytes of 'val'.
+*
+* Return(s)   : Status of the response.
+*********************************************************************************************************
+*/
+
+static  CPU_INT08U  Test_SimpleRd (CPU_INT32U  addr,
+                                   CPU_INT16U  len)
+{
+    ReqLen = 0;
+    Test_Put16U(FMT_SIMPLE_RD);
+    Test_Put16U(len);
+    Test_Put32U(addr);
+    return (Test_Parse());
+}
+
+
+static  CPU_INT08U  Test_SimpleWr (CPU_INT32U  addr,
+                                   CPU_INT16U  len,
+                                   CPU_INT08U  val)
+{
+    CPU_INT16U  i;
+
+
+    ReqLen = 0;
+    Test_Put16U(FMT_SIMPLE_WR);
+    Test_Put16U(len);
+    Test_Put32U(addr);
+    for (i = 0; i < len; i++) {
+        Test_Put08U(val);
+    }
+    return (Test_Parse());
+}
+
+
+/*
+*********************************************************************************************************
+*                                            Test_RdChk()
+*
+* Description : Check that Rsp[] holds the 'len' bytes of the target's memory at 'addr', from 'ix'.
+*********************************************************************************************************
+*/
+
+static  CPU_BOOLEAN  Test_RdChk (CPU_INT16U  ix,
+                                 CPU_INT32U  addr,
+                                 CPU_INT16U  len)
+{
+    CPU_INT16U  i;
+
+
+    for (i = 0; i < len; i++) {
+        if (Rsp[ix + i] != Test_Pat(addr + i)) {
+            return (DEF_FAIL);
+        }
+    }
+    return (DEF_OK);
+}
+
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                            Test_Tbl()
+*
+* Description : Check the region table (see Note #3).
+*********************************************************************************************************
+*/
+
+static  void  Test_Tbl (void)
+{
+    const  PROBE_COM_REGION  *pregion;
+    CPU_INT32U                wr_start;
+    CPU_INT32U                wr_end;
+    CPU_INT16U                wr_nbr;
+    CPU_BOOLEAN               sorted;
+    CPU_BOOLEAN               paged_wr;
+    CPU_BOOLEAN               covered;
+    CPU_INT16U                i;
+
+
+    sorted   = DEF_YES;
+    paged_wr = DEF_NO;
+    covered  = DEF_NO;
+    wr_nbr   = 0;
+    wr_start = 0;
+    wr_end   = 0;
+    for (i = 0; i < ProbeCom_RegionTblNbr; i++) {
+        pregion = &ProbeCom_RegionTbl[i];
+        if ((pregion->Start > pregion->End) ||
+           ((i > 0) && (pregion->Start <= ProbeCom_RegionTbl[i - 1].End))) {
+            sorted = DEF_NO;
+        }
+        if ((pregion->Access & PROBE_COM_REGION_WR) != 0) {
+            if ((pregion->Access & PROBE_COM_REGION_PAGED) != 0) {
+                paged_wr = DEF_YES;
+            }
+            wr_nbr++;
+            wr_start = pregion->Start;
+            wr_end   = pregion->End;
+        }
+        if (((pregion->Start <= SCI_END)                && (pregion->End >= SCI_START)) ||
+            ((pregion->Start <= WINDOW_START + 0x3FFFuL) && (pregion->End >= WINDOW_START))) {
+            covered = DEF_YES;
+        }
+    }
+    TEST_CHK(sorted   == DEF_YES);
+    TEST_CHK(paged_wr == DEF_NO);
+    TEST_CHK(covered  == DEF_NO);
+    TEST_CHK((wr_nbr == 1) && (wr_start == PROBE_RAM_START) && (wr_end == PROBE_RAM_END));
+    printf("%u regions, WR only 0x%04lX-0x%04lX\n",
+           (unsigned)ProbeCom_RegionTblNbr, (unsigned long)wr_start, (unsigned long)wr_end);
+}
+
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                             Test_Rd()
+*
+* Description : Check reads of unpaged & paged memory (see Note #4).
+*********************************************************************************************************
+*/
+
+static  void  Test_Rd (void)
+{
+    static  const  CPU_INT16U  off[3] = {0x8000, 0x9234, 0xBFF0};
+    CPU_BOOLEAN                good;
+    CPU_INT16U                 pg;
+    CPU_INT16U                 k;
+
+
+    TEST_CHK(Test_SimpleRd(SCI_START,               1) == STATUS_ADDR_FORBIDDEN);
+    TEST_CHK(Test_SimpleRd(SCI_END,                 1) == STATUS_ADDR_FORBIDDEN);
+    TEST_CHK(Test_SimpleRd(SCI_START - 8,          16) == STATUS_ADDR_FORBIDDEN);  /* Runs into the SCI.          */
+    TEST_CHK(Test_SimpleRd(EEPROM_START - 4,        8) == STATUS_ADDR_FORBIDDEN);  /* Registers into EEPROM.      */
+    TEST_CHK(Test_SimpleRd(0x00000FF0uL,            1) == STATUS_ADDR_FORBIDDEN);  /* Hole above EEPROM.          */
+    TEST_CHK(Test_SimpleRd(RAM_END - 1,             4) == STATUS_ADDR_FORBIDDEN);  /* RAM into PROBE_RAM.         */
+    TEST_CHK(Test_SimpleRd(WINDOW_START,            4) == STATUS_ADDR_FORBIDDEN);
+    TEST_CHK(Test_SimpleRd(FLASH_C000 - 2,          4) == STATUS_ADDR_FORBIDDEN);  /* Window into flash.          */
+    TEST_CHK(Test_SimpleRd(0xFFFFFFF0uL,         0x20) == STATUS_ADDR_FORBIDDEN);  /* Wraps past 0xFFFFFFFF.      */
+
+    if (LowMapped == DEF_YES) {
+        TEST_CHK((Test_SimpleRd(RAM_START,       16) == STATUS_OK) && (Test_RdChk(4, RAM_START,       16) == DEF_OK));
+        TEST_CHK((Test_SimpleRd(RAM_END - 15,    16) == STATUS_OK) && (Test_RdChk(4, RAM_END - 15,    16) == DEF_OK));
+        TEST_CHK((Test_SimpleRd(PROBE_RAM_START, 16) == STATUS_OK) && (Test_RdChk(4, PROBE_RAM_START, 16) == DEF_OK));
+        TEST_CHK((Test_SimpleRd(FLASH_4000,      16) == STATUS_OK) && (Test_RdChk(4, FLASH_4000,      16) == DEF_OK));
+        TEST_CHK((Test_SimpleRd(0x0000FFF0uL,    16) == STATUS_OK) && (Test_RdChk(4, 0x0000FFF0uL,    16) == DEF_OK));
+    }
+
+    good = DEF_YES;                                             /* Every page, from the page named.                     */
+    for (pg = PAGE_FIRST; pg <= PAGE_LAST; pg++) {
+        for (k = 0; k < 3; k++) {
+            if ((Test_SimpleRd(PAGED_ADDR(pg, off[k]), 16) != STATUS_OK) ||
+                (Test_RdChk(4, PAGED_ADDR(pg, off[k]), 16) != DEF_OK)) {
+                good = DEF_NO;
+            }
+        }
+    }
+    TEST_CHK(good == DEF_YES);
+    TEST_CHK(Test_SimpleRd(PAGED_ADDR(PAGE_LAST, 0xBFF8),     16) == STATUS_ADDR_FORBIDDEN);  /* Past end of page.  */
+    TEST_CHK(Test_SimpleRd(PAGED_ADDR(0x3E, 0x8000),           4) == STATUS_ADDR_FORBIDDEN);  /* Is ROM_4000.       */
+    TEST_CHK(Test_SimpleRd(PAGED_ADDR(PAGE_FIRST - 1, 0x8000), 4) == STATUS_ADDR_FORBIDDEN);
+    TEST_CHK(Test_SimpleRd(PAGED_ADDR(PAGE_FIRST, 0xC000),     4) == STATUS_ADDR_FORBIDDEN);
+
+    ReqLen = 0;                                                 /* Paged & unpaged items in one request.                */
+    Test_Put16U(FMT_MULTIPLE_RD);
+    Test_Item(PAGED_ADDR(0x35, 0x8100), 8);
+    Test_Item(PAGED_ADDR(0x3C, 0xA000), 4);
+    TEST_CHK((Test_Parse() == STATUS_OK) &&
+             (Test_RdChk(4, PAGED_ADDR(0x35, 0x8100), 8) == DEF_OK) &&
+             (Test_RdChk(12, PAGED_ADDR(0x3C, 0xA000), 4) == DEF_OK));
+    if (LowMapped == DEF_YES) {
+        Test_Item(RAM_START + 0x200, 4);
+        TEST_CHK((Test_Parse() == STATUS_OK) && (Test_RdChk(16, RAM_START + 0x200, 4) == DEF_OK));
+    }
+    Test_Item(SCI_START, 1);                                    /* One forbidden item refuses all.                      */
+    TEST_CHK(Test_Parse() == STATUS_ADDR_FORBIDDEN);
+}
+
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                             Test_Wr()
+*
+* Description : Check writes (see Note #3 & #4).  Without PROBE_COM_SUPPORT_WR, every write is refused.
+*********************************************************************************************************
+*/
+
+static  void  Test_Wr (void)
+{
+    static  const  CPU_INT32U  addr[4] = {RAM_START, RAM_START + 0x0800, RAM_END - 3, FLASH_4000};
+    CPU_BOOLEAN                intact;
+    CPU_INT16U                 i;
+
+
+    intact = DEF_YES;                                           /* Stack, kernel & other RAM, flash.                    */
+    for (i = 0; i < 4; i++) {
+        TEST_CHK(Test_SimpleWr(addr[i], 4, 0x5A) == STATUS_WR_REFUSED);
+        if ((LowMapped == DEF_YES) && (*Test_Mem(addr[i]) != Test_Pat(addr[i]))) {
+            intact = DEF_NO;
+        }
+    }
+    TEST_CHK(intact == DEF_YES);
+    TEST_CHK(Test_SimpleWr(PROBE_RAM_END - 1,        4, 0x5A) == STATUS_WR_REFUSED);  /* Runs into flash.       */
+    TEST_CHK(Test_SimpleWr(SCI_START,                1, 0x5A) == STATUS_WR_REFUSED);
+    TEST_CHK(Test_SimpleWr(EEPROM_START,             1, 0x5A) == STATUS_WR_REFUSED);
+    TEST_CHK(Test_SimpleWr(PAGED_ADDR(0x34, 0x8000), 1, 0x5A) == STATUS_WR_REFUSED);
+    TEST_CHK(*Test_Mem(PAGED_ADDR(0x34, 0x8000)) == Test_Pat(PAGED_ADDR(0x34, 0x8000)));
+
+    ReqLen = 0;                                                 /* A kernel item refuses the request.                   */
+    Test_Put16U(FMT_MULTIPLE_WR);
+    Test_Item(RAM_START + 0x0400, 2);
+    Test_Put16U(0xEEEE);
+    Test_Item(PROBE_RAM_START, 2);
+    Test_Put16U(0xEEEE);
+    TEST_CHK(Test_Parse() == STATUS_WR_REFUSED);
+
+    if (LowMapped == DEF_YES) {
+        TEST_CHK(*Test_Mem(RAM_START + 0x0400) == Test_Pat(RAM_START + 0x0400));
+#if (PROBE_COM_SUPPORT_WR == DEF_TRUE)
+        TEST_CHK((Test_SimpleWr(PROBE_RAM_START, 4, 0x5A) == STATUS_OK) && (*Test_Mem(PROBE_RAM_START + 3) == 0x5A));
+        TEST_CHK((Test_SimpleWr(PROBE_RAM_END,   1, 0xA5) == STATUS_OK) && (*Test_Mem(PROBE_RAM_END)       == 0xA5));
+#endif
+    }
+}
+
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                          Test_SimpleRdSG()
+*                                             Test_SG()
+*
+* Description : Send a scattered SIMPLE_RD; check scattered reads (see Note #4).  RAM is sent in place,
+*               so it need not be mapped.
+*********************************************************************************************************
+*/
+
+#if (PROBE_COM_SUPPORT_SG == DEF_TRUE)
+static  CPU_INT16U  Test_SimpleRdSG (CPU_INT32U         addr,
+                                     CPU_INT16U         len,
+                                     PROBE_COM_TX_SEG  *pseg,
+                                     CPU_INT08U        *pseg_nbr)
+{
+    ReqLen = 0;
+    Test_Put16U(FMT_SIMPLE_RD);
+    Test_Put16U(len);
+    Test_Put32U(addr);
+    return (ProbeCom_ParseRxPktSG((void *)Req, (void *)Rsp, ReqLen, PROBE_COM_TX_MAX_SIZE,
+                                  pseg, PROBE_COM_SG_SEG_NBR, pseg_nbr));
+}
+
+
+static  void  Test_SG (void)
+{
+    PROBE_COM_TX_SEG  seg[PROBE_COM_SG_SEG_NBR];
+    CPU_INT08U        seg_nbr;
+    CPU_INT16U        len;
+
+
+    len = Test_SimpleRdSG(RAM_START, 1000, seg, &seg_nbr);
+    TEST_CHK((Rsp[2] == STATUS_OK) && (len == 1004) && (seg_nbr == 2) && (seg[1].DataPtr == (void *)Test_Mem(RAM_START)));
+
+    (void)Test_SimpleRdSG(RAM_END - 499, 1000, seg, &seg_nbr);  /* Runs from RAM into PROBE_RAM.                        */
+    TEST_CHK((Rsp[2] == STATUS_ADDR_FORBIDDEN) && (seg_nbr == 1));
+
+                                                                /* Paged, too large to copy into the TX buf.            */
+    (void)Test_SimpleRdSG(PAGED_ADDR(0x31, 0x8000), 1000, seg, &seg_nbr);
+    TEST_CHK((Rsp[2] == STATUS_TX_PKT_TOO_LARGE) && (seg_nbr == 1));
+
+                                                                /* Paged, copied.                                       */
+    len = Test_SimpleRdSG(PAGED_ADDR(0x31, 0x8000), 40, seg, &seg_nbr);
+    TEST_CHK((Rsp[2] == STATUS_OK) && (len == 44) && (seg_nbr == 1) &&
+             (Test_RdChk(4, PAGED_ADDR(0x31, 0x8000), 40) == DEF_OK));
+}
+#endif
+
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                            Test_Delta()
+*                                            Test_Stream()
+*
+* Description : Check that a rejected delta or stream request leaves the state as it was (see Note #5).
+*********************************************************************************************************
+*/
+
+#if (PROBE_COM_SUPPORT_DELTA == DEF_TRUE)
+static  void  Test_DeltaReq (CPU_INT32U  addr)
+{
+    ReqLen = 0;
+    Test_Put16U(FMT_MULTIPLE_RD_DELTA);
+    Test_Put16U(0);
+    Test_Item(PAGED_ADDR(0x32, 0x8010), 4);
+    Test_Item(addr, 4);
+}
+
+
+static  void  Test_Delta (void)
+{
+    Test_DeltaReq(PAGED_ADDR(0x3C, 0x9000));                    /* Keyframe, then nothing changed.                      */
+    TEST_CHK((Test_Parse() == STATUS_OK) && (Rsp[4] == 1) && (Rsp[5] == 0x03) &&
+             (Test_RdChk(6,  PAGED_ADDR(0x32, 0x8010), 4) == DEF_OK) &&
+             (Test_RdChk(10, PAGED_ADDR(0x3C, 0x9000), 4) == DEF_OK));
+    TEST_CHK((Test_Parse() == STATUS_OK) && (Rsp[4] == 0) && (Rsp[5] == 0));
+
+    Test_DeltaReq(SCI_START);
+    TEST_CHK(Test_Parse() == STATUS_ADDR_FORBIDDEN);
+    Test_DeltaReq(PAGED_ADDR(0x3C, 0x9000));                    /* Still no keyframe.                                   */
+    TEST_CHK((Test_Parse() == STATUS_OK) && (Rsp[4] == 0) && (Rsp[5] == 0));
+}
+#endif
+
+
+#if (PROBE_COM_SUPPORT_STREAM == DEF_TRUE)
+static  void  Test_Stream (void)
+{
+    CPU_INT16U  len;
+
+
+    ReqLen = 0;
+    Test_Put16U(FMT_STREAM_CFG);
+    Test_Put16U(10);
+    Test_Item(PAGED_ADDR(0x3B, 0x8010), 4);
+    Test_Item(PAGED_ADDR(0x30, 0xB000), 4);
+    TEST_CHK(Test_Parse() == STATUS_OK);
+    len = ProbeCom_StreamSnapshot((void *)Rsp, PROBE_COM_TX_MAX_SIZE, 1);
+    TEST_CHK((len == 18) && (Test_RdChk(10, PAGED_ADDR(0x3B, 0x8010), 4) == DEF_OK) &&
+                            (Test_RdChk(14, PAGED_ADDR(0x30, 0xB000), 4) == DEF_OK));
+
+    ReqLen = 0;
+    Test_Put16U(FMT_STREAM_CFG);
+    Test_Put16U(10);
+    Test_Item(PAGED_ADDR(0x3A, 0x8000), 4);
+    Test_Item(WINDOW_START, 4);
+    TEST_CHK(Test_Parse() == STATUS_ADDR_FORBIDDEN);
+    len = ProbeCom_StreamSnapshot((void *)Rsp, PROBE_COM_TX_MAX_SIZE, 2);
+    TEST_CHK((len == 18) && (Test_RdChk(10, PAGED_ADDR(0x3B, 0x8010), 4) == DEF_OK) &&
+                            (Test_RdChk(14, PAGED_ADDR(0x30, 0xB000), 4) == DEF_OK));
+
+    ReqLen = 0;                                                 /* Stop the stream.                                     */
+    Test_Put16U(FMT_STREAM_CFG);
+    Test_Put16U(0);
+    (void)Test_Parse();
+}
+#endif
+
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                            Test_Bench()
+*
+* Description : Time SIMPLE_RD requests (see Note #6).
+*********************************************************************************************************
+*/
+
+static  void  Test_Bench (void)
+{
+    unsigned  long  long  t_hit;
+    unsigned  long  long  t_miss;
+    CPU_BOOLEAN           good;
+    CPU_INT32U            n;
+
+
+    good  = DEF_YES;
+    t_hit = Test_TimeNs();                                      /* Same page each time: region last found.              */
+    for (n = 0; n < BENCH_NBR; n++) {
+        if (Test_SimpleRd(PAGED_ADDR(0x36, 0x8000 + (n & 0xFF)), 4) != STATUS_OK) {
+            good = DEF_NO;
+        }
+    }
+    t_hit  = Test_TimeNs() - t_hit;
+
+    t_miss = Test_TimeNs();                                     /* Alternating pages: tbl searched.                     */
+    for (n = 0; n < BENCH_NBR; n++) {
+        if (Test_SimpleRd(PAGED_ADDR((n & 1) ? PAGE_FIRST : PAGE_LAST, 0x8000 + (n & 0xFF)), 4) != STATUS_OK) {
+            good = DEF_NO;
+        }
+    }
+    t_miss = Test_TimeNs() - t_miss;
+
+    TEST_CHK(good == DEF_YES);
+    printf("SIMPLE_RD of 4 B, %u regions: %5.1f ns with the last region hit, %5.1f ns searched\n",
+           (unsigned)ProbeCom_RegionTblNbr, (double)t_hit / BENCH_NBR, (double)t_miss / BENCH_NBR);
+}
+
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                              main()
+*********************************************************************************************************
+*/
+
+int  main (void)
+{
+    ProbeCom_Init();
+    TEST_CHK(Test_Map(PAGED_BASE, PAGED_SIZE) == DEF_OK);
+    LowMapped = (Test_Map(LOW_BASE, LOW_SIZE) == DEF_OK) ? DEF_YES : DEF_NO;
+    if (LowMapped == DEF_NO) {
+        printf("0x%04lX-0x%04lX not mappable (vm.mmap_min_addr): its reads & writes are skipped\n",
+               (unsigned long)LOW_BASE, (unsigned long)(LOW_BASE + LOW_SIZE - 1));
+    }
+
+    Test_Tbl();
+    Test_Rd();
+    Test_Wr();
+#if (PROBE_COM_SUPPORT_SG == DEF_TRUE)
+    Test_SG();
+#endif
+#if (PROBE_COM_SUPPORT_DELTA == DEF_TRUE)
+    Test_Delta();
+#endif
+#if (PROBE_COM_SUPPORT_STREAM == DEF_TRUE)
+    Test_Stream();
+#endif
+    Test_Bench();
+
+#if (PROBE_COM_SUPPORT_WR == DEF_TRUE)
+    Test_Done("test_probe_region (PROBE_COM_SUPPORT_WR DEF_TRUE)");
+#else
+    Test_Done("test_probe_region (PROBE_COM_SUPPORT_WR DEF_FALSE)");
+#endif
+    return (0);
+}
@@ -0,0 +1,380 @@
+/*
+*********************************************************************************************************
+*                                             HOST TESTS
+*
+*                                 uC/Probe Scattered (Zero-Copy) Reads
+*
+* Filename      : test_probe_sg.c
+* Note(s)       : (1) probe_com.c & probe_rs232.c at 115200 baud on the simulated SCI of 'probe_sim.c', built
+*                     with PROBE_COM_SUPPORT_SG DEF_TRUE (test_probe_sg_on, the board's 13 segments; &
+*                     test_probe_sg_seg4, 4 segments) & DEF_FALSE (test_probe_sg_off).
+*
+*                 (2) With SG, the MAX_TX_SIZE query MUST report PROBE_COM_SG_MAX_SIZE & a read of up to
+*                     PROBE_COM_SG_MAX_SIZE bytes with its header MUST return the right data.  Without,
+*                     any read that does not fit in the TX buffer is rejected as too large.  A response
+*                     framed with a CRC-16 is never scattered.
+*
+*                 (3) A MULTIPLE_RD of 12 adjacent items takes one segment; one of scattered items takes
+*                     one per item, & empty items take none.  A request needing more segments than
+*                     PROBE_COM_SG_SEG_NBR is rejected as too large.
+*
+*                 (4) A 2 KB trace buffer is read in 60-byte chunks, as the host must without SG, then in
+*                     one scattered read, each request sent as soon as the previous response is decoded.
+*                     With no host latency, then 1 ms, as over a USB-serial adapter.
+*********************************************************************************************************
+*/
+
+#include  <includes.h>
+#include  <probe_com.h>
+#include  <probe_rs232.h>
+#include  "probe_sim.h"
+
+
+/*
+*********************************************************************************************************
+*                                            LOCAL DEFINES
+*********************************************************************************************************
+*/
+
+#define  MEM_SIZE                       4200
+#define  TRACE_LEN                      2048
+#define  CHUNK_LEN       (PROBE_COM_TX_MAX_SIZE - 4)            /* Largest rd that fits in the TX buffer.               */
+
+#define  ITEM_NBR                         12                    /* Most items a request holds.                          */
+#define  ITEM_LEN                        200
+
+#if (PROBE_COM_SUPPORT_SG == DEF_TRUE)
+#define  RD_MAX_SIZE       PROBE_COM_SG_MAX_SIZE
+#else
+#define  RD_MAX_SIZE                    4096                    /* As the board's PROBE_COM_SG_MAX_SIZE.                */
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                        LOCAL GLOBAL VARIABLES
+*********************************************************************************************************
+*/
+
+static  OS_STK               TestTaskStk[TEST_TASK_STK_SIZE];
+
+static  CPU_INT08U           Mem[MEM_SIZE];                     /* Target memory read.                                  */
+static  CPU_INT08U           HostTrace[TRACE_LEN];              /* Host copy of the trace buffer (see Note #4).         */
+
+static  CPU_INT16U           TraceOff;
+static  CPU_INT16U           TraceChunk;
+static  CPU_INT32U           TraceRdCtr;
+static  CPU_INT32U           TraceErrCtr;
+static  CPU_BOOLEAN          TraceActive;
+static  unsigned  long long  TraceEnd_ns;
+
+static  PROBE_SIM_PKT        Rsp;
+
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                          Test_SimpleRdReq()
+*
+* Description : Form a SIMPLE_RD request of 'len' bytes at 'off' in Mem[].
+*
+* Return(s)   : Length of the request.
+*********************************************************************************************************
+*/
+
+static  CPU_INT16U  Test_SimpleRdReq (CPU_INT08U  *preq,
+                                     CPU_INT16U   off,
+                                     CPU_INT16U   len)
+{
+    CPU_INT32U  addr;
+
+
+    addr    = (CPU_INT32U)(unsigned long)&Mem[off];
+    preq[0] = PROBE_SIM_FMT_SIMPLE_RD & 0xFF;
+    preq[1] = PROBE_SIM_FMT_SIMPLE_RD >> 8;
+    preq[2] = (CPU_INT08U)(len);
+    preq[3] = (CPU_INT08U)(len  >>  8);
+    preq[4] = (CPU_INT08U)(addr);
+    preq[5] = (CPU_INT08U)(addr >>  8);
+    preq[6] = (CPU_INT08U)(addr >> 16);
+    preq[7] = (CPU_INT08U)(addr >> 24);
+    return (8);
+}
+
+
+/*
+*********************************************************************************************************
+*                                            Test_Rd()
+*
+* Description : Read 'len' bytes at 'off' in Mem[] with SIMPLE_RD.
+*
+* Return(s)   : The response status, or 0 if there was no response.  On PROBE_SIM_STATUS_OK, 0 if the data
+*               are wrong.
+*********************************************************************************************************
+*/
+
+static  CPU_INT08U  Test_Rd (CPU_INT16U   off,
+                             CPU_INT16U   len,
+                             CPU_BOOLEAN  crc_en)
+{
+    CPU_INT08U  req[8];
+
+
+    (void)Test_SimpleRdReq(req, off, len);
+    if (ProbeSim_Req(req, sizeof(req), crc_en, &Rsp) != DEF_OK) {
+        return (0);
+    }
+    if ((Rsp.Data[2] == PROBE_SIM_STATUS_OK) &&
+        ((Rsp.Len != 4 + len) || (memcmp(&Rsp.Data[4], &Mem[off], len) != 0))) {
+        return (0);
+    }
+    return (Rsp.Data[2]);
+}
+
+
+/*
+*********************************************************************************************************
+*                                          Test_MultipleRd()
+*
+* Description : Read a list of items with MULTIPLE_RD.
+*
+* Return(s)   : As Test_Rd().
+*********************************************************************************************************
+*/
+
+static  CPU_INT08U  Test_MultipleRd (const PROBE_SIM_ITEM  *pitem,
+                                     CPU_INT16U             nbr)
+{
+    CPU_INT08U  req[PROBE_COM_RX_MAX_SIZE];
+    CPU_INT16U  len;
+    CPU_INT16U  off;
+    CPU_INT16U  i;
+
+
+    len = ProbeSim_ReqItems(req, PROBE_SIM_FMT_MULTIPLE_RD, DEF_NO, 0, pitem, nbr);
+    if (ProbeSim_Req(req, len, DEF_NO, &Rsp) != DEF_OK) {
+        return (0);
+    }
+    if (Rsp.Data[2] == PROBE_SIM_STATUS_OK) {
+        off = 4;
+        for (i = 0; i < nbr; i++) {
+            if (memcmp(&Rsp.Data[off], pitem[i].DataPtr, pitem[i].Len) != 0) {
+                return (0);
+            }
+            off += pitem[i].Len;
+        }
+        if (off != Rsp.Len) {
+            return (0);
+        }
+    }
+    return (Rsp.Data[2]);
+}
+
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                            Test_TraceRx()
+*
+* Description : Store each chunk of the trace buffer the host decodes & request the next (see Note #4).
+*********************************************************************************************************
+*/
+
+static  void  Test_TraceRx (PROBE_SIM_PKT  *ppkt)
+{
+    CPU_INT08U  req[8];
+    CPU_INT16U  len;
+
+
+    if ((TraceActive == DEF_NO) ||
+        (ProbeSim_GetINT16U(&ppkt->Data[0]) != (PROBE_SIM_FMT_SIMPLE_RD | PROBE_SIM_FMT_TX))) {
+        return;
+    }
+    len = ppkt->Len - 4;
+    if ((ppkt->Data[2] != PROBE_SIM_STATUS_OK) || (TraceOff + len > TRACE_LEN)) {
+        TraceErrCtr++;
+        TraceActive = DEF_NO;
+        return;
+    }
+    memcpy(&HostTrace[TraceOff], &ppkt->Data[4], len);
+    TraceOff += len;
+    TraceRdCtr++;
+    if (TraceOff < TRACE_LEN) {
+        len = (TRACE_LEN - TraceOff < TraceChunk) ? (TRACE_LEN - TraceOff) : TraceChunk;
+        (void)Test_SimpleRdReq(req, TraceOff, len);
+        ProbeSim_HostTx(req, sizeof(req), DEF_NO);
+    } else {
+        TraceEnd_ns = ppkt->Time_ns;
+        TraceActive = DEF_NO;
+    }
+}
+
+
+/*
+*********************************************************************************************************
+*                                             Test_Trace()
+*
+* Description : Read the trace buffer (the first TRACE_LEN bytes of Mem[]) in reads of up to 'chunk' bytes
+*               & print the round trips, the bytes on the line & the time taken (see Note #4).
+*
+* Return(s)   : Round trips, or 0 if the copy is wrong.
+*********************************************************************************************************
+*/
+
+static  CPU_INT32U  Test_Trace (CPU_INT16U  chunk,
+                                CPU_INT32U  host_lat_us)
+{
+    PROBE_SIM_STAT       stat;
+    CPU_INT08U           req[8];
+    unsigned  long long  start;
+    CPU_INT32U           ms;
+
+
+    ProbeSim_Cfg(PROBE_SIM_MODE_TDRE, 0, host_lat_us);
+    memset(HostTrace, 0, sizeof(HostTrace));
+    TraceOff    = 0;
+    TraceChunk  = chunk;
+    TraceRdCtr  = 0;
+    TraceErrCtr = 0;
+    TraceActive = DEF_YES;
+    ProbeSim_StatClr();
+    start       = ProbeSim_TimeNs();
+    (void)Test_SimpleRdReq(req, 0, (chunk < TRACE_LEN) ? chunk : TRACE_LEN);
+    ProbeSim_HostTx(req, sizeof(req), DEF_NO);
+    for (ms = 0; (ms < 2000) && (TraceActive == DEF_YES); ms++) {
+        ProbeSim_Run(1);
+    }
+    ProbeSim_StatGet(&stat);
+    ProbeSim_Cfg(PROBE_SIM_MODE_TDRE, 0, 0);
+
+    if ((TraceActive == DEF_YES) || (TraceErrCtr > 0) || (memcmp(HostTrace, Mem, TRACE_LEN) != 0)) {
+        TraceActive = DEF_NO;
+        return (0);
+    }
+    printf("%u-byte trace, %4u-byte reads, host latency %4lu us: %2lu round trips, %4lu B on the line, %3lu ms\n",
+           (unsigned)TRACE_LEN, (unsigned)((chunk < TRACE_LEN) ? chunk : TRACE_LEN), (unsigned long)host_lat_us,
+           (unsigned long)TraceRdCtr, (unsigned long)(stat.TxByteCtr + stat.RxByteCtr),
+           (unsigned long)((TraceEnd_ns - start + 500000) / 1000000));
+    return (TraceRdCtr);
+}
+
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                             TestTask()
+*********************************************************************************************************
+*/
+
+static  void  TestTask (void *p_arg)
+{
+    static  const  CPU_INT16U  rd_len[] = {1, CHUNK_LEN, CHUNK_LEN + 1, 255, 1000, 2048, RD_MAX_SIZE - 4};
+    static  const  CPU_INT08U  req_max_tx[4] = {PROBE_SIM_FMT_QUERY & 0xFF, PROBE_SIM_FMT_QUERY >> 8,
+                                                PROBE_SIM_QUERY_MAX_TX_SIZE & 0xFF, PROBE_SIM_QUERY_MAX_TX_SIZE >> 8};
+    PROBE_SIM_ITEM             item[ITEM_NBR];
+    PROBE_SIM_ITEM             mixed[ITEM_NBR];
+    CPU_INT08U                 status;
+    CPU_INT16U                 nbr;
+#if (PROBE_COM_SUPPORT_SG == DEF_TRUE)
+    CPU_INT16U                 mixed_nbr;
+#endif
+    CPU_INT16U                 i;
+
+
+    (void)p_arg;
+    ProbeSim_Init();
+    ProbeCom_Init();
+    ProbeRS232_Init(115200);
+    ProbeRS232_RxIntEn();
+    ProbeSim_HndlrSet(Test_TraceRx);
+
+    for (i = 0; i < MEM_SIZE; i++) {
+        Mem[i] = (CPU_INT08U)(i * 31 + (i >> 8));
+    }
+
+                                                                /* See Note #2.                                         */
+    TEST_CHK(ProbeSim_Req(req_max_tx, sizeof(req_max_tx), DEF_NO, &Rsp) == DEF_OK);
+#if (PROBE_COM_SUPPORT_SG == DEF_TRUE)
+    TEST_CHK(ProbeSim_GetINT16U(&Rsp.Data[4]) == PROBE_COM_SG_MAX_SIZE);
+#else
+    TEST_CHK(ProbeSim_GetINT16U(&Rsp.Data[4]) == PROBE_COM_TX_MAX_SIZE);
+#endif
+    for (i = 0; i < sizeof(rd_len) / sizeof(rd_len[0]); i++) {
+        status = Test_Rd(7, rd_len[i], DEF_NO);
+#if (PROBE_COM_SUPPORT_SG == DEF_TRUE)
+        TEST_CHK(status == PROBE_SIM_STATUS_OK);
+#else
+        TEST_CHK(status == ((rd_len[i] <= CHUNK_LEN) ? PROBE_SIM_STATUS_OK : PROBE_SIM_STATUS_TOO_LARGE));
+#endif
+    }
+    TEST_CHK(Test_Rd(0, RD_MAX_SIZE - 3,           DEF_NO) == PROBE_SIM_STATUS_TOO_LARGE);
+    TEST_CHK(Test_Rd(0, CHUNK_LEN,                 DEF_YES) == PROBE_SIM_STATUS_OK);
+    TEST_CHK(Test_Rd(0, CHUNK_LEN + 1,             DEF_YES) == PROBE_SIM_STATUS_TOO_LARGE);
+
+    for (i = 0; i < ITEM_NBR; i++) {                            /* See Note #3.                                         */
+        item[i].DataPtr  = (void *)&Mem[i * ITEM_LEN];
+        item[i].Len      = ITEM_LEN;
+    }
+    status = Test_MultipleRd(item, ITEM_NBR);
+#if (PROBE_COM_SUPPORT_SG == DEF_TRUE)
+    TEST_CHK(status == PROBE_SIM_STATUS_OK);
+#else
+    TEST_CHK(status == PROBE_SIM_STATUS_TOO_LARGE);
+#endif
+
+    for (i = 0; i < ITEM_NBR; i++) {
+        item[i].DataPtr  = (void *)&Mem[i * (ITEM_LEN + 100)];
+        mixed[i].DataPtr = (void *)&Mem[(i / 2) * (ITEM_LEN + 100)];
+        mixed[i].Len     = ((i % 2) == 0) ? ITEM_LEN : 0;       /* Every other item empty.                              */
+    }
+#if (PROBE_COM_SUPPORT_SG == DEF_TRUE)
+    nbr = (PROBE_COM_SG_SEG_NBR - 1 < ITEM_NBR) ? (PROBE_COM_SG_SEG_NBR - 1) : ITEM_NBR;
+    TEST_CHK(Test_MultipleRd(item,  nbr)     == PROBE_SIM_STATUS_OK);
+    mixed_nbr = (nbr * 2 < ITEM_NBR) ? (nbr * 2) : ITEM_NBR;
+    TEST_CHK(Test_MultipleRd(mixed, mixed_nbr) == PROBE_SIM_STATUS_OK);
+    if (nbr < ITEM_NBR) {
+        TEST_CHK(Test_MultipleRd(item, nbr + 1) == PROBE_SIM_STATUS_TOO_LARGE);
+    }
+#else
+    nbr = 2;
+    TEST_CHK(Test_MultipleRd(item,  nbr)     == PROBE_SIM_STATUS_TOO_LARGE);
+    TEST_CHK(Test_MultipleRd(mixed, nbr * 2) == PROBE_SIM_STATUS_TOO_LARGE);
+#endif
+    for (i = 0; i < 4; i++) {                                   /* Small rd's fit, scattered or not.                    */
+        item[i].Len = CHUNK_LEN / 4;
+    }
+    TEST_CHK(Test_MultipleRd(item, 4) == PROBE_SIM_STATUS_OK);
+
+                                                                /* See Note #4.                                         */
+    TEST_CHK(Test_Trace(CHUNK_LEN, 0)    == (TRACE_LEN + CHUNK_LEN - 1) / CHUNK_LEN);
+    TEST_CHK(Test_Trace(CHUNK_LEN, 1000) == (TRACE_LEN + CHUNK_LEN - 1) / CHUNK_LEN);
+#if (PROBE_COM_SUPPORT_SG == DEF_TRUE)
+    TEST_CHK(Test_Trace(TRACE_LEN, 0)    == 1);
+    TEST_CHK(Test_Trace(TRACE_LEN, 1000) == 1);
+#endif
+
+#if   (PROBE_COM_SUPPORT_SG == DEF_FALSE)
+    Test_Done("test_probe_sg (PROBE_COM_SUPPORT_SG DEF_FALSE)");
+#elif (PROBE_COM_SG_SEG_NBR == 4)
+    Test_Done("test_probe_sg (PROBE_COM_SG_SEG_NBR 4)");
+#else
+    Test_Done("test_probe_sg (PROBE_COM_SG_SEG_NBR 13)");
+#endif
+}
+
+
+int  main (void)
+{
+    OSInit();
+    (void)OSTaskCreateExt(TestTask,
+                          (void *)0,
+                          &TestTaskStk[TEST_TASK_STK_SIZE - 1],
+                          TEST_TASK_PRIO,
+                          TEST_TASK_PRIO,
+                          &TestTaskStk[0],
+                          TEST_TASK_STK_SIZE,
+                          (void *)0,
+                          OS_TASK_OPT_NONE);
+    OSStart();
+    return (0);
+}
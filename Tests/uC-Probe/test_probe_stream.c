@@ -0,0 +1,337 @@
+/*
+*********************************************************************************************************
+*                                             HOST TESTS
+*
+*                                   uC/Probe Symbol Streaming over RS-232
+*
+* Filename      : test_probe_stream.c
+* Note(s)       : (1) probe_com.c & probe_rs232.c at 115200 baud on the simulated SCI of 'probe_sim.c'.  The
+*                     host decodes every frame from the line & checks each snapshot: the sequence number
+*                     MUST have no gap, & the data MUST be what the streamed variables held when it was
+*                     taken.  The test sets each variable to the tick before each tick is run, so a
+*                     snapshot taken on the tick with timestamp 'ts' holds 'ts - 1', one taken later in the
+*                     tick, after a request, 'ts'.
+*
+*                 (2) Below the line rate, a snapshot MUST leave every 'period' ms to the ms.  Above it,
+*                     the stream MUST keep the line busy: at least 95% of the snapshots a saturated line
+*                     carries, with the periods missed counted in ProbeRS232_StreamSkipCtr.
+*
+*                 (3) MULTIPLE_RD requests sent while the stream runs MUST all be answered, with the
+*                     snapshots still leaving every period.
+*
+*                 (4) A set of 9 symbols, a set too large for the TX buffer & a malformed set are rejected
+*                     & MUST leave the running stream as it was; a period of 0 stops it.
+*********************************************************************************************************
+*/
+
+#include  <includes.h>
+#include  <probe_com.h>
+#include  <probe_rs232.h>
+#include  "probe_sim.h"
+
+
+/*
+*********************************************************************************************************
+*                                            LOCAL DEFINES
+*********************************************************************************************************
+*/
+
+#define  VAR_NBR                           4
+#define  RUN_MS                         1000
+#define  RD_NBR                           50
+
+#define  SNAP_LEN             (10 + VAR_NBR * 4)                /* Hdr, seq & timestamp, then the data.                 */
+
+
+/*
+*********************************************************************************************************
+*                                        LOCAL GLOBAL VARIABLES
+*********************************************************************************************************
+*/
+
+static  OS_STK          TestTaskStk[TEST_TASK_STK_SIZE];
+
+static  CPU_INT32U      AppVar[VAR_NBR];                        /* Streamed variables (see Note #1).                    */
+static  CPU_INT32U      AppCfg[VAR_NBR] = {0x11111111, 0x22222222, 0x33333333, 0x44444444};
+
+static  CPU_INT16U      SnapPeriod;                             /* Period in force, to check the timestamps.            */
+static  CPU_BOOLEAN     SnapDataChk;                            /* AppVar[] is being set every tick.                    */
+static  CPU_INT32U      SnapCtr;
+static  CPU_INT32U      SnapSeqErrCtr;
+static  CPU_INT32U      SnapTsErrCtr;
+static  CPU_INT32U      SnapDataErrCtr;
+static  CPU_INT16U      SnapSeq;
+static  CPU_INT32U      SnapTs;
+
+static  PROBE_SIM_PKT   Rsp;
+
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                            Test_SnapRx()
+*
+* Description : Check each snapshot the host decodes (see Note #1).
+*********************************************************************************************************
+*/
+
+static  void  Test_SnapRx (PROBE_SIM_PKT  *ppkt)
+{
+    CPU_INT16U  seq;
+    CPU_INT32U  ts;
+    CPU_INT32U  val;
+    CPU_INT08U  i;
+
+
+    if (ProbeSim_GetINT16U(&ppkt->Data[0]) != PROBE_SIM_FMT_STREAM_DATA) {
+        return;
+    }
+    seq = ProbeSim_GetINT16U(&ppkt->Data[4]);
+    ts  = ProbeSim_GetINT32U(&ppkt->Data[6]);
+    if ((ppkt->Len != SNAP_LEN) || (ppkt->Data[2] != PROBE_SIM_STATUS_OK)) {
+        SnapDataErrCtr++;
+        return;
+    }
+    if (SnapCtr > 0) {
+        if (seq != (CPU_INT16U)(SnapSeq + 1)) {
+            SnapSeqErrCtr++;
+        }
+        if ((ts - SnapTs) < SnapPeriod) {                       /* Never early; exactly on time below the line rate.    */
+            SnapTsErrCtr++;
+        }
+    }
+    for (i = 0; i < VAR_NBR; i++) {
+        val = ProbeSim_GetINT32U(&ppkt->Data[10 + 4 * i]);
+        if ((SnapDataChk == DEF_YES) && (val != ts - 1) && (val != ts)) {
+            SnapDataErrCtr++;
+        }
+        if (val != ProbeSim_GetINT32U(&ppkt->Data[10])) {       /* All from the same instant.                           */
+            SnapDataErrCtr++;
+        }
+    }
+    SnapSeq = seq;
+    SnapTs  = ts;
+    SnapCtr++;
+}
+
+
+/*
+*********************************************************************************************************
+*                                           Test_SnapClr()
+*
+* Description : Start checking the snapshots afresh, e.g. after a new set restarted the sequence number.
+*********************************************************************************************************
+*/
+
+static  void  Test_SnapClr (CPU_INT16U  period)
+{
+    SnapPeriod     = period;
+    SnapCtr        = 0;
+    SnapSeqErrCtr  = 0;
+    SnapTsErrCtr   = 0;
+    SnapDataErrCtr = 0;
+}
+
+
+/*
+*********************************************************************************************************
+*                                             Test_Run()
+*
+* Description : Run 'ms' ticks, setting the streamed variables to the tick before each (see Note #1).
+*********************************************************************************************************
+*/
+
+static  void  Test_Run (CPU_INT32U  ms)
+{
+    CPU_INT08U  i;
+
+
+    SnapDataChk = DEF_YES;
+    while (ms > 0) {
+        for (i = 0; i < VAR_NBR; i++) {
+            AppVar[i] = OSTimeGet();
+        }
+        ProbeSim_Run(1);
+        ms--;
+    }
+    SnapDataChk = DEF_NO;
+}
+
+
+/*
+*********************************************************************************************************
+*                                           Test_StreamCfg()
+*
+* Description : Configure the stream with the first 'nbr' items of a table & return the response status.
+*********************************************************************************************************
+*/
+
+static  CPU_INT08U  Test_StreamCfg (CPU_INT16U             period,
+                                    const PROBE_SIM_ITEM  *pitem,
+                                    CPU_INT16U             nbr)
+{
+    CPU_INT08U  req[PROBE_COM_RX_MAX_SIZE];
+    CPU_INT16U  len;
+
+
+    len = ProbeSim_ReqItems(req, PROBE_SIM_FMT_STREAM_CFG, DEF_YES, period, pitem, nbr);
+    if (ProbeSim_Req(req, len, DEF_NO, &Rsp) != DEF_OK) {
+        return (0);
+    }
+    return (Rsp.Data[2]);
+}
+
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                            Test_Rate()
+*
+* Description : Stream the variables for RUN_MS at 'period' & print the rate against the line (see Note #2).
+*********************************************************************************************************
+*/
+
+static  void  Test_Rate (CPU_INT16U             period,
+                         const PROBE_SIM_ITEM  *pitem)
+{
+    PROBE_SIM_STAT  stat;
+    CPU_INT32U      skip;
+    CPU_INT32U      frame_ns;
+    CPU_INT32U      ceil;
+    CPU_INT32U      exp;
+
+
+    TEST_CHK(Test_StreamCfg(period, pitem, VAR_NBR) == PROBE_SIM_STATUS_OK);
+    Test_Run(period + 5);                                       /* Let the stream settle.                               */
+    Test_SnapClr(period);
+    skip           = ProbeRS232_StreamSkipCtr;
+    ProbeSim_StatClr();
+    Test_Run(RUN_MS);
+    ProbeSim_StatGet(&stat);
+    skip           = ProbeRS232_StreamSkipCtr - skip;
+
+    frame_ns = (8 + SNAP_LEN + 2) * ProbeSim_ByteNs();
+    ceil     = (1000000000uL + frame_ns / 2) / frame_ns;
+    exp      = RUN_MS / period;
+    printf("period %2u ms: %3lu snapshots/s, %3lu skipped, line %3lu%% busy, %3lu/s on a saturated line\n",
+           (unsigned)period, (unsigned long)SnapCtr, (unsigned long)skip,
+           (unsigned long)((unsigned long long)stat.TxByteCtr * ProbeSim_ByteNs() / (RUN_MS * 10000uLL)),
+           (unsigned long)ceil);
+
+    TEST_CHK(SnapSeqErrCtr  == 0);
+    TEST_CHK(SnapDataErrCtr == 0);
+    TEST_CHK(stat.PktErrCtr == 0);
+    if (exp < ceil) {                                           /* Below the line rate.                                 */
+        TEST_CHK((SnapCtr >= exp - 1) && (SnapCtr <= exp + 1));
+        TEST_CHK(SnapTsErrCtr == 0);
+        TEST_CHK(skip == 0);
+    } else {                                                    /* Line saturated.                                      */
+        TEST_CHK(SnapCtr * 100 >= ceil * 95);
+        TEST_CHK(SnapCtr <= ceil + 1);
+        TEST_CHK(skip > 0);
+    }
+}
+
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                             TestTask()
+*********************************************************************************************************
+*/
+
+static  void  TestTask (void *p_arg)
+{
+    PROBE_SIM_ITEM  item[9];
+    PROBE_SIM_ITEM  big[VAR_NBR];
+    CPU_INT08U      req[PROBE_COM_RX_MAX_SIZE];
+    CPU_INT16U      len;
+    CPU_INT32U      snap_ctr;
+    CPU_INT32U      ok;
+    CPU_INT08U      i;
+
+
+    (void)p_arg;
+    ProbeSim_Init();
+    ProbeCom_Init();
+    ProbeRS232_Init(115200);
+    ProbeRS232_RxIntEn();
+    ProbeSim_HndlrSet(Test_SnapRx);
+
+    for (i = 0; i < 9; i++) {
+        item[i].DataPtr = (void *)&AppVar[i % VAR_NBR];
+        item[i].Len     = 4;
+    }
+    for (i = 0; i < VAR_NBR; i++) {
+        big[i].DataPtr  = (void *)&AppVar[i];
+        big[i].Len      = 14;                                   /* 10 + 56 bytes > PROBE_COM_TX_MAX_SIZE.               */
+    }
+
+    TEST_CHK(ProbeSim_FmtSupport(PROBE_SIM_FMT_STREAM_CFG) == DEF_YES);
+
+    Test_Rate(10, item);                                        /* See Note #2.                                         */
+    Test_Rate( 5, item);
+    Test_Rate( 2, item);
+    Test_Rate( 1, item);
+
+    TEST_CHK(Test_StreamCfg(10, item, VAR_NBR) == PROBE_SIM_STATUS_OK);
+    Test_Run(20);
+    Test_SnapClr(10);                                           /* See Note #3.                                         */
+    snap_ctr   = SnapCtr;
+    ok         = 0;
+    for (i = 0; i < RD_NBR; i++) {
+        len = ProbeSim_ReqItems(req, PROBE_SIM_FMT_MULTIPLE_RD, DEF_NO, 0, &item[0], 1);
+        AppVar[0] = 0x5A000000 + i;
+        if ((ProbeSim_Req(req, len, DEF_NO, &Rsp) == DEF_OK)            &&
+            (Rsp.Data[2] == PROBE_SIM_STATUS_OK)                        &&
+            (ProbeSim_GetINT32U(&Rsp.Data[4]) == 0x5A000000uL + i)) {
+            ok++;
+        }
+        AppVar[0] = OSTimeGet();
+    }
+    printf("stream at 10 ms: %lu/%u MULTIPLE_RD answered, %lu snapshots meanwhile\n",
+           (unsigned long)ok, (unsigned)RD_NBR, (unsigned long)(SnapCtr - snap_ctr));
+    TEST_CHK(ok == RD_NBR);
+    TEST_CHK(SnapSeqErrCtr == 0);
+    TEST_CHK(SnapTsErrCtr  == 0);
+
+    for (i = 0; i < VAR_NBR; i++) {                             /* See Note #4.                                         */
+        item[i].DataPtr = (void *)&AppCfg[i];
+    }
+    TEST_CHK(Test_StreamCfg(10, item, 9)       == PROBE_SIM_STATUS_TOO_LARGE);
+    TEST_CHK(Test_StreamCfg(10, big,  VAR_NBR) == PROBE_SIM_STATUS_TOO_LARGE);
+    len = ProbeSim_ReqItems(req, PROBE_SIM_FMT_STREAM_CFG, DEF_YES, 10, &item[0], 1) - 1;
+    TEST_CHK((ProbeSim_Req(req, len, DEF_NO, &Rsp) == DEF_OK) && (Rsp.Data[2] == PROBE_SIM_STATUS_WRONG_SIZE));
+    TEST_CHK(Test_StreamCfg(10, item, 0)       == PROBE_SIM_STATUS_WRONG_SIZE);
+    snap_ctr       = SnapCtr;
+    SnapDataErrCtr = 0;
+    Test_Run(100);
+    TEST_CHK(SnapCtr - snap_ctr >= 9);                          /* Still streaming AppVar[], not AppCfg[].              */
+    TEST_CHK(SnapDataErrCtr == 0);
+    TEST_CHK(SnapSeqErrCtr  == 0);
+
+    TEST_CHK(Test_StreamCfg(0, item, 0) == PROBE_SIM_STATUS_OK);
+    snap_ctr = SnapCtr;
+    Test_Run(100);
+    TEST_CHK(SnapCtr == snap_ctr);
+    TEST_CHK(ProbeCom_StreamPeriodGet() == 0);
+
+    Test_Done("test_probe_stream");
+}
+
+
+int  main (void)
+{
+    OSInit();
+    (void)OSTaskCreateExt(TestTask,
+                          (void *)0,
+                          &TestTaskStk[TEST_TASK_STK_SIZE - 1],
+                          TEST_TASK_PRIO,
+                          TEST_TASK_PRIO,
+                          &TestTaskStk[0],
+                          TEST_TASK_STK_SIZE,
+                          (void *)0,
+                          OS_TASK_OPT_NONE);
+    OSStart();
+    return (0);
+}
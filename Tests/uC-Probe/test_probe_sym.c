@@ -0,0 +1,338 @@
+/*
+*********************************************************************************************************
+*                                             HOST TESTS
+*
+*                                      uC/Probe Symbol Directory
+*
+* Filename      : test_probe_sym.c
+* Note(s)       : (1) probe_com.c with the directory that 'probe_com_sym.py' generates from
+*                     'test_probe_sym.lst', queried through ProbeCom_ParseRxPkt().  Built with 1 KiB
+*                     packets (test_probe_sym), with the 64-byte packets of the Dragon12 (test_probe_sym_64)
+*                     & with PROBE_COM_SUPPORT_SYM DEF_FALSE (test_probe_sym_off).
+*
+*                 (2) The table MUST be sorted by hash, with no two entries alike, & each hash MUST be the
+*                     FNV-1a hash of the name listed, computed here as a host would.
+*
+*                 (3) A SYM_LOOKUP MUST answer {address, size, type} for each hash, in request order, in one
+*                     response; an unknown name MUST be answered with address 0, size 0 & type NONE.  A
+*                     request that is not a whole number of hashes MUST be refused with WRONG_SIZE, & one
+*                     with more hashes than fit the response with TOO_LARGE.
+*
+*                 (4) ProbeCom_SymFind() time per lookup, for the table & an unknown name.
+*********************************************************************************************************
+*/
+
+#include  <includes.h>
+#include  <probe_com.h>
+#include  "test_probe_sym.h"
+
+
+/*
+*********************************************************************************************************
+*                                            LOCAL DEFINES
+*********************************************************************************************************
+*/
+
+#define  FMT_QUERY                    0x0001
+#define  FMT_SYM_LOOKUP               0x0010
+#define  FMT_TX                       0x8000
+#define  QUERY_FMT_SUPPORT            0x1001
+
+#define  STATUS_OK                      0x01
+#define  STATUS_UNKNOWN_REQUEST         0xF9
+#define  STATUS_TX_PKT_TOO_LARGE        0xFD
+#define  STATUS_RX_PKT_WRONG_SIZE       0xFE
+
+                                                                /* Most hashes answered in one response.                */
+#define  LOOKUP_MAX        (((PROBE_COM_TX_MAX_SIZE - 4) / 8 < (PROBE_COM_RX_MAX_SIZE - 2) / 4) ? \
+                             ((PROBE_COM_TX_MAX_SIZE - 4) / 8) : ((PROBE_COM_RX_MAX_SIZE - 2) / 4))
+
+#define  BENCH_NBR                    1000000
+
+
+/*
+*********************************************************************************************************
+*                                           LOCAL DATA TYPES
+*********************************************************************************************************
+*/
+
+typedef  struct  test_sym {                                     /* A symbol of 'test_probe_sym.lst', as a host sees it. */
+    const  char      *Name;
+    void             *AddrPtr;
+    CPU_INT16U        Size;
+    CPU_INT08U        Type;
+} TEST_SYM;
+
+
+/*
+*********************************************************************************************************
+*                                        LOCAL GLOBAL VARIABLES
+*********************************************************************************************************
+*/
+
+CPU_INT32U   AppTick    = 0x12345678;
+CPU_INT16S   AppTemp    = -42;
+CPU_FP32     AppGain    = 1.5f;
+CPU_BOOLEAN  AppRunning = DEF_TRUE;
+APP_DATA     AppData    = {1234, 987654, 3};
+CPU_CHAR     AppName[12] = "Dragon12";
+CPU_INT32U   AppFill[APP_FILL_NBR];
+
+static  const  TEST_SYM  TestSymTbl[] = {
+    {"AppTick",       &AppTick,       sizeof(AppTick),       PROBE_COM_SYM_TYPE_INT32U},
+    {"AppTemp",       &AppTemp,       sizeof(AppTemp),       PROBE_COM_SYM_TYPE_INT16S},
+    {"AppGain",       &AppGain,       sizeof(AppGain),       PROBE_COM_SYM_TYPE_FP32},
+    {"AppRunning",    &AppRunning,    sizeof(AppRunning),    PROBE_COM_SYM_TYPE_BOOLEAN},
+    {"AppData",       &AppData,       sizeof(AppData),       PROBE_COM_SYM_TYPE_BLOB},
+    {"AppData.Speed", &AppData.Speed, sizeof(AppData.Speed), PROBE_COM_SYM_TYPE_INT16U},
+    {"AppData.Odo",   &AppData.Odo,   sizeof(AppData.Odo),   PROBE_COM_SYM_TYPE_INT32U},
+    {"AppData.Gear",  &AppData.Gear,  sizeof(AppData.Gear),  PROBE_COM_SYM_TYPE_INT08U},
+    {"AppName",       &AppName,       sizeof(AppName),       PROBE_COM_SYM_TYPE_CHAR},
+    {"NoSuchSym",     (void *)0,      0,                     PROBE_COM_SYM_TYPE_NONE}     /* Not listed.           */
+};
+
+#define  TEST_SYM_NBR              (sizeof(TestSymTbl) / sizeof(TestSymTbl[0]))
+
+static  CPU_INT08U  Req[PROBE_COM_RX_MAX_SIZE];
+static  CPU_INT08U  Rsp[PROBE_COM_TX_MAX_SIZE];
+
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                             Test_Hash()
+*
+* Description : Return the 32-bit FNV-1a hash of a symbol name, as a host computes it (see Note #2).
+*********************************************************************************************************
+*/
+
+static  CPU_INT32U  Test_Hash (const char  *pname)
+{
+    CPU_INT32U  hash;
+
+
+    hash = 0x811C9DC5uL;
+    while (*pname != '\0') {
+        hash ^= (CPU_INT08U)*pname++;
+        hash *= 0x01000193uL;
+    }
+    return (hash);
+}
+
+
+/*
+*********************************************************************************************************
+*                                           Test_GetINT16U()
+*                                           Test_GetINT32U()
+*
+* Description : Read a little-endian word.
+*********************************************************************************************************
+*/
+
+static  CPU_INT16U  Test_GetINT16U (const CPU_INT08U  *p)
+{
+    return ((CPU_INT16U)(p[0] | (p[1] << 8)));
+}
+
+
+#if (PROBE_COM_SUPPORT_SYM == DEF_TRUE)
+static  CPU_INT32U  Test_GetINT32U (const CPU_INT08U  *p)
+{
+    return ((CPU_INT32U)p[0] | ((CPU_INT32U)p[1] << 8) | ((CPU_INT32U)p[2] << 16) | ((CPU_INT32U)p[3] << 24));
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                            Test_Lookup()
+*
+* Description : Send a SYM_LOOKUP of the names given.
+*
+* Argument(s) : pname           Names to look up.
+*
+*               nbr             Number of names.
+*
+* Return(s)   : Length of the response, in Rsp[].
+*********************************************************************************************************
+*/
+
+static  CPU_INT16U  Test_Lookup (const char  * const  *pname,
+                                 CPU_INT16U           nbr)
+{
+    CPU_INT32U  hash;
+    CPU_INT16U  ix;
+    CPU_INT16U  i;
+
+
+    Req[0] = (CPU_INT08U)(FMT_SYM_LOOKUP);
+    Req[1] = (CPU_INT08U)(FMT_SYM_LOOKUP >> 8);
+    ix     = 2;
+    for (i = 0; i < nbr; i++) {
+        hash      = Test_Hash(pname[i]);
+        Req[ix++] = (CPU_INT08U)(hash);
+        Req[ix++] = (CPU_INT08U)(hash >>  8);
+        Req[ix++] = (CPU_INT08U)(hash >> 16);
+        Req[ix++] = (CPU_INT08U)(hash >> 24);
+    }
+    return (ProbeCom_ParseRxPkt((void *)Req, (void *)Rsp, ix, PROBE_COM_TX_MAX_SIZE));
+}
+
+
+#if (PROBE_COM_SUPPORT_SYM == DEF_TRUE)
+/*
+*********************************************************************************************************
+*                                            Test_SymChk()
+*
+* Description : Check the descriptor of response entry 'i' against a symbol.
+*********************************************************************************************************
+*/
+
+static  CPU_BOOLEAN  Test_SymChk (CPU_INT16U   i,
+                                  void        *paddr,
+                                  CPU_INT16U   size,
+                                  CPU_INT08U   type)
+{
+    const  CPU_INT08U  *pdesc;
+
+
+    pdesc = &Rsp[4 + 8 * i];
+    if ((Test_GetINT32U(&pdesc[0]) != (CPU_INT32U)(unsigned long)paddr) ||
+        (Test_GetINT16U(&pdesc[4]) != size) ||
+        (pdesc[6]                  != type)) {
+        return (DEF_FAIL);
+    }
+    return (DEF_OK);
+}
+#endif
+
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                              main()
+*********************************************************************************************************
+*/
+
+int  main (void)
+{
+    static  const  CPU_INT08U  fmt_req[4] = {FMT_QUERY         & 0xFF, FMT_QUERY         >> 8,
+                                             QUERY_FMT_SUPPORT & 0xFF, QUERY_FMT_SUPPORT >> 8};
+    char                       fill_name[APP_FILL_NBR][16];
+    const  char               *pname[TEST_SYM_NBR + APP_FILL_NBR];
+    CPU_BOOLEAN                listed;
+    CPU_INT16U                 len;
+    CPU_INT16U                 i;
+#if (PROBE_COM_SUPPORT_SYM == DEF_TRUE)
+    CPU_INT16U                 nbr;
+    CPU_INT16U                 j;
+    CPU_INT32U                 hash;
+    CPU_INT32U                 n;
+    CPU_BOOLEAN                sorted;
+    CPU_BOOLEAN                found;
+    const  char               *prep[LOOKUP_MAX + 1];
+    unsigned  long  long       t;
+    volatile  CPU_INT16U       sink;
+#endif
+
+
+    ProbeCom_Init();
+    for (i = 0; i < APP_FILL_NBR; i++) {
+        AppFill[i] = 0xF0000000uL + i;
+        (void)snprintf(fill_name[i], sizeof(fill_name[i]), "AppFill[%u]", (unsigned)i);
+    }
+
+    len    = ProbeCom_ParseRxPkt((void *)fmt_req, (void *)Rsp, sizeof(fmt_req), PROBE_COM_TX_MAX_SIZE);
+    listed = DEF_NO;
+    for (i = 4; i + 1 < len; i += 2) {
+        if (Test_GetINT16U(&Rsp[i]) == FMT_SYM_LOOKUP) {
+            listed = DEF_YES;
+        }
+    }
+
+#if (PROBE_COM_SUPPORT_SYM == DEF_TRUE)
+    TEST_CHK(listed == DEF_YES);
+                                                                /* See Note #2.                                         */
+    TEST_CHK(ProbeCom_SymTblNbr == TEST_SYM_NBR - 1 + APP_FILL_NBR);
+    sorted = DEF_YES;
+    for (i = 1; i < ProbeCom_SymTblNbr; i++) {
+        if (ProbeCom_SymTbl[i].NameHash <= ProbeCom_SymTbl[i - 1].NameHash) {
+            sorted = DEF_NO;
+        }
+    }
+    TEST_CHK(sorted == DEF_YES);
+    for (i = 0; i < TEST_SYM_NBR + APP_FILL_NBR; i++) {
+        pname[i] = (i < TEST_SYM_NBR) ? TestSymTbl[i].Name : fill_name[i - TEST_SYM_NBR];
+    }
+    for (i = 0; i < TEST_SYM_NBR + APP_FILL_NBR; i++) {
+        hash  = Test_Hash(pname[i]);
+        found = DEF_NO;
+        for (j = 0; j < ProbeCom_SymTblNbr; j++) {
+            if (ProbeCom_SymTbl[j].NameHash == hash) {
+                found = DEF_YES;
+            }
+        }
+        TEST_CHK(found == ((i == TEST_SYM_NBR - 1) ? DEF_NO : DEF_YES));
+    }
+
+                                                                /* See Note #3.                                         */
+    for (i = 0; i < TEST_SYM_NBR; i += nbr) {                   /* Named syms & an unknown name.                        */
+        nbr = (TEST_SYM_NBR - i < LOOKUP_MAX) ? (CPU_INT16U)(TEST_SYM_NBR - i) : (CPU_INT16U)LOOKUP_MAX;
+        len = Test_Lookup(&pname[i], nbr);
+        TEST_CHK((len == 4 + 8 * nbr) && (Test_GetINT16U(&Rsp[0]) == (FMT_SYM_LOOKUP | FMT_TX)) && (Rsp[2] == STATUS_OK));
+        for (j = 0; j < nbr; j++) {
+            TEST_CHK(Test_SymChk(j, TestSymTbl[i + j].AddrPtr, TestSymTbl[i + j].Size, TestSymTbl[i + j].Type) == DEF_OK);
+        }
+    }
+    for (i = 0; i < APP_FILL_NBR; i += nbr) {                   /* Every array element, in as few requests as fit.      */
+        nbr = (APP_FILL_NBR - i < LOOKUP_MAX) ? (CPU_INT16U)(APP_FILL_NBR - i) : (CPU_INT16U)LOOKUP_MAX;
+        len = Test_Lookup(&pname[TEST_SYM_NBR + i], nbr);
+        TEST_CHK((len == 4 + 8 * nbr) && (Rsp[2] == STATUS_OK));
+        for (j = 0; j < nbr; j++) {
+            TEST_CHK(Test_SymChk(j, &AppFill[i + j], sizeof(AppFill[0]), PROBE_COM_SYM_TYPE_INT32U) == DEF_OK);
+            TEST_CHK(*(CPU_INT32U *)(unsigned long)Test_GetINT32U(&Rsp[4 + 8 * j]) == 0xF0000000uL + i + j);
+        }
+    }
+    printf("%u syms, %u per lookup with %u-byte packets\n",
+           (unsigned)ProbeCom_SymTblNbr, (unsigned)LOOKUP_MAX, (unsigned)PROBE_COM_TX_MAX_SIZE);
+
+    len = Test_Lookup(pname, 0);                                /* No hash.                                             */
+    TEST_CHK((len == 4) && (Rsp[2] == STATUS_RX_PKT_WRONG_SIZE));
+    (void)Test_Lookup(pname, 1);                                /* Not a whole nbr of hashes.                           */
+    len = ProbeCom_ParseRxPkt((void *)Req, (void *)Rsp, 7, PROBE_COM_TX_MAX_SIZE);
+    TEST_CHK((len == 4) && (Rsp[2] == STATUS_RX_PKT_WRONG_SIZE));
+    if (2 + 4 * (LOOKUP_MAX + 1) <= PROBE_COM_RX_MAX_SIZE) {    /* One hash more than fits the response.                */
+        for (i = 0; i < LOOKUP_MAX + 1; i++) {
+            prep[i] = pname[TEST_SYM_NBR + (i % APP_FILL_NBR)];
+        }
+        len = Test_Lookup(prep, LOOKUP_MAX + 1);
+        TEST_CHK((len == 4) && (Rsp[2] == STATUS_TX_PKT_TOO_LARGE));
+    }
+
+    for (i = 0; i < 2; i++) {                                   /* See Note #4.                                         */
+        hash = Test_Hash((i == 0) ? "AppFill[17]" : "NoSuchSym");
+        sink = 0;
+        t    = Test_TimeNs();
+        for (n = 0; n < BENCH_NBR; n++) {
+            Req[2] = (CPU_INT08U)(hash);
+            Req[3] = (CPU_INT08U)(hash >>  8);
+            Req[4] = (CPU_INT08U)(hash >> 16);
+            Req[5] = (CPU_INT08U)(hash >> 24);
+            sink  += ProbeCom_ParseRxPkt((void *)Req, (void *)Rsp, 6, PROBE_COM_TX_MAX_SIZE);
+        }
+        t    = Test_TimeNs() - t;
+        printf("lookup of %-12s %5.1f ns per request of 1 hash, %u syms\n",
+               (i == 0) ? "a listed sym:" : "an unknown:", (double)t / BENCH_NBR, (unsigned)ProbeCom_SymTblNbr);
+    }
+
+    Test_Done("test_probe_sym (PROBE_COM_SUPPORT_SYM DEF_TRUE)");
+#else
+    TEST_CHK(listed == DEF_NO);
+    pname[0] = TestSymTbl[0].Name;
+    len      = Test_Lookup(pname, 1);
+    TEST_CHK((len == 4) && (Rsp[2] == STATUS_UNKNOWN_REQUEST));
+
+    Test_Done("test_probe_sym (PROBE_COM_SUPPORT_SYM DEF_FALSE)");
+#endif
+    return (0);
+}
@@ -0,0 +1,53 @@
+/*
+*********************************************************************************************************
+*                                             HOST TESTS
+*
+*                                      uC/Probe Symbol Directory
+*
+* Filename      : test_probe_sym.h
+* Note(s)       : (1) The application symbols of 'test_probe_sym.lst', defined in 'test_probe_sym.c'.
+*********************************************************************************************************
+*/
+
+#ifndef  TEST_PROBE_SYM_H
+#define  TEST_PROBE_SYM_H
+
+
+/*
+*********************************************************************************************************
+*                                               DEFINES
+*********************************************************************************************************
+*/
+
+#define  APP_FILL_NBR                     64
+
+
+/*
+*********************************************************************************************************
+*                                              DATA TYPES
+*********************************************************************************************************
+*/
+
+typedef  struct  app_data {
+    CPU_INT16U  Speed;
+    CPU_INT32U  Odo;
+    CPU_INT08U  Gear;
+} APP_DATA;
+
+
+/*
+*********************************************************************************************************
+*                                           GLOBAL VARIABLES
+*********************************************************************************************************
+*/
+
+extern  CPU_INT32U   AppTick;
+extern  CPU_INT16S   AppTemp;
+extern  CPU_FP32     AppGain;
+extern  CPU_BOOLEAN  AppRunning;
+extern  APP_DATA     AppData;
+extern  CPU_CHAR     AppName[12];
+extern  CPU_INT32U   AppFill[APP_FILL_NBR];
+
+
+#endif
@@ -0,0 +1,314 @@
+/*
+*********************************************************************************************************
+*                                             HOST TESTS
+*
+*                                   uC/Probe Lock-Free Telemetry Pool
+*
+* Filename      : test_probe_tel.c
+* Note(s)       : (1) PROD_NBR host threads each commit SAMPLE_NBR telemetry samples, alternately through
+*                     ProbeCom_TelemetryReserve()/_Commit() & through ProbeCom_TxTelemetry(), while the main
+*                     thread parses TELEMETRY_GET requests with ProbeCom_ParseRxPkt(), as the Probe task
+*                     would.  Built with the default PROBE_COM_ATOMIC_LD/ST/CAS, in critical
+*                     sections (test_probe_tel_crit), & with the GCC atomic builtins (test_probe_tel_atomic),
+*                     also with a pool of one buffer (test_probe_tel_atomic_nbr1).
+*
+*                 (2) Every sample has its own length & data pattern, & its sequence number as timestamp.
+*                     Every sample committed MUST be received once, intact, in commit order per producer;
+*                     a buffer sent in several responses MUST NOT be interleaved with another.  Every sample
+*                     not committed MUST be counted in ProbeCom_TelemetryDropCtr, & every buffer MUST be
+*                     back on the free stack at the end.
+*
+*                 (3) Run twice: with producers that retry a sample the pool had no buffer for, & a TX
+*                     buffer that splits a telemetry buffer over 4 responses; then with producers that drop
+*                     it & yield after each sample, & a TX buffer that holds a whole telemetry buffer.
+*
+*                 (4) Also built with '-fsanitize=thread' (test_probe_tel_atomic_tsan), which reports any
+*                     access to a buffer that the reserve/commit & the tagged free stack do not order.
+*********************************************************************************************************
+*/
+
+#include  <includes.h>
+#include  <probe_com.h>
+#include  <pthread.h>
+#include  <sched.h>
+
+
+/*
+*********************************************************************************************************
+*                                            LOCAL DEFINES
+*********************************************************************************************************
+*/
+
+#define  PROD_NBR                          4
+
+#ifdef   __SANITIZE_THREAD__
+#define  SAMPLE_NBR                    20000                    /* ThreadSanitizer runs ~10x slower.                    */
+#else
+#define  SAMPLE_NBR                   200000
+#endif
+
+#define  FMT_TELEMETRY_GET            0x000B
+#define  FMT_TX                       0x8000
+#define  STATUS_TELEMETRY_NONE          0xF7
+
+#define  RSP_HDR_SIZE                     16                    /* Hdr, ID, timestamp, buf len & data len.              */
+
+
+/*
+*********************************************************************************************************
+*                                           LOCAL DATA TYPES
+*********************************************************************************************************
+*/
+
+typedef  struct  test_prod {                                    /* Results of one producer.                             */
+    CPU_INT32U  NbrSent;
+    CPU_INT32U  NbrDrop;
+} TEST_PROD;
+
+
+/*
+*********************************************************************************************************
+*                                        LOCAL GLOBAL VARIABLES
+*********************************************************************************************************
+*/
+
+static  TEST_PROD             Prod[PROD_NBR];
+static  CPU_BOOLEAN           ProdRetry;
+static  volatile  CPU_INT32U  ProdDoneCtr;
+
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                            Test_Pat()
+*                                            Test_Len()
+*
+* Description : Data byte 'i' & length of sample 'seq' of producer 'id' (see Note #2).
+*********************************************************************************************************
+*/
+
+static  CPU_INT08U  Test_Pat (CPU_INT32U  id,
+                              CPU_INT32U  seq,
+                              CPU_INT32U  i)
+{
+    return ((CPU_INT08U)(id * 131 + seq * 7 + i * 13));
+}
+
+
+static  CPU_INT16U  Test_Len (CPU_INT32U  seq)
+{
+    return ((CPU_INT16U)(seq % (PROBE_COM_TELEMETRY_BUF_LEN + 1)));
+}
+
+
+/*
+*********************************************************************************************************
+*                                            ProdThread()
+*
+* Description : Producer of Note #1.
+*********************************************************************************************************
+*/
+
+static  void  *ProdThread (void *p_arg)
+{
+    PROBE_COM_TELEMETRY_BUF  *pbuf;
+    CPU_INT08U                data[PROBE_COM_TELEMETRY_BUF_LEN];
+    CPU_INT32U                id;
+    CPU_INT32U                seq;
+    CPU_INT16U                len;
+    CPU_INT16U                i;
+    CPU_BOOLEAN               ok;
+
+
+    id  = (CPU_INT32U)(unsigned long)p_arg;
+    seq = 0;
+    while (seq < SAMPLE_NBR) {
+        len = Test_Len(seq);
+        if ((seq & 1) != 0) {                                   /* Fill in place ...                                    */
+            pbuf = ProbeCom_TelemetryReserve();
+            ok   = (pbuf != (PROBE_COM_TELEMETRY_BUF *)0) ? DEF_OK : DEF_FAIL;
+            if (ok == DEF_OK) {
+                for (i = 0; i < len; i++) {
+                    pbuf->Buf[i] = Test_Pat(id, seq, i);
+                }
+                ProbeCom_TelemetryCommit(pbuf, id, len, seq);
+            }
+        } else {                                                /* ... or copy.                                         */
+            for (i = 0; i < len; i++) {
+                data[i] = Test_Pat(id, seq, i);
+            }
+            ok = ProbeCom_TxTelemetry(id, (void *)data, len, seq);
+        }
+        if (ok == DEF_OK) {
+            Prod[id].NbrSent++;
+            seq++;
+        } else {
+            Prod[id].NbrDrop++;
+            if (ProdRetry == DEF_YES) {
+                (void)sched_yield();
+            } else {
+                seq++;
+            }
+        }
+        if (ProdRetry == DEF_NO) {                              /* Let the consumer run on a single core.               */
+            (void)sched_yield();
+        }
+    }
+    (void)__atomic_add_fetch(&ProdDoneCtr, 1, __ATOMIC_RELEASE);
+    return ((void *)0);
+}
+
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                              Test_Run()
+*
+* Description : Run the producers against the consumer once (see Notes #2 & #3).
+*
+* Argument(s) : retry           DEF_YES if the producers retry a sample the pool had no buffer for.
+*
+*               tx_size         Size of the TX buffer passed to ProbeCom_ParseRxPkt().
+*********************************************************************************************************
+*/
+
+static  void  Test_Run (CPU_BOOLEAN  retry,
+                        CPU_INT16U   tx_size)
+{
+    static  const  CPU_INT08U  req[4] = {FMT_TELEMETRY_GET & 0xFF, FMT_TELEMETRY_GET >> 8, 0, 0};
+    pthread_t                  th[PROD_NBR];
+    CPU_INT08U                 rsp[RSP_HDR_SIZE + PROBE_COM_TELEMETRY_BUF_LEN];
+    CPU_INT32U                 seq_next[PROD_NBR];
+    CPU_INT32U                 rx_ctr[PROD_NBR];
+    CPU_INT32U                 drop_ctr;
+    CPU_INT32U                 drop_sum;
+    CPU_INT32U                 sent_sum;
+    CPU_INT32U                 pkt_ctr;
+    CPU_INT32U                 err_ctr;
+    CPU_INT32U                 cur_id;
+    CPU_INT32U                 cur_seq;
+    CPU_INT16U                 cur_len;
+    CPU_INT16U                 cur_ix;
+    CPU_INT32U                 id;
+    CPU_INT32U                 seq;
+    CPU_INT16U                 size;
+    CPU_INT16U                 len;
+    CPU_INT16U                 n;
+    CPU_INT16U                 i;
+    CPU_BOOLEAN                done;
+    unsigned  long  long       t;
+
+
+    Mem_Clr((void *)Prod,     sizeof(Prod));
+    Mem_Clr((void *)seq_next, sizeof(seq_next));
+    Mem_Clr((void *)rx_ctr,   sizeof(rx_ctr));
+    ProdRetry   = retry;
+    ProdDoneCtr = 0;
+    drop_ctr    = ProbeCom_TelemetryDropCtr;
+    pkt_ctr     = 0;
+    err_ctr     = 0;
+    cur_id      = PROD_NBR;                                     /* No buffer in progress.                               */
+    cur_seq     = 0;
+    cur_len     = 0;
+    cur_ix      = 0;
+
+    t = Test_TimeNs();
+    for (id = 0; id < PROD_NBR; id++) {
+        TEST_CHK(pthread_create(&th[id], NULL, ProdThread, (void *)(unsigned long)id) == 0);
+    }
+    while (DEF_TRUE) {
+        done = (__atomic_load_n(&ProdDoneCtr, __ATOMIC_ACQUIRE) == PROD_NBR) ? DEF_YES : DEF_NO;
+        n    = ProbeCom_ParseRxPkt((void *)req, (void *)rsp, sizeof(req), tx_size);
+        pkt_ctr++;
+        if (rsp[2] == STATUS_TELEMETRY_NONE) {
+            if (done == DEF_YES) {                              /* Every commit precedes this empty response.           */
+                break;
+            }
+            (void)sched_yield();
+            continue;
+        }
+        id   = (CPU_INT32U)rsp[4] | ((CPU_INT32U)rsp[5] << 8) | ((CPU_INT32U)rsp[6]  << 16) | ((CPU_INT32U)rsp[7]  << 24);
+        seq  = (CPU_INT32U)rsp[8] | ((CPU_INT32U)rsp[9] << 8) | ((CPU_INT32U)rsp[10] << 16) | ((CPU_INT32U)rsp[11] << 24);
+        size = (CPU_INT16U)(rsp[12] | (rsp[13] << 8));
+        len  = (CPU_INT16U)(rsp[14] | (rsp[15] << 8));
+        if ((rsp[0] != (CPU_INT08U)(FMT_TELEMETRY_GET | FMT_TX)) || (rsp[1] != (CPU_INT08U)((FMT_TELEMETRY_GET | FMT_TX) >> 8)) ||
+            (n != RSP_HDR_SIZE + len) || (id >= PROD_NBR)) {
+            err_ctr++;
+            break;
+        }
+        if (cur_id == PROD_NBR) {                               /* First response of a buffer: in order?                */
+            if ((seq < seq_next[id]) || (size != Test_Len(seq))) {
+                err_ctr++;
+            }
+            seq_next[id] = seq + 1;
+            cur_id       = id;
+            cur_seq      = seq;
+            cur_len      = size;
+            cur_ix       = 0;
+        } else if ((id != cur_id) || (seq != cur_seq) || (size != cur_len)) {
+            err_ctr++;                                          /* Interleaved with another buffer.                     */
+        }
+        for (i = 0; i < len; i++) {
+            if (rsp[RSP_HDR_SIZE + i] != Test_Pat(id, seq, cur_ix + i)) {
+                err_ctr++;
+                break;
+            }
+        }
+        cur_ix += len;
+        if (cur_ix >= cur_len) {
+            rx_ctr[id]++;
+            cur_id = PROD_NBR;
+        }
+    }
+    for (id = 0; id < PROD_NBR; id++) {
+        TEST_CHK(pthread_join(th[id], NULL) == 0);
+    }
+    t = Test_TimeNs() - t;
+
+    sent_sum = 0;
+    drop_sum = 0;
+    for (id = 0; id < PROD_NBR; id++) {
+        TEST_CHK(rx_ctr[id] == Prod[id].NbrSent);
+        if (retry == DEF_YES) {
+            TEST_CHK(Prod[id].NbrSent == SAMPLE_NBR);
+        } else {
+            TEST_CHK(Prod[id].NbrSent + Prod[id].NbrDrop == SAMPLE_NBR);
+        }
+        sent_sum += Prod[id].NbrSent;
+        drop_sum += Prod[id].NbrDrop;
+    }
+    TEST_CHK(err_ctr == 0);
+    TEST_CHK(cur_id  == PROD_NBR);
+    TEST_CHK(ProbeCom_TelemetryDropCtr - drop_ctr == drop_sum);
+
+    printf("%u producers, %u bufs, %s, TX %3u B: %lu committed, %lu dropped, %lu rsp, %.2f M samples/s\n",
+           (unsigned)PROD_NBR, (unsigned)PROBE_COM_TELEMETRY_NBR, (retry == DEF_YES) ? "retry" : "drop ",
+           (unsigned)tx_size, (unsigned long)sent_sum, (unsigned long)drop_sum, (unsigned long)pkt_ctr,
+           (double)(sent_sum + drop_sum) * 1000.0 / (double)t);
+}
+
+
+/*$PAGE*/
+int  main (void)
+{
+    CPU_INT32U  free_ctr;
+
+
+    ProbeCom_Init();
+
+    Test_Run(DEF_YES, RSP_HDR_SIZE + PROBE_COM_TELEMETRY_BUF_LEN / 4);
+    Test_Run(DEF_NO,  RSP_HDR_SIZE + PROBE_COM_TELEMETRY_BUF_LEN);
+
+    free_ctr = 0;                                               /* Every buffer back on the free stack.                 */
+    while (ProbeCom_TelemetryReserve() != (PROBE_COM_TELEMETRY_BUF *)0) {
+        free_ctr++;
+    }
+    TEST_CHK(free_ctr == PROBE_COM_TELEMETRY_NBR);
+
+#ifdef   PROBE_COM_ATOMIC_GCC
+    Test_Done("test_probe_tel (PROBE_COM_ATOMIC_GCC)");
+#else
+    Test_Done("test_probe_tel (critical sections)");
+#endif
+    return (0);
+}
@@ -0,0 +1,287 @@
+/*
+*********************************************************************************************************
+*                                             HOST TESTS
+*
+*                              uC/Probe RS-232 Transmit: TDRE against TC
+*
+* Filename      : test_probe_tx.c
+* Note(s)       : (1) probe_com.c & probe_rs232.c at 115200 baud on the simulated SCI of 'probe_sim.c', with
+*                     the TX interrupt raised on TDRE, as the MC9S12 port now does, & on TC, as it did
+*                     before, each 0, 4 & 10 us after the condition.
+*
+*                 (2) A stream of 74-byte frames (one 54-byte item) every 1 ms saturates the line.  With
+*                     TDRE the next byte is loaded while the current one shifts out: the line MUST NOT go
+*                     idle within a frame & MUST carry 1 / (74 byte times) frames per second.  With TC it
+*                     idles for the interrupt latency after every byte.
+*
+*                 (3) The host then polls the same item with MULTIPLE_RD, sending each request as soon as
+*                     the previous response is decoded.
+*
+*                 (4) In every case each frame MUST decode with the data intact, & no byte may be written
+*                     over a full data register.
+*********************************************************************************************************
+*/
+
+#include  <includes.h>
+#include  <probe_com.h>
+#include  <probe_rs232.h>
+#include  "probe_sim.h"
+
+
+/*
+*********************************************************************************************************
+*                                            LOCAL DEFINES
+*********************************************************************************************************
+*/
+
+#define  RUN_MS                         1000
+#define  ITEM_LEN                         54
+
+#define  SNAP_LEN                (10 + ITEM_LEN)                /* Hdr, seq & timestamp, then the data.                 */
+#define  FRAME_LEN             (8 + SNAP_LEN + 2)               /* 74 bytes framed.                                     */
+
+
+/*
+*********************************************************************************************************
+*                                        LOCAL GLOBAL VARIABLES
+*********************************************************************************************************
+*/
+
+static  OS_STK          TestTaskStk[TEST_TASK_STK_SIZE];
+
+static  CPU_INT08U      AppBuf[ITEM_LEN];
+
+static  CPU_INT32U      SnapCtr;
+static  CPU_INT32U      PollCtr;
+static  CPU_INT32U      DataErrCtr;
+static  CPU_BOOLEAN     PollEn;                                 /* Send the next request from the handler.              */
+static  CPU_INT08U      PollReq[PROBE_COM_RX_MAX_SIZE];
+static  CPU_INT16U      PollReqLen;
+
+static  PROBE_SIM_PKT   Rsp;
+
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                             Test_Rx()
+*
+* Description : Check each frame the host decodes; send the next poll (see Notes #3 & #4).
+*********************************************************************************************************
+*/
+
+static  void  Test_Rx (PROBE_SIM_PKT  *ppkt)
+{
+    CPU_INT16U  fmt;
+
+
+    fmt = ProbeSim_GetINT16U(&ppkt->Data[0]);
+    if (fmt == PROBE_SIM_FMT_STREAM_DATA) {
+        if ((ppkt->Len != SNAP_LEN) || (memcmp(&ppkt->Data[10], AppBuf, ITEM_LEN) != 0)) {
+            DataErrCtr++;
+        }
+        SnapCtr++;
+    } else if ((fmt == (PROBE_SIM_FMT_MULTIPLE_RD | PROBE_SIM_FMT_TX)) && (PollEn == DEF_YES)) {
+        if ((ppkt->Len != 4 + ITEM_LEN) || (memcmp(&ppkt->Data[4], AppBuf, ITEM_LEN) != 0)) {
+            DataErrCtr++;
+        }
+        PollCtr++;
+        ProbeSim_HostTx(PollReq, PollReqLen, DEF_NO);
+    }
+}
+
+
+/*
+*********************************************************************************************************
+*                                             Test_Pct()
+*
+* Description : Return the share of the time the line was busy within frames, in 0.1 %.
+*********************************************************************************************************
+*/
+
+static  CPU_INT32U  Test_Pct (const PROBE_SIM_STAT  *pstat)
+{
+    unsigned  long long  busy;
+
+
+    busy = (unsigned long long)pstat->TxByteCtr * ProbeSim_ByteNs();
+    return ((CPU_INT32U)((busy * 1000 + (busy + pstat->TxIdle_ns) / 2) / (busy + pstat->TxIdle_ns)));
+}
+
+
+/*
+*********************************************************************************************************
+*                                           Test_IdleChk()
+*
+* Description : Check that the line idled for the TC interrupt latency after each byte within a frame, give
+*               or take the frame cut by the start or the end of the measure (see Note #2).
+*********************************************************************************************************
+*/
+
+static  CPU_BOOLEAN  Test_IdleChk (const PROBE_SIM_STAT  *pstat,
+                                   CPU_INT32U             isr_ns)
+{
+    unsigned  long long  exp;
+
+
+    exp = (unsigned long long)(pstat->TxByteCtr - pstat->PktCtr) * isr_ns;
+    if ((pstat->TxIdle_ns + (unsigned long long)FRAME_LEN * isr_ns < exp) ||
+        (pstat->TxIdle_ns > exp + (unsigned long long)FRAME_LEN * isr_ns)) {
+        return (DEF_FAIL);
+    }
+    return (DEF_OK);
+}
+
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                             Test_Tx()
+*
+* Description : Stream, then poll, for RUN_MS each with the TX interrupt raised in 'mode', 'isr_ns' late.
+*
+* Argument(s) : mode            PROBE_SIM_MODE_TDRE or PROBE_SIM_MODE_TC.
+*
+*               isr_ns          Latency of the TX interrupt, in ns.
+*
+*               pitem           The item streamed & polled.
+*
+*               ppoll_ctr       Returns the polls answered.
+*
+* Return(s)   : Snapshots decoded.
+*********************************************************************************************************
+*/
+
+static  CPU_INT32U  Test_Tx (CPU_INT08U             mode,
+                             CPU_INT32U             isr_ns,
+                             const PROBE_SIM_ITEM  *pitem,
+                             CPU_INT32U            *ppoll_ctr)
+{
+    PROBE_SIM_STAT  snap_stat;
+    PROBE_SIM_STAT  poll_stat;
+    CPU_INT08U      req[PROBE_COM_RX_MAX_SIZE];
+    CPU_INT16U      len;
+    CPU_INT32U      snap_ctr;
+    CPU_INT32U      poll_ctr;
+    CPU_INT32U      snap_pct;
+    CPU_INT32U      poll_pct;
+
+
+    ProbeSim_Cfg(mode, isr_ns, 0);
+    DataErrCtr = 0;
+
+    len = ProbeSim_ReqItems(req, PROBE_SIM_FMT_STREAM_CFG, DEF_YES, 1, pitem, 1);
+    TEST_CHK((ProbeSim_Req(req, len, DEF_NO, &Rsp) == DEF_OK) && (Rsp.Data[2] == PROBE_SIM_STATUS_OK));
+    ProbeSim_Run(10);                                           /* Let the stream settle.                               */
+    SnapCtr = 0;
+    ProbeSim_StatClr();
+    ProbeSim_Run(RUN_MS);                                       /* See Note #2.                                         */
+    ProbeSim_StatGet(&snap_stat);
+    snap_ctr = SnapCtr;
+    len = ProbeSim_ReqItems(req, PROBE_SIM_FMT_STREAM_CFG, DEF_YES, 0, pitem, 0);
+    TEST_CHK((ProbeSim_Req(req, len, DEF_NO, &Rsp) == DEF_OK) && (Rsp.Data[2] == PROBE_SIM_STATUS_OK));
+    ProbeSim_Run(10);
+
+    PollReqLen = ProbeSim_ReqItems(PollReq, PROBE_SIM_FMT_MULTIPLE_RD, DEF_NO, 0, pitem, 1);
+    PollCtr    = 0;
+    PollEn     = DEF_YES;
+    ProbeSim_StatClr();
+    ProbeSim_HostTx(PollReq, PollReqLen, DEF_NO);               /* See Note #3.                                         */
+    ProbeSim_Run(RUN_MS);
+    ProbeSim_StatGet(&poll_stat);
+    PollEn     = DEF_NO;
+    ProbeSim_Run(10);                                           /* Drain the last poll.                                 */
+    poll_ctr   = PollCtr;
+
+    snap_pct = Test_Pct(&snap_stat);
+    poll_pct = Test_Pct(&poll_stat);
+    printf("%-4s isr %2lu us: stream %3lu frames/s, %3lu.%lu%% of wire; polls %3lu/s, %3lu.%lu%% of wire\n",
+           (mode == PROBE_SIM_MODE_TDRE) ? "TDRE" : "TC", (unsigned long)(isr_ns / 1000),
+           (unsigned long)snap_ctr, (unsigned long)(snap_pct / 10), (unsigned long)(snap_pct % 10),
+           (unsigned long)poll_ctr, (unsigned long)(poll_pct / 10), (unsigned long)(poll_pct % 10));
+
+    TEST_CHK(DataErrCtr          == 0);                         /* See Note #4.                                         */
+    TEST_CHK(snap_stat.PktErrCtr == 0);
+    TEST_CHK(poll_stat.PktErrCtr == 0);
+    TEST_CHK(snap_stat.TxOvrCtr  == 0);
+    TEST_CHK(poll_stat.TxOvrCtr  == 0);
+    TEST_CHK(poll_ctr            >  0);
+    if (mode == PROBE_SIM_MODE_TDRE) {                          /* See Note #2.                                         */
+        TEST_CHK(snap_stat.TxIdle_ns == 0);
+        TEST_CHK(poll_stat.TxIdle_ns == 0);
+    } else {                                                    /* The latency after each byte but the last of a frame, */
+        TEST_CHK(Test_IdleChk(&snap_stat, isr_ns) == DEF_OK);   /* ... give or take the frame cut by the window.        */
+        TEST_CHK(Test_IdleChk(&poll_stat, isr_ns) == DEF_OK);
+    }
+    *ppoll_ctr = poll_ctr;
+    return (snap_ctr);
+}
+
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                             TestTask()
+*********************************************************************************************************
+*/
+
+static  void  TestTask (void *p_arg)
+{
+    static  const  CPU_INT32U  isr_ns[] = {0, 4000, 10000};
+    PROBE_SIM_ITEM             item;
+    CPU_INT32U                 ceil;
+    CPU_INT32U                 tdre_snap;
+    CPU_INT32U                 tdre_poll;
+    CPU_INT32U                 tc_snap;
+    CPU_INT32U                 tc_poll;
+    CPU_INT32U                 tc_ceil;
+    CPU_INT08U                 i;
+
+
+    (void)p_arg;
+    ProbeSim_Init();
+    ProbeCom_Init();
+    ProbeRS232_Init(115200);
+    ProbeRS232_RxIntEn();
+    ProbeSim_HndlrSet(Test_Rx);
+
+    for (i = 0; i < ITEM_LEN; i++) {
+        AppBuf[i] = (CPU_INT08U)(0xA5 ^ (i * 7));
+    }
+    item.DataPtr = (void *)&AppBuf[0];
+    item.Len     = ITEM_LEN;
+    ceil         = (1000000000uL + FRAME_LEN * ProbeSim_ByteNs() / 2) / (FRAME_LEN * ProbeSim_ByteNs());
+    printf("%u-byte frames: %lu/s on a saturated line\n", (unsigned)FRAME_LEN, (unsigned long)ceil);
+
+    for (i = 0; i < sizeof(isr_ns) / sizeof(isr_ns[0]); i++) {
+        tdre_snap = Test_Tx(PROBE_SIM_MODE_TDRE, isr_ns[i], &item, &tdre_poll);
+        tc_snap   = Test_Tx(PROBE_SIM_MODE_TC,   isr_ns[i], &item, &tc_poll);
+        tc_ceil   = 1000000000uL / (FRAME_LEN * (ProbeSim_ByteNs() + isr_ns[i]));
+
+        TEST_CHK((tdre_snap + 1 >= ceil) && (tdre_snap <= ceil + 1));
+        TEST_CHK((tc_snap   + 1 >= tc_ceil) && (tc_snap <= tc_ceil + 1));
+        if (isr_ns[i] > 0) {
+            TEST_CHK(tdre_snap > tc_snap);
+            TEST_CHK(tdre_poll > tc_poll);
+        }
+    }
+
+    Test_Done("test_probe_tx");
+}
+
+
+int  main (void)
+{
+    OSInit();
+    (void)OSTaskCreateExt(TestTask,
+                          (void *)0,
+                          &TestTaskStk[TEST_TASK_STK_SIZE - 1],
+                          TEST_TASK_PRIO,
+                          TEST_TASK_PRIO,
+                          &TestTaskStk[0],
+                          TEST_TASK_STK_SIZE,
+                          (void *)0,
+                          OS_TASK_OPT_NONE);
+    OSStart();
+    return (0);
+}
@@ -0,0 +1,428 @@
+/*
+*********************************************************************************************************
+*                                             HOST TESTS
+*
+*                                        uC/Probe UDP Transport
+*
+* Filename      : test_probe_udp.c
+* Note(s)       : (1) probe_com.c & probe_tcpip.c with the POSIX socket port ('Ports/POSIX/probe_tcpipc.c') &
+*                     the POSIX OS layer ('OS/POSIX/probe_tcpip_os.c'), with 1 KiB packets.  The test plays
+*                     the host over a UDP socket on the loopback interface.
+*
+*                 (2) Each datagram MUST carry one packet with the RS-232 header & no footer.  A datagram
+*                     that is short, has a bad start delimiter or a length that does not match MUST be
+*                     dropped silently & counted in ProbeTCPIP_RxDropCtr; one larger than the RX buffer is
+*                     dropped by the port.  The target MUST keep answering afterwards.
+*
+*                 (3) A 10 ms stream MUST deliver 100 snapshots a second, in sequence, to the sender of the
+*                     last datagram.  The first is due at once & the last receive may end past the second,
+*                     so up to 102 are counted in the second.
+*
+*                 (4) The host keeps 1 or 4 requests in flight for RUN_MS & compares the polls per second
+*                     with the RS-232 ceiling at 115200 baud with 64-byte packets.
+*********************************************************************************************************
+*/
+
+#include  <includes.h>
+#include  <probe_com.h>
+#include  <probe_tcpip.h>
+
+#include  <sys/types.h>
+#include  <sys/socket.h>
+#include  <netinet/in.h>
+#include  <arpa/inet.h>
+#include  <poll.h>
+#include  <unistd.h>
+
+
+/*
+*********************************************************************************************************
+*                                            LOCAL DEFINES
+*********************************************************************************************************
+*/
+
+#define  RUN_MS                         1000
+#define  RX_TMO_MS                       100
+
+#define  RD_LEN                         1016                    /* Largest SIMPLE_RD in one 1 KiB response.             */
+#define  SYM_NBR                           3
+
+#define  RS232_BYTE_NS                 86806                    /* 10 bits at 115200 baud.                              */
+#define  RS232_DATA_MAX                   60                    /* Data per 64-byte RS-232 response.                    */
+
+#define  FMT_QUERY                    0x0001
+#define  FMT_SIMPLE_RD                0x0002
+#define  FMT_MULTIPLE_RD              0x0007
+#define  FMT_STREAM_CFG               0x000C
+#define  FMT_STREAM_DATA              0x800D
+#define  FMT_TX                       0x8000
+#define  QUERY_FMT_SUPPORT            0x1001
+#define  STATUS_OK                      0x01
+
+
+/*
+*********************************************************************************************************
+*                                        LOCAL GLOBAL VARIABLES
+*********************************************************************************************************
+*/
+
+static  CPU_INT32U      AppSym[SYM_NBR] = {0x01234567, 0x89ABCDEF, 0x5A5AA5A5};
+static  CPU_INT08U      AppBuf[RD_LEN];
+
+static  int             HostSock;
+static  CPU_INT08U      HostRxBuf[2048];
+static  CPU_INT32U      HostFrameErrCtr;                        /* Datagrams from the target with a bad hdr.            */
+
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                          Test_GetINT16U()
+*
+* Description : Read a little-endian 16-bit word.
+*********************************************************************************************************
+*/
+
+static  CPU_INT16U  Test_GetINT16U (const CPU_INT08U  *p)
+{
+    return ((CPU_INT16U)(p[0] | (p[1] << 8)));
+}
+
+
+/*
+*********************************************************************************************************
+*                                            Test_TxRaw()
+*
+* Description : Send one datagram to the target, as is.
+*********************************************************************************************************
+*/
+
+static  void  Test_TxRaw (const void  *p,
+                          CPU_INT16U   len)
+{
+    (void)send(HostSock, p, len, 0);
+}
+
+
+/*
+*********************************************************************************************************
+*                                              Test_Tx()
+*
+* Description : Send one packet to the target, with the header (see Note #2).
+*********************************************************************************************************
+*/
+
+static  void  Test_Tx (const CPU_INT08U  *pdata,
+                       CPU_INT16U         len)
+{
+    CPU_INT08U  pkt[2048];
+
+
+    pkt[0] = 'u';
+    pkt[1] = 'C';
+    pkt[2] = 'P';
+    pkt[3] = 'r';
+    pkt[4] = (CPU_INT08U)(len);
+    pkt[5] = (CPU_INT08U)(len >> 8);
+    pkt[6] = 0;
+    pkt[7] = 0;
+    memcpy(&pkt[8], pdata, len);
+    Test_TxRaw(pkt, len + 8);
+}
+
+
+/*
+*********************************************************************************************************
+*                                              Test_Rx()
+*
+* Description : Receive one packet from the target.
+*
+* Argument(s) : tmo_ms          Timeout, in ms.
+*
+* Return(s)   : Length of the data segment, at &HostRxBuf[8], or 0 on timeout.
+*********************************************************************************************************
+*/
+
+static  CPU_INT16U  Test_Rx (int  tmo_ms)
+{
+    struct  pollfd  pfd;
+    ssize_t         len;
+
+
+    pfd.fd     = HostSock;
+    pfd.events = POLLIN;
+    if (poll(&pfd, 1, tmo_ms) <= 0) {
+        return (0);
+    }
+    len = recv(HostSock, HostRxBuf, sizeof(HostRxBuf), 0);
+    if ((len < 8) || (memcmp(HostRxBuf, "uCPr", 4) != 0) ||
+        (Test_GetINT16U(&HostRxBuf[4]) != len - 8)) {
+        HostFrameErrCtr++;
+        return (0);
+    }
+    return ((CPU_INT16U)(len - 8));
+}
+
+
+/*
+*********************************************************************************************************
+*                                            Test_Items()
+*
+* Description : Form a request of 'fmt' & a 16-bit word, followed by one item per symbol.
+*
+* Return(s)   : Length of the request.
+*********************************************************************************************************
+*/
+
+static  CPU_INT16U  Test_Items (CPU_INT08U  *preq,
+                                CPU_INT16U   fmt,
+                                CPU_INT16U   word)
+{
+    CPU_INT32U  addr;
+    CPU_INT16U  ix;
+    CPU_INT08U  i;
+
+
+    preq[0] = (CPU_INT08U)(fmt);
+    preq[1] = (CPU_INT08U)(fmt >> 8);
+    preq[2] = (CPU_INT08U)(word);
+    preq[3] = (CPU_INT08U)(word >> 8);
+    ix      = (fmt == FMT_MULTIPLE_RD) ? 2 : 4;
+    for (i = 0; i < SYM_NBR; i++) {
+        addr         = (CPU_INT32U)(unsigned long)&AppSym[i];
+        preq[ix++]   = 4;
+        preq[ix++]   = (CPU_INT08U)(addr);
+        preq[ix++]   = (CPU_INT08U)(addr >>  8);
+        preq[ix++]   = (CPU_INT08U)(addr >> 16);
+        preq[ix++]   = (CPU_INT08U)(addr >> 24);
+    }
+    return (ix);
+}
+
+
+/*
+*********************************************************************************************************
+*                                           Test_SimpleRd()
+*
+* Description : Form a SIMPLE_RD request of 'len' bytes of AppBuf.
+*
+* Return(s)   : Length of the request.
+*********************************************************************************************************
+*/
+
+static  CPU_INT16U  Test_SimpleRd (CPU_INT08U  *preq,
+                                   CPU_INT16U   len)
+{
+    CPU_INT32U  addr;
+
+
+    addr    = (CPU_INT32U)(unsigned long)&AppBuf[0];
+    preq[0] = (CPU_INT08U)(FMT_SIMPLE_RD);
+    preq[1] = (CPU_INT08U)(FMT_SIMPLE_RD >> 8);
+    preq[2] = (CPU_INT08U)(len);
+    preq[3] = (CPU_INT08U)(len >> 8);
+    preq[4] = (CPU_INT08U)(addr);
+    preq[5] = (CPU_INT08U)(addr >>  8);
+    preq[6] = (CPU_INT08U)(addr >> 16);
+    preq[7] = (CPU_INT08U)(addr >> 24);
+    return (8);
+}
+
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                             Test_Poll()
+*
+* Description : Poll for RUN_MS with 'inflight' requests in flight & print the polls per second (see Note #4).
+*
+* Argument(s) : name            Name of the request.
+*
+*               preq            Request.
+*
+*               req_len         Length of the request.
+*
+*               rd_len          Data read by the request.
+*
+*               inflight        Requests in flight.
+*********************************************************************************************************
+*/
+
+static  void  Test_Poll (const char        *name,
+                         const CPU_INT08U  *preq,
+                         CPU_INT16U         req_len,
+                         CPU_INT16U         rd_len,
+                         CPU_INT08U         inflight)
+{
+    unsigned  long  long  t0;
+    unsigned  long  long  t;
+    CPU_INT32U            poll_ctr;
+    CPU_INT32U            lost_ctr;
+    CPU_INT32U            err_ctr;
+    CPU_INT32U            rate;
+    CPU_INT32U            rs232_ceil;
+    CPU_INT32U            chunk_nbr;
+    CPU_INT16U            len;
+    CPU_INT08U            i;
+
+
+    poll_ctr = 0;
+    lost_ctr = 0;
+    err_ctr  = 0;
+    for (i = 0; i < inflight; i++) {
+        Test_Tx(preq, req_len);
+    }
+    t0 = Test_TimeNs();
+    do {
+        len = Test_Rx(RX_TMO_MS);
+        if (len == 0) {                                         /* Lost: refill the requests in flight.                 */
+            lost_ctr += inflight;
+            for (i = 0; i < inflight; i++) {
+                Test_Tx(preq, req_len);
+            }
+        } else {
+            if ((len != 4 + rd_len) || (HostRxBuf[8 + 2] != STATUS_OK)) {
+                err_ctr++;
+            }
+            poll_ctr++;
+            Test_Tx(preq, req_len);
+        }
+        t = Test_TimeNs() - t0;
+    } while (t < (unsigned long long)RUN_MS * 1000000uLL);
+    while (Test_Rx(RX_TMO_MS) > 0) {                            /* Drain the requests in flight.                        */
+        ;
+    }
+
+    rate       = (CPU_INT32U)((unsigned long long)poll_ctr * 1000000000uLL / t);
+    chunk_nbr  = (rd_len + RS232_DATA_MAX - 1) / RS232_DATA_MAX;
+    len        = ((4 + rd_len) < (4 + RS232_DATA_MAX)) ? (4 + rd_len) : (4 + RS232_DATA_MAX);
+    if (len < req_len) {
+        len = req_len;
+    }
+    rs232_ceil = 1000000000uL / (chunk_nbr * (8 + len + 2) * RS232_BYTE_NS);
+    printf("%u in flight, %-18s %6lu polls/s, %6lu KB/s of data (RS-232: %3lu polls/s)\n",
+           (unsigned)inflight, name, (unsigned long)rate,
+           (unsigned long)((unsigned long long)rate * rd_len / 1000), (unsigned long)rs232_ceil);
+
+    TEST_CHK(err_ctr  == 0);
+    TEST_CHK(lost_ctr == 0);
+    TEST_CHK(rate     >  20 * rs232_ceil);
+}
+
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                              main()
+*********************************************************************************************************
+*/
+
+int  main (void)
+{
+    static  const  CPU_INT08U  fmt_req[4] = {FMT_QUERY & 0xFF, FMT_QUERY >> 8, QUERY_FMT_SUPPORT & 0xFF, QUERY_FMT_SUPPORT >> 8};
+    struct  sockaddr_in        addr;
+    CPU_INT08U                 req[64];
+    CPU_INT08U                 bad[1100];
+    CPU_INT16U                 req_len;
+    CPU_INT16U                 len;
+    CPU_INT32U                 drop_ctr;
+    CPU_INT32U                 snap_ctr;
+    CPU_INT32U                 seq_err_ctr;
+    CPU_INT16U                 seq;
+    unsigned  long  long       t0;
+    CPU_INT16U                 i;
+
+
+    for (i = 0; i < RD_LEN; i++) {
+        AppBuf[i] = (CPU_INT08U)(i * 31 + 7);
+    }
+    ProbeCom_Init();
+    ProbeTCPIP_Init();
+
+    HostSock = socket(AF_INET, SOCK_DGRAM, 0);
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family      = AF_INET;
+    addr.sin_port        = htons(PROBE_TCPIP_PORT);
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    TEST_CHK(connect(HostSock, (struct sockaddr *)&addr, sizeof(addr)) == 0);
+
+    Test_Tx(fmt_req, sizeof(fmt_req));
+    len = Test_Rx(500);
+    TEST_CHK((len >= 6) && (Test_GetINT16U(&HostRxBuf[8]) == (FMT_QUERY | FMT_TX)));
+
+    req_len = Test_SimpleRd(req, RD_LEN);                       /* One 1 KiB response in one datagram.                  */
+    Test_Tx(req, req_len);
+    len = Test_Rx(500);
+    TEST_CHK((len == 4 + RD_LEN) && (memcmp(&HostRxBuf[8 + 4], AppBuf, RD_LEN) == 0));
+
+                                                                /* See Note #2.                                         */
+    drop_ctr = ProbeTCPIP_RxDropCtr;
+    Test_TxRaw("uCPr\x01", 5);                                  /* Short.                                               */
+    TEST_CHK(Test_Rx(RX_TMO_MS) == 0);
+    memcpy(bad, "uCPx\x04\x00\x00\x00", 8);                     /* Bad start delimiter.                                 */
+    memcpy(&bad[8], fmt_req, 4);
+    Test_TxRaw(bad, 12);
+    TEST_CHK(Test_Rx(RX_TMO_MS) == 0);
+    bad[3] = 'r';
+    bad[4] = 5;                                                 /* Length too large, ...                                */
+    Test_TxRaw(bad, 12);
+    TEST_CHK(Test_Rx(RX_TMO_MS) == 0);
+    bad[4] = 3;                                                 /* ... too small, ...                                   */
+    Test_TxRaw(bad, 12);
+    TEST_CHK(Test_Rx(RX_TMO_MS) == 0);
+    bad[4] = 0;                                                 /* ... zero.                                            */
+    Test_TxRaw(bad, 8);
+    TEST_CHK(Test_Rx(RX_TMO_MS) == 0);
+    bad[4]  = 4;                                                /* RS-232 footer.                                       */
+    bad[12] = 0;
+    bad[13] = '/';
+    Test_TxRaw(bad, 14);
+    TEST_CHK(Test_Rx(RX_TMO_MS) == 0);
+    TEST_CHK(ProbeTCPIP_RxDropCtr == drop_ctr + 6);
+    memset(&bad[8], 0, sizeof(bad) - 8);                        /* Larger than the RX buf: dropped by the port.         */
+    bad[4] = (CPU_INT08U)((sizeof(bad) - 8));
+    bad[5] = (CPU_INT08U)((sizeof(bad) - 8) >> 8);
+    Test_TxRaw(bad, sizeof(bad));
+    TEST_CHK(Test_Rx(RX_TMO_MS) == 0);
+    Test_Tx(fmt_req, sizeof(fmt_req));
+    TEST_CHK(Test_Rx(500) > 0);
+
+    req_len = Test_Items(req, FMT_STREAM_CFG, 10);              /* See Note #3.                                         */
+    Test_Tx(req, req_len);
+    snap_ctr    = 0;
+    seq_err_ctr = 0;
+    seq         = 0;
+    t0          = Test_TimeNs();
+    while (Test_TimeNs() - t0 < 1000000000uLL) {
+        len = Test_Rx(RX_TMO_MS);
+        if ((len > 0) && (Test_GetINT16U(&HostRxBuf[8]) == FMT_STREAM_DATA)) {
+            if ((len != 10 + 4 * SYM_NBR) || (memcmp(&HostRxBuf[8 + 10], AppSym, sizeof(AppSym)) != 0) ||
+                ((snap_ctr > 0) && (Test_GetINT16U(&HostRxBuf[8 + 4]) != (CPU_INT16U)(seq + 1)))) {
+                seq_err_ctr++;
+            }
+            seq = Test_GetINT16U(&HostRxBuf[8 + 4]);
+            snap_ctr++;
+        }
+    }
+    (void)Test_Items(req, FMT_STREAM_CFG, 0);                   /* Period 0 & no items: stop the stream.                */
+    Test_Tx(req, 4);
+    while (Test_Rx(RX_TMO_MS) > 0) {
+        ;
+    }
+    printf("10 ms stream: %lu snapshots in 1 s\n", (unsigned long)snap_ctr);
+    TEST_CHK((snap_ctr >= 95) && (snap_ctr <= 102));
+    TEST_CHK(seq_err_ctr == 0);
+
+    req_len = Test_Items(req, FMT_MULTIPLE_RD, 0);              /* See Note #4.                                         */
+    Test_Poll("MULTIPLE_RD 3 syms:", req, req_len, 4 * SYM_NBR, 1);
+    req_len = Test_SimpleRd(req, 56);
+    Test_Poll("SIMPLE_RD 56 B:",     req, req_len, 56,          1);
+    req_len = Test_SimpleRd(req, RD_LEN);
+    Test_Poll("SIMPLE_RD 1016 B:",   req, req_len, RD_LEN,      1);
+    Test_Poll("SIMPLE_RD 1016 B:",   req, req_len, RD_LEN,      4);
+
+    TEST_CHK(HostFrameErrCtr == 0);
+    (void)close(HostSock);
+    Test_Done("test_probe_udp");
+    return (0);
+}
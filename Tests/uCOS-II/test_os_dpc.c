@@ -0,0 +1,285 @@
+/*
+*********************************************************************************************************
+*                                             HOST TESTS
+*
+*                                   uC/OS-II Deferred Procedure Calls
+*
+* Filename      : test_os_dpc.c
+* Note(s)       : (1) Deferred calls must run in the DPC task, in the order they were posted, before the
+*                     interrupted task resumes.  Calls posted to a full queue are counted & dropped.
+*
+*                 (2) The interrupt-disabled time is measured by the host port (see 'os_cpu.h  Note #3')
+*                     for an ISR that does its work itself & for one that defers the same work with
+*                     OSDPCPost().  The work stands in for a driver's protocol handling.  The figures are
+*                     host nanoseconds, not target cycles; the ratio is what matters.
+*
+*                 (3) The application may suspend & resume the DPC task.  A post must not undo the
+*                     suspend and a resume with an empty queue must leave the task waiting for a post.
+*********************************************************************************************************
+*/
+
+#include  <includes.h>
+
+
+/*
+*********************************************************************************************************
+*                                            LOCAL DEFINES
+*********************************************************************************************************
+*/
+
+#define  APP_PRIO                         20
+#define  WORK_LOOPS                     2000
+#define  MEAS_NBR_INTS                 20000
+
+
+/*
+*********************************************************************************************************
+*                                        LOCAL GLOBAL VARIABLES
+*********************************************************************************************************
+*/
+
+static  OS_STK            TestTaskStk[TEST_TASK_STK_SIZE];
+static  OS_STK            AppTaskStk[TEST_TASK_STK_SIZE];
+
+static  volatile  INT32U  WorkSum;
+static  INT32U            DPC_Nbr;
+static  INT32U            DPC_ArgLast;
+static  CPU_BOOLEAN       DPC_Ok;
+static  INT32U            DPC_Pending;
+static  INT32U            DPC_SeenPending;
+static  INT32U            ISR_Arg;
+static  INT32U            DPC_CountNbr;
+
+static  double            MeasTotNs[2];
+static  unsigned  long    MeasMaxNs[2];
+
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                          DEFERRED CALLS & ISRs
+*********************************************************************************************************
+*/
+
+static  void  Work (void)
+{
+    INT32U  i;
+
+
+    for (i = 0; i < WORK_LOOPS; i++) {
+        WorkSum += i ^ (WorkSum >> 3);
+    }
+}
+
+
+static  void  OrderDPC (void *p_arg)
+{
+    INT32U  arg;
+
+
+    arg = (INT32U)(CPU_ADDR)p_arg;
+    if ((arg != DPC_ArgLast + 1) || (OSTCBCur->OSTCBPrio != OS_TASK_DPC_PRIO)) {
+        DPC_Ok = DEF_FALSE;
+    }
+    DPC_ArgLast = arg;
+    DPC_Nbr++;
+    DPC_Pending--;
+}
+
+
+static  void  OrderISR (void)                                   /* Posts two calls per interrupt.                       */
+{
+    (void)OSDPCPost(OrderDPC, (void *)(CPU_ADDR)++ISR_Arg);
+    (void)OSDPCPost(OrderDPC, (void *)(CPU_ADDR)++ISR_Arg);
+    DPC_Pending += 2;
+}
+
+
+static  void  FloodISR (void)
+{
+    INT32U  i;
+
+
+    for (i = 0; i < OS_DPC_Q_SIZE + 2; i++) {
+        if (OSDPCPost(OrderDPC, (void *)(CPU_ADDR)++ISR_Arg) == OS_ERR_NONE) {
+            DPC_Pending++;
+        } else {
+            ISR_Arg--;
+        }
+    }
+}
+
+
+static  void  CountDPC (void *p_arg)
+{
+    (void)p_arg;
+    DPC_CountNbr++;
+}
+
+
+static  void  CountISR (void)
+{
+    (void)OSDPCPost(CountDPC, (void *)0);
+}
+
+
+static  void  WorkDPC (void *p_arg)
+{
+    (void)p_arg;
+    Work();
+}
+
+
+static  void  DirectISR (void)                                  /* Does the work in the ISR ...                         */
+{
+    Work();
+}
+
+
+static  void  DeferredISR (void)                                /* ... or defers it (see Note #2).                      */
+{
+    (void)OSDPCPost(WorkDPC, (void *)0);
+}
+
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                              AppTask()
+*
+* Description : Takes the interrupts for each part of the test, then waits for the test task.
+*********************************************************************************************************
+*/
+
+static  void  AppTask (void *p_arg)
+{
+    INT32U  i;
+    INT32U  m;
+
+
+    (void)p_arg;
+    for (i = 0; i < 50; i++) {                                  /* ------------------ ORDER (Note #1) ------------------ */
+        OS_CPU_SimISR(OrderISR);
+        if (DPC_Pending != 0) {
+            DPC_SeenPending++;
+        }
+    }
+    OSSchedLock();                                              /* -------------- OVERFLOW (Note #1) ------------------- */
+    OS_CPU_SimISR(FloodISR);
+    if (DPC_Pending != 0) {
+        DPC_SeenPending++;                                      /* Expected: the DPC task cannot run yet.               */
+    }
+    OSSchedUnlock();
+                                                                /* ------------ MEASUREMENT (Note #2) ------------------ */
+    for (m = 0; m < 2; m++) {
+        OS_CPU_IntDisMeasClr();
+        for (i = 0; i < MEAS_NBR_INTS; i++) {
+            OS_CPU_SimISR((m == 0) ? DirectISR : DeferredISR);
+        }
+        MeasTotNs[m] = OS_CPU_IntDisMeasTotNs;
+        MeasMaxNs[m] = OS_CPU_IntDisMeasMaxNs;
+    }
+    (void)OSTaskSuspend(OS_PRIO_SELF);
+}
+
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                             Test_Susp()
+*
+* Description : Suspends & resumes the DPC task from the application (see Note #3).
+*********************************************************************************************************
+*/
+
+static  void  Test_Susp (void)
+{
+    OS_TCB  *ptcb;
+    INT8U    err;
+
+
+    ptcb = OSTCBPrioTbl[OS_TASK_DPC_PRIO];
+    TEST_CHK(ptcb->OSTCBStat == OS_STAT_SEM);                   /* Idle DPC task waits on its event.                    */
+
+    err = OSTaskSuspend(OS_TASK_DPC_PRIO);                      /* A post does not undo the suspend ...                 */
+    TEST_CHK(err == OS_ERR_NONE);
+    OS_CPU_SimISR(CountISR);
+    OSTimeDly(1);
+    TEST_CHK(DPC_CountNbr == 0);
+    TEST_CHK(ptcb->OSTCBStat == OS_STAT_SUSPEND);
+
+    err = OSTaskResume(OS_TASK_DPC_PRIO);                       /* ... the resume runs the call that was posted.        */
+    TEST_CHK(err == OS_ERR_NONE);
+    TEST_CHK(DPC_CountNbr == 1);
+    TEST_CHK(ptcb->OSTCBStat == OS_STAT_SEM);
+
+    (void)OSTaskSuspend(OS_TASK_DPC_PRIO);                      /* A resume with an empty queue does not wake it.       */
+    OSSchedLock();
+    (void)OSTaskResume(OS_TASK_DPC_PRIO);
+    TEST_CHK(ptcb->OSTCBStat == OS_STAT_SEM);
+    TEST_CHK((OSRdyTbl[ptcb->OSTCBY] & ptcb->OSTCBBitX) == 0);
+    OSSchedUnlock();
+
+    OS_CPU_SimISR(CountISR);                                    /* A post still wakes it.                               */
+    TEST_CHK(DPC_CountNbr == 2);
+}
+
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                             TestTask()
+*********************************************************************************************************
+*/
+
+static  void  TestTask (void *p_arg)
+{
+    (void)p_arg;
+    DPC_Ok = DEF_TRUE;
+    (void)OSTaskCreateExt(AppTask,
+                          (void *)0,
+                          &AppTaskStk[TEST_TASK_STK_SIZE - 1],
+                          APP_PRIO,
+                          APP_PRIO,
+                          &AppTaskStk[0],
+                          TEST_TASK_STK_SIZE,
+                          (void *)0,
+                          OS_TASK_OPT_NONE);
+    while (OSTCBPrioTbl[APP_PRIO]->OSTCBStat == OS_STAT_RDY) {
+        OSTimeDly(1);
+    }
+
+    printf("order: %u calls, seen pending %u time(s), overflows %u\n",
+           (unsigned)DPC_Nbr, (unsigned)DPC_SeenPending, (unsigned)OSDPCOvfCtr);
+    TEST_CHK(DPC_Ok == DEF_TRUE);
+    TEST_CHK(DPC_Pending == 0);
+    TEST_CHK(DPC_Nbr == 100 + (OS_DPC_Q_SIZE - 1));
+    TEST_CHK(DPC_SeenPending == 1);                             /* Only while the scheduler was locked.                 */
+    TEST_CHK(OSDPCOvfCtr == 3);                                 /* One entry of the ring is always kept empty.          */
+
+    printf("interrupt-disabled, work in ISR : %7.1f ns/int, max %6lu ns\n",
+           MeasTotNs[0] / MEAS_NBR_INTS, MeasMaxNs[0]);
+    printf("interrupt-disabled, work in DPC : %7.1f ns/int, max %6lu ns\n",
+           MeasTotNs[1] / MEAS_NBR_INTS, MeasMaxNs[1]);
+    TEST_CHK(MeasTotNs[1] * 2.0 < MeasTotNs[0]);
+
+    Test_Susp();
+    Test_Done("test_os_dpc");
+}
+
+
+int  main (void)
+{
+    OSInit();
+    (void)OSTaskCreateExt(TestTask,
+                          (void *)0,
+                          &TestTaskStk[TEST_TASK_STK_SIZE - 1],
+                          TEST_TASK_PRIO,
+                          TEST_TASK_PRIO,
+                          &TestTaskStk[0],
+                          TEST_TASK_STK_SIZE,
+                          (void *)0,
+                          OS_TASK_OPT_NONE);
+    OSStart();
+    return (0);
+}
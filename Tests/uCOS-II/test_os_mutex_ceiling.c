@@ -0,0 +1,287 @@
+/*
+*********************************************************************************************************
+*                                             HOST TESTS
+*
+*                             uC/OS-II Mutexes: Priority Ceiling vs. Inheritance
+*
+* Filename      : test_os_mutex_ceiling.c
+* Note(s)       : (1) Built twice, with OS_MUTEX_CEILING_EN 1 (immediate priority ceiling) & 0 (priority
+*                     inheritance, PIP).  The owner's priority is checked in both modes, including nested &
+*                     out-of-order release with the ceiling, whichever of the two ceilings is taken first.
+*                     Deleting a mutex held by a suspended task must not make that task ready.
+*
+*                 (2) Latency figures, in host ns:
+*
+*                     (a) Uncontended: one OSMutexPend()/OSMutexPost() pair with nobody waiting.
+*
+*                     (b) Contended: a low priority task holds the mutex & readies a high priority task
+*                         that wants it.  The latency is from the moment the high priority task is made
+*                         ready until it owns the mutex.  Context switches are counted per hand-off.
+*
+*                     Compare the figures printed by both builds.
+*********************************************************************************************************
+*/
+
+#include  <includes.h>
+
+
+/*
+*********************************************************************************************************
+*                                            LOCAL DEFINES
+*********************************************************************************************************
+*/
+
+#define  MTX_PIP                           8
+#define  MTX_PIP_2                         6
+#define  HI_PRIO                          12
+#define  OWN_PRIO                         20
+#define  LO_PRIO                          30
+
+#define  MEAS_NBR                     100000
+
+
+/*
+*********************************************************************************************************
+*                                        LOCAL GLOBAL VARIABLES
+*********************************************************************************************************
+*/
+
+static  OS_STK              TestTaskStk[TEST_TASK_STK_SIZE];
+static  OS_STK              HiTaskStk[TEST_TASK_STK_SIZE];
+static  OS_STK              LoTaskStk[TEST_TASK_STK_SIZE];
+static  OS_STK              OwnTaskStk[TEST_TASK_STK_SIZE];
+
+static  OS_EVENT           *Mtx;
+static  OS_EVENT           *HiSem;
+static  OS_EVENT           *LoSem;
+static  OS_EVENT           *OwnMtx;
+
+static  unsigned long long  HandOffStart;
+static  double              HandOffTotNs;
+static  unsigned long long  HandOffMaxNs;
+static  INT32U              HandOffCtxSw;
+static  INT32U              HandOffNbr;
+
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                              HiTask()
+*
+* Description : High priority side of the hand-off (see Note #2b).
+*********************************************************************************************************
+*/
+
+static  void  HiTask (void *p_arg)
+{
+    INT8U               err;
+    unsigned long long  ns;
+
+
+    (void)p_arg;
+    while (DEF_TRUE) {
+        OSSemPend(HiSem, 0, &err);
+        OSMutexPend(Mtx, 0, &err);
+        ns = Test_TimeNs() - HandOffStart;
+        HandOffTotNs += (double)ns;
+        if (ns > HandOffMaxNs) {
+            HandOffMaxNs = ns;
+        }
+        HandOffNbr++;
+        (void)OSMutexPost(Mtx);
+        (void)OSSemPost(LoSem);
+    }
+}
+
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                             OwnTask()
+*
+* Description : Acquires OwnMtx, then suspends itself while still owning it (see Note #1).
+*********************************************************************************************************
+*/
+
+static  void  OwnTask (void *p_arg)
+{
+    INT8U  err;
+
+
+    (void)p_arg;
+    OSMutexPend(OwnMtx, 0, &err);
+    while (DEF_TRUE) {
+        (void)OSTaskSuspend(OS_PRIO_SELF);
+    }
+}
+
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                           Test_Prio()
+*
+* Description : Check the owner's priority (see Note #1).  Runs in LoTask(), below both ceilings.
+*********************************************************************************************************
+*/
+
+static  void  Test_Prio (void)
+{
+    INT8U      err;
+    INT8U      prio;
+    OS_EVENT  *mtx_2;
+    OS_TCB    *ptcb;
+
+
+    prio  = OSTCBCur->OSTCBPrio;
+    mtx_2 = OSMutexCreate(MTX_PIP_2, &err);
+    TEST_CHK(err == OS_ERR_NONE);
+
+    OSMutexPend(Mtx, 0, &err);
+    TEST_CHK(err == OS_ERR_NONE);
+#if OS_MUTEX_CEILING_EN > 0
+    TEST_CHK(OSTCBCur->OSTCBPrio == MTX_PIP);                   /* Raised at acquire ...                                */
+    OSMutexPend(mtx_2, 0, &err);
+    TEST_CHK(OSTCBCur->OSTCBPrio == MTX_PIP_2);
+    TEST_CHK(OSTCBCur->OSTCBMutexCtr == 2);
+    (void)OSMutexPost(mtx_2);                                   /* ... restored in LIFO order ...                       */
+    TEST_CHK(OSTCBCur->OSTCBPrio == MTX_PIP);
+    (void)OSMutexPost(Mtx);
+    TEST_CHK(OSTCBCur->OSTCBPrio == prio);
+
+    OSMutexPend(Mtx, 0, &err);                                  /* ... & out of order.                                  */
+    OSMutexPend(mtx_2, 0, &err);
+    (void)OSMutexPost(Mtx);
+    TEST_CHK(OSTCBCur->OSTCBPrio == MTX_PIP_2);
+    (void)OSMutexPost(mtx_2);
+    TEST_CHK(OSTCBCur->OSTCBPrio == prio);
+    TEST_CHK(OSTCBCur->OSTCBMutexCtr == 0);
+
+    OSMutexPend(mtx_2, 0, &err);                                /* High ceiling first, released first.                  */
+    OSMutexPend(Mtx, 0, &err);
+    TEST_CHK(err == OS_ERR_NONE);
+    TEST_CHK(OSTCBCur->OSTCBPrio == MTX_PIP_2);
+    (void)OSMutexPost(mtx_2);                                   /* Still holds Mtx: down to its ceiling only.           */
+    TEST_CHK(OSTCBCur->OSTCBPrio == MTX_PIP);
+    (void)OSMutexPost(Mtx);
+    TEST_CHK(OSTCBCur->OSTCBPrio == prio);
+    TEST_CHK(OSTCBCur->OSTCBMutexCtr == 0);
+#else
+    TEST_CHK(OSTCBCur->OSTCBPrio == prio);                      /* Not raised without contention.                       */
+    (void)OSMutexPost(Mtx);
+    TEST_CHK(OSTCBCur->OSTCBPrio == prio);
+#endif
+    TEST_CHK(OSTCBPrioTbl[prio] == OSTCBCur);
+    (void)OSMutexDel(mtx_2, OS_DEL_ALWAYS, &err);
+                                                                /* Suspended owner stays suspended on delete.           */
+    OwnMtx = OSMutexCreate(MTX_PIP_2, &err);
+    (void)OSTaskCreateExt(OwnTask, (void *)0, &OwnTaskStk[TEST_TASK_STK_SIZE - 1], OWN_PRIO, OWN_PRIO,
+                          &OwnTaskStk[0], TEST_TASK_STK_SIZE, (void *)0, OS_TASK_OPT_NONE);
+    ptcb = OSTCBPrioTbl[OWN_PRIO];
+    TEST_CHK(ptcb->OSTCBStat == OS_STAT_SUSPEND);
+    (void)OSMutexDel(OwnMtx, OS_DEL_ALWAYS, &err);
+    TEST_CHK(err == OS_ERR_NONE);
+    TEST_CHK(ptcb->OSTCBPrio == OWN_PRIO);
+    TEST_CHK(ptcb->OSTCBStat == OS_STAT_SUSPEND);
+    TEST_CHK((OSRdyTbl[ptcb->OSTCBY] & ptcb->OSTCBBitX) == 0);
+    TEST_CHK(OSTCBPrioTbl[OWN_PRIO] == ptcb);
+    (void)OSTaskDel(OWN_PRIO);
+}
+
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                              LoTask()
+*
+* Description : Runs the priority checks & the latency measurements (see Note #2).
+*********************************************************************************************************
+*/
+
+static  void  LoTask (void *p_arg)
+{
+    INT8U               err;
+    INT32U              i;
+    INT32U              ctx_sw;
+    unsigned long long  t0;
+    unsigned long long  t1;
+
+
+    (void)p_arg;
+    Test_Prio();
+                                                                /* ------------ UNCONTENDED (Note #2a) ----------------- */
+    t0 = Test_TimeNs();
+    for (i = 0; i < MEAS_NBR; i++) {
+        OSMutexPend(Mtx, 0, &err);
+        (void)OSMutexPost(Mtx);
+    }
+    t1 = Test_TimeNs();
+    printf("uncontended: %6.1f ns per pend/post\n", (double)(t1 - t0) / MEAS_NBR);
+                                                                /* ------------- CONTENDED (Note #2b) ------------------ */
+    ctx_sw = OSCtxSwCtr;
+    for (i = 0; i < MEAS_NBR; i++) {
+        OSMutexPend(Mtx, 0, &err);
+        HandOffStart = Test_TimeNs();
+        (void)OSSemPost(HiSem);                                 /* PIP: Hi preempts, blocks & boosts Lo.                */
+        (void)OSMutexPost(Mtx);                                 /* Ceiling: Hi runs only from here.                     */
+        OSSemPend(LoSem, 0, &err);
+    }
+    HandOffCtxSw = OSCtxSwCtr - ctx_sw;
+    (void)OSTaskSuspend(OS_PRIO_SELF);
+}
+
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                             TestTask()
+*********************************************************************************************************
+*/
+
+static  void  TestTask (void *p_arg)
+{
+    INT8U  err;
+
+
+    (void)p_arg;
+    Mtx   = OSMutexCreate(MTX_PIP, &err);
+    HiSem = OSSemCreate(0);
+    LoSem = OSSemCreate(0);
+    TEST_CHK(err == OS_ERR_NONE);
+
+    (void)OSTaskCreateExt(HiTask, (void *)0, &HiTaskStk[TEST_TASK_STK_SIZE - 1], HI_PRIO, HI_PRIO,
+                          &HiTaskStk[0], TEST_TASK_STK_SIZE, (void *)0, OS_TASK_OPT_NONE);
+    (void)OSTaskCreateExt(LoTask, (void *)0, &LoTaskStk[TEST_TASK_STK_SIZE - 1], LO_PRIO, LO_PRIO,
+                          &LoTaskStk[0], TEST_TASK_STK_SIZE, (void *)0, OS_TASK_OPT_NONE);
+    while (OSTCBPrioTbl[LO_PRIO]->OSTCBStat == OS_STAT_RDY) {
+        OSTimeDly(1);
+    }
+    TEST_CHK(HandOffNbr == MEAS_NBR);
+    TEST_CHK(OSTCBPrioTbl[LO_PRIO]->OSTCBPrio == LO_PRIO);      /* Lo is back at its own priority.                      */
+    printf("contended:   %6.1f ns ready-to-owner (max %llu ns), %.1f ctx sw per hand-off\n",
+           HandOffTotNs / MEAS_NBR, HandOffMaxNs, (double)HandOffCtxSw / MEAS_NBR);
+#if OS_MUTEX_CEILING_EN > 0
+    TEST_CHK(HandOffCtxSw <= 2 * MEAS_NBR + 2);                 /* Hi never blocks on the mutex.                        */
+    Test_Done("test_os_mutex_ceiling (OS_MUTEX_CEILING_EN 1)");
+#else
+    TEST_CHK(HandOffCtxSw >= 3 * MEAS_NBR);                     /* Hi preempts Lo, blocks, then gets the mutex.         */
+    Test_Done("test_os_mutex_ceiling (OS_MUTEX_CEILING_EN 0)");
+#endif
+}
+
+
+int  main (void)
+{
+    OSInit();
+    (void)OSTaskCreateExt(TestTask,
+                          (void *)0,
+                          &TestTaskStk[TEST_TASK_STK_SIZE - 1],
+                          TEST_TASK_PRIO,
+                          TEST_TASK_PRIO,
+                          &TestTaskStk[0],
+                          TEST_TASK_STK_SIZE,
+                          (void *)0,
+                          OS_TASK_OPT_NONE);
+    OSStart();
+    return (0);
+}
@@ -0,0 +1,356 @@
+/*
+*********************************************************************************************************
+*                                             HOST TESTS
+*
+*                                    uC/OS-II Reader-Writer Locks
+*
+* Filename      : test_os_rwlock.c
+* Note(s)       : (1) Built twice, with OS_SCHED_RR_EN 1 & 0.  Each scenario is a list of tasks that pend on
+*                     the lock after a delay, hold it for a number of ticks & release it.  A task logs its
+*                     tag when it gets the lock, the upper case tag when it releases it & '-' on a timeout.
+*                     The log shows the order of the hand-offs:
+*
+*                     (a) A writer waiting keeps new readers out (writer preference) & waiting writers get
+*                         the lock in priority order, not in arrival order.
+*
+*                     (b) A writer that times out lets the readers queued behind it in.
+*
+*                     (c) Every reader waiting gets the lock at once when a writer releases it.  With
+*                         round-robin the readers share one priority.
+*
+*                 (2) Read throughput: 1 to RD_NBR_MAX readers each hold the lock for one tick at a time
+*                     (standing in for a read that blocks, e.g. on a driver) & count their reads.  With
+*                     OSRWLockPendRd() the readers overlap, so the reads per tick grow with their number;
+*                     with OSRWLockPendWr() they are serialized, as with a mutex.  The host time of an
+*                     uncontended OSRWLockPendRd()/OSRWLockPostRd() pair is also printed.
+*********************************************************************************************************
+*/
+
+#include  <includes.h>
+
+
+/*
+*********************************************************************************************************
+*                                            LOCAL DEFINES
+*********************************************************************************************************
+*/
+
+#define  SCN_NBR_MAX                       5
+#define  RD_PRIO                          25
+#define  RD_NBR_MAX                        8
+#define  RD_TICKS                       1000
+#define  MEAS_NBR                     100000
+
+#if OS_SCHED_RR_EN > 0
+#define  RD_PRIO_STEP                      0                    /* Readers share RD_PRIO ...                            */
+#define  RD_OPT                         OS_TASK_OPT_SCHED_RR
+#else
+#define  RD_PRIO_STEP                      1                    /* ... or each get their own.                           */
+#define  RD_OPT                         OS_TASK_OPT_NONE
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                           LOCAL DATA TYPES
+*********************************************************************************************************
+*/
+
+typedef  struct  lock_step {                                    /* One task of a scenario (see Note #1).                */
+    INT8U        Prio;
+    INT16U       Opt;
+    CPU_BOOLEAN  Wr;
+    INT16U       Dly;
+    INT16U       Timeout;
+    INT16U       Hold;
+    CPU_CHAR     Tag;
+} LOCK_STEP;
+
+
+/*
+*********************************************************************************************************
+*                                        LOCAL GLOBAL VARIABLES
+*********************************************************************************************************
+*/
+
+static  OS_STK           TestTaskStk[TEST_TASK_STK_SIZE];
+static  OS_STK           StepTaskStk[SCN_NBR_MAX][TEST_TASK_STK_SIZE];
+static  OS_STK           RdTaskStk[RD_NBR_MAX][TEST_TASK_STK_SIZE];
+
+static  OS_EVENT        *Lock;
+
+static  CPU_CHAR         Log[32];
+static  CPU_INT08U       LogIx;
+
+static  const  LOCK_STEP  ScnPrefer[] = {                       /* Note #1a                                             */
+    { 21, OS_TASK_OPT_NONE, DEF_FALSE, 0, 0, 10, 'a' },
+    { 22, OS_TASK_OPT_NONE, DEF_FALSE, 0, 0, 10, 'b' },
+    { 16, OS_TASK_OPT_NONE, DEF_TRUE,  1, 0,  3, 'x' },
+    { 15, OS_TASK_OPT_NONE, DEF_TRUE,  2, 0,  3, 'y' },
+    { 23, OS_TASK_OPT_NONE, DEF_FALSE, 4, 0,  1, 'c' }
+};
+
+static  const  LOCK_STEP  ScnTimeout[] = {                      /* Note #1b                                             */
+    { 21, OS_TASK_OPT_NONE, DEF_FALSE, 0, 0, 10, 'a' },
+    { 15, OS_TASK_OPT_NONE, DEF_TRUE,  2, 4,  3, 'x' },
+    { 23, OS_TASK_OPT_NONE, DEF_FALSE, 4, 0,  1, 'c' }
+};
+
+static  const  LOCK_STEP  ScnReaders[] = {                      /* Note #1c                                             */
+    { 15,                         OS_TASK_OPT_NONE, DEF_TRUE,  0, 0, 5, 'x' },
+    { RD_PRIO,                    RD_OPT,           DEF_FALSE, 1, 0, 2, 'a' },
+    { RD_PRIO + RD_PRIO_STEP,     RD_OPT,           DEF_FALSE, 1, 0, 2, 'b' },
+    { RD_PRIO + RD_PRIO_STEP * 2, RD_OPT,           DEF_FALSE, 1, 0, 2, 'c' }
+};
+
+static  CPU_BOOLEAN      RdWr;                                  /* Readers use OSRWLockPendWr() (see Note #2).          */
+static  CPU_INT08U       RdNbr;                                 /* Number of readers taking part.                       */
+static  INT32U           RdCtr[RD_NBR_MAX];
+
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                             StepTask()
+*
+* Description : Runs one step of a scenario (see Note #1).
+*********************************************************************************************************
+*/
+
+static  void  StepTask (void *p_arg)
+{
+    const  LOCK_STEP  *p_step;
+    INT8U              err;
+
+
+    p_step = (const LOCK_STEP *)p_arg;
+    if (p_step->Dly > 0) {
+        OSTimeDly(p_step->Dly);
+    }
+    if (p_step->Wr == DEF_TRUE) {
+        OSRWLockPendWr(Lock, p_step->Timeout, &err);
+    } else {
+        OSRWLockPendRd(Lock, p_step->Timeout, &err);
+    }
+    if (err != OS_ERR_NONE) {
+        Log[LogIx++] = '-';
+        (void)OSTaskSuspend(OS_PRIO_SELF);
+    }
+    Log[LogIx++] = p_step->Tag;
+    OSTimeDly(p_step->Hold);
+    Log[LogIx++] = (CPU_CHAR)(p_step->Tag - 'a' + 'A');
+    if (p_step->Wr == DEF_TRUE) {
+        (void)OSRWLockPostWr(Lock);
+    } else {
+        (void)OSRWLockPostRd(Lock);
+    }
+    (void)OSTaskSuspend(OS_PRIO_SELF);
+}
+
+
+/*
+*********************************************************************************************************
+*                                             Test_Scn()
+*
+* Description : Run a scenario for 'ticks' ticks, query the lock, run it for 'ticks_end' more ticks & delete
+*               its tasks.  The log is left in Log[].
+*********************************************************************************************************
+*/
+
+static  void  Test_Scn (const  LOCK_STEP       *p_scn,
+                                CPU_INT08U       nbr,
+                                INT16U           ticks,
+                                OS_RWLOCK_DATA  *p_data,
+                                INT16U           ticks_end)
+{
+    CPU_INT08U  ix;
+    INT8U       err;
+
+
+    Mem_Clr((void *)Log, sizeof(Log));
+    LogIx = 0;
+    for (ix = 0; ix < nbr; ix++) {
+        err = OSTaskCreateExt(StepTask,
+                              (void *)&p_scn[ix],
+                              &StepTaskStk[ix][TEST_TASK_STK_SIZE - 1],
+                              p_scn[ix].Prio,
+                              p_scn[ix].Prio,
+                              &StepTaskStk[ix][0],
+                              TEST_TASK_STK_SIZE,
+                              (void *)0,
+                              p_scn[ix].Opt);
+        TEST_CHK(err == OS_ERR_NONE);
+    }
+    OSTimeDly(ticks);
+    (void)OSRWLockQuery(Lock, p_data);
+    OSTimeDly(ticks_end);
+    for (ix = 0; ix < nbr; ix++) {
+        (void)OSTaskDel(p_scn[ix].Prio);
+    }
+}
+
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                              RdTask()
+*
+* Description : One reader of the throughput measurement (see Note #2).
+*********************************************************************************************************
+*/
+
+static  void  RdTask (void *p_arg)
+{
+    CPU_INT08U  id;
+    INT8U       err;
+
+
+    id = (CPU_INT08U)(CPU_ADDR)p_arg;
+    while (DEF_TRUE) {
+        if (id >= RdNbr) {                                      /* Not taking part in this round.                       */
+            OSTimeDly(1);
+            continue;
+        }
+        if (RdWr == DEF_TRUE) {
+            OSRWLockPendWr(Lock, 0, &err);
+            OSTimeDly(1);
+            (void)OSRWLockPostWr(Lock);
+        } else {
+            OSRWLockPendRd(Lock, 0, &err);
+            OSTimeDly(1);
+            (void)OSRWLockPostRd(Lock);
+        }
+        RdCtr[id]++;
+    }
+}
+
+
+/*
+*********************************************************************************************************
+*                                             Test_Rd()
+*
+* Description : Returns the reads per tick done by 'nbr' readers, with read or write locking.
+*********************************************************************************************************
+*/
+
+static  double  Test_Rd (CPU_INT08U nbr, CPU_BOOLEAN wr)
+{
+    CPU_INT08U  ix;
+    INT32U      tot;
+
+
+    RdNbr = 0;
+    OSTimeDly(3);                                               /* Let the last round's readers drain.                  */
+    Mem_Clr((void *)RdCtr, sizeof(RdCtr));
+    RdWr  = wr;
+    RdNbr = nbr;
+    OSTimeDly(RD_TICKS);
+    tot   = 0;
+    for (ix = 0; ix < RD_NBR_MAX; ix++) {
+        tot += RdCtr[ix];
+    }
+    return ((double)tot / RD_TICKS);
+}
+
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                             TestTask()
+*********************************************************************************************************
+*/
+
+static  void  TestTask (void *p_arg)
+{
+    OS_RWLOCK_DATA      data;
+    CPU_INT08U          ix;
+    CPU_INT08U          nbr;
+    INT8U               err;
+    INT32U              i;
+    double              rd;
+    double              wr;
+    unsigned long long  t0;
+    unsigned long long  t1;
+
+
+    (void)p_arg;
+    Lock = OSRWLockCreate();
+    TEST_CHK(Lock != (OS_EVENT *)0);
+                                                                /* ------------------ SCENARIOS (Note #1) -------------- */
+    Test_Scn(ScnPrefer, sizeof(ScnPrefer) / sizeof(ScnPrefer[0]), 5, &data, 30);
+    TEST_CHK(data.OSNbrReaders     == 2);                       /* Both writers & 'c' wait at tick 5.                   */
+    TEST_CHK(data.OSNbrWritersWait == 2);
+    printf("prefer : %s\n", Log);
+    TEST_CHK(Str_Cmp(Log, (CPU_CHAR *)"abAByYxXcC") == 0);
+
+    Test_Scn(ScnTimeout, sizeof(ScnTimeout) / sizeof(ScnTimeout[0]), 5, &data, 30);
+    TEST_CHK(data.OSNbrWritersWait == 1);
+    printf("timeout: %s\n", Log);
+    TEST_CHK(Str_Cmp(Log, (CPU_CHAR *)"a-cCA") == 0);
+
+    Test_Scn(ScnReaders, sizeof(ScnReaders) / sizeof(ScnReaders[0]), 6, &data, 30);
+    TEST_CHK(data.OSNbrReaders     == 3);
+    printf("readers: %s\n", Log);
+    TEST_CHK(Str_Cmp_N(Log, (CPU_CHAR *)"xX", 2) == 0);
+    for (ix = 2; ix < 5; ix++) {                                /* All three in before any leaves.                      */
+        TEST_CHK((Log[ix] >= 'a') && (Log[ix] <= 'c'));
+        TEST_CHK((Log[ix + 3] >= 'A') && (Log[ix + 3] <= 'C'));
+    }
+    (void)OSRWLockQuery(Lock, &data);
+    TEST_CHK(data.OSNbrReaders     == 0);
+    TEST_CHK(data.OSWriterPrio     == 0xFF);
+    TEST_CHK(data.OSNbrWritersWait == 0);
+    TEST_CHK(Lock->OSEventGrp      == 0);
+                                                                /* ----------------- THROUGHPUT (Note #2) -------------- */
+    t0 = Test_TimeNs();
+    for (i = 0; i < MEAS_NBR; i++) {
+        OSRWLockPendRd(Lock, 0, &err);
+        (void)OSRWLockPostRd(Lock);
+    }
+    t1 = Test_TimeNs();
+    printf("uncontended: %6.1f ns per pend/post\n", (double)(t1 - t0) / MEAS_NBR);
+
+    for (ix = 0; ix < RD_NBR_MAX; ix++) {
+        err = OSTaskCreateExt(RdTask,
+                              (void *)(CPU_ADDR)ix,
+                              &RdTaskStk[ix][TEST_TASK_STK_SIZE - 1],
+                              (INT8U)(RD_PRIO + RD_PRIO_STEP * ix),
+                              (INT8U)(RD_PRIO + RD_PRIO_STEP * ix),
+                              &RdTaskStk[ix][0],
+                              TEST_TASK_STK_SIZE,
+                              (void *)0,
+                              RD_OPT);
+        TEST_CHK(err == OS_ERR_NONE);
+    }
+    printf("readers   reads/tick (PendRd)   reads/tick (PendWr)\n");
+    for (nbr = 1; nbr <= RD_NBR_MAX; nbr *= 2) {
+        rd = Test_Rd(nbr, DEF_FALSE);
+        wr = Test_Rd(nbr, DEF_TRUE);
+        printf("%7u   %19.2f   %19.2f\n", (unsigned)nbr, rd, wr);
+        TEST_CHK(rd >= 0.9 * nbr);                              /* Readers overlap ...                                  */
+        TEST_CHK(wr <= 1.1);                                    /* ... writers do not.                                  */
+    }
+
+#if OS_SCHED_RR_EN > 0
+    Test_Done("test_os_rwlock (OS_SCHED_RR_EN 1)");
+#else
+    Test_Done("test_os_rwlock (OS_SCHED_RR_EN 0)");
+#endif
+}
+
+
+int  main (void)
+{
+    OSInit();
+    (void)OSTaskCreateExt(TestTask,
+                          (void *)0,
+                          &TestTaskStk[TEST_TASK_STK_SIZE - 1],
+                          TEST_TASK_PRIO,
+                          TEST_TASK_PRIO,
+                          &TestTaskStk[0],
+                          TEST_TASK_STK_SIZE,
+                          (void *)0,
+                          OS_TASK_OPT_NONE);
+    OSStart();
+    return (0);
+}
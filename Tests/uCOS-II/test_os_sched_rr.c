@@ -0,0 +1,373 @@
+/*
+*********************************************************************************************************
+*                                             HOST TESTS
+*
+*                                    uC/OS-II Round-Robin Scheduling
+*
+* Filename      : test_os_sched_rr.c
+* Note(s)       : (1) Built twice, with OS_SCHED_RR_EN 1 & 0.  With round-robin, tasks sharing a priority
+*                     must split the CPU evenly, & a task created without OS_TASK_OPT_SCHED_RR must not join
+*                     them.  Without it, a second task at a used priority must be refused.
+*
+*                 (2) Mutex (priority inheritance): a round-robin task owning a mutex that a higher priority
+*                     task waits for is raised to the PIP.  It then runs alone, out of the time slicing of
+*                     its priority, until it posts the mutex; after that it is back at its own priority &
+*                     shares the CPU evenly with the other tasks again.
+*
+*                 (3) The switch overhead is the host time per simulated tick while busy tasks run, alone &
+*                     three to a priority.  Compare the numbers printed by both builds; they are host
+*                     figures, not target cycles.
+*********************************************************************************************************
+*/
+
+#include  <includes.h>
+
+
+/*
+*********************************************************************************************************
+*                                            LOCAL DEFINES
+*********************************************************************************************************
+*/
+
+#define  RR_PRIO                          20
+#define  RR_NBR_TASKS                      3
+#define  RR_FAIR_TICKS                  3000
+#define  RR_OVH_TICKS                  50000
+#define  RR_PIP                           14
+#define  RR_HI_PRIO                       16
+
+
+/*
+*********************************************************************************************************
+*                                        LOCAL GLOBAL VARIABLES
+*********************************************************************************************************
+*/
+
+static  OS_STK           TestTaskStk[TEST_TASK_STK_SIZE];
+static  OS_STK           BurnTaskStk[RR_NBR_TASKS][TEST_TASK_STK_SIZE];
+static  volatile  INT32U BurnTicks[RR_NBR_TASKS];
+
+#if OS_SCHED_RR_EN > 0
+static  OS_STK           HiTaskStk[TEST_TASK_STK_SIZE];
+static  OS_EVENT        *RRMtx;
+static  volatile  INT8U  RRMtxRel;                              /* Tells OwnerTask() to post RRMtx.                     */
+static  volatile  INT8U  RRMtxHiGot;
+#endif
+
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                             BurnTask()
+*
+* Description : Busy task.  Counts the ticks that interrupt it.
+*********************************************************************************************************
+*/
+
+static  void  BurnTask (void *p_arg)
+{
+    INT32U  ix;
+
+
+    ix = (INT32U)(CPU_ADDR)p_arg;
+    while (DEF_TRUE) {
+        BurnTicks[ix]++;
+        OS_CPU_SimTickISR();
+    }
+}
+
+
+static  INT8U  BurnCreate (INT32U  ix,
+                           INT8U   prio,
+                           INT16U  opt)
+{
+    INT8U  err;
+
+
+    err = OSTaskCreateExt(BurnTask,
+                          (void *)(CPU_ADDR)ix,
+                          &BurnTaskStk[ix][TEST_TASK_STK_SIZE - 1],
+                          prio,
+                          (INT16U)(prio + ix),
+                          &BurnTaskStk[ix][0],
+                          TEST_TASK_STK_SIZE,
+                          (void *)0,
+                          opt);
+    return (err);
+}
+
+
+static  void  BurnClr (void)
+{
+    INT32U  ix;
+
+
+    for (ix = 0; ix < RR_NBR_TASKS; ix++) {
+        BurnTicks[ix] = 0;
+    }
+}
+
+
+#if OS_SCHED_RR_EN > 0
+static  INT32U  Dist (INT32U  a,
+                      INT32U  b)
+{
+    return ((a > b) ? (a - b) : (b - a));
+}
+#endif
+
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                       OwnerTask() & HiTask()
+*
+* Description : OwnerTask() is a busy round-robin task that holds RRMtx until told to post it.  HiTask()
+*               waits for RRMtx, takes it & posts it once.
+*********************************************************************************************************
+*/
+
+#if OS_SCHED_RR_EN > 0
+static  void  OwnerTask (void *p_arg)
+{
+    INT8U  err;
+
+
+    OSMutexPend(RRMtx, 0, &err);
+    while (RRMtxRel == OS_FALSE) {
+        BurnTicks[0]++;
+        OS_CPU_SimTickISR();
+    }
+    (void)OSMutexPost(RRMtx);
+    BurnTask(p_arg);
+}
+
+
+static  void  HiTask (void *p_arg)
+{
+    INT8U  err;
+
+
+    (void)p_arg;
+    OSMutexPend(RRMtx, 0, &err);
+    RRMtxHiGot = (err == OS_ERR_NONE) ? OS_TRUE : OS_FALSE;
+    (void)OSMutexPost(RRMtx);
+    while (DEF_TRUE) {
+        (void)OSTaskSuspend(OS_PRIO_SELF);
+    }
+}
+#endif
+
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                           Test_Mutex()
+*
+* Description : See Note #2.
+*********************************************************************************************************
+*/
+
+#if OS_SCHED_RR_EN > 0
+static  void  Test_Mutex (void)
+{
+    INT8U    err;
+    INT32U   ix;
+    INT32U   ticks[RR_NBR_TASKS];
+    INT32U   i;
+    OS_TCB  *ptcb;
+
+
+    BurnClr();
+    RRMtxRel   = OS_FALSE;
+    RRMtxHiGot = OS_FALSE;
+    RRMtx      = OSMutexCreate(RR_PIP, &err);
+    TEST_CHK(err == OS_ERR_NONE);
+    (void)OSTaskCreateExt(OwnerTask, (void *)0, &BurnTaskStk[0][TEST_TASK_STK_SIZE - 1], RR_PRIO, RR_PRIO,
+                          &BurnTaskStk[0][0], TEST_TASK_STK_SIZE, (void *)0, OS_TASK_OPT_SCHED_RR);
+    for (ix = 1; ix < RR_NBR_TASKS; ix++) {
+        TEST_CHK(BurnCreate(ix, RR_PRIO, OS_TASK_OPT_SCHED_RR) == OS_ERR_NONE);
+    }
+    for (i = 0; (i < RR_FAIR_TICKS) && (RRMtx->OSEventPtr == (void *)0); i++) {
+        OSTimeDly(1);                                           /* Until OwnerTask() holds the mutex.                   */
+    }
+    ptcb = (OS_TCB *)RRMtx->OSEventPtr;
+    TEST_CHK(ptcb != (OS_TCB *)0);
+    TEST_CHK(ptcb->OSTCBPrio == RR_PRIO);
+                                                                /* ------------- OWNER RAISED OUT OF THE RING ---------- */
+    (void)OSTaskCreateExt(HiTask, (void *)0, &HiTaskStk[TEST_TASK_STK_SIZE - 1], RR_HI_PRIO, RR_HI_PRIO,
+                          &HiTaskStk[0], TEST_TASK_STK_SIZE, (void *)0, OS_TASK_OPT_NONE);
+    OSTimeDly(1);                                               /* HiTask() blocks on the mutex.                        */
+    TEST_CHK(ptcb->OSTCBPrio == RR_PIP);
+    TEST_CHK(OSTCBPrioTbl[RR_HI_PRIO]->OSTCBStat == OS_STAT_MUTEX);
+    for (ix = 0; ix < RR_NBR_TASKS; ix++) {
+        ticks[ix] = BurnTicks[ix];
+    }
+    OSTimeDly(RR_FAIR_TICKS);
+    TEST_CHK(ptcb->OSTCBPrio == RR_PIP);
+                                                                /* Owner gets every tick, no time slicing.              */
+    TEST_CHK(Dist(BurnTicks[0] - ticks[0], RR_FAIR_TICKS) <= 1);
+    for (ix = 1; ix < RR_NBR_TASKS; ix++) {
+        TEST_CHK(BurnTicks[ix] == ticks[ix]);
+    }
+                                                                /* -------- BACK IN THE RING AFTER THE POST ------------ */
+    RRMtxRel = OS_TRUE;
+    OSTimeDly(1);
+    TEST_CHK(RRMtxHiGot == OS_TRUE);
+    TEST_CHK(ptcb->OSTCBPrio == RR_PRIO);
+    TEST_CHK(OSTCBPrioTbl[RR_PIP] == OS_TCB_RESERVED);
+    for (ix = 0; ix < RR_NBR_TASKS; ix++) {
+        ticks[ix] = BurnTicks[ix];
+    }
+    OSTimeDly(RR_FAIR_TICKS);
+    for (ix = 0; ix < RR_NBR_TASKS; ix++) {
+        TEST_CHK(Dist(BurnTicks[ix] - ticks[ix], RR_FAIR_TICKS / RR_NBR_TASKS) <= OS_SCHED_RR_QUANTA);
+    }
+
+    TEST_CHK(OSTaskDel(RR_HI_PRIO) == OS_ERR_NONE);
+    for (ix = 0; ix < RR_NBR_TASKS; ix++) {
+        TEST_CHK(OSTaskDel(RR_PRIO) == OS_ERR_NONE);
+        OSTimeDly(OS_SCHED_RR_QUANTA);
+    }
+    (void)OSMutexDel(RRMtx, OS_DEL_ALWAYS, &err);
+    TEST_CHK(err == OS_ERR_NONE);
+    TEST_CHK(OSTCBPrioTbl[RR_PRIO] == (OS_TCB *)0);
+}
+#endif
+
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                         Test_Overhead()
+*
+* Description : Time RR_OVH_TICKS simulated ticks while 'nbr' busy tasks share RR_PRIO + 1.
+*********************************************************************************************************
+*/
+
+static  void  Test_Overhead (INT32U  nbr)
+{
+    INT32U              ix;
+    INT32U              ctx_sw;
+    unsigned long long  t0;
+    unsigned long long  t1;
+
+
+    BurnClr();
+    for (ix = 0; ix < nbr; ix++) {
+        (void)BurnCreate(ix, RR_PRIO + 1, OS_TASK_OPT_SCHED_RR);
+    }
+    ctx_sw = OSCtxSwCtr;
+    t0     = Test_TimeNs();
+    OSTimeDly(RR_OVH_TICKS);
+    t1     = Test_TimeNs();
+    ctx_sw = OSCtxSwCtr - ctx_sw;
+    for (ix = 0; ix < nbr; ix++) {
+        (void)OSTaskDel(RR_PRIO + 1);
+    }
+    printf("overhead: %u task(s), %6.1f ns/tick, %6u ctx sw\n",
+           (unsigned)nbr, (double)(t1 - t0) / RR_OVH_TICKS, (unsigned)ctx_sw);
+}
+
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                             TestTask()
+*********************************************************************************************************
+*/
+
+static  void  TestTask (void *p_arg)
+{
+    INT8U   err;
+    INT32U  ctx_sw;
+#if OS_SCHED_RR_EN > 0
+    INT32U  ix;
+    INT32U  ticks[RR_NBR_TASKS];
+    INT32U  nbr_stopped;
+#endif
+
+
+    (void)p_arg;
+                                                                /* ---------------- FAIRNESS (Note #1) ---------------- */
+    BurnClr();
+    TEST_CHK(BurnCreate(0, RR_PRIO, OS_TASK_OPT_SCHED_RR) == OS_ERR_NONE);
+    err = BurnCreate(1, RR_PRIO, OS_TASK_OPT_SCHED_RR);
+    (void)BurnCreate(2, RR_PRIO, OS_TASK_OPT_SCHED_RR);
+#if OS_SCHED_RR_EN > 0
+    TEST_CHK(err == OS_ERR_NONE);
+    TEST_CHK(BurnCreate(2, RR_PRIO, OS_TASK_OPT_NONE) == OS_ERR_PRIO_EXIST);
+#else
+    TEST_CHK(err == OS_ERR_PRIO_EXIST);
+#endif
+
+    ctx_sw = OSCtxSwCtr;
+    OSTimeDly(RR_FAIR_TICKS);
+    ctx_sw = OSCtxSwCtr - ctx_sw;
+    printf("fairness: %u %u %u ticks, %u ctx sw\n",
+           (unsigned)BurnTicks[0], (unsigned)BurnTicks[1], (unsigned)BurnTicks[2], (unsigned)ctx_sw);
+#if OS_SCHED_RR_EN > 0
+    for (ix = 0; ix < RR_NBR_TASKS; ix++) {                     /* Each task gets its share, to within a quantum.       */
+        TEST_CHK(Dist(BurnTicks[ix], RR_FAIR_TICKS / RR_NBR_TASKS) <= OS_SCHED_RR_QUANTA);
+    }
+    TEST_CHK(Dist(ctx_sw, RR_FAIR_TICKS / OS_SCHED_RR_QUANTA) <= 2 * RR_NBR_TASKS);
+                                                                /* ------------- SUSPENDED TASK IS SKIPPED ------------- */
+    TEST_CHK(OSTaskSuspend(RR_PRIO) == OS_ERR_NONE);
+    for (ix = 0; ix < RR_NBR_TASKS; ix++) {
+        ticks[ix] = BurnTicks[ix];
+    }
+    OSTimeDly(RR_FAIR_TICKS);
+    nbr_stopped = 0;
+    for (ix = 0; ix < RR_NBR_TASKS; ix++) {
+        ticks[ix] = BurnTicks[ix] - ticks[ix];
+        if (ticks[ix] == 0) {
+            nbr_stopped++;
+        } else {
+            TEST_CHK(Dist(ticks[ix], RR_FAIR_TICKS / 2) <= OS_SCHED_RR_QUANTA);
+        }
+    }
+    TEST_CHK(nbr_stopped == 1);
+    TEST_CHK(OSTaskResume(RR_PRIO) == OS_ERR_NONE);
+                                                                /* --------- DELETING EVERY TASK FREES THE PRIO -------- */
+    for (ix = 0; ix < RR_NBR_TASKS; ix++) {
+        TEST_CHK(OSTaskDel(RR_PRIO) == OS_ERR_NONE);
+        OSTimeDly(OS_SCHED_RR_QUANTA);
+    }
+    TEST_CHK(OSTCBPrioTbl[RR_PRIO] == (OS_TCB *)0);
+    TEST_CHK((OSRdyTbl[RR_PRIO >> 3] & (1 << (RR_PRIO & 7))) == 0);
+                                                                /* ---------- MUTEX OWNER LEAVES THE RING -------------- */
+    Test_Mutex();
+#else
+    TEST_CHK(BurnTicks[0] >= RR_FAIR_TICKS - 1);                /* The one task gets every tick.                        */
+    TEST_CHK(OSTaskDel(RR_PRIO) == OS_ERR_NONE);
+    TEST_CHK(OSTCBPrioTbl[RR_PRIO] == (OS_TCB *)0);
+#endif
+                                                                /* ---------------- OVERHEAD (Note #3) ----------------- */
+    Test_Overhead(1);
+#if OS_SCHED_RR_EN > 0
+    Test_Overhead(RR_NBR_TASKS);
+#endif
+
+#if OS_SCHED_RR_EN > 0
+    Test_Done("test_os_sched_rr (OS_SCHED_RR_EN 1)");
+#else
+    Test_Done("test_os_sched_rr (OS_SCHED_RR_EN 0)");
+#endif
+}
+
+
+int  main (void)
+{
+    OSInit();
+    (void)OSTaskCreateExt(TestTask,
+                          (void *)0,
+                          &TestTaskStk[TEST_TASK_STK_SIZE - 1],
+                          TEST_TASK_PRIO,
+                          TEST_TASK_PRIO,
+                          &TestTaskStk[0],
+                          TEST_TASK_STK_SIZE,
+                          (void *)0,
+                          OS_TASK_OPT_NONE);
+    OSStart();
+    return (0);
+}
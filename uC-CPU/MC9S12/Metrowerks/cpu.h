@@ -232,6 +232,30 @@ typedef  CPU_INT32U  CPU_SR;                                    /* Defines   CPU
 #define  CPU_CRITICAL_EXIT()            { CPU_SR_Restore(cpu_sr); }
 
 
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                      MEMORY BARRIER CONFIGURATION
+*
+* Note(s) : (1) Configure the memory barrier macro's used by lock-free code (e.g. 'lib_mem.c  Mem_SeqRd()'):
+*
+*                   CPU_MB()                            Orders ALL    memory accesses across the barrier
+*                   CPU_RMB()                           Orders memory reads  across the barrier
+*                   CPU_WMB()                           Orders memory writes across the barrier
+*
+*               Neither the compiler NOR the CPU may move an access of the ordered kind across a barrier.
+*
+*           (2) The MC9S12 is a single core that completes its memory accesses in program order, so
+*               only the compiler must be kept from moving accesses.  The compiler does NOT optimize
+*               across inline assembly; one NOP (1 bus cycle) is the least it can be given.
+*********************************************************************************************************
+*/
+
+#define  CPU_MB()                       { __asm NOP; }
+#define  CPU_RMB()                      CPU_MB()
+#define  CPU_WMB()                      CPU_MB()
+
+
 /*
 *********************************************************************************************************
 *                                         FUNCTION PROTOTYPES
@@ -0,0 +1,90 @@
+/*
+*********************************************************************************************************
+*                                               uC/CPU
+*                                    CPU CONFIGURATION & PORT LAYER
+*
+*                          (c) Copyright 2004-2007; Micrium, Inc.; Weston, FL
+*
+*               All rights reserved.  Protected by international copyright laws.
+*
+*               uC/CPU is provided in source form for FREE evaluation, for educational
+*               use or peaceful research.  If you plan on using uC/CPU in a commercial
+*               product you need to contact Micrium to properly license its use in your
+*               product.  We provide ALL the source code for your convenience and to
+*               help you experience uC/CPU.  The fact that the source code is provided
+*               does NOT mean that you can use it without paying a licensing fee.
+*
+*               Knowledge of the source code may NOT be used to develop a similar product.
+*
+*               Please help us continue to provide the Embedded community with the finest
+*               software available.  Your honesty is greatly appreciated.
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*
+*                                            CPU PORT FILE
+*
+*                                            POSIX Host
+*                                            GNU Compiler
+*
+* Filename      : cpu_c.c
+* Version       : V1.18
+* Programmer(s) : EHS
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*                                            INCLUDE FILES
+*********************************************************************************************************
+*/
+
+#define  _GNU_SOURCE                                             /* For PTHREAD_RECURSIVE_MUTEX_INITIALIZER_NP.          */
+
+#include  <cpu.h>
+#include  <pthread.h>
+
+
+/*
+*********************************************************************************************************
+*                                        LOCAL GLOBAL VARIABLES
+*********************************************************************************************************
+*/
+
+static  pthread_mutex_t  CPU_CriticalMutex = PTHREAD_RECURSIVE_MUTEX_INITIALIZER_NP;
+
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                  SAVE THE STATUS AND DISABLE INTERRUPTS
+*                                                  &
+*                                            RESTORE STATUS
+*
+* Description : Enter & exit a critical section (see 'cpu.h  CRITICAL SECTION CONFIGURATION  Note #4').
+*
+* Argument(s) : cpu_sr      Value returned by the matching CPU_SR_Save().
+*
+* Return(s)   : CPU_SR_Save() returns 0; there is no status to save.
+*
+* Caller(s)   : CPU_CRITICAL_ENTER() & CPU_CRITICAL_EXIT().
+*
+* Note(s)     : (1) The mutex is recursive, so critical sections nest as they do on the target.  Each
+*                   CPU_SR_Save() MUST be paired with one CPU_SR_Restore() in the same thread.
+*********************************************************************************************************
+*/
+
+CPU_SR  CPU_SR_Save (void)
+{
+    (void)pthread_mutex_lock(&CPU_CriticalMutex);
+    return ((CPU_SR)0);
+}
+
+
+void  CPU_SR_Restore (CPU_SR  cpu_sr)
+{
+    (void)cpu_sr;
+    (void)pthread_mutex_unlock(&CPU_CriticalMutex);
+}
@@ -0,0 +1,460 @@
+/*
+*********************************************************************************************************
+*                                               uC/LCD
+*                                         LCD Module Driver
+*
+*                              (c) Copyright 2005; Micrium; Weston, FL
+*
+*                   All rights reserved.  Protected by international copyright laws.
+*                   Knowledge of the source code may not be used to write a similar
+*                   product.  This file may only be used in accordance with a license
+*                   and should not be redistributed in any way.
+*********************************************************************************************************
+*/
+
+
+/*
+*********************************************************************************************************
+*                                        HOST DISPLAY BACK END
+*
+* Filename      : lcd_host.c
+* Programmer(s) : JJL
+* Version       : V3.00
+*********************************************************************************************************
+*                                              DESCRIPTION
+*
+*
+* This module emulates an HD44780 based display module on a host computer.  Select it with:
+*
+*     #define  DISP_DRV_SEL  DispDrvHost
+*
+* in app_cfg.h and link it instead of lcd_hd44780.c and the BSP's LCD port functions.
+*
+* Every update (DISP_DRV Flush entry) is drawn on stdout as a frame, redrawn in place when
+* DISP_HOST_ANSI_EN is enabled.  The bytes DispDrvHD44780 would have sent to the module are counted,
+* and the time they would have taken on the bus is accumulated (DISP_HOST_BYTE_US per byte,
+* DISP_HOST_CLR_US for the 'clear display' command).  DispHostStatGet() and DispHostRowGet() let display
+* code be profiled and regression tested without the board.
+*********************************************************************************************************
+*/
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                              INCLUDE FILES
+*********************************************************************************************************
+*/
+
+#include "includes.h"
+#include <stdio.h>
+
+/*
+*********************************************************************************************************
+*                                            LOCAL CONSTANTS
+*********************************************************************************************************
+*/
+
+#define  DISP_HOST_MAX_ROWS         4  /* Largest display supported by uC/LCD                          */
+#define  DISP_HOST_MAX_COLS        DISP_LINE_LEN
+
+/*
+*********************************************************************************************************
+*                                            LOCAL VARIABLES
+*********************************************************************************************************
+*/
+
+static  CPU_INT08U      DispHostMaxRows;
+static  CPU_INT08U      DispHostMaxCols;
+static  CPU_INT08U      DispHostRow;        /* Position the emulated address counter points to         */
+static  CPU_INT08U      DispHostCol;
+static  CPU_INT08U      DispHostShift;      /* Columns the display is shifted left                     */
+static  CPU_BOOLEAN     DispHostDirty;      /* Display changed since the last frame was drawn          */
+
+static  CPU_INT08U      DispHostDDRAM[DISP_HOST_MAX_ROWS][DISP_LINE_LEN];
+static  CPU_INT08U      DispHostRowBuf[DISP_HOST_MAX_COLS + 1];     /* Visible part of a row, see ...  */
+                                                                    /* ... DispHostRowGet()            */
+static  CPU_INT08U      DispHostCG[8][8];   /* Dot patterns of the CGRAM characters                    */
+
+static  DISP_HOST_STAT  DispHostStat;
+
+/*
+*********************************************************************************************************
+*                                        LOCAL FUNCTION PROTOTYPES
+*********************************************************************************************************
+*/
+
+static  void        DispHostInit(CPU_INT08U maxrows, CPU_INT08U maxcols);
+static  void        DispHostCursorSet(CPU_INT08U row, CPU_INT08U col);
+static  void        DispHostWrRun(CPU_INT08U *pdata, CPU_INT08U len);
+static  void        DispHostGlyphDef(CPU_INT08U slot, CPU_INT08U *pat);
+static  void        DispHostClr(void);
+static  void        DispHostShiftWr(CPU_INT08U dir);
+static  void        DispHostFlush(void);
+static  void        DispHostBusWr(CPU_BOOLEAN data, CPU_INT32U us);
+static  CPU_CHAR    DispHostCharGet(CPU_INT08U c);
+
+/*
+*********************************************************************************************************
+*                                            GLOBAL VARIABLES
+*********************************************************************************************************
+*/
+
+const  DISP_DRV  DispDrvHost = {
+    DispHostInit,
+    DispHostCursorSet,
+    DispHostWrRun,
+    DispHostGlyphDef,
+    DispHostClr,
+    DispHostShiftWr,
+    DispHostFlush
+};
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                     GET A ROW OF THE EMULATED DISPLAY
+*
+* Description : This function returns the characters currently visible on a row of the emulated display,
+*               taking the display shift into account.
+* Arguments   : 'row'   is the row, 0 to 'DispMaxRows - 1'
+* Returns     : A pointer to the NUL terminated row, character codes 0 to 7 are CGRAM characters.
+*               A pointer to an empty string if 'row' is out of range.
+* Notes       : The row is returned in a buffer that the next call overwrites.
+*********************************************************************************************************
+*/
+
+CPU_INT08U  *DispHostRowGet (CPU_INT08U row)
+{
+    CPU_INT08U col;
+
+
+    if (row >= DispHostMaxRows) {
+        return ((CPU_INT08U *)"");
+    }
+    for (col = 0; col < DispHostMaxCols; col++) {
+        DispHostRowBuf[col] = DispHostDDRAM[row][(DispHostShift + col) % DISP_LINE_LEN];
+    }
+    DispHostRowBuf[col] = 0;
+    return (&DispHostRowBuf[0]);
+}
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                          CLEAR THE COUNTERS
+*
+* Description : This function zeroes the byte, bus time and update counters.
+* Arguments   : none
+* Returns     : none
+* Notes       : The counters are also cleared by DispInit(), once the display module has been reset.
+*********************************************************************************************************
+*/
+
+void  DispHostStatClr (void)
+{
+    DispHostStat.CmdCtr     = 0;
+    DispHostStat.DataCtr    = 0;
+    DispHostStat.BusTime_uS = 0;
+    DispHostStat.FlushCtr   = 0;
+}
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                           GET THE COUNTERS
+*
+* Description : This function returns a copy of the counters.
+* Arguments   : 'pstat' is a pointer to the structure receiving the counters.
+* Returns     : none
+*********************************************************************************************************
+*/
+
+void  DispHostStatGet (DISP_HOST_STAT *pstat)
+{
+    *pstat = DispHostStat;
+}
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                     INITIALIZE THE DISPLAY MODULE
+*
+* Description : This function resets the emulated display: blank, cursor home, counters cleared.
+* Arguments   : maxrows      specifies the number of lines on the display (1 to 4)
+*               maxcols      specified the number of characters per line (1 to 40)
+* Returns     : none
+*********************************************************************************************************
+*/
+
+static  void  DispHostInit (CPU_INT08U maxrows, CPU_INT08U maxcols)
+{
+    CPU_INT08U i;
+    CPU_INT08U j;
+
+
+    if (maxrows > DISP_HOST_MAX_ROWS) {
+        maxrows = DISP_HOST_MAX_ROWS;
+    }
+    if (maxcols > DISP_HOST_MAX_COLS) {
+        maxcols = DISP_HOST_MAX_COLS;
+    }
+    DispHostMaxRows = maxrows;
+    DispHostMaxCols = maxcols;
+    for (i = 0; i < 8; i++) {                   /* CGRAM content is undefined after power up           */
+        for (j = 0; j < 8; j++) {
+            DispHostCG[i][j] = 0;
+        }
+    }
+    DispHostClr();
+    DispHostStatClr();
+#if DISP_HOST_ANSI_EN > 0
+    printf("\033[2J");                          /* Erase the terminal once, frames are drawn in place  */
+#endif
+}
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                          POSITION THE CURSOR
+*
+* Description : This function positions the emulated address counter.
+* Arguments   : 'row'   is the row    position of the cursor
+*               'col'   is the column position of the cursor
+* Returns     : none
+*********************************************************************************************************
+*/
+
+static  void  DispHostCursorSet (CPU_INT08U row, CPU_INT08U col)
+{
+    DispHostRow = row;
+    DispHostCol = col;
+    DispHostBusWr(DEF_FALSE, DISP_HOST_BYTE_US);
+}
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                          WRITE A RUN OF CHARACTERS
+*
+* Description : This function writes 'len' characters starting at the cursor position.
+* Arguments   : 'pdata' is a pointer to the characters
+*               'len'   is the number of characters to write
+* Returns     : none
+* Notes       : Like DispDrvHD44780, a cursor positioning command is counted when a run crosses the middle
+*               of a 1 line display.
+*********************************************************************************************************
+*/
+
+static  void  DispHostWrRun (CPU_INT08U *pdata, CPU_INT08U len)
+{
+    while (len > 0) {
+        if (DispHostRow < DispHostMaxRows && DispHostCol < DISP_LINE_LEN) {
+            DispHostDDRAM[DispHostRow][DispHostCol] = *pdata;
+        }
+        DispHostBusWr(DEF_TRUE, DISP_HOST_BYTE_US);
+        pdata++;
+        DispHostCol++;
+        len--;
+        if (len > 0 && DispHostMaxRows == 1 && DispHostCol == (DispHostMaxCols >> 1)) {
+            DispHostBusWr(DEF_FALSE, DISP_HOST_BYTE_US);
+        }
+    }
+    DispHostDirty = DEF_TRUE;
+}
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                          WRITE A CGRAM SLOT
+*
+* Description : This function stores an 8 byte dot pattern into one of the emulated CGRAM slots.
+* Arguments   : 'slot'  is the CGRAM slot (i.e. character code) 0 to 7.
+*               'pat'   is a pointer to an 8 BYTE array containing the dot pattern.
+* Returns     : none
+*********************************************************************************************************
+*/
+
+static  void  DispHostGlyphDef (CPU_INT08U slot, CPU_INT08U *pat)
+{
+    CPU_INT08U i;
+
+
+    DispHostBusWr(DEF_FALSE, DISP_HOST_BYTE_US);
+    for (i = 0; i < 8; i++) {
+        DispHostCG[slot & 0x07][i] = *pat++;
+        DispHostBusWr(DEF_TRUE, DISP_HOST_BYTE_US);
+    }
+    DispHostDirty = DEF_TRUE;               /* Characters already on the display change shape too     */
+}
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                            CLEAR THE DISPLAY
+*
+* Description : This function blanks the emulated display, returns the cursor home and cancels the shift.
+* Arguments   : none
+* Returns     : none
+*********************************************************************************************************
+*/
+
+static  void  DispHostClr (void)
+{
+    CPU_INT08U row;
+    CPU_INT08U col;
+
+
+    for (row = 0; row < DispHostMaxRows; row++) {
+        for (col = 0; col < DISP_LINE_LEN; col++) {
+            DispHostDDRAM[row][col] = ' ';
+        }
+    }
+    DispHostRow   = 0;
+    DispHostCol   = 0;
+    DispHostShift = 0;
+    DispHostDirty = DEF_TRUE;
+    DispHostBusWr(DEF_FALSE, DISP_HOST_CLR_US);
+}
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                            SHIFT THE DISPLAY
+*
+* Description : This function moves the emulated display window one column over DDRAM.
+* Arguments   : 'dir'   is DISP_SHIFT_LEFT  to move the text left, or
+*                          DISP_SHIFT_RIGHT to move the text right.
+* Returns     : none
+*********************************************************************************************************
+*/
+
+static  void  DispHostShiftWr (CPU_INT08U dir)
+{
+    if (dir == DISP_SHIFT_LEFT) {
+        DispHostShift = (DispHostShift + 1) % DISP_LINE_LEN;
+    } else {
+        DispHostShift = (DispHostShift + DISP_LINE_LEN - 1) % DISP_LINE_LEN;
+    }
+    DispHostDirty = DEF_TRUE;
+    DispHostBusWr(DEF_FALSE, DISP_HOST_BYTE_US);
+}
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                             END OF AN UPDATE
+*
+* Description : This function draws the display on stdout if it changed since the last frame.
+* Arguments   : none
+* Returns     : none
+*********************************************************************************************************
+*/
+
+static  void  DispHostFlush (void)
+{
+    CPU_INT08U  row;
+    CPU_INT08U  col;
+    CPU_INT08U *prow;
+
+
+    DispHostStat.FlushCtr++;
+    if (DispHostDirty == DEF_FALSE) {
+        return;
+    }
+    DispHostDirty = DEF_FALSE;
+
+#if DISP_HOST_ANSI_EN > 0
+    printf("\033[H");                       /* Cursor home, draw over the previous frame               */
+#endif
+    putchar('+');
+    for (col = 0; col < DispHostMaxCols; col++) {
+        putchar('-');
+    }
+    printf("+\n");
+    for (row = 0; row < DispHostMaxRows; row++) {
+        putchar('|');
+        prow = DispHostRowGet(row);
+        for (col = 0; col < DispHostMaxCols; col++) {
+            putchar(DispHostCharGet(prow[col]));
+        }
+        printf("|\n");
+    }
+    putchar('+');
+    for (col = 0; col < DispHostMaxCols; col++) {
+        putchar('-');
+    }
+    printf("+\n");
+    printf("cmd %lu  data %lu  bus %lu uS  updates %lu\n",
+           (unsigned long)DispHostStat.CmdCtr,
+           (unsigned long)DispHostStat.DataCtr,
+           (unsigned long)DispHostStat.BusTime_uS,
+           (unsigned long)DispHostStat.FlushCtr);
+    fflush(stdout);
+}
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                    ACCOUNT FOR A BYTE ON THE BUS (Internal)
+*
+* Description : This function counts a byte DispDrvHD44780 would have sent, and the time it would take.
+* Arguments   : 'data'  is DEF_TRUE for a data byte, DEF_FALSE for an instruction.
+*               'us'    is the time the byte takes to send and execute (in microseconds).
+* Returns     : none
+*********************************************************************************************************
+*/
+
+static  void  DispHostBusWr (CPU_BOOLEAN data, CPU_INT32U us)
+{
+    if (data == DEF_TRUE) {
+        DispHostStat.DataCtr++;
+    } else {
+        DispHostStat.CmdCtr++;
+    }
+    DispHostStat.BusTime_uS += us;
+}
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                  GET THE TERMINAL CHARACTER FOR A CODE (Internal)
+*
+* Description : This function returns the character drawn for an HD44780 character code.  CGRAM characters
+*               are drawn by how many of their 40 dots are lit: ' ', '.', ':', '+' or '#'.
+* Arguments   : 'c'     is the character code
+* Returns     : The character to print.
+*********************************************************************************************************
+*/
+
+static  CPU_CHAR  DispHostCharGet (CPU_INT08U c)
+{
+    CPU_INT08U  i;
+    CPU_INT08U  bits;
+    CPU_INT08U  dots;
+
+
+    if (c < 16) {                           /* Codes 8 to 15 are aliases of the CGRAM characters       */
+        dots = 0;
+        for (i = 0; i < 8; i++) {
+            bits = DispHostCG[c & 0x07][i] & 0x1F;
+            while (bits != 0) {
+                dots += bits & 0x01;
+                bits >>= 1;
+            }
+        }
+        if (dots == 0) {
+            return (' ');
+        } else if (dots <= 10) {
+            return ('.');
+        } else if (dots <= 20) {
+            return (':');
+        } else if (dots <= 30) {
+            return ('+');
+        }
+        return ('#');
+    }
+    if (c < 0x20 || c > 0x7D) {             /* Not in the ASCII part of the character generator ROM   */
+        return ('?');
+    }
+    return ((CPU_CHAR)c);
+}
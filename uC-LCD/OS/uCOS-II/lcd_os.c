@@ -39,6 +39,32 @@
 
 static  OS_EVENT   *DispSem;                /* Semaphore used to access display functions              */
 
+#if DISP_SCROLL_EN > 0
+static  OS_TMR     *DispTmr;                /* Periodic timer that scrolls the display                 */
+#endif
+
+#if DISP_TASK_EN > 0
+static  OS_EVENT   *DispQ;                  /* Queue of commands for the LCD task                      */
+static  void       *DispQTbl[DISP_TASK_Q_SIZE];
+static  OS_MEM     *DispCmdMem;             /* Partition of free command blocks                        */
+static  DISP_CMD    DispCmdTbl[DISP_TASK_Q_SIZE];
+static  OS_STK      DispTaskStk[DISP_TASK_STK_SIZE];
+
+        CPU_INT16U  DispCmdOvfCtr;          /* Number of commands dropped because the queue was full   */
+
+/*
+*********************************************************************************************************
+*                                        LOCAL FUNCTION PROTOTYPES
+*********************************************************************************************************
+*/
+
+static  void        DispTask(void *p_arg);
+#endif
+
+#if DISP_SCROLL_EN > 0
+static  void        DispTmrCallback(void *ptmr, void *p_arg);
+#endif
+
 /*
 *********************************************************************************************************
 *                                       INITIALIZE RTOS SERVICES
@@ -46,6 +72,10 @@ static  OS_EVENT   *DispSem;                /* Semaphore used to access display
 * Description : This function creates a semaphore to ensure exclusive access to the LCD module and thus
 *               provide thread safe access to the display.
 *
+*               With DISP_TASK_EN, it also creates the LCD task, the queue that feeds it and the partition
+*               of command blocks.  There are as many command blocks as queue entries so a command block
+*               can always be queued.
+*
 * Arguments   : none
 *
 * Returns     : none
@@ -54,15 +84,43 @@ static  OS_EVENT   *DispSem;                /* Semaphore used to access display
 
 void  DispInitOS (void)
 {
-#if OS_EVENT_NAME_SIZE > 11
+#if (OS_EVENT_NAME_SIZE > 11) || (DISP_TASK_EN > 0)
     INT8U  err;
 #endif
 
 
     DispSem  = OSSemCreate(1);              /* Create display access semaphore                         */
+#if DISP_SCROLL_EN > 0
+    DispTmr  = (OS_TMR *)0;                 /* Scroll timer is only created by DispScrollStart()       */
+#endif
 #if OS_EVENT_NAME_SIZE > 11
     OSEventNameSet(DispSem, (INT8U *)"uC/LCD Lock", &err);
 #endif
+
+#if DISP_TASK_EN > 0
+    DispCmdOvfCtr = 0;
+    DispQ         = OSQCreate(&DispQTbl[0], DISP_TASK_Q_SIZE);
+#if OS_EVENT_NAME_SIZE > 10
+    OSEventNameSet(DispQ, (INT8U *)"uC/LCD Q", &err);
+#endif
+    DispCmdMem    = OSMemCreate((void *)&DispCmdTbl[0], DISP_TASK_Q_SIZE, sizeof(DISP_CMD), &err);
+#if OS_MEM_NAME_SIZE > 10
+    OSMemNameSet(DispCmdMem, (INT8U *)"uC/LCD Cmd", &err);
+#endif
+
+    (void)OSTaskCreateExt(DispTask,
+                          (void *)0,
+                          (OS_STK *)&DispTaskStk[DISP_TASK_STK_SIZE - 1],
+                          DISP_TASK_PRIO,
+                          DISP_TASK_PRIO,
+                          (OS_STK *)&DispTaskStk[0],
+                          DISP_TASK_STK_SIZE,
+                          (void *)0,
+                          OS_TASK_OPT_STK_CHK | OS_TASK_OPT_STK_CLR);
+#if OS_TASK_NAME_SIZE > 12
+    OSTaskNameSet(DISP_TASK_PRIO, (INT8U *)"uC/LCD Task", &err);
+#endif
+#endif
 }
 
 /*
@@ -91,3 +149,165 @@ void  DispUnlock (void)
 {
     OSSemPost(DispSem);                     /* Release access to display                               */
 }
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                            SCROLL TIMER
+*
+* Description : DispTmrStart() creates and starts a periodic timer that calls DispScrollStep() every
+*               'period' timer ticks.  A timer that is already running is replaced.  DispTmrStop() deletes
+*               the timer.
+*
+* Arguments   : period   is the time between two calls, in timer ticks (see OS_TMR_CFG_TICKS_PER_SEC)
+*
+* Returns     : DispTmrStart() returns DEF_OK if the timer is running, DEF_FAIL if no timer is available.
+*
+* Note(s)     : DispScrollStep() runs in the context of the timer task.
+*********************************************************************************************************
+*/
+
+#if DISP_SCROLL_EN > 0
+CPU_BOOLEAN  DispTmrStart (CPU_INT16U period)
+{
+    INT8U  err;
+
+
+    DispTmrStop();
+    DispTmr = OSTmrCreate(period,
+                          period,
+                          OS_TMR_OPT_PERIODIC,
+                          DispTmrCallback,
+                          (void *)0,
+                          (INT8U *)"uC/LCD Scroll",
+                          &err);
+    if (DispTmr == (OS_TMR *)0) {
+        return (DEF_FAIL);
+    }
+    (void)OSTmrStart(DispTmr, &err);
+    return (DEF_OK);
+}
+
+
+
+void  DispTmrStop (void)
+{
+    INT8U  err;
+
+
+    if (DispTmr != (OS_TMR *)0) {
+        (void)OSTmrDel(DispTmr, &err);
+        DispTmr = (OS_TMR *)0;
+    }
+}
+
+
+
+static  void  DispTmrCallback (void *ptmr, void *p_arg)
+{
+    (void)ptmr;
+    (void)p_arg;
+    DispScrollStep();
+}
+#endif
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                         LCD TASK COMMAND QUEUE
+*
+* Description : DispCmdGet() returns a free command block, DispCmdPost() queues a filled command block to
+*               the LCD task.  Neither function blocks the caller.
+*
+* Arguments   : pcmd     is a pointer to a command block obtained from DispCmdGet()
+*
+* Returns     : DispCmdGet() returns a pointer to the command block, or a NULL pointer if all command
+*               blocks are in use.  In this case the command is dropped and DispCmdOvfCtr is incremented.
+*********************************************************************************************************
+*/
+
+#if DISP_TASK_EN > 0
+DISP_CMD  *DispCmdGet (void)
+{
+    DISP_CMD  *pcmd;
+    INT8U      err;
+
+
+    pcmd = (DISP_CMD *)OSMemGet(DispCmdMem, &err);
+    if (err != OS_ERR_NONE) {
+        DispCmdOvfCtr++;                    /* Display is too far behind, drop the command             */
+        return ((DISP_CMD *)0);
+    }
+    return (pcmd);
+}
+
+
+
+void  DispCmdPost (DISP_CMD *pcmd)
+{
+    if (OSQPost(DispQ, (void *)pcmd) != OS_ERR_NONE) {
+        (void)OSMemPut(DispCmdMem, (void *)pcmd);
+        DispCmdOvfCtr++;
+    }
+}
+
+/*
+*********************************************************************************************************
+*                                          SIGNAL COMPLETION
+*
+* Description : This function is called by the LCD task to signal the semaphore passed to DispNotify().
+*
+* Arguments   : p_done   is a pointer to the semaphore, may be NULL
+*
+* Returns     : none
+*********************************************************************************************************
+*/
+
+void  DispSignal (void *p_done)
+{
+    if (p_done != (void *)0) {
+        (void)OSSemPost((OS_EVENT *)p_done);
+    }
+}
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                              LCD TASK
+*
+* Description : This task owns the LCD module.  It performs the queued commands in order and, when the
+*               queue is empty, sends the accumulated changes to the display with a single flush.
+*
+* Arguments   : p_arg    is not used
+*
+* Returns     : none
+*
+* Note(s)     : Each command is copied and its block freed before it is performed.  DISP_CMD_NOTIFY wakes
+*               a task that usually has a higher priority: when it runs, every command block MUST already
+*               be free again.
+*********************************************************************************************************
+*/
+
+static  void  DispTask (void *p_arg)
+{
+    DISP_CMD  *pcmd;
+    DISP_CMD   cmd;
+    INT8U      err;
+
+
+    (void)p_arg;
+    while (DEF_TRUE) {
+        pcmd = (DISP_CMD *)OSQPend(DispQ, 0, &err);
+        while (pcmd != (DISP_CMD *)0) {     /* Perform all the commands queued so far ...              */
+            cmd = *pcmd;                    /* See Note                                                */
+            (void)OSMemPut(DispCmdMem, (void *)pcmd);
+            DispCmdExec(&cmd);
+            pcmd = (DISP_CMD *)OSQAccept(DispQ, &err);
+        }
+#if DISP_SHADOW_EN > 0
+        cmd.Type = DISP_CMD_FLUSH;
+        DispCmdExec(&cmd);                  /* ... then update the display once                        */
+#endif
+    }
+}
+#endif
@@ -35,6 +35,9 @@
 *     1 line  x 20 characters     2 lines x 20 characters     4 lines x 20 characters
 *     1 line  x 24 characters     2 lines x 24 characters
 *     1 line  x 40 characters     2 lines x 40 characters
+*
+* The display module is reached through a back end (see DISP_DRV_SEL): DispDrvHD44780 (lcd_hd44780.c)
+* on the target, or DispDrvHost (lcd_host.c) to render and profile the display on a host computer.
 *********************************************************************************************************
 */
 
@@ -53,20 +56,10 @@
 *********************************************************************************************************
 */
 
-                                       /* ---------------------- HD44780 COMMANDS -------------------- */
-#define  DISP_CMD_CLS            0x01  /* Clr display : clears display and returns cursor home         */
-
-#if      DISP_BUS_WIDTH == 4
-#define  DISP_CMD_FNCT           0x28  /* Function Set: Set 4 bit data length, 1/16 duty, 5x8 dots     */
-#else
-#define  DISP_CMD_FNCT           0x38  /* Function Set: Set 8 bit data length, 1/16 duty, 5x8 dots     */
-#endif
-
-#define  DISP_CMD_FNCT_INIT8     0x30  /* Function Set: 8 bit mode, no options                         */
-#define  DISP_CMD_FNCT_INIT4     0x20  /* Function Set: 4 bit mode, no options                         */
-
-#define  DISP_CMD_MODE           0x06  /* Entry mode  : Inc. display data address when writing         */
-#define  DISP_CMD_ON_OFF         0x0C  /* Disp ON/OFF : Display ON, cursor OFF and no BLINK character  */
+                                       /* ------------------------ CGRAM CACHE ----------------------- */
+#define  DISP_CG_NBR_SLOTS          8  /* Number of user definable characters in CGRAM                 */
+#define  DISP_CG_SLOT_NONE       0xFF  /* No CGRAM slot could be allocated                             */
+#define  DISP_GLYPH_RSVD         0xFF  /* Slot was defined with DispDefChar(), never evicted           */
 
 /*
 *********************************************************************************************************
@@ -74,9 +67,21 @@
 *********************************************************************************************************
 */
 
+static  const  DISP_DRV  *DispDrv = &DISP_DRV_SEL;  /* Back end the display module is reached through   */
+
 static  CPU_INT08U   DispMaxCols;      /* Maximum number of columns (i.e. characters per line)         */
 static  CPU_INT08U   DispMaxRows;      /* Maximum number of rows for the display                       */
 
+#if DISP_SCROLL_EN > 0
+static  CPU_INT08U   DispShiftPos;     /* Columns the display is shifted left, 0 to DISP_LINE_LEN - 1  */
+#endif
+
+#if DISP_SHADOW_EN > 0                 /* Characters the application wants on the display ...          */
+static  CPU_INT08U   DispShadow[DISP_SHADOW_MAX_ROWS][DISP_SHADOW_MAX_COLS];
+                                       /* ... and characters the LCD module is currently showing       */
+static  CPU_INT08U   DispScreen[DISP_SHADOW_MAX_ROWS][DISP_SHADOW_MAX_COLS];
+#endif
+
 
 static  CPU_INT08U   DispHorBar1[]  = {0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10};
 static  CPU_INT08U   DispHorBar2[]  = {0x18, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18};
@@ -93,13 +98,48 @@ static  CPU_INT08U   DispVertBar6[] = {0x00, 0x00, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F,
 static  CPU_INT08U   DispVertBar7[] = {0x00, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F};
 static  CPU_INT08U   DispVertBar8[] = {0x1F, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F};
 
+static  CPU_INT08U  *DispHorBarTbl[]  = {DispHorBar1,  DispHorBar2,  DispHorBar3,  DispHorBar4,
+                                         DispHorBar5};
+
+static  CPU_INT08U  *DispVertBarTbl[] = {DispVertBar1, DispVertBar2, DispVertBar3, DispVertBar4,
+                                         DispVertBar5, DispVertBar6, DispVertBar7, DispVertBar8};
+
+static  CPU_INT08U   DispCGId[DISP_CG_NBR_SLOTS];   /* Glyph held by each CGRAM slot                   */
+static  CPU_INT08U   DispCGLRU[DISP_CG_NBR_SLOTS];  /* CGRAM slots, most recently used first           */
+
 /*
 *********************************************************************************************************
 *                                        LOCAL FUNCTION PROTOTYPES
 *********************************************************************************************************
 */
 
-static  void         DispCursorSet(CPU_INT08U row, CPU_INT08U col);
+static  void         DispCharWr(CPU_INT08U row, CPU_INT08U col, CPU_INT08U c);
+static  void         DispClrLineWr(CPU_INT08U line);
+static  void         DispClrScrWr(void);
+static  void         DispDefCharWr(CPU_INT08U id, CPU_INT08U *pat);
+static  void         DispGlyphWr(CPU_INT08U row, CPU_INT08U col, CPU_INT08U id, CPU_INT08U *pat);
+static  CPU_INT08U   DispGlyphLoad(CPU_INT08U id, CPU_INT08U *pat);
+static  void         DispGlyphTouch(CPU_INT08U slot);
+static  CPU_INT08U   DispGlyphVictim(void);
+#if DISP_SHADOW_EN > 0
+static  void         DispFlushWr(void);
+#endif
+static  void         DispHorBarWr(CPU_INT08U row, CPU_INT08U col, CPU_INT08U val);
+static  void         DispVertBarWr(CPU_INT08U row, CPU_INT08U col, CPU_INT08U val);
+static  void         DispStrWr(CPU_INT08U row, CPU_INT08U col, CPU_INT08U *s);
+#if DISP_SHADOW_EN == 0
+static  void         DispRunWr(CPU_INT08U row, CPU_INT08U col, CPU_INT08U *pdata, CPU_INT08U len);
+#endif
+#if DISP_SCROLL_EN > 0
+static  void         DispScrollStrWr(CPU_INT08U row, CPU_INT08U col, CPU_INT08U *s);
+static  void         DispScrollStepWr(void);
+static  void         DispScrollHomeWr(void);
+#endif
+
+#if DISP_TASK_EN > 0
+static  void         DispCmdSend(CPU_INT08U type, CPU_INT08U row, CPU_INT08U col, CPU_INT08U val,
+                                 CPU_INT08U *pdata, CPU_INT08U len);
+#endif
 
 /*$PAGE*/
 /*
@@ -117,12 +157,35 @@ static  void         DispCursorSet(CPU_INT08U row, CPU_INT08U col);
 */
 
 void  DispChar (CPU_INT08U row, CPU_INT08U col, CPU_INT08U c)
+{
+#if DISP_TASK_EN > 0
+    DispCmdSend(DISP_CMD_CHAR, row, col, c, (CPU_INT08U *)0, 0);
+#else
+    DispCharWr(row, col, c);
+#endif
+}
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                     DISPLAY A CHARACTER (Internal)
+*
+* Description : This function performs DispChar() on the LCD module.  It runs in the caller's context, or
+*               in the LCD task when DISP_TASK_EN is enabled.
+* Arguments   : see DispChar()
+* Returns     : none
+*********************************************************************************************************
+*/
+
+static  void  DispCharWr (CPU_INT08U row, CPU_INT08U col, CPU_INT08U c)
 {
     if (row < DispMaxRows && col < DispMaxCols) {
         DispLock();
-        DispCursorSet(row, col);            /* Position cursor at ROW/COL                              */
-        DispSel(DISP_SEL_DATA_REG);
-        DispDataWr(c);                      /* Send character to display                               */
+#if DISP_SHADOW_EN > 0
+        DispShadow[row][col] = c;           /* Update off-screen copy, sent by DispFlush()             */
+#else
+        DispRunWr(row, col, &c, 1);         /* Send character to display at ROW/COL                    */
+#endif
         DispUnlock();
     }
 }
@@ -141,18 +204,45 @@ void  DispChar (CPU_INT08U row, CPU_INT08U col, CPU_INT08U c)
 */
 
 void  DispClrLine (CPU_INT08U line)
+{
+#if DISP_TASK_EN > 0
+    DispCmdSend(DISP_CMD_CLR_LINE, line, 0, 0, (CPU_INT08U *)0, 0);
+#else
+    DispClrLineWr(line);
+#endif
+}
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                         CLEAR LINE (Internal)
+*
+* Description : This function performs DispClrLine() on the LCD module.  It runs in the caller's context, or
+*               in the LCD task when DISP_TASK_EN is enabled.
+* Arguments   : see DispClrLine()
+* Returns     : none
+*********************************************************************************************************
+*/
+
+static  void  DispClrLineWr (CPU_INT08U line)
 {
     CPU_INT08U i;
 
 
     if (line < DispMaxRows) {
         DispLock();
-        DispCursorSet(line, 0);                  /* Position cursor at begin of the line to clear      */
-        DispSel(DISP_SEL_DATA_REG);              /* Select the LCD Display DATA register               */
+#if DISP_SHADOW_EN > 0
         for (i = 0; i < DispMaxCols; i++) {      /* Write ' ' into all column positions of that line   */
-            DispDataWr(' ');                     /* Write an ASCII space at current cursor position    */
+            DispShadow[line][i] = ' ';
         }
-        DispCursorSet(line, 0);                  /* Position cursor at begin of the line to clear      */
+#else
+        DispDrv->CursorSet(line, 0);             /* Position cursor at begin of the line to clear      */
+        for (i = 0; i < DispMaxCols; i++) {      /* Write ' ' into all column positions of that line   */
+            DispDrv->WrRun((CPU_INT08U *)" ", 1);/* Write an ASCII space at current cursor position    */
+        }
+        DispDrv->CursorSet(line, 0);             /* Position cursor at begin of the line to clear      */
+        DispDrv->Flush();
+#endif
         DispUnlock();
     }
 }
@@ -165,60 +255,65 @@ void  DispClrLine (CPU_INT08U line)
 * Description : This function clears the display
 * Arguments   : none
 * Returns     : none
+* Notes       : With DISP_SHADOW_EN, only the off-screen copy is cleared.  DispFlush() then blanks the
+*               cells that are not already blank instead of issuing the 2 mS 'clear display' command.
+*               With DISP_SCROLL_EN as well, the 'clear display' command is sent right away: the off-screen
+*               copy only covers the visible columns, not the rest of DDRAM nor the display shift.
 *********************************************************************************************************
 */
 
 void  DispClrScr (void)
 {
-    DispLock();
-    DispSel(DISP_SEL_CMD_REG);         /* Select the LCD display command register                      */
-    DispDataWr(DISP_CMD_CLS);          /* Send command to LCD display to clear the display             */
-    DispDly_uS(2000);                  /* Delay at least  2 mS                                         */
-    DispUnlock();
+#if DISP_TASK_EN > 0
+    DispCmdSend(DISP_CMD_CLR_SCR, 0, 0, 0, (CPU_INT08U *)0, 0);
+#else
+    DispClrScrWr();
+#endif
 }
 
 /*$PAGE*/
 /*
 *********************************************************************************************************
-*                                     POSITION THE CURSOR (Internal)
+*                                      CLEAR THE SCREEN (Internal)
 *
-* Description : This function positions the cursor into the LCD buffer
-* Arguments   : 'row'   is the row    position of the cursor in the LCD Display
-*                       'row' can be a value from 0 to 'DispMaxRows - 1'
-*               'col'   is the column position of the cursor in the LCD Display
-*                       'col' can be a value from 0 to 'DispMaxCols - 1'
+* Description : This function performs DispClrScr() on the LCD module.  It runs in the caller's context, or
+*               in the LCD task when DISP_TASK_EN is enabled.
+* Arguments   : see DispClrScr()
 * Returns     : none
 *********************************************************************************************************
 */
 
-static  void  DispCursorSet (CPU_INT08U row, CPU_INT08U col)
+static  void  DispClrScrWr (void)
 {
-    DispSel(DISP_SEL_CMD_REG);                             /* Select LCD display command register      */
-    switch (row) {
-        case 0:
-             if (DispMaxRows == 1) {                       /* Handle special case when only one line   */
-                 if (col < (DispMaxCols >> 1)) {
-                     DispDataWr(0x80 + col);               /* First  half of the line starts at 0x80   */
-                 } else {                                  /* Second half of the line starts at 0xC0   */
-                     DispDataWr(0xC0 + col - (DispMaxCols >> 1));
-                 }
-             } else {
-                 DispDataWr(0x80 + col);                   /* Select LCD's display line 1              */
-             }
-             break;
-
-        case 1:
-             DispDataWr(0xC0 + col);                       /* Select LCD's display line 2              */
-             break;
+#if DISP_SHADOW_EN > 0
+    CPU_INT08U row;
+    CPU_INT08U col;
 
-        case 2:
-             DispDataWr(0x80 + DispMaxCols + col);         /* Select LCD's display line 3              */
-             break;
 
-        case 3:
-             DispDataWr(0xC0 + DispMaxCols + col);         /* Select LCD's display line 4              */
-             break;
+    DispLock();
+    for (row = 0; row < DispMaxRows; row++) {
+        for (col = 0; col < DispMaxCols; col++) {
+            DispShadow[row][col] = ' ';
+#if DISP_SCROLL_EN > 0
+            DispScreen[row][col] = ' ';    /* Display is blank after the 'clear display' command below */
+#endif
+        }
     }
+#if DISP_SCROLL_EN > 0
+    DispDrv->Clr();                    /* Also blanks the off screen DDRAM columns                     */
+    DispShiftPos = 0;                  /* 'clear display' also cancels the display shift               */
+    DispDrv->Flush();
+#endif
+    DispUnlock();
+#else
+    DispLock();
+    DispDrv->Clr();                    /* Send command to LCD display to clear the display             */
+#if DISP_SCROLL_EN > 0
+    DispShiftPos = 0;                  /* 'clear display' also cancels the display shift               */
+#endif
+    DispDrv->Flush();
+    DispUnlock();
+#endif
 }
 
 /*$PAGE*/
@@ -230,21 +325,37 @@ static  void  DispCursorSet (CPU_INT08U row, CPU_INT08U col)
 * Arguments   : 'id'    is the identifier for the desired dot pattern.
 *               'pat'   is a pointer to an 8 BYTE array containing the dot pattern.
 * Returns     : None.
+* Notes       : The CGRAM slot 'id' is taken out of the glyph cache (see DispGlyph()) until DispInit().
 *********************************************************************************************************
 */
 
 void  DispDefChar (CPU_INT08U id, CPU_INT08U *pat)
 {
-    CPU_INT08U i;
+#if DISP_TASK_EN > 0
+    DispCmdSend(DISP_CMD_DEF_CHAR, 0, 0, id, pat, 8);
+#else
+    DispDefCharWr(id, pat);
+#endif
+}
 
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                      DEFINE CHARACTER (Internal)
+*
+* Description : This function performs DispDefChar() on the LCD module.  It runs in the caller's context, or
+*               in the LCD task when DISP_TASK_EN is enabled.
+* Arguments   : see DispDefChar()
+* Returns     : none
+*********************************************************************************************************
+*/
 
+static  void  DispDefCharWr (CPU_INT08U id, CPU_INT08U *pat)
+{
+    id &= DISP_CG_NBR_SLOTS - 1;
     DispLock();
-    DispSel(DISP_SEL_CMD_REG);              /* Select command register                                 */
-    DispDataWr(0x40 + (id << 3));           /* Set address of CG RAM                                   */
-    DispSel(DISP_SEL_DATA_REG);             /* Select the data register                                */
-    for (i = 0; i < 8; i++) {
-        DispDataWr(*pat++);                 /* Write pattern into CG RAM                               */
-    }
+    DispDrv->GlyphDef(id, pat);
+    DispCGId[id] = DISP_GLYPH_RSVD;         /* Application owns this slot, the cache must not evict it */
     DispUnlock();
 }
 
@@ -264,6 +375,256 @@ void  DispDummy (void)
 {
 }
 
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                      SEND CHANGES TO THE DISPLAY
+*
+* Description : This function sends to the LCD module the characters that changed in the off-screen copy
+*               since the last call.  Adjacent changed characters are sent as a burst after a single
+*               cursor positioning command.
+* Arguments   : none
+* Returns     : none
+* Notes       : - DispChar(), DispClrLine(), DispClrScr(), DispHorBar(), DispVertBar() and DispStr() only
+*                 update the off-screen copy when DISP_SHADOW_EN is enabled.  Call DispFlush() once the
+*                 screen has been updated.
+*               - The back end increments its address after each character, so the cursor only needs to
+*                 be positioned at the start of each run of changed characters.
+*********************************************************************************************************
+*/
+
+#if DISP_SHADOW_EN > 0
+void  DispFlush (void)
+{
+#if DISP_TASK_EN > 0
+    DispCmdSend(DISP_CMD_FLUSH, 0, 0, 0, (CPU_INT08U *)0, 0);
+#else
+    DispFlushWr();
+#endif
+}
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                 SEND CHANGES TO THE DISPLAY (Internal)
+*
+* Description : This function performs DispFlush() on the LCD module.  It runs in the caller's context, or
+*               in the LCD task when DISP_TASK_EN is enabled.
+* Arguments   : see DispFlush()
+* Returns     : none
+*********************************************************************************************************
+*/
+
+static  void  DispFlushWr (void)
+{
+    CPU_INT08U row;
+    CPU_INT08U col;
+    CPU_INT08U start;                                      /* First column of a run of changes         */
+
+
+    DispLock();
+    for (row = 0; row < DispMaxRows; row++) {
+        col = 0;
+        while (col < DispMaxCols) {
+            if (DispShadow[row][col] == DispScreen[row][col]) {
+                col++;                                     /* Only send characters that changed        */
+            } else {
+                start = col;
+                while (col < DispMaxCols && DispShadow[row][col] != DispScreen[row][col]) {
+                    DispScreen[row][col] = DispShadow[row][col];
+                    col++;
+                }
+                DispDrv->CursorSet(row, start);            /* One cursor positioning per run           */
+                DispDrv->WrRun(&DispShadow[row][start], col - start);
+            }
+        }
+    }
+    DispDrv->Flush();
+    DispUnlock();
+}
+#endif
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                          DISPLAY A CUSTOM GLYPH
+*
+* Description : This function displays a custom character identified by 'id'.  The 8 CGRAM slots of the
+*               HD44780 are managed as a cache: the dot pattern is only sent to the LCD module when the
+*               glyph is not already resident, replacing the least recently used glyph.
+* Arguments   : 'row'   is the row    position of the glyph in the LCD Display
+*                       'row' can be a value from 0 to 'DispMaxRows - 1'
+*               'col'   is the column position of the glyph in the LCD Display
+*                       'col' can be a value from 0 to 'DispMaxCols - 1'
+*               'id'    identifies the glyph, from DISP_GLYPH_USER to 254.  Lower values are used by the
+*                       bar graphs.
+*               'pat'   is a pointer to an 8 BYTE array containing the dot pattern of glyph 'id'.
+* Returns     : none
+* Notes       : - A glyph that is on the display (with DISP_SHADOW_EN, or about to be) is only replaced
+*                 when every other slot is also in use.
+*               - A blank is displayed if all CGRAM slots were taken with DispDefChar().
+*********************************************************************************************************
+*/
+
+void  DispGlyph (CPU_INT08U row, CPU_INT08U col, CPU_INT08U id, CPU_INT08U *pat)
+{
+#if DISP_TASK_EN > 0
+    DispCmdSend(DISP_CMD_GLYPH, row, col, id, pat, 8);
+#else
+    DispGlyphWr(row, col, id, pat);
+#endif
+}
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                     DISPLAY A CUSTOM GLYPH (Internal)
+*
+* Description : This function performs DispGlyph() on the LCD module.  It runs in the caller's context, or
+*               in the LCD task when DISP_TASK_EN is enabled.
+* Arguments   : see DispGlyph()
+* Returns     : none
+*********************************************************************************************************
+*/
+
+static  void  DispGlyphWr (CPU_INT08U row, CPU_INT08U col, CPU_INT08U id, CPU_INT08U *pat)
+{
+    CPU_INT08U c;
+
+
+    if (row < DispMaxRows && col < DispMaxCols) {
+        DispLock();
+        c = DispGlyphLoad(id, pat);
+        if (c == DISP_CG_SLOT_NONE) {
+            c = ' ';
+        }
+#if DISP_SHADOW_EN > 0
+        DispShadow[row][col] = c;
+#else
+        DispRunWr(row, col, &c, 1);
+#endif
+        DispUnlock();
+    }
+}
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                       LOAD A GLYPH INTO CGRAM (Internal)
+*
+* Description : This function looks up glyph 'id' in the CGRAM cache.  On a miss, the pattern is written
+*               into the slot chosen by DispGlyphVictim().
+* Arguments   : 'id'    identifies the glyph
+*               'pat'   is a pointer to an 8 BYTE array containing the dot pattern of glyph 'id'.
+* Returns     : The character code (0 to 7) to write to display the glyph, or
+*               DISP_CG_SLOT_NONE if every slot is reserved by DispDefChar().
+* Notes       : The caller must own the display (see DispLock()).
+*********************************************************************************************************
+*/
+
+static  CPU_INT08U  DispGlyphLoad (CPU_INT08U id, CPU_INT08U *pat)
+{
+    CPU_INT08U slot;
+
+
+    for (slot = 0; slot < DISP_CG_NBR_SLOTS; slot++) {
+        if (DispCGId[slot] == id) {         /* Hit: the glyph is already in CGRAM                      */
+            DispGlyphTouch(slot);
+            return (slot);
+        }
+    }
+    slot = DispGlyphVictim();               /* Miss: replace the least recently used glyph             */
+    if (slot != DISP_CG_SLOT_NONE) {
+        DispDrv->GlyphDef(slot, pat);
+        DispCGId[slot] = id;
+        DispGlyphTouch(slot);
+    }
+    return (slot);
+}
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                    MARK A GLYPH AS RECENTLY USED (Internal)
+*
+* Description : This function moves 'slot' to the front of the LRU list.
+* Arguments   : 'slot'  is the CGRAM slot that was just used
+* Returns     : none
+*********************************************************************************************************
+*/
+
+static  void  DispGlyphTouch (CPU_INT08U slot)
+{
+    CPU_INT08U i;
+
+
+    i = 0;
+    while (DispCGLRU[i] != slot) {          /* Find the slot in the list                               */
+        i++;
+    }
+    while (i > 0) {                         /* Shift the more recently used slots down by one          */
+        DispCGLRU[i] = DispCGLRU[i - 1];
+        i--;
+    }
+    DispCGLRU[0] = slot;
+}
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                   CHOOSE A CGRAM SLOT TO REPLACE (Internal)
+*
+* Description : This function returns the least recently used slot that is not reserved by DispDefChar().
+*               With DISP_SHADOW_EN, slots whose character code is on the display or in the off-screen
+*               copy are skipped, as rewriting them would change characters already on the screen.
+* Arguments   : none
+* Returns     : The CGRAM slot to replace, or DISP_CG_SLOT_NONE if every slot is reserved.
+*********************************************************************************************************
+*/
+
+static  CPU_INT08U  DispGlyphVictim (void)
+{
+    CPU_INT08U used;
+    CPU_INT08U slot;
+    CPU_INT08U i;
+#if DISP_SHADOW_EN > 0
+    CPU_INT08U row;
+    CPU_INT08U col;
+    CPU_INT08U c;
+#endif
+
+
+    used = 0;                               /* Bit 'n' set if CGRAM slot 'n' is on screen              */
+#if DISP_SHADOW_EN > 0
+    for (row = 0; row < DispMaxRows; row++) {
+        for (col = 0; col < DispMaxCols; col++) {
+            c = DispShadow[row][col];
+            if (c < 16) {                   /* Codes 8 to 15 are aliases of the CGRAM characters       */
+                used |= 1 << (c & 0x07);
+            }
+            c = DispScreen[row][col];
+            if (c < 16) {
+                used |= 1 << (c & 0x07);
+            }
+        }
+    }
+#endif
+    slot = DISP_CG_SLOT_NONE;
+    i    = DISP_CG_NBR_SLOTS;
+    while (i > 0) {                         /* From the least recently used slot ...                   */
+        i--;
+        if (DispCGId[DispCGLRU[i]] != DISP_GLYPH_RSVD) {
+            if ((used & (1 << DispCGLRU[i])) == 0) {
+                return (DispCGLRU[i]);      /* ... the first free or hidden slot                       */
+            }
+            if (slot == DISP_CG_SLOT_NONE) {
+                slot = DispCGLRU[i];        /* ... otherwise the least recently used one               */
+            }
+        }
+    }
+    return (slot);
+}
+
 /*$PAGE*/
 /*
 *********************************************************************************************************
@@ -275,32 +636,82 @@ void  DispDummy (void)
 *               'val'   is the value of the horizontal bar.  This value cannot exceed:
 *                           DispMaxCols * 5
 * Returns     : none
-* Notes       : To use this function, you must first call DispHorBarInit()
+* Notes       : The bar glyphs are loaded into CGRAM on first use (see DispGlyph()).  When they are
+*               already resident, only the bar's characters are sent to the LCD module.
 *********************************************************************************************************
 */
 
 void  DispHorBar (CPU_INT08U row, CPU_INT08U col, CPU_INT08U val)
 {
+#if DISP_TASK_EN > 0
+    DispCmdSend(DISP_CMD_HOR_BAR, row, col, val, (CPU_INT08U *)0, 0);
+#else
+    DispHorBarWr(row, col, val);
+#endif
+}
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                  DISPLAY A HORIZONTAL BAR (Internal)
+*
+* Description : This function performs DispHorBar() on the LCD module.  It runs in the caller's context, or
+*               in the LCD task when DISP_TASK_EN is enabled.
+* Arguments   : see DispHorBar()
+* Returns     : none
+*********************************************************************************************************
+*/
+
+static  void  DispHorBarWr (CPU_INT08U row, CPU_INT08U col, CPU_INT08U val)
+{
+#if DISP_SHADOW_EN > 0
     CPU_INT08U i;
+#endif
     CPU_INT08U full;
     CPU_INT08U fract;
+    CPU_INT08U c_full;
+    CPU_INT08U c_fract;
 
 
     full  = val / 5;                        /* Find out how many 'full' blocks to turn ON              */
     fract = val % 5;                        /* Compute portion of block                                */
     if (row < DispMaxRows && (col + full - 1) < DispMaxCols) {
         DispLock();
-        i = 0;                              /* Set counter to limit column to maximum allowable column */
-        DispCursorSet(row, col);            /* Position cursor at beginning of the bar graph           */
-        DispSel(DISP_SEL_DATA_REG);
+        c_full  = ' ';
+        c_fract = ' ';
+        if (full > 0) {                     /* Get the character codes of the glyphs, loading ...      */
+            c_full  = DispGlyphLoad(DISP_GLYPH_HOR_BAR + 4, DispHorBarTbl[4]);
+        }
+        if (fract > 0) {                    /* ... them into CGRAM only if they are not resident       */
+            c_fract = DispGlyphLoad(DISP_GLYPH_HOR_BAR + fract - 1, DispHorBarTbl[fract - 1]);
+        }
+        if (c_full == DISP_CG_SLOT_NONE) {
+            c_full = ' ';
+        }
+        if (c_fract == DISP_CG_SLOT_NONE) {
+            c_fract = ' ';
+        }
+#if DISP_SHADOW_EN > 0
+        i = col;
         while (full > 0) {                  /* Write all 'full' blocks                                 */
-            DispDataWr(5);                  /* Send custom character #5 which is full block            */
-            i++;                            /* Increment limit counter                                 */
+            DispShadow[row][i] = c_full;    /* Full block                                              */
+            i++;
+            full--;
+        }
+        if (fract > 0 && i < DispMaxCols) {
+            DispShadow[row][i] = c_fract;   /* Portion of block                                        */
+        }
+#else
+        DispDrv->CursorSet(row, col);       /* Position cursor at beginning of the bar graph           */
+        while (full > 0) {                  /* Write all 'full' blocks                                 */
+            DispDrv->WrRun(&c_full, 1);     /* Send the full block                                     */
             full--;
         }
         if (fract > 0) {
-            DispDataWr(fract);              /* Send custom character # 'fract' (i.e. portion of block) */
+            DispDrv->WrRun(&c_fract, 1);    /* Send the portion of block                               */
         }
+        DispDrv->Flush();
+#endif
         DispUnlock();
     }
 }
@@ -310,20 +721,16 @@ void  DispHorBar (CPU_INT08U row, CPU_INT08U col, CPU_INT08U val)
 *********************************************************************************************************
 *                                      INITIALIZE HORIZONTAL BAR
 *
-* Description : This function is used to initialize the bar graph capability of this module.  You must
-*               call this function prior to calling DispHorBar().
+* Description : This function is used to initialize the bar graph capability of this module.
 * Arguments   : none
 * Returns     : none
+* Notes       : DispHorBar() now loads the glyphs it needs into CGRAM on demand, so this function has
+*               nothing left to do.  It is kept for existing applications.
 *********************************************************************************************************
 */
 
 void  DispHorBarInit (void)
 {
-    DispDefChar(1, &DispHorBar1[0]);
-    DispDefChar(2, &DispHorBar2[0]);
-    DispDefChar(3, &DispHorBar3[0]);
-    DispDefChar(4, &DispHorBar4[0]);
-    DispDefChar(5, &DispHorBar5[0]);
 }
 
 /*$PAGE*/
@@ -337,36 +744,53 @@ void  DispHorBarInit (void)
 *               'val'   is the value of the vertical bar.  This value cannot exceed 8 (i.e. 8 bars per character)
 *
 * Returns     : none
-* Notes       : To use this function, you must first call DispVerBarInit()
+* Notes       : The bar glyph is loaded into CGRAM on first use (see DispGlyph()).
 *********************************************************************************************************
 */
 
 void  DispVertBar (CPU_INT08U row, CPU_INT08U col, CPU_INT08U val)
 {
+#if DISP_TASK_EN > 0
+    DispCmdSend(DISP_CMD_VERT_BAR, row, col, val, (CPU_INT08U *)0, 0);
+#else
+    DispVertBarWr(row, col, val);
+#endif
+}
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                   DISPLAY A VERTICAL BAR (Internal)
+*
+* Description : This function performs DispVertBar() on the LCD module.  It runs in the caller's context, or
+*               in the LCD task when DISP_TASK_EN is enabled.
+* Arguments   : see DispVertBar()
+* Returns     : none
+*********************************************************************************************************
+*/
+
+static  void  DispVertBarWr (CPU_INT08U row, CPU_INT08U col, CPU_INT08U val)
+{
+    CPU_INT08U c;
+
+
     if (row < DispMaxRows && col < DispMaxCols) {
+        if (val > 8) {
+            val = 8;                        /* Always display 8 bars                                   */
+        }
         DispLock();
-        DispCursorSet(row, col);            /* Position cursor at beginning of the bar graph           */
-        DispSel(DISP_SEL_DATA_REG);
-        switch (val) {
-            case 0:
-                 DispDataWr(' ');           /* Display NO bars                                         */
-                 break;
-
-            case 1:
-            case 2:
-            case 3:
-            case 4:
-            case 5:
-            case 6:
-            case 7:
-            case 8:
-                 DispDataWr(val - 1);       /* Display between 1 and 8 bars                            */
-                 break;
-
-            default:
-                 DispDataWr(7);             /* Always display 8 bars                                   */
-                 break;
+        c = ' ';                            /* Display NO bars                                         */
+        if (val > 0) {                      /* Display between 1 and 8 bars                            */
+            c = DispGlyphLoad(DISP_GLYPH_VERT_BAR + val - 1, DispVertBarTbl[val - 1]);
         }
+        if (c == DISP_CG_SLOT_NONE) {
+            c = ' ';
+        }
+#if DISP_SHADOW_EN > 0
+        DispShadow[row][col] = c;
+#else
+        DispRunWr(row, col, &c, 1);         /* Send the bar at ROW/COL                                 */
+#endif
         DispUnlock();
     }
 }
@@ -376,23 +800,16 @@ void  DispVertBar (CPU_INT08U row, CPU_INT08U col, CPU_INT08U val)
 *********************************************************************************************************
 *                                      INITIALIZE VERTICAL BAR
 *
-* Description : This function is used to initialize the bar graph capability of this module.  You must
-*               call this function prior to calling DispVerBar().
+* Description : This function is used to initialize the bar graph capability of this module.
 * Arguments   : none
 * Returns     : none
+* Notes       : DispVertBar() now loads the glyph it needs into CGRAM on demand, so this function has
+*               nothing left to do.  It is kept for existing applications.
 *********************************************************************************************************
 */
 
 void  DispVertBarInit (void)
 {
-    DispDefChar(0, &DispVertBar1[0]);
-    DispDefChar(1, &DispVertBar2[0]);
-    DispDefChar(2, &DispVertBar3[0]);
-    DispDefChar(3, &DispVertBar4[0]);
-    DispDefChar(4, &DispVertBar5[0]);
-    DispDefChar(5, &DispVertBar6[0]);
-    DispDefChar(6, &DispVertBar7[0]);
-    DispDefChar(7, &DispVertBar8[0]);
 }
 
 /*$PAGE*/
@@ -407,56 +824,52 @@ void  DispVertBarInit (void)
 * Notes       : - DispInit() MUST be called only when multitasking has started.  This is because
 *                 DispInit() requires time delay services from the operating system.
 *               - DispInit() MUST only be called once during initialization.
+*               - With DISP_SHADOW_EN, 'maxrows' and 'maxcols' are limited to DISP_SHADOW_MAX_ROWS and
+*                 DISP_SHADOW_MAX_COLS.
 *********************************************************************************************************
 */
 
 void  DispInit (CPU_INT08U maxrows, CPU_INT08U maxcols)
 {
-    DispInitOS();                      /* Initialize the RTOS services                                 */
-
-    DispInitPort();                    /* Initialize I/O ports used in display driver                  */
-
-    DispMaxRows = maxrows;
-    DispMaxCols = maxcols;
-
-                                       /* INITIALIZE THE DISPLAY MODULE                                */
-    DispSel(DISP_SEL_CMD_REG);         /* Select command register.                                     */
-    DispDly_uS(50000);                 /* Delay more than 15 mS after power up                         */
-
-#if DISP_BUS_WIDTH == 4
-    DispDataWrOneNibble(DISP_CMD_FNCT_INIT8);/* Function Set: 8 bit, Only writes upper nibble          */
-    DispDly_uS(5000);                  /* Busy flag cannot be checked yet!  5 FNCT writes recommended! */
-
-    DispDataWrOneNibble(DISP_CMD_FNCT_INIT8);/* Function Set: 8 bit, Only writes upper nibble          */
-    DispDly_uS(5000);                        /* Busy flag cannot be checked yet!                       */
-
-    DispDataWrOneNibble(DISP_CMD_FNCT_INIT8);/* Function Set: 8 bit, Only writes upper nibble          */
-    DispDly_uS(5000);                        /* Busy flag cannot be checked yet!                       */
-
-    DispDataWrOneNibble(DISP_CMD_FNCT_INIT4);/* Function Set: 4 bit, Only writes upper nibble          */
-    DispDly_uS(5000);                        /* Busy flag cannot be checked yet!                       */
-#else
-   DispDataWr(DISP_CMD_FNCT_INIT8);    /* Two lines, 1/16 duty cycle, 5x8 dots, 8 bit operation        */
-   DispDly_uS(2000);                   /* 4 FNCT writes recommended in Hitachi datasheet!              */
+    CPU_INT08U i;
+#if DISP_SHADOW_EN > 0
+    CPU_INT08U row;
+    CPU_INT08U col;
+#endif
 
-   DispDataWr(DISP_CMD_FNCT_INIT8);    /* Two lines, 1/16 duty cycle, 5x8 dots, 8 bit operation        */
-   DispDly_uS(2000);                   /* Busy flag cannot be checked yet!                             */
 
-   DispDataWr(DISP_CMD_FNCT_INIT8);    /* Two lines, 1/16 duty cycle, 5x8 dots, 8 bit operation        */
-   DispDly_uS(2000);                   /* Busy flag cannot be checked yet!                             */
+#if DISP_SHADOW_EN > 0
+    if (maxrows > DISP_SHADOW_MAX_ROWS) {
+        maxrows = DISP_SHADOW_MAX_ROWS;
+    }
+    if (maxcols > DISP_SHADOW_MAX_COLS) {
+        maxcols = DISP_SHADOW_MAX_COLS;
+    }
+    for (row = 0; row < DISP_SHADOW_MAX_ROWS; row++) {
+        for (col = 0; col < DISP_SHADOW_MAX_COLS; col++) {
+            DispShadow[row][col] = ' ';    /* Display is blank after the 'clear display' command below */
+            DispScreen[row][col] = ' ';
+        }
+    }
 #endif
 
-    DispDataWr(DISP_CMD_FNCT);         /* Two lines, 1/16 duty cycle, 5x8 dots, Operation Mode         */
-    DispDly_uS(2000);                  /* Optional: Busy flag can now be checked yet                   */
+    DispInitOS();                      /* Initialize the RTOS services                                 */
 
-    DispDataWr(DISP_CMD_ON_OFF);       /* Disp ON/OFF: Display ON, cursor OFF and no BLINK character   */
-    DispDly_uS(2000);                  /* Delay at least  2 mS                                         */
+    DispMaxRows = maxrows;
+    DispMaxCols = maxcols;
+#if DISP_SCROLL_EN > 0
+    DispShiftPos = 0;
+#endif
 
-    DispDataWr(DISP_CMD_CLS);          /* Send command to LCD display to clear the display             */
-    DispDly_uS(2000);                  /* Delay at least  2 mS                                         */
+                                       /* CGRAM content is undefined after power up, empty the cache  */
+    for (i = 0; i < DISP_CG_NBR_SLOTS; i++) {
+        DispCGId[i]  = DISP_GLYPH_NONE;
+        DispCGLRU[i] = i;
+    }
 
-    DispDataWr(DISP_CMD_MODE);         /* Entry mode: Inc. display data address when writing           */
-    DispDly_uS(2000);                  /* Delay at least  2 mS                                         */
+                                       /* Initialize the port and reset the display module             */
+    DispDrv->Init(maxrows, maxcols);
+    DispDrv->Flush();
 }
 
 /*$PAGE*/
@@ -476,19 +889,417 @@ void  DispInit (CPU_INT08U maxrows, CPU_INT08U maxcols)
 */
 
 void  DispStr (CPU_INT08U row, CPU_INT08U col, CPU_INT08U *s)
+{
+#if DISP_TASK_EN > 0
+    CPU_INT08U len;
+
+
+    len = 0;
+    while (len < DISP_TASK_STR_SIZE - 1 && s[len]) {  /* Only characters that fit in a command are sent */
+        len++;
+    }
+    DispCmdSend(DISP_CMD_STR, row, col, 0, s, len);
+#else
+    DispStrWr(row, col, s);
+#endif
+}
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                     DISPLAY AN ASCII STRING (Internal)
+*
+* Description : This function performs DispStr() on the LCD module.  It runs in the caller's context, or
+*               in the LCD task when DISP_TASK_EN is enabled.
+* Arguments   : see DispStr()
+* Returns     : none
+*********************************************************************************************************
+*/
+
+static  void  DispStrWr (CPU_INT08U row, CPU_INT08U col, CPU_INT08U *s)
 {
     CPU_INT08U i;
 
 
     if (row < DispMaxRows && col < DispMaxCols) {
         DispLock();
-        DispCursorSet(row, col);            /* Position cursor at ROW/COL                              */
-        DispSel(DISP_SEL_DATA_REG);
+#if DISP_SHADOW_EN > 0
         i = col;                            /* Set counter to limit column to maximum allowable column */
         while (i < DispMaxCols && *s) {     /* Write all chars within str + limit to DispMaxCols       */
-            DispDataWr(*s++);               /* Send character to LCD display                           */
+            DispShadow[row][i] = *s++;      /* Update off-screen copy, sent by DispFlush()             */
             i++;                            /* Increment limit counter                                 */
         }
+#else
+        i = 0;                              /* Count chars within str + limit to DispMaxCols           */
+        while (col + i < DispMaxCols && s[i]) {
+            i++;
+        }
+        DispRunWr(row, col, s, i);          /* Send the characters as one run at ROW/COL               */
+#endif
         DispUnlock();
     }
 }
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                       WRITE A SCROLLING LINE
+*
+* Description : This function writes a string anywhere in the DISP_LINE_LEN characters of a line's DDRAM,
+*               including the columns that are off screen until the display is shifted (see
+*               DispScrollStart()).
+* Arguments   : 'row'   is the row of the line, 0 or 1
+*               'col'   is the DDRAM column of the first character, 0 to DISP_LINE_LEN - 1
+*               's'     is a pointer to the string.  Characters past the end of the line are ignored.
+* Returns     : none
+* Notes       : - Only 2 line displays are supported: 1 line modules are addressed as two half lines and
+*                 4 line modules interleave their lines in DDRAM.
+*               - The string is sent right away, also with DISP_SHADOW_EN.  The off-screen copy is
+*                 updated too so DispFlush() does not send its visible part again.
+*               - Columns are DDRAM columns: while the display is shifted, column 0 is no longer at the
+*                 left edge.  This also applies to DispStr() and the other functions.
+*********************************************************************************************************
+*/
+
+#if DISP_SCROLL_EN > 0
+void  DispScrollStr (CPU_INT08U row, CPU_INT08U col, CPU_INT08U *s)
+{
+#if DISP_TASK_EN > 0
+    CPU_INT08U len;
+    CPU_INT08U n;
+
+
+    len = 0;
+    while (col + len < DISP_LINE_LEN && s[len]) {
+        len++;
+    }
+    while (len > 0) {                                  /* Split the string across command blocks        */
+        n = len;
+        if (n > DISP_TASK_STR_SIZE - 1) {
+            n = DISP_TASK_STR_SIZE - 1;
+        }
+        DispCmdSend(DISP_CMD_SCROLL_STR, row, col, 0, s, n);
+        s   += n;
+        col += n;
+        len -= n;
+    }
+#else
+    DispScrollStrWr(row, col, s);
+#endif
+}
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                  WRITE A SCROLLING LINE (Internal)
+*
+* Description : This function performs DispScrollStr() on the LCD module.  It runs in the caller's context,
+*               or in the LCD task when DISP_TASK_EN is enabled.
+* Arguments   : see DispScrollStr()
+* Returns     : none
+*********************************************************************************************************
+*/
+
+static  void  DispScrollStrWr (CPU_INT08U row, CPU_INT08U col, CPU_INT08U *s)
+{
+    CPU_INT08U len;
+#if DISP_SHADOW_EN > 0
+    CPU_INT08U i;
+#endif
+
+
+    if (DispMaxRows == 2 && row < DispMaxRows && col < DISP_LINE_LEN) {
+        len = 0;
+        while (col + len < DISP_LINE_LEN && s[len]) {
+            len++;
+        }
+        DispLock();
+        DispDrv->CursorSet(row, col);
+        DispDrv->WrRun(s, len);
+#if DISP_SHADOW_EN > 0
+        for (i = 0; i < len; i++) {         /* Keep the off-screen copy in step with the display       */
+            if (col + i < DispMaxCols) {
+                DispShadow[row][col + i] = s[i];
+                DispScreen[row][col + i] = s[i];
+            }
+        }
+#endif
+        DispDrv->Flush();
+        DispUnlock();
+    }
+}
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                         START / STOP SCROLLING
+*
+* Description : DispScrollStart() starts an OS timer that shifts the display one column left every
+*               'period' timer ticks, so the DISP_LINE_LEN characters of each line go by as a marquee.
+*               DispScrollStop() stops the timer and shifts the display back to its original position.
+* Arguments   : 'period' is the time between two steps, in timer ticks (OS_TMR_CFG_TICKS_PER_SEC).
+* Returns     : DispScrollStart() returns DEF_OK   if the display is scrolling
+*                                        DEF_FAIL if no OS timer is available.
+* Notes       : - Each step is a single 'display shift' command, no character is rewritten.
+*               - The HD44780 shifts all lines together.  Fill the lines that should stay still with the
+*                 same character (e.g. blanks).
+*               - DispScrollStep() is called by the timer (see DispTmrStart()).  It only queues the step
+*                 when DISP_TASK_EN is enabled, so the timer task never waits for the LCD module.
+*********************************************************************************************************
+*/
+
+CPU_BOOLEAN  DispScrollStart (CPU_INT16U period)
+{
+    return (DispTmrStart(period));
+}
+
+
+
+void  DispScrollStep (void)
+{
+#if DISP_TASK_EN > 0
+    DispCmdSend(DISP_CMD_SCROLL_STEP, 0, 0, 0, (CPU_INT08U *)0, 0);
+#else
+    DispScrollStepWr();
+#endif
+}
+
+
+
+void  DispScrollStop (void)
+{
+    DispTmrStop();
+#if DISP_TASK_EN > 0
+    DispCmdSend(DISP_CMD_SCROLL_HOME, 0, 0, 0, (CPU_INT08U *)0, 0);
+#else
+    DispScrollHomeWr();
+#endif
+}
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                  SCROLL ONE STEP / SCROLL HOME (Internal)
+*
+* Description : DispScrollStepWr() shifts the display one column left.  DispScrollHomeWr() shifts it back
+*               to its original position, in whichever direction takes fewer commands.
+* Arguments   : none
+* Returns     : none
+*********************************************************************************************************
+*/
+
+static  void  DispScrollStepWr (void)
+{
+    DispLock();
+    DispDrv->Shift(DISP_SHIFT_LEFT);
+    DispShiftPos++;
+    if (DispShiftPos >= DISP_LINE_LEN) {
+        DispShiftPos = 0;
+    }
+    DispDrv->Flush();
+    DispUnlock();
+}
+
+
+
+static  void  DispScrollHomeWr (void)
+{
+    DispLock();
+    while (DispShiftPos != 0) {
+        if (DispShiftPos <= DISP_LINE_LEN / 2) {
+            DispDrv->Shift(DISP_SHIFT_RIGHT);
+            DispShiftPos--;
+        } else {
+            DispDrv->Shift(DISP_SHIFT_LEFT);
+            DispShiftPos++;
+            if (DispShiftPos >= DISP_LINE_LEN) {
+                DispShiftPos = 0;
+            }
+        }
+    }
+    DispDrv->Flush();
+    DispUnlock();
+}
+#endif
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                  WRITE A RUN OF CHARACTERS (Internal)
+*
+* Description : This function sends 'len' characters to the back end, starting at ROW/COL, and ends the
+*               update.
+* Arguments   : 'row'   is the row    position of the first character
+*               'col'   is the column position of the first character
+*               'pdata' is a pointer to the characters
+*               'len'   is the number of characters to send
+* Returns     : none
+* Notes       : The caller must own the display (see DispLock()).
+*********************************************************************************************************
+*/
+
+#if DISP_SHADOW_EN == 0
+static  void  DispRunWr (CPU_INT08U row, CPU_INT08U col, CPU_INT08U *pdata, CPU_INT08U len)
+{
+    DispDrv->CursorSet(row, col);
+    DispDrv->WrRun(pdata, len);
+    DispDrv->Flush();
+}
+#endif
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                     NOTIFY WHEN THE DISPLAY IS UP TO DATE
+*
+* Description : This function asks the LCD task to signal 'p_done' once every command queued before this
+*               call has been sent to the LCD module.
+* Arguments   : 'p_done' is the RTOS object to signal (a semaphore with uC/OS-II, see DispSignal()).
+* Returns     : DEF_OK    if the request was queued
+*               DEF_FAIL  if the queue is full.  'p_done' will NOT be signaled.
+* Notes       : The caller is not blocked.  Pend on 'p_done' to wait for the display.
+*********************************************************************************************************
+*/
+
+#if DISP_TASK_EN > 0
+CPU_BOOLEAN  DispNotify (void *p_done)
+{
+    DISP_CMD  *pcmd;
+
+
+    pcmd = DispCmdGet();
+    if (pcmd == (DISP_CMD *)0) {
+        return (DEF_FAIL);
+    }
+    pcmd->Type = DISP_CMD_NOTIFY;
+    pcmd->Done = p_done;
+    DispCmdPost(pcmd);
+    return (DEF_OK);
+}
+#endif
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                   QUEUE A COMMAND FOR THE LCD TASK (Internal)
+*
+* Description : This function fills a command block and queues it for the LCD task.
+* Arguments   : 'type'  is the command (see DISP_CMD_xxx)
+*               'row'   is the row    argument of the command
+*               'col'   is the column argument of the command
+*               'val'   is the value  argument of the command
+*               'pdata' is a pointer to 'len' bytes to copy into the command (string or dot pattern)
+*               'len'   is the number of bytes at 'pdata', at most DISP_TASK_STR_SIZE - 1
+* Returns     : none
+* Notes       : The command is dropped if no command block is free (see DispCmdGet()).
+*********************************************************************************************************
+*/
+
+#if DISP_TASK_EN > 0
+static  void  DispCmdSend (CPU_INT08U  type,
+                           CPU_INT08U  row,
+                           CPU_INT08U  col,
+                           CPU_INT08U  val,
+                           CPU_INT08U *pdata,
+                           CPU_INT08U  len)
+{
+    DISP_CMD   *pcmd;
+    CPU_INT08U  i;
+
+
+    pcmd = DispCmdGet();
+    if (pcmd != (DISP_CMD *)0) {
+        pcmd->Type = type;
+        pcmd->Row  = row;
+        pcmd->Col  = col;
+        pcmd->Val  = val;
+        pcmd->Done = (void *)0;
+        for (i = 0; i < len; i++) {
+            pcmd->Str[i] = pdata[i];
+        }
+        pcmd->Str[len] = 0;
+        DispCmdPost(pcmd);
+    }
+}
+#endif
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                          EXECUTE A COMMAND
+*
+* Description : This function is called by the LCD task to perform a queued command on the LCD module.
+* Arguments   : 'pcmd'  is a pointer to the command
+* Returns     : none
+* Notes       : DISP_CMD_NOTIFY first sends any pending change to the display, then signals the caller.
+*********************************************************************************************************
+*/
+
+#if DISP_TASK_EN > 0
+void  DispCmdExec (DISP_CMD *pcmd)
+{
+    switch (pcmd->Type) {
+        case DISP_CMD_CHAR:
+             DispCharWr(pcmd->Row, pcmd->Col, pcmd->Val);
+             break;
+
+        case DISP_CMD_CLR_LINE:
+             DispClrLineWr(pcmd->Row);
+             break;
+
+        case DISP_CMD_CLR_SCR:
+             DispClrScrWr();
+             break;
+
+        case DISP_CMD_DEF_CHAR:
+             DispDefCharWr(pcmd->Val, &pcmd->Str[0]);
+             break;
+
+        case DISP_CMD_GLYPH:
+             DispGlyphWr(pcmd->Row, pcmd->Col, pcmd->Val, &pcmd->Str[0]);
+             break;
+
+        case DISP_CMD_HOR_BAR:
+             DispHorBarWr(pcmd->Row, pcmd->Col, pcmd->Val);
+             break;
+
+        case DISP_CMD_VERT_BAR:
+             DispVertBarWr(pcmd->Row, pcmd->Col, pcmd->Val);
+             break;
+
+        case DISP_CMD_STR:
+             DispStrWr(pcmd->Row, pcmd->Col, &pcmd->Str[0]);
+             break;
+
+#if DISP_SCROLL_EN > 0
+        case DISP_CMD_SCROLL_STR:
+             DispScrollStrWr(pcmd->Row, pcmd->Col, &pcmd->Str[0]);
+             break;
+
+        case DISP_CMD_SCROLL_STEP:
+             DispScrollStepWr();
+             break;
+
+        case DISP_CMD_SCROLL_HOME:
+             DispScrollHomeWr();
+             break;
+#endif
+
+        case DISP_CMD_FLUSH:
+#if DISP_SHADOW_EN > 0
+             DispFlushWr();
+#endif
+             break;
+
+        case DISP_CMD_NOTIFY:
+#if DISP_SHADOW_EN > 0
+             DispFlushWr();
+#endif
+             DispSignal(pcmd->Done);
+             break;
+
+        default:
+             break;
+    }
+}
+#endif
@@ -34,6 +34,117 @@
 #define  DISP_SEL_CMD_REG           0
 #define  DISP_SEL_DATA_REG          1
 
+#define  DISP_LINE_LEN             40         /* Characters in a display line's DDRAM (2 line modules) */
+
+#define  DISP_SHIFT_LEFT            0         /* Display shift: text moves left  (see DISP_DRV Shift)  */
+#define  DISP_SHIFT_RIGHT           1         /* Display shift: text moves right                       */
+
+#ifndef  DISP_SHADOW_EN                       /* Update an off-screen copy, send changes w/ DispFlush()*/
+#define  DISP_SHADOW_EN             0
+#endif
+
+#ifndef  DISP_TASK_EN                         /* Queue drawing commands to an LCD task                 */
+#define  DISP_TASK_EN               0
+#endif
+
+#ifndef  DISP_SCROLL_EN                     /* Marquee driven by an OS timer, see DispScrollStart()  */
+#define  DISP_SCROLL_EN             0
+#endif
+
+#ifndef  DISP_BUSY_FLAG_EN                    /* Poll the busy flag, the port must drive RW            */
+#define  DISP_BUSY_FLAG_EN          0
+#endif
+
+#ifndef  DISP_BUSY_POLL_MAX                   /* Busy flag reads before falling back to a fixed delay  */
+#define  DISP_BUSY_POLL_MAX      1000
+#endif
+
+#define  DISP_BUSY_EXEC_US         50         /* Worst case for all instructions but clear and home    */
+
+#ifndef  DISP_DRV_SEL                         /* Display back end, DispDrvHD44780 or DispDrvHost       */
+#define  DISP_DRV_SEL      DispDrvHD44780
+#endif
+
+#ifndef  DISP_HOST_ANSI_EN                    /* Host: redraw in place with ANSI cursor home           */
+#define  DISP_HOST_ANSI_EN          1
+#endif
+
+#ifndef  DISP_HOST_BYTE_US                    /* Host: simulated time to send one byte and execute it  */
+#define  DISP_HOST_BYTE_US         43
+#endif
+
+#ifndef  DISP_HOST_CLR_US                     /* Host: simulated time of the 'clear display' command   */
+#define  DISP_HOST_CLR_US        1530
+#endif
+
+                                              /* ---------- LCD TASK COMMANDS (see DISP_CMD) --------- */
+#define  DISP_CMD_CHAR              1
+#define  DISP_CMD_CLR_LINE          2
+#define  DISP_CMD_CLR_SCR           3
+#define  DISP_CMD_DEF_CHAR          4
+#define  DISP_CMD_HOR_BAR           5
+#define  DISP_CMD_VERT_BAR          6
+#define  DISP_CMD_STR               7
+#define  DISP_CMD_FLUSH             8
+#define  DISP_CMD_NOTIFY            9
+#define  DISP_CMD_GLYPH            10
+#define  DISP_CMD_SCROLL_STR       11
+#define  DISP_CMD_SCROLL_STEP      12
+#define  DISP_CMD_SCROLL_HOME      13
+
+                                              /* ------------ GLYPH IDS (see DispGlyph()) ------------ */
+#define  DISP_GLYPH_NONE            0
+#define  DISP_GLYPH_HOR_BAR         1         /* 1 to 5 columns lit, DispHorBar()                      */
+#define  DISP_GLYPH_VERT_BAR        6         /* 1 to 8 rows lit, DispVertBar()                        */
+#define  DISP_GLYPH_USER           16         /* First glyph id free for the application               */
+
+/*
+*********************************************************************************************************
+*                                               DATA TYPES
+*********************************************************************************************************
+*/
+
+typedef  struct  disp_drv {                   /* Display back end, selected with DISP_DRV_SEL          */
+    void  (*Init)(CPU_INT08U maxrows, CPU_INT08U maxcols);  /* Reset the module, blank, cursor at 0,0  */
+    void  (*CursorSet)(CPU_INT08U row, CPU_INT08U col);     /* Position the write address              */
+    void  (*WrRun)(CPU_INT08U *pdata, CPU_INT08U len);      /* Write 'len' chars, address auto-incr.   */
+    void  (*GlyphDef)(CPU_INT08U slot, CPU_INT08U *pat);    /* Load an 8 byte dot pattern into CGRAM   */
+    void  (*Clr)(void);                                     /* Blank, cursor at 0,0 and no shift       */
+    void  (*Shift)(CPU_INT08U dir);                         /* Move all lines one column, DDRAM intact */
+    void  (*Flush)(void);                                   /* End of an update                        */
+} DISP_DRV;
+
+typedef  struct  disp_host_stat {             /* Host back end counters, see DispHostStatGet()         */
+    CPU_INT32U   CmdCtr;                      /* Instruction bytes an HD44780 would have received      */
+    CPU_INT32U   DataCtr;                     /* Data bytes (characters and dot patterns)              */
+    CPU_INT32U   BusTime_uS;                  /* Simulated time spent sending them                     */
+    CPU_INT32U   FlushCtr;                    /* Number of updates                                     */
+} DISP_HOST_STAT;
+
+#if DISP_TASK_EN > 0
+typedef  struct  disp_cmd {                   /* Drawing command queued to the LCD task                */
+    CPU_INT08U   Type;                        /* Command, see DISP_CMD_xxx                             */
+    CPU_INT08U   Row;
+    CPU_INT08U   Col;
+    CPU_INT08U   Val;                         /* Character, bar value or CGRAM character id            */
+    void        *Done;                        /* RTOS object signaled by DISP_CMD_NOTIFY               */
+    CPU_INT08U   Str[DISP_TASK_STR_SIZE];     /* NUL terminated string or 8 byte dot pattern           */
+} DISP_CMD;
+#endif
+
+/*
+*********************************************************************************************************
+*                                            GLOBAL VARIABLES
+*********************************************************************************************************
+*/
+
+extern  const  DISP_DRV  DispDrvHD44780;      /* HD44780 through the port in the BSP (lcd_hd44780.c)   */
+extern  const  DISP_DRV  DispDrvHost;         /* Terminal renderer for host builds   (lcd_host.c)      */
+
+#if DISP_TASK_EN > 0
+extern  CPU_INT16U       DispCmdOvfCtr;       /* Commands dropped because the queue was full (lcd_os.c)*/
+#endif
+
 /*
 *********************************************************************************************************
 *                                           FUNCTION PROTOTYPES
@@ -46,6 +157,10 @@ void  DispClrScr(void);
 void  DispDefChar(CPU_INT08U id, CPU_INT08U *pat);
 void  DispDly_uS(CPU_INT32U us);
 void  DispDummy(void);
+#if DISP_SHADOW_EN > 0
+void  DispFlush(void);
+#endif
+void  DispGlyph(CPU_INT08U row, CPU_INT08U col, CPU_INT08U id, CPU_INT08U *pat);
 void  DispHorBar(CPU_INT08U row, CPU_INT08U col, CPU_INT08U val);
 void  DispHorBarInit(void);
 void  DispVertBar(CPU_INT08U row, CPU_INT08U col, CPU_INT08U val);
@@ -53,6 +168,18 @@ void  DispVertBarInit(void);
 void  DispInit(CPU_INT08U maxrows, CPU_INT08U maxcols);
 void  DispStr(CPU_INT08U row, CPU_INT08U col, CPU_INT08U *s);
 
+#if DISP_SCROLL_EN > 0
+void         DispScrollStr(CPU_INT08U row, CPU_INT08U col, CPU_INT08U *s);
+CPU_BOOLEAN  DispScrollStart(CPU_INT16U period);
+void         DispScrollStep(void);            /* Called by the scroll timer                            */
+void         DispScrollStop(void);
+#endif
+
+#if DISP_TASK_EN > 0
+CPU_BOOLEAN  DispNotify(void *p_done);
+void  DispCmdExec(DISP_CMD *pcmd);            /* Called by the LCD task                                */
+#endif
+
 /*
 *********************************************************************************************************
 *                                           FUNCTION PROTOTYPES
@@ -68,6 +195,21 @@ void  DispDataWr(CPU_INT08U data);
 void  DispInitPort(void);
 void  DispSel(CPU_INT08U sel);
 
+#if DISP_BUSY_FLAG_EN > 0
+CPU_INT08U  DispStatRd(void);                 /* Read the busy flag (bit 7) and address counter        */
+#endif
+
+/*
+*********************************************************************************************************
+*                                           FUNCTION PROTOTYPES
+*                                          HOST BACK END (lcd_host.c)
+*********************************************************************************************************
+*/
+
+CPU_INT08U  *DispHostRowGet(CPU_INT08U row);  /* Characters on a row of the emulated display           */
+void         DispHostStatClr(void);
+void         DispHostStatGet(DISP_HOST_STAT *pstat);
+
 /*
 *********************************************************************************************************
 *                                           FUNCTION PROTOTYPES
@@ -78,3 +220,26 @@ void  DispSel(CPU_INT08U sel);
 void  DispInitOS(void);                       /* Initialize RTOS services                              */
 void  DispLock(void);                         /* Ensure  exclusive access to the display               */
 void  DispUnlock(void);                       /* Release exclusive access to the display               */
+
+#if DISP_TASK_EN > 0
+DISP_CMD  *DispCmdGet(void);                  /* Get a free command block, NULL if none                */
+void       DispCmdPost(DISP_CMD *pcmd);       /* Queue a command to the LCD task                       */
+void       DispSignal(void *p_done);          /* Signal the object passed to DispNotify()              */
+#endif
+
+#if DISP_SCROLL_EN > 0
+CPU_BOOLEAN  DispTmrStart(CPU_INT16U period); /* Call DispScrollStep() every 'period' timer ticks      */
+void         DispTmrStop(void);
+#endif
+
+/*
+*********************************************************************************************************
+*                                          CONFIGURATION ERRORS
+*********************************************************************************************************
+*/
+
+#if DISP_TASK_EN > 0
+#if DISP_TASK_STR_SIZE < 9
+#error  "DISP_TASK_STR_SIZE illegally defined in app_cfg.h. Must hold an 8 byte dot pattern + NUL (>= 9)"
+#endif
+#endif
@@ -0,0 +1,383 @@
+/*
+*********************************************************************************************************
+*                                               uC/LCD
+*                                         LCD Module Driver
+*
+*                              (c) Copyright 2005; Micrium; Weston, FL
+*
+*                   All rights reserved.  Protected by international copyright laws.
+*                   Knowledge of the source code may not be used to write a similar
+*                   product.  This file may only be used in accordance with a license
+*                   and should not be redistributed in any way.
+*********************************************************************************************************
+*/
+
+
+/*
+*********************************************************************************************************
+*                                       HD44780 DISPLAY BACK END
+*
+* Filename      : lcd_hd44780.c
+* Programmer(s) : JJL
+* Version       : V3.00
+*********************************************************************************************************
+*                                              DESCRIPTION
+*
+*
+* This module drives a Hitachi HD44780 DOT MATRIX LCD controller through the port functions of the BSP
+* (DispSel(), DispDataWr(), DispDataWrOneNibble() and DispStatRd()).  lcd.c reaches it through the
+* DispDrvHD44780 back end (see DISP_DRV_SEL).
+*********************************************************************************************************
+*/
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                              INCLUDE FILES
+*********************************************************************************************************
+*/
+
+#include "includes.h"
+
+/*
+*********************************************************************************************************
+*                                            LOCAL CONSTANTS
+*********************************************************************************************************
+*/
+
+                                       /* ---------------------- HD44780 COMMANDS -------------------- */
+#define  DISP_CMD_CLS            0x01  /* Clr display : clears display and returns cursor home         */
+
+#if      DISP_BUS_WIDTH == 4
+#define  DISP_CMD_FNCT           0x28  /* Function Set: Set 4 bit data length, 1/16 duty, 5x8 dots     */
+#else
+#define  DISP_CMD_FNCT           0x38  /* Function Set: Set 8 bit data length, 1/16 duty, 5x8 dots     */
+#endif
+
+#define  DISP_CMD_FNCT_INIT8     0x30  /* Function Set: 8 bit mode, no options                         */
+#define  DISP_CMD_FNCT_INIT4     0x20  /* Function Set: 4 bit mode, no options                         */
+
+#define  DISP_CMD_MODE           0x06  /* Entry mode  : Inc. display data address when writing         */
+#define  DISP_CMD_ON_OFF         0x0C  /* Disp ON/OFF : Display ON, cursor OFF and no BLINK character  */
+
+#define  DISP_CMD_SHIFT_LEFT     0x18  /* Shift       : Move the display left,  DDRAM unchanged        */
+#define  DISP_CMD_SHIFT_RIGHT    0x1C  /* Shift       : Move the display right, DDRAM unchanged        */
+
+#define  DISP_STAT_BUSY          0x80  /* Status      : Busy flag, set while an instruction executes   */
+
+/*
+*********************************************************************************************************
+*                                            LOCAL VARIABLES
+*********************************************************************************************************
+*/
+
+static  CPU_INT08U   DispHD44780MaxCols;    /* Maximum number of columns (i.e. characters per line)    */
+static  CPU_INT08U   DispHD44780MaxRows;    /* Maximum number of rows for the display                  */
+static  CPU_INT08U   DispHD44780Row;        /* Position the LCD's address counter points to            */
+static  CPU_INT08U   DispHD44780Col;
+
+/*
+*********************************************************************************************************
+*                                        LOCAL FUNCTION PROTOTYPES
+*********************************************************************************************************
+*/
+
+static  void  DispHD44780Init(CPU_INT08U maxrows, CPU_INT08U maxcols);
+static  void  DispHD44780CursorSet(CPU_INT08U row, CPU_INT08U col);
+static  void  DispHD44780WrRun(CPU_INT08U *pdata, CPU_INT08U len);
+static  void  DispHD44780GlyphDef(CPU_INT08U slot, CPU_INT08U *pat);
+static  void  DispHD44780Clr(void);
+static  void  DispHD44780Shift(CPU_INT08U dir);
+static  void  DispHD44780Flush(void);
+static  void  DispRdyWait(CPU_INT32U us);
+static  void  DispWr(CPU_INT08U data);
+
+/*
+*********************************************************************************************************
+*                                            GLOBAL VARIABLES
+*********************************************************************************************************
+*/
+
+const  DISP_DRV  DispDrvHD44780 = {
+    DispHD44780Init,
+    DispHD44780CursorSet,
+    DispHD44780WrRun,
+    DispHD44780GlyphDef,
+    DispHD44780Clr,
+    DispHD44780Shift,
+    DispHD44780Flush
+};
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                     INITIALIZE THE DISPLAY MODULE
+*
+* Description : This function initializes the I/O port and performs the HD44780 reset sequence.
+* Arguments   : maxrows      specifies the number of lines on the display (1 to 4)
+*               maxcols      specified the number of characters per line
+* Returns     : none
+* Notes       : Requires time delay services from the operating system (see DispInit()).
+*********************************************************************************************************
+*/
+
+static  void  DispHD44780Init (CPU_INT08U maxrows, CPU_INT08U maxcols)
+{
+    DispInitPort();                    /* Initialize I/O ports used in display driver                  */
+
+    DispHD44780MaxRows = maxrows;
+    DispHD44780MaxCols = maxcols;
+    DispHD44780Row     = 0;
+    DispHD44780Col     = 0;
+
+    DispSel(DISP_SEL_CMD_REG);         /* Select command register.                                     */
+    DispDly_uS(50000);                 /* Delay more than 15 mS after power up                         */
+
+#if DISP_BUS_WIDTH == 4
+    DispDataWrOneNibble(DISP_CMD_FNCT_INIT8);/* Function Set: 8 bit, Only writes upper nibble          */
+    DispDly_uS(5000);                  /* Busy flag cannot be checked yet!  5 FNCT writes recommended! */
+
+    DispDataWrOneNibble(DISP_CMD_FNCT_INIT8);/* Function Set: 8 bit, Only writes upper nibble          */
+    DispDly_uS(5000);                        /* Busy flag cannot be checked yet!                       */
+
+    DispDataWrOneNibble(DISP_CMD_FNCT_INIT8);/* Function Set: 8 bit, Only writes upper nibble          */
+    DispDly_uS(5000);                        /* Busy flag cannot be checked yet!                       */
+
+    DispDataWrOneNibble(DISP_CMD_FNCT_INIT4);/* Function Set: 4 bit, Only writes upper nibble          */
+    DispDly_uS(5000);                        /* Busy flag cannot be checked yet!                       */
+#else
+   DispDataWr(DISP_CMD_FNCT_INIT8);    /* Two lines, 1/16 duty cycle, 5x8 dots, 8 bit operation        */
+   DispDly_uS(2000);                   /* 4 FNCT writes recommended in Hitachi datasheet!              */
+
+   DispDataWr(DISP_CMD_FNCT_INIT8);    /* Two lines, 1/16 duty cycle, 5x8 dots, 8 bit operation        */
+   DispDly_uS(2000);                   /* Busy flag cannot be checked yet!                             */
+
+   DispDataWr(DISP_CMD_FNCT_INIT8);    /* Two lines, 1/16 duty cycle, 5x8 dots, 8 bit operation        */
+   DispDly_uS(2000);                   /* Busy flag cannot be checked yet!                             */
+#endif
+
+    DispWr(DISP_CMD_FNCT);             /* Two lines, 1/16 duty cycle, 5x8 dots, Operation Mode         */
+    DispRdyWait(2000);                 /* Optional: Busy flag can now be checked yet                   */
+
+    DispWr(DISP_CMD_ON_OFF);           /* Disp ON/OFF: Display ON, cursor OFF and no BLINK character   */
+    DispRdyWait(2000);                 /* Wait until ready, or at least 2 mS without the busy flag     */
+
+    DispWr(DISP_CMD_CLS);              /* Send command to LCD display to clear the display             */
+    DispRdyWait(2000);                 /* Wait until ready, or at least 2 mS without the busy flag     */
+
+    DispWr(DISP_CMD_MODE);             /* Entry mode: Inc. display data address when writing           */
+    DispRdyWait(2000);                 /* Wait until ready, or at least 2 mS without the busy flag     */
+}
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                          POSITION THE CURSOR
+*
+* Description : This function positions the cursor into the LCD buffer
+* Arguments   : 'row'   is the row    position of the cursor in the LCD Display
+*                       'row' can be a value from 0 to 'DispMaxRows - 1'
+*               'col'   is the column position of the cursor in the LCD Display
+*                       'col' can be a value from 0 to 'DispMaxCols - 1'
+* Returns     : none
+*********************************************************************************************************
+*/
+
+static  void  DispHD44780CursorSet (CPU_INT08U row, CPU_INT08U col)
+{
+    DispHD44780Row = row;
+    DispHD44780Col = col;
+    DispSel(DISP_SEL_CMD_REG);                             /* Select LCD display command register      */
+    switch (row) {
+        case 0:
+             if (DispHD44780MaxRows == 1) {                /* Handle special case when only one line   */
+                 if (col < (DispHD44780MaxCols >> 1)) {
+                     DispWr(0x80 + col);                   /* First  half of the line starts at 0x80   */
+                 } else {                                  /* Second half of the line starts at 0xC0   */
+                     DispWr(0xC0 + col - (DispHD44780MaxCols >> 1));
+                 }
+             } else {
+                 DispWr(0x80 + col);                       /* Select LCD's display line 1              */
+             }
+             break;
+
+        case 1:
+             DispWr(0xC0 + col);                           /* Select LCD's display line 2              */
+             break;
+
+        case 2:
+             DispWr(0x80 + DispHD44780MaxCols + col);      /* Select LCD's display line 3              */
+             break;
+
+        case 3:
+             DispWr(0xC0 + DispHD44780MaxCols + col);      /* Select LCD's display line 4              */
+             break;
+    }
+}
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                          WRITE A RUN OF CHARACTERS
+*
+* Description : This function writes 'len' characters starting at the cursor position.
+* Arguments   : 'pdata' is a pointer to the characters
+*               'len'   is the number of characters to write
+* Returns     : none
+* Notes       : The HD44780 increments its address after each character.  On a 1 line display, the second
+*               half of the line is not contiguous with the first, so the cursor is re-positioned when a
+*               run crosses the middle of the line.
+*********************************************************************************************************
+*/
+
+static  void  DispHD44780WrRun (CPU_INT08U *pdata, CPU_INT08U len)
+{
+    DispSel(DISP_SEL_DATA_REG);
+    while (len > 0) {
+        DispWr(*pdata++);                  /* Send character to display                                */
+        DispHD44780Col++;
+        len--;
+        if (len > 0 && DispHD44780MaxRows == 1 && DispHD44780Col == (DispHD44780MaxCols >> 1)) {
+            DispHD44780CursorSet(0, DispHD44780Col);   /* Second half of a 1 line display is apart     */
+            DispSel(DISP_SEL_DATA_REG);
+        }
+    }
+}
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                          WRITE A CGRAM SLOT
+*
+* Description : This function writes an 8 byte dot pattern into one of the CGRAM slots.
+* Arguments   : 'slot'  is the CGRAM slot (i.e. character code) 0 to 7.
+*               'pat'   is a pointer to an 8 BYTE array containing the dot pattern.
+* Returns     : none
+* Notes       : The address counter is left pointing into CGRAM, the cursor must be positioned before
+*               the next character is written.
+*********************************************************************************************************
+*/
+
+static  void  DispHD44780GlyphDef (CPU_INT08U slot, CPU_INT08U *pat)
+{
+    CPU_INT08U i;
+
+
+    DispSel(DISP_SEL_CMD_REG);              /* Select command register                                 */
+    DispWr(0x40 + (slot << 3));             /* Set address of CG RAM                                   */
+    DispSel(DISP_SEL_DATA_REG);             /* Select the data register                                */
+    for (i = 0; i < 8; i++) {
+        DispWr(*pat++);                     /* Write pattern into CG RAM                               */
+    }
+}
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                            CLEAR THE DISPLAY
+*
+* Description : This function sends the 'clear display' command, which also returns the cursor home and
+*               cancels any display shift.
+* Arguments   : none
+* Returns     : none
+*********************************************************************************************************
+*/
+
+static  void  DispHD44780Clr (void)
+{
+    DispHD44780Row = 0;
+    DispHD44780Col = 0;
+    DispSel(DISP_SEL_CMD_REG);         /* Select the LCD display command register                      */
+    DispWr(DISP_CMD_CLS);              /* Send command to LCD display to clear the display             */
+    DispRdyWait(2000);                 /* Wait until ready, or at least 2 mS without the busy flag     */
+}
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                            SHIFT THE DISPLAY
+*
+* Description : This function moves the display window one column over DDRAM.  All lines move together,
+*               no character is rewritten.
+* Arguments   : 'dir'   is DISP_SHIFT_LEFT  to move the text left, or
+*                          DISP_SHIFT_RIGHT to move the text right.
+* Returns     : none
+*********************************************************************************************************
+*/
+
+static  void  DispHD44780Shift (CPU_INT08U dir)
+{
+    DispSel(DISP_SEL_CMD_REG);
+    if (dir == DISP_SHIFT_LEFT) {
+        DispWr(DISP_CMD_SHIFT_LEFT);
+    } else {
+        DispWr(DISP_CMD_SHIFT_RIGHT);
+    }
+}
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                             END OF AN UPDATE
+*
+* Description : The HD44780 shows characters as soon as they are written, there is nothing to do.
+* Arguments   : none
+* Returns     : none
+*********************************************************************************************************
+*/
+
+static  void  DispHD44780Flush (void)
+{
+}
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                    WAIT UNTIL THE LCD MODULE IS READY (Internal)
+*
+* Description : This function waits for the HD44780 to finish the instruction last written to it.  With
+*               DISP_BUSY_FLAG_EN, the busy flag is polled so the wait ends as soon as the controller is
+*               ready.  Otherwise the worst case execution time 'us' is always waited.
+* Arguments   : 'us'    is the worst case execution time of the instruction (in microseconds).
+* Returns     : none
+* Notes       : - The busy flag cannot be read before the function set that ends the reset sequence.
+*               - If the busy flag is still set after DISP_BUSY_POLL_MAX reads (e.g. RW is not actually
+*                 wired), 'us' is waited instead so the display keeps working at worst case timing.
+*********************************************************************************************************
+*/
+
+static  void  DispRdyWait (CPU_INT32U us)
+{
+#if DISP_BUSY_FLAG_EN > 0
+    CPU_INT16U polls;
+
+
+    for (polls = 0; polls < DISP_BUSY_POLL_MAX; polls++) {
+        if ((DispStatRd() & DISP_STAT_BUSY) == 0) {
+            return;
+        }
+    }
+#endif
+    DispDly_uS(us);
+}
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                    WRITE A BYTE TO THE LCD MODULE (Internal)
+*
+* Description : This function writes a byte to the register selected with DispSel().  With
+*               DISP_BUSY_FLAG_EN the port only strobes the byte, so this function also waits for the
+*               instruction to complete.  Otherwise the port's own delays already cover it.
+* Arguments   : 'data'  is the byte to write.
+* Returns     : none
+*********************************************************************************************************
+*/
+
+static  void  DispWr (CPU_INT08U data)
+{
+    DispDataWr(data);
+#if DISP_BUSY_FLAG_EN > 0
+    DispRdyWait(DISP_BUSY_EXEC_US);
+#endif
+}
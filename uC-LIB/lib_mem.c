@@ -541,6 +541,112 @@ CPU_BOOLEAN  Mem_Cmp (void        *p1_mem,
 }
 
 
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                             Mem_SeqWr()
+*
+* Description : Publish a data buffer protected by a sequence lock.
+*
+* Argument(s) : pseq        Pointer to sequence lock counter (see 'lib_mem.h  MEMORY SEQUENCE LOCK DATA TYPE').
+*
+*               pdest       Pointer to shared      memory buffer.
+*
+*               psrc        Pointer to new data    memory buffer.
+*
+*               size        Number of data buffer octets to publish.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : various.
+*
+* Note(s)     : (1) Only ONE writer per sequence lock is allowed.  The writer MUST NOT be preempted by a 
+*                   reader of the same sequence lock; e.g. publish from an ISR, or from a task with the 
+*                   scheduler locked.  Otherwise a reader could retry until the writer runs again.
+*
+*               (2) Sequence counter accesses are ordered around the buffer copy by CPU_WMB() (see 'cpu.h
+*                   MEMORY BARRIER CONFIGURATION').  Neither 'volatile' nor the call to Mem_Copy() keep the
+*                   compiler or the CPU from moving the buffer writes across the counter updates.
+*********************************************************************************************************
+*/
+
+void  Mem_SeqWr (MEM_SEQ     *pseq,
+                 void        *pdest,
+                 void        *psrc,
+                 CPU_SIZE_T   size)
+{
+    if (pseq == (MEM_SEQ *)0) {
+        return;
+    }
+
+   *pseq += 1;                                                  /* Seq ctr odd : update in progress.                    */
+    CPU_WMB();                                                  /* See Note #2.                                         */
+    Mem_Copy(pdest, psrc, size);
+    CPU_WMB();
+   *pseq += 1;                                                  /* Seq ctr even: update complete.                       */
+}
+
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                             Mem_SeqRd()
+*
+* Description : Copy a consistent snapshot of a data buffer protected by a sequence lock.
+*
+* Argument(s) : pseq        Pointer to sequence lock counter (see 'lib_mem.h  MEMORY SEQUENCE LOCK DATA TYPE').
+*
+*               pdest       Pointer to snapshot    memory buffer.
+*
+*               psrc        Pointer to shared      memory buffer.
+*
+*               size        Number of data buffer octets to copy.
+*
+* Return(s)   : Number of copies retried because the writer updated the buffer during the copy.
+*
+* Caller(s)   : various.
+*
+* Note(s)     : (1) Readers never block the writer & never block each other.  The snapshot is retried 
+*                   until NO update overlapped the copy (see also 'Mem_SeqWr()  Note #1').
+*
+*               (2) 'pdest' MAY hold a torn copy between retries; it is consistent on return ONLY.
+*
+*               (3) The buffer reads are kept between the two counter reads by CPU_RMB() (see 'Mem_SeqWr()
+*                   Note #2').
+*********************************************************************************************************
+*/
+
+CPU_SIZE_T  Mem_SeqRd (MEM_SEQ     *pseq,
+                       void        *pdest,
+                       void        *psrc,
+                       CPU_SIZE_T   size)
+{
+    CPU_INT16U  seq_start;
+    CPU_INT16U  seq_end;
+    CPU_SIZE_T  retry_ctr;
+
+
+    if (pseq == (MEM_SEQ *)0) {
+        return (0);
+    }
+
+    retry_ctr = 0;
+    while (DEF_TRUE) {
+        seq_start = *pseq;
+        CPU_RMB();                                              /* See Note #3.                                         */
+        if ((seq_start & 0x0001) == 0) {                        /* If NO update in progress, ...                        */
+            Mem_Copy(pdest, psrc, size);                        /* ... copy shared buf ...                              */
+            CPU_RMB();
+            seq_end = *pseq;
+            if (seq_end == seq_start) {                         /* ... & rtn if NO update overlapped the copy.          */
+                return (retry_ctr);
+            }
+        }
+        retry_ctr++;
+    }
+}
+
+
 /*$PAGE*/
 /*
 *********************************************************************************************************
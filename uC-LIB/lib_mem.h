@@ -288,6 +288,27 @@ struct  mem_pool {
 };
 
 
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                     MEMORY SEQUENCE LOCK DATA TYPE
+*
+* Note(s) : (1) A sequence lock lets ONE writer publish a multi-octet data buffer that any number of 
+*               readers copy without blocking the writer :
+*
+*               (a) The writer increments the sequence counter before & after updating the buffer; the
+*                   counter is thus odd while an update is in progress.
+*
+*               (b) A reader copies the buffer between two reads of the sequence counter & retries the 
+*                   copy if the counter was odd or changed in between.
+*
+*           (2) The sequence counter MUST be initialized to zero (or any even value) before first use.
+*********************************************************************************************************
+*/
+
+typedef  volatile  CPU_INT16U  MEM_SEQ;
+
+
 /*$PAGE*/
 /*
 *********************************************************************************************************
@@ -771,6 +792,17 @@ CPU_BOOLEAN   Mem_Cmp        (void         *p1_mem,
                               CPU_SIZE_T    size);
 
 
+void          Mem_SeqWr      (MEM_SEQ      *pseq,
+                              void         *pdest,
+                              void         *psrc,
+                              CPU_SIZE_T    size);
+
+CPU_SIZE_T    Mem_SeqRd      (MEM_SEQ      *pseq,
+                              void         *pdest,
+                              void         *psrc,
+                              CPU_SIZE_T    size);
+
+
 #if (LIB_MEM_CFG_POOL_EN == DEF_ENABLED)
 void          Mem_PoolCreate (void         *pmem_base_addr,
                               CPU_SIZE_T    mem_size,
@@ -87,6 +87,19 @@
 *********************************************************************************************************
 */
 
+static  const  CPU_CHAR  Str_DigPairTbl[] = {                   /* Two ASCII digs per entry, '00' .. '99'.              */
+    "00010203040506070809"
+    "10111213141516171819"
+    "20212223242526272829"
+    "30313233343536373839"
+    "40414243444546474849"
+    "50515253545556575859"
+    "60616263646566676869"
+    "70717273747576777879"
+    "80818283848586878889"
+    "90919293949596979899"
+};
+
 
 /*
 *********************************************************************************************************
@@ -101,6 +114,9 @@
 *********************************************************************************************************
 */
 
+static  void  Str_FmtDig4(CPU_INT16U   val,
+                          CPU_CHAR    *pstr);
+
 
 /*
 *********************************************************************************************************
@@ -1246,3 +1262,198 @@ CPU_CHAR  *Str_FmtNbr_32 (CPU_FP32      nbr,
 }
 #endif
 
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                         Str_FmtNbr_Int32U()
+*
+* Description : Format unsigned integer number into a fixed-width character string.
+*
+* Argument(s) : nbr             Number                          to format.
+*
+*               nbr_dig         Number of digits                to format (see Note #1).
+*
+*               lead_char       Character to prepend before the first non-zero digit (see Note #2).
+*
+*               nul             NULL-character terminate option (DEF_YES/DEF_NO) [see Note #3].
+*
+*               pstr_fmt        Pointer to character array to return formatted number string (see Note #4).
+*
+* Return(s)   : Pointer to formatted string, if NO errors (see Note #5).
+*
+*               Pointer to NULL,             otherwise.
+*
+* Caller(s)   : various.
+*
+* Note(s)     : (1) (a) Exactly 'nbr_dig' characters are formatted, so that a number re-formatted in place
+*                       overwrites every character of the previously formatted number.
+*
+*                   (b) If the number of digits to format ('nbr_dig') is less than the number of significant
+*                       digits of the number to format ('nbr'); then the most-significant digits of the
+*                       formatted number will be truncated (see also 'Str_FmtNbr_32()  Note #2a').
+*
+*                           Example :
+*
+*                               nbr      = 23456
+*                               nbr_dig  = 3
+*
+*                               pstr_fmt = "456"
+*
+*               (2) (a) Leading character is typically '0' for zero-padded or ' ' for right-aligned numbers.
+*
+*                   (b) The one's digit is ALWAYS formatted as a digit; a number of zero value formats as
+*                       a single '0' preceded by ('nbr_dig' - 1) leading characters.
+*
+*               (3) (a) NULL-character terminate option DISABLED prevents overwriting previous character
+*                       array formatting; e.g. a number may be formatted into the middle of a string.
+*
+*                   (b) WARNING: Unless 'pstr_fmt' character array is pre-/post-terminated, NULL-character
+*                       terminate option DISABLED will cause character string run-on.
+*
+*               (4) (a) Format buffer size NOT validated; buffer overruns MUST be prevented by caller.
+*
+*                   (b) To prevent character buffer overrun :
+*
+*                           Character array size MUST be  >=  ('nbr_dig'         +
+*                                                              1 'NUL' terminator)  characters
+*
+*               (5) String format terminates when :
+*
+*                   (a) Format string pointer is passed a NULL pointer.
+*                       (1) No string format performed; NULL pointer returned.
+*
+*                   (b) Number successfully formatted into character string array.
+*
+*               (6) (a) No floating-point operations are used, so this function is available regardless of
+*                       LIB_STR_CFG_FP_EN.
+*
+*                   (b) Digits are NOT extracted by repeated division by 10.  The number is split into
+*                       base-10000 chunks (at most two 32-bit divisions), each chunk is split into two
+*                       base-100 halves by a reciprocal multiply, & each half is looked up as a pair of
+*                       ASCII digits in 'Str_DigPairTbl[]'.
+*
+*                   (c) Only the chunks holding formatted digits are computed : a number formatted to at most
+*                       4 digits (e.g. a 2-digit display field) costs one reciprocal multiply & two look-ups.
+*********************************************************************************************************
+*/
+
+CPU_CHAR  *Str_FmtNbr_Int32U (CPU_INT32U    nbr,
+                              CPU_INT08U    nbr_dig,
+                              CPU_CHAR      lead_char,
+                              CPU_BOOLEAN   nul,
+                              CPU_CHAR     *pstr_fmt)
+{
+    CPU_CHAR     dig[10];                                       /* All 10 digs of a 32-bit nbr, most-significant first. */
+    CPU_CHAR    *pstr;
+    CPU_CHAR    *pdig;
+    CPU_INT32U   nbr_hi;
+    CPU_INT16U   chunk_hi;
+    CPU_INT16U   chunk_mid;
+    CPU_INT16U   chunk_lo;
+    CPU_INT08U   nbr_lead;
+
+                                                                /* Rtn NULL if str ptr NULL (see Note #5a).             */
+    if (pstr_fmt == (CPU_CHAR *)0) {
+        return ((CPU_CHAR *)0);
+    }
+
+
+    pstr = pstr_fmt;
+    if (nbr_dig > sizeof(dig)) {                                /* Pad any digs beyond 32-bit range with lead char.     */
+        nbr_lead = nbr_dig - sizeof(dig);
+        while (nbr_lead > 0) {
+           *pstr++ = lead_char;
+            nbr_lead--;
+        }
+        nbr_dig = sizeof(dig);
+    }
+
+    if (nbr_dig > 0) {
+        if (nbr < 10000) {                                      /* Split nbr into base-10000 chunks (see Note #6b).     */
+            nbr_hi   = 0;
+            chunk_lo = (CPU_INT16U)nbr;
+        } else {
+            nbr_hi   =               nbr / 10000;
+            chunk_lo = (CPU_INT16U)(nbr - (nbr_hi * 10000));
+        }
+        Str_FmtDig4(chunk_lo, &dig[6]);
+
+        if (nbr_dig > 4) {                                      /* Fmt hi chunks only if not truncated (see Note #6c).  */
+            if (nbr_hi < 10000) {
+                chunk_hi  = 0;
+                chunk_mid = (CPU_INT16U)nbr_hi;
+            } else {
+                chunk_hi  = (CPU_INT16U)(nbr_hi / 10000);       /* Max 32-bit nbr has only 2 digs in hi chunk.          */
+                chunk_mid = (CPU_INT16U)(nbr_hi - ((CPU_INT32U)chunk_hi * 10000));
+            }
+            Str_FmtDig4(chunk_mid, &dig[2]);
+            dig[0] = Str_DigPairTbl[(chunk_hi * 2)    ];
+            dig[1] = Str_DigPairTbl[(chunk_hi * 2) + 1];
+        }
+
+        pdig = &dig[sizeof(dig) - nbr_dig];                     /* Truncate most-significant digs (see Note #1b).       */
+        while ((nbr_dig > 1) && (*pdig == '0')) {               /* Replace lead zeros, not one's dig (see Note #2b).    */
+           *pstr++ = lead_char;
+            pdig++;
+            nbr_dig--;
+        }
+        while (nbr_dig > 0) {
+           *pstr++ = *pdig++;
+            nbr_dig--;
+        }
+    }
+
+    if (nul != DEF_NO) {                                        /* If NOT DISABLED, append NULL char (see Note #3).     */
+       *pstr = (CPU_CHAR)0;
+    }
+
+
+    return (pstr_fmt);
+}
+
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                           LOCAL FUNCTIONS
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*                                            Str_FmtDig4()
+*
+* Description : Format a number less than 10000 as exactly four ASCII digits.
+*
+* Argument(s) : val         Value to format (0 .. 9999).
+*
+*               pstr        Pointer to character array to receive the four digits (NOT NULL-terminated).
+*
+* Return(s)   : none.
+*
+* Caller(s)   : Str_FmtNbr_Int32U().
+*
+* Note(s)     : (1) 'val / 100' is computed as '(val * 5243) >> 19', which is exact for all values 0 .. 9999
+*                   & needs only one 16 x 16 => 32-bit multiply.
+*********************************************************************************************************
+*/
+
+static  void  Str_FmtDig4 (CPU_INT16U   val,
+                           CPU_CHAR    *pstr)
+{
+    CPU_INT16U  hi;
+    CPU_INT16U  lo;
+
+
+    hi      = (CPU_INT16U)(((CPU_INT32U)val * 5243) >> 19);     /* hi = val / 100 (see Note #1).                        */
+    lo      = (CPU_INT16U)(val - (hi * 100));
+
+    pstr[0] = Str_DigPairTbl[(hi * 2)    ];
+    pstr[1] = Str_DigPairTbl[(hi * 2) + 1];
+    pstr[2] = Str_DigPairTbl[(lo * 2)    ];
+    pstr[3] = Str_DigPairTbl[(lo * 2) + 1];
+}
+
@@ -248,6 +248,12 @@ CPU_CHAR    *Str_FmtNbr_32(CPU_FP32      nbr,
                            CPU_CHAR     *pstr_fmt);
 #endif
 
+CPU_CHAR    *Str_FmtNbr_Int32U(CPU_INT32U    nbr,
+                               CPU_INT08U    nbr_dig,
+                               CPU_CHAR      lead_char,
+                               CPU_BOOLEAN   nul,
+                               CPU_CHAR     *pstr_fmt);
+
 
 /*$PAGE*/
 /*
@@ -102,6 +102,14 @@ static  void  ProbeRS232_OS_Task(void *p_arg);                          /* Probe
   #error  "If PROBE_RS232_PARSE_TASK is set to DEF_TRUE, then semaphores MUST be enabled."
 #endif
 
+#if (PROBE_RS232_PARSE_TASK > 0) && (OS_TIME_DLY_HMSM_EN == 0)
+  #error  "If PROBE_RS232_PARSE_TASK is set to DEF_TRUE, then OSTimeDlyHMSM() MUST be enabled."
+#endif
+
+#if (PROBE_COM_SUPPORT_STREAM == DEF_TRUE) && (OS_TIME_GET_SET_EN == 0)
+  #error  "If PROBE_COM_SUPPORT_STREAM is set to DEF_TRUE, then OSTimeGet() MUST be enabled."
+#endif
+
 
 /*
 *********************************************************************************************************
@@ -187,21 +195,34 @@ void  ProbeRS232_OS_Init (void)
 *
 * Description : Wait for a packet to be received.
 *
-* Argument(s) : none.
+* Argument(s) : tmo         Timeout, in milliseconds.  If this value is zero, then the function waits
+*                           forever.
 *
-* Return(s)   : none.
+* Return(s)   : DEF_TRUE   if a packet was received.
+*               DEF_FALSE  if the timeout expired.
 *********************************************************************************************************
 */
 
 #if (PROBE_RS232_PARSE_TASK > 0)
-void  ProbeRS232_OS_Pend (void)
+CPU_BOOLEAN  ProbeRS232_OS_Pend (CPU_INT16U  tmo)
 {
 #if (OS_SEM_EN > 0)
+    CPU_INT32U  ticks;
     CPU_INT08U  err;
 
 
-    OSSemPend(ProbeRS232_OS_Sem, 0, &err);                          /* Wait for a packet to be received                     */
+    ticks = ((CPU_INT32U)tmo * OS_TICKS_PER_SEC + 999) / 1000;     /* Round timeout up to a whole tick                     */
+    if (ticks > 65535) {
+        ticks = 65535;
+    }
+
+    OSSemPend(ProbeRS232_OS_Sem, (INT16U)ticks, &err);              /* Wait for a packet to be received                     */
+    if (err != OS_NO_ERR) {
+        return (DEF_FALSE);
+    }
 #endif
+
+    return (DEF_TRUE);
 }
 #endif
 
@@ -228,6 +249,54 @@ void  ProbeRS232_OS_Post (void)
 #endif
 
 
+/*
+*********************************************************************************************************
+*                                        ProbeRS232_OS_Dly()
+*
+* Description : Delay for a certain number of milliseconds.
+*
+* Argument(s) : dly         Delay, in milliseconds.
+*
+* Return(s)   : none.
+*********************************************************************************************************
+*/
+
+#if (PROBE_RS232_PARSE_TASK > 0)
+void  ProbeRS232_OS_Dly (CPU_INT16U  dly)
+{
+    if (dly >= 1000) {
+        OSTimeDlyHMSM(0, 0, 1, 0);
+    } else {
+        OSTimeDlyHMSM(0, 0, 0, dly);
+    }
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                      ProbeRS232_OS_TimeGet()
+*
+* Description : Get the current time.
+*
+* Argument(s) : none.
+*
+* Return(s)   : The time since the OS started, in milliseconds.
+*********************************************************************************************************
+*/
+
+#if (PROBE_COM_SUPPORT_STREAM == DEF_TRUE)
+CPU_INT32U  ProbeRS232_OS_TimeGet (void)
+{
+    CPU_INT32U  ticks;
+
+
+    ticks = OSTimeGet();
+    return ((ticks / OS_TICKS_PER_SEC) * 1000 + ((ticks % OS_TICKS_PER_SEC) * 1000) / OS_TICKS_PER_SEC);
+}
+#endif
+
+
 /*
 *********************************************************************************************************
 *********************************************************************************************************
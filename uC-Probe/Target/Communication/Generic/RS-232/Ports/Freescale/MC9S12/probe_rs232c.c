@@ -102,6 +102,12 @@ void  ProbeRS232_InitTarget (CPU_INT32U baud)
 *                 ProbeRS232_TxISR for both Rx and Tx SCI interrupts (See probe_rs232_ba.s).
 *              3) When changing the value of PROBE_RS232_COMM_SEL from within probe_com_cfg.h,
 *                 the interrupt vector table within vectors.c must be updated as well.
+*              4) Transmission is driven by the Transmit Data Register Empty (TDRE) interrupt rather
+*                 than Transmit Complete (TC).  TDRE is raised as soon as a byte moves into the shift
+*                 register, so the next byte is loaded while the current one is still being sent &
+*                 the frame goes out back to back, with no gap for the interrupt latency.
+*              5) TDRE stays set whenever the data register is empty, so it is only serviced while
+*                 the Tx interrupt is enabled.
 *********************************************************************************************************
 */
 
@@ -115,7 +121,8 @@ void  ProbeRS232_RxTxISRHandler (void)
     if ((status & SCI0SR1_RDRF_MASK) == SCI0SR1_RDRF_MASK) {            /* If Receive Interrupt                                     */
         ProbeRS232_RxHandler(SCI0DRL);                                  /* Call the generic Rx handler                              */
     } 
-    if ((status & SCI0SR1_TC_MASK) == SCI0SR1_TC_MASK) {                /* If Transmit Complete Interrupt                           */
+    if (((status  & SCI0SR1_TDRE_MASK) == SCI0SR1_TDRE_MASK) &&         /* If Transmit Data Register Empty Interrupt (see Note #5)  */
+        ((SCI0CR2 & SCI0SR1_TDRE_MASK) == SCI0SR1_TDRE_MASK)) {
    	    ProbeRS232_TxHandler();
     }
 #endif
@@ -125,7 +132,8 @@ void  ProbeRS232_RxTxISRHandler (void)
     if ((status & SCI1SR1_RDRF_MASK) == SCI1SR1_RDRF_MASK) {            /* If Receive Interrupt                                     */
         ProbeRS232_RxHandler(SCI1DRL);                                  /* Call the generic Rx handler                              */
     } else {
-        if ((status & SCI1SR1_TC_MASK) == SCI1SR1_TC_MASK) {            /* If Transmit Complete Interrupt                           */
+        if (((status  & SCI1SR1_TDRE_MASK) == SCI1SR1_TDRE_MASK) &&     /* If Transmit Data Register Empty Interrupt (see Note #5)  */
+            ((SCI1CR2 & SCI1SR1_TDRE_MASK) == SCI1SR1_TDRE_MASK)) {
        	    ProbeRS232_TxHandler();
         }
     }
@@ -168,11 +176,11 @@ void  ProbeRS232_Tx1 (CPU_INT08U c)
 void  ProbeRS232_TxIntDis (void) 
 {
 #if (PROBE_RS232_COMM_SEL == PROBE_RS232_UART_0)
-    SCI0CR2 &= ~SCI0SR1_TC_MASK;                                        /* disable tx interrupts				                    */
+    SCI0CR2 &= ~SCI0SR1_TDRE_MASK;                                      /* disable tx interrupts				                    */
 #endif
 
 #if (PROBE_RS232_COMM_SEL == PROBE_RS232_UART_1)
-    SCI1CR2 &= ~SCI1SR1_TC_MASK;                                        /* disable tx interrupts				                    */
+    SCI1CR2 &= ~SCI1SR1_TDRE_MASK;                                      /* disable tx interrupts				                    */
 #endif      
 }
 
@@ -185,11 +193,11 @@ void  ProbeRS232_TxIntDis (void)
 void  ProbeRS232_TxIntEn (void) 
 {
 #if (PROBE_RS232_COMM_SEL == PROBE_RS232_UART_0)
-    SCI0CR2 |=  SCI0SR1_TC_MASK;                                        /* enable tx interrupts				                        */
+    SCI0CR2 |=  SCI0SR1_TDRE_MASK;                                      /* enable tx interrupts				                        */
 #endif
 
 #if (PROBE_RS232_COMM_SEL == PROBE_RS232_UART_1)
-    SCI1CR2 |=  SCI1SR1_TC_MASK;                                        /* enable tx interrupts				                        */
+    SCI1CR2 |=  SCI1SR1_TDRE_MASK;                                      /* enable tx interrupts				                        */
 #endif   
 }
 
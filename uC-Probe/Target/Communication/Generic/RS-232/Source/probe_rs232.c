@@ -72,6 +72,26 @@
 *                                       +-------------------+-------------------+
 *                                       | Checksum|   '/'   |
 *                                       +-------------------+
+*
+*           (2) If PROBE_COM_SUPPORT_CRC16 is DEF_TRUE, the host may instead frame a packet with a CRC-16
+*               by setting PROBE_RS232_PAD_CRC16 in the first padding byte.  The checksum is then replaced
+*               by a CRC-16/CCITT (polynomial 0x1021, initial value 0xFFFF), most significant byte first,
+*               computed over the length, the padding & the data:
+*
+*                                       +-------------------+-------------------+
+*                                       |   'u'   |   'C'   |   'P'   |   'r'   |
+*                                       +-------------------+-------------------+
+*                                       |       Length      |  0x01   |  0x00   |
+*                                       +-------------------+-------------------+
+*                                       |                  Data                 |
+*                                       |                   .                   |
+*                                       +-------------------+-------------------+
+*                                       | CRC(hi) | CRC(lo) |   '/'   |
+*                                       +-----------------------------+
+*
+*               Each response is framed like the request it answers; snapshots are framed like the last
+*               request.  The host learns that CRC-16 framing is accepted from the PROBE_COM_FMT_CRC16
+*               entry in the response to a PROBE_COM_QUERY_FMT_SUPPORT query.
 *********************************************************************************************************
 */
 
@@ -101,22 +121,33 @@
 #define  PROBE_RS232_RX_STATE_DATA                         8    /* Waiting for data.                                    */
 #define  PROBE_RS232_RX_STATE_CHKSUM                       9    /* Waiting for checksum.                                */
 #define  PROBE_RS232_RX_STATE_ED                          10    /* Waiting for end delimiter.                           */
+#define  PROBE_RS232_RX_STATE_CRC2                        11    /* Waiting for CRC-16, second byte.                     */
+
+                                                                /* ------------------ CRC-16 FRAMING ----------------- */
+#define  PROBE_RS232_PAD_CRC16                          0x01    /* Pkt framed with CRC-16 (see Note #2).                */
+#define  PROBE_RS232_CRC16_INIT                       0xFFFF    /* CRC-16/CCITT initial value.                          */
 
-                                                                /* ---------- TRANSMIT STATE MACHINE STATES ----------- */
-#define  PROBE_RS232_TX_STATE_SD0                          0    /* Waiting to send start first  start delim. (SD0).     */
-#define  PROBE_RS232_TX_STATE_SD1                          1    /* Waiting to send start second start delim. (SD1).     */
-#define  PROBE_RS232_TX_STATE_SD2                          2    /* Waiting to send start third  start delim. (SD2).     */
-#define  PROBE_RS232_TX_STATE_SD3                          3    /* Waiting to send start fourth start delim. (SD3).     */
-#define  PROBE_RS232_TX_STATE_LEN1                         4    /* Waiting to send length,  first  byte.                */
-#define  PROBE_RS232_TX_STATE_LEN2                         5    /* Waiting to send length,  second byte.                */
-#define  PROBE_RS232_TX_STATE_PAD1                         6    /* Waiting to send padding, first  byte.                */
-#define  PROBE_RS232_TX_STATE_PAD2                         7    /* Waiting to send padding, second byte.                */
-#define  PROBE_RS232_TX_STATE_DATA                         8    /* Waiting to send data.                                */
-#define  PROBE_RS232_TX_STATE_CHKSUM                       9    /* Waiting to send checksum.                            */
-#define  PROBE_RS232_TX_STATE_ED                          10    /* Waiting to send end delimiter.                       */
+                                                                /* Add a byte to a CRC-16 (see 'ProbeRS232_CRC16Tbl'). */
+#define  PROBE_RS232_CRC16_UPD(crc, data)    (CPU_INT16U)(((crc) << 8) ^ ProbeRS232_CRC16Tbl[((crc) >> 8) ^ (data)])
+
+                                                                /* -------------- TRANSMIT FRAME LAYOUT --------------- */
+#define  PROBE_RS232_TX_HDR_SIZE                           8    /* Start delims (4), len (2) & padding (2).             */
+#define  PROBE_RS232_TX_FTR_SIZE                           2    /* Checksum (1) & end delim (1).                        */
+#define  PROBE_RS232_TX_FTR_CRC16_SIZE                     3    /* CRC-16   (2) & end delim (1).                        */
+#define  PROBE_RS232_TX_FRAME_SIZE    (PROBE_RS232_TX_HDR_SIZE + PROBE_RS232_TX_BUF_SIZE + PROBE_RS232_TX_FTR_CRC16_SIZE)
 
 #define  PROBE_RS232_USE_CHECKSUM                  DEF_FALSE    /* DO NOT CHANGE                                        */
 
+                                                                /* --------------- SCATTERED RESPONSES ---------------- */
+#if    ((PROBE_COM_SUPPORT_SG     == DEF_TRUE ) && \
+        (PROBE_RS232_USE_CHECKSUM == DEF_FALSE))                /* See 'ProbeRS232_TxStart()' Note #2.                  */
+#define  PROBE_RS232_USE_SG                        DEF_TRUE
+#define  PROBE_RS232_TX_SEG_NBR    (PROBE_COM_SG_SEG_NBR + 1)   /* Rsp segs + ftr.                                      */
+#else
+#define  PROBE_RS232_USE_SG                       DEF_FALSE
+#define  PROBE_RS232_TX_SEG_NBR                            2    /* Rsp + ftr.                                           */
+#endif
+
 /*
 *********************************************************************************************************
 *                                             LOCAL CONSTANTS
@@ -130,6 +161,12 @@
 *********************************************************************************************************
 */
 
+typedef  struct  probe_rs232_tx_pkt {
+    CPU_INT08U        Buf[PROBE_RS232_TX_FRAME_SIZE];           /* Hdr, rsp & ftr of pkt.                               */
+    PROBE_COM_TX_SEG  SegTbl[PROBE_RS232_TX_SEG_NBR];           /* Segs of pkt (see 'ProbeRS232_TxStart()').            */
+    CPU_INT08U        SegNbr;                                   /* Nbr of segs in pkt.                                  */
+} PROBE_RS232_TX_PKT;
+
 
 /*
 *********************************************************************************************************
@@ -137,6 +174,43 @@
 *********************************************************************************************************
 */
 
+#if (PROBE_COM_SUPPORT_CRC16 == DEF_TRUE)                       /* CRC-16/CCITT of each byte value (poly 0x1021).       */
+static  const  CPU_INT16U  ProbeRS232_CRC16Tbl[256] = {
+    0x0000, 0x1021, 0x2042, 0x3063, 0x4084, 0x50A5, 0x60C6, 0x70E7,
+    0x8108, 0x9129, 0xA14A, 0xB16B, 0xC18C, 0xD1AD, 0xE1CE, 0xF1EF,
+    0x1231, 0x0210, 0x3273, 0x2252, 0x52B5, 0x4294, 0x72F7, 0x62D6,
+    0x9339, 0x8318, 0xB37B, 0xA35A, 0xD3BD, 0xC39C, 0xF3FF, 0xE3DE,
+    0x2462, 0x3443, 0x0420, 0x1401, 0x64E6, 0x74C7, 0x44A4, 0x5485,
+    0xA56A, 0xB54B, 0x8528, 0x9509, 0xE5EE, 0xF5CF, 0xC5AC, 0xD58D,
+    0x3653, 0x2672, 0x1611, 0x0630, 0x76D7, 0x66F6, 0x5695, 0x46B4,
+    0xB75B, 0xA77A, 0x9719, 0x8738, 0xF7DF, 0xE7FE, 0xD79D, 0xC7BC,
+    0x48C4, 0x58E5, 0x6886, 0x78A7, 0x0840, 0x1861, 0x2802, 0x3823,
+    0xC9CC, 0xD9ED, 0xE98E, 0xF9AF, 0x8948, 0x9969, 0xA90A, 0xB92B,
+    0x5AF5, 0x4AD4, 0x7AB7, 0x6A96, 0x1A71, 0x0A50, 0x3A33, 0x2A12,
+    0xDBFD, 0xCBDC, 0xFBBF, 0xEB9E, 0x9B79, 0x8B58, 0xBB3B, 0xAB1A,
+    0x6CA6, 0x7C87, 0x4CE4, 0x5CC5, 0x2C22, 0x3C03, 0x0C60, 0x1C41,
+    0xEDAE, 0xFD8F, 0xCDEC, 0xDDCD, 0xAD2A, 0xBD0B, 0x8D68, 0x9D49,
+    0x7E97, 0x6EB6, 0x5ED5, 0x4EF4, 0x3E13, 0x2E32, 0x1E51, 0x0E70,
+    0xFF9F, 0xEFBE, 0xDFDD, 0xCFFC, 0xBF1B, 0xAF3A, 0x9F59, 0x8F78,
+    0x9188, 0x81A9, 0xB1CA, 0xA1EB, 0xD10C, 0xC12D, 0xF14E, 0xE16F,
+    0x1080, 0x00A1, 0x30C2, 0x20E3, 0x5004, 0x4025, 0x7046, 0x6067,
+    0x83B9, 0x9398, 0xA3FB, 0xB3DA, 0xC33D, 0xD31C, 0xE37F, 0xF35E,
+    0x02B1, 0x1290, 0x22F3, 0x32D2, 0x4235, 0x5214, 0x6277, 0x7256,
+    0xB5EA, 0xA5CB, 0x95A8, 0x8589, 0xF56E, 0xE54F, 0xD52C, 0xC50D,
+    0x34E2, 0x24C3, 0x14A0, 0x0481, 0x7466, 0x6447, 0x5424, 0x4405,
+    0xA7DB, 0xB7FA, 0x8799, 0x97B8, 0xE75F, 0xF77E, 0xC71D, 0xD73C,
+    0x26D3, 0x36F2, 0x0691, 0x16B0, 0x6657, 0x7676, 0x4615, 0x5634,
+    0xD94C, 0xC96D, 0xF90E, 0xE92F, 0x99C8, 0x89E9, 0xB98A, 0xA9AB,
+    0x5844, 0x4865, 0x7806, 0x6827, 0x18C0, 0x08E1, 0x3882, 0x28A3,
+    0xCB7D, 0xDB5C, 0xEB3F, 0xFB1E, 0x8BF9, 0x9BD8, 0xABBB, 0xBB9A,
+    0x4A75, 0x5A54, 0x6A37, 0x7A16, 0x0AF1, 0x1AD0, 0x2AB3, 0x3A92,
+    0xFD2E, 0xED0F, 0xDD6C, 0xCD4D, 0xBDAA, 0xAD8B, 0x9DE8, 0x8DC9,
+    0x7C26, 0x6C07, 0x5C64, 0x4C45, 0x3CA2, 0x2C83, 0x1CE0, 0x0CC1,
+    0xEF1F, 0xFF3E, 0xCF5D, 0xDF7C, 0xAF9B, 0xBFBA, 0x8FD9, 0x9FF8,
+    0x6E17, 0x7E36, 0x4E55, 0x5E74, 0x2E93, 0x3EB2, 0x0ED1, 0x1EF0
+};
+#endif
+
 
 /*
 *********************************************************************************************************
@@ -150,28 +224,51 @@ static  CPU_INT16U   ProbeRS232_RxRemainLen;                    /* Remaining byt
 
                                                                 /* ----------------- RX PKT VARIABLES ----------------- */
 static  CPU_INT16U   ProbeRS232_RxLen;                          /* Length  of data in current pkt.                      */
-static  CPU_INT08U   ProbeRS232_RxBuf[PROBE_RS232_RX_BUF_SIZE]; /* Data    of current pkt.                              */
 #if (PROBE_RS232_USE_CHECKSUM == DEF_TRUE)
 static  CPU_INT08U   ProbeRS232_RxChkSum;                       /* Checksum of current pkt.                             */
+#endif
+#if (PROBE_COM_SUPPORT_CRC16    == DEF_TRUE)
+static  CPU_BOOLEAN  ProbeRS232_RxCRCEn;                        /* Indicates current pkt is framed with CRC-16.         */
+static  CPU_INT16U   ProbeRS232_RxCRC;                          /* CRC-16 of current pkt.                               */
 #endif
 
-                                                                /* --------------- RX DATA BUF VARIABLE --------------- */
+                                                                /* --------------- RX DATA BUF VARIABLES -------------- */
+                                                                /* Data of rx'd pkts (see 'ProbeRS232_RxPkt()').        */
+static  CPU_INT08U   ProbeRS232_RxBuf[PROBE_RS232_PIPE_DEPTH][PROBE_RS232_RX_BUF_SIZE];
+                                                                /* Length of data in each buf.                          */
+static  CPU_INT16U   ProbeRS232_RxBufLen[PROBE_RS232_PIPE_DEPTH];
+#if (PROBE_COM_SUPPORT_CRC16 == DEF_TRUE)                       /* Framing of each buf.                                 */
+static  CPU_BOOLEAN  ProbeRS232_RxBufCRCEn[PROBE_RS232_PIPE_DEPTH];
+#endif
 static  CPU_INT16U   ProbeRS232_RxBufWrIx;                      /* Index of next write; also number of bytes in buf.    */
+static  CPU_INT08U   ProbeRS232_RxPktWrIx;                      /* Index of buf being rx'd into.                        */
+static  CPU_INT08U   ProbeRS232_RxPktRdIx;                      /* Index of next buf to parse.                          */
+static  CPU_INT08U   ProbeRS232_RxPktNbr;                       /* Nbr of rx'd pkts not yet parsed.                     */
 
                                                                 /* ---------------- TX STATE VARIABLES ---------------- */
-static  CPU_INT08U   ProbeRS232_TxState;                        /* Current state of TX state machine.                   */
 static  CPU_BOOLEAN  ProbeRS232_TxActiveFlag;                   /* Indicates TX is currently active.                    */
+#if (PROBE_COM_SUPPORT_CRC16 == DEF_TRUE)
+static  CPU_BOOLEAN  ProbeRS232_TxCRCEn;                        /* Indicates rsp's are framed with CRC-16.              */
+#endif
 
                                                                 /* ----------------- TX PKT VARIABLES ----------------- */
-static  CPU_INT16U   ProbeRS232_TxLen;                          /* Length  of data in current pkt.                      */
-static  CPU_INT08U   ProbeRS232_TxBuf[PROBE_RS232_TX_BUF_SIZE]; /* Data    of current pkt.                              */
-#if (PROBE_RS232_USE_CHECKSUM == DEF_TRUE)
-static  CPU_INT08U   ProbeRS232_TxChkSum;                       /* Checksum of current pkt.                             */
-#endif
+                                                                /* Formed & tx'd pkts (see 'ProbeRS232_TxStart()').     */
+static  PROBE_RS232_TX_PKT  ProbeRS232_TxPktTbl[PROBE_RS232_PIPE_DEPTH];
+static  CPU_INT08U          ProbeRS232_TxPktWrIx;               /* Index of next pkt to form.                           */
+static  CPU_INT08U          ProbeRS232_TxPktRdIx;               /* Index of pkt being tx'd.                             */
+static  CPU_INT08U          ProbeRS232_TxPktNbr;                /* Nbr of pkts formed & not yet wholly tx'd.            */
 
                                                                 /* --------------- TX DATA BUF VARIABLES -------------- */
-static  CPU_BOOLEAN  ProbeRS232_TxBufInUse;                     /* Indicates TX buf currently holds a pkt.              */
-static  CPU_INT16U   ProbeRS232_TxBufRdIx;                      /* Index of next read.                                  */
+static  PROBE_COM_TX_SEG   *ProbeRS232_TxSegPtr;                /* Ptr to seg being tx'd.                               */
+static  CPU_INT08U          ProbeRS232_TxSegLeft;               /* Nbr of segs after the one being tx'd.                */
+static  CPU_INT08U         *ProbeRS232_TxPtr;                   /* Ptr to next byte to tx.                              */
+static  CPU_INT16U          ProbeRS232_TxSegRemain;             /* Nbr of bytes left in seg being tx'd.                 */
+
+#if (PROBE_COM_SUPPORT_STREAM == DEF_TRUE)
+                                                                /* ---------------- STREAM VARIABLES ------------------ */
+static  CPU_BOOLEAN  ProbeRS232_StreamActive;                   /* Indicates snapshots are being scheduled.             */
+static  CPU_INT32U   ProbeRS232_StreamNextTS;                   /* Time at which next snapshot is due, in ms.           */
+#endif
 
 
 
@@ -189,7 +286,13 @@ static  void        ProbeRS232_RxStoINT8U(CPU_INT08U  rx_data);
 
 static  void        ProbeRS232_RxBufClr  (void);
 
-static  void        ProbeRS232_TxStart   (void);
+static  void        ProbeRS232_TxStart   (CPU_INT16U  len);
+
+static  void        ProbeRS232_TxPktLoad (void);
+
+#if (PROBE_COM_SUPPORT_STREAM == DEF_TRUE)
+static  CPU_INT16U  ProbeRS232_StreamTx  (void);
+#endif
 
 
 /*
@@ -217,16 +320,48 @@ static  void        ProbeRS232_TxStart   (void);
 
 void  ProbeRS232_Init (CPU_INT32U baud_rate)
 {
-    ProbeRS232_RxState      = PROBE_RS232_RX_STATE_SD0;         /* Setup Rx and Tx state machines.                      */
-    ProbeRS232_TxState      = PROBE_RS232_TX_STATE_SD0;
+    CPU_INT08U  ix;
+
+
+    ProbeRS232_RxState      = PROBE_RS232_RX_STATE_SD0;         /* Setup Rx state machine.                              */
+    ProbeRS232_RxPktWrIx    = 0;
+    ProbeRS232_RxPktRdIx    = 0;
+    ProbeRS232_RxPktNbr     = 0;
+
+    for (ix = 0; ix < PROBE_RS232_PIPE_DEPTH; ix++) {           /* Pre-serialize the constant part of each TX hdr.      */
+        ProbeRS232_TxPktTbl[ix].Buf[0] = PROBE_RS232_PROTOCOL_TX_SD0;
+        ProbeRS232_TxPktTbl[ix].Buf[1] = PROBE_RS232_PROTOCOL_TX_SD1;
+        ProbeRS232_TxPktTbl[ix].Buf[2] = PROBE_RS232_PROTOCOL_TX_SD2;
+        ProbeRS232_TxPktTbl[ix].Buf[3] = PROBE_RS232_PROTOCOL_TX_SD3;
+        ProbeRS232_TxPktTbl[ix].Buf[6] = 0;
+        ProbeRS232_TxPktTbl[ix].Buf[7] = 0;
+        ProbeRS232_TxPktTbl[ix].SegNbr = 0;
+    }
 
-    ProbeRS232_TxLen        = 0;
+    ProbeRS232_TxPktWrIx    = 0;
+    ProbeRS232_TxPktRdIx    = 0;
+    ProbeRS232_TxPktNbr     = 0;
+    ProbeRS232_TxSegLeft    = 0;
+    ProbeRS232_TxSegRemain  = 0;
     ProbeRS232_TxActiveFlag = DEF_FALSE;
-    ProbeRS232_TxBufInUse   = DEF_FALSE;
+#if (PROBE_COM_SUPPORT_CRC16  == DEF_TRUE)
+    ProbeRS232_TxCRCEn      = DEF_FALSE;
+#endif
+
+#if (PROBE_COM_SUPPORT_STREAM == DEF_TRUE)
+    ProbeRS232_StreamActive = DEF_FALSE;
+#endif
 
 #if (PROBE_COM_STAT_EN     == DEF_ENABLED)
     ProbeRS232_RxCtr        = 0;
     ProbeRS232_TxCtr        = 0;
+    ProbeRS232_RxDropCtr    = 0;
+#if (PROBE_COM_SUPPORT_CRC16  == DEF_TRUE)
+    ProbeRS232_RxCRCErrCtr  = 0;
+#endif
+#if (PROBE_COM_SUPPORT_STREAM == DEF_TRUE)
+    ProbeRS232_StreamSkipCtr = 0;
+#endif
 #endif
 
 #if (PROBE_RS232_PARSE_TASK == DEF_TRUE)
@@ -249,26 +384,46 @@ void  ProbeRS232_Init (CPU_INT32U baud_rate)
 *
 * Caller(s)   : ProbeRS232_OS_Task().
 *
-* Note(s)     : none.
+* Note(s)     : (1) While a stream is running, the task wakes up when the next snapshot is due as well as
+*                   when a packet is received.  See 'ProbeRS232_StreamTx()'.
+*
+*               (2) A request received while every TX packet still holds a response or a snapshot is held
+*                   until one is free, rather than dropped.
+*
+*               (3) Up to PROBE_RS232_PIPE_DEPTH requests may be received & parsed ahead of the responses
+*                   being transmitted, so the next request is handled while the previous response is
+*                   still being shifted out (see 'ProbeRS232_RxPkt()' & 'ProbeRS232_TxStart()').
 *********************************************************************************************************
 */
 
 #if (PROBE_RS232_PARSE_TASK == DEF_TRUE)
 void  ProbeRS232_Task (void *p_arg)
 {
-    CPU_INT16U  len;
+    CPU_INT16U   len;
+    CPU_INT16U   tmo;
+    CPU_BOOLEAN  rxd;
 
 
     (void)p_arg;
 
     while (DEF_TRUE) {
-        ProbeRS232_OS_Pend();                                   /* Wait for a packet to be received.                    */
-
-        len = ProbeRS232_ParseRxPkt();                          /* Parse packet and formulate a response.               */
-
-        if (len > 0) {                                          /* If we have a response.                               */
-            ProbeRS232_TxLen = len;
-            ProbeRS232_TxStart();
+#if (PROBE_COM_SUPPORT_STREAM == DEF_TRUE)
+        tmo = ProbeRS232_StreamTx();                            /* Tx snapshot if due (see Note #1).                    */
+#else
+        tmo = 0;
+#endif
+        rxd = ProbeRS232_OS_Pend(tmo);                          /* Wait for a packet to be received.                    */
+
+        if (rxd == DEF_TRUE) {
+                                                                /* See Note #2.                                         */
+            while (ProbeRS232_TxPktNbr >= PROBE_RS232_PIPE_DEPTH) {
+                ProbeRS232_OS_Dly(1);
+            }
+            len = ProbeRS232_ParseRxPkt();                      /* Parse packet and formulate a response (see Note #3). */
+
+            if (len > 0) {                                      /* If we have a response.                               */
+                ProbeRS232_TxStart(len);
+            }
         }
     }
 }
@@ -295,7 +450,11 @@ void  ProbeRS232_Task (void *p_arg)
 *
 * Caller(s)   : Rx ISR.
 *
-* Note(s)     : none.
+* Note(s)     : (1) For a packet framed with a CRC-16, the CRC is updated as each byte is received.  The
+*                   length & first padding byte are only added once the padding byte shows the framing,
+*                   so packets framed with a checksum cost no more than before.  Since the CRC is sent
+*                   most significant byte first, adding the two CRC bytes leaves zero if the packet is
+*                   intact.
 *********************************************************************************************************
 */
 
@@ -359,6 +518,14 @@ void  ProbeRS232_RxHandler (CPU_INT08U rx_data)
                                                                 /* Chk len.                                             */
              if ((ProbeRS232_RxRemainLen == 0) || (ProbeRS232_RxRemainLen > PROBE_RS232_RX_BUF_SIZE)) {
                  ProbeRS232_RxState  = PROBE_RS232_RX_STATE_SD0;
+
+             } else if (ProbeRS232_RxPktNbr >= PROBE_RS232_PIPE_DEPTH) {
+                                                                /* Drop pkt if no rx buf is free.                       */
+                 ProbeRS232_RxState  = PROBE_RS232_RX_STATE_SD0;
+#if (PROBE_COM_STAT_EN == DEF_ENABLED)
+                 ProbeRS232_RxDropCtr++;
+#endif
+
              } else {
                  ProbeRS232_RxLen    = ProbeRS232_RxRemainLen;
                  ProbeRS232_RxState  = PROBE_RS232_RX_STATE_PAD1;
@@ -367,11 +534,27 @@ void  ProbeRS232_RxHandler (CPU_INT08U rx_data)
 
 
         case PROBE_RS232_RX_STATE_PAD1:                         /* Rx'd the 1st padding byte.                           */
+#if (PROBE_COM_SUPPORT_CRC16 == DEF_TRUE)
+             if ((rx_data & PROBE_RS232_PAD_CRC16) != 0) {      /* If pkt is framed with CRC-16 (see Note #1) ...       */
+                 ProbeRS232_RxCRCEn = DEF_TRUE;                 /*  ... start CRC with len & padding.                   */
+                 ProbeRS232_RxCRC   = PROBE_RS232_CRC16_INIT;
+                 ProbeRS232_RxCRC   = PROBE_RS232_CRC16_UPD(ProbeRS232_RxCRC, ProbeRS232_RxLen & 0xFF);
+                 ProbeRS232_RxCRC   = PROBE_RS232_CRC16_UPD(ProbeRS232_RxCRC, ProbeRS232_RxLen >> 8);
+                 ProbeRS232_RxCRC   = PROBE_RS232_CRC16_UPD(ProbeRS232_RxCRC, rx_data);
+             } else {
+                 ProbeRS232_RxCRCEn = DEF_FALSE;
+             }
+#endif
              ProbeRS232_RxState = PROBE_RS232_RX_STATE_PAD2;
              break;
 
 
         case PROBE_RS232_RX_STATE_PAD2:                         /* Rx'd the 2nd  padding byte.                          */
+#if (PROBE_COM_SUPPORT_CRC16 == DEF_TRUE)
+             if (ProbeRS232_RxCRCEn == DEF_TRUE) {
+                 ProbeRS232_RxCRC = PROBE_RS232_CRC16_UPD(ProbeRS232_RxCRC, rx_data);
+             }
+#endif
              ProbeRS232_RxState = PROBE_RS232_RX_STATE_DATA;
              break;
 
@@ -380,6 +563,11 @@ void  ProbeRS232_RxHandler (CPU_INT08U rx_data)
              ProbeRS232_RxStoINT8U(rx_data);
 #if (PROBE_RS232_USE_CHECKSUM == DEF_TRUE)
              ProbeRS232_RxChkSum += rx_data;
+#endif
+#if (PROBE_COM_SUPPORT_CRC16  == DEF_TRUE)
+             if (ProbeRS232_RxCRCEn == DEF_TRUE) {
+                 ProbeRS232_RxCRC = PROBE_RS232_CRC16_UPD(ProbeRS232_RxCRC, rx_data);
+             }
 #endif
              if (--ProbeRS232_RxRemainLen == 0) {
                  ProbeRS232_RxState = PROBE_RS232_RX_STATE_CHKSUM;
@@ -388,6 +576,13 @@ void  ProbeRS232_RxHandler (CPU_INT08U rx_data)
 
 
         case PROBE_RS232_RX_STATE_CHKSUM:                       /* Rx'd the checksum.                                   */
+#if (PROBE_COM_SUPPORT_CRC16  == DEF_TRUE)
+             if (ProbeRS232_RxCRCEn == DEF_TRUE) {              /* If pkt is framed with CRC-16 ... rx'd 1st CRC byte.  */
+                 ProbeRS232_RxCRC   = PROBE_RS232_CRC16_UPD(ProbeRS232_RxCRC, rx_data);
+                 ProbeRS232_RxState = PROBE_RS232_RX_STATE_CRC2;
+                 break;
+             }
+#endif
 #if (PROBE_RS232_USE_CHECKSUM == DEF_TRUE)
              ProbeRS232_RxChkSum += rx_data;
              if ((ProbeRS232_RxChkSum & 0xFF) == 0x00) {
@@ -401,6 +596,21 @@ void  ProbeRS232_RxHandler (CPU_INT08U rx_data)
              break;
 
 
+#if (PROBE_COM_SUPPORT_CRC16 == DEF_TRUE)
+        case PROBE_RS232_RX_STATE_CRC2:                         /* Rx'd the 2nd CRC byte.                               */
+             ProbeRS232_RxCRC = PROBE_RS232_CRC16_UPD(ProbeRS232_RxCRC, rx_data);
+             if (ProbeRS232_RxCRC == 0) {                       /* Chk CRC (see Note #1).                               */
+                 ProbeRS232_RxState = PROBE_RS232_RX_STATE_ED;
+             } else {
+#if (PROBE_COM_STAT_EN == DEF_ENABLED)
+                 ProbeRS232_RxCRCErrCtr++;
+#endif
+                 ProbeRS232_RxState = PROBE_RS232_RX_STATE_SD0;
+             }
+             break;
+#endif
+
+
         case PROBE_RS232_RX_STATE_ED:                           /* Rx'd the end delimiter.                              */
              if (rx_data == PROBE_RS232_PROTOCOL_RX_ED) {
                  ProbeRS232_RxPkt();                            /* Parse rx'd pkt.                                      */
@@ -426,125 +636,69 @@ void  ProbeRS232_RxHandler (CPU_INT08U rx_data)
 *
 * Return(s)   : none.
 *
-* Caller(s)   : Tx ISR.
+* Caller(s)   : Tx ISR,
+*               ProbeRS232_TxStart().
 *
-* Note(s)     : none.
+* Note(s)     : (1) The header, the response & the footer are laid out as a list of segments by
+*                   'ProbeRS232_TxStart()', so each call only copies the next byte to the UART.
+*
+*               (2) The TX packet is released as soon as its last byte has been handed to the UART, so
+*                   the next response may be formed in it while that byte is still being shifted out.
+*
+*               (3) If further packets have been queued by 'ProbeRS232_TxStart()', the next is started at
+*                   once, so the packets leave back to back without waiting for the task.
+*
+*               (4) When packets are parsed in the ISR, a request received while every TX packet was in
+*                   use is still queued (see 'ProbeRS232_ParseRxPkt()  Note #1'); it is parsed as soon as a
+*                   TX packet is freed.
 *********************************************************************************************************
 */
 
 void  ProbeRS232_TxHandler (void)
 {
-    CPU_INT08U  tx_data;
+#if (PROBE_RS232_PARSE_TASK == DEF_FALSE)
+    CPU_INT16U  len;
 
 
+#endif
+    if (ProbeRS232_TxSegRemain > 0) {                           /* If pkt is waiting to be sent ...                     */
+        ProbeRS232_Tx1(*ProbeRS232_TxPtr);                      /*  ... tx next byte (see Note #1).                     */
+        ProbeRS232_TxActiveFlag = DEF_TRUE;
+        ProbeRS232_TxPtr++;
+        ProbeRS232_TxSegRemain--;
 #if (PROBE_COM_STAT_EN == DEF_ENABLED)
-    if ((ProbeRS232_TxState != PROBE_RS232_TX_STATE_SD0) ||
-        (ProbeRS232_TxLen    > 0                       )) {
         ProbeRS232_TxCtr++;
-    }
-#endif
-
-    switch (ProbeRS232_TxState) {
-        case PROBE_RS232_TX_STATE_SD0:
-             if (ProbeRS232_TxLen > 0) {                        /* If pkt is waiting to be sent ...                     */
-                 ProbeRS232_Tx1(PROBE_RS232_PROTOCOL_TX_SD0);   /*  ... tx start 1st start delimiter (SD0).             */
-                 ProbeRS232_TxActiveFlag = DEF_TRUE;
-                 ProbeRS232_TxState      = PROBE_RS232_TX_STATE_SD1;
-                 ProbeRS232_TxBufRdIx    = 0;
-
-             } else {                                           /* If no pkt is waiting to be sent ...                  */
-                 ProbeRS232_TxActiveFlag = DEF_FALSE;
-                 ProbeRS232_TxIntDis();                         /*  ... dis tx int's.                                   */
-             }
-             break;
-
-
-        case PROBE_RS232_TX_STATE_SD1:                          /* Tx start 2nd start delimiter (SD1).                  */
-             ProbeRS232_Tx1(PROBE_RS232_PROTOCOL_TX_SD1);
-             ProbeRS232_TxState = PROBE_RS232_TX_STATE_SD2;
-             break;
-
-
-        case PROBE_RS232_TX_STATE_SD2:                          /* Tx start 3rd start delimiter (SD2).                  */
-             ProbeRS232_Tx1(PROBE_RS232_PROTOCOL_TX_SD2);
-             ProbeRS232_TxState = PROBE_RS232_TX_STATE_SD3;
-             break;
-
-
-        case PROBE_RS232_TX_STATE_SD3:                          /* Tx start 4th start delimiter (SD3).                  */
-             ProbeRS232_Tx1(PROBE_RS232_PROTOCOL_TX_SD3);
-             ProbeRS232_TxState = PROBE_RS232_TX_STATE_LEN1;
-             break;
-
-
-        case PROBE_RS232_TX_STATE_LEN1:                         /* Tx 1st len byte.                                     */
-             tx_data             = ProbeRS232_TxLen & 0xFF;
-             ProbeRS232_Tx1(tx_data);
-             ProbeRS232_TxState  = PROBE_RS232_TX_STATE_LEN2;
-#if (PROBE_RS232_USE_CHECKSUM == DEF_TRUE)
-             ProbeRS232_TxChkSum = tx_data;
-#endif
-             break;
-
-
-        case PROBE_RS232_TX_STATE_LEN2:                         /* Tx 2nd len byte.                                     */
-             tx_data              = ProbeRS232_TxLen >> 8;
-             ProbeRS232_Tx1(tx_data);
-             ProbeRS232_TxState   = PROBE_RS232_TX_STATE_PAD1;
-#if (PROBE_RS232_USE_CHECKSUM == DEF_TRUE)
-             ProbeRS232_TxChkSum += tx_data;
-#endif
-             break;
-
-
-        case PROBE_RS232_TX_STATE_PAD1:                         /* Tx 1st padding byte.                                 */
-             ProbeRS232_Tx1(0);
-             ProbeRS232_TxState = PROBE_RS232_TX_STATE_PAD2;
-             break;
-
-
-        case PROBE_RS232_TX_STATE_PAD2:                         /* Tx 2nd padding byte.                                 */
-             ProbeRS232_Tx1(0);
-             ProbeRS232_TxState = PROBE_RS232_TX_STATE_DATA;
-             break;
-
-
-        case PROBE_RS232_TX_STATE_DATA:                         /* Tx data.                                             */
-             tx_data = ProbeRS232_TxBuf[ProbeRS232_TxBufRdIx];
-             ProbeRS232_Tx1(tx_data);
-#if (PROBE_RS232_USE_CHECKSUM == DEF_TRUE)
-             ProbeRS232_TxChkSum += tx_data;
 #endif
-             ProbeRS232_TxBufRdIx++;
-             if (ProbeRS232_TxBufRdIx >= ProbeRS232_TxLen) {
-                 ProbeRS232_TxState = PROBE_RS232_TX_STATE_CHKSUM;
-                 ProbeRS232_TxLen   = 0;
-             }
-             break;
-
 
-        case PROBE_RS232_TX_STATE_CHKSUM:                       /* Tx checksum.                                         */
-#if (PROBE_RS232_USE_CHECKSUM == DEF_TRUE)
-             ProbeRS232_Tx1(ProbeRS232_TxChkSum);
-#else
-             ProbeRS232_Tx1(0);
+        if (ProbeRS232_TxSegRemain == 0) {                      /* If end of seg ...                                    */
+            if (ProbeRS232_TxSegLeft > 0) {                     /*  ... start next seg                              ... */
+                ProbeRS232_TxSegLeft--;
+                ProbeRS232_TxSegPtr++;
+                ProbeRS232_TxPtr       = (CPU_INT08U *)ProbeRS232_TxSegPtr->DataPtr;
+                ProbeRS232_TxSegRemain =               ProbeRS232_TxSegPtr->DataLen;
+            } else {                                            /*  ... or, after end delim, free tx pkt (see Note #2). */
+                ProbeRS232_TxPktRdIx++;
+                if (ProbeRS232_TxPktRdIx >= PROBE_RS232_PIPE_DEPTH) {
+                    ProbeRS232_TxPktRdIx = 0;
+                }
+                ProbeRS232_TxPktNbr--;
+                if (ProbeRS232_TxPktNbr > 0) {                  /* Start next queued pkt (see Note #3).                 */
+                    ProbeRS232_TxPktLoad();
+                }
+#if (PROBE_RS232_PARSE_TASK == DEF_FALSE)
+                if (ProbeRS232_RxPktNbr > 0) {                  /* Parse held rx'd pkt (see Note #4).                   */
+                    len = ProbeRS232_ParseRxPkt();
+                    if (len > 0) {
+                        ProbeRS232_TxStart(len);
+                    }
+                }
 #endif
-             ProbeRS232_TxState = PROBE_RS232_TX_STATE_ED;
-             break;
-
-
-        case PROBE_RS232_TX_STATE_ED:                           /* Tx end delimiter.                                    */
-             ProbeRS232_Tx1(PROBE_RS232_PROTOCOL_TX_ED);
-             ProbeRS232_TxState    = PROBE_RS232_TX_STATE_SD0;
-             ProbeRS232_TxBufInUse = DEF_FALSE;
-             break;
-
+            }
+        }
 
-        default:
-             ProbeRS232_TxState      = PROBE_RS232_TX_STATE_SD0;
-             ProbeRS232_TxActiveFlag = DEF_FALSE;
-             ProbeRS232_TxIntDis();                             /* No more data to send, dis tx int's.                  */
-             break;
+    } else {                                                    /* If no pkt is waiting to be sent ...                  */
+        ProbeRS232_TxActiveFlag = DEF_FALSE;
+        ProbeRS232_TxIntDis();                                  /*  ... dis tx int's.                                   */
     }
 }
 
@@ -568,26 +722,75 @@ void  ProbeRS232_TxHandler (void)
 * Return(s)   : The number of bytes in the data segment of the packet to transmit in response.
 *
 * Caller(s)   : ProbeRS232_Task(),
-*               ProbeRS232_RxPkt().
+*               ProbeRS232_RxPkt(),
+*               ProbeRS232_TxHandler().
 *
-* Note(s)     : none.
+* Note(s)     : (1) The oldest received packet is parsed into the next free TX packet & its RX buffer is
+*                   released.  If no TX packet is free, the packet is left queued & 0 is returned: the task
+*                   waits for a TX packet before calling, & in the ISR the packet is parsed by
+*                   'ProbeRS232_TxHandler()' when one is freed.
+*
+*               (2) The CRC-16 of a response is computed before transmission starts, so a response to a
+*                   request framed with a CRC-16 is never scattered: it is formed wholly in the TX packet,
+*                   as if PROBE_COM_SUPPORT_SG were DEF_FALSE.
 *********************************************************************************************************
 */
 
 static  CPU_INT16U  ProbeRS232_ParseRxPkt (void)
 {
-    CPU_INT16U  tx_len;
+#if (CPU_CFG_CRITICAL_METHOD == CPU_CRITICAL_METHOD_STATUS_LOCAL)
+    CPU_SR               cpu_sr = 0;
+#endif
+    PROBE_RS232_TX_PKT  *ppkt;
+    CPU_INT08U          *prx;
+    CPU_INT16U           rx_len;
+    CPU_INT16U           tx_len;
+#if (PROBE_RS232_USE_SG == DEF_TRUE)
+    CPU_INT08U           seg_nbr_max;
+#endif
 
 
-    if (ProbeRS232_TxBufInUse == DEF_TRUE) {                    /* Do cmds only if Tx buffer is free.                   */
-        return (0);
-    }
+    tx_len = 0;
+    if (ProbeRS232_TxPktNbr < PROBE_RS232_PIPE_DEPTH) {         /* Do cmds only if a Tx pkt is free (see Note #1).      */
+        ppkt   = &ProbeRS232_TxPktTbl[ProbeRS232_TxPktWrIx];
+        prx    = &ProbeRS232_RxBuf[ProbeRS232_RxPktRdIx][0];
+        rx_len =  ProbeRS232_RxBufLen[ProbeRS232_RxPktRdIx];
+#if (PROBE_COM_SUPPORT_CRC16 == DEF_TRUE)                       /* Frame rsp like req.                                  */
+        ProbeRS232_TxCRCEn = ProbeRS232_RxBufCRCEn[ProbeRS232_RxPktRdIx];
+#endif
+#if (PROBE_RS232_USE_SG == DEF_TRUE)
+        seg_nbr_max = PROBE_COM_SG_SEG_NBR;
+#if (PROBE_COM_SUPPORT_CRC16 == DEF_TRUE)
+        if (ProbeRS232_TxCRCEn == DEF_TRUE) {                   /* See Note #2.                                         */
+            seg_nbr_max = 1;
+        }
+#endif
+        tx_len = ProbeCom_ParseRxPktSG((void             *)prx,
+                                       (void             *)&ppkt->Buf[PROBE_RS232_TX_HDR_SIZE],
+                                       (CPU_INT16U        )rx_len,
+                                       (CPU_INT16U        )PROBE_RS232_TX_BUF_SIZE,
+                                       (PROBE_COM_TX_SEG *)&ppkt->SegTbl[0],
+                                       (CPU_INT08U        )seg_nbr_max,
+                                       (CPU_INT08U       *)&ppkt->SegNbr);
+#else
+        tx_len = ProbeCom_ParseRxPkt((void     *)prx,
+                                     (void     *)&ppkt->Buf[PROBE_RS232_TX_HDR_SIZE],
+                                     (CPU_INT16U)rx_len,
+                                     (CPU_INT16U)PROBE_RS232_TX_BUF_SIZE);
+
+        ppkt->SegTbl[0].DataPtr = &ppkt->Buf[PROBE_RS232_TX_HDR_SIZE];
+        ppkt->SegTbl[0].DataLen = tx_len;
+        ppkt->SegNbr            = 1;
+#endif
 
-    ProbeRS232_TxBufInUse = DEF_TRUE;
-    tx_len                = ProbeCom_ParseRxPkt((void     *)ProbeRS232_RxBuf,
-                                                (void     *)ProbeRS232_TxBuf,
-                                                (CPU_INT16U)ProbeRS232_RxLen,
-                                                (CPU_INT16U)PROBE_RS232_TX_BUF_SIZE);
+        CPU_CRITICAL_ENTER();                                   /* Release rx buf.                                      */
+        ProbeRS232_RxPktRdIx++;
+        if (ProbeRS232_RxPktRdIx >= PROBE_RS232_PIPE_DEPTH) {
+            ProbeRS232_RxPktRdIx = 0;
+        }
+        ProbeRS232_RxPktNbr--;
+        CPU_CRITICAL_EXIT();
+    }
 
     return (tx_len);
 }
@@ -605,12 +808,25 @@ static  CPU_INT16U  ProbeRS232_ParseRxPkt (void)
 *
 * Caller(s)   : ProbeRS232_RxHandler().
 *
-* Note(s)     : none.
+* Note(s)     : (1) The RX buffers form a ring of PROBE_RS232_PIPE_DEPTH packets.  The packet just received
+*                   is queued for 'ProbeRS232_ParseRxPkt()' & reception continues in the next buffer; once
+*                   every buffer holds an unparsed packet, further packets are dropped until one is parsed.
 *********************************************************************************************************
 */
 
 static  void  ProbeRS232_RxPkt (void)
 {
+                                                                /* Queue rx'd pkt (see Note #1).                        */
+    ProbeRS232_RxBufLen[ProbeRS232_RxPktWrIx]   = ProbeRS232_RxLen;
+#if (PROBE_COM_SUPPORT_CRC16 == DEF_TRUE)
+    ProbeRS232_RxBufCRCEn[ProbeRS232_RxPktWrIx] = ProbeRS232_RxCRCEn;
+#endif
+    ProbeRS232_RxPktWrIx++;
+    if (ProbeRS232_RxPktWrIx >= PROBE_RS232_PIPE_DEPTH) {
+        ProbeRS232_RxPktWrIx = 0;
+    }
+    ProbeRS232_RxPktNbr++;
+
 #if (PROBE_RS232_PARSE_TASK == DEF_TRUE)
     ProbeRS232_OS_Post();                                       /* We have a whole packet, signal task to parse it.     */
 
@@ -620,18 +836,12 @@ static  void  ProbeRS232_RxPkt (void)
 
 
 
-#if (CPU_CFG_CRITICAL_METHOD == CPU_CRITICAL_METHOD_STATUS_LOCAL)
-    CPU_SR      cpu_sr = 0;
-#endif
     CPU_INT16U  len;
 
 
     len = ProbeRS232_ParseRxPkt();                              /* We have a whole packet, parse it.                    */
     if (len > 0) {
-        CPU_CRITICAL_ENTER();
-        ProbeRS232_TxLen = len;
-        ProbeRS232_TxStart();
-        CPU_CRITICAL_EXIT();
+        ProbeRS232_TxStart(len);
     }
 #endif
 }
@@ -656,7 +866,7 @@ static  void  ProbeRS232_RxPkt (void)
 static  void  ProbeRS232_RxStoINT8U (CPU_INT08U rx_data)
 {
     if (ProbeRS232_RxBufWrIx < PROBE_RS232_RX_BUF_SIZE) {
-        ProbeRS232_RxBuf[ProbeRS232_RxBufWrIx++] = rx_data;
+        ProbeRS232_RxBuf[ProbeRS232_RxPktWrIx][ProbeRS232_RxBufWrIx++] = rx_data;
     }
 }
 
@@ -687,21 +897,122 @@ static  void  ProbeRS232_RxBufClr (void)
 *********************************************************************************************************
 *                                          ProbeRS232_TxStart()
 *
-* Description : Cause transmission to begin.
+* Description : Frame the response & queue it for transmission.
 *
-* Argument(s) : none.
+* Argument(s) : len         Number of bytes in the data segment of the packet, which has already been
+*                           formed in the next free TX packet & described in its segment table.
 *
 * Return(s)   : none.
 *
 * Caller(s)   : ProbeRS232_Task(),
-*               ProbeRS232_RxPkt().
+*               ProbeRS232_RxPkt(),
+*               ProbeRS232_TxHandler(),
+*               ProbeRS232_StreamTx().
 *
-* Note(s)     : none.
+* Note(s)     : (1) The response always starts in the TX buffer, after room left for the header, & may
+*                   continue in further segments pointing at target memory (see 'ProbeCom_ParseRxPktSG()').
+*                   The header is joined to the first segment, & the footer, kept at the end of the TX
+*                   buffer, is added as the last segment:
+*
+*                       +-----+-----+-----+----------------+   +-------------+         +----+----+
+*                       | SDs | LEN | PAD |  Rsp (TX buf)  |   |  Rsp (mem)  |   ...   | CS | ED |
+*                       +-----+-----+-----+----------------+   +-------------+         +----+----+
+*                       |<------------ Seg 0 ------------->|   |<-- Seg 1 -->|         |<- Last->|
+*
+*                   The start delimiters & padding never change & are written once by 'ProbeRS232_Init()'.
+*
+*               (2) The checksum can only be precomputed if the whole response is in the TX buffer, so
+*                   scattered responses are not used when the checksum is enabled.
+*
+*               (3) With CRC-16 framing (see 'RS-232 PACKET FORMAT  Note #2'), the CRC is computed over the
+*                   whole packet here, before transmission starts, so the TX ISR only copies bytes.  The
+*                   response is then always wholly in the TX buffer (see 'ProbeRS232_ParseRxPkt()'
+*                   Note #2).
+*
+*               (4) The TX packets form a ring of PROBE_RS232_PIPE_DEPTH packets.  If no packet is being
+*                   transmitted, this one is started at once; otherwise it is started by
+*                   'ProbeRS232_TxHandler()' when those ahead of it have been sent.
 *********************************************************************************************************
 */
 
-static  void  ProbeRS232_TxStart (void)
+static  void  ProbeRS232_TxStart (CPU_INT16U len)
 {
+#if (CPU_CFG_CRITICAL_METHOD == CPU_CRITICAL_METHOD_STATUS_LOCAL)
+    CPU_SR               cpu_sr = 0;
+#endif
+    PROBE_RS232_TX_PKT  *ppkt;
+    CPU_INT08U          *ptx_ftr;
+    PROBE_COM_TX_SEG    *pseg;
+#if (PROBE_RS232_USE_CHECKSUM == DEF_TRUE)
+    CPU_INT08U           chk_sum;
+#endif
+#if (PROBE_COM_SUPPORT_CRC16  == DEF_TRUE)
+    CPU_INT16U           crc;
+    CPU_INT08U          *pdata;
+#endif
+#if ((PROBE_RS232_USE_CHECKSUM == DEF_TRUE) || \
+     (PROBE_COM_SUPPORT_CRC16  == DEF_TRUE))
+    CPU_INT16U           ix;
+#endif
+
+
+    ppkt           = &ProbeRS232_TxPktTbl[ProbeRS232_TxPktWrIx];
+    ppkt->Buf[4]   = len & 0xFF;                                /* See Note #1.                                         */
+    ppkt->Buf[5]   = len >> 8;
+
+    pseg           = &ppkt->SegTbl[0];                          /* Join hdr to first seg.                               */
+    pseg->DataPtr  = &ppkt->Buf[0];
+    pseg->DataLen += PROBE_RS232_TX_HDR_SIZE;
+
+    ptx_ftr        = &ppkt->Buf[PROBE_RS232_TX_HDR_SIZE + PROBE_RS232_TX_BUF_SIZE];
+    pseg           = &ppkt->SegTbl[ppkt->SegNbr];               /* Add ftr as last seg.                                 */
+    pseg->DataPtr  = ptx_ftr;
+    ppkt->SegNbr++;
+
+#if (PROBE_COM_SUPPORT_CRC16 == DEF_TRUE)
+    if (ProbeRS232_TxCRCEn == DEF_TRUE) {                       /* If rsp is framed with CRC-16 (see Note #3) ...       */
+        ppkt->Buf[6]   = PROBE_RS232_PAD_CRC16;
+        crc            = PROBE_RS232_CRC16_INIT;
+        pdata          = &ppkt->Buf[4];                         /*  ... CRC covers len, padding & data.                 */
+        for (ix = 0; ix < len + 4; ix++) {
+            crc        = PROBE_RS232_CRC16_UPD(crc, *pdata);
+            pdata++;
+        }
+        ptx_ftr[0]     = crc >> 8;
+        ptx_ftr[1]     = crc & 0xFF;
+        ptx_ftr[2]     = PROBE_RS232_PROTOCOL_TX_ED;
+        pseg->DataLen  = PROBE_RS232_TX_FTR_CRC16_SIZE;
+
+    } else {
+        ppkt->Buf[6]   = 0;
+#endif
+#if (PROBE_RS232_USE_CHECKSUM == DEF_TRUE)
+        chk_sum        = ppkt->Buf[4] + ppkt->Buf[5];           /* See Note #2.                                         */
+        for (ix = 0; ix < len; ix++) {
+            chk_sum   += ppkt->Buf[PROBE_RS232_TX_HDR_SIZE + ix];
+        }
+        ptx_ftr[0]     = chk_sum;
+#else
+        ptx_ftr[0]     = 0;
+#endif
+        ptx_ftr[1]     = PROBE_RS232_PROTOCOL_TX_ED;
+        pseg->DataLen  = PROBE_RS232_TX_FTR_SIZE;
+#if (PROBE_COM_SUPPORT_CRC16 == DEF_TRUE)
+    }
+#endif
+
+    ProbeRS232_TxPktWrIx++;                                     /* Pkt is now ready to be sent (see Note #4).           */
+    if (ProbeRS232_TxPktWrIx >= PROBE_RS232_PIPE_DEPTH) {
+        ProbeRS232_TxPktWrIx = 0;
+    }
+
+    CPU_CRITICAL_ENTER();
+    ProbeRS232_TxPktNbr++;
+    if (ProbeRS232_TxPktNbr == 1) {                             /* If no other pkt is queued ... start this one.        */
+        ProbeRS232_TxPktLoad();
+    }
+    CPU_CRITICAL_EXIT();
+
     if (ProbeRS232_TxActiveFlag == DEF_FALSE) {                 /* If no other transmission is in progress ...          */
         ProbeRS232_TxHandler();                                 /*  ... Handle transmit                    ...          */
         ProbeRS232_TxIntEn();                                   /*  ... Enable transmit interrupts.                     */
@@ -709,4 +1020,115 @@ static  void  ProbeRS232_TxStart (void)
 }
 
 
+/*
+*********************************************************************************************************
+*                                         ProbeRS232_TxPktLoad()
+*
+* Description : Start transmitting the oldest queued TX packet.
+*
+* Argument(s) : none.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : ProbeRS232_TxHandler(),
+*               ProbeRS232_TxStart().
+*
+* Note(s)     : (1) Called from the TX ISR or with interrupts disabled.
+*********************************************************************************************************
+*/
+
+static  void  ProbeRS232_TxPktLoad (void)
+{
+    PROBE_RS232_TX_PKT  *ppkt;
+
+
+    ppkt                   = &ProbeRS232_TxPktTbl[ProbeRS232_TxPktRdIx];
+    ProbeRS232_TxSegPtr    = &ppkt->SegTbl[0];
+    ProbeRS232_TxSegLeft   =  ppkt->SegNbr - 1;
+    ProbeRS232_TxPtr       = (CPU_INT08U *)ProbeRS232_TxSegPtr->DataPtr;
+    ProbeRS232_TxSegRemain =               ProbeRS232_TxSegPtr->DataLen;
+}
+
+
+/*
+*********************************************************************************************************
+*                                          ProbeRS232_StreamTx()
+*
+* Description : Transmit a snapshot of the streamed symbols if one is due.
+*
+* Argument(s) : none.
+*
+* Return(s)   : The number of milliseconds until the next snapshot is due, or 0 if the stream is stopped.
+*
+* Caller(s)   : ProbeRS232_Task().
+*
+* Note(s)     : (1) Snapshots are scheduled against an absolute due time, so the stream rate does not
+*                   drift with the time spent parsing & transmitting.  The first snapshot of a new
+*                   stream is due immediately.
+*
+*               (2) If every TX packet still holds a response or a previous snapshot, the snapshot is
+*                   retried 1 ms later.
+*
+*               (3) If a whole period has already passed by the time the snapshot is sent, the missed
+*                   periods are skipped rather than sent back to back, & the schedule restarts from now.
+*********************************************************************************************************
+*/
+
+#if (PROBE_COM_SUPPORT_STREAM == DEF_TRUE)
+static  CPU_INT16U  ProbeRS232_StreamTx (void)
+{
+    PROBE_RS232_TX_PKT  *ppkt;
+    CPU_INT16U           period;
+    CPU_INT16U           len;
+    CPU_INT32U           ts;
+    CPU_INT32S           remain;
+
+
+    period = ProbeCom_StreamPeriodGet();
+    if (period == 0) {                                          /* If stream stopped ... wait only for rx'd pkts.       */
+        ProbeRS232_StreamActive = DEF_FALSE;
+        return (0);
+    }
+
+    ts = ProbeRS232_OS_TimeGet();
+    if (ProbeRS232_StreamActive == DEF_FALSE) {                 /* See Note #1.                                         */
+        ProbeRS232_StreamActive = DEF_TRUE;
+        ProbeRS232_StreamNextTS = ts;
+    }
+
+    remain = (CPU_INT32S)(ProbeRS232_StreamNextTS - ts);
+    if (remain > 0) {                                           /* If snapshot not yet due ... rtn time until due.      */
+        return ((CPU_INT16U)remain);
+    }
+
+    if (ProbeRS232_TxPktNbr >= PROBE_RS232_PIPE_DEPTH) {        /* See Note #2.                                         */
+        return (1);
+    }
+
+    ppkt = &ProbeRS232_TxPktTbl[ProbeRS232_TxPktWrIx];
+    len  = ProbeCom_StreamSnapshot((void     *)&ppkt->Buf[PROBE_RS232_TX_HDR_SIZE],
+                                   (CPU_INT16U)PROBE_RS232_TX_BUF_SIZE,
+                                   (CPU_INT32U)ts);
+    if (len > 0) {
+        ppkt->SegTbl[0].DataPtr = &ppkt->Buf[PROBE_RS232_TX_HDR_SIZE];
+        ppkt->SegTbl[0].DataLen = len;
+        ppkt->SegNbr            = 1;
+        ProbeRS232_TxStart(len);
+    }
+
+    ProbeRS232_StreamNextTS += period;
+    remain                   = (CPU_INT32S)(ProbeRS232_StreamNextTS - ts);
+    if (remain <= 0) {                                          /* See Note #3.                                         */
+#if (PROBE_COM_STAT_EN == DEF_ENABLED)
+        ProbeRS232_StreamSkipCtr += (CPU_INT32U)(-remain) / period + 1;
+#endif
+        ProbeRS232_StreamNextTS   = ts + period;
+        remain                    = period;
+    }
+
+    return ((CPU_INT16U)remain);
+}
+#endif
+
+
 #endif
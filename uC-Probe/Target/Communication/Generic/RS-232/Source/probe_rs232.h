@@ -78,6 +78,15 @@
                                                                     /* ---------------- Byte counters --------------------- */
 PROBE_RS232_EXT  CPU_INT32U  ProbeRS232_RxCtr;                      /*  ... Number of bytes received                        */
 PROBE_RS232_EXT  CPU_INT32U  ProbeRS232_TxCtr;                      /*  ... Number of bytes transmitted                     */
+PROBE_RS232_EXT  CPU_INT32U  ProbeRS232_RxDropCtr;                  /*  ... Number of packets dropped, no free Rx buffer    */
+
+#if (PROBE_COM_SUPPORT_CRC16  == DEF_TRUE)
+PROBE_RS232_EXT  CPU_INT32U  ProbeRS232_RxCRCErrCtr;                /*  ... Number of packets dropped, bad CRC-16           */
+#endif
+
+#if (PROBE_COM_SUPPORT_STREAM == DEF_TRUE)
+PROBE_RS232_EXT  CPU_INT32U  ProbeRS232_StreamSkipCtr;              /*  ... Number of stream periods skipped                */
+#endif
 #endif
 
 
@@ -132,9 +141,14 @@ void  ProbeRS232_Tx1           (CPU_INT08U   c);                    /* Function
 */
 
 #if (PROBE_RS232_PARSE_TASK == DEF_TRUE)
-void  ProbeRS232_OS_Init       (void);
-void  ProbeRS232_OS_Pend       (void);
-void  ProbeRS232_OS_Post       (void);
+void         ProbeRS232_OS_Init    (void);
+CPU_BOOLEAN  ProbeRS232_OS_Pend    (CPU_INT16U   tmo);
+void         ProbeRS232_OS_Post    (void);
+void         ProbeRS232_OS_Dly     (CPU_INT16U   dly);
+#endif
+
+#if (PROBE_COM_SUPPORT_STREAM == DEF_TRUE)
+CPU_INT32U   ProbeRS232_OS_TimeGet (void);
 #endif
 
 
@@ -169,6 +183,14 @@ void  ProbeRS232_OS_Post       (void);
 
 
 
+#if      ((PROBE_COM_SUPPORT_STREAM == DEF_TRUE ) && \
+          (PROBE_RS232_PARSE_TASK   == DEF_FALSE))
+  #error  "PROBE_RS232_PARSE_TASK      illegally #define'd in 'probe_com_cfg.h'     "
+  #error  "                           [MUST be  DEF_TRUE   if streaming supported  ]"
+#endif
+
+
+
 #ifndef    PROBE_RS232_RX_BUF_SIZE
   #error  "PROBE_RS232_RX_BUF_SIZE           not #define'd in 'probe_com_cfg.h'     "
 #endif
@@ -180,6 +202,18 @@ void  ProbeRS232_OS_Post       (void);
 #endif
 
 
+
+#ifndef    PROBE_RS232_PIPE_DEPTH
+  #error  "PROBE_RS232_PIPE_DEPTH            not #define'd in 'probe_com_cfg.h'     "
+  #error  "                           [MUST be  >= 1 && <= 255                     ]"
+
+#elif    ((PROBE_RS232_PIPE_DEPTH <   1) || \
+          (PROBE_RS232_PIPE_DEPTH > 255))
+  #error  "PROBE_RS232_PIPE_DEPTH      illegally #define'd in 'probe_com_cfg.h'     "
+  #error  "                           [MUST be  >= 1 && <= 255                     ]"
+#endif
+
+
 #ifndef    PROBE_RS232_COMM_SEL
   #error  "PROBE_RS232_COMM_SEL              not #define'd in 'probe_com_cfg.h'     "
 #endif
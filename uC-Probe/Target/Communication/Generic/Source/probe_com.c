@@ -75,6 +75,18 @@
 *
 *               (E)  PROBE_COM_FMT_?X_STR_RD.  The RX request instructs the target to return a string
 *                    that the user has stored in the target's string buffer.
+*
+*               (F)  PROBE_COM_FMT_?X_STREAM_CFG.  The RX request gives the target a stream period & a set
+*                    of {memory address, data length} pairs to sample at that period (or stops the stream).
+*
+*               (G)  PROBE_COM_FMT_TX_STREAM_DATA.  The target sends a snapshot of the streamed symbols
+*                    without being asked; there is no matching RX request.
+*
+*               (H)  PROBE_COM_FMT_?X_MULTIPLE_RD_DELTA.  As PROBE_COM_FMT_?X_MULTIPLE_RD, but the target
+*                    sends only the items that changed since its last response to the same request.
+*
+*               (I)  PROBE_COM_FMT_?X_SYM_LOOKUP.  The RX request gives a set of symbol name hashes; the
+*                    target returns the address, size & type of each symbol from its symbol directory.
 **********************************************************************************************************
 */
 
@@ -110,6 +122,19 @@
 #define  PROBE_COM_FMT_RX_TELEMETRY_GET               0x000B
 #define  PROBE_COM_FMT_TX_TELEMETRY_GET               0x800B
 
+#define  PROBE_COM_FMT_RX_STREAM_CFG                  0x000C
+#define  PROBE_COM_FMT_TX_STREAM_CFG                  0x800C
+
+#define  PROBE_COM_FMT_TX_STREAM_DATA                 0x800D
+
+#define  PROBE_COM_FMT_RX_MULTIPLE_RD_DELTA           0x000E
+#define  PROBE_COM_FMT_TX_MULTIPLE_RD_DELTA           0x800E
+
+#define  PROBE_COM_FMT_CRC16                          0x000F    /* Not a request (see 'QUERIES  Note #2').              */
+
+#define  PROBE_COM_FMT_RX_SYM_LOOKUP                  0x0010
+#define  PROBE_COM_FMT_TX_SYM_LOOKUP                  0x8010
+
 /*
 *********************************************************************************************************
 *                                             STATUS CONSTANTS
@@ -133,6 +158,9 @@
 *               (F)  PROBE_COM_STATUS_RX_PKT_WRONG_SIZE.  The request packet is not the expected size.
 *
 *               (G)  PROBE_COM_STATUS_FAIL.  Another error occurred.
+*
+*               (H)  PROBE_COM_STATUS_ADDR_FORBIDDEN.  The request would read or write memory that the
+*                    region tbl does not allow (see 'MEMORY REGIONS').
 **********************************************************************************************************
 */
 
@@ -140,6 +168,7 @@
 #define  PROBE_COM_STATUS_TELEMETRY_NONE                0xF7
 #define  PROBE_COM_STATUS_STR_NONE                      0xF8
 #define  PROBE_COM_STATUS_UNKNOWN_REQUEST               0xF9
+#define  PROBE_COM_STATUS_ADDR_FORBIDDEN                0xFA
 #define  PROBE_COM_STATUS_QUERY_NOT_SUPPORTED           0xFC
 #define  PROBE_COM_STATUS_TX_PKT_TOO_LARGE              0xFD
 #define  PROBE_COM_STATUS_RX_PKT_WRONG_SIZE             0xFE
@@ -165,6 +194,11 @@
 *                    target can respond to.
 *
 *               (E)  PROBE_COM_QUERY_VERSION.  The target responds with the communication module version.
+*
+*           (2) If PROBE_COM_SUPPORT_CRC16 is DEF_TRUE, the PROBE_COM_QUERY_FMT_SUPPORT response also lists
+*               PROBE_COM_FMT_CRC16, telling the host that packets may be framed with a CRC-16 (see
+*               'probe_rs232.c  RS-232 PACKET FORMAT  Note #2').  This is not a request format; a packet
+*               of this format is answered with PROBE_COM_STATUS_UNKNOWN_REQUEST.
 **********************************************************************************************************
 */
 
@@ -191,6 +225,24 @@
 
 #define  PROBE_COM_INFO_PKT_SIZE                      0x0001
 
+/*
+*********************************************************************************************************
+*                                           DELTA READ OPTIONS
+*
+* Note(s):  (1) The following options may be set in a PROBE_COM_FMT_RX_MULTIPLE_RD_DELTA request :
+*
+*               (A)  PROBE_COM_DELTA_OPT_KEY.  The host asks for a keyframe, e.g., after losing a response.
+*
+*           (2) The following flags are returned in a PROBE_COM_FMT_TX_MULTIPLE_RD_DELTA response :
+*
+*               (A)  PROBE_COM_DELTA_FLAG_KEY.  The response is a keyframe; every item is included.
+**********************************************************************************************************
+*/
+
+#define  PROBE_COM_DELTA_OPT_KEY                      0x0001
+
+#define  PROBE_COM_DELTA_FLAG_KEY                       0x01
+
 /*
 *********************************************************************************************************
 *                                               MODIFIERS
@@ -220,6 +272,74 @@
 #define  PROBE_COM_SIZE_RX_HDR                             2
 #define  PROBE_COM_SIZE_TX_HDR                             4
 
+/*
+*********************************************************************************************************
+*                                            TELEMETRY POOL
+*
+* Note(s):  (1) Telemetry buffers are filled by producers, which may be any task or ISR, between
+*               ProbeCom_TelemetryReserve() & ProbeCom_TelemetryCommit().  They are drained by the
+*               consumer, ProbeCom_CmdTelemetryGet(), which runs in the single context that parses packets.
+*
+*           (2) Apart from while it is reserved, each buffer is on exactly one of these lists, linked by
+*               index through 'NextIx':
+*
+*               (a) The free stack, ProbeCom_TelemetryFreeHead.  Producers pop buffers off it & the
+*                   consumer pushes them back.  The low 16 bits of the head are the index of the top
+*                   buffer & the high 16 bits a tag which every push & pop increments, so a pop which
+*                   read a stale top always fails its compare-and-swap (the "ABA" problem).
+*
+*               (b) The ready stack, ProbeCom_TelemetryRdyHead, newest buffer first.  Producers push
+*                   committed buffers onto it; the consumer only ever takes the whole stack, so no tag is
+*                   needed.
+*
+*               (c) The transmit list, ProbeCom_TelemetryTxIx, oldest buffer first, which only the
+*                   consumer accesses.  When it runs empty the ready stack is taken & reversed onto it, so
+*                   buffers are transmitted in the order they were committed.
+*
+*           (3) Words shared with producers are only accessed through PROBE_COM_ATOMIC_LD(), _ST() &
+*               _CAS().  By default, each is a single load, store or compare-&-store inside a critical
+*               section, so interrupts are disabled for a few instructions no matter how much data is
+*               published, & never while data is copied.  A port whose CPU has atomic instructions, or a
+*               host build, may #define all three in 'probe_com_cfg.h'.
+**********************************************************************************************************
+*/
+
+#define  PROBE_COM_TELEMETRY_IX_NONE                  0xFFFF    /* Index terminating a list.                            */
+#define  PROBE_COM_TELEMETRY_IX_MASK             0x0000FFFFL    /* Index of top of free stack.                          */
+#define  PROBE_COM_TELEMETRY_TAG_INC             0x00010000L    /* Tag increment of free stack (see Note #2a).          */
+
+#if (PROBE_COM_SUPPORT_TELEMETRY == DEF_TRUE)
+#ifndef  PROBE_COM_ATOMIC_CAS                                   /* See Note #3.                                         */
+#define  PROBE_COM_ATOMIC_LD(pvar)                  ProbeCom_AtomicLd((pvar))
+#define  PROBE_COM_ATOMIC_ST(pvar, val)             ProbeCom_AtomicSt((pvar), (val))
+#define  PROBE_COM_ATOMIC_CAS(pvar, val_old, val_new)  ProbeCom_AtomicCAS((pvar), (val_old), (val_new))
+#define  PROBE_COM_ATOMIC_DFLT                     DEF_TRUE
+#else
+#define  PROBE_COM_ATOMIC_DFLT                    DEF_FALSE
+#endif
+#endif
+
+/*
+*********************************************************************************************************
+*                                            MEMORY REGIONS
+*
+* Note(s):  (1) If PROBE_COM_SUPPORT_REGION is DEF_TRUE, the memory named by every read, write & stream
+*               request is looked up in the region tbl (see 'probe_com.h  MEMORY REGIONS').  Unless each
+*               item lies wholly within one region which grants the access, the request is answered with
+*               PROBE_COM_STATUS_ADDR_FORBIDDEN.
+*
+*           (2) Addresses are then always taken as 32-bit, even on CPUs with 16-bit addresses, so a
+*               request may name paged memory.  On the HCS12, for example, 0x3C8000 is offset 0x8000
+*               of flash page 0x3C (as in the linker's PRM & MAP files).
+*
+*           (3) Paged memory is copied through ProbeCom_PagedRd(), so a scattered response never sends
+*               it straight from memory; the page might be switched before the segment is transmitted.
+*
+*           (4) Most requests read several items from the same region, so the region last found is
+*               checked before the tbl is binary searched.
+**********************************************************************************************************
+*/
+
 /*
 *********************************************************************************************************
 *                                           LOCAL CONSTANTS
@@ -233,6 +353,22 @@
 *********************************************************************************************************
 */
 
+#if (PROBE_COM_SUPPORT_REGION == DEF_TRUE)
+typedef  CPU_INT32U  PROBE_COM_ADDR;                            /* Addr in request (see 'MEMORY REGIONS  Note #2').     */
+#else
+typedef  CPU_ADDR    PROBE_COM_ADDR;
+#endif
+
+#if (PROBE_COM_SUPPORT_STREAM == DEF_TRUE)
+typedef  struct  probe_com_stream_sym {
+    PROBE_COM_ADDR  Addr;                                       /* Start addr of sym.                                   */
+    CPU_INT08U      Len;                                        /* Nbr of bytes in sym.                                 */
+#if (PROBE_COM_SUPPORT_REGION == DEF_TRUE)
+    CPU_INT08U      Access;                                     /* Access flags of region holding sym.                  */
+#endif
+} PROBE_COM_STREAM_SYM;
+#endif
+
 
 /*
 *********************************************************************************************************
@@ -256,10 +392,36 @@ static  PROBE_COM_STR_HDNLR_FNCT    ProbeCom_StrHndlr;
 
 #if (PROBE_COM_SUPPORT_TELEMETRY == DEF_TRUE)
 static  PROBE_COM_TELEMETRY_BUF     ProbeCom_TelemetryBufTbl[PROBE_COM_TELEMETRY_NBR];
-static  PROBE_COM_TELEMETRY_BUF    *ProbeCom_TelemetryFreePoolPtr;
-static  PROBE_COM_TELEMETRY_BUF    *ProbeCom_TelemetryRdyPoolPtr;
-static  CPU_INT16U                  ProbeCom_TelemetryBufNbrFree;
-static  CPU_INT16U                  ProbeCom_TelemetryBufNbrRdy;
+static  CPU_INT32U                  ProbeCom_TelemetryFreeHead; /* Tag & ix of top of free stack.                       */
+static  CPU_INT32U                  ProbeCom_TelemetryRdyHead;  /* Ix of newest committed buf.                          */
+static  CPU_INT32U                  ProbeCom_TelemetryTxIx;     /* Ix of oldest committed buf (consumer only).          */
+#endif
+
+#if (PROBE_COM_SUPPORT_STREAM == DEF_TRUE)
+static  PROBE_COM_STREAM_SYM        ProbeCom_StreamSymTbl[PROBE_COM_STREAM_SYM_NBR];
+static  CPU_INT08U                  ProbeCom_StreamSymNbr;      /* Nbr of syms in stream set.                           */
+static  CPU_INT16U                  ProbeCom_StreamLen;         /* Nbr of sym bytes in each snapshot.                   */
+static  CPU_INT16U                  ProbeCom_StreamPeriod;      /* Snapshot period, in ms (0 = stream stopped).         */
+static  CPU_INT16U                  ProbeCom_StreamSeq;         /* Seq nbr of next snapshot.                            */
+#endif
+
+#if (PROBE_COM_SUPPORT_DELTA == DEF_TRUE)
+                                                                /* Item descriptors of last delta rd.                   */
+static  CPU_INT08U                  ProbeCom_DeltaDesc[PROBE_COM_RX_MAX_SIZE];
+static  CPU_INT16U                  ProbeCom_DeltaDescLen;
+                                                                /* Item data as last tx'd.                              */
+static  CPU_INT08U                  ProbeCom_DeltaShadow[PROBE_COM_TX_MAX_SIZE];
+static  CPU_INT16U                  ProbeCom_DeltaKeyCtr;       /* Nbr of delta rsp's until next keyframe.              */
+#endif
+
+#if (PROBE_COM_SUPPORT_SG == DEF_TRUE)
+static  PROBE_COM_TX_SEG           *ProbeCom_SegTblPtr;         /* Seg tbl of rsp being formed (NULL = no scatter).     */
+static  CPU_INT08U                  ProbeCom_SegNbrMax;         /* Nbr of entries in seg tbl.                           */
+static  CPU_INT08U                  ProbeCom_SegNbr;            /* Nbr of segs used.                                    */
+#endif
+
+#if (PROBE_COM_SUPPORT_REGION == DEF_TRUE)
+static  const  PROBE_COM_REGION    *ProbeCom_RegionLastPtr;     /* Region last found (see 'MEMORY REGIONS  Note #4').   */
 #endif
 
 static  CPU_INT32U                  ProbeCom_EndiannessTest;
@@ -299,6 +461,20 @@ static  CPU_INT16U   ProbeCom_CmdMultipleRd  (CPU_INT08U   *prx_buf,
                                               CPU_INT16U    rx_pkt_size,
                                               CPU_INT16U    tx_buf_size);
 
+#if (PROBE_COM_SUPPORT_DELTA == DEF_TRUE)
+static  CPU_INT16U   ProbeCom_CmdMultipleRdDelta(CPU_INT08U   *prx_buf,
+                                                 CPU_INT08U   *ptx_buf,
+                                                 CPU_INT16U    rx_pkt_size,
+                                                 CPU_INT16U    tx_buf_size);
+#endif
+
+#if (PROBE_COM_SUPPORT_SG == DEF_TRUE)
+static  CPU_INT16U   ProbeCom_CmdMultipleRdSG(CPU_INT08U   *prx_buf,
+                                              CPU_INT08U   *ptx_buf,
+                                              CPU_INT16U    rx_pkt_size,
+                                              CPU_INT32U    tx_len);
+#endif
+
 #if (PROBE_COM_SUPPORT_WR == DEF_TRUE)
 static  CPU_INT16U   ProbeCom_CmdSimpleWr    (CPU_INT08U   *prx_buf,
                                               CPU_INT08U   *ptx_buf,
@@ -330,6 +506,20 @@ static  CPU_INT16U   ProbeCom_CmdTelemetryGet(CPU_INT08U   *prx_buf,
                                               CPU_INT16U    tx_buf_size);
 #endif
 
+#if (PROBE_COM_SUPPORT_STREAM == DEF_TRUE)
+static  CPU_INT16U   ProbeCom_CmdStreamCfg   (CPU_INT08U   *prx_buf,
+                                              CPU_INT08U   *ptx_buf,
+                                              CPU_INT16U    rx_pkt_size,
+                                              CPU_INT16U    tx_buf_size);
+#endif
+
+#if (PROBE_COM_SUPPORT_SYM == DEF_TRUE)
+static  CPU_INT16U   ProbeCom_CmdSymLookup   (CPU_INT08U   *prx_buf,
+                                              CPU_INT08U   *ptx_buf,
+                                              CPU_INT16U    rx_pkt_size,
+                                              CPU_INT16U    tx_buf_size);
+#endif
+
 
                                                                 /* ------------------- RD FROM RX PKT ----------------- */
 static  CPU_INT08U   ProbeCom_GetINT8U       (CPU_INT08U  **pbuf);
@@ -345,11 +535,18 @@ static  void         ProbeCom_StoINT8U       (CPU_INT08U  **pbuf,
 static  void         ProbeCom_StoINT16U      (CPU_INT08U  **pbuf,
                                               CPU_INT16U    data);
 
-#if (PROBE_COM_SUPPORT_TELEMETRY == DEF_TRUE)
+#if ((PROBE_COM_SUPPORT_TELEMETRY == DEF_TRUE) || \
+     (PROBE_COM_SUPPORT_STREAM    == DEF_TRUE) || \
+     (PROBE_COM_SUPPORT_SYM       == DEF_TRUE))
 static  void         ProbeCom_StoINT32U      (CPU_INT08U  **pbuf,
                                               CPU_INT32U    data);
 #endif
 
+#if (PROBE_COM_SUPPORT_SG == DEF_TRUE)
+static  CPU_BOOLEAN  ProbeCom_SegAdd         (void         *pdata,
+                                              CPU_INT16U    len);
+#endif
+
                                                                 /* -------------- DETERMINE PKT MODIFIER -------------- */
 #if (PROBE_COM_SUPPORT_STR == DEF_TRUE)
 static  CPU_BOOLEAN  ProbeCom_StrRdy         (void);
@@ -358,6 +555,34 @@ static  CPU_BOOLEAN  ProbeCom_StrRdy         (void);
 #if (PROBE_COM_SUPPORT_TELEMETRY == DEF_TRUE)
 static  CPU_BOOLEAN  ProbeCom_TelemetryRdy   (void);
 static  void         ProbeCom_TelemetryInit  (void);
+
+static  PROBE_COM_TELEMETRY_BUF  *ProbeCom_TelemetryTxBufGet(void);
+static  void         ProbeCom_TelemetryTxBufFree(void);
+
+#if (PROBE_COM_ATOMIC_DFLT == DEF_TRUE)
+static  CPU_INT32U   ProbeCom_AtomicLd       (CPU_INT32U   *pvar);
+
+static  void         ProbeCom_AtomicSt       (CPU_INT32U   *pvar,
+                                              CPU_INT32U    val);
+
+static  CPU_BOOLEAN  ProbeCom_AtomicCAS      (CPU_INT32U   *pvar,
+                                              CPU_INT32U    val_old,
+                                              CPU_INT32U    val_new);
+#endif
+#endif
+
+#if (PROBE_COM_SUPPORT_SYM == DEF_TRUE)
+static  const  PROBE_COM_SYM  *ProbeCom_SymFind(CPU_INT32U    name_hash);
+#endif
+
+#if (PROBE_COM_SUPPORT_REGION == DEF_TRUE)
+static  CPU_INT08U   ProbeCom_RegionAccess   (CPU_INT32U    addr,
+                                              CPU_INT16U    nbytes);
+
+static  void         ProbeCom_MemRd          (void         *pdest,
+                                              CPU_INT32U    addr,
+                                              CPU_INT16U    nbytes,
+                                              CPU_INT08U    access);
 #endif
 
 
@@ -405,6 +630,28 @@ void  ProbeCom_Init (void)
     ProbeCom_TelemetryInit();
 #endif
 
+#if (PROBE_COM_SUPPORT_STREAM == DEF_TRUE)
+    ProbeCom_StreamSymNbr = 0;
+    ProbeCom_StreamLen    = 0;
+    ProbeCom_StreamPeriod = 0;
+    ProbeCom_StreamSeq    = 0;
+#endif
+
+#if (PROBE_COM_SUPPORT_DELTA == DEF_TRUE)
+    ProbeCom_DeltaDescLen = 0;
+    ProbeCom_DeltaKeyCtr  = 0;
+#endif
+
+#if (PROBE_COM_SUPPORT_SG == DEF_TRUE)
+    ProbeCom_SegTblPtr    = (PROBE_COM_TX_SEG *)0;
+    ProbeCom_SegNbrMax    = 0;
+    ProbeCom_SegNbr       = 0;
+#endif
+
+#if (PROBE_COM_SUPPORT_REGION == DEF_TRUE)
+    ProbeCom_RegionLastPtr = (const PROBE_COM_REGION *)0;
+#endif
+
 #if (PROBE_COM_STAT_EN == DEF_ENABLED)
     ProbeCom_RxPktCtr     = 0;
     ProbeCom_TxPktCtr     = 0;
@@ -420,6 +667,14 @@ void  ProbeCom_Init (void)
     ProbeCom_RxSymCtr     = 0;
     ProbeCom_RxSymByteCtr = 0;
 #endif
+
+#if (PROBE_COM_SUPPORT_TELEMETRY == DEF_TRUE)
+    ProbeCom_TelemetryDropCtr = 0;
+#endif
+
+#if (PROBE_COM_SUPPORT_STREAM == DEF_TRUE)
+    ProbeCom_TxStreamCtr  = 0;
+#endif
 #endif
 
     ProbeCom_EndiannessTest = 0x12345678L;
@@ -496,6 +751,12 @@ CPU_INT16U  ProbeCom_ParseRxPkt (void        *prx_pkt,
              tx_buf_wr = ProbeCom_CmdMultipleRd(  prx_pkt_08, ptx_pkt_08,  rx_pkt_size, tx_buf_size);
              break;
 
+#if (PROBE_COM_SUPPORT_DELTA == DEF_TRUE)
+        case PROBE_COM_FMT_RX_MULTIPLE_RD_DELTA:
+             tx_buf_wr = ProbeCom_CmdMultipleRdDelta(prx_pkt_08, ptx_pkt_08, rx_pkt_size, tx_buf_size);
+             break;
+#endif
+
 #if (PROBE_COM_SUPPORT_WR == DEF_TRUE)
         case PROBE_COM_FMT_RX_SIMPLE_WR:
              tx_buf_wr = ProbeCom_CmdSimpleWr(    prx_pkt_08, ptx_pkt_08, rx_pkt_size, tx_buf_size);
@@ -522,6 +783,18 @@ CPU_INT16U  ProbeCom_ParseRxPkt (void        *prx_pkt,
              break;
 #endif
 
+#if (PROBE_COM_SUPPORT_STREAM == DEF_TRUE)
+        case PROBE_COM_FMT_RX_STREAM_CFG:
+             tx_buf_wr = ProbeCom_CmdStreamCfg(   prx_pkt_08, ptx_pkt_08,  rx_pkt_size, tx_buf_size);
+             break;
+#endif
+
+#if (PROBE_COM_SUPPORT_SYM == DEF_TRUE)
+        case PROBE_COM_FMT_RX_SYM_LOOKUP:
+             tx_buf_wr = ProbeCom_CmdSymLookup(   prx_pkt_08, ptx_pkt_08,  rx_pkt_size, tx_buf_size);
+             break;
+#endif
+
         default:
              tx_buf_wr = ProbeCom_CmdErr  (                   ptx_pkt_08,  PROBE_COM_STATUS_UNKNOWN_REQUEST);
              break;
@@ -531,6 +804,83 @@ CPU_INT16U  ProbeCom_ParseRxPkt (void        *prx_pkt,
 }
 
 
+/*
+*********************************************************************************************************
+*                                        ProbeCom_ParseRxPktSG()
+*
+* Description : Parse a packet & formulate a response which may be scattered across several segments.
+*
+* Argument(s) : prx_pkt         Pointer to the receive  packet buffer
+*
+*               ptx_pkt         Pointer to the transmit packet buffer
+*
+*               rx_pkt_size     Size of the received packet
+*
+*               tx_buf_size     Size of the transmit packet buffer
+*
+*               pseg_tbl        Pointer to the table that will receive the response segments
+*
+*               seg_nbr_max     Number of entries in the segment table (must be at least 1)
+*
+*               pseg_nbr        Pointer to the variable that will receive the number of segments used
+*
+* Return(s)   : The number of bytes in the data segment of the packet to transmit in response, i.e.,
+*               the total length of all the segments.
+*
+* Caller(s)   : Tasks/receive handlers in communications-specific drivers which can transmit a response
+*               from several buffers, e.g., probe_rs232.
+*
+* Note(s)     : (1) The response is transmitted by sending each segment in turn.  The first segment
+*                   always starts at 'ptx_pkt'.  A read that will not fit in the transmit packet buffer
+*                   is not copied; the data is described by further segments pointing at the target
+*                   memory, so only 'tx_buf_size' bytes of RAM are needed however large the read.
+*
+*               (2) The memory referenced by the segments is read as the segments are transmitted, not
+*                   while this function executes.
+*
+*               (3) Responses are formed one at a time; this function must not be called by two tasks
+*                   at once.
+*
+*               (4) If 'seg_nbr_max' is 1, the response is never scattered; it is formed in the transmit
+*                   packet buffer exactly as by 'ProbeCom_ParseRxPkt()'.
+*********************************************************************************************************
+*/
+
+#if (PROBE_COM_SUPPORT_SG == DEF_TRUE)
+CPU_INT16U  ProbeCom_ParseRxPktSG (void              *prx_pkt,
+                                   void              *ptx_pkt,
+                                   CPU_INT16U         rx_pkt_size,
+                                   CPU_INT16U         tx_buf_size,
+                                   PROBE_COM_TX_SEG  *pseg_tbl,
+                                   CPU_INT08U         seg_nbr_max,
+                                   CPU_INT08U        *pseg_nbr)
+{
+    CPU_INT16U  tx_len;
+
+
+    if (seg_nbr_max >= 2) {                                     /* Scatter only if a seg may follow the TX buf ...      */
+        ProbeCom_SegTblPtr = pseg_tbl;                          /*  ... (see Note #4).                                  */
+        ProbeCom_SegNbrMax = seg_nbr_max;
+    }
+    ProbeCom_SegNbr    = 0;
+
+    tx_len             = ProbeCom_ParseRxPkt(prx_pkt, ptx_pkt, rx_pkt_size, tx_buf_size);
+
+    if (ProbeCom_SegNbr == 0) {                                 /* If rsp was formed in TX buf ... rtn as one seg.      */
+        pseg_tbl[0].DataPtr = ptx_pkt;
+        pseg_tbl[0].DataLen = tx_len;
+        ProbeCom_SegNbr     = 1;
+    }
+
+   *pseg_nbr           = ProbeCom_SegNbr;
+    ProbeCom_SegTblPtr = (PROBE_COM_TX_SEG *)0;
+    ProbeCom_SegNbr    = 0;
+
+    return (tx_len);
+}
+#endif
+
+
 /*
 *********************************************************************************************************
 *                                         ProbeCom_InfoHndlrSet()
@@ -747,15 +1097,12 @@ CPU_BOOLEAN  ProbeCom_TxStr (CPU_CHAR    *pstr,
 *                       for OS task data, then the local ID may specified the task number, priority or
 *                       ID (employed by the OS).
 *
-*               (2) CPU_CRITICAL_ENTER() & CPU_CRITICAL_EXIT() REQUIRED to prevent pool access from multiple
-*                   tasks/contexts.  The task/context which adds telemetry data to the queue is one of
-*                   these; the task/ISR which actually transmits that data is another.  If the latter is
-*                   a task (NOT an ISR), then these COULD be replaced by a semaphore lock.
+*               (2) The data is copied into a buffer reserved from the telemetry pool, outside any
+*                   critical section (see 'TELEMETRY POOL  Note #3').  A producer which builds its data
+*                   in place should call ProbeCom_TelemetryReserve() & ProbeCom_TelemetryCommit() instead.
 *
-*               (3) New buffers are unlinked from the FRONT of the free pool before being filled with
-*                   telemetry data.  Full buffers are linked to the BACK of the ready pool after being
-*                   filled with telemetry data.  Buffers may be linked to the front of the ready pool
-*                   upon partial transmission of a large buffer; see 'ProbeCom_CmdTelemetryGet()' Note #4.
+*               (3) If 'nbr_octets' exceeds PROBE_COM_TELEMETRY_BUF_LEN, the data is not queued.  If no
+*                   buffer is free, the data is dropped & ProbeCom_TelemetryDropCtr is incremented.
 *********************************************************************************************************
 */
 
@@ -766,42 +1113,22 @@ CPU_BOOLEAN  ProbeCom_TxTelemetry (CPU_INT32U   id,
                                    CPU_INT32U   timestamp)
 {
     PROBE_COM_TELEMETRY_BUF  *pbuf;
-#if (CPU_CFG_CRITICAL_METHOD == CPU_CRITICAL_METHOD_STATUS_LOCAL)
-    CPU_SR                    cpu_sr;
-#endif
 
 
-    CPU_CRITICAL_ENTER();
-    pbuf = ProbeCom_TelemetryFreePoolPtr;
-    if (pbuf == (PROBE_COM_TELEMETRY_BUF *)0) {
-        CPU_CRITICAL_EXIT();
+    if (nbr_octets > PROBE_COM_TELEMETRY_BUF_LEN) {             /* See Note #3.                                         */
         return (DEF_FALSE);
     }
-    ProbeCom_TelemetryFreePoolPtr = (PROBE_COM_TELEMETRY_BUF *)pbuf->NextBufPtr;
-    ProbeCom_TelemetryBufNbrFree--;
-    CPU_CRITICAL_EXIT();
 
-    pbuf->ID        = id;
-    pbuf->Timestamp = timestamp;
-    pbuf->BufLen    = nbr_octets;
-    pbuf->BufIx     = 0;
+    pbuf = ProbeCom_TelemetryReserve();
+    if (pbuf == (PROBE_COM_TELEMETRY_BUF *)0) {
+        return (DEF_FALSE);
+    }
 
-    Mem_Copy((void     *)pbuf->Buf,
-             (void     *)pdata,
-             (CPU_SIZE_T)nbr_octets);
+    Mem_Copy((void     *)&pbuf->Buf[0],
+             (void     *) pdata,
+             (CPU_SIZE_T) nbr_octets);
 
-    CPU_CRITICAL_ENTER();
-    if (ProbeCom_TelemetryRdyPoolPtr == (PROBE_COM_TELEMETRY_BUF *)0) {
-        pbuf->PrevBufPtr               = (void *)0;
-        pbuf->NextBufPtr               = (void *)0;
-        ProbeCom_TelemetryRdyPoolPtr = pbuf;
-    } else {
-        pbuf->PrevBufPtr                         = (void *)ProbeCom_TelemetryRdyPoolPtr;
-        pbuf->NextBufPtr                         = (void *)0;
-        ProbeCom_TelemetryRdyPoolPtr->NextBufPtr = pbuf;
-    }
-    ProbeCom_TelemetryBufNbrRdy++;
-    CPU_CRITICAL_EXIT();
+    ProbeCom_TelemetryCommit(pbuf, id, nbr_octets, timestamp);
 
     return (DEF_TRUE);
 }
@@ -810,148 +1137,771 @@ CPU_BOOLEAN  ProbeCom_TxTelemetry (CPU_INT32U   id,
 
 /*
 *********************************************************************************************************
-*********************************************************************************************************
-**                                  STATIC STRING-HANDLING FUNCTIONS
-*********************************************************************************************************
-*********************************************************************************************************
-*/
-
-/*
-*********************************************************************************************************
-*                                            ProbeCom_StrRdy()
+*                                      ProbeCom_TelemetryReserve()
 *
-* Description : Check if a string is ready for transmission.
+* Description : Reserve a telemetry buffer, which the caller fills in place.
 *
 * Argument(s) : none.
 *
-* Return(s)   : DEF_TRUE   if a  string is in the buffer for transmission.
-*               DEF_FALSE  if no string is in the buffer for transmission.
+* Return(s)   : Pointer to the buffer, whose 'Buf' may hold up to PROBE_COM_TELEMETRY_BUF_LEN octets, or
+*               a NULL pointer if the pool is empty.
 *
-* Caller(s)   : ProbeCom_PktModifier().
+* Caller(s)   : Application,
+*               ProbeCom_TxTelemetry().
 *
-* Note(s)     : (1) See Notes for 'ProbeCom_TxStr()'.
+* Note(s)     : (1) This function may be called from any task or ISR, & does not disable interrupts except
+*                   within PROBE_COM_ATOMIC_LD() & _CAS() (see 'TELEMETRY POOL  Note #3').
+*
+*               (2) A reserved buffer MUST be passed to ProbeCom_TelemetryCommit().
+*
+*               (3) A buffer is popped off the free stack (see 'TELEMETRY POOL  Note #2a').  If the pool
+*                   is empty, ProbeCom_TelemetryDropCtr is incremented.
 *********************************************************************************************************
 */
 
-#if (PROBE_COM_SUPPORT_STR == DEF_TRUE)
-static  CPU_BOOLEAN  ProbeCom_StrRdy (void)
+#if (PROBE_COM_SUPPORT_TELEMETRY == DEF_TRUE)
+PROBE_COM_TELEMETRY_BUF  *ProbeCom_TelemetryReserve (void)
 {
-    CPU_BOOLEAN  rdy;
-    CPU_INT16U   wr_ix;
-    CPU_INT16U   rd_ix;
-
+    CPU_INT32U   head;
+    CPU_INT32U   head_new;
+    CPU_INT32U   ix;
+    CPU_INT32U   ix_next;
+    CPU_BOOLEAN  ok;
+#if (PROBE_COM_STAT_EN == DEF_ENABLED)
+    CPU_INT32U   ctr;
+#endif
 
-    wr_ix = ProbeCom_StrBufWrIx;
-    rd_ix = ProbeCom_StrBufRdIx;
 
-    if (wr_ix == rd_ix) {
-        rdy = DEF_FALSE;
-    } else {
-        rdy = DEF_TRUE;
-    }
+    do {                                                        /* Pop buf off free stack (see Note #3).                */
+        head = PROBE_COM_ATOMIC_LD(&ProbeCom_TelemetryFreeHead);
+        ix   = head & PROBE_COM_TELEMETRY_IX_MASK;
+        if (ix == PROBE_COM_TELEMETRY_IX_NONE) {                /* Pool empty ... drop.                                 */
+#if (PROBE_COM_STAT_EN == DEF_ENABLED)
+            do {
+                ctr = PROBE_COM_ATOMIC_LD(&ProbeCom_TelemetryDropCtr);
+                ok  = PROBE_COM_ATOMIC_CAS(&ProbeCom_TelemetryDropCtr, ctr, ctr + 1);
+            } while (ok == DEF_NO);
+#endif
+            return ((PROBE_COM_TELEMETRY_BUF *)0);
+        }
+        ix_next  = PROBE_COM_ATOMIC_LD(&ProbeCom_TelemetryBufTbl[ix].NextIx);
+        head_new = ((head & ~PROBE_COM_TELEMETRY_IX_MASK) + PROBE_COM_TELEMETRY_TAG_INC) | ix_next;
+        ok       = PROBE_COM_ATOMIC_CAS(&ProbeCom_TelemetryFreeHead, head, head_new);
+    } while (ok == DEF_NO);
 
-    return (rdy);
+    return (&ProbeCom_TelemetryBufTbl[ix]);
 }
 #endif
 
 
 /*
 *********************************************************************************************************
-*                                         ProbeCom_TelemetryRdy()
+*                                      ProbeCom_TelemetryCommit()
 *
-* Description : Check if telemetry data is ready for transmission.
+* Description : Queue a filled telemetry buffer for transmission.
 *
-* Argument(s) : none.
+* Argument(s) : pbuf        Pointer to the buffer, as returned by ProbeCom_TelemetryReserve().
 *
-* Return(s)   : DEF_TRUE   if    telemetry data is queued for transmission.
-*               DEF_FALSE  if no telemetry data is queued buffer for transmission.
+*               id          ID which identifies the type of the data.  (See 'ProbeCom_TxTelemetry()'
+*                           Note #1.)
 *
-* Caller(s)   : ProbeCom_PktModifier().
+*               nbr_octets  Number of data octets written to 'pbuf->Buf'.
+*
+*               timestamp   Timestamp identifying generation time of data.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : Application,
+*               ProbeCom_TxTelemetry().
 *
-* Note(s)     : (1) See Notes for 'ProbeCom_TxTelemetry()'.
+* Note(s)     : (1) This function may be called from any task or ISR (see 'ProbeCom_TelemetryReserve()'
+*                   Note #1).
+*
+*               (2) The buffer is pushed onto the ready stack (see 'TELEMETRY POOL  Note #2b').  The
+*                   compare-&-swap which pushes it also publishes the data written to it.
+*
+*               (3) 'nbr_octets' is limited to PROBE_COM_TELEMETRY_BUF_LEN.
 *********************************************************************************************************
 */
 
 #if (PROBE_COM_SUPPORT_TELEMETRY == DEF_TRUE)
-static  CPU_BOOLEAN  ProbeCom_TelemetryRdy (void)
+void  ProbeCom_TelemetryCommit (PROBE_COM_TELEMETRY_BUF  *pbuf,
+                                CPU_INT32U                id,
+                                CPU_INT16U                nbr_octets,
+                                CPU_INT32U                timestamp)
 {
-    CPU_BOOLEAN  rdy;
+    CPU_INT32U   head;
+    CPU_INT32U   ix;
+    CPU_BOOLEAN  ok;
 
 
-    if (ProbeCom_TelemetryRdyPoolPtr != (PROBE_COM_TELEMETRY_BUF *)0) {
-        rdy = DEF_FALSE;
-    } else {
-        rdy = DEF_TRUE;
+    if (nbr_octets > PROBE_COM_TELEMETRY_BUF_LEN) {             /* See Note #3.                                         */
+        nbr_octets = PROBE_COM_TELEMETRY_BUF_LEN;
     }
 
-    return (rdy);
+    pbuf->ID        = id;
+    pbuf->Timestamp = timestamp;
+    pbuf->BufLen    = nbr_octets;
+    pbuf->BufIx     = 0;
+
+    ix = (CPU_INT32U)(pbuf - &ProbeCom_TelemetryBufTbl[0]);
+    do {                                                        /* Push buf onto rdy stack (see Note #2).               */
+        head = PROBE_COM_ATOMIC_LD(&ProbeCom_TelemetryRdyHead);
+        PROBE_COM_ATOMIC_ST(&pbuf->NextIx, head);
+        ok   = PROBE_COM_ATOMIC_CAS(&ProbeCom_TelemetryRdyHead, head, ix);
+    } while (ok == DEF_NO);
 }
 #endif
 
 
 /*
 *********************************************************************************************************
-*                                         ProbeCom_TelemetryInit()
+*                                       ProbeCom_StreamPeriodGet()
 *
-* Description : Initialize telemetry buffer pools.
+* Description : Get the period of the symbol stream.
 *
 * Argument(s) : none.
 *
-* Return(s)   : none.
+* Return(s)   : The snapshot period, in milliseconds, or 0 if the stream is stopped.
 *
-* Caller(s)   : ProbeCom_Init().
+* Caller(s)   : Communications-specific driver.
 *
 * Note(s)     : none.
 *********************************************************************************************************
 */
 
-#if (PROBE_COM_SUPPORT_TELEMETRY == DEF_TRUE)
-static  void  ProbeCom_TelemetryInit (void)
+#if (PROBE_COM_SUPPORT_STREAM == DEF_TRUE)
+CPU_INT16U  ProbeCom_StreamPeriodGet (void)
 {
-    CPU_INT08U                i;
-    PROBE_COM_TELEMETRY_BUF  *pbuf;
-
-
-                                                                /* ---------------- INIT TELEMETRY TBL ---------------- */
-                                                                /* Init-clr telemetry pool.                             */
-    ProbeCom_TelemetryFreePoolPtr = (PROBE_COM_TELEMETRY_BUF *)0;
-    ProbeCom_TelemetryRdyPoolPtr  = (PROBE_COM_TELEMETRY_BUF *)0;
-
-    pbuf = &ProbeCom_TelemetryBufTbl[0];
-    for (i = 0; i < PROBE_COM_TELEMETRY_NBR; i++) {             /* Free each vol to pool.                               */
-                                                                /* Init doubly-linked list.                             */
-        pbuf->PrevBufPtr = (void     *)0;
-        pbuf->NextBufPtr = (void     *)ProbeCom_TelemetryFreePoolPtr;
-
-        pbuf->ID         = (CPU_INT32U)0;
-        pbuf->Timestamp  = (CPU_INT32U)0;
-        pbuf->BufLen     = (CPU_INT16U)0;
-        pbuf->BufIx      = (CPU_INT16U)0;
-
-        if (ProbeCom_TelemetryFreePoolPtr != (PROBE_COM_TELEMETRY_BUF *)0) {
-            ProbeCom_TelemetryFreePoolPtr->PrevBufPtr = (void *)pbuf;
-        }
-        ProbeCom_TelemetryFreePoolPtr = pbuf;
-        pbuf++;
-    }
-
-    ProbeCom_TelemetryBufNbrFree = PROBE_COM_TELEMETRY_NBR;
-    ProbeCom_TelemetryBufNbrRdy  = 0;
+    return (ProbeCom_StreamPeriod);
 }
 #endif
 
 
 /*
 *********************************************************************************************************
-*********************************************************************************************************
-**                                  STATIC PACKET-HANDLING FUNCTIONS
-*********************************************************************************************************
-*********************************************************************************************************
-*/
-
-/*
-*********************************************************************************************************
-*                                         ProbeCom_PktModifier()
+*                                       ProbeCom_StreamSnapshot()
+*
+* Description : Formulate a snapshot of the streamed symbols.
+*
+* Argument(s) : ptx_pkt         Pointer to the transmit packet buffer
+*
+*               tx_buf_size     Size of the transmit packet buffer
+*
+*               ts              Timestamp of the snapshot, in milliseconds.
+*
+* Return(s)   : The number of bytes in the data segment of the packet to transmit,
+*               or 0 if the stream is stopped.
+*
+* Caller(s)   : Tasks in communications-specific drivers, e.g., probe_rs232.
+*
+* Note(s)     : (1) The TX format:
+*
+*                   (A) A 2-byte format, indicating the data segment format;
+*                   (B) A 1-byte status, indicating the status after the request;
+*                   (C) A 1-byte modifier;
+*                   (D) A 2-byte sequence number, incremented for every snapshot;
+*                   (E) A 4-byte timestamp;
+*                   (F) The memory data for each symbol, in the order given by the stream configuration.
+*
+*                         +-------------------------+------------+------------+
+*                         |          Format         |   Status   |  Modifier  |
+*                         +-------------------------+------------+------------+
+*                         |     Sequence number     |       Timestamp
+*                         +-------------------------+-------------------------+
+*                                                   |          Data           |
+*                         +-------------------------+                         |
+*                         |                         .                         |
+*                         |                         .                         |
+*                         +---------------------------------------------------+
+*
+*               (2) The host detects lost snapshots from gaps in the sequence number & late snapshots
+*                   from the timestamp.
+*
+*               (3) The stream set is changed only by 'ProbeCom_CmdStreamCfg()'.  This function & the
+*                   parser MUST be called from the same task, so the set cannot change during a snapshot.
+*********************************************************************************************************
+*/
+
+#if (PROBE_COM_SUPPORT_STREAM == DEF_TRUE)
+CPU_INT16U  ProbeCom_StreamSnapshot (void        *ptx_pkt,
+                                     CPU_INT16U   tx_buf_size,
+                                     CPU_INT32U   ts)
+{
+    CPU_INT08U            *ptx_buf;
+    PROBE_COM_STREAM_SYM  *psym;
+    CPU_INT08U             sym_ix;
+
+
+    if (ProbeCom_StreamPeriod == 0) {                           /* If stream stopped ... no pkt.                        */
+        return (0);
+    }
+                                                                /* Tx pkt size = 10 (= Tx header + seq + timestamp)     */
+                                                                /*             + sym bytes.                             */
+    if (tx_buf_size < PROBE_COM_SIZE_TX_HDR + 6 + ProbeCom_StreamLen) {
+        return (0);
+    }
+
+    ptx_buf = (CPU_INT08U *)ptx_pkt;
+                                                                /* Store TX pkt hdr :                                   */
+    ProbeCom_StoINT16U(&ptx_buf, PROBE_COM_FMT_TX_STREAM_DATA); /* (a) TX pkt format.                                   */
+    ProbeCom_StoINT8U( &ptx_buf, PROBE_COM_STATUS_OK);          /* (b) Target status.                                   */
+    ProbeCom_StoINT8U( &ptx_buf, ProbeCom_PktModifier());       /* (c) Modifier.                                        */
+    ProbeCom_StoINT16U(&ptx_buf, ProbeCom_StreamSeq);           /* (d) Seq nbr.                                         */
+    ProbeCom_StoINT32U(&ptx_buf, ts);                           /* (e) Timestamp.                                       */
+
+    psym = &ProbeCom_StreamSymTbl[0];
+    for (sym_ix = 0; sym_ix < ProbeCom_StreamSymNbr; sym_ix++) {
+#if (PROBE_COM_SUPPORT_REGION == DEF_TRUE)                      /* Store data for each sym.                             */
+        ProbeCom_MemRd((void *)ptx_buf, psym->Addr, psym->Len, psym->Access);
+#else
+        Mem_Copy((void     *)ptx_buf,                           /* Store data for each sym.                             */
+                 (void     *)psym->Addr,
+                 (CPU_SIZE_T)psym->Len);
+#endif
+        ptx_buf += psym->Len;
+        psym++;
+    }
+
+    ProbeCom_StreamSeq++;
+
+#if (PROBE_COM_STAT_EN == DEF_ENABLED)
+    ProbeCom_TxPktCtr++;
+    ProbeCom_TxStreamCtr++;
+    ProbeCom_TxSymCtr     += ProbeCom_StreamSymNbr;
+    ProbeCom_TxSymByteCtr += ProbeCom_StreamLen;
+#endif
+
+    return ((CPU_INT16U)(PROBE_COM_SIZE_TX_HDR + 6 + ProbeCom_StreamLen));
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+**                                  STATIC STRING-HANDLING FUNCTIONS
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*                                            ProbeCom_StrRdy()
+*
+* Description : Check if a string is ready for transmission.
+*
+* Argument(s) : none.
+*
+* Return(s)   : DEF_TRUE   if a  string is in the buffer for transmission.
+*               DEF_FALSE  if no string is in the buffer for transmission.
+*
+* Caller(s)   : ProbeCom_PktModifier().
+*
+* Note(s)     : (1) See Notes for 'ProbeCom_TxStr()'.
+*********************************************************************************************************
+*/
+
+#if (PROBE_COM_SUPPORT_STR == DEF_TRUE)
+static  CPU_BOOLEAN  ProbeCom_StrRdy (void)
+{
+    CPU_BOOLEAN  rdy;
+    CPU_INT16U   wr_ix;
+    CPU_INT16U   rd_ix;
+
+
+    wr_ix = ProbeCom_StrBufWrIx;
+    rd_ix = ProbeCom_StrBufRdIx;
+
+    if (wr_ix == rd_ix) {
+        rdy = DEF_FALSE;
+    } else {
+        rdy = DEF_TRUE;
+    }
+
+    return (rdy);
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                         ProbeCom_TelemetryRdy()
+*
+* Description : Check if telemetry data is ready for transmission.
+*
+* Argument(s) : none.
+*
+* Return(s)   : DEF_TRUE   if    telemetry data is queued for transmission.
+*               DEF_FALSE  if no telemetry data is queued for transmission.
+*
+* Caller(s)   : ProbeCom_PktModifier().
+*
+* Note(s)     : (1) See 'TELEMETRY POOL  Note #1'.
+*********************************************************************************************************
+*/
+
+#if (PROBE_COM_SUPPORT_TELEMETRY == DEF_TRUE)
+static  CPU_BOOLEAN  ProbeCom_TelemetryRdy (void)
+{
+    CPU_BOOLEAN  rdy;
+
+
+    if (ProbeCom_TelemetryTxBufGet() != (PROBE_COM_TELEMETRY_BUF *)0) {
+        rdy = DEF_TRUE;
+    } else {
+        rdy = DEF_FALSE;
+    }
+
+    return (rdy);
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                         ProbeCom_TelemetryInit()
+*
+* Description : Initialize telemetry buffer pools.
+*
+* Argument(s) : none.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : ProbeCom_Init().
+*
+* Note(s)     : (1) Every buffer is linked onto the free stack, with a tag of 0.
+*********************************************************************************************************
+*/
+
+#if (PROBE_COM_SUPPORT_TELEMETRY == DEF_TRUE)
+static  void  ProbeCom_TelemetryInit (void)
+{
+    CPU_INT16U                i;
+    PROBE_COM_TELEMETRY_BUF  *pbuf;
+
+
+                                                                /* ---------------- INIT TELEMETRY TBL ---------------- */
+    pbuf = &ProbeCom_TelemetryBufTbl[0];
+    for (i = 0; i < PROBE_COM_TELEMETRY_NBR; i++) {             /* Free each buf to pool (see Note #1).                 */
+        if (i < PROBE_COM_TELEMETRY_NBR - 1) {
+            pbuf->NextIx = i + 1;
+        } else {
+            pbuf->NextIx = PROBE_COM_TELEMETRY_IX_NONE;
+        }
+
+        pbuf->ID         = (CPU_INT32U)0;
+        pbuf->Timestamp  = (CPU_INT32U)0;
+        pbuf->BufLen     = (CPU_INT16U)0;
+        pbuf->BufIx      = (CPU_INT16U)0;
+        pbuf++;
+    }
+
+    ProbeCom_TelemetryFreeHead = 0;
+    ProbeCom_TelemetryRdyHead  = PROBE_COM_TELEMETRY_IX_NONE;
+    ProbeCom_TelemetryTxIx     = PROBE_COM_TELEMETRY_IX_NONE;
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                      ProbeCom_TelemetryTxBufGet()
+*
+* Description : Get the oldest committed telemetry buffer.
+*
+* Argument(s) : none.
+*
+* Return(s)   : Pointer to the buffer, or a NULL pointer if no buffer is committed.
+*
+* Caller(s)   : ProbeCom_CmdTelemetryGet(),
+*               ProbeCom_TelemetryRdy().
+*
+* Note(s)     : (1) When the transmit list is empty, the whole ready stack is taken & reversed onto it
+*                   (see 'TELEMETRY POOL  Note #2c').
+*
+*               (2) A buffer which was only partly transmitted stays at the front of the transmit list, so
+*                   its transmission is not interrupted by other buffers.
+*********************************************************************************************************
+*/
+
+#if (PROBE_COM_SUPPORT_TELEMETRY == DEF_TRUE)
+static  PROBE_COM_TELEMETRY_BUF  *ProbeCom_TelemetryTxBufGet (void)
+{
+    CPU_INT32U   head;
+    CPU_INT32U   ix;
+    CPU_INT32U   ix_next;
+    CPU_BOOLEAN  ok;
+
+
+    if (ProbeCom_TelemetryTxIx == PROBE_COM_TELEMETRY_IX_NONE) {
+        do {                                                    /* Take rdy stack (see Note #1).                        */
+            head = PROBE_COM_ATOMIC_LD(&ProbeCom_TelemetryRdyHead);
+            if (head == PROBE_COM_TELEMETRY_IX_NONE) {
+                return ((PROBE_COM_TELEMETRY_BUF *)0);
+            }
+            ok   = PROBE_COM_ATOMIC_CAS(&ProbeCom_TelemetryRdyHead, head, PROBE_COM_TELEMETRY_IX_NONE);
+        } while (ok == DEF_NO);
+
+        ix = head;
+        while (ix != PROBE_COM_TELEMETRY_IX_NONE) {             /* Reverse it onto tx list.                             */
+            ix_next = PROBE_COM_ATOMIC_LD(&ProbeCom_TelemetryBufTbl[ix].NextIx);
+            PROBE_COM_ATOMIC_ST(&ProbeCom_TelemetryBufTbl[ix].NextIx, ProbeCom_TelemetryTxIx);
+            ProbeCom_TelemetryTxIx = ix;
+            ix                     = ix_next;
+        }
+    }
+
+    return (&ProbeCom_TelemetryBufTbl[ProbeCom_TelemetryTxIx]);
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                      ProbeCom_TelemetryTxBufFree()
+*
+* Description : Return the oldest committed telemetry buffer, once wholly transmitted, to the pool.
+*
+* Argument(s) : none.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : ProbeCom_CmdTelemetryGet().
+*
+* Note(s)     : (1) The buffer is unlinked from the transmit list & pushed onto the free stack (see
+*                   'TELEMETRY POOL  Note #2a').
+*********************************************************************************************************
+*/
+
+#if (PROBE_COM_SUPPORT_TELEMETRY == DEF_TRUE)
+static  void  ProbeCom_TelemetryTxBufFree (void)
+{
+    PROBE_COM_TELEMETRY_BUF  *pbuf;
+    CPU_INT32U                head;
+    CPU_INT32U                head_new;
+    CPU_INT32U                ix;
+    CPU_BOOLEAN               ok;
+
+
+    ix                     = ProbeCom_TelemetryTxIx;
+    pbuf                   = &ProbeCom_TelemetryBufTbl[ix];
+    ProbeCom_TelemetryTxIx = PROBE_COM_ATOMIC_LD(&pbuf->NextIx);
+
+    do {                                                        /* Push buf onto free stack (see Note #1).              */
+        head     = PROBE_COM_ATOMIC_LD(&ProbeCom_TelemetryFreeHead);
+        PROBE_COM_ATOMIC_ST(&pbuf->NextIx, head & PROBE_COM_TELEMETRY_IX_MASK);
+        head_new = ((head & ~PROBE_COM_TELEMETRY_IX_MASK) + PROBE_COM_TELEMETRY_TAG_INC) | ix;
+        ok       = PROBE_COM_ATOMIC_CAS(&ProbeCom_TelemetryFreeHead, head, head_new);
+    } while (ok == DEF_NO);
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                          ProbeCom_AtomicLd()
+*
+* Description : Load a word shared with telemetry producers.
+*
+* Argument(s) : pvar        Pointer to the word.
+*
+* Return(s)   : The value of the word.
+*
+* Caller(s)   : Telemetry pool functions, through PROBE_COM_ATOMIC_LD().
+*
+* Note(s)     : (1) See 'TELEMETRY POOL  Note #3'.  A 32-bit load is NOT a single instruction on every CPU.
+*********************************************************************************************************
+*/
+
+#if (PROBE_COM_SUPPORT_TELEMETRY == DEF_TRUE)
+#if (PROBE_COM_ATOMIC_DFLT       == DEF_TRUE)
+static  CPU_INT32U  ProbeCom_AtomicLd (CPU_INT32U  *pvar)
+{
+#if (CPU_CFG_CRITICAL_METHOD == CPU_CRITICAL_METHOD_STATUS_LOCAL)
+    CPU_SR      cpu_sr = 0;
+#endif
+    CPU_INT32U  val;
+
+
+    CPU_CRITICAL_ENTER();
+    val = *pvar;
+    CPU_CRITICAL_EXIT();
+
+    return (val);
+}
+#endif
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                          ProbeCom_AtomicSt()
+*
+* Description : Store a word shared with telemetry producers.
+*
+* Argument(s) : pvar        Pointer to the word.
+*
+*               val         Value to store.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : Telemetry pool functions, through PROBE_COM_ATOMIC_ST().
+*
+* Note(s)     : (1) See 'TELEMETRY POOL  Note #3'.
+*********************************************************************************************************
+*/
+
+#if (PROBE_COM_SUPPORT_TELEMETRY == DEF_TRUE)
+#if (PROBE_COM_ATOMIC_DFLT       == DEF_TRUE)
+static  void  ProbeCom_AtomicSt (CPU_INT32U  *pvar,
+                                 CPU_INT32U   val)
+{
+#if (CPU_CFG_CRITICAL_METHOD == CPU_CRITICAL_METHOD_STATUS_LOCAL)
+    CPU_SR  cpu_sr = 0;
+#endif
+
+
+    CPU_CRITICAL_ENTER();
+    *pvar = val;
+    CPU_CRITICAL_EXIT();
+}
+#endif
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                          ProbeCom_AtomicCAS()
+*
+* Description : Compare-&-swap a word shared with telemetry producers.
+*
+* Argument(s) : pvar        Pointer to the word.
+*
+*               val_old     Value the word is expected to hold.
+*
+*               val_new     Value to store if the word holds 'val_old'.
+*
+* Return(s)   : DEF_YES, if the word held 'val_old' & 'val_new' was stored.
+*               DEF_NO,  otherwise.
+*
+* Caller(s)   : Telemetry pool functions, through PROBE_COM_ATOMIC_CAS().
+*
+* Note(s)     : (1) See 'TELEMETRY POOL  Note #3'.
+*********************************************************************************************************
+*/
+
+#if (PROBE_COM_SUPPORT_TELEMETRY == DEF_TRUE)
+#if (PROBE_COM_ATOMIC_DFLT       == DEF_TRUE)
+static  CPU_BOOLEAN  ProbeCom_AtomicCAS (CPU_INT32U  *pvar,
+                                         CPU_INT32U   val_old,
+                                         CPU_INT32U   val_new)
+{
+#if (CPU_CFG_CRITICAL_METHOD == CPU_CRITICAL_METHOD_STATUS_LOCAL)
+    CPU_SR       cpu_sr = 0;
+#endif
+    CPU_BOOLEAN  ok;
+
+
+    CPU_CRITICAL_ENTER();
+    if (*pvar == val_old) {
+        *pvar = val_new;
+        ok    = DEF_YES;
+    } else {
+        ok    = DEF_NO;
+    }
+    CPU_CRITICAL_EXIT();
+
+    return (ok);
+}
+#endif
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                          ProbeCom_SymFind()
+*
+* Description : Find a symbol in the symbol directory.
+*
+* Argument(s) : name_hash   Hash of the symbol name.
+*
+* Return(s)   : Pointer to the symbol directory entry, if the symbol is found.
+*               Pointer to NULL,                       otherwise.
+*
+* Caller(s)   : ProbeCom_CmdSymLookup().
+*
+* Note(s)     : (1) The directory is sorted by name hash (see 'probe_com.h  SYMBOL DIRECTORY  Note #1'),
+*                   so it is binary searched.  Each lookup takes at most 17 comparisons.
+*********************************************************************************************************
+*/
+
+#if (PROBE_COM_SUPPORT_SYM == DEF_TRUE)
+static  const  PROBE_COM_SYM  *ProbeCom_SymFind (CPU_INT32U  name_hash)
+{
+    const  PROBE_COM_SYM  *psym;
+    CPU_INT16U             ix_lo;
+    CPU_INT16U             ix_hi;
+    CPU_INT16U             ix_mid;
+
+
+    ix_lo = 0;
+    ix_hi = ProbeCom_SymTblNbr;                                 /* Search [ix_lo, ix_hi).                               */
+    while (ix_lo < ix_hi) {
+        ix_mid = ix_lo + (ix_hi - ix_lo) / 2;
+        psym   = &ProbeCom_SymTbl[ix_mid];
+        if (psym->NameHash == name_hash) {
+            return (psym);
+        }
+        if (psym->NameHash <  name_hash) {
+            ix_lo = ix_mid + 1;
+        } else {
+            ix_hi = ix_mid;
+        }
+    }
+
+    return ((const PROBE_COM_SYM *)0);
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                       ProbeCom_RegionAccess()
+*
+* Description : Get the access granted to a range of memory.
+*
+* Argument(s) : addr        Address of the first byte of the range.
+*
+*               nbytes      Number of bytes in the range.
+*
+* Return(s)   : The access flags of the region holding the range, if one region holds all of it.
+*               PROBE_COM_REGION_NONE,                          otherwise.
+*
+* Caller(s)   : ProbeCom_CmdSimpleRd(),
+*               ProbeCom_CmdMultipleRd(),
+*               ProbeCom_CmdMultipleRdSG(),
+*               ProbeCom_CmdMultipleRdDelta(),
+*               ProbeCom_CmdSimpleWr(),
+*               ProbeCom_CmdMultipleWr(),
+*               ProbeCom_CmdStreamCfg().
+*
+* Note(s)     : (1) The region last found is checked first (see 'MEMORY REGIONS  Note #4').  Otherwise,
+*                   the region tbl is sorted by start addr (see 'probe_com.h  MEMORY REGIONS  Note #1'),
+*                   so it is binary searched for the last region which starts at or below 'addr'.
+*
+*               (2) An empty range is treated as the single byte at 'addr'.
+*
+*               (3) ProbeCom_RegionLastPtr is read once & only ever points into the region tbl, so the
+*                   result is correct even if another task updates it meanwhile.
+*********************************************************************************************************
+*/
+
+#if (PROBE_COM_SUPPORT_REGION == DEF_TRUE)
+static  CPU_INT08U  ProbeCom_RegionAccess (CPU_INT32U  addr,
+                                           CPU_INT16U  nbytes)
+{
+    const  PROBE_COM_REGION  *pregion;
+    CPU_INT32U                addr_end;
+    CPU_INT16U                ix_lo;
+    CPU_INT16U                ix_hi;
+    CPU_INT16U                ix_mid;
+
+
+    addr_end = addr;                                            /* See Note #2.                                         */
+    if (nbytes > 0) {
+        addr_end = addr + nbytes - 1;
+        if (addr_end < addr) {                                  /* Range wraps past end of addr space.                  */
+            return (PROBE_COM_REGION_NONE);
+        }
+    }
+
+    pregion = ProbeCom_RegionLastPtr;                           /* See Note #3.                                         */
+    if ((pregion == (const PROBE_COM_REGION *)0) ||             /* If range does NOT start in region last found ...     */
+        (addr    <  pregion->Start)              ||
+        (addr    >  pregion->End)) {
+        ix_lo = 0;                                              /* ... search tbl (see Note #1).                        */
+        ix_hi = ProbeCom_RegionTblNbr;
+        while (ix_lo < ix_hi) {
+            ix_mid = ix_lo + (ix_hi - ix_lo) / 2;
+            if (ProbeCom_RegionTbl[ix_mid].Start <= addr) {
+                ix_lo = ix_mid + 1;
+            } else {
+                ix_hi = ix_mid;
+            }
+        }
+        if (ix_lo == 0) {                                       /* Range starts below first region.                     */
+            return (PROBE_COM_REGION_NONE);
+        }
+        pregion = &ProbeCom_RegionTbl[ix_lo - 1];
+        if (addr > pregion->End) {                              /* Range starts in gap after region.                    */
+            return (PROBE_COM_REGION_NONE);
+        }
+        ProbeCom_RegionLastPtr = pregion;
+    }
+
+    if (addr_end > pregion->End) {                              /* Range runs past end of region.                       */
+        return (PROBE_COM_REGION_NONE);
+    }
+
+    return (pregion->Access);
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                           ProbeCom_MemRd()
+*
+* Description : Read target memory.
+*
+* Argument(s) : pdest       Pointer to the buffer which will receive the data.
+*
+*               addr        Address of the data.
+*
+*               nbytes      Number of bytes to read.
+*
+*               access      Access flags of the region holding the data (see 'ProbeCom_RegionAccess()').
+*
+* Return(s)   : none.
+*
+* Caller(s)   : ProbeCom_CmdSimpleRd(),
+*               ProbeCom_CmdMultipleRd(),
+*               ProbeCom_CmdMultipleRdDelta(),
+*               ProbeCom_StreamSnapshot().
+*
+* Note(s)     : none.
+*********************************************************************************************************
+*/
+
+#if (PROBE_COM_SUPPORT_REGION == DEF_TRUE)
+static  void  ProbeCom_MemRd (void        *pdest,
+                              CPU_INT32U   addr,
+                              CPU_INT16U   nbytes,
+                              CPU_INT08U   access)
+{
+    if ((access & PROBE_COM_REGION_PAGED) != 0) {
+        ProbeCom_PagedRd(pdest, addr, nbytes);
+    } else {
+        Mem_Copy((void     *)pdest,
+                 (void     *)(CPU_ADDR)addr,
+                 (CPU_SIZE_T)nbytes);
+    }
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+**                                  STATIC PACKET-HANDLING FUNCTIONS
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*                                         ProbeCom_PktModifier()
 *
 * Description : Get packet modfier byte.
 *
@@ -1125,7 +2075,15 @@ static  CPU_INT16U  ProbeCom_CmdQuery (CPU_INT08U  *prx_buf,
              break;
 
         case PROBE_COM_QUERY_MAX_TX_SIZE:
+#if (PROBE_COM_SUPPORT_SG == DEF_TRUE)
+             if (ProbeCom_SegTblPtr != (PROBE_COM_TX_SEG *)0) { /* If rsp may be scattered, larger rd's are possible.  */
+                 ProbeCom_StoINT16U(&ptx_buf, PROBE_COM_SG_MAX_SIZE);
+             } else {
+                 ProbeCom_StoINT16U(&ptx_buf, PROBE_COM_TX_MAX_SIZE);
+             }
+#else
              ProbeCom_StoINT16U(&ptx_buf, PROBE_COM_TX_MAX_SIZE);
+#endif
              ProbeCom_StoINT16U(&ptx_buf, 0);
              nbytes  = 4;
              break;
@@ -1136,6 +2094,10 @@ static  CPU_INT16U  ProbeCom_CmdQuery (CPU_INT08U  *prx_buf,
              ProbeCom_StoINT16U(&ptx_buf, PROBE_COM_FMT_RX_SIMPLE_RD  );
              ProbeCom_StoINT16U(&ptx_buf, PROBE_COM_FMT_RX_MULTIPLE_RD);
              nbytes  = 8;
+#if (PROBE_COM_SUPPORT_DELTA == DEF_TRUE)
+             ProbeCom_StoINT16U(&ptx_buf, PROBE_COM_FMT_RX_MULTIPLE_RD_DELTA);
+             nbytes += 2;
+#endif
 #if (PROBE_COM_SUPPORT_WR == DEF_TRUE)
              ProbeCom_StoINT16U(&ptx_buf, PROBE_COM_FMT_RX_SIMPLE_WR  );
              ProbeCom_StoINT16U(&ptx_buf, PROBE_COM_FMT_RX_MULTIPLE_WR);
@@ -1146,8 +2108,20 @@ static  CPU_INT16U  ProbeCom_CmdQuery (CPU_INT08U  *prx_buf,
              ProbeCom_StoINT16U(&ptx_buf, PROBE_COM_FMT_RX_STR_WR);
              nbytes += 4;
 #endif
-#if (PROBE_COM_SUPPORT_TELEMETRY == DEF_TRUE)
-             ProbeCom_StoINT16U(&ptx_buf, PROBE_COM_FMT_RX_TELEMETRY_GET);
+#if (PROBE_COM_SUPPORT_TELEMETRY == DEF_TRUE)
+             ProbeCom_StoINT16U(&ptx_buf, PROBE_COM_FMT_RX_TELEMETRY_GET);
+             nbytes += 2;
+#endif
+#if (PROBE_COM_SUPPORT_STREAM == DEF_TRUE)
+             ProbeCom_StoINT16U(&ptx_buf, PROBE_COM_FMT_RX_STREAM_CFG);
+             nbytes += 2;
+#endif
+#if (PROBE_COM_SUPPORT_SYM    == DEF_TRUE)
+             ProbeCom_StoINT16U(&ptx_buf, PROBE_COM_FMT_RX_SYM_LOOKUP);
+             nbytes += 2;
+#endif
+#if (PROBE_COM_SUPPORT_CRC16  == DEF_TRUE)
+             ProbeCom_StoINT16U(&ptx_buf, PROBE_COM_FMT_CRC16);
              nbytes += 2;
 #endif
              break;
@@ -1317,6 +2291,9 @@ static  CPU_INT16U  ProbeCom_CmdInfo (CPU_INT08U  *prx_buf,
 *                         |                         .                         |
 *                         +---------------------------------------------------+
 *
+*               (3) If the data will not fit in the TX buffer & the response may be scattered (see
+*                   'ProbeCom_ParseRxPktSG()'), the data is not copied but transmitted straight from
+*                   memory.  Paged data is never scattered (see 'MEMORY REGIONS  Note #3').
 *********************************************************************************************************
 */
 
@@ -1325,8 +2302,11 @@ static  CPU_INT16U  ProbeCom_CmdSimpleRd (CPU_INT08U  *prx_buf,
                                           CPU_INT16U   rx_pkt_size,
                                           CPU_INT16U   tx_buf_size)
 {
-    CPU_ADDR     addr;
-    CPU_INT16U   nbytes;
+    PROBE_COM_ADDR  addr;
+    CPU_INT16U      nbytes;
+#if (PROBE_COM_SUPPORT_REGION == DEF_TRUE)
+    CPU_INT08U      access;
+#endif
 
 
     addr   = 0;
@@ -1345,16 +2325,41 @@ static  CPU_INT16U  ProbeCom_CmdSimpleRd (CPU_INT08U  *prx_buf,
     nbytes = ProbeCom_GetINT16U(&prx_buf);                      /* Get nbr of bytes to read.                            */
 
                                                                 /* Get read addr.                                       */
-#if ((!defined(CPU_CFG_ADDR_SIZE)) || \
+#if ((PROBE_COM_SUPPORT_REGION == DEF_TRUE) || \
+     (!defined(CPU_CFG_ADDR_SIZE))          || \
      ((defined(CPU_CFG_ADDR_SIZE)) && \
               (CPU_CFG_ADDR_SIZE   != CPU_WORD_SIZE_16)))
-    addr   = (CPU_ADDR)ProbeCom_GetINT32U(&prx_buf);
+    addr   = (PROBE_COM_ADDR)ProbeCom_GetINT32U(&prx_buf);
 #else
-    addr   = (CPU_ADDR)ProbeCom_GetINT16U(&prx_buf);
+    addr   = (PROBE_COM_ADDR)ProbeCom_GetINT16U(&prx_buf);
+#endif
+
+#if (PROBE_COM_SUPPORT_REGION == DEF_TRUE)
+    access = ProbeCom_RegionAccess(addr, nbytes);
+    if ((access & PROBE_COM_REGION_RD) == 0) {                  /* Rtn err if memory may NOT be read.                   */
+        return (ProbeCom_CmdErr(ptx_buf, PROBE_COM_STATUS_ADDR_FORBIDDEN));
+    }
+                                                                /* Rtn err if paged data will NOT fit in buf.           */
+    if (((access & PROBE_COM_REGION_PAGED) != 0) &&
+        ((CPU_INT32U)nbytes + PROBE_COM_SIZE_TX_HDR > tx_buf_size)) {
+        return (ProbeCom_CmdErr(ptx_buf, PROBE_COM_STATUS_TX_PKT_TOO_LARGE));
+    }
 #endif
 
-    if (nbytes + PROBE_COM_SIZE_TX_HDR > tx_buf_size) {         /* If TX pkt will NOT fit in buf, rtn err.            */
+                                                                /* If TX pkt will NOT fit in buf ...                    */
+    if ((CPU_INT32U)nbytes + PROBE_COM_SIZE_TX_HDR > tx_buf_size) {
+#if (PROBE_COM_SUPPORT_SG == DEF_TRUE)
+        if ((ProbeCom_SegTblPtr == (PROBE_COM_TX_SEG *)0) ||    /*  ... & can't be scattered, rtn err.                  */
+            (ProbeCom_SegNbrMax <  2)                    ||
+            ((CPU_INT32U)nbytes + PROBE_COM_SIZE_TX_HDR > PROBE_COM_SG_MAX_SIZE)) {
+            return (ProbeCom_CmdErr(ptx_buf, PROBE_COM_STATUS_TX_PKT_TOO_LARGE));
+        }
+                                                                /*  ... else tx data from memory (see Note #3).         */
+        (void)ProbeCom_SegAdd((void *)ptx_buf,         PROBE_COM_SIZE_TX_HDR);
+        (void)ProbeCom_SegAdd((void *)(CPU_ADDR)addr,  nbytes);
+#else
         return (ProbeCom_CmdErr(ptx_buf, PROBE_COM_STATUS_TX_PKT_TOO_LARGE));
+#endif
     }
 
 #if (PROBE_COM_STAT_EN == DEF_ENABLED)
@@ -1367,9 +2372,27 @@ static  CPU_INT16U  ProbeCom_CmdSimpleRd (CPU_INT08U  *prx_buf,
     ProbeCom_StoINT8U( &ptx_buf, PROBE_COM_STATUS_OK);          /*  (b) Target status.                                  */
     ProbeCom_StoINT8U( &ptx_buf, ProbeCom_PktModifier());       /*  (c) Modifier.                                       */
 
+#if (PROBE_COM_SUPPORT_REGION == DEF_TRUE)
+#if (PROBE_COM_SUPPORT_SG == DEF_TRUE)
+    if (ProbeCom_SegNbr == 0) {
+        ProbeCom_MemRd((void *)ptx_buf, addr, nbytes, access);  /* Save TX data segment data.                           */
+    }
+#else
+    ProbeCom_MemRd((void *)ptx_buf, addr, nbytes, access);      /* Save TX data segment data.                           */
+#endif
+#else
+#if (PROBE_COM_SUPPORT_SG == DEF_TRUE)
+    if (ProbeCom_SegNbr == 0) {
+        Mem_Copy((void     *)ptx_buf,                           /* Save TX data segment data.                           */
+                 (void     *)addr,
+                 (CPU_SIZE_T)nbytes);
+    }
+#else
     Mem_Copy((void     *)ptx_buf,                               /* Save TX data segment data.                           */
              (void     *)addr,
              (CPU_SIZE_T)nbytes);
+#endif
+#endif
 
                                                                 /* ------------------ RTN TX PKT SIZE ----------------- */
     return ((CPU_INT16U)(nbytes + PROBE_COM_SIZE_TX_HDR));      /* TX pkt size = nbytes (= Tx data   size)              */
@@ -1453,6 +2476,8 @@ static  CPU_INT16U  ProbeCom_CmdSimpleRd (CPU_INT08U  *prx_buf,
 *                         |                         .                         |        |
 *                         +---------------------------------------------------+       ---
 *
+*               (3) If the data will not fit in the TX buffer & the response may be scattered (see
+*                   'ProbeCom_ParseRxPktSG()'), the response is formed by 'ProbeCom_CmdMultipleRdSG()'.
 *********************************************************************************************************
 */
 
@@ -1464,47 +2489,437 @@ static  CPU_INT16U  ProbeCom_CmdMultipleRd (CPU_INT08U  *prx_buf,
     CPU_INT08U  *ptx_buf_start;
     CPU_INT16U   tx_len;
 
-    CPU_ADDR     addr;
+    PROBE_COM_ADDR  addr;
+    CPU_INT16U   nbytes;
+    CPU_INT16U   rx_pkt_ix;
+#if (PROBE_COM_SUPPORT_REGION == DEF_TRUE)
+    CPU_INT08U   access;
+#endif
+
+#if (PROBE_COM_STAT_EN == DEF_ENABLED)
+    CPU_INT16U   sym_ctr;
+    CPU_INT16U   sym_byte_ctr;
+#endif
+
+#if (PROBE_COM_SUPPORT_SG == DEF_TRUE)
+    CPU_INT32U   sg_len;
+#endif
+
+
+                                                                /* ------------------- CHK PKT SIZE ------------------- */
+                                                                /* Expected size >= 2 (= Rx header size )               */
+                                                                /*                + 5 (= 1 item descriptor).            */
+    if (rx_pkt_size  < 7) {
+        return (ProbeCom_CmdErr(ptx_buf, PROBE_COM_STATUS_RX_PKT_WRONG_SIZE));
+    }
+
+#if (PROBE_COM_SUPPORT_SG == DEF_TRUE)
+    if (ProbeCom_SegTblPtr != (PROBE_COM_TX_SEG *)0) {          /* If rsp may be scattered ...                          */
+        sg_len = PROBE_COM_SIZE_TX_HDR;
+        for (rx_pkt_ix = 7; rx_pkt_ix <= rx_pkt_size; rx_pkt_ix += 5) {
+            sg_len += prx_buf[rx_pkt_ix - 7];                   /*  ... sum nbr of bytes to read             ...        */
+        }
+        if (sg_len > tx_buf_size) {                             /*  ... & scatter rsp if it won't fit in TX buf.        */
+            return (ProbeCom_CmdMultipleRdSG(prx_buf, ptx_buf, rx_pkt_size, sg_len));
+        }
+    }
+#endif
+
+                                                                /* -------------------- HANDLE RD --------------------- */
+    ptx_buf_start = ptx_buf;                                    /* Save ptr to TX buf in case pkt is too long for buf.  */
+    tx_len        = PROBE_COM_SIZE_TX_HDR;                      /* Initial TX pkt len = 4 = size of hdr.                */
+
+                                                                /* Store TX pkt hdr :                                   */
+    ptx_buf[0]    = PROBE_COM_FMT_TX_MULTIPLE_RD_LO;            /* (a) TX pkt format.                                   */
+    ptx_buf[1]    = PROBE_COM_FMT_TX_MULTIPLE_RD_HI;
+    ptx_buf[2]    = PROBE_COM_STATUS_OK;                        /* (b) Target status.                                   */
+    ptx_buf[3]    = ProbeCom_PktModifier();                     /* (c) Modifier.                                        */
+    ptx_buf      += PROBE_COM_SIZE_TX_HDR;
+
+    rx_pkt_ix     = 7;                                          /* Recv pkt ix after 1st item = 2 (= Rx header size   ) */
+                                                                /*                            + 5 (= 1 item descriptor).*/
+
+#if (PROBE_COM_STAT_EN == DEF_ENABLED)
+    sym_ctr      = 0;
+    sym_byte_ctr = 0;
+#endif
+                                                                /* Store data for each item.                            */
+    while (rx_pkt_ix <= rx_pkt_size) {
+        nbytes     =  prx_buf[0];                               /* (a) Get nbr of bytes to read.                        */
+
+                                                                /* (b) Get read addr.                                   */
+#if ((PROBE_COM_SUPPORT_REGION == DEF_TRUE) || \
+     (!defined(CPU_CFG_ADDR_SIZE))          || \
+     ((defined(CPU_CFG_ADDR_SIZE)) && \
+              (CPU_CFG_ADDR_SIZE   != CPU_WORD_SIZE_16)))
+        addr       = (prx_buf[4] << 8) + prx_buf[3];
+        addr       = (addr       << 8) + prx_buf[2];
+        addr       = (addr       << 8) + prx_buf[1];
+#else
+        addr       = (prx_buf[2] << 8) + prx_buf[1];
+#endif
+
+        prx_buf   += 5;
+        rx_pkt_ix += 5;
+
+#if (PROBE_COM_SUPPORT_REGION == DEF_TRUE)
+        access     = ProbeCom_RegionAccess(addr, nbytes);       /*     May memory be read? ...                          */
+        if ((access & PROBE_COM_REGION_RD) == 0) {              /*     ... rtn err if not.                              */
+            return (ProbeCom_CmdErr(ptx_buf_start, PROBE_COM_STATUS_ADDR_FORBIDDEN));
+        }
+#endif
+
+        tx_len    += nbytes;                                    /* (c) Add nbr of bytes to pkt len.                     */
+
+        if (tx_len > tx_buf_size) {                             /* (d) Will pkt be too long for TX buf? ...             */
+            ptx_buf = ptx_buf_start;                            /*     ... rtn err.                                     */
+            return (ProbeCom_CmdErr(ptx_buf, PROBE_COM_STATUS_TX_PKT_TOO_LARGE));
+        }
+
+#if (PROBE_COM_STAT_EN == DEF_ENABLED)
+        sym_ctr++;                                              /* (e) Inc local sym ctr.                               */
+        sym_byte_ctr += nbytes;
+#endif
+                                                                /* (f) Otherwise, save TX data.                         */
+#if (PROBE_COM_SUPPORT_REGION == DEF_TRUE)
+        ProbeCom_MemRd((void *)ptx_buf, addr, nbytes, access);
+#else
+        Mem_Copy((void     *)ptx_buf,
+                 (void     *)addr,
+                 (CPU_SIZE_T)nbytes);
+#endif
+
+        ptx_buf += nbytes;
+    }
+
+#if (PROBE_COM_STAT_EN == DEF_ENABLED)
+    ProbeCom_TxSymCtr     += sym_ctr;                           /* Inc global sym ctr.                                  */
+    ProbeCom_TxSymByteCtr += sym_byte_ctr;
+#endif
+
+                                                                /* ------------------ RTN TX PKT SIZE ----------------- */
+    return (tx_len);
+}
+
+
+/*
+*********************************************************************************************************
+*                                      ProbeCom_CmdMultipleRdSG()
+*
+* Description : Form a scattered response to a multiple read request.
+*
+* Argument(s) : prx_buf         Pointer to the receive  buffer
+*
+*               ptx_buf         Pointer to the transmit buffer
+*
+*               rx_pkt_size     Size of the receive  packet
+*
+*               tx_len          Size of the response, i.e., the size of the header plus the sizes of
+*                               all the items
+*
+* Return(s)   : The number of bytes written to the tx buffer.
+*
+* Caller(s)   : ProbeCom_CmdMultipleRd().
+*
+* Note(s)     : (1) The response has the format described in 'ProbeCom_CmdMultipleRd()'.  Only the header
+*                   is written to the TX buffer; each item is added as a segment pointing at the target
+*                   memory, & items which are adjacent in memory share a segment.
+*
+*               (2) If the items need more segments than the table holds, the request is rejected, just
+*                   as a read that does not fit in the TX buffer is.
+*
+*               (3) Paged items cannot be sent straight from memory (see 'MEMORY REGIONS  Note #3'), so a
+*                   request which reads any is rejected as too large.
+*********************************************************************************************************
+*/
+
+#if (PROBE_COM_SUPPORT_SG == DEF_TRUE)
+static  CPU_INT16U  ProbeCom_CmdMultipleRdSG (CPU_INT08U  *prx_buf,
+                                              CPU_INT08U  *ptx_buf,
+                                              CPU_INT16U   rx_pkt_size,
+                                              CPU_INT32U   tx_len)
+{
+    PROBE_COM_ADDR  addr;
     CPU_INT16U   nbytes;
     CPU_INT16U   rx_pkt_ix;
+    CPU_BOOLEAN  ok;
+#if (PROBE_COM_SUPPORT_REGION == DEF_TRUE)
+    CPU_INT08U   access;
+#endif
+
+#if (PROBE_COM_STAT_EN == DEF_ENABLED)
+    CPU_INT16U   sym_ctr;
+    CPU_INT16U   sym_byte_ctr;
+#endif
+
+
+    if (tx_len > PROBE_COM_SG_MAX_SIZE) {                       /* If pkt will be too long even when scattered ...      */
+        return (ProbeCom_CmdErr(ptx_buf, PROBE_COM_STATUS_TX_PKT_TOO_LARGE));  /* ... rtn err.                          */
+    }
+
+                                                                /* Store TX pkt hdr :                                   */
+    ptx_buf[0] = PROBE_COM_FMT_TX_MULTIPLE_RD_LO;               /* (a) TX pkt format.                                   */
+    ptx_buf[1] = PROBE_COM_FMT_TX_MULTIPLE_RD_HI;
+    ptx_buf[2] = PROBE_COM_STATUS_OK;                           /* (b) Target status.                                   */
+    ptx_buf[3] = ProbeCom_PktModifier();                        /* (c) Modifier.                                        */
+    (void)ProbeCom_SegAdd((void *)ptx_buf, PROBE_COM_SIZE_TX_HDR);
+
+    rx_pkt_ix  = 7;
+
+#if (PROBE_COM_STAT_EN == DEF_ENABLED)
+    sym_ctr      = 0;
+    sym_byte_ctr = 0;
+#endif
+                                                                /* Add a seg for each item.                             */
+    while (rx_pkt_ix <= rx_pkt_size) {
+        nbytes     =  prx_buf[0];                               /* (a) Get nbr of bytes to read.                        */
+
+                                                                /* (b) Get read addr.                                   */
+#if ((PROBE_COM_SUPPORT_REGION == DEF_TRUE) || \
+     (!defined(CPU_CFG_ADDR_SIZE))          || \
+     ((defined(CPU_CFG_ADDR_SIZE)) && \
+              (CPU_CFG_ADDR_SIZE   != CPU_WORD_SIZE_16)))
+        addr       = (prx_buf[4] << 8) + prx_buf[3];
+        addr       = (addr       << 8) + prx_buf[2];
+        addr       = (addr       << 8) + prx_buf[1];
+#else
+        addr       = (prx_buf[2] << 8) + prx_buf[1];
+#endif
+
+        prx_buf   += 5;
+        rx_pkt_ix += 5;
+
+#if (PROBE_COM_SUPPORT_REGION == DEF_TRUE)
+        access     = ProbeCom_RegionAccess(addr, nbytes);       /*     May memory be read? ...                          */
+        if ((access & PROBE_COM_REGION_RD) == 0) {              /*     ... rtn err if not.                              */
+            ProbeCom_SegNbr = 0;
+            return (ProbeCom_CmdErr(ptx_buf, PROBE_COM_STATUS_ADDR_FORBIDDEN));
+        }
+        if ((access & PROBE_COM_REGION_PAGED) != 0) {           /*     Rtn err if paged (see Note #3).                  */
+            ProbeCom_SegNbr = 0;
+            return (ProbeCom_CmdErr(ptx_buf, PROBE_COM_STATUS_TX_PKT_TOO_LARGE));
+        }
+#endif
+
+        ok = ProbeCom_SegAdd((void *)(CPU_ADDR)addr, nbytes);   /* (c) Add seg, or extend previous seg.                 */
+        if (ok == DEF_FAIL) {                                   /* (d) Out of segs? ... rtn err (see Note #2).          */
+            ProbeCom_SegNbr = 0;
+            return (ProbeCom_CmdErr(ptx_buf, PROBE_COM_STATUS_TX_PKT_TOO_LARGE));
+        }
+
+#if (PROBE_COM_STAT_EN == DEF_ENABLED)
+        sym_ctr++;                                              /* (e) Inc local sym ctr.                               */
+        sym_byte_ctr += nbytes;
+#endif
+    }
+
+#if (PROBE_COM_STAT_EN == DEF_ENABLED)
+    ProbeCom_TxSymCtr     += sym_ctr;                           /* Inc global sym ctr.                                  */
+    ProbeCom_TxSymByteCtr += sym_byte_ctr;
+#endif
+
+    return ((CPU_INT16U)tx_len);
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                     ProbeCom_CmdMultipleRdDelta()
+*
+* Description : Parse the FMT_MULTIPLE_RD_DELTA request & formulate response.  This command asks the target
+*               to send data read from its memory, for a certain set of {memory address, data length}
+*               pairs, but only for those items whose data changed since the last response.
+*
+* Argument(s) : prx_buf         Pointer to the receive  buffer
+*
+*               ptx_buf         Pointer to the transmit buffer
+*
+*               rx_pkt_size     Size of the receive  packet
+*
+*               tx_buf_size     Size of the transmit buffer
+*
+* Return(s)   : The number of bytes written to the tx buffer.
+*
+* Caller(s)   : ProbeCom_ParseRxPkt().
+*
+* Note(s)     : (1) The RX format:
+*
+*                   (A) A 2-byte format,  indicating the data segment format;
+*                   (B) A 2-byte options, the DELTA READ OPTIONS;
+*                   (C) A 5-byte item descriptor, for each item in the list, as for FMT_MULTIPLE_RD.
+*
+*                         +-------------------------+-------------------------+
+*                         |          Format         |         Options         |
+*                         +------------+------------+-------------------------+
+*                         | Num. bytes |                  Address             |     Item 1
+*                         +------------+--------------------------------------+
+*                         |                         .                         |
+*                         |                         .                         |
+*                         +------------+--------------------------------------+
+*                         | Num. bytes |                  Address             |     Item n
+*                         +------------+--------------------------------------+
+*
+*               (2) The TX format:
+*
+*                   (A) A 2-byte format, indicating the data segment format;
+*                   (B) A 1-byte status, indicating the status after the request;
+*                   (C) A 1-byte modifier;
+*                   (D) A 1-byte flags, the DELTA READ FLAGS;
+*                   (E) A bitmap of ((n + 7) / 8) bytes.  Bit (i % 8) of byte (i / 8) is set if item i
+*                       is included;
+*                   (F) The memory data for each included item, in item order.
+*
+*                         +-------------------------+------------+------------+
+*                         |          Format         |   Status   |  Modifier  |
+*                         +------------+------------+------------+------------+
+*                         |   Flags    |        Bitmap           |    Data    |
+*                         +------------+-------------------------+            |
+*                         |                         .                         |
+*                         |                         .                         |
+*                         +---------------------------------------------------+
+*
+*               (3) The target keeps a single shadow of the item data it last sent.  The shadow is only
+*                   valid for the same list of item descriptors, so the response is a keyframe, with
+*                   every item included, if :
+*
+*                   (a) The item descriptors differ from those of the previous delta request;
+*                   (b) The host set PROBE_COM_DELTA_OPT_KEY; or
+*                   (c) PROBE_COM_DELTA_KEY_PERIOD responses have been sent since the last keyframe.
+*
+*                   If a response is lost, the host MUST set PROBE_COM_DELTA_OPT_KEY in its next request,
+*                   or wait for the next periodic keyframe, since its copy no longer matches the shadow.
+*
+*               (4) The response is checked against the size of a keyframe, so a request is accepted or
+*                   rejected independent of how many items changed.
+*
+*               (5) Each item is read from memory once, straight into the TX buffer, & then compared
+*                   with the shadow.  An unchanged item is overwritten by the next item.
+*
+*               (6) Every item is checked against the region tbl before the descriptor, shadow or keyframe
+*                   counter is changed, so a forbidden request leaves the delta state as it was.
+*********************************************************************************************************
+*/
+
+#if (PROBE_COM_SUPPORT_DELTA == DEF_TRUE)
+static  CPU_INT16U  ProbeCom_CmdMultipleRdDelta (CPU_INT08U  *prx_buf,
+                                                 CPU_INT08U  *ptx_buf,
+                                                 CPU_INT16U   rx_pkt_size,
+                                                 CPU_INT16U   tx_buf_size)
+{
+    CPU_INT08U   *pbitmap;
+    CPU_INT08U   *pshadow;
+    CPU_INT16U    opt;
+    CPU_INT16U    desc_len;
+    CPU_INT16U    nbr_items;
+    CPU_INT16U    bitmap_len;
+    CPU_INT16U    data_len;
+    CPU_INT16U    tx_len;
+    CPU_INT16U    item_ix;
+    CPU_INT16U    nbytes;
+    PROBE_COM_ADDR  addr;
+    CPU_BOOLEAN   key;
+    CPU_BOOLEAN   same;
+#if (PROBE_COM_SUPPORT_REGION == DEF_TRUE)
+    CPU_INT08U   *pdesc;
+    CPU_INT08U    access;
+#endif
+
+#if (PROBE_COM_STAT_EN == DEF_ENABLED)
+    CPU_INT16U    sym_ctr;
+    CPU_INT16U    sym_byte_ctr;
+#endif
+
+
+                                                                /* ------------------- CHK PKT SIZE ------------------- */
+                                                                /* Expected size = 2     (= Rx header size   )          */
+                                                                /*               + 2     (= Options          )          */
+                                                                /*               + 5 * n (= n item descriptors).        */
+    if ((rx_pkt_size < 9) || (((rx_pkt_size - 4) % 5) != 0)) {
+        return (ProbeCom_CmdErr(ptx_buf, PROBE_COM_STATUS_RX_PKT_WRONG_SIZE));
+    }
+
+    opt        = ProbeCom_GetINT16U(&prx_buf);
+    desc_len   = rx_pkt_size - 4;
+    nbr_items  = desc_len / 5;
+    bitmap_len = (nbr_items + 7) / 8;
+
+    data_len   = 0;                                             /* See Note #4.                                         */
+    for (item_ix = 0; item_ix < nbr_items; item_ix++) {
+        data_len += prx_buf[5 * item_ix];
+    }
+                                                                /* Keyframe size = 5          (= Tx header + flags)     */
+                                                                /*               + bitmap_len (= Bitmap           )     */
+                                                                /*               + data_len   (= Item data        ).    */
+    if ((PROBE_COM_SIZE_TX_HDR + 1 + bitmap_len + data_len > tx_buf_size) ||
+        (data_len > sizeof(ProbeCom_DeltaShadow))) {
+        return (ProbeCom_CmdErr(ptx_buf, PROBE_COM_STATUS_TX_PKT_TOO_LARGE));
+    }
 
-#if (PROBE_COM_STAT_EN == DEF_ENABLED)
-    CPU_INT16U   sym_ctr;
-    CPU_INT16U   sym_byte_ctr;
+#if (PROBE_COM_SUPPORT_REGION == DEF_TRUE)
+                                                                /* ------------------- CHK ACCESS --------------------- */
+    pdesc = prx_buf;                                            /* See Note #6.                                         */
+    for (item_ix = 0; item_ix < nbr_items; item_ix++) {
+        addr   = (pdesc[4] << 8) + pdesc[3];
+        addr   = (addr     << 8) + pdesc[2];
+        addr   = (addr     << 8) + pdesc[1];
+        access = ProbeCom_RegionAccess(addr, pdesc[0]);
+        if ((access & PROBE_COM_REGION_RD) == 0) {
+            return (ProbeCom_CmdErr(ptx_buf, PROBE_COM_STATUS_ADDR_FORBIDDEN));
+        }
+        pdesc += 5;
+    }
 #endif
 
+                                                                /* ------------------ CHK KEYFRAME -------------------- */
+    key = DEF_NO;                                               /* See Note #3.                                         */
+    if ((DEF_BIT_IS_SET(opt, PROBE_COM_DELTA_OPT_KEY) == DEF_YES) ||
+        (desc_len             != ProbeCom_DeltaDescLen)          ||
+        (ProbeCom_DeltaKeyCtr == 0)) {
+        key = DEF_YES;
+    } else if (Mem_Cmp((void     *)prx_buf,
+                       (void     *)ProbeCom_DeltaDesc,
+                       (CPU_SIZE_T)desc_len) == DEF_NO) {
+        key = DEF_YES;
+    }
 
-                                                                /* ------------------- CHK PKT SIZE ------------------- */
-                                                                /* Expected size >= 2 (= Rx header size )               */
-                                                                /*                + 5 (= 1 item descriptor).            */
-    if (rx_pkt_size  < 7) {
-        return (ProbeCom_CmdErr(ptx_buf, PROBE_COM_STATUS_RX_PKT_WRONG_SIZE));
+    if (key == DEF_YES) {
+        Mem_Copy((void     *)ProbeCom_DeltaDesc,
+                 (void     *)prx_buf,
+                 (CPU_SIZE_T)desc_len);
+        ProbeCom_DeltaDescLen = desc_len;
+        ProbeCom_DeltaKeyCtr  = PROBE_COM_DELTA_KEY_PERIOD;
     }
+    ProbeCom_DeltaKeyCtr--;
 
                                                                 /* -------------------- HANDLE RD --------------------- */
-    ptx_buf_start = ptx_buf;                                    /* Save ptr to TX buf in case pkt is too long for buf.  */
-    tx_len        = PROBE_COM_SIZE_TX_HDR;                      /* Initial TX pkt len = 4 = size of hdr.                */
-
                                                                 /* Store TX pkt hdr :                                   */
-    ptx_buf[0]    = PROBE_COM_FMT_TX_MULTIPLE_RD_LO;            /* (a) TX pkt format.                                   */
-    ptx_buf[1]    = PROBE_COM_FMT_TX_MULTIPLE_RD_HI;
-    ptx_buf[2]    = PROBE_COM_STATUS_OK;                        /* (b) Target status.                                   */
-    ptx_buf[3]    = ProbeCom_PktModifier();                     /* (c) Modifier.                                        */
-    ptx_buf      += PROBE_COM_SIZE_TX_HDR;
+    ProbeCom_StoINT16U(&ptx_buf, PROBE_COM_FMT_TX_MULTIPLE_RD_DELTA);
+                                                                /* (a) TX pkt format.                                   */
+    ProbeCom_StoINT8U( &ptx_buf, PROBE_COM_STATUS_OK);          /* (b) Target status.                                   */
+    ProbeCom_StoINT8U( &ptx_buf, ProbeCom_PktModifier());       /* (c) Modifier.                                        */
+                                                                /* (d) Flags.                                           */
+    ProbeCom_StoINT8U( &ptx_buf, (key == DEF_YES) ? PROBE_COM_DELTA_FLAG_KEY : 0);
 
-    rx_pkt_ix     = 7;                                          /* Recv pkt ix after 1st item = 2 (= Rx header size   ) */
-                                                                /*                            + 5 (= 1 item descriptor).*/
+    pbitmap  = ptx_buf;                                         /* (e) Bitmap, filled in as items are stored.           */
+    Mem_Clr((void     *)pbitmap,
+            (CPU_SIZE_T)bitmap_len);
+    ptx_buf += bitmap_len;
+    tx_len   = PROBE_COM_SIZE_TX_HDR + 1 + bitmap_len;
+
+    pshadow  = &ProbeCom_DeltaShadow[0];
 
 #if (PROBE_COM_STAT_EN == DEF_ENABLED)
     sym_ctr      = 0;
     sym_byte_ctr = 0;
 #endif
-                                                                /* Store data for each item.                            */
-    while (rx_pkt_ix <= rx_pkt_size) {
+                                                                /* Store data for each changed item.                    */
+    for (item_ix = 0; item_ix < nbr_items; item_ix++) {
         nbytes     =  prx_buf[0];                               /* (a) Get nbr of bytes to read.                        */
 
                                                                 /* (b) Get read addr.                                   */
-#if ((!defined(CPU_CFG_ADDR_SIZE)) || \
+#if ((PROBE_COM_SUPPORT_REGION == DEF_TRUE) || \
+     (!defined(CPU_CFG_ADDR_SIZE))          || \
      ((defined(CPU_CFG_ADDR_SIZE)) && \
               (CPU_CFG_ADDR_SIZE   != CPU_WORD_SIZE_16)))
         addr       = (prx_buf[4] << 8) + prx_buf[3];
@@ -1515,25 +2930,38 @@ static  CPU_INT16U  ProbeCom_CmdMultipleRd (CPU_INT08U  *prx_buf,
 #endif
 
         prx_buf   += 5;
-        rx_pkt_ix += 5;
 
-        tx_len    += nbytes;                                    /* (c) Add nbr of bytes to pkt len.                     */
+#if (PROBE_COM_SUPPORT_REGION == DEF_TRUE)
+        access     = ProbeCom_RegionAccess(addr, nbytes);       /* (c) Rd item into TX buf (see Note #5).               */
+        ProbeCom_MemRd((void *)ptx_buf, addr, nbytes, access);
+#else
+        Mem_Copy((void     *)ptx_buf,                           /* (c) Rd item into TX buf (see Note #5).               */
+                 (void     *)addr,
+                 (CPU_SIZE_T)nbytes);
+#endif
 
-        if (tx_len > tx_buf_size) {                             /* (d) Will pkt be too long for TX buf? ...             */
-            ptx_buf = ptx_buf_start;                            /*     ... rtn err.                                     */
-            return (ProbeCom_CmdErr(ptx_buf, PROBE_COM_STATUS_TX_PKT_TOO_LARGE));
+        same = DEF_NO;
+        if (key == DEF_NO) {                                    /* (d) Cmp with shadow.                                 */
+            same = Mem_Cmp((void     *)ptx_buf,
+                           (void     *)pshadow,
+                           (CPU_SIZE_T)nbytes);
         }
 
+        if (same == DEF_NO) {                                   /* (e) If changed, keep in pkt & update shadow.         */
+            Mem_Copy((void     *)pshadow,
+                     (void     *)ptx_buf,
+                     (CPU_SIZE_T)nbytes);
+            DEF_BIT_SET(pbitmap[item_ix / 8], DEF_BIT(item_ix % 8));
+            ptx_buf += nbytes;
+            tx_len  += nbytes;
+
 #if (PROBE_COM_STAT_EN == DEF_ENABLED)
-        sym_ctr++;                                              /* (e) Inc local sym ctr.                               */
-        sym_byte_ctr += nbytes;
+            sym_ctr++;
+            sym_byte_ctr += nbytes;
 #endif
-                                                                /* (f) Otherwise, save TX data.                         */
-        Mem_Copy((void     *)ptx_buf,
-                 (void     *)addr,
-                 (CPU_SIZE_T)nbytes);
+        }
 
-        ptx_buf += nbytes;
+        pshadow += nbytes;
     }
 
 #if (PROBE_COM_STAT_EN == DEF_ENABLED)
@@ -1544,6 +2972,7 @@ static  CPU_INT16U  ProbeCom_CmdMultipleRd (CPU_INT08U  *prx_buf,
                                                                 /* ------------------ RTN TX PKT SIZE ----------------- */
     return (tx_len);
 }
+#endif
 
 
 /*
@@ -1603,10 +3032,10 @@ static  CPU_INT16U  ProbeCom_CmdSimpleWr (CPU_INT08U  *prx_buf,
                                           CPU_INT16U   rx_pkt_size,
                                           CPU_INT16U   tx_buf_size)
 {
-    CPU_INT16U   nbytes;
-    CPU_ADDR     addr;
+    CPU_INT16U      nbytes;
+    PROBE_COM_ADDR  addr;
 #if (CPU_CFG_CRITICAL_METHOD == CPU_CRITICAL_METHOD_STATUS_LOCAL)
-    CPU_SR       cpu_sr;
+    CPU_SR          cpu_sr;
 #endif
 
 
@@ -1623,21 +3052,28 @@ static  CPU_INT16U  ProbeCom_CmdSimpleWr (CPU_INT08U  *prx_buf,
     nbytes = ProbeCom_GetINT16U(&prx_buf);                      /* Get nbr of bytes to write.                           */
 
                                                                 /* Get write addr.                                      */
-#if ((!defined(CPU_CFG_ADDR_SIZE)) || \
+#if ((PROBE_COM_SUPPORT_REGION == DEF_TRUE) || \
+     (!defined(CPU_CFG_ADDR_SIZE))          || \
      ((defined(CPU_CFG_ADDR_SIZE)) && \
               (CPU_CFG_ADDR_SIZE   != CPU_WORD_SIZE_16)))
-    addr   = (CPU_ADDR)ProbeCom_GetINT32U(&prx_buf);
+    addr   = (PROBE_COM_ADDR)ProbeCom_GetINT32U(&prx_buf);
 #else
-    addr   = (CPU_ADDR)ProbeCom_GetINT16U(&prx_buf);
+    addr   = (PROBE_COM_ADDR)ProbeCom_GetINT16U(&prx_buf);
 #endif
 
     if (rx_pkt_size != (8 + nbytes)) {                          /* If RX data segment is NOT expected size ... rtn err. */
         return (ProbeCom_CmdErr(ptx_buf, PROBE_COM_STATUS_RX_PKT_WRONG_SIZE));
     }
 
+#if (PROBE_COM_SUPPORT_REGION == DEF_TRUE)                      /* If memory may NOT be written ... rtn err.            */
+    if ((ProbeCom_RegionAccess(addr, nbytes) & PROBE_COM_REGION_WR) == 0) {
+        return (ProbeCom_CmdErr(ptx_buf, PROBE_COM_STATUS_ADDR_FORBIDDEN));
+    }
+#endif
+
                                                                 /* Copy data into memory.                               */
     CPU_CRITICAL_ENTER();
-    Mem_Copy((void     *)addr,
+    Mem_Copy((void     *)(CPU_ADDR)addr,
              (void     *)prx_buf,
              (CPU_SIZE_T)nbytes);
     CPU_CRITICAL_EXIT();
@@ -1724,9 +3160,9 @@ static  CPU_INT16U  ProbeCom_CmdMultipleWr (CPU_INT08U  *prx_buf,
                                             CPU_INT16U   rx_pkt_size,
                                             CPU_INT16U   tx_buf_size)
 {
-    CPU_INT16U   nbytes;
-    CPU_ADDR     addr;
-    CPU_INT16U   rx_pkt_ix;
+    CPU_INT16U      nbytes;
+    PROBE_COM_ADDR  addr;
+    CPU_INT16U      rx_pkt_ix;
 #if (PROBE_COM_STAT_EN == DEF_ENABLED)
     CPU_INT16U   sym_ctr;
     CPU_INT16U   sym_byte_ctr;
@@ -1757,14 +3193,15 @@ static  CPU_INT16U  ProbeCom_CmdMultipleWr (CPU_INT08U  *prx_buf,
         nbytes  =  prx_buf[0];                                  /* (a) Get nbr of bytes to write.                       */
 
                                                                 /* (b) Get write addr.                                  */
-#if ((!defined(CPU_CFG_ADDR_SIZE)) || \
+#if ((PROBE_COM_SUPPORT_REGION == DEF_TRUE) || \
+     (!defined(CPU_CFG_ADDR_SIZE))          || \
      ((defined(CPU_CFG_ADDR_SIZE)) && \
               (CPU_CFG_ADDR_SIZE   != CPU_WORD_SIZE_16)))
         addr     = (prx_buf[4] << 8) + prx_buf[3];
         addr     = (addr       << 8) + prx_buf[2];
         addr     = (addr       << 8) + prx_buf[1];
 #else
-        addr     = (rx_buf[2]  << 8) + prx_buf[1];
+        addr     = (prx_buf[2] << 8) + prx_buf[1];
 #endif
 
         prx_buf += 5;
@@ -1773,13 +3210,19 @@ static  CPU_INT16U  ProbeCom_CmdMultipleWr (CPU_INT08U  *prx_buf,
             return (ProbeCom_CmdErr(ptx_buf, PROBE_COM_STATUS_RX_PKT_WRONG_SIZE));
         }
 
+#if (PROBE_COM_SUPPORT_REGION == DEF_TRUE)                      /*     If memory may NOT be written ... rtn err.        */
+        if ((ProbeCom_RegionAccess(addr, nbytes) & PROBE_COM_REGION_WR) == 0) {
+            return (ProbeCom_CmdErr(ptx_buf, PROBE_COM_STATUS_ADDR_FORBIDDEN));
+        }
+#endif
+
 #if (PROBE_COM_STAT_EN == DEF_ENABLED)
         sym_ctr++;                                              /* (c) Incr local sym ctr.                              */
         sym_byte_ctr += nbytes;
 #endif
                                                                 /* (d) Store data into pkt.                             */
         CPU_CRITICAL_ENTER();
-        Mem_Copy((void     *)addr,
+        Mem_Copy((void     *)(CPU_ADDR)addr,
                  (void     *)prx_buf,
                  (CPU_SIZE_T)nbytes);
         CPU_CRITICAL_EXIT();
@@ -2066,7 +3509,7 @@ static  CPU_INT16U  ProbeCom_CmdStrWr (CPU_INT08U  *prx_buf,
 
 /*
 *********************************************************************************************************
-*                                        ProbeCom_CmdTeletryGet()
+*                                       ProbeCom_CmdTelemetryGet()
 *
 * Description : Parse the FMT_TELEMETRY_GET command & formulate response.  This command asks the target
 *               to send a telemetry data that it is currently storing.
@@ -2115,9 +3558,9 @@ static  CPU_INT16U  ProbeCom_CmdStrWr (CPU_INT08U  *prx_buf,
 *               (3) See Notes for 'ProbeCom_TxTelemetry()'.
 *
 *               (4) Since the size of the telemetry buffer (and, consequently, the number of bytes of
-*                   telemetry data) may exceed the size of the maximum transmit packet, this function
-*                   will relink a buffer that cannot be fully transmitted to the FRONT of the ready queue
-*                   so buffer transmission is not interrupted by other buffers.
+*                   telemetry data) may exceed the size of the maximum transmit packet, a buffer that
+*                   cannot be fully transmitted stays at the FRONT of the transmit list so buffer
+*                   transmission is not interrupted by other buffers.  See 'ProbeCom_TelemetryTxBufGet()'.
 *********************************************************************************************************
 */
 
@@ -2128,11 +3571,8 @@ static  CPU_INT16U  ProbeCom_CmdTelemetryGet (CPU_INT08U  *prx_buf,
                                               CPU_INT16U   tx_buf_size)
 {
     PROBE_COM_TELEMETRY_BUF  *pbuf;
-#if (CPU_CFG_CRITICAL_METHOD == CPU_CRITICAL_METHOD_STATUS_LOCAL)
-    CPU_SR                    cpu_sr;
-#endif
     CPU_INT16U                buf_len;
-    CPU_INT08U                buf_ix;
+    CPU_INT16U                buf_ix;
     CPU_INT16U                buf_len_tx;
 
 
@@ -2140,20 +3580,15 @@ static  CPU_INT16U  ProbeCom_CmdTelemetryGet (CPU_INT08U  *prx_buf,
                                                                 /* Expected size = 2 (= Rx header size)                 */
                                                                 /*               + 2 (= Padding       ).                */
     if (rx_pkt_size != 4) {
-        return (ProbeCom_CmdError(ptx_buf, PROBE_COM_STATUS_RX_PKT_WRONG_SIZE));
+        return (ProbeCom_CmdErr(ptx_buf, PROBE_COM_STATUS_RX_PKT_WRONG_SIZE));
     }
 
 
                                                                 /* ----------------- HANDLE TELEMETRY ----------------- */
-    CPU_CRITICAL_ENTER();
-    pbuf = ProbeCom_TelemetryRdyPoolPtr;
+    pbuf = ProbeCom_TelemetryTxBufGet();
     if (pbuf == (PROBE_COM_TELEMETRY_BUF *)0) {                 /* If there is NO telemetry data ... rtn err.           */
-        CPU_CRITICAL_EXIT();
-        return (ProbeCom_CmdError(tx_buf, PROBE_COM_STATUS_TELEMETRY_NONE));
+        return (ProbeCom_CmdErr(ptx_buf, PROBE_COM_STATUS_TELEMETRY_NONE));
     }
-    ProbeCom_TelemetryRdyPoolPtr = pbuf->NextBufPtr;
-    ProbeCom_TelemetryBufNbrRdy--;
-    CPU_CRITICAL_EXIT();
 
                                                                 /* Store TX pkt hdr :                                   */
                                                                 /* (a) TX pkt format.                                   */
@@ -2186,35 +3621,14 @@ static  CPU_INT16U  ProbeCom_CmdTelemetryGet (CPU_INT08U  *prx_buf,
              (void     *)&pbuf->Buf[buf_ix],
              (CPU_SIZE_T) buf_len_tx);
 
-                                                                /* Buf len too much for tx buf ...                      */
-                                                                /* ... link buf back to front of rdy pool.              */
-    if (buf_len_tx != buf_len - buf_ix) {
-        buf_ix      += buf_len;
-        pbuf->BufIx  = buf_ix;
-        CPU_CRITICAL_ENTER();
-        pbuf->NextBufPtr = (void *)ProbeCom_TelemetryRdyPoolPtr;
-        if (ProbeCom_TelemetryRdyPoolPtr == (PROBE_COM_TELEMETRY_BUF *)0) {
-            ProbeCom_TelemetryRdyPoolPtr = pbuf;
-        }
-        ProbeCom_TelemetryRdyPoolPtr = pbuf;
-        ProbeCom_TelemetryBufNbrRdy++;
-        CPU_CRITICAL_EXIT();
-    } else {                                                    /* Otherwise ... link buf to front of free pool.        */
-        CPU_CRITICAL_ENTER();
-        pbuf->ID         = (CPU_INT32U)0;
-        pbuf->Timestamp  = (CPU_INT32U)0;
-        pbuf->BufLen     = (CPU_INT16U)0;
-        pbuf->BufIx      = (CPU_INT16U)0;
-        pbuf->NextBufPtr = (void *)ProbeCom_TelemetryFreePoolPtr;
-        if (ProbeCom_TelemetryFreePoolPtr == (PROBE_COM_TELEMETRY_BUF *)0) {
-            ProbeCom_TelemetryFreePoolPtr = pbuf;
-        }
-        ProbeCom_TelemetryFreePoolPtr = pbuf;
-        ProbeCom_TelemetryBufNbrFree++;
-        CPU_CRITICAL_EXIT();
+    buf_ix += buf_len_tx;
+    if (buf_ix < buf_len) {                                     /* Buf len too much for tx buf (see Note #4) ...        */
+        pbuf->BufIx = buf_ix;                                   /* ... keep buf at front of tx list.                    */
+    } else {                                                    /* Otherwise ... free buf.                              */
+        ProbeCom_TelemetryTxBufFree();
     }
                                                                 /* ------------------ RTN TX PKT SIZE ----------------- */
-    return ((CPU_INT16U)(PROBE_COM_SIZE_TX_HEADER + buf_len_tx + 12));
+    return ((CPU_INT16U)(PROBE_COM_SIZE_TX_HDR + buf_len_tx + 12));
                                                                 /* Tx pkt size = 4          (= Tx header size     )     */
                                                                 /*             + 4          (= telemetry ID       )     */
                                                                 /*             + 4          (= telemetry timestamp)     */
@@ -2225,6 +3639,299 @@ static  CPU_INT16U  ProbeCom_CmdTelemetryGet (CPU_INT08U  *prx_buf,
 #endif
 
 
+/*
+*********************************************************************************************************
+*                                        ProbeCom_CmdStreamCfg()
+*
+* Description : Parse the FMT_STREAM_CFG command & formulate response.  This command gives the target a
+*               set of {memory address, data length} pairs to send, without further requests, once
+*               every stream period.
+*
+* Argument(s) : prx_buf         Pointer to the receive  buffer
+*
+*               ptx_buf         Pointer to the transmit buffer
+*
+*               rx_pkt_size     Size of the receive  packet
+*
+*               tx_buf_size     Size of the transmit buffer
+*
+* Return(s)   : The number of bytes written to the tx buffer.
+*
+* Caller(s)   : ProbeCom_ParseRxPkt().
+*
+* Note(s)     : (1) The RX format:
+*
+*                   (A) A 2-byte format, indicating the data segment format;
+*                   (B) A 2-byte period, the time between snapshots in milliseconds (0 stops the stream);
+*                   (C) A 5-byte item descriptor, for each symbol in the set, consisting of the following:
+*
+*                       (1) A 1-byte length,  indicating the number of bytes to read;
+*                       (2) A 4-byte address, the starting address of the data to read.
+*
+*                         +-------------------------+-------------------------+
+*                         |          Format         |          Period         |
+*                         +------------+------------+-------------------------+
+*                         | Num. bytes |                  Address             |     Item 1
+*                         +------------+--------------------------------------+
+*                         |                         .                         |
+*                         |                         .                         |
+*                         +------------+--------------------------------------+
+*                         | Num. bytes |                  Address             |     Item n
+*                         +------------+--------------------------------------+
+*
+*               (2) The TX format:
+*
+*                   (A) A 2-byte format, indicating the data segment format;
+*                   (B) A 1-byte status, indicating the status after the request;
+*                   (C) A 1-byte modifier.
+*
+*                         +-------------------------+------------+------------+
+*                         |          Format         |   Status   |  Modifier  |
+*                         +-------------------------+------------+------------+
+*
+*               (3) A set is rejected with PROBE_COM_STATUS_TX_PKT_TOO_LARGE if it holds more than
+*                   PROBE_COM_STREAM_SYM_NBR symbols, or if its snapshot would not fit in the TX buffer.
+*                   The previous set, if any, is then left streaming.
+*
+*               (4) The sequence number restarts from 0 with every new set.
+*
+*               (5) Every sym is checked against the region tbl before the set is changed, so a set which
+*                   names forbidden memory leaves the running stream as it was.
+*********************************************************************************************************
+*/
+
+#if (PROBE_COM_SUPPORT_STREAM == DEF_TRUE)
+static  CPU_INT16U  ProbeCom_CmdStreamCfg (CPU_INT08U  *prx_buf,
+                                           CPU_INT08U  *ptx_buf,
+                                           CPU_INT16U   rx_pkt_size,
+                                           CPU_INT16U   tx_buf_size)
+{
+    CPU_INT16U             period;
+    CPU_INT16U             nbr_syms;
+    CPU_INT16U             stream_len;
+    CPU_INT08U             sym_ix;
+    PROBE_COM_STREAM_SYM  *psym;
+    PROBE_COM_ADDR         addr;
+#if (PROBE_COM_SUPPORT_REGION == DEF_TRUE)
+    CPU_INT08U            *pdesc;
+#endif
+
+
+                                                                /* ------------------- CHK PKT SIZE ------------------- */
+                                                                /* Expected size = 2     (= Rx header size   )          */
+                                                                /*               + 2     (= Period           )          */
+                                                                /*               + 5 * n (= n item descriptors).        */
+    if ((rx_pkt_size < 4) || (((rx_pkt_size - 4) % 5) != 0)) {
+        return (ProbeCom_CmdErr(ptx_buf, PROBE_COM_STATUS_RX_PKT_WRONG_SIZE));
+    }
+
+    period   = ProbeCom_GetINT16U(&prx_buf);
+    nbr_syms = (rx_pkt_size - 4) / 5;
+
+    if ((period != 0) && (nbr_syms == 0)) {                     /* A running stream needs at least one sym.             */
+        return (ProbeCom_CmdErr(ptx_buf, PROBE_COM_STATUS_RX_PKT_WRONG_SIZE));
+    }
+
+                                                                /* ------------------ HANDLE CFG ---------------------- */
+    if (period == 0) {                                          /* Stop stream.                                         */
+        ProbeCom_StreamPeriod = 0;
+        ProbeCom_StreamSymNbr = 0;
+        ProbeCom_StreamLen    = 0;
+
+    } else {
+        if (nbr_syms > PROBE_COM_STREAM_SYM_NBR) {              /* See Note #3.                                         */
+            return (ProbeCom_CmdErr(ptx_buf, PROBE_COM_STATUS_TX_PKT_TOO_LARGE));
+        }
+
+        stream_len = 0;
+        for (sym_ix = 0; sym_ix < nbr_syms; sym_ix++) {
+            stream_len += prx_buf[5 * sym_ix];
+        }
+                                                                /* Snapshot size = 10 (= Tx header + seq + timestamp)   */
+                                                                /*               + sym bytes.                           */
+        if (PROBE_COM_SIZE_TX_HDR + 6 + stream_len > tx_buf_size) {
+            return (ProbeCom_CmdErr(ptx_buf, PROBE_COM_STATUS_TX_PKT_TOO_LARGE));
+        }
+
+#if (PROBE_COM_SUPPORT_REGION == DEF_TRUE)
+        pdesc = prx_buf;                                        /* See Note #5.                                         */
+        for (sym_ix = 0; sym_ix < nbr_syms; sym_ix++) {
+            addr   = (pdesc[4] << 8) + pdesc[3];
+            addr   = (addr     << 8) + pdesc[2];
+            addr   = (addr     << 8) + pdesc[1];
+            if ((ProbeCom_RegionAccess(addr, pdesc[0]) & PROBE_COM_REGION_RD) == 0) {
+                return (ProbeCom_CmdErr(ptx_buf, PROBE_COM_STATUS_ADDR_FORBIDDEN));
+            }
+            pdesc += 5;
+        }
+#endif
+
+        psym = &ProbeCom_StreamSymTbl[0];
+        for (sym_ix = 0; sym_ix < nbr_syms; sym_ix++) {         /* Store each sym.                                      */
+                                                                /* (a) Get read addr.                                   */
+#if ((PROBE_COM_SUPPORT_REGION == DEF_TRUE) || \
+     (!defined(CPU_CFG_ADDR_SIZE))          || \
+     ((defined(CPU_CFG_ADDR_SIZE)) && \
+              (CPU_CFG_ADDR_SIZE   != CPU_WORD_SIZE_16)))
+            addr       = (prx_buf[4] << 8) + prx_buf[3];
+            addr       = (addr       << 8) + prx_buf[2];
+            addr       = (addr       << 8) + prx_buf[1];
+#else
+            addr       = (prx_buf[2] << 8) + prx_buf[1];
+#endif
+            psym->Addr = addr;
+            psym->Len  = prx_buf[0];                            /* (b) Get nbr of bytes to read.                        */
+#if (PROBE_COM_SUPPORT_REGION == DEF_TRUE)
+                                                                /* (c) Get access flags of region.                      */
+            psym->Access = ProbeCom_RegionAccess(addr, psym->Len);
+#endif
+
+            prx_buf   += 5;
+            psym++;
+        }
+
+        ProbeCom_StreamSymNbr = (CPU_INT08U)nbr_syms;
+        ProbeCom_StreamLen    = stream_len;
+        ProbeCom_StreamPeriod = period;
+        ProbeCom_StreamSeq    = 0;                              /* See Note #4.                                         */
+    }
+
+                                                                /* Store TX pkt hdr :                                   */
+    ProbeCom_StoINT16U(&ptx_buf, PROBE_COM_FMT_TX_STREAM_CFG);  /* (a) TX pkt format.                                   */
+    ProbeCom_StoINT8U( &ptx_buf, PROBE_COM_STATUS_OK);          /* (b) Target status.                                   */
+    ProbeCom_StoINT8U( &ptx_buf, ProbeCom_PktModifier());       /* (c) Modifier.                                        */
+
+                                                                /* ------------------ RTN TX PKT SIZE ----------------- */
+    return ((CPU_INT16U)(PROBE_COM_SIZE_TX_HDR));               /* Tx pkt size = 4 (= Tx header size).                  */
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                        ProbeCom_CmdSymLookup()
+*
+* Description : Parse the FMT_SYM_LOOKUP request & formulate response.  This command causes the target
+*               to send the address, size & type of a set of symbols, named by hash, from its symbol
+*               directory.
+*
+* Argument(s) : prx_buf         Pointer to the receive  buffer
+*
+*               ptx_buf         Pointer to the transmit buffer
+*
+*               rx_pkt_size     Size of the receive  packet
+*
+*               tx_buf_size     Size of the transmit buffer
+*
+* Return(s)   : The number of bytes written to the tx buffer.
+*
+* Caller(s)   : ProbeCom_ParseRxPkt().
+*
+* Note(s)     : (1) The RX format:
+*
+*                   (A) A 2-byte format, indicating the data segment format;
+*                   (B) A 4-byte hash,   for each symbol in the set.
+*
+*                         +-------------------------+-------------------------+
+*                         |          Format         |   Hash (Item 1, low)    |
+*                         +-------------------------+-------------------------+
+*                         |   Hash (Item 1, high)   |   Hash (Item 2, low)    |
+*                         +-------------------------+-------------------------+
+*                         |                         .                         |
+*                         |                         .                         |
+*                         +-------------------------+-------------------------+
+*                         |   Hash (Item n, high)   |
+*                         +-------------------------+
+*
+*               (2) The TX format:
+*
+*                   (A) A 2-byte format, indicating the data segment format;
+*                   (B) A 1-byte status, indicating the status after the request;
+*                   (C) A 1-byte modifier;
+*                   (D) For each symbol, in the order requested, the following is sent:
+*
+*                       (1) A 4-byte address, the address of the symbol;
+*                       (2) A 2-byte size,    the number of bytes in the symbol;
+*                       (3) A 1-byte type,    PROBE_COM_SYM_TYPE_???;
+*                       (4) A 1-byte pad.
+*
+*                         +-------------------------+------------+------------+
+*                         |          Format         |   Status   |  Modifier  |
+*                         +-------------------------+------------+------------+
+*                         |                      Address                      |     Item 1
+*                         +-------------------------+------------+------------+
+*                         |           Size          |    Type    |    Pad     |
+*                         +-------------------------+------------+------------+
+*                         |                         .                         |
+*                         |                         .                         |
+*                         +---------------------------------------------------+
+*                         |                      Address                      |     Item n
+*                         +-------------------------+------------+------------+
+*                         |           Size          |    Type    |    Pad     |
+*                         +-------------------------+------------+------------+
+*
+*               (3) The hash of a symbol name is the 32-bit FNV-1a hash of its characters, as computed
+*                   by 'probe_com_sym.py'.  The host may thus find a variable by name without the ELF
+*                   or MAP file of the running firmware.
+*
+*               (4) A symbol which is not in the directory is returned with address 0, size 0 & type
+*                   PROBE_COM_SYM_TYPE_NONE.
+*********************************************************************************************************
+*/
+
+#if (PROBE_COM_SUPPORT_SYM == DEF_TRUE)
+static  CPU_INT16U  ProbeCom_CmdSymLookup (CPU_INT08U  *prx_buf,
+                                           CPU_INT08U  *ptx_buf,
+                                           CPU_INT16U   rx_pkt_size,
+                                           CPU_INT16U   tx_buf_size)
+{
+    CPU_INT16U              nbr_syms;
+    CPU_INT16U              sym_ix;
+    CPU_INT32U              name_hash;
+    const  PROBE_COM_SYM   *psym;
+
+
+                                                                /* ------------------- CHK PKT SIZE ------------------- */
+                                                                /* Expected size = 2     (= Rx header size)             */
+                                                                /*               + 4 * n (= n hashes      ).            */
+    if ((rx_pkt_size < 6) || (((rx_pkt_size - 2) % 4) != 0)) {
+        return (ProbeCom_CmdErr(ptx_buf, PROBE_COM_STATUS_RX_PKT_WRONG_SIZE));
+    }
+
+    nbr_syms = (rx_pkt_size - 2) / 4;
+                                                                /* Tx pkt size = 4     (= Tx header size)               */
+                                                                /*             + 8 * n (= n sym descriptors).           */
+    if (PROBE_COM_SIZE_TX_HDR + (CPU_INT32U)nbr_syms * 8 > tx_buf_size) {
+        return (ProbeCom_CmdErr(ptx_buf, PROBE_COM_STATUS_TX_PKT_TOO_LARGE));
+    }
+
+                                                                /* Store TX pkt hdr :                                   */
+    ProbeCom_StoINT16U(&ptx_buf, PROBE_COM_FMT_TX_SYM_LOOKUP);  /* (a) TX pkt format.                                   */
+    ProbeCom_StoINT8U( &ptx_buf, PROBE_COM_STATUS_OK);          /* (b) Target status.                                   */
+    ProbeCom_StoINT8U( &ptx_buf, ProbeCom_PktModifier());       /* (c) Modifier.                                        */
+
+                                                                /* ------------------ HANDLE LOOKUP ------------------- */
+    for (sym_ix = 0; sym_ix < nbr_syms; sym_ix++) {
+        name_hash = ProbeCom_GetINT32U(&prx_buf);
+        psym      = ProbeCom_SymFind(name_hash);
+        if (psym != (const PROBE_COM_SYM *)0) {
+            ProbeCom_StoINT32U(&ptx_buf, (CPU_INT32U)(CPU_ADDR)psym->AddrPtr);
+            ProbeCom_StoINT16U(&ptx_buf, psym->Size);
+            ProbeCom_StoINT8U( &ptx_buf, psym->Type);
+        } else {                                                /* See Note #4.                                         */
+            ProbeCom_StoINT32U(&ptx_buf, 0);
+            ProbeCom_StoINT16U(&ptx_buf, 0);
+            ProbeCom_StoINT8U( &ptx_buf, PROBE_COM_SYM_TYPE_NONE);
+        }
+        ProbeCom_StoINT8U(&ptx_buf, 0);
+    }
+
+                                                                /* ------------------ RTN TX PKT SIZE ----------------- */
+    return ((CPU_INT16U)(nbr_syms * 8 + PROBE_COM_SIZE_TX_HDR));
+}
+#endif
+
+
 /*
 *********************************************************************************************************
 *********************************************************************************************************
@@ -2313,10 +4020,66 @@ static  void  ProbeCom_StoINT16U (CPU_INT08U **pbuf, CPU_INT16U data)
 }
 
 
-#if (PROBE_COM_SUPPORT_TELEMETRY == DEF_TRUE)
+#if ((PROBE_COM_SUPPORT_TELEMETRY == DEF_TRUE) || \
+     (PROBE_COM_SUPPORT_STREAM    == DEF_TRUE) || \
+     (PROBE_COM_SUPPORT_SYM       == DEF_TRUE))
 static  void  ProbeCom_StoINT32U (CPU_INT08U **pbuf, CPU_INT32U data)
 {
     ProbeCom_StoINT16U(pbuf, (CPU_INT16U)(data & 0x0000FFFFL));
     ProbeCom_StoINT16U(pbuf, (CPU_INT16U)(data >> 16));
 }
 #endif
+
+
+/*
+*********************************************************************************************************
+*                                          ProbeCom_SegAdd()
+*
+* Description : Add a segment to the scattered response being formed.
+*
+* Argument(s) : pdata           Pointer to the segment data.
+*
+*               len             Number of bytes in the segment.
+*
+* Return(s)   : DEF_OK,   if the segment was added.
+*               DEF_FAIL, otherwise.
+*
+* Caller(s)   : ProbeCom_CmdSimpleRd(),
+*               ProbeCom_CmdMultipleRdSG().
+*
+* Note(s)     : (1) Empty segments are not added, & a segment which directly follows the previous one in
+*                   memory extends it instead of using another table entry.
+*********************************************************************************************************
+*/
+
+#if (PROBE_COM_SUPPORT_SG == DEF_TRUE)
+static  CPU_BOOLEAN  ProbeCom_SegAdd (void *pdata, CPU_INT16U len)
+{
+    PROBE_COM_TX_SEG  *pseg;
+
+
+    if (len == 0) {                                             /* See Note #1.                                         */
+        return (DEF_OK);
+    }
+
+    if (ProbeCom_SegNbr > 0) {
+        pseg = &ProbeCom_SegTblPtr[ProbeCom_SegNbr - 1];
+        if (((CPU_INT08U *)pseg->DataPtr + pseg->DataLen == (CPU_INT08U *)pdata) &&
+            (pseg->DataLen <= 0xFFFF - len)) {
+            pseg->DataLen += len;
+            return (DEF_OK);
+        }
+    }
+
+    if (ProbeCom_SegNbr >= ProbeCom_SegNbrMax) {
+        return (DEF_FAIL);
+    }
+
+    pseg          = &ProbeCom_SegTblPtr[ProbeCom_SegNbr];
+    pseg->DataPtr = pdata;
+    pseg->DataLen = len;
+    ProbeCom_SegNbr++;
+
+    return (DEF_OK);
+}
+#endif
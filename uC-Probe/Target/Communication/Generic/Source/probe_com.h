@@ -105,6 +105,49 @@
 #define  PROBE_COM_SUPPORT_TELEMETRY             DEF_FALSE
 #endif
 
+#ifndef  PROBE_COM_SUPPORT_STREAM
+#define  PROBE_COM_SUPPORT_STREAM                DEF_FALSE
+#endif
+
+#ifndef  PROBE_COM_SUPPORT_DELTA
+#define  PROBE_COM_SUPPORT_DELTA                 DEF_FALSE
+#endif
+
+#ifndef  PROBE_COM_SUPPORT_SG
+#define  PROBE_COM_SUPPORT_SG                    DEF_FALSE
+#endif
+
+#ifndef  PROBE_COM_SUPPORT_CRC16
+#define  PROBE_COM_SUPPORT_CRC16                 DEF_FALSE
+#endif
+
+#ifndef  PROBE_COM_SUPPORT_SYM
+#define  PROBE_COM_SUPPORT_SYM                   DEF_FALSE
+#endif
+
+#ifndef  PROBE_COM_SUPPORT_REGION
+#define  PROBE_COM_SUPPORT_REGION                DEF_FALSE
+#endif
+
+                                                                /* ------------------- SYMBOL TYPES ------------------- */
+#define  PROBE_COM_SYM_TYPE_NONE                        0x00    /* Sym not found.                                       */
+#define  PROBE_COM_SYM_TYPE_INT08U                      0x01
+#define  PROBE_COM_SYM_TYPE_INT08S                      0x02
+#define  PROBE_COM_SYM_TYPE_INT16U                      0x03
+#define  PROBE_COM_SYM_TYPE_INT16S                      0x04
+#define  PROBE_COM_SYM_TYPE_INT32U                      0x05
+#define  PROBE_COM_SYM_TYPE_INT32S                      0x06
+#define  PROBE_COM_SYM_TYPE_FP32                        0x07
+#define  PROBE_COM_SYM_TYPE_BOOLEAN                     0x08
+#define  PROBE_COM_SYM_TYPE_CHAR                        0x09    /* Char array.                                          */
+#define  PROBE_COM_SYM_TYPE_BLOB                        0x0A    /* Struct, array or other aggregate.                    */
+
+                                                                /* ---------------- REGION ACCESS FLAGS --------------- */
+#define  PROBE_COM_REGION_NONE                          0x00    /* No access.                                           */
+#define  PROBE_COM_REGION_RD                            0x01    /* Region may be read.                                  */
+#define  PROBE_COM_REGION_WR                            0x02    /* Region may be written.                               */
+#define  PROBE_COM_REGION_PAGED                         0x04    /* Region is rd through ProbeCom_PagedRd().             */
+
 
 /*
 *********************************************************************************************************
@@ -118,8 +161,7 @@ typedef  void  (*PROBE_COM_INFO_HDNLR_FNCT) (CPU_INT16U   info,
 
 #if (PROBE_COM_SUPPORT_TELEMETRY == DEF_ENABLED)
 typedef  struct  probe_com_telemetry_buf {
-    void        *PrevBufPtr;
-    void        *NextBufPtr;
+    CPU_INT32U   NextIx;                                        /* Ix of next buf in free or rdy list.                  */
     CPU_INT32U   ID;
     CPU_INT32U   Timestamp;
     CPU_INT16U   BufLen;
@@ -132,6 +174,28 @@ typedef  struct  probe_com_telemetry_buf {
 typedef  void  (*PROBE_COM_STR_HDNLR_FNCT)  (CPU_CHAR    *pstr,
                                              CPU_INT16U   len);
 
+#if (PROBE_COM_SUPPORT_SYM == DEF_TRUE)
+typedef  struct  probe_com_sym {                                /* Entry of the sym directory.                          */
+    CPU_INT32U   NameHash;                                      /* FNV-1a hash of sym name.                             */
+    void        *AddrPtr;                                       /* Ptr to sym.                                          */
+    CPU_INT16U   Size;                                          /* Nbr of bytes in sym.                                 */
+    CPU_INT08U   Type;                                          /* Sym type (see PROBE_COM_SYM_TYPE_???).               */
+} PROBE_COM_SYM;
+#endif
+
+#if (PROBE_COM_SUPPORT_REGION == DEF_TRUE)
+typedef  struct  probe_com_region {                             /* Entry of the region tbl.                             */
+    CPU_INT32U   Start;                                         /* Addr of first byte of region.                        */
+    CPU_INT32U   End;                                           /* Addr of last  byte of region.                        */
+    CPU_INT08U   Access;                                        /* Access granted (see PROBE_COM_REGION_???).           */
+} PROBE_COM_REGION;
+#endif
+
+typedef  struct  probe_com_tx_seg {                             /* Segment of a scattered response.                     */
+    void        *DataPtr;                                       /* Ptr to seg data, in TX buf or target memory.         */
+    CPU_INT16U   DataLen;                                       /* Nbr of bytes in seg.                                 */
+} PROBE_COM_TX_SEG;
+
 /*
 *********************************************************************************************************
 *                                            GLOBAL VARIABLES
@@ -154,6 +218,14 @@ PROBE_COM_EXT  CPU_INT32U  ProbeCom_TxStrCtr;                   /* Number of str
 PROBE_COM_EXT  CPU_INT32U  ProbeCom_RxSymCtr;                   /* Number of symbols received.                          */
 PROBE_COM_EXT  CPU_INT32U  ProbeCom_RxSymByteCtr;               /* Number of symbol bytes received.                     */
 #endif
+
+#if (PROBE_COM_SUPPORT_TELEMETRY == DEF_TRUE)
+PROBE_COM_EXT  CPU_INT32U  ProbeCom_TelemetryDropCtr;           /* Number of telemetry bufs not reserved, pool empty.   */
+#endif
+
+#if (PROBE_COM_SUPPORT_STREAM == DEF_TRUE)
+PROBE_COM_EXT  CPU_INT32U  ProbeCom_TxStreamCtr;                /* Number of stream snapshots transmitted.               */
+#endif
 #endif
 
 
@@ -177,6 +249,16 @@ CPU_INT16U   ProbeCom_ParseRxPkt  (void                       *prx_pkt,     /* P
                                    CPU_INT16U                  rx_pkt_sz,
                                    CPU_INT16U                  tx_buf_sz);
 
+#if (PROBE_COM_SUPPORT_SG == DEF_TRUE)
+CPU_INT16U   ProbeCom_ParseRxPktSG(void                       *prx_pkt,     /* Parse rx'd pkt & fmt scattered resp.     */
+                                   void                       *ptx_pkt,
+                                   CPU_INT16U                  rx_pkt_sz,
+                                   CPU_INT16U                  tx_buf_sz,
+                                   PROBE_COM_TX_SEG           *pseg_tbl,
+                                   CPU_INT08U                  seg_nbr_max,
+                                   CPU_INT08U                 *pseg_nbr);
+#endif
+
 void         ProbeCom_InfoHndlrSet(PROBE_COM_INFO_HDNLR_FNCT   hndlr);      /* Set hndlr for info pkt's.                */
 
 #if (PROBE_COM_SUPPORT_STR == DEF_TRUE)
@@ -191,8 +273,62 @@ CPU_BOOLEAN  ProbeCom_TxTelemetry (CPU_INT32U                  id,          /* T
                                    void                       *pdata,
                                    CPU_INT16U                  nbr_octets,
                                    CPU_INT32U                  timestamp);
+
+PROBE_COM_TELEMETRY_BUF  *ProbeCom_TelemetryReserve(void);                  /* Reserve telemetry buf to fill in place.  */
+
+void         ProbeCom_TelemetryCommit (PROBE_COM_TELEMETRY_BUF *pbuf,       /* Queue filled telemetry buf for tx.       */
+                                       CPU_INT32U               id,
+                                       CPU_INT16U               nbr_octets,
+                                       CPU_INT32U               timestamp);
+#endif
+
+#if (PROBE_COM_SUPPORT_STREAM == DEF_TRUE)
+CPU_INT16U   ProbeCom_StreamPeriodGet(void);                                /* Get stream period.                       */
+
+CPU_INT16U   ProbeCom_StreamSnapshot (void                    *ptx_pkt,     /* Fmt snapshot of streamed syms.           */
+                                      CPU_INT16U               tx_buf_sz,
+                                      CPU_INT32U               ts);
+#endif
+
+/*
+*********************************************************************************************************
+*                                            SYMBOL DIRECTORY
+*                                DEFINED IN APPLICATION's probe_com_sym.c
+*
+* Note(s) : (1) 'probe_com_sym.c' is generated at build time by 'probe_com_sym.py' from a list of the
+*               symbols to register, & is placed in flash.  The table is sorted by 'NameHash'.
+*********************************************************************************************************
+*/
+
+#if (PROBE_COM_SUPPORT_SYM == DEF_TRUE)
+extern  const  PROBE_COM_SYM  ProbeCom_SymTbl[];
+extern  const  CPU_INT16U     ProbeCom_SymTblNbr;
 #endif
 
+
+/*
+*********************************************************************************************************
+*                                             MEMORY REGIONS
+*                              DEFINED IN APPLICATION's probe_com_region.c
+*
+* Note(s) : (1) The region tbl describes the memory the host may read & write.  Its entries are sorted
+*               by 'Start' & must not overlap.  Memory not in any region may be neither read nor written.
+*
+*           (2) ProbeCom_PagedRd() reads memory in a region with PROBE_COM_REGION_PAGED set.  Such a
+*               region may not also have PROBE_COM_REGION_WR set.
+*********************************************************************************************************
+*/
+
+#if (PROBE_COM_SUPPORT_REGION == DEF_TRUE)
+extern  const  PROBE_COM_REGION  ProbeCom_RegionTbl[];
+extern  const  CPU_INT16U        ProbeCom_RegionTblNbr;
+
+void         ProbeCom_PagedRd    (void                       *pdest,
+                                  CPU_INT32U                  addr,
+                                  CPU_INT16U                  nbytes);
+#endif
+
+
 /*
 *********************************************************************************************************
 *                                         FUNCTION PROTOTYPES
@@ -264,6 +400,174 @@ void         ProbeCom_OS_Dly     (CPU_INT16U                  dly);
   #error  "PROBE_COM_SUPPORT_TELEMETRY  illegally #define'd in 'probe_com_cfg.h'               "
   #error  "                             [MUST be  DEF_TRUE   Telemetry commands     supported] "
   #error  "                             [     ||  DEF_FALSE  Telemetry commands NOT supported] "
+
+#elif     (PROBE_COM_SUPPORT_TELEMETRY == DEF_TRUE)
+
+#ifndef    PROBE_COM_TELEMETRY_NBR
+  #error  "PROBE_COM_TELEMETRY_NBR            not #define'd in 'probe_com_cfg.h'               "
+  #error  "                             [MUST be  >= 1 && <= 65534                           ] "
+
+#elif    ((PROBE_COM_TELEMETRY_NBR <     1) || \
+          (PROBE_COM_TELEMETRY_NBR > 65534))
+  #error  "PROBE_COM_TELEMETRY_NBR      illegally #define'd in 'probe_com_cfg.h'               "
+  #error  "                             [MUST be  >= 1 && <= 65534                           ] "
+#endif
+
+#ifndef    PROBE_COM_TELEMETRY_BUF_LEN
+  #error  "PROBE_COM_TELEMETRY_BUF_LEN        not #define'd in 'probe_com_cfg.h'               "
+  #error  "                             [MUST be  >= 1 && <= 65535                           ] "
+
+#elif    ((PROBE_COM_TELEMETRY_BUF_LEN <     1) || \
+          (PROBE_COM_TELEMETRY_BUF_LEN > 65535))
+  #error  "PROBE_COM_TELEMETRY_BUF_LEN  illegally #define'd in 'probe_com_cfg.h'               "
+  #error  "                             [MUST be  >= 1 && <= 65535                           ] "
+#endif
+
+#if      ((defined(PROBE_COM_ATOMIC_LD)  || \
+           defined(PROBE_COM_ATOMIC_ST)  || \
+           defined(PROBE_COM_ATOMIC_CAS))   && \
+         (!defined(PROBE_COM_ATOMIC_LD)  || \
+          !defined(PROBE_COM_ATOMIC_ST)  || \
+          !defined(PROBE_COM_ATOMIC_CAS)))
+  #error  "PROBE_COM_ATOMIC_LD/ST/CAS partly #define'd in 'probe_com_cfg.h'                    "
+  #error  "                             [MUST #define all three, or none                     ] "
+#endif
+
+#endif
+
+
+
+#ifndef    PROBE_COM_SUPPORT_STREAM
+  #error  "PROBE_COM_SUPPORT_STREAM           not #define'd in 'probe_com_cfg.h'               "
+  #error  "                             [MUST be  DEF_TRUE   Symbol streaming     supported]   "
+  #error  "                             [     ||  DEF_FALSE  Symbol streaming NOT supported]   "
+
+#elif    ((PROBE_COM_SUPPORT_STREAM != DEF_TRUE ) && \
+          (PROBE_COM_SUPPORT_STREAM != DEF_FALSE))
+  #error  "PROBE_COM_SUPPORT_STREAM     illegally #define'd in 'probe_com_cfg.h'               "
+  #error  "                             [MUST be  DEF_TRUE   Symbol streaming     supported]   "
+  #error  "                             [     ||  DEF_FALSE  Symbol streaming NOT supported]   "
+
+#elif     (PROBE_COM_SUPPORT_STREAM == DEF_TRUE)
+#ifndef    PROBE_COM_STREAM_SYM_NBR
+  #error  "PROBE_COM_STREAM_SYM_NBR           not #define'd in 'probe_com_cfg.h'               "
+  #error  "                             [MUST be  >= 1  ]                                      "
+  #error  "                             [     &&  <= 255]                                      "
+
+#elif    ((PROBE_COM_STREAM_SYM_NBR > 255) || \
+          (PROBE_COM_STREAM_SYM_NBR < 1  ))
+  #error  "PROBE_COM_STREAM_SYM_NBR     illegally #define'd in 'probe_com_cfg.h'               "
+  #error  "                             [MUST be  >= 1  ]                                      "
+  #error  "                             [     &&  <= 255]                                      "
+#endif
+#endif
+
+
+
+#ifndef    PROBE_COM_SUPPORT_DELTA
+  #error  "PROBE_COM_SUPPORT_DELTA            not #define'd in 'probe_com_cfg.h'               "
+  #error  "                             [MUST be  DEF_TRUE   Delta reads     supported]        "
+  #error  "                             [     ||  DEF_FALSE  Delta reads NOT supported]        "
+
+#elif    ((PROBE_COM_SUPPORT_DELTA != DEF_TRUE ) && \
+          (PROBE_COM_SUPPORT_DELTA != DEF_FALSE))
+  #error  "PROBE_COM_SUPPORT_DELTA      illegally #define'd in 'probe_com_cfg.h'               "
+  #error  "                             [MUST be  DEF_TRUE   Delta reads     supported]        "
+  #error  "                             [     ||  DEF_FALSE  Delta reads NOT supported]        "
+
+#elif     (PROBE_COM_SUPPORT_DELTA == DEF_TRUE)
+#ifndef    PROBE_COM_DELTA_KEY_PERIOD
+  #error  "PROBE_COM_DELTA_KEY_PERIOD         not #define'd in 'probe_com_cfg.h'               "
+  #error  "                             [MUST be  >= 1    ]                                    "
+  #error  "                             [     &&  <= 65535]                                    "
+
+#elif    ((PROBE_COM_DELTA_KEY_PERIOD > 65535) || \
+          (PROBE_COM_DELTA_KEY_PERIOD < 1    ))
+  #error  "PROBE_COM_DELTA_KEY_PERIOD   illegally #define'd in 'probe_com_cfg.h'               "
+  #error  "                             [MUST be  >= 1    ]                                    "
+  #error  "                             [     &&  <= 65535]                                    "
+#endif
+#endif
+
+
+
+#ifndef    PROBE_COM_SUPPORT_SG
+  #error  "PROBE_COM_SUPPORT_SG               not #define'd in 'probe_com_cfg.h'               "
+  #error  "                             [MUST be  DEF_TRUE   Scattered responses     supported]"
+  #error  "                             [     ||  DEF_FALSE  Scattered responses NOT supported]"
+
+#elif    ((PROBE_COM_SUPPORT_SG != DEF_TRUE ) && \
+          (PROBE_COM_SUPPORT_SG != DEF_FALSE))
+  #error  "PROBE_COM_SUPPORT_SG         illegally #define'd in 'probe_com_cfg.h'               "
+  #error  "                             [MUST be  DEF_TRUE   Scattered responses     supported]"
+  #error  "                             [     ||  DEF_FALSE  Scattered responses NOT supported]"
+
+#elif     (PROBE_COM_SUPPORT_SG == DEF_TRUE)
+#ifndef    PROBE_COM_SG_SEG_NBR
+  #error  "PROBE_COM_SG_SEG_NBR               not #define'd in 'probe_com_cfg.h'               "
+  #error  "                             [MUST be  >= 2  ]                                      "
+  #error  "                             [     &&  <= 255]                                      "
+
+#elif    ((PROBE_COM_SG_SEG_NBR > 255) || \
+          (PROBE_COM_SG_SEG_NBR < 2  ))
+  #error  "PROBE_COM_SG_SEG_NBR         illegally #define'd in 'probe_com_cfg.h'               "
+  #error  "                             [MUST be  >= 2  ]                                      "
+  #error  "                             [     &&  <= 255]                                      "
+#endif
+
+#ifndef    PROBE_COM_SG_MAX_SIZE
+  #error  "PROBE_COM_SG_MAX_SIZE              not #define'd in 'probe_com_cfg.h'               "
+  #error  "                             [MUST be  >= PROBE_COM_TX_MAX_SIZE]                    "
+  #error  "                             [     &&  <= 65535                ]                    "
+
+#elif    ((PROBE_COM_SG_MAX_SIZE > 65535                ) || \
+          (PROBE_COM_SG_MAX_SIZE < PROBE_COM_TX_MAX_SIZE))
+  #error  "PROBE_COM_SG_MAX_SIZE        illegally #define'd in 'probe_com_cfg.h'               "
+  #error  "                             [MUST be  >= PROBE_COM_TX_MAX_SIZE]                    "
+  #error  "                             [     &&  <= 65535                ]                    "
+#endif
+#endif
+
+
+
+#ifndef    PROBE_COM_SUPPORT_CRC16
+  #error  "PROBE_COM_SUPPORT_CRC16            not #define'd in 'probe_com_cfg.h'               "
+  #error  "                             [MUST be  DEF_TRUE   CRC-16 framing     supported]     "
+  #error  "                             [     ||  DEF_FALSE  CRC-16 framing NOT supported]     "
+
+#elif    ((PROBE_COM_SUPPORT_CRC16 != DEF_TRUE ) && \
+          (PROBE_COM_SUPPORT_CRC16 != DEF_FALSE))
+  #error  "PROBE_COM_SUPPORT_CRC16      illegally #define'd in 'probe_com_cfg.h'               "
+  #error  "                             [MUST be  DEF_TRUE   CRC-16 framing     supported]     "
+  #error  "                             [     ||  DEF_FALSE  CRC-16 framing NOT supported]     "
+#endif
+
+
+
+#ifndef    PROBE_COM_SUPPORT_SYM
+  #error  "PROBE_COM_SUPPORT_SYM              not #define'd in 'probe_com_cfg.h'               "
+  #error  "                             [MUST be  DEF_TRUE   Symbol directory     supported]   "
+  #error  "                             [     ||  DEF_FALSE  Symbol directory NOT supported]   "
+
+#elif    ((PROBE_COM_SUPPORT_SYM != DEF_TRUE ) && \
+          (PROBE_COM_SUPPORT_SYM != DEF_FALSE))
+  #error  "PROBE_COM_SUPPORT_SYM        illegally #define'd in 'probe_com_cfg.h'               "
+  #error  "                             [MUST be  DEF_TRUE   Symbol directory     supported]   "
+  #error  "                             [     ||  DEF_FALSE  Symbol directory NOT supported]   "
+#endif
+
+
+
+#ifndef    PROBE_COM_SUPPORT_REGION
+  #error  "PROBE_COM_SUPPORT_REGION           not #define'd in 'probe_com_cfg.h'               "
+  #error  "                             [MUST be  DEF_TRUE   Memory accesses     checked]      "
+  #error  "                             [     ||  DEF_FALSE  Memory accesses NOT checked]      "
+
+#elif    ((PROBE_COM_SUPPORT_REGION != DEF_TRUE ) && \
+          (PROBE_COM_SUPPORT_REGION != DEF_FALSE))
+  #error  "PROBE_COM_SUPPORT_REGION     illegally #define'd in 'probe_com_cfg.h'               "
+  #error  "                             [MUST be  DEF_TRUE   Memory accesses     checked]      "
+  #error  "                             [     ||  DEF_FALSE  Memory accesses NOT checked]      "
 #endif
 
 
@@ -0,0 +1,142 @@
+/*
+*********************************************************************************************************
+*                                      uC/Probe Communication
+*
+*                           (c) Copyright 2007; Micrium, Inc.; Weston, FL
+*
+*               All rights reserved.  Protected by international copyright laws.
+*               Knowledge of the source code may NOT be used to develop a similar product.
+*               Please help us continue to provide the Embedded community with the finest
+*               software available.  Your honesty is greatly appreciated.
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*
+*                                              uC/Probe
+*
+*                                      Communication: TCP-IP
+*
+* Filename      : probe_tcpip_os.c
+* Version       : V1.50
+* Programmer(s) : BAN
+* Note(s)       : (1) This file is the POSIX threads layer for the uC/Probe TCP-IP Communication Module,
+*                     for use with the POSIX socket port (see 'Ports/POSIX/probe_tcpipc.c').
+*
+*                 (2) PROBE_TCPIP_TASK_PRIO & PROBE_TCPIP_TASK_STK_SIZE are not used; the thread runs with
+*                     the default scheduling policy & stack size.
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*                                            INCLUDE FILES
+*********************************************************************************************************
+*/
+
+#include  <probe_com.h>
+#include  <probe_tcpip.h>
+
+#include  <pthread.h>
+#include  <time.h>
+
+#if (PROBE_COM_METHOD_TCPIP > 0)
+
+/*
+*********************************************************************************************************
+*                                       LOCAL GLOBAL VARIABLES
+*********************************************************************************************************
+*/
+
+static  pthread_t  ProbeTCPIP_OS_Thread;                                /* Probe TCP-IP thread                              */
+
+
+/*
+*********************************************************************************************************
+*                                      LOCAL FUNCTION PROTOTYPES
+*********************************************************************************************************
+*/
+
+static  void  *ProbeTCPIP_OS_Task(void *p_arg);                         /* Probe TCP-IP thread                              */
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+**                                          GLOBAL FUNCTIONS
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*                                         ProbeTCPIP_OS_Init()
+*
+* Description : Create the thread for TCP-IP communication.
+*
+* Argument(s) : none.
+*
+* Return(s)   : none.
+*********************************************************************************************************
+*/
+
+void  ProbeTCPIP_OS_Init (void)
+{
+    (void)pthread_create(&ProbeTCPIP_OS_Thread, (pthread_attr_t *)0, ProbeTCPIP_OS_Task, (void *)0);
+    (void)pthread_detach( ProbeTCPIP_OS_Thread);
+}
+
+
+/*
+*********************************************************************************************************
+*                                      ProbeTCPIP_OS_TimeGet()
+*
+* Description : Get the current time.
+*
+* Argument(s) : none.
+*
+* Return(s)   : The time from an arbitrary, fixed origin, in milliseconds.
+*********************************************************************************************************
+*/
+
+#if (PROBE_COM_SUPPORT_STREAM == DEF_TRUE)
+CPU_INT32U  ProbeTCPIP_OS_TimeGet (void)
+{
+    struct timespec  ts;
+
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ((CPU_INT32U)ts.tv_sec * 1000 + (CPU_INT32U)(ts.tv_nsec / 1000000));
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+**                                          LOCAL FUNCTIONS
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*                                         ProbeTCPIP_OS_Task()
+*
+* Description : Thread which waits for datagrams to be received, formulates responses, and transmits them.
+*
+* Argument(s) : p_arg        Argument passed to ProbeTCPIP_OS_Task() by 'pthread_create()'.
+*
+* Return(s)   : none.
+*********************************************************************************************************
+*/
+
+static  void  *ProbeTCPIP_OS_Task (void *p_arg)
+{
+    ProbeTCPIP_Task(p_arg);
+
+    return ((void *)0);
+}
+
+#endif
@@ -0,0 +1,213 @@
+/*
+*********************************************************************************************************
+*                                      uC/Probe Communication
+*
+*                           (c) Copyright 2007; Micrium, Inc.; Weston, FL
+*
+*               All rights reserved.  Protected by international copyright laws.
+*               Knowledge of the source code may NOT be used to develop a similar product.
+*               Please help us continue to provide the Embedded community with the finest
+*               software available.  Your honesty is greatly appreciated.
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*
+*                                              uC/Probe
+*
+*                                      Communication: TCP-IP
+*
+* Filename      : probe_tcpip_os.c
+* Version       : V1.50
+* Programmer(s) : BAN
+* Note(s)       : (1) This file is the uC/OS-II layer for the uC/Probe TCP-IP Communication Module.
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*                                            INCLUDE FILES
+*********************************************************************************************************
+*/
+
+#include  <probe_com.h>
+#include  <probe_tcpip.h>
+#include  <ucos_ii.h>
+
+#if (PROBE_COM_METHOD_TCPIP > 0)
+
+/*
+*********************************************************************************************************
+*                                            LOCAL DEFINES
+*********************************************************************************************************
+*/
+
+
+/*
+*********************************************************************************************************
+*                                           LOCAL CONSTANTS
+*********************************************************************************************************
+*/
+
+
+/*
+*********************************************************************************************************
+*                                          LOCAL DATA TYPES
+*********************************************************************************************************
+*/
+
+
+/*
+*********************************************************************************************************
+*                                            LOCAL TABLES
+*********************************************************************************************************
+*/
+
+
+/*
+*********************************************************************************************************
+*                                       LOCAL GLOBAL VARIABLES
+*********************************************************************************************************
+*/
+
+static  OS_STK     ProbeTCPIP_OS_TaskStk[PROBE_TCPIP_TASK_STK_SIZE];    /* Probe TCP-IP task stack                          */
+
+
+/*
+*********************************************************************************************************
+*                                      LOCAL FUNCTION PROTOTYPES
+*********************************************************************************************************
+*/
+
+static  void  ProbeTCPIP_OS_Task(void *p_arg);                          /* Probe TCP-IP task                                */
+
+
+/*
+*********************************************************************************************************
+*                                     LOCAL CONFIGURATION ERRORS
+*********************************************************************************************************
+*/
+
+#if (PROBE_COM_SUPPORT_STREAM == DEF_TRUE) && (OS_TIME_GET_SET_EN == 0)
+  #error  "If PROBE_COM_SUPPORT_STREAM is set to DEF_TRUE, then OSTimeGet() MUST be enabled."
+#endif
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+**                                          GLOBAL FUNCTIONS
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*                                         ProbeTCPIP_OS_Init()
+*
+* Description : Create the task for TCP-IP communication.
+*
+* Argument(s) : none.
+*
+* Return(s)   : none.
+*********************************************************************************************************
+*/
+
+void  ProbeTCPIP_OS_Init (void)
+{
+    CPU_INT08U  err;
+
+
+#if (OS_TASK_CREATE_EXT_EN > 0)
+    #if (OS_STK_GROWTH == 1)
+    err = OSTaskCreateExt( ProbeTCPIP_OS_Task,
+                           (void *)0,
+                          &ProbeTCPIP_OS_TaskStk[PROBE_TCPIP_TASK_STK_SIZE - 1],    /* Set Top-Of-Stack.                    */
+                           PROBE_TCPIP_TASK_PRIO,
+                           PROBE_TCPIP_TASK_PRIO,
+                          &ProbeTCPIP_OS_TaskStk[0],                                /* Set Bottom-Of-Stack.                 */
+                           PROBE_TCPIP_TASK_STK_SIZE,
+                           (void *)0,                                               /* No TCB extension.                    */
+                           OS_TASK_OPT_STK_CHK | OS_TASK_OPT_STK_CLR);              /* Enable stack checking + clear stack. */
+    #else
+    err = OSTaskCreateExt( ProbeTCPIP_OS_Task,
+                           (void *)0,
+                          &ProbeTCPIP_OS_TaskStk[0],                                /* Set Top-Of-Stack.                    */
+                           PROBE_TCPIP_TASK_PRIO,
+                           PROBE_TCPIP_TASK_PRIO,
+                          &ProbeTCPIP_OS_TaskStk[PROBE_TCPIP_TASK_STK_SIZE - 1],    /* Set Bottom-Of-Stack.                 */
+                           PROBE_TCPIP_TASK_STK_SIZE,
+                           (void *)0,                                               /* No TCB extension.                    */
+                           OS_TASK_OPT_STK_CHK | OS_TASK_OPT_STK_CLR);              /* Enable stack checking + clear stack. */
+    #endif
+#else
+    #if (OS_STK_GROWTH == 1)
+    err = OSTaskCreate( ProbeTCPIP_OS_Task,
+                        (void *)0,
+                       &ProbeTCPIP_OS_TaskStk[PROBE_TCPIP_TASK_STK_SIZE - 1],
+                        PROBE_TCPIP_TASK_PRIO);
+    #else
+    err = OSTaskCreate( ProbeTCPIP_OS_Task,
+                        (void *)0,
+                       &ProbeTCPIP_OS_TaskStk[0],
+                        PROBE_TCPIP_TASK_PRIO);
+    #endif
+#endif
+
+#if   (OS_TASK_NAME_SIZE > 13)
+    OSTaskNameSet(PROBE_TCPIP_TASK_PRIO, (CPU_INT08U *)"Probe TCP-IP", &err);
+#endif
+}
+
+
+/*
+*********************************************************************************************************
+*                                      ProbeTCPIP_OS_TimeGet()
+*
+* Description : Get the current time.
+*
+* Argument(s) : none.
+*
+* Return(s)   : The time since the OS started, in milliseconds.
+*********************************************************************************************************
+*/
+
+#if (PROBE_COM_SUPPORT_STREAM == DEF_TRUE)
+CPU_INT32U  ProbeTCPIP_OS_TimeGet (void)
+{
+    CPU_INT32U  ticks;
+
+
+    ticks = OSTimeGet();
+    return ((ticks / OS_TICKS_PER_SEC) * 1000 + ((ticks % OS_TICKS_PER_SEC) * 1000) / OS_TICKS_PER_SEC);
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+**                                          LOCAL FUNCTIONS
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*                                         ProbeTCPIP_OS_Task()
+*
+* Description : Task which waits for datagrams to be received, formulates responses, and transmits them.
+*
+* Argument(s) : p_arg        Argument passed to ProbeTCPIP_OS_Task() by 'OSTaskCreate()'.
+*
+* Return(s)   : none.
+*********************************************************************************************************
+*/
+
+static  void  ProbeTCPIP_OS_Task (void *p_arg)
+{
+    ProbeTCPIP_Task(p_arg);
+}
+
+#endif
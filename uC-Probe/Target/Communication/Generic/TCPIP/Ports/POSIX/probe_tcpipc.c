@@ -0,0 +1,202 @@
+/*
+*********************************************************************************************************
+*                                      uC/Probe Communication
+*
+*                           (c) Copyright 2007; Micrium, Inc.; Weston, FL
+*
+*               All rights reserved.  Protected by international copyright laws.
+*               Knowledge of the source code may NOT be used to develop a similar product.
+*               Please help us continue to provide the Embedded community with the finest
+*               software available.  Your honesty is greatly appreciated.
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*
+*                                              uC/Probe
+*
+*                                      Communication: TCP-IP
+*                                     Port for POSIX BSD sockets
+*
+* Filename      : probe_tcpipc.c
+* Version       : V1.00
+* Programmer(s) : BAN
+* Note(s)       : (1) This port runs the uC/Probe TCP-IP module on a host (Linux, BSD, Mac OS X) over a
+*                     UDP socket, so the target side of uC/Probe can be exercised & benchmarked without
+*                     hardware.
+*
+*                 (2) The socket is bound to every local IPv4 address.
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*                                            INCLUDE FILES
+*********************************************************************************************************
+*/
+
+#include  <probe_com.h>
+#include  <probe_tcpip.h>
+
+#include  <sys/types.h>
+#include  <sys/socket.h>
+#include  <sys/uio.h>
+#include  <netinet/in.h>
+#include  <poll.h>
+#include  <string.h>
+#include  <unistd.h>
+
+#if (PROBE_COM_METHOD_TCPIP == DEF_ENABLED)
+
+/*
+*********************************************************************************************************
+*                                       LOCAL GLOBAL VARIABLES
+*********************************************************************************************************
+*/
+
+static  int                 ProbeTCPIP_Sock = -1;               /* UDP socket.                                          */
+static  struct sockaddr_in  ProbeTCPIP_PeerAddr;                /* Sender of the last datagram.                         */
+static  socklen_t           ProbeTCPIP_PeerAddrLen;
+
+
+/*
+*********************************************************************************************************
+*                                       ProbeTCPIP_InitTarget()
+*
+* Description : Open the UDP socket & bind it to the uC/Probe port.
+*
+* Argument(s) : port            The UDP port on which to receive requests.
+*
+* Return(s)   : DEF_OK,   if the socket was opened & bound.
+*               DEF_FAIL, otherwise.
+*
+* Caller(s)   : ProbeTCPIP_Init().
+*
+* Note(s)     : none.
+*********************************************************************************************************
+*/
+
+CPU_BOOLEAN  ProbeTCPIP_InitTarget (CPU_INT16U  port)
+{
+    struct sockaddr_in  addr;
+    int                 opt;
+    int                 err;
+
+
+    ProbeTCPIP_Sock = socket(AF_INET, SOCK_DGRAM, 0);
+    if (ProbeTCPIP_Sock < 0) {
+        return (DEF_FAIL);
+    }
+
+    opt = 1;                                                    /* Allow an immediate restart on the same port.         */
+    (void)setsockopt(ProbeTCPIP_Sock, SOL_SOCKET, SO_REUSEADDR, &opt, sizeof(opt));
+
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family      = AF_INET;
+    addr.sin_port        = htons(port);
+    addr.sin_addr.s_addr = htonl(INADDR_ANY);                   /* See Note #2.                                         */
+
+    err = bind(ProbeTCPIP_Sock, (struct sockaddr *)&addr, sizeof(addr));
+    if (err != 0) {
+        close(ProbeTCPIP_Sock);
+        ProbeTCPIP_Sock = -1;
+        return (DEF_FAIL);
+    }
+
+    ProbeTCPIP_PeerAddrLen = 0;
+
+    return (DEF_OK);
+}
+
+
+/*
+*********************************************************************************************************
+*                                         ProbeTCPIP_RxPkt()
+*
+* Description : Wait for a datagram & receive it.
+*
+* Argument(s) : prx_buf         Pointer to the buffer which will receive the datagram.
+*
+*               rx_buf_size     Size of the buffer.
+*
+*               tmo             Timeout, in milliseconds.  If this value is zero, then the function waits
+*                               forever.
+*
+* Return(s)   : The length of the datagram, or 0 if the timeout expired or the datagram did not fit.
+*
+* Caller(s)   : ProbeTCPIP_Task().
+*
+* Note(s)     : (1) The sender is remembered, so the response & later snapshots are sent back to it.
+*********************************************************************************************************
+*/
+
+CPU_INT16U  ProbeTCPIP_RxPkt (void        *prx_buf,
+                              CPU_INT16U   rx_buf_size,
+                              CPU_INT16U   tmo)
+{
+    struct pollfd       pfd;
+    struct sockaddr_in  addr;
+    struct iovec        iov;
+    struct msghdr       msg;
+    ssize_t             len;
+    int                 nbr;
+
+
+    pfd.fd     = ProbeTCPIP_Sock;
+    pfd.events = POLLIN;
+    nbr        = poll(&pfd, 1, (tmo == 0) ? -1 : (int)tmo);
+    if (nbr <= 0) {                                             /* Timeout or signal.                                   */
+        return (0);
+    }
+
+    iov.iov_base = prx_buf;
+    iov.iov_len  = rx_buf_size;
+    memset(&msg, 0, sizeof(msg));
+    msg.msg_name    = &addr;
+    msg.msg_namelen = sizeof(addr);
+    msg.msg_iov     = &iov;
+    msg.msg_iovlen  = 1;
+
+    len = recvmsg(ProbeTCPIP_Sock, &msg, 0);
+    if ((len <= 0) || ((msg.msg_flags & MSG_TRUNC) != 0)) {     /* Datagram larger than buf ... drop it.                */
+        return (0);
+    }
+
+    ProbeTCPIP_PeerAddr    = addr;                              /* See Note #1.                                         */
+    ProbeTCPIP_PeerAddrLen = msg.msg_namelen;
+
+    return ((CPU_INT16U)len);
+}
+
+
+/*
+*********************************************************************************************************
+*                                         ProbeTCPIP_TxPkt()
+*
+* Description : Send a datagram to the sender of the last datagram received.
+*
+* Argument(s) : ptx_buf         Pointer to the datagram.
+*
+*               tx_len          Length of the datagram.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : ProbeTCPIP_TxStart().
+*
+* Note(s)     : none.
+*********************************************************************************************************
+*/
+
+void  ProbeTCPIP_TxPkt (void        *ptx_buf,
+                        CPU_INT16U   tx_len)
+{
+    if (ProbeTCPIP_PeerAddrLen == 0) {                          /* No host has contacted us yet.                        */
+        return;
+    }
+
+    (void)sendto(ProbeTCPIP_Sock, ptx_buf, tx_len, 0, (struct sockaddr *)&ProbeTCPIP_PeerAddr, ProbeTCPIP_PeerAddrLen);
+}
+
+
+#endif
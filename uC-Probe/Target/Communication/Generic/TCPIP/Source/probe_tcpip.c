@@ -0,0 +1,431 @@
+/*
+*********************************************************************************************************
+*                                         uC/Probe Communication
+*
+*                           (c) Copyright 2007; Micrium, Inc.; Weston, FL
+*
+*               All rights reserved.  Protected by international copyright laws.
+*               Knowledge of the source code may NOT be used to develop a similar product.
+*               Please help us continue to provide the Embedded community with the finest
+*               software available.  Your honesty is greatly appreciated.
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*
+*                                                uC/Probe
+*
+*                                          Communication: TCP-IP
+*
+* Filename      : probe_tcpip.c
+* Version       : V1.50
+* Programmer(s) : BAN
+* Note(s)       : (1) The abbreviations RX and TX refer to communication from the target's perspective.
+*
+*                 (2) The abbreviations RD and WR refer to reading data from the target memory and
+*                     writing data to the target memory, respectively.
+*
+*                 (3) The socket itself is handled by the port (probe_tcpipc.c), which may be a target
+*                     TCP/IP stack or, for a host build, BSD sockets.  This file only frames packets.
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*                                              INCLUDE FILES
+*********************************************************************************************************
+*/
+
+#define   PROBE_TCPIP_MODULE
+#include  <probe_com.h>
+#include  <probe_tcpip.h>
+
+#if (PROBE_COM_METHOD_TCPIP == DEF_ENABLED)
+
+/*
+*********************************************************************************************************
+*                                              LOCAL DEFINES
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*                                          TCP-IP PACKET FORMAT
+*
+* Note(s):  (1) Each UDP datagram carries exactly one packet, which includes the following parts:
+*
+*                   (A)  4 1-byte start delimiters, forming the ASCII representation of "uCPr".  These
+*                        are the constants PROBE_TCPIP_PROTOCOL_RX_SD0-PROBE_TCPIP_PROTOCOL_?X_SD4;
+*                   (B)  1 2-byte length, the length of the data segment;
+*                   (C)  1 2-byte padding, unused; and
+*                   (D)  n   bytes of data.
+*
+*                                       +-------------------+-------------------+
+*                                       |   'u'   |   'C'   |   'P'   |   'r'   |
+*                                       +-------------------+-------------------+
+*                                       |       Length      |     Padding       |
+*                                       +-------------------+-------------------+
+*                                       |                  Data                 |   The data segment does not need to end on
+*                                       |                   .                   |   a four-byte boundary, as might be inferred
+*                                       |                   .                   |   from this diagram.
+*                                       |                   .                   |
+*                                       +-------------------+-------------------+
+*
+*               The header is the RS-232 header, but there is no checksum & no end delimiter:  the
+*               datagram boundary ends the packet & the UDP checksum covers it.  A datagram whose
+*               length does not equal the header length plus the packet length is dropped.
+*
+*           (2) The response to a request is sent to the address & port the request came from.
+*               Snapshots are sent to the sender of the last datagram received.
+*********************************************************************************************************
+*/
+
+                                                                /* ------------- INBOUND PACKET DELIMITERS ------------ */
+#define  PROBE_TCPIP_PROTOCOL_RX_SD0                    0x75    /* Start delimiters.                                    */
+#define  PROBE_TCPIP_PROTOCOL_RX_SD1                    0x43
+#define  PROBE_TCPIP_PROTOCOL_RX_SD2                    0x50
+#define  PROBE_TCPIP_PROTOCOL_RX_SD3                    0x72
+
+                                                                /* ------------ OUTBOUND PACKET DELIMITERS ------------ */
+#define  PROBE_TCPIP_PROTOCOL_TX_SD0                    0x75    /* Start delimiters.                                    */
+#define  PROBE_TCPIP_PROTOCOL_TX_SD1                    0x43
+#define  PROBE_TCPIP_PROTOCOL_TX_SD2                    0x50
+#define  PROBE_TCPIP_PROTOCOL_TX_SD3                    0x72
+
+#define  PROBE_TCPIP_HDR_SIZE                              8    /* Start delims (4), len (2) & padding (2).             */
+
+
+/*
+*********************************************************************************************************
+*                                             LOCAL CONSTANTS
+*********************************************************************************************************
+*/
+
+
+/*
+*********************************************************************************************************
+*                                            LOCAL DATA TYPES
+*********************************************************************************************************
+*/
+
+
+/*
+*********************************************************************************************************
+*                                              LOCAL TABLES
+*********************************************************************************************************
+*/
+
+
+/*
+*********************************************************************************************************
+*                                         LOCAL GLOBAL VARIABLES
+*********************************************************************************************************
+*/
+
+                                                                /* Rx'd datagram, hdr included.                         */
+static  CPU_INT08U   ProbeTCPIP_RxBuf[PROBE_TCPIP_HDR_SIZE + PROBE_TCPIP_RX_BUF_SIZE];
+                                                                /* Datagram to tx, hdr included.                        */
+static  CPU_INT08U   ProbeTCPIP_TxBuf[PROBE_TCPIP_HDR_SIZE + PROBE_TCPIP_TX_BUF_SIZE];
+
+#if (PROBE_COM_SUPPORT_STREAM == DEF_TRUE)
+static  CPU_BOOLEAN  ProbeTCPIP_StreamActive;                   /* Indicates snapshots are being scheduled.             */
+static  CPU_INT32U   ProbeTCPIP_StreamNextTS;                   /* Time at which next snapshot is due, in ms.           */
+static  CPU_BOOLEAN  ProbeTCPIP_PeerValid;                      /* Indicates a req has been rx'd from some host.        */
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                        LOCAL FUNCTION PROTOTYPES
+*********************************************************************************************************
+*/
+
+static  CPU_INT16U  ProbeTCPIP_RxChk   (CPU_INT16U  rx_len);
+
+static  void        ProbeTCPIP_TxStart (CPU_INT16U  len);
+
+#if (PROBE_COM_SUPPORT_STREAM == DEF_TRUE)
+static  CPU_INT16U  ProbeTCPIP_StreamTx(void);
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                       LOCAL CONFIGURATION ERRORS
+*********************************************************************************************************
+*/
+
+
+/*
+*********************************************************************************************************
+*                                            ProbeTCPIP_Init()
+*
+* Description : Initialize the TCP-IP communication module.
+*
+* Argument(s) : none.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : Application.
+*
+* Note(s)     : (1) If the socket cannot be opened, the task is not created & uC/Probe is unavailable over
+*                   TCP-IP.
+*********************************************************************************************************
+*/
+
+void  ProbeTCPIP_Init (void)
+{
+    CPU_BOOLEAN  ok;
+
+
+    ProbeTCPIP_TxBuf[0] = PROBE_TCPIP_PROTOCOL_TX_SD0;          /* Pre-serialize the constant part of the TX hdr.       */
+    ProbeTCPIP_TxBuf[1] = PROBE_TCPIP_PROTOCOL_TX_SD1;
+    ProbeTCPIP_TxBuf[2] = PROBE_TCPIP_PROTOCOL_TX_SD2;
+    ProbeTCPIP_TxBuf[3] = PROBE_TCPIP_PROTOCOL_TX_SD3;
+    ProbeTCPIP_TxBuf[6] = 0;
+    ProbeTCPIP_TxBuf[7] = 0;
+
+#if (PROBE_COM_SUPPORT_STREAM == DEF_TRUE)
+    ProbeTCPIP_StreamActive  = DEF_FALSE;
+    ProbeTCPIP_PeerValid     = DEF_FALSE;
+#endif
+
+#if (PROBE_COM_STAT_EN     == DEF_ENABLED)
+    ProbeTCPIP_RxCtr         = 0;
+    ProbeTCPIP_TxCtr         = 0;
+    ProbeTCPIP_RxDropCtr     = 0;
+#if (PROBE_COM_SUPPORT_STREAM == DEF_TRUE)
+    ProbeTCPIP_StreamSkipCtr = 0;
+#endif
+#endif
+
+    ok = ProbeTCPIP_InitTarget(PROBE_TCPIP_PORT);               /* Open socket (see Note #1).                           */
+    if (ok == DEF_OK) {
+        ProbeTCPIP_OS_Init();
+    }
+}
+
+
+/*
+*********************************************************************************************************
+*                                            ProbeTCPIP_Task()
+*
+* Description : The task which receives a datagram, parses the packet, forms a response, and transmits it.
+*
+* Argument(s) : p_arg           The argument passed to 'ProbeTCPIP_Task()' by  'ProbeTCPIP_OS_Task()'.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : ProbeTCPIP_OS_Task().
+*
+* Note(s)     : (1) While a stream is running, the task wakes up when the next snapshot is due as well as
+*                   when a datagram is received.  See 'ProbeTCPIP_StreamTx()'.
+*
+*               (2) The request & response are parsed & formed in place, after the header, so no data is
+*                   copied between the socket & ProbeCom_ParseRxPkt().
+*********************************************************************************************************
+*/
+
+void  ProbeTCPIP_Task (void *p_arg)
+{
+    CPU_INT16U  rx_len;
+    CPU_INT16U  tx_len;
+    CPU_INT16U  tmo;
+
+
+    (void)p_arg;
+
+    while (DEF_TRUE) {
+#if (PROBE_COM_SUPPORT_STREAM == DEF_TRUE)
+        tmo    = ProbeTCPIP_StreamTx();                         /* Tx snapshot if due (see Note #1).                    */
+#else
+        tmo    = 0;
+#endif
+        rx_len = ProbeTCPIP_RxPkt((void     *)&ProbeTCPIP_RxBuf[0],
+                                  (CPU_INT16U)sizeof(ProbeTCPIP_RxBuf),
+                                  (CPU_INT16U)tmo);
+
+        rx_len = ProbeTCPIP_RxChk(rx_len);                      /* Validate framing.                                    */
+        if (rx_len > 0) {
+#if (PROBE_COM_SUPPORT_STREAM == DEF_TRUE)
+            ProbeTCPIP_PeerValid = DEF_TRUE;
+#endif
+                                                                /* See Note #2.                                         */
+            tx_len = ProbeCom_ParseRxPkt((void     *)&ProbeTCPIP_RxBuf[PROBE_TCPIP_HDR_SIZE],
+                                         (void     *)&ProbeTCPIP_TxBuf[PROBE_TCPIP_HDR_SIZE],
+                                         (CPU_INT16U)rx_len,
+                                         (CPU_INT16U)PROBE_TCPIP_TX_BUF_SIZE);
+
+            if (tx_len > 0) {                                   /* If we have a response.                               */
+                ProbeTCPIP_TxStart(tx_len);
+            }
+        }
+    }
+}
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                             LOCAL FUNCTIONS
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*                                           ProbeTCPIP_RxChk()
+*
+* Description : Validate the framing of a received datagram.
+*
+* Argument(s) : rx_len          Length of the datagram, in bytes, or 0 if none was received.
+*
+* Return(s)   : The length of the packet's data segment, or 0 if the datagram must be dropped.
+*
+* Caller(s)   : ProbeTCPIP_Task().
+*
+* Note(s)     : (1) See 'TCP-IP PACKET FORMAT  Note #1'.
+*********************************************************************************************************
+*/
+
+static  CPU_INT16U  ProbeTCPIP_RxChk (CPU_INT16U  rx_len)
+{
+    CPU_INT16U  len;
+
+
+    if (rx_len == 0) {                                          /* Timeout, or datagram larger than buf.                */
+        return (0);
+    }
+
+#if (PROBE_COM_STAT_EN == DEF_ENABLED)
+    ProbeTCPIP_RxCtr += rx_len;
+#endif
+
+    if (rx_len < PROBE_TCPIP_HDR_SIZE) {
+#if (PROBE_COM_STAT_EN == DEF_ENABLED)
+        ProbeTCPIP_RxDropCtr++;
+#endif
+        return (0);
+    }
+
+    len = ((CPU_INT16U)ProbeTCPIP_RxBuf[5] << 8) | ProbeTCPIP_RxBuf[4];
+
+    if ((ProbeTCPIP_RxBuf[0] != PROBE_TCPIP_PROTOCOL_RX_SD0) ||
+        (ProbeTCPIP_RxBuf[1] != PROBE_TCPIP_PROTOCOL_RX_SD1) ||
+        (ProbeTCPIP_RxBuf[2] != PROBE_TCPIP_PROTOCOL_RX_SD2) ||
+        (ProbeTCPIP_RxBuf[3] != PROBE_TCPIP_PROTOCOL_RX_SD3) ||
+        (len                 == 0)                           ||
+        (len != rx_len - PROBE_TCPIP_HDR_SIZE)) {               /* See Note #1.                                         */
+#if (PROBE_COM_STAT_EN == DEF_ENABLED)
+        ProbeTCPIP_RxDropCtr++;
+#endif
+        return (0);
+    }
+
+    return (len);
+}
+
+
+/*
+*********************************************************************************************************
+*                                          ProbeTCPIP_TxStart()
+*
+* Description : Complete the header of the packet in the transmit buffer & send the datagram.
+*
+* Argument(s) : len             Length of the data segment.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : ProbeTCPIP_Task(),
+*               ProbeTCPIP_StreamTx().
+*
+* Note(s)     : none.
+*********************************************************************************************************
+*/
+
+static  void  ProbeTCPIP_TxStart (CPU_INT16U  len)
+{
+    ProbeTCPIP_TxBuf[4] = (CPU_INT08U)(len & 0xFF);
+    ProbeTCPIP_TxBuf[5] = (CPU_INT08U)(len >> 8);
+
+    ProbeTCPIP_TxPkt((void     *)&ProbeTCPIP_TxBuf[0],
+                     (CPU_INT16U)(len + PROBE_TCPIP_HDR_SIZE));
+
+#if (PROBE_COM_STAT_EN == DEF_ENABLED)
+    ProbeTCPIP_TxCtr += len + PROBE_TCPIP_HDR_SIZE;
+#endif
+}
+
+
+/*
+*********************************************************************************************************
+*                                          ProbeTCPIP_StreamTx()
+*
+* Description : Transmit a snapshot of the streamed symbols if one is due.
+*
+* Argument(s) : none.
+*
+* Return(s)   : The number of milliseconds until the next snapshot is due, or 0 if the stream is stopped.
+*
+* Caller(s)   : ProbeTCPIP_Task().
+*
+* Note(s)     : (1) Snapshots are scheduled against an absolute due time, so the stream rate does not
+*                   drift with the time spent parsing & transmitting.  The first snapshot of a new
+*                   stream is due immediately.
+*
+*               (2) If a whole period has already passed by the time the snapshot is sent, the missed
+*                   periods are skipped rather than sent back to back, & the schedule restarts from now.
+*********************************************************************************************************
+*/
+
+#if (PROBE_COM_SUPPORT_STREAM == DEF_TRUE)
+static  CPU_INT16U  ProbeTCPIP_StreamTx (void)
+{
+    CPU_INT16U  period;
+    CPU_INT16U  len;
+    CPU_INT32U  ts;
+    CPU_INT32S  remain;
+
+
+    period = ProbeCom_StreamPeriodGet();
+    if ((period               == 0) ||                          /* If stream stopped ... wait only for rx'd pkts.       */
+        (ProbeTCPIP_PeerValid == DEF_FALSE)) {
+        ProbeTCPIP_StreamActive = DEF_FALSE;
+        return (0);
+    }
+
+    ts = ProbeTCPIP_OS_TimeGet();
+    if (ProbeTCPIP_StreamActive == DEF_FALSE) {                 /* See Note #1.                                         */
+        ProbeTCPIP_StreamActive = DEF_TRUE;
+        ProbeTCPIP_StreamNextTS = ts;
+    }
+
+    remain = (CPU_INT32S)(ProbeTCPIP_StreamNextTS - ts);
+    if (remain > 0) {                                           /* If snapshot not yet due ... rtn time until due.      */
+        return ((CPU_INT16U)remain);
+    }
+
+    len = ProbeCom_StreamSnapshot((void     *)&ProbeTCPIP_TxBuf[PROBE_TCPIP_HDR_SIZE],
+                                  (CPU_INT16U)PROBE_TCPIP_TX_BUF_SIZE,
+                                  (CPU_INT32U)ts);
+    if (len > 0) {
+        ProbeTCPIP_TxStart(len);
+    }
+
+    ProbeTCPIP_StreamNextTS += period;
+    remain                   = (CPU_INT32S)(ProbeTCPIP_StreamNextTS - ts);
+    if (remain <= 0) {                                          /* See Note #2.                                         */
+#if (PROBE_COM_STAT_EN == DEF_ENABLED)
+        ProbeTCPIP_StreamSkipCtr += (CPU_INT32U)(-remain) / period + 1;
+#endif
+        ProbeTCPIP_StreamNextTS   = ts + period;
+        remain                    = period;
+    }
+
+    return ((CPU_INT16U)remain);
+}
+#endif
+
+
+#endif
@@ -0,0 +1,191 @@
+/*
+*********************************************************************************************************
+*                                         uC/Probe Communication
+*
+*                           (c) Copyright 2007; Micrium, Inc.; Weston, FL
+*
+*               All rights reserved.  Protected by international copyright laws.
+*               Knowledge of the source code may NOT be used to develop a similar product.
+*               Please help us continue to provide the Embedded community with the finest
+*               software available.  Your honesty is greatly appreciated.
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*
+*                                                uC/Probe
+*
+*                                          Communication: TCP-IP
+*
+* Filename      : probe_tcpip.h
+* Version       : V1.50
+* Programmer(s) : BAN
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*                                                 MODULE
+*
+* Note(s) : (1) This header file is protected from multiple pre-processor inclusion through use of the
+*               PROBE_TCPIP present pre-processor macro definition.
+*********************************************************************************************************
+*/
+
+#ifndef  PROBE_TCPIP_PRESENT                                    /* See Note #1.                                         */
+#define  PROBE_TCPIP_PRESENT
+
+
+/*
+*********************************************************************************************************
+*                                                 EXTERNS
+*********************************************************************************************************
+*/
+
+#ifdef    PROBE_TCPIP_MODULE
+#define   PROBE_TCPIP_EXT
+#else
+#define   PROBE_TCPIP_EXT  extern
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                              INCLUDE FILES
+*********************************************************************************************************
+*/
+
+#include  <probe_com.h>
+
+
+#if (PROBE_COM_METHOD_TCPIP == DEF_ENABLED)
+
+/*
+*********************************************************************************************************
+*                                                 DEFINES
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*                                            GLOBAL VARIABLES
+*********************************************************************************************************
+*/
+
+#if (PROBE_COM_STAT_EN == DEF_ENABLED)
+                                                                    /* ---------------- Byte counters --------------------- */
+PROBE_TCPIP_EXT  CPU_INT32U  ProbeTCPIP_RxCtr;                      /*  ... Number of bytes received                        */
+PROBE_TCPIP_EXT  CPU_INT32U  ProbeTCPIP_TxCtr;                      /*  ... Number of bytes transmitted                     */
+PROBE_TCPIP_EXT  CPU_INT32U  ProbeTCPIP_RxDropCtr;                  /*  ... Number of datagrams dropped, bad framing        */
+
+#if (PROBE_COM_SUPPORT_STREAM == DEF_TRUE)
+PROBE_TCPIP_EXT  CPU_INT32U  ProbeTCPIP_StreamSkipCtr;              /*  ... Number of stream periods skipped                */
+#endif
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                                 MACRO'S
+*********************************************************************************************************
+*/
+
+
+/*
+*********************************************************************************************************
+*                                           FUNCTION PROTOTYPES
+*********************************************************************************************************
+*/
+
+void         ProbeTCPIP_Init       (void);                          /* Initialize uC/Probe TCP-IP Communication Module      */
+void         ProbeTCPIP_Task       (void        *p_arg);
+
+
+/*
+*********************************************************************************************************
+*                                           FUNCTION PROTOTYPES
+*                                    DEFINED IN PORT's probe_tcpipc.c
+*********************************************************************************************************
+*/
+
+CPU_BOOLEAN  ProbeTCPIP_InitTarget (CPU_INT16U   port);             /* Open & bind the UDP socket                           */
+
+CPU_INT16U   ProbeTCPIP_RxPkt      (void        *prx_buf,           /* Rx one datagram & remember its sender                */
+                                    CPU_INT16U   rx_buf_size,
+                                    CPU_INT16U   tmo);
+
+void         ProbeTCPIP_TxPkt      (void        *ptx_buf,           /* Tx one datagram to the last sender                   */
+                                    CPU_INT16U   tx_len);
+
+
+/*
+*********************************************************************************************************
+*                                           FUNCTION PROTOTYPES
+*                                    DEFINED IN OS's probe_tcpip_os.c
+*********************************************************************************************************
+*/
+
+void         ProbeTCPIP_OS_Init    (void);
+
+#if (PROBE_COM_SUPPORT_STREAM == DEF_TRUE)
+CPU_INT32U   ProbeTCPIP_OS_TimeGet (void);
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                          CONFIGURATION ERRORS
+*********************************************************************************************************
+*/
+
+#ifndef    PROBE_TCPIP_PORT
+  #error  "PROBE_TCPIP_PORT                  not #define'd in 'probe_com_cfg.h'     "
+  #error  "                           [MUST be  >= 1 && <= 65535                   ]"
+
+#elif    ((PROBE_TCPIP_PORT <     1) || \
+          (PROBE_TCPIP_PORT > 65535))
+  #error  "PROBE_TCPIP_PORT            illegally #define'd in 'probe_com_cfg.h'     "
+  #error  "                           [MUST be  >= 1 && <= 65535                   ]"
+#endif
+
+
+
+#ifndef    PROBE_TCPIP_RX_BUF_SIZE
+  #error  "PROBE_TCPIP_RX_BUF_SIZE           not #define'd in 'probe_com_cfg.h'     "
+#endif
+
+
+
+#ifndef    PROBE_TCPIP_TX_BUF_SIZE
+  #error  "PROBE_TCPIP_TX_BUF_SIZE           not #define'd in 'probe_com_cfg.h'     "
+  #error  "                           [MUST be  <= 65527                           ]"
+
+#elif     (PROBE_TCPIP_TX_BUF_SIZE > 65527)
+  #error  "PROBE_TCPIP_TX_BUF_SIZE     illegally #define'd in 'probe_com_cfg.h'     "
+  #error  "                           [MUST be  <= 65527                           ]"
+#endif
+
+
+
+#ifndef    PROBE_TCPIP_TASK_PRIO
+  #error  "PROBE_TCPIP_TASK_PRIO             not #define'd in 'probe_com_cfg.h'     "
+#endif
+
+#ifndef    PROBE_TCPIP_TASK_STK_SIZE
+  #error  "PROBE_TCPIP_TASK_STK_SIZE         not #define'd in 'probe_com_cfg.h'     "
+#endif
+
+
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                              MODULE END
+*
+* Note(s) : See 'MODULE  Note #1'.
+*********************************************************************************************************
+*/
+
+#endif                                                          /* End of PROBE_COM_TCPIP module include (see Note #1). */
@@ -0,0 +1,166 @@
+#!/usr/bin/env python
+#
+#*********************************************************************************************************
+#                                      uC/Probe Communication
+#
+#                           (c) Copyright 2007; Micrium, Inc.; Weston, FL
+#
+#               All rights reserved.  Protected by international copyright laws.
+#               Knowledge of the source code may NOT be used to develop a similar product.
+#               Please help us continue to provide the Embedded community with the finest
+#               software available.  Your honesty is greatly appreciated.
+#*********************************************************************************************************
+#
+#*********************************************************************************************************
+#
+#                                              uC/Probe
+#
+#                                 Communication: Symbol Directory Generator
+#
+# Filename      : probe_com_sym.py
+# Version       : V1.50
+# Programmer(s) : BAN
+# Note(s)       : (1) This script generates 'probe_com_sym.c', the symbol directory queried with the
+#                     PROBE_COM_FMT_RX_SYM_LOOKUP request (see 'probe_com.c  ProbeCom_CmdSymLookup()').
+#                     Run it as a pre-build step, or whenever the symbol list changes:
+#
+#                         python probe_com_sym.py probe_com_sym.lst probe_com_sym.c
+#
+#                 (2) The symbol list holds one symbol per line:
+#
+#                         <name>   <type>
+#
+#                     where <name> is a C lvalue without white space (e.g., 'OSCPUUsage' or
+#                     'AppData.Speed') & <type> is one of the PROBE_COM_SYM_TYPE_??? suffixes (e.g.,
+#                     'INT16U').  Each symbol must be declared in a header the list includes.  Lines
+#                     beginning with '#include' are copied to the output; other lines beginning with '#'
+#                     are comments.
+#
+#                 (3) Addresses & sizes are filled in by the compiler & linker (from '&<name>' and
+#                     'sizeof(<name>)'), so the directory always matches the firmware it is built into.
+#                     The table is 'const'; with CodeWarrior for the HC(S)12, compile 'probe_com_sym.c'
+#                     with -Cc so it is allocated in ROM_VAR (flash) rather than copied down to RAM.
+#
+#                 (4) The name hash is the 32-bit FNV-1a hash of the characters of <name>.  A host finds
+#                     a symbol by hashing its name the same way:
+#
+#                         python probe_com_sym.py --hash OSCPUUsage
+#*********************************************************************************************************
+
+import sys
+
+
+SYM_TYPES = ('INT08U', 'INT08S', 'INT16U', 'INT16S', 'INT32U', 'INT32S',
+             'FP32',   'BOOLEAN', 'CHAR',  'BLOB')
+
+SYM_NBR_MAX = 65535
+
+
+def sym_hash(name):
+    """Return the 32-bit FNV-1a hash of a symbol name."""
+    h = 0x811C9DC5
+    for c in name.encode('ascii'):
+        h = ((h ^ c) * 0x01000193) & 0xFFFFFFFF
+    return h
+
+
+def sym_list_parse(path):
+    """Parse a symbol list; return (include lines, [(hash, name, type)] sorted by hash)."""
+    incs  = []
+    syms  = []
+    names = {}
+    hashes = {}
+
+    with open(path) as f:
+        for line_nbr, line in enumerate(f, 1):
+            line = line.strip()
+            if line.startswith('#include'):
+                incs.append(line)
+                continue
+            if (line == '') or line.startswith('#'):
+                continue
+
+            fields = line.split()
+            if len(fields) != 2:
+                raise SystemExit('%s:%d: expected "<name> <type>"' % (path, line_nbr))
+            name, typ = fields
+            if typ not in SYM_TYPES:
+                raise SystemExit('%s:%d: unknown type "%s" (must be one of %s)'
+                                 % (path, line_nbr, typ, ', '.join(SYM_TYPES)))
+            if name in names:
+                raise SystemExit('%s:%d: "%s" already listed on line %d' % (path, line_nbr, name, names[name]))
+
+            h = sym_hash(name)
+            if h in hashes:                                     # Lookups must be unambiguous.
+                raise SystemExit('%s:%d: hash of "%s" collides with "%s"' % (path, line_nbr, name, hashes[h]))
+
+            names[name] = line_nbr
+            hashes[h]   = name
+            syms.append((h, name, typ))
+
+    if len(syms) == 0:
+        raise SystemExit('%s: no symbols listed' % path)
+    if len(syms) > SYM_NBR_MAX:
+        raise SystemExit('%s: more than %d symbols listed' % (path, SYM_NBR_MAX))
+
+    syms.sort()                                                 # ProbeCom_SymFind() binary searches the table.
+    return incs, syms
+
+
+def sym_tbl_gen(list_path, incs, syms):
+    """Return the text of 'probe_com_sym.c'."""
+    name_w = max(len(name) for h, name, typ in syms)
+    out    = []
+
+    out.append('/*')
+    out.append('*' * 105)
+    out.append('*' + ' ' * 38 + 'uC/Probe Communication')
+    out.append('*')
+    out.append('*' + ' ' * 40 + 'Symbol Directory')
+    out.append('*')
+    out.append('* Filename      : probe_com_sym.c')
+    out.append('* Note(s)       : (1) GENERATED by probe_com_sym.py from %s; do NOT edit.'
+               % list_path.replace('\\', '/').split('/')[-1])
+    out.append('*' * 105)
+    out.append('*/')
+    out.append('')
+    out.extend(incs)
+    out.append('#include  <probe_com.h>')
+    out.append('')
+    out.append('')
+    out.append('#if (PROBE_COM_SUPPORT_SYM == DEF_TRUE)')
+    out.append('')
+    out.append('const  PROBE_COM_SYM  ProbeCom_SymTbl[] = {')
+    for h, name, typ in syms:
+        out.append('    {0x%08XL, (void *)&%-*s (CPU_INT16U)sizeof(%-*s PROBE_COM_SYM_TYPE_%s},'
+                   % (h, name_w + 1, name + ',', name_w + 2, name + '),', typ))
+    out.append('};')
+    out.append('')
+    out.append('const  CPU_INT16U     ProbeCom_SymTblNbr = sizeof(ProbeCom_SymTbl) / sizeof(ProbeCom_SymTbl[0]);')
+    out.append('')
+    out.append('#endif')
+    out.append('')
+
+    return '\n'.join(out)
+
+
+def main(argv):
+    if (len(argv) >= 2) and (argv[0] == '--hash'):
+        for name in argv[1:]:
+            print('0x%08X  %s' % (sym_hash(name), name))
+        return 0
+
+    if len(argv) != 2:
+        sys.stderr.write('usage: probe_com_sym.py <symbol list> <output .c file>\n'
+                         '       probe_com_sym.py --hash <name> ...\n')
+        return 2
+
+    incs, syms = sym_list_parse(argv[0])
+    text       = sym_tbl_gen(argv[0], incs, syms)
+    with open(argv[1], 'w') as f:
+        f.write(text)
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main(sys.argv[1:]))
@@ -0,0 +1,116 @@
+/*
+*********************************************************************************************************
+*                                               uC/OS-II
+*                                         The Real-Time Kernel
+*
+*                         (c) Copyright 2002, Jean J. Labrosse, Weston, FL
+*                                          All Rights Reserved
+*
+*
+*                                          POSIX Host (ucontext)
+*                                                  GNU
+*
+* File         : os_cpu.h
+* By           : Jean J. Labrosse
+* Port Version : V2.86
+*
+* Note(s)      : (1) This port runs the kernel as one host process so the processor-independent code can be
+*                    tested & measured (see 'Tests/Makefile').  Each task is a ucontext; a context switch
+*                    is a swapcontext().  There is exactly one host thread, so only one task runs at a time,
+*                    as on the target.
+*
+*                (2) There are no interrupts.  OS_CPU_SimISR() runs a handler the way the CPU would take an
+*                    interrupt, & OS_CPU_SimTickISR() does what the tick ISR does.  They are called by the
+*                    idle task & by busy tasks at the points where an interrupt would arrive.  Time therefore
+*                    advances only as fast as the code under test lets it.
+*
+*                (3) With OS_CPU_INT_DIS_MEAS_EN > 0, every period with the simulated interrupts disabled is
+*                    timed with the host clock.  Interrupts are disabled from the entry of a simulated
+*                    ISR to its return, as the CPU does.
+*********************************************************************************************************
+*/
+
+#ifndef  OS_CPU_H
+#define  OS_CPU_H
+
+/*
+*********************************************************************************************************
+*                                              DATA TYPES
+*********************************************************************************************************
+*/
+
+typedef unsigned char  BOOLEAN;
+typedef unsigned char  INT8U;                    /* Unsigned  8 bit quantity                           */
+typedef signed   char  INT8S;                    /* Signed    8 bit quantity                           */
+typedef unsigned short INT16U;                   /* Unsigned 16 bit quantity                           */
+typedef signed   short INT16S;                   /* Signed   16 bit quantity                           */
+typedef unsigned int   INT32U;                   /* Unsigned 32 bit quantity                           */
+typedef signed   int   INT32S;                   /* Signed   32 bit quantity                           */
+typedef float          FP32;                     /* Single precision floating point                    */
+typedef double         FP64;                     /* Double precision floating point                    */
+
+typedef unsigned long  OS_STK;                   /* Stack entries are pointer sized                    */
+typedef unsigned int   OS_CPU_SR;                /* Simulated interrupt disable flag                   */
+
+/*
+*********************************************************************************************************
+*                                            CONFIGURATION
+*********************************************************************************************************
+*/
+
+#ifndef  OS_CPU_INT_DIS_MEAS_EN
+#define  OS_CPU_INT_DIS_MEAS_EN    1             /* Time interrupt-disabled periods (see Note #3)      */
+#endif
+
+/*
+*********************************************************************************************************
+*                                           GLOBAL VARIABLES
+*********************************************************************************************************
+*/
+
+#if OS_CPU_INT_DIS_MEAS_EN > 0
+extern  unsigned  long  OS_CPU_IntDisMeasCtr;    /* Number of interrupt-disabled periods               */
+extern  unsigned  long  OS_CPU_IntDisMeasMaxNs;  /* Longest period, in ns                              */
+extern  double          OS_CPU_IntDisMeasTotNs;  /* Sum of all periods, in ns                          */
+#endif
+
+/*
+*********************************************************************************************************
+*                                           CRITICAL SECTIONS
+*
+* Method #3:  Disable/Enable interrupts by preserving the state of interrupts.  OS_CPU_SR_Save() returns
+*             the simulated interrupt disable flag & sets it; OS_CPU_SR_Restore() puts it back.  The flag
+*             is also saved & restored across a context switch, as the CCR is on the target.
+*********************************************************************************************************
+*/
+
+#define  OS_CRITICAL_METHOD    3
+
+#define  OS_ENTER_CRITICAL()  cpu_sr = OS_CPU_SR_Save()            /* Disable interrupts              */
+#define  OS_EXIT_CRITICAL()   OS_CPU_SR_Restore(cpu_sr)            /* Enable  interrupts              */
+
+#define  OS_TASK_SW()         OSCtxSw()
+
+#define  OS_STK_GROWTH        1                                     /* Stack growth: 1 = Down, 0 = Up */
+
+/*
+*********************************************************************************************************
+*                                              PROTOTYPES
+*********************************************************************************************************
+*/
+
+OS_CPU_SR  OS_CPU_SR_Save(void);
+void       OS_CPU_SR_Restore(OS_CPU_SR cpu_sr);
+
+void       OSStartHighRdy(void);
+void       OSCtxSw(void);
+void       OSIntCtxSw(void);
+
+void       OS_CPU_SimISR(void (*isr)(void));
+void       OS_CPU_SimTickISR(void);
+
+#if OS_CPU_INT_DIS_MEAS_EN > 0
+void       OS_CPU_IntDisMeasClr(void);
+#endif
+
+#endif
@@ -0,0 +1,478 @@
+/*
+*********************************************************************************************************
+*                                               uC/OS-II
+*                                         The Real-Time Kernel
+*
+*                         (c) Copyright 2002, Jean J. Labrosse, Weston, FL
+*                                          All Rights Reserved
+*
+*
+*                                          POSIX Host (ucontext)
+*                                                  GNU
+*
+* File         : os_cpu_c.c
+* By           : Jean J. Labrosse
+* Port Version : V2.86
+*********************************************************************************************************
+*/
+
+#include  <ucos_ii.h>
+#include  <ucontext.h>
+#include  <stdlib.h>
+#include  <time.h>
+
+/*
+*********************************************************************************************************
+*                                           LOCAL CONSTANTS
+*********************************************************************************************************
+*/
+
+#define  OS_CPU_HOST_STK_SIZE   (64 * 1024)      /* Host stack given to each task (see OSTaskStkInit()) */
+
+/*
+*********************************************************************************************************
+*                                          LOCAL DATA TYPES
+*********************************************************************************************************
+*/
+
+typedef  struct  os_cpu_ctx {
+    ucontext_t    Ctx;                           /* Saved host context                                 */
+    OS_CPU_SR     SR;                            /* Saved interrupt disable flag                       */
+    void        (*Task)(void *p_arg);            /* Task code & argument, for the first switch-in      */
+    void         *Arg;
+} OS_CPU_CTX;
+
+/*
+*********************************************************************************************************
+*                                           LOCALS
+*********************************************************************************************************
+*/
+
+static  OS_CPU_SR   OS_CPU_IntDis;               /* Simulated interrupt disable flag                   */
+static  ucontext_t  OS_CPU_MainCtx;              /* Context of main(), never resumed                   */
+
+#if OS_CPU_INT_DIS_MEAS_EN > 0
+static  struct  timespec  OS_CPU_IntDisMeasStart;     /* When interrupts were last disabled            */
+
+unsigned  long  OS_CPU_IntDisMeasCtr;
+unsigned  long  OS_CPU_IntDisMeasMaxNs;
+double          OS_CPU_IntDisMeasTotNs;
+#endif
+
+#if OS_TMR_EN > 0
+static  INT16U      OSTmrCtr;
+#endif
+
+/*
+*********************************************************************************************************
+*                                       OS INITIALIZATION HOOK
+*                                            (BEGINNING)
+*
+* Description: This function is called by OSInit() at the beginning of OSInit().
+*
+* Arguments  : none
+*
+* Note(s)    : 1) Interrupts should be disabled during this call.
+*********************************************************************************************************
+*/
+#if OS_CPU_HOOKS_EN > 0 && OS_VERSION > 203
+void  OSInitHookBegin (void)
+{
+#if OS_TMR_EN > 0
+    OSTmrCtr = 0;
+#endif
+}
+#endif
+
+/*
+*********************************************************************************************************
+*                                       OS INITIALIZATION HOOK
+*                                               (END)
+*
+* Description: This function is called by OSInit() at the end of OSInit().
+*
+* Arguments  : none
+*
+* Note(s)    : 1) Interrupts should be disabled during this call.
+*********************************************************************************************************
+*/
+#if OS_CPU_HOOKS_EN > 0 && OS_VERSION > 203
+void  OSInitHookEnd (void)
+{
+}
+#endif
+
+/*
+*********************************************************************************************************
+*                                          TASK CREATION HOOK
+*
+* Description: This function is called when a task is created.
+*
+* Arguments  : ptcb   is a pointer to the task control block of the task being created.
+*
+* Note(s)    : 1) Interrupts are disabled during this call.
+*********************************************************************************************************
+*/
+#if OS_CPU_HOOKS_EN > 0
+void  OSTaskCreateHook (OS_TCB *ptcb)
+{
+#if OS_APP_HOOKS_EN > 0
+    App_TaskCreateHook(ptcb);
+#else
+    (void)ptcb;
+#endif
+}
+#endif
+
+/*
+*********************************************************************************************************
+*                                           TASK DELETION HOOK
+*
+* Description: This function is called when a task is deleted.
+*
+* Arguments  : ptcb   is a pointer to the task control block of the task being deleted.
+*
+* Note(s)    : 1) Interrupts are disabled during this call.
+*              2) The task's host stack is not freed: the task may be deleting itself & still be running
+*                 on it.  Tests create a bounded number of tasks.
+*********************************************************************************************************
+*/
+#if OS_CPU_HOOKS_EN > 0
+void  OSTaskDelHook (OS_TCB *ptcb)
+{
+#if OS_APP_HOOKS_EN > 0
+    App_TaskDelHook(ptcb);
+#else
+    (void)ptcb;
+#endif
+}
+#endif
+
+/*
+*********************************************************************************************************
+*                                             IDLE TASK HOOK
+*
+* Description: This function is called by the idle task.
+*
+* Arguments  : none
+*
+* Note(s)    : 1) Interrupts are enabled during this call.
+*              2) Nothing else would make time pass once every task is waiting, so the idle task raises
+*                 the simulated tick (see 'os_cpu.h  Note #2').
+*********************************************************************************************************
+*/
+#if OS_CPU_HOOKS_EN > 0 && OS_VERSION >= 251
+void  OSTaskIdleHook (void)
+{
+#if OS_APP_HOOKS_EN > 0
+    App_TaskIdleHook();
+#endif
+    OS_CPU_SimTickISR();
+}
+#endif
+
+/*
+*********************************************************************************************************
+*                                           STATISTIC TASK HOOK
+*
+* Description: This function is called every second by uC/OS-II's statistics task.
+*
+* Arguments  : none
+*********************************************************************************************************
+*/
+
+#if OS_CPU_HOOKS_EN > 0
+void  OSTaskStatHook (void)
+{
+#if OS_APP_HOOKS_EN > 0
+    App_TaskStatHook();
+#endif
+}
+#endif
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                        INITIALIZE A TASK'S STACK
+*
+* Description: This function is called by either OSTaskCreate() or OSTaskCreateExt() to initialize the
+*              context of the task being created.
+*
+* Arguments  : task          is a pointer to the task code
+*
+*              p_arg         is a pointer to a user supplied data area that will be passed to the task
+*                            when the task first executes.
+*
+*              ptos          is a pointer to the top of stack (not used).
+*
+*              opt           specifies options that can be used to alter the behavior of OSTaskStkInit().
+*
+* Returns    : A pointer to the task's saved context.  It is stored in OSTCBStkPtr & only ever used by
+*              this port.
+*
+* Note(s)    : 1) Host library calls (e.g. printf()) need far more stack than a target task is given, so
+*                 each task runs on its own OS_CPU_HOST_STK_SIZE host stack & 'ptos' is ignored.
+*              2) Tasks start with interrupts enabled, as on the target.
+*********************************************************************************************************
+*/
+
+static  void  OS_CPU_TaskStart (void)
+{
+    OS_CPU_CTX  *pctx;
+
+
+    pctx          = (OS_CPU_CTX *)OSTCBCur->OSTCBStkPtr;
+    OS_CPU_SR_Restore(0);                                   /* See Note #2.                                    */
+    pctx->Task(pctx->Arg);
+    (void)OSTaskDel(OS_PRIO_SELF);                          /* Tasks should never return                       */
+}
+
+
+OS_STK *OSTaskStkInit (void (*task)(void *pd), void *p_arg, OS_STK *ptos, INT16U opt)
+{
+    OS_CPU_CTX  *pctx;
+
+
+    (void)ptos;
+    (void)opt;
+    pctx       = (OS_CPU_CTX *)calloc(1, sizeof(OS_CPU_CTX));
+    pctx->Task = task;
+    pctx->Arg  = p_arg;
+    (void)getcontext(&pctx->Ctx);
+    pctx->Ctx.uc_stack.ss_sp   = malloc(OS_CPU_HOST_STK_SIZE);
+    pctx->Ctx.uc_stack.ss_size = OS_CPU_HOST_STK_SIZE;
+    pctx->Ctx.uc_link          = (ucontext_t *)0;
+    makecontext(&pctx->Ctx, OS_CPU_TaskStart, 0);
+    return ((OS_STK *)pctx);
+}
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                           TASK SWITCH HOOK
+*
+* Description: This function is called when a task switch is performed.
+*
+* Arguments  : none
+*
+* Note(s)    : 1) Interrupts are disabled during this call.
+*********************************************************************************************************
+*/
+#if OS_CPU_HOOKS_EN > 0
+void  OSTaskSwHook (void)
+{
+#if OS_APP_HOOKS_EN > 0
+    App_TaskSwHook();
+#endif
+}
+#endif
+
+/*
+*********************************************************************************************************
+*                                           OSTCBInit() HOOK
+*
+* Description: This function is called by OS_TCBInit() after setting up most of the TCB.
+*
+* Arguments  : ptcb    is a pointer to the TCB of the task being created.
+*********************************************************************************************************
+*/
+#if OS_CPU_HOOKS_EN > 0 && OS_VERSION > 203
+void  OSTCBInitHook (OS_TCB *ptcb)
+{
+#if OS_APP_HOOKS_EN > 0
+    App_TCBInitHook(ptcb);
+#else
+    (void)ptcb;
+#endif
+}
+#endif
+
+/*
+*********************************************************************************************************
+*                                               TICK HOOK
+*
+* Description: This function is called every tick.
+*
+* Arguments  : none
+*********************************************************************************************************
+*/
+#if OS_CPU_HOOKS_EN > 0
+void  OSTimeTickHook (void)
+{
+#if OS_APP_HOOKS_EN > 0
+    App_TimeTickHook();
+#endif
+
+#if OS_TMR_EN > 0
+    OSTmrCtr++;
+    if (OSTmrCtr >= (OS_TICKS_PER_SEC / OS_TMR_CFG_TICKS_PER_SEC)) {
+        OSTmrCtr = 0;
+        OSTmrSignal();
+    }
+#endif
+}
+#endif
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                      SAVE & RESTORE INTERRUPT STATE
+*
+* Description: Implement OS_CRITICAL_METHOD #3 on the simulated interrupt disable flag.
+*
+* Arguments  : cpu_sr        is the value returned by the matching OS_CPU_SR_Save().
+*
+* Returns    : OS_CPU_SR_Save() returns the flag as it was before interrupts were disabled.
+*
+* Note(s)    : 1) Only the outermost OS_CPU_SR_Save() & the OS_CPU_SR_Restore() that enables interrupts
+*                 again are timed (see 'os_cpu.h  Note #3').  A period that spans a context switch is
+*                 one period, as it is on the target.
+*********************************************************************************************************
+*/
+
+OS_CPU_SR  OS_CPU_SR_Save (void)
+{
+    OS_CPU_SR  sr;
+
+
+    sr            = OS_CPU_IntDis;
+    OS_CPU_IntDis = 1;
+#if OS_CPU_INT_DIS_MEAS_EN > 0
+    if (sr == 0) {
+        clock_gettime(CLOCK_MONOTONIC, &OS_CPU_IntDisMeasStart);
+    }
+#endif
+    return (sr);
+}
+
+
+void  OS_CPU_SR_Restore (OS_CPU_SR cpu_sr)
+{
+#if OS_CPU_INT_DIS_MEAS_EN > 0
+    struct  timespec  now;
+    unsigned  long    ns;
+
+
+    if ((cpu_sr == 0) && (OS_CPU_IntDis != 0)) {
+        clock_gettime(CLOCK_MONOTONIC, &now);
+        ns = (unsigned long)((now.tv_sec  - OS_CPU_IntDisMeasStart.tv_sec) * 1000000000L +
+                             (now.tv_nsec - OS_CPU_IntDisMeasStart.tv_nsec));
+        OS_CPU_IntDisMeasCtr++;
+        OS_CPU_IntDisMeasTotNs += (double)ns;
+        if (ns > OS_CPU_IntDisMeasMaxNs) {
+            OS_CPU_IntDisMeasMaxNs = ns;
+        }
+    }
+#endif
+    OS_CPU_IntDis = cpu_sr;
+}
+
+
+/*
+*********************************************************************************************************
+*                                  CLEAR INTERRUPT-DISABLED MEASUREMENTS
+*
+* Description: Start a new interrupt-disabled time measurement.
+*
+* Arguments  : none
+*********************************************************************************************************
+*/
+
+#if OS_CPU_INT_DIS_MEAS_EN > 0
+void  OS_CPU_IntDisMeasClr (void)
+{
+    OS_CPU_IntDisMeasCtr   = 0;
+    OS_CPU_IntDisMeasMaxNs = 0;
+    OS_CPU_IntDisMeasTotNs = 0.0;
+}
+#endif
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                          CONTEXT SWITCHING
+*
+* Description: OSStartHighRdy() runs the highest priority task; it does not return.  OSCtxSw() &
+*              OSIntCtxSw() save the current task's context & resume OSTCBHighRdy's.
+*
+* Arguments  : none
+*
+* Note(s)    : 1) The task level & the interrupt level switch are the same: the simulated tick ISR runs
+*                 on the interrupted task's stack, so that task resumes inside OSIntExit() & returns
+*                 from OS_CPU_SimTickISR() the next time it runs, just as it would return from the ISR.
+*********************************************************************************************************
+*/
+
+void  OSStartHighRdy (void)
+{
+#if OS_CPU_HOOKS_EN > 0
+    OSTaskSwHook();
+#endif
+    OSRunning = OS_TRUE;
+    OSTCBCur  = OSTCBHighRdy;
+    OSPrioCur = OSPrioHighRdy;
+    (void)swapcontext(&OS_CPU_MainCtx, &((OS_CPU_CTX *)OSTCBCur->OSTCBStkPtr)->Ctx);
+}
+
+
+void  OSCtxSw (void)
+{
+    OS_CPU_CTX  *pold;
+    OS_CPU_CTX  *pnew;
+
+
+#if OS_CPU_HOOKS_EN > 0
+    OSTaskSwHook();
+#endif
+    pold       = (OS_CPU_CTX *)OSTCBCur->OSTCBStkPtr;
+    pnew       = (OS_CPU_CTX *)OSTCBHighRdy->OSTCBStkPtr;
+    OSTCBCur   = OSTCBHighRdy;
+    OSPrioCur  = OSPrioHighRdy;
+    pold->SR   = OS_CPU_IntDis;
+    (void)swapcontext(&pold->Ctx, &pnew->Ctx);
+    OS_CPU_IntDis = ((OS_CPU_CTX *)OSTCBCur->OSTCBStkPtr)->SR;
+}
+
+
+void  OSIntCtxSw (void)
+{
+    OSCtxSw();                                              /* See Note #1.                                    */
+}
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                            SIMULATED ISRs
+*
+* Description: OS_CPU_SimISR() takes a simulated interrupt & runs 'isr' as its handler, between
+*              OSIntEnter() & OSIntExit().  OS_CPU_SimTickISR() takes the tick interrupt.
+*
+* Arguments  : isr           is the handler.
+*
+* Note(s)    : 1) Like a real interrupt, none is taken while interrupts are disabled.  It is dropped, not
+*                 held pending: callers raise interrupts from task level, where they are enabled.
+*              2) The CPU disables interrupts on entry & the return from interrupt enables them again.
+*                 If OSIntExit() switches tasks, the interrupted task returns from here when it resumes.
+*********************************************************************************************************
+*/
+
+void  OS_CPU_SimISR (void (*isr)(void))
+{
+    OS_CPU_SR  cpu_sr;
+
+
+    if (OS_CPU_IntDis != 0) {                               /* See Note #1.                                    */
+        return;
+    }
+    cpu_sr = OS_CPU_SR_Save();                              /* See Note #2.                                    */
+    OSIntEnter();
+    isr();
+    OSIntExit();
+    OS_CPU_SR_Restore(cpu_sr);
+}
+
+
+void  OS_CPU_SimTickISR (void)
+{
+    OS_CPU_SimISR(OSTimeTick);
+}
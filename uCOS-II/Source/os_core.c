@@ -67,6 +67,10 @@ static  void  OS_InitMisc(void);
 
 static  void  OS_InitRdyList(void);
 
+#if OS_DPC_EN > 0
+static  void  OS_InitTaskDPC(void);
+#endif
+
 static  void  OS_InitTaskIdle(void);
 
 #if OS_TASK_STAT_EN > 0
@@ -77,6 +81,86 @@ static  void  OS_InitTCBList(void);
 
 static  void  OS_SchedNew(void);
 
+#if OS_SCHED_RR_EN > 0
+static  void  OS_SchedRRTick(void);
+
+#if (OS_EVENT_EN)
+static  BOOLEAN  OS_EventTaskIsWaiting(OS_TCB *ptcb, OS_EVENT *pevent);
+
+static  BOOLEAN  OS_EventTaskRRShared(OS_TCB *ptcb, OS_EVENT *pevent);
+#endif
+#endif
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                    QUEUE A DEFERRED PROCEDURE CALL
+*
+* Description: This function is called by an ISR to defer the bulk of its processing to task level.  The
+*              function and its argument are placed in the DPC queue and the DPC task is made ready.
+*              Because the DPC task runs at OS_TASK_DPC_PRIO (the highest priority), OSIntExit() switches
+*              to it before any application task so deferred work is done with interrupts enabled, ahead
+*              of normal scheduling.
+*
+* Arguments  : fnct      is the function to call from the DPC task.
+*
+*              p_arg     is the argument passed to 'fnct'.
+*
+* Returns    : OS_ERR_NONE            if the call was queued
+*              OS_ERR_DPC_Q_FULL      if the DPC queue is full (the call is dropped and OSDPCOvfCtr is
+*                                     incremented)
+*              OS_ERR_DPC_FNCT_NULL   if 'fnct' is a NULL pointer
+*
+* Note(s)    : 1) This function may be called from an ISR or from a task.
+*              2) Deferred functions are called in the order they were queued and MUST NOT block.
+*              3) The DPC task is the only consumer of the queue; it removes entries without disabling
+*                 interrupts.  Interrupts are only disabled here, for the few instructions needed to
+*                 fill an entry and wake the DPC task.
+*              4) The DPC task is woken through OSDPCEvent, never by clearing a suspend: a task that the
+*                 application suspended with OSTaskSuspend() stays suspended.
+*********************************************************************************************************
+*/
+
+#if OS_DPC_EN > 0
+INT8U  OSDPCPost (OS_DPC_FNCT fnct, void *p_arg)
+{
+    OS_DPC    *pdpc;
+    INT8U      in;
+#if OS_CRITICAL_METHOD == 3                                /* Allocate storage for CPU status register */
+    OS_CPU_SR  cpu_sr = 0;
+#endif
+
+
+
+#if OS_ARG_CHK_EN > 0
+    if (fnct == (OS_DPC_FNCT)0) {                          /* Validate 'fnct'                          */
+        return (OS_ERR_DPC_FNCT_NULL);
+    }
+#endif
+    OS_ENTER_CRITICAL();
+    in = OSDPCIn + 1;
+    if (in == OS_DPC_Q_SIZE) {                             /* Wrap around the end of the queue         */
+        in = 0;
+    }
+    if (in == OSDPCOut) {                                  /* Queue is full (one entry is kept empty)  */
+        OSDPCOvfCtr++;
+        OS_EXIT_CRITICAL();
+        return (OS_ERR_DPC_Q_FULL);
+    }
+    pdpc            = &OSDPCTbl[OSDPCIn];
+    pdpc->OSDPCFnct = fnct;
+    pdpc->OSDPCArg  = p_arg;
+    OSDPCIn         = in;                                  /* Publish the entry once it is complete    */
+    if (OSDPCEvent.OSEventGrp != 0) {                      /* Wake up the DPC task if it is idle       */
+        (void)OS_EventTaskRdy(&OSDPCEvent, (void *)0, OS_STAT_SEM, OS_STAT_PEND_OK);
+        OS_EXIT_CRITICAL();
+        OS_Sched();                                        /* No effect from an ISR, see OSIntExit()   */
+        return (OS_ERR_NONE);
+    }
+    OS_EXIT_CRITICAL();
+    return (OS_ERR_NONE);
+}
+#endif
 /*$PAGE*/
 /*
 *********************************************************************************************************
@@ -137,6 +221,7 @@ INT8U  OSEventNameGet (OS_EVENT *pevent, INT8U *pname, INT8U *perr)
         case OS_EVENT_TYPE_MUTEX:
         case OS_EVENT_TYPE_MBOX:
         case OS_EVENT_TYPE_Q:
+        case OS_EVENT_TYPE_RWLOCK:
              break;
 
         default:
@@ -211,6 +296,7 @@ void  OSEventNameSet (OS_EVENT *pevent, INT8U *pname, INT8U *perr)
         case OS_EVENT_TYPE_MUTEX:
         case OS_EVENT_TYPE_MBOX:
         case OS_EVENT_TYPE_Q:
+        case OS_EVENT_TYPE_RWLOCK:
              break;
 
         default:
@@ -575,6 +661,9 @@ void  OSInit (void)
     OS_QInit();                                                  /* Initialize the message queue structures  */
 #endif
 
+#if OS_DPC_EN > 0
+    OS_InitTaskDPC();                                            /* Create the DPC Task                      */
+#endif
     OS_InitTaskIdle();                                           /* Create the Idle Task                     */
 #if OS_TASK_STAT_EN > 0
     OS_InitTaskStat();                                           /* Create the Statistic Task                */
@@ -660,8 +749,8 @@ void  OSIntExit (void)
         if (OSIntNesting == 0) {                           /* Reschedule only if all ISRs complete ... */
             if (OSLockNesting == 0) {                      /* ... and not locked.                      */
                 OS_SchedNew();
-                if (OSPrioHighRdy != OSPrioCur) {          /* No Ctx Sw if current task is highest rdy */
-                    OSTCBHighRdy  = OSTCBPrioTbl[OSPrioHighRdy];
+                OSTCBHighRdy  = OSTCBPrioTbl[OSPrioHighRdy];
+                if (OSTCBHighRdy != OSTCBCur) {            /* No Ctx Sw if current task is highest rdy */
 #if OS_TASK_PROFILE_EN > 0
                     OSTCBHighRdy->OSTCBCtxSwCtr++;         /* Inc. # of context switches to this task  */
 #endif
@@ -905,12 +994,18 @@ void  OSTimeTick (void)
                     if ((ptcb->OSTCBStat & OS_STAT_SUSPEND) == OS_STAT_RDY) {  /* Is task suspended?       */
                         OSRdyGrp               |= ptcb->OSTCBBitY;             /* No,  Make ready          */
                         OSRdyTbl[ptcb->OSTCBY] |= ptcb->OSTCBBitX;
+#if OS_SCHED_RR_EN > 0
+                        OS_SchedRRUpdate(ptcb->OSTCBPrio);
+#endif
                     }
                 }
             }
             ptcb = ptcb->OSTCBNext;                        /* Point at next TCB in TCB list                */
             OS_EXIT_CRITICAL();
         }
+#if OS_SCHED_RR_EN > 0
+        OS_SchedRRTick();                                  /* Charge tick to current task's time quantum   */
+#endif
     }
 }
 
@@ -985,6 +1080,9 @@ void  OS_Dummy (void)
 INT8U  OS_EventTaskRdy (OS_EVENT *pevent, void *pmsg, INT8U msk, INT8U pend_stat)
 {
     OS_TCB  *ptcb;
+#if OS_SCHED_RR_EN > 0
+    OS_TCB  *phead;
+#endif
     INT8U    y;
     INT8U    x;
     INT8U    prio;
@@ -1013,6 +1111,16 @@ INT8U  OS_EventTaskRdy (OS_EVENT *pevent, void *pmsg, INT8U msk, INT8U pend_stat
 #endif
 
     ptcb                  =  OSTCBPrioTbl[prio];        /* Point to this task's OS_TCB                 */
+#if OS_SCHED_RR_EN > 0
+    phead                 =  ptcb;                      /* Find waiting task among those sharing prio  */
+    do {
+        if ((ptcb->OSTCBPrio == prio) && (OS_EventTaskIsWaiting(ptcb, pevent) == OS_TRUE)) {
+            break;
+        }
+        ptcb = ptcb->OSTCBRRNext;
+    } while (ptcb != phead);
+    OSTCBEventRdy         =  ptcb;                      /* Tell caller which task got the event        */
+#endif
     ptcb->OSTCBDly        =  0;                         /* Prevent OSTimeTick() from readying task     */
 #if ((OS_Q_EN > 0) && (OS_MAX_QS > 0)) || (OS_MBOX_EN > 0)
     ptcb->OSTCBMsg        =  pmsg;                      /* Send message directly to waiting task       */
@@ -1032,9 +1140,13 @@ INT8U  OS_EventTaskRdy (OS_EVENT *pevent, void *pmsg, INT8U msk, INT8U pend_stat
     if (ptcb->OSTCBEventMultiPtr != (OS_EVENT **)0) {   /* Remove this task from events' wait lists    */
         OS_EventTaskRemoveMulti(ptcb, ptcb->OSTCBEventMultiPtr);
         ptcb->OSTCBEventPtr       = (OS_EVENT  *)pevent;/* Return event as first multi-pend event ready*/
+        ptcb->OSTCBStat          &= ~(INT8U)OS_STAT_PEND_ANY;  /* No longer pending on the other events */
     }
 #endif
 
+#if OS_SCHED_RR_EN > 0
+    OS_SchedRRUpdate(prio);                             /* Keep a ready task at the head of the list   */
+#endif
     return (prio);
 }
 #endif
@@ -1069,6 +1181,9 @@ void  OS_EventTaskWait (OS_EVENT *pevent)
     if (OSRdyTbl[y] == 0) {
         OSRdyGrp &= ~OSTCBCur->OSTCBBitY;         /* Clear event grp bit if this was only task pending */
     }
+#if OS_SCHED_RR_EN > 0
+    OS_SchedRRUpdate(OSTCBCur->OSTCBPrio);        /* Priority stays ready if shared with a ready task  */
+#endif
 }
 #endif
 /*$PAGE*/
@@ -1112,6 +1227,9 @@ void  OS_EventTaskWaitMulti (OS_EVENT **pevents_wait)
     if (OSRdyTbl[y] == 0) {
         OSRdyGrp &= ~OSTCBCur->OSTCBBitY;         /* Clear event grp bit if this was only task pending */
     }
+#if OS_SCHED_RR_EN > 0
+    OS_SchedRRUpdate(OSTCBCur->OSTCBPrio);        /* Priority stays ready if shared with a ready task  */
+#endif
 }
 #endif
 /*$PAGE*/
@@ -1137,6 +1255,11 @@ void  OS_EventTaskRemove (OS_TCB   *ptcb,
     INT8U  y;
 
 
+#if OS_SCHED_RR_EN > 0
+    if (OS_EventTaskRRShared(ptcb, pevent) == OS_TRUE) {
+        return;                                         /* Another task at this prio is still waiting  */
+    }
+#endif
     y                       =  ptcb->OSTCBY;
     pevent->OSEventTbl[y]  &= ~ptcb->OSTCBBitX;         /* Remove task from wait list                  */
     if (pevent->OSEventTbl[y] == 0) {
@@ -1182,10 +1305,16 @@ void  OS_EventTaskRemoveMulti (OS_TCB    *ptcb,
     pevents =  pevents_multi;
     pevent  = *pevents;
     while (pevent != (OS_EVENT *)0) {                   /* Remove task from all events' wait lists     */
-        pevent->OSEventTbl[y]  &= ~bitx;
-        if (pevent->OSEventTbl[y] == 0) {
-            pevent->OSEventGrp &= ~bity;
+#if OS_SCHED_RR_EN > 0
+        if (OS_EventTaskRRShared(ptcb, pevent) == OS_FALSE) {
+#endif
+            pevent->OSEventTbl[y]  &= ~bitx;
+            if (pevent->OSEventTbl[y] == 0) {
+                pevent->OSEventGrp &= ~bity;
+            }
+#if OS_SCHED_RR_EN > 0
         }
+#endif
         pevents++;
         pevent = *pevents;
     }
@@ -1194,6 +1323,94 @@ void  OS_EventTaskRemoveMulti (OS_TCB    *ptcb,
 /*$PAGE*/
 /*
 *********************************************************************************************************
+*                                 SEE IF TASK IS IN AN EVENT'S WAIT LIST
+*
+* Description: This function determines whether a task is still accounted for in an event's wait list,
+*              i.e. it is pending on the event or it timed out and did not yet remove itself from the
+*              wait list.
+*
+* Arguments  : ptcb     is a pointer to the task to check.
+*
+*              pevent   is a pointer to the event control block.
+*
+* Returns    : OS_TRUE  if the task is in the event's wait list
+*              OS_FALSE otherwise
+*
+* Note       : This function is INTERNAL to uC/OS-II and your application should not call it.
+*********************************************************************************************************
+*/
+#if (OS_EVENT_EN) && (OS_SCHED_RR_EN > 0)
+static  BOOLEAN  OS_EventTaskIsWaiting (OS_TCB   *ptcb,
+                                        OS_EVENT *pevent)
+{
+#if (OS_EVENT_MULTI_EN > 0)
+    OS_EVENT **pevents;
+#endif
+
+
+    if ((ptcb->OSTCBStat & OS_STAT_PEND_ANY) == OS_STAT_RDY) {
+        if (ptcb->OSTCBStatPend != OS_STAT_PEND_TO) {   /* Not pending and not timed out               */
+            return (OS_FALSE);
+        }
+    }
+    if (ptcb->OSTCBEventPtr == pevent) {
+        return (OS_TRUE);
+    }
+#if (OS_EVENT_MULTI_EN > 0)
+    pevents = ptcb->OSTCBEventMultiPtr;
+    if (pevents != (OS_EVENT **)0) {
+        while (*pevents != (OS_EVENT *)0) {             /* Look for event in multi-pend list           */
+            if (*pevents == pevent) {
+                return (OS_TRUE);
+            }
+            pevents++;
+        }
+    }
+#endif
+    return (OS_FALSE);
+}
+#endif
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                     SEE IF ANOTHER TASK SHARING THE PRIORITY WAITS FOR AN EVENT
+*
+* Description: Event wait lists hold one bit per priority.  When round-robin scheduling is enabled,
+*              several tasks can share that bit and it must only be cleared when the last of them leaves
+*              the wait list.
+*
+* Arguments  : ptcb     is a pointer to the task leaving the wait list.
+*
+*              pevent   is a pointer to the event control block.
+*
+* Returns    : OS_TRUE  if another task at the same priority is in the event's wait list
+*              OS_FALSE otherwise
+*
+* Note       : This function is INTERNAL to uC/OS-II and your application should not call it.
+*********************************************************************************************************
+*/
+#if (OS_EVENT_EN) && (OS_SCHED_RR_EN > 0)
+static  BOOLEAN  OS_EventTaskRRShared (OS_TCB   *ptcb,
+                                       OS_EVENT *pevent)
+{
+    OS_TCB  *pnext;
+
+
+    pnext = ptcb->OSTCBRRNext;
+    while (pnext != ptcb) {
+        if (pnext->OSTCBPrio == ptcb->OSTCBPrio) {
+            if (OS_EventTaskIsWaiting(pnext, pevent) == OS_TRUE) {
+                return (OS_TRUE);
+            }
+        }
+        pnext = pnext->OSTCBRRNext;
+    }
+    return (OS_FALSE);
+}
+#endif
+/*$PAGE*/
+/*
+*********************************************************************************************************
 *                                 INITIALIZE EVENT CONTROL BLOCK'S WAIT LIST
 *
 * Description: This function is called by other uC/OS-II services to initialize the event wait list.
@@ -1313,6 +1530,20 @@ static  void  OS_InitMisc (void)
     OSIdleCtrMax  = 0L;
     OSStatRdy     = OS_FALSE;                              /* Statistic task is not ready              */
 #endif
+
+#if OS_DPC_EN > 0
+    OSDPCIn       = 0;                                     /* The DPC queue is empty                   */
+    OSDPCOut      = 0;
+    OSDPCOvfCtr   = 0;
+    OSDPCEvent.OSEventType    = OS_EVENT_TYPE_SEM;         /* DPC task waits here, see OS_TaskDPC()    */
+    OSDPCEvent.OSEventCnt     = 0;
+    OSDPCEvent.OSEventPtr     = (void *)0;
+#if OS_EVENT_NAME_SIZE > 1
+    OSDPCEvent.OSEventName[0] = '?';                       /* Unknown name                             */
+    OSDPCEvent.OSEventName[1] = OS_ASCII_NUL;
+#endif
+    OS_EventWaitListInit(&OSDPCEvent);
+#endif
 }
 /*$PAGE*/
 /*
@@ -1351,6 +1582,73 @@ static  void  OS_InitRdyList (void)
     OSTCBCur      = (OS_TCB *)0;
 }
 
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                             INITIALIZATION
+*                                         CREATING THE DPC TASK
+*
+* Description: This function creates the Deferred Procedure Call Task.
+*
+* Arguments  : none
+*
+* Returns    : none
+*********************************************************************************************************
+*/
+
+#if OS_DPC_EN > 0
+static  void  OS_InitTaskDPC (void)
+{
+#if OS_TASK_NAME_SIZE > 6
+    INT8U  err;
+#endif
+
+
+#if OS_TASK_CREATE_EXT_EN > 0
+    #if OS_STK_GROWTH == 1
+    (void)OSTaskCreateExt(OS_TaskDPC,
+                          (void *)0,                                 /* No arguments passed to OS_TaskDPC()  */
+                          &OSTaskDPCStk[OS_TASK_DPC_STK_SIZE - 1],   /* Set Top-Of-Stack                     */
+                          OS_TASK_DPC_PRIO,                          /* Highest priority level               */
+                          OS_TASK_DPC_ID,
+                          &OSTaskDPCStk[0],                          /* Set Bottom-Of-Stack                  */
+                          OS_TASK_DPC_STK_SIZE,
+                          (void *)0,                                 /* No TCB extension                     */
+                          OS_TASK_OPT_STK_CHK | OS_TASK_OPT_STK_CLR);/* Enable stack checking + clear stack  */
+    #else
+    (void)OSTaskCreateExt(OS_TaskDPC,
+                          (void *)0,                                 /* No arguments passed to OS_TaskDPC()  */
+                          &OSTaskDPCStk[0],                          /* Set Top-Of-Stack                     */
+                          OS_TASK_DPC_PRIO,                          /* Highest priority level               */
+                          OS_TASK_DPC_ID,
+                          &OSTaskDPCStk[OS_TASK_DPC_STK_SIZE - 1],   /* Set Bottom-Of-Stack                  */
+                          OS_TASK_DPC_STK_SIZE,
+                          (void *)0,                                 /* No TCB extension                     */
+                          OS_TASK_OPT_STK_CHK | OS_TASK_OPT_STK_CLR);/* Enable stack checking + clear stack  */
+    #endif
+#else
+    #if OS_STK_GROWTH == 1
+    (void)OSTaskCreate(OS_TaskDPC,
+                       (void *)0,
+                       &OSTaskDPCStk[OS_TASK_DPC_STK_SIZE - 1],
+                       OS_TASK_DPC_PRIO);
+    #else
+    (void)OSTaskCreate(OS_TaskDPC,
+                       (void *)0,
+                       &OSTaskDPCStk[0],
+                       OS_TASK_DPC_PRIO);
+    #endif
+#endif
+
+#if OS_TASK_NAME_SIZE > 12
+    OSTaskNameSet(OS_TASK_DPC_PRIO, (INT8U *)"uC/OS-II DPC", &err);
+#else
+#if OS_TASK_NAME_SIZE > 6
+    OSTaskNameSet(OS_TASK_DPC_PRIO, (INT8U *)"OS-DPC", &err);
+#endif
+#endif
+}
+#endif
 /*$PAGE*/
 /*
 *********************************************************************************************************
@@ -1615,8 +1913,8 @@ void  OS_Sched (void)
     if (OSIntNesting == 0) {                           /* Schedule only if all ISRs done and ...       */
         if (OSLockNesting == 0) {                      /* ... scheduler is not locked                  */
             OS_SchedNew();
-            if (OSPrioHighRdy != OSPrioCur) {          /* No Ctx Sw if current task is highest rdy     */
-                OSTCBHighRdy = OSTCBPrioTbl[OSPrioHighRdy];
+            OSTCBHighRdy = OSTCBPrioTbl[OSPrioHighRdy];
+            if (OSTCBHighRdy != OSTCBCur) {            /* No Ctx Sw if current task is highest rdy     */
 #if OS_TASK_PROFILE_EN > 0
                 OSTCBHighRdy->OSTCBCtxSwCtr++;         /* Inc. # of context switches to this task      */
 #endif
@@ -1672,6 +1970,107 @@ static  void  OS_SchedNew (void)
 #endif
 }
 
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                 UPDATE ROUND-ROBIN LIST OF A PRIORITY
+*
+* Description: This function is called by other uC/OS-II services after the state of a task that can share
+*              its priority with other round-robin tasks has changed.  The first ready task found in the
+*              list (starting with the one OSTCBPrioTbl[] points to) becomes the task that runs at that
+*              priority and the priority is put back in the ready list.  A priority thus stays ready as
+*              long as ONE of the tasks sharing it is ready to run.
+*
+* Arguments  : prio     is the priority to update
+*
+* Returns    : none
+*
+* Notes      : 1) This function is INTERNAL to uC/OS-II and your application should not call it.
+*              2) Interrupts are assumed to be disabled when this function is called.
+*              3) A task which inherited a mutex's PIP stays linked in the list of its original priority
+*                 but is skipped because its OSTCBPrio no longer matches.
+*********************************************************************************************************
+*/
+
+#if OS_SCHED_RR_EN > 0
+void  OS_SchedRRUpdate (INT8U prio)
+{
+    OS_TCB  *phead;
+    OS_TCB  *ptcb;
+
+
+    phead = OSTCBPrioTbl[prio];
+    if ((phead == (OS_TCB *)0) || (phead == OS_TCB_RESERVED)) {
+        return;
+    }
+    ptcb  = phead;
+    do {
+        if ((ptcb->OSTCBPrio == prio)                                                   &&
+            ((ptcb->OSTCBStat & (OS_STAT_PEND_ANY | OS_STAT_SUSPEND)) == OS_STAT_RDY) &&
+            (ptcb->OSTCBDly == 0)) {
+            OSTCBPrioTbl[prio]      = ptcb;      /* Task will run next at this priority                */
+            OSRdyGrp               |= ptcb->OSTCBBitY;
+            OSRdyTbl[ptcb->OSTCBY] |= ptcb->OSTCBBitX;
+            return;
+        }
+        ptcb = ptcb->OSTCBRRNext;
+    } while (ptcb != phead);
+}
+#endif
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                  CHARGE ONE TICK TO ROUND-ROBIN QUANTUM
+*
+* Description: This function is called by OSTimeTick() to charge the current task with one tick of its
+*              round-robin time quantum.  When the quantum expires, the next ready task sharing the
+*              priority of the current task is selected to run at that priority and the context switch
+*              happens in OSIntExit().
+*
+* Arguments  : none
+*
+* Returns    : none
+*
+* Notes      : 1) This function is INTERNAL to uC/OS-II and your application should not call it.
+*              2) The quantum is not charged while the scheduler is locked.
+*********************************************************************************************************
+*/
+
+#if OS_SCHED_RR_EN > 0
+static  void  OS_SchedRRTick (void)
+{
+    OS_TCB    *ptcb;
+    OS_TCB    *pnext;
+#if OS_CRITICAL_METHOD == 3                      /* Allocate storage for CPU status register           */
+    OS_CPU_SR  cpu_sr = 0;
+#endif
+
+
+
+    OS_ENTER_CRITICAL();
+    ptcb = OSTCBCur;
+    if ((ptcb->OSTCBRRNext != ptcb) && (OSLockNesting == 0)) {     /* Is priority shared?              */
+        if (ptcb->OSTCBRRCtr > 1) {
+            ptcb->OSTCBRRCtr--;
+        } else {
+            ptcb->OSTCBRRCtr = OS_SCHED_RR_QUANTA;                 /* Quantum expired, reload it ...   */
+            pnext            = ptcb->OSTCBRRNext;                  /* ... and find next task to run    */
+            while (pnext != ptcb) {
+                if ((pnext->OSTCBPrio == ptcb->OSTCBPrio)                                        &&
+                    ((pnext->OSTCBStat & (OS_STAT_PEND_ANY | OS_STAT_SUSPEND)) == OS_STAT_RDY) &&
+                    (pnext->OSTCBDly == 0)) {
+                    OSTCBPrioTbl[ptcb->OSTCBPrio] = pnext;
+                    break;
+                }
+                pnext = pnext->OSTCBRRNext;
+            }
+        }
+    }
+    OS_EXIT_CRITICAL();
+}
+#endif
+
 /*$PAGE*/
 /*
 *********************************************************************************************************
@@ -1741,6 +2140,66 @@ INT8U  OS_StrLen (INT8U *psrc)
 /*$PAGE*/
 /*
 *********************************************************************************************************
+*                                      DEFERRED PROCEDURE CALL TASK
+*
+* Description: This task is internal to uC/OS-II and calls, in order, the functions queued by OSDPCPost().
+*              When the queue is empty the task pends on OSDPCEvent until OSDPCPost() readies it again.
+*
+* Arguments  : none
+*
+* Returns    : none
+*
+* Note(s)    : 1) The task runs at OS_TASK_DPC_PRIO, which should be the highest priority in the system.
+*              2) Queued functions are called with interrupts enabled.  An entry is released before its
+*                 function is called so that ISRs can re-use it right away.
+*              3) OSDPCEvent is private to the DPC task and is not taken from OSEventTbl[].  Because the
+*                 task waits on an event, OSTaskSuspend() and OSTaskResume() act on it as on any other
+*                 pending task: a post does not undo a suspend and a resume does not wake it early.
+*********************************************************************************************************
+*/
+
+#if OS_DPC_EN > 0
+void  OS_TaskDPC (void *p_arg)
+{
+    OS_DPC_FNCT  fnct;
+    void        *parg;
+    INT8U        out;
+#if OS_CRITICAL_METHOD == 3                      /* Allocate storage for CPU status register           */
+    OS_CPU_SR    cpu_sr = 0;
+#endif
+
+
+
+    (void)p_arg;                                 /* Prevent compiler warning for not using 'p_arg'     */
+    for (;;) {
+        out = OSDPCOut;
+        while (out != OSDPCIn) {                 /* Run every call queued so far                       */
+            fnct = OSDPCTbl[out].OSDPCFnct;
+            parg = OSDPCTbl[out].OSDPCArg;
+            out++;
+            if (out == OS_DPC_Q_SIZE) {
+                out = 0;
+            }
+            OSDPCOut = out;                      /* Release the entry before calling the function      */
+            (*fnct)(parg);
+        }
+        OS_ENTER_CRITICAL();
+        if (OSDPCOut == OSDPCIn) {               /* Wait for OSDPCPost() if the queue is still empty   */
+            OSTCBCur->OSTCBStat     |= OS_STAT_SEM;
+            OSTCBCur->OSTCBStatPend  = OS_STAT_PEND_OK;
+            OSTCBCur->OSTCBDly       = 0;        /* Wait forever                                       */
+            OS_EventTaskWait(&OSDPCEvent);
+            OS_EXIT_CRITICAL();
+            OS_Sched();
+        } else {
+            OS_EXIT_CRITICAL();
+        }
+    }
+}
+#endif
+/*$PAGE*/
+/*
+*********************************************************************************************************
 *                                              IDLE TASK
 *
 * Description: This task is internal to uC/OS-II and executes whenever no other higher priority tasks
@@ -1922,6 +2381,9 @@ void  OS_TaskStatStkChk (void)
 INT8U  OS_TCBInit (INT8U prio, OS_STK *ptos, OS_STK *pbos, INT16U id, INT32U stk_size, void *pext, INT16U opt)
 {
     OS_TCB    *ptcb;
+#if OS_SCHED_RR_EN > 0
+    OS_TCB    *phead;
+#endif
 #if OS_CRITICAL_METHOD == 3                                /* Allocate storage for CPU status register */
     OS_CPU_SR  cpu_sr = 0;
 #endif
@@ -1957,6 +2419,15 @@ INT8U  OS_TCBInit (INT8U prio, OS_STK *ptos, OS_STK *pbos, INT16U id, INT32U stk
         ptcb->OSTCBDelReq        = OS_ERR_NONE;
 #endif
 
+#if (OS_MUTEX_EN > 0) && (OS_MUTEX_CEILING_EN > 0)
+        ptcb->OSTCBMutexCtr      = 0;                      /* Task does not hold any mutex             */
+        ptcb->OSTCBBasePrio      = prio;
+#endif
+
+#if OS_SCHED_RR_EN > 0
+        ptcb->OSTCBRRCtr         = OS_SCHED_RR_QUANTA;     /* Start with a full time quantum           */
+#endif
+
 #if OS_LOWEST_PRIO <= 63
         ptcb->OSTCBY             = (INT8U)(prio >> 3);          /* Pre-compute X, Y, BitX and BitY     */
         ptcb->OSTCBX             = (INT8U)(prio & 0x07);
@@ -2002,7 +2473,21 @@ INT8U  OS_TCBInit (INT8U prio, OS_STK *ptos, OS_STK *pbos, INT16U id, INT32U stk
         OSTaskCreateHook(ptcb);                            /* Call user defined hook                   */
 
         OS_ENTER_CRITICAL();
+#if OS_SCHED_RR_EN > 0
+        phead = OSTCBPrioTbl[prio];
+        if ((phead == (OS_TCB *)0) || (phead == OS_TCB_RESERVED)) {
+            ptcb->OSTCBRRNext  = ptcb;                     /* First task at this priority              */
+            ptcb->OSTCBRRPrev  = ptcb;
+            OSTCBPrioTbl[prio] = ptcb;
+        } else {                                           /* Join round-robin list as its last task   */
+            ptcb->OSTCBRRNext               = phead;
+            ptcb->OSTCBRRPrev               = phead->OSTCBRRPrev;
+            phead->OSTCBRRPrev->OSTCBRRNext = ptcb;
+            phead->OSTCBRRPrev              = ptcb;
+        }
+#else
         OSTCBPrioTbl[prio] = ptcb;
+#endif
         ptcb->OSTCBNext    = OSTCBList;                    /* Link into TCB chain                      */
         ptcb->OSTCBPrev    = (OS_TCB *)0;
         if (OSTCBList != (OS_TCB *)0) {
@@ -2011,6 +2496,9 @@ INT8U  OS_TCBInit (INT8U prio, OS_STK *ptos, OS_STK *pbos, INT16U id, INT32U stk
         OSTCBList               = ptcb;
         OSRdyGrp               |= ptcb->OSTCBBitY;         /* Make task ready to run                   */
         OSRdyTbl[ptcb->OSTCBY] |= ptcb->OSTCBBitX;
+#if OS_SCHED_RR_EN > 0
+        OS_SchedRRUpdate(prio);
+#endif
         OSTaskCtr++;                                       /* Increment the #tasks counter             */
         OS_EXIT_CRITICAL();
         return (OS_ERR_NONE);
@@ -33,6 +33,15 @@ INT16U  const  OSDebugEn           = OS_DEBUG_EN;               /* Debug constan
 
 #if OS_DEBUG_EN > 0
 
+INT16U  const  OSDPCEn             = OS_DPC_EN;
+#if OS_DPC_EN > 0
+INT16U  const  OSDPCQSize          = OS_DPC_Q_SIZE;             /* Number of entries in the DPC queue  */
+INT16U  const  OSDPCTblSize        = sizeof(OSDPCTbl);          /* Size of OSDPCTbl[] in bytes         */
+#else
+INT16U  const  OSDPCQSize          = 0;
+INT16U  const  OSDPCTblSize        = 0;
+#endif
+
 INT32U  const  OSEndiannessTest    = 0x12345678L;               /* Variable to test CPU endianness     */
 
 INT16U  const  OSEventEn           = OS_EVENT_EN;
@@ -76,6 +85,11 @@ INT16U  const  OSMemSize           = 0;
 INT16U  const  OSMemTblSize        = 0;
 #endif
 INT16U  const  OSMutexEn           = OS_MUTEX_EN;
+#if OS_MUTEX_EN > 0
+INT16U  const  OSMutexCeilingEn    = OS_MUTEX_CEILING_EN;       /* Owner raised to PIP at acquire time */
+#else
+INT16U  const  OSMutexCeilingEn    = 0;
+#endif
 
 INT16U  const  OSPtrSize           = sizeof(void *);            /* Size in Bytes of a pointer          */
 
@@ -89,6 +103,15 @@ INT16U  const  OSQSize             = 0;
 
 INT16U  const  OSRdyTblSize        = OS_RDY_TBL_SIZE;           /* Number of bytes in the ready table  */
 
+INT16U  const  OSRWLockEn          = OS_RWLOCK_EN;
+
+INT16U  const  OSSchedRREn         = OS_SCHED_RR_EN;
+#if OS_SCHED_RR_EN > 0
+INT16U  const  OSSchedRRQuanta     = OS_SCHED_RR_QUANTA;        /* Round-robin time quantum (ticks)    */
+#else
+INT16U  const  OSSchedRRQuanta     = 0;
+#endif
+
 INT16U  const  OSSemEn             = OS_SEM_EN;
 
 INT16U  const  OSStkWidth          = sizeof(OS_STK);            /* Size in Bytes of a stack entry      */
@@ -141,6 +164,14 @@ INT16U  const  OSTmrWheelTblSize   = 0;
 #if OS_DEBUG_EN > 0
 
 INT16U  const  OSDataSize = sizeof(OSCtxSwCtr)
+#if OS_DPC_EN > 0
+                          + sizeof(OSDPCTbl)
+                          + sizeof(OSDPCIn)
+                          + sizeof(OSDPCOut)
+                          + sizeof(OSDPCOvfCtr)
+                          + sizeof(OSDPCEvent)
+                          + sizeof(OSTaskDPCStk)
+#endif
 #if (OS_EVENT_EN) && (OS_MAX_EVENTS > 0)
                           + sizeof(OSEventFreeList)
                           + sizeof(OSEventTbl)
@@ -229,6 +260,10 @@ void  OSDebugInit (void)
     
     ptemp = (void *)&OSDebugEn;
 
+    ptemp = (void *)&OSDPCEn;
+    ptemp = (void *)&OSDPCQSize;
+    ptemp = (void *)&OSDPCTblSize;
+
     ptemp = (void *)&OSEndiannessTest;
 
     ptemp = (void *)&OSEventMax;
@@ -256,6 +291,7 @@ void  OSDebugInit (void)
     ptemp = (void *)&OSMemTblSize;
 
     ptemp = (void *)&OSMutexEn;
+    ptemp = (void *)&OSMutexCeilingEn;
 
     ptemp = (void *)&OSPtrSize;
 
@@ -265,6 +301,11 @@ void  OSDebugInit (void)
 
     ptemp = (void *)&OSRdyTblSize;
 
+    ptemp = (void *)&OSRWLockEn;
+
+    ptemp = (void *)&OSSchedRREn;
+    ptemp = (void *)&OSSchedRRQuanta;
+
     ptemp = (void *)&OSSemEn;
 
     ptemp = (void *)&OSStkWidth;
@@ -1014,6 +1014,9 @@ static  void  OS_FlagBlock (OS_FLAG_GRP *pgrp, OS_FLAG_NODE *pnode, OS_FLAGS fla
     if (OSRdyTbl[y] == 0x00) {
         OSRdyGrp &= ~OSTCBCur->OSTCBBitY;
     }
+#if OS_SCHED_RR_EN > 0
+    OS_SchedRRUpdate(OSTCBCur->OSTCBPrio);            /* Keep prio ready if shared with a ready task   */
+#endif
 }
 
 /*$PAGE*/
@@ -1112,6 +1115,9 @@ static  BOOLEAN  OS_FlagTaskRdy (OS_FLAG_NODE *pnode, OS_FLAGS flags_rdy)
     if (ptcb->OSTCBStat == OS_STAT_RDY) {                  /* Task now ready?                          */
         OSRdyGrp               |= ptcb->OSTCBBitY;         /* Put task into ready list                 */
         OSRdyTbl[ptcb->OSTCBY] |= ptcb->OSTCBBitX;
+#if OS_SCHED_RR_EN > 0
+        OS_SchedRRUpdate(ptcb->OSTCBPrio);
+#endif
         sched                   = OS_TRUE;
     } else {
         sched                   = OS_FALSE;
@@ -46,6 +46,12 @@
 
 static  void  OSMutex_RdyAtPrio(OS_TCB *ptcb, INT8U prio);
 
+#if OS_MUTEX_CEILING_EN > 0
+static  INT8U  OSMutex_CeilAcquire(OS_EVENT *pevent, OS_TCB *ptcb);
+
+static  void  OSMutex_CeilRelease(OS_EVENT *pevent, OS_TCB *ptcb);
+#endif
+
 /*$PAGE*/
 /*
 *********************************************************************************************************
@@ -77,13 +83,18 @@ static  void  OSMutex_RdyAtPrio(OS_TCB *ptcb, INT8U prio);
 *
 * Warning(s) : This function CANNOT be called from an ISR because mutual exclusion semaphores are
 *              intended to be used by tasks only.
+*
+* Note(s)    : 1) When OS_MUTEX_CEILING_EN is enabled, the calling task is raised to the PIP as soon as
+*                 it acquires the mutex (see OSMutexPend()).
 *********************************************************************************************************
 */
 
 #if OS_MUTEX_ACCEPT_EN > 0
 BOOLEAN  OSMutexAccept (OS_EVENT *pevent, INT8U *perr)
 {
+#if OS_MUTEX_CEILING_EN == 0
     INT8U      pip;                                    /* Priority Inheritance Priority (PIP)          */
+#endif
 #if OS_CRITICAL_METHOD == 3                            /* Allocate storage for CPU status register     */
     OS_CPU_SR  cpu_sr = 0;
 #endif
@@ -108,6 +119,13 @@ BOOLEAN  OSMutexAccept (OS_EVENT *pevent, INT8U *perr)
         return (OS_FALSE);
     }
     OS_ENTER_CRITICAL();                               /* Get value (0 or 1) of Mutex                  */
+#if OS_MUTEX_CEILING_EN > 0
+    if ((pevent->OSEventCnt & OS_MUTEX_KEEP_LOWER_8) == OS_MUTEX_AVAILABLE) {
+        *perr = OSMutex_CeilAcquire(pevent, OSTCBCur); /*      Acquire Mutex and raise task to PIP     */
+        OS_EXIT_CRITICAL();
+        return (OS_TRUE);
+    }
+#else
     pip = (INT8U)(pevent->OSEventCnt >> 8);            /* Get PIP from mutex                           */
     if ((pevent->OSEventCnt & OS_MUTEX_KEEP_LOWER_8) == OS_MUTEX_AVAILABLE) {
         pevent->OSEventCnt &= OS_MUTEX_KEEP_UPPER_8;   /*      Mask off LSByte (Acquire Mutex)         */
@@ -122,6 +140,7 @@ BOOLEAN  OSMutexAccept (OS_EVENT *pevent, INT8U *perr)
         }
         return (OS_TRUE);
     }
+#endif
     OS_EXIT_CRITICAL();
     *perr = OS_ERR_NONE;
     return (OS_FALSE);
@@ -160,6 +179,9 @@ BOOLEAN  OSMutexAccept (OS_EVENT *pevent, INT8U *perr)
 *
 *              2) The MOST  significant 8 bits of '.OSEventCnt' are used to hold the priority number
 *                 to use to reduce priority inversion.
+*
+*              3) When OS_MUTEX_CEILING_EN is enabled, 'prio' is the priority ceiling of the mutex: the
+*                 owner runs at this priority for as long as it holds the mutex.
 *********************************************************************************************************
 */
 
@@ -247,10 +269,9 @@ OS_EVENT  *OSMutexCreate (INT8U prio, INT8U *perr)
 *              3) Because ALL tasks pending on the mutex will be readied, you MUST be careful because the
 *                 resource(s) will no longer be guarded by the mutex.
 *
-*              4) IMPORTANT: In the 'OS_DEL_ALWAYS' case, we assume that the owner of the Mutex (if there
-*                            is one) is ready-to-run and is thus NOT pending on another kernel object or
-*                            has delayed itself.  In other words, if a task owns the mutex being deleted,
-*                            that task will be made ready-to-run at its original priority.
+*              4) IMPORTANT: In the 'OS_DEL_ALWAYS' case, the owner of the Mutex (if there is one) is put
+*                            back at its original priority.  It is only made ready-to-run at that priority
+*                            if it was ready-to-run; an owner that is pending, delayed or suspended stays so.
 *********************************************************************************************************
 */
 
@@ -260,7 +281,9 @@ OS_EVENT  *OSMutexDel (OS_EVENT *pevent, INT8U opt, INT8U *perr)
     BOOLEAN    tasks_waiting;
     OS_EVENT  *pevent_return;
     INT8U      pip;                                        /* Priority inheritance priority            */
+#if OS_MUTEX_CEILING_EN == 0
     INT8U      prio;
+#endif
     OS_TCB    *ptcb;
 #if OS_CRITICAL_METHOD == 3                                /* Allocate storage for CPU status register */
     OS_CPU_SR  cpu_sr = 0;
@@ -315,13 +338,17 @@ OS_EVENT  *OSMutexDel (OS_EVENT *pevent, INT8U opt, INT8U *perr)
              break;
 
         case OS_DEL_ALWAYS:                                /* ALWAYS DELETE THE MUTEX ---------------- */
-             pip  = (INT8U)(pevent->OSEventCnt >> 8);                     /* Get PIP of mutex          */
-             prio = (INT8U)(pevent->OSEventCnt & OS_MUTEX_KEEP_LOWER_8);  /* Get owner's original prio */
              ptcb = (OS_TCB *)pevent->OSEventPtr;
              if (ptcb != (OS_TCB *)0) {                    /* See if any task owns the mutex           */
+#if OS_MUTEX_CEILING_EN > 0
+                 OSMutex_CeilRelease(pevent, ptcb);        /* Drop to ceiling of mutexes still held    */
+#else
+                 pip  = (INT8U)(pevent->OSEventCnt >> 8);                     /* Get PIP of mutex      */
+                 prio = (INT8U)(pevent->OSEventCnt & OS_MUTEX_KEEP_LOWER_8);  /* Get owner's prio      */
                  if (ptcb->OSTCBPrio == pip) {             /* See if original prio was changed         */
                      OSMutex_RdyAtPrio(ptcb, prio);        /* Yes, Restore the task's original prio    */
                  }
+#endif
              }
              while (pevent->OSEventGrp != 0) {             /* Ready ALL tasks waiting for mutex        */
                  (void)OS_EventTaskRdy(pevent, (void *)0, OS_STAT_MUTEX, OS_STAT_PEND_OK);
@@ -392,17 +419,29 @@ OS_EVENT  *OSMutexDel (OS_EVENT *pevent, INT8U opt, INT8U *perr)
 * Note(s)    : 1) The task that owns the Mutex MUST NOT pend on any other event while it owns the mutex.
 *
 *              2) You MUST NOT change the priority of the task that owns the mutex
+*
+*              3) A round-robin task raised to the PIP stays linked with the tasks sharing its original
+*                 priority, but is not time sliced with them until it releases the mutex.
+*
+*              4) When OS_MUTEX_CEILING_EN is enabled, the mutex uses the immediate priority ceiling
+*                 protocol: the task acquiring the mutex is raised to the PIP right away and nothing is
+*                 done to the owner when another task has to wait.  A task may hold several mutexes and
+*                 release them in any order; it always runs at the highest ceiling of the mutexes it
+*                 still holds, or at its own priority once it holds none.  Note 1 does not apply in this
+*                 mode.
 *********************************************************************************************************
 */
 
 void  OSMutexPend (OS_EVENT *pevent, INT16U timeout, INT8U *perr)
 {
+#if OS_MUTEX_CEILING_EN == 0
     INT8U      pip;                                        /* Priority Inheritance Priority (PIP)      */
     INT8U      mprio;                                      /* Mutex owner priority                     */
     BOOLEAN    rdy;                                        /* Flag indicating task was ready           */
     OS_TCB    *ptcb;
     OS_EVENT  *pevent2;
     INT8U      y;
+#endif
 #if OS_CRITICAL_METHOD == 3                                /* Allocate storage for CPU status register */
     OS_CPU_SR  cpu_sr = 0;
 #endif
@@ -432,6 +471,14 @@ void  OSMutexPend (OS_EVENT *pevent, INT16U timeout, INT8U *perr)
     }
 /*$PAGE*/
     OS_ENTER_CRITICAL();
+#if OS_MUTEX_CEILING_EN > 0
+                                                           /* Is Mutex available?                      */
+    if ((INT8U)(pevent->OSEventCnt & OS_MUTEX_KEEP_LOWER_8) == OS_MUTEX_AVAILABLE) {
+        *perr = OSMutex_CeilAcquire(pevent, OSTCBCur);     /* Yes, Acquire it and raise task to PIP    */
+        OS_EXIT_CRITICAL();
+        return;
+    }                                                      /* No,  owner already runs at the ceiling   */
+#else
     pip = (INT8U)(pevent->OSEventCnt >> 8);                /* Get PIP from mutex                       */
                                                            /* Is Mutex available?                      */
     if ((INT8U)(pevent->OSEventCnt & OS_MUTEX_KEEP_LOWER_8) == OS_MUTEX_AVAILABLE) {
@@ -452,7 +499,12 @@ void  OSMutexPend (OS_EVENT *pevent, INT16U timeout, INT8U *perr)
     if (ptcb->OSTCBPrio > pip) {                                  /*     Need to promote prio of owner?*/
         if (mprio > OSTCBCur->OSTCBPrio) {
             y = ptcb->OSTCBY;
+#if OS_SCHED_RR_EN > 0                                            /*     Rdy bit may be shared, so ... */
+            if (((ptcb->OSTCBStat & (OS_STAT_PEND_ANY | OS_STAT_SUSPEND)) == OS_STAT_RDY) &&
+                (ptcb->OSTCBDly == 0)) {                          /*     ... look at owner's state     */
+#else
             if ((OSRdyTbl[y] & ptcb->OSTCBBitX) != 0) {           /*     See if mutex owner is ready   */
+#endif
                 OSRdyTbl[y] &= ~ptcb->OSTCBBitX;                  /*     Yes, Remove owner from Rdy ...*/
                 if (OSRdyTbl[y] == 0) {                           /*          ... list at current prio */
                     OSRdyGrp &= ~ptcb->OSTCBBitY;
@@ -461,9 +513,7 @@ void  OSMutexPend (OS_EVENT *pevent, INT16U timeout, INT8U *perr)
             } else {
                 pevent2 = ptcb->OSTCBEventPtr;
                 if (pevent2 != (OS_EVENT *)0) {                   /* Remove from event wait list       */
-                    if ((pevent2->OSEventTbl[ptcb->OSTCBY] &= ~ptcb->OSTCBBitX) == 0) {
-                        pevent2->OSEventGrp &= ~ptcb->OSTCBBitY;
-                    }
+                    OS_EventTaskRemove(ptcb, pevent2);
                 }
                 rdy = OS_FALSE;                            /* No                                       */
             }
@@ -490,8 +540,12 @@ void  OSMutexPend (OS_EVENT *pevent, INT16U timeout, INT8U *perr)
                 }
             }
             OSTCBPrioTbl[pip] = ptcb;
+#if OS_SCHED_RR_EN > 0
+            OS_SchedRRUpdate(mprio);                       /* Other tasks at owner's prio keep running */
+#endif
         }
     }
+#endif
     OSTCBCur->OSTCBStat     |= OS_STAT_MUTEX;         /* Mutex not available, pend current task        */
     OSTCBCur->OSTCBStatPend  = OS_STAT_PEND_OK;
     OSTCBCur->OSTCBDly       = timeout;               /* Store timeout in current task's TCB           */
@@ -544,6 +598,9 @@ void  OSMutexPend (OS_EVENT *pevent, INT16U timeout, INT8U *perr)
 *                                      Unfortunately, this is something that could not be
 *                                      detected when the Mutex is created because we don't know
 *                                      what tasks will be using the Mutex.
+*
+* Note(s)    : 1) When OS_MUTEX_CEILING_EN is enabled, the task that receives the mutex is raised to the
+*                 PIP before the scheduler runs.
 *********************************************************************************************************
 */
 
@@ -551,6 +608,10 @@ INT8U  OSMutexPost (OS_EVENT *pevent)
 {
     INT8U      pip;                                   /* Priority inheritance priority                 */
     INT8U      prio;
+#if OS_MUTEX_CEILING_EN > 0
+    OS_TCB    *ptcb;
+    INT8U      err;
+#endif
 #if OS_CRITICAL_METHOD == 3                           /* Allocate storage for CPU status register      */
     OS_CPU_SR  cpu_sr = 0;
 #endif
@@ -575,16 +636,35 @@ INT8U  OSMutexPost (OS_EVENT *pevent)
         OS_EXIT_CRITICAL();
         return (OS_ERR_NOT_MUTEX_OWNER);
     }
+#if OS_MUTEX_CEILING_EN > 0
+    OSMutex_CeilRelease(pevent, OSTCBCur);            /* Drop to ceiling of the mutexes still held     */
+#else
     if (OSTCBCur->OSTCBPrio == pip) {                 /* Did we have to raise current task's priority? */
         OSMutex_RdyAtPrio(OSTCBCur, prio);            /* Restore the task's original priority          */
     }
+#endif
     OSTCBPrioTbl[pip] = OS_TCB_RESERVED;              /* Reserve table entry                           */
     if (pevent->OSEventGrp != 0) {                    /* Any task waiting for the mutex?               */
                                                       /* Yes, Make HPT waiting for mutex ready         */
         prio                = OS_EventTaskRdy(pevent, (void *)0, OS_STAT_MUTEX, OS_STAT_PEND_OK);
+#if OS_MUTEX_CEILING_EN > 0
+#if OS_SCHED_RR_EN > 0
+        ptcb                = OSTCBEventRdy;          /*      Priority may be shared, use readied TCB  */
+#else
+        ptcb                = OSTCBPrioTbl[prio];
+#endif
+        err                 = OSMutex_CeilAcquire(pevent, ptcb);  /* New owner runs at the ceiling     */
+        OS_EXIT_CRITICAL();
+        OS_Sched();                                   /*      Find highest priority task ready to run  */
+        return (err);
+#else
         pevent->OSEventCnt &= OS_MUTEX_KEEP_UPPER_8;  /*      Save priority of mutex's new owner       */
         pevent->OSEventCnt |= prio;
+#if OS_SCHED_RR_EN > 0
+        pevent->OSEventPtr  = OSTCBEventRdy;          /*      Priority may be shared, use readied TCB  */
+#else
         pevent->OSEventPtr  = OSTCBPrioTbl[prio];     /*      Link to new mutex owner's OS_TCB         */
+#endif
         if (prio <= pip) {                            /*      PIP 'must' have a SMALLER prio ...       */
             OS_EXIT_CRITICAL();                       /*      ... than current task!                   */
             OS_Sched();                               /*      Find highest priority task ready to run  */
@@ -594,6 +674,7 @@ INT8U  OSMutexPost (OS_EVENT *pevent)
             OS_Sched();                               /*      Find highest priority task ready to run  */
             return (OS_ERR_NONE);
         }
+#endif
     }
     pevent->OSEventCnt |= OS_MUTEX_AVAILABLE;         /* No,  Mutex is now available                   */
     pevent->OSEventPtr  = (void *)0;
@@ -672,27 +753,43 @@ INT8U  OSMutexQuery (OS_EVENT *pevent, OS_MUTEX_DATA *p_mutex_data)
 /*$PAGE*/
 /*
 *********************************************************************************************************
-*                                RESTORE A TASK BACK TO ITS ORIGINAL PRIORITY
+*                                    MOVE A TASK TO ANOTHER PRIORITY
 *
-* Description: This function makes a task ready at the specified priority
+* Description: This function changes the priority of a task that owns a mutex.  A task that is ready-to-run
+*              is made ready at the new priority.  A task that is pending, delayed or suspended is NOT made
+*              ready; if it is in an event's wait list, it is moved to the new priority in that list.
 *
-* Arguments  : ptcb            is a pointer to OS_TCB of the task to make ready
+* Arguments  : ptcb            is a pointer to OS_TCB of the task to move
 *
 *              prio            is the desired priority
 *
 * Returns    : none
+*
+* Note(s)    : 1) This function is INTERNAL to uC/OS-II and must be called with interrupts disabled.
 *********************************************************************************************************
 */
 
 static  void  OSMutex_RdyAtPrio (OS_TCB *ptcb, INT8U prio)
 {
-    INT8U   y;
+    INT8U      y;
+    BOOLEAN    rdy;
+    OS_EVENT  *pevent;
 
 
-    y            =  ptcb->OSTCBY;                          /* Remove owner from ready list at 'pip'    */
-    OSRdyTbl[y] &= ~ptcb->OSTCBBitX;
-    if (OSRdyTbl[y] == 0) {
-        OSRdyGrp &= ~ptcb->OSTCBBitY;
+    if (((ptcb->OSTCBStat & (OS_STAT_PEND_ANY | OS_STAT_SUSPEND)) == OS_STAT_RDY) &&
+        (ptcb->OSTCBDly == 0)) {                           /* See if task is ready-to-run              */
+        y            =  ptcb->OSTCBY;                      /* Yes, Remove task from ready list         */
+        OSRdyTbl[y] &= ~ptcb->OSTCBBitX;
+        if (OSRdyTbl[y] == 0) {
+            OSRdyGrp &= ~ptcb->OSTCBBitY;
+        }
+        rdy = OS_TRUE;
+    } else {
+        rdy = OS_FALSE;                                    /* No,  leave it out of the ready list      */
+    }
+    pevent = ptcb->OSTCBEventPtr;
+    if (pevent != (OS_EVENT *)0) {                         /* Remove from event wait list              */
+        OS_EventTaskRemove(ptcb, pevent);
     }
     ptcb->OSTCBPrio         = prio;
 #if OS_LOWEST_PRIO <= 63
@@ -706,10 +803,123 @@ static  void  OSMutex_RdyAtPrio (OS_TCB *ptcb, INT8U prio)
     ptcb->OSTCBBitY         = (INT16U)(1 << ptcb->OSTCBY);
     ptcb->OSTCBBitX         = (INT16U)(1 << ptcb->OSTCBX);
 #endif
-    OSRdyGrp               |= ptcb->OSTCBBitY;             /* Make task ready at original priority     */
-    OSRdyTbl[ptcb->OSTCBY] |= ptcb->OSTCBBitX;
+    if (rdy == OS_TRUE) {                                  /* Make task ready at the new priority      */
+        OSRdyGrp               |= ptcb->OSTCBBitY;
+        OSRdyTbl[ptcb->OSTCBY] |= ptcb->OSTCBBitX;
+    }
+    if (pevent != (OS_EVENT *)0) {                         /* Add to event wait list at new priority   */
+        pevent->OSEventGrp               |= ptcb->OSTCBBitY;
+        pevent->OSEventTbl[ptcb->OSTCBY] |= ptcb->OSTCBBitX;
+    }
     OSTCBPrioTbl[prio]      = ptcb;
 }
 
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                              GIVE A MUTEX TO A TASK AND RAISE IT TO THE CEILING
+*
+* Description: This function makes a task the owner of a mutex (priority ceiling mode).  The task's own
+*              priority is saved in the mutex and the task is moved to the mutex's PIP, unless it already
+*              runs at a higher ceiling.
+*
+* Arguments  : pevent          is a pointer to the mutex
+*
+*              ptcb            is a pointer to the OS_TCB of the new owner.  The task is either running or
+*                              was just readied by OS_EventTaskRdy().
+*
+* Returns    : OS_ERR_NONE         if the task now runs at or above the ceiling
+*              OS_ERR_PIP_LOWER    if the task's own priority was already at or above the ceiling
+*
+* Note(s)    : 1) This function is INTERNAL to uC/OS-II and must be called with interrupts disabled.
+*              2) A task that already holds another mutex may legitimately be above the ceiling.
+*              3) The task's own priority is recorded in OSTCBBasePrio when it acquires its first mutex
+*                 and is what the task returns to once it releases its last one.
+*********************************************************************************************************
+*/
+
+#if OS_MUTEX_CEILING_EN > 0
+static  INT8U  OSMutex_CeilAcquire (OS_EVENT *pevent, OS_TCB *ptcb)
+{
+    INT8U   pip;
+    INT8U   prio;
+
+
+    pip                 = (INT8U)(pevent->OSEventCnt >> 8);
+    prio                = ptcb->OSTCBPrio;
+    if (ptcb->OSTCBMutexCtr == 0) {                        /* Not raised by any ceiling yet            */
+        ptcb->OSTCBBasePrio = prio;
+    }
+    pevent->OSEventCnt &= OS_MUTEX_KEEP_UPPER_8;           /* Save the owner's own priority            */
+    pevent->OSEventCnt |= ptcb->OSTCBBasePrio;
+    pevent->OSEventPtr  = (void *)ptcb;                    /* Link TCB of task owning the mutex        */
+    ptcb->OSTCBMutexCtr++;
+    if (prio > pip) {                                      /* Raise the owner to the ceiling           */
+        OSMutex_RdyAtPrio(ptcb, pip);
+#if OS_SCHED_RR_EN > 0
+        OS_SchedRRUpdate(prio);                            /* Other tasks at owner's prio keep running */
+#endif
+    }
+    if (ptcb->OSTCBBasePrio <= pip) {                      /* PIP 'must' have a SMALLER prio than task */
+        return (OS_ERR_PIP_LOWER);
+    }
+    return (OS_ERR_NONE);
+}
+#endif
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                              TAKE A MUTEX AWAY FROM ITS OWNER (CEILING MODE)
+*
+* Description: This function undoes OSMutex_CeilAcquire() when the owner releases the mutex.  The owner is
+*              moved to the highest ceiling among the mutexes it still holds or, if it holds none, back to
+*              its own priority.  Mutexes can thus be released in any order.
+*
+* Arguments  : pevent          is a pointer to the mutex being released
+*
+*              ptcb            is a pointer to the OS_TCB of the owner
+*
+* Returns    : none
+*
+* Note(s)    : 1) This function is INTERNAL to uC/OS-II and must be called with interrupts disabled.
+*              2) The new priority is NOT derived from the owner's current priority, which only tells the
+*                 highest ceiling held so far.
+*********************************************************************************************************
+*/
+
+#if OS_MUTEX_CEILING_EN > 0
+static  void  OSMutex_CeilRelease (OS_EVENT *pevent, OS_TCB *ptcb)
+{
+    OS_EVENT  *pevent2;
+    INT16U     i;
+    INT8U      pip;
+    INT8U      prio;
+
+
+    if (ptcb->OSTCBMutexCtr > 0) {
+        ptcb->OSTCBMutexCtr--;
+    }
+    prio = ptcb->OSTCBBasePrio;                            /* Own priority if no other mutex is held   */
+    if (ptcb->OSTCBMutexCtr > 0) {                         /* Find highest ceiling still held          */
+        pevent2 = &OSEventTbl[0];
+        for (i = 0; i < OS_MAX_EVENTS; i++) {
+            if ((pevent2->OSEventType == OS_EVENT_TYPE_MUTEX) &&
+                (pevent2->OSEventPtr  == (void *)ptcb)        &&
+                (pevent2              != pevent)) {
+                pip = (INT8U)(pevent2->OSEventCnt >> 8);
+                if (pip < prio) {
+                    prio = pip;
+                }
+            }
+            pevent2++;
+        }
+    }
+    if (ptcb->OSTCBPrio != prio) {
+        OSMutex_RdyAtPrio(ptcb, prio);
+    }
+}
+#endif
+
 
 #endif                                                     /* OS_MUTEX_EN                              */
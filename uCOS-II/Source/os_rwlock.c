@@ -0,0 +1,880 @@
+/*
+*********************************************************************************************************
+*                                                uC/OS-II
+*                                          The Real-Time Kernel
+*                                       READER-WRITER LOCK MANAGEMENT
+*
+*                              (c) Copyright 1992-2007, Micrium, Weston, FL
+*                                           All Rights Reserved
+*
+* File    : OS_RWLOCK.C
+* By      : Jean J. Labrosse
+* Version : V2.86
+*
+* LICENSING TERMS:
+* ---------------
+*   uC/OS-II is provided in source form for FREE evaluation, for educational use or for peaceful research.  
+* If you plan on using  uC/OS-II  in a commercial product you need to contact Micrim to properly license 
+* its use in your product. We provide ALL the source code for your convenience and to help you experience 
+* uC/OS-II.   The fact that the  source is provided does  NOT  mean that you can use it without  paying a 
+* licensing fee.
+*********************************************************************************************************
+*/
+
+#ifndef  OS_MASTER_FILE
+#include <ucos_ii.h>
+#endif
+
+#if OS_RWLOCK_EN > 0
+/*
+*********************************************************************************************************
+*                                            LOCAL CONSTANTS
+*********************************************************************************************************
+*/
+
+#define  OS_RWLOCK_KEEP_LOWER_8  ((INT16U)0x00FFu)
+#define  OS_RWLOCK_KEEP_UPPER_8  ((INT16U)0xFF00u)
+
+#define  OS_RWLOCK_WRITER        ((INT16U)0x00FFu)         /* LSByte value when a writer owns the lock */
+#define  OS_RWLOCK_READERS_MAX   ((INT16U)0x00FEu)         /* Maximum number of concurrent readers     */
+
+#if OS_LOWEST_PRIO <= 63
+#define  OS_RWLOCK_ROW_SHIFT     3                         /* Priorities per wait list row: 8 ...      */
+#else
+#define  OS_RWLOCK_ROW_SHIFT     4                         /* ... or 16                                */
+#endif
+
+/*
+*********************************************************************************************************
+*                                       LOCAL FUNCTION PROTOTYPES
+*********************************************************************************************************
+*/
+
+static  void  OSRWLock_Grant(OS_EVENT *pevent);
+
+static  void  OSRWLock_GrantReaders(OS_EVENT *pevent);
+
+static  INT8U  OSRWLock_LowestBit(INT16U bits);
+
+static  OS_TCB  *OSRWLock_WaitFind(OS_EVENT *pevent, INT8U prio, BOOLEAN wr);
+
+static  void  OSRWLock_TaskRdy(OS_TCB *ptcb, OS_EVENT *pevent);
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                      CREATE A READER-WRITER LOCK
+*
+* Description: This function creates a reader-writer lock.  Any number of tasks may hold the lock for
+*              reading at the same time, but a task holding it for writing has exclusive access.
+*
+* Arguments  : none
+*
+* Returns    : != (void *)0  is a pointer to the event control block (OS_EVENT) associated with the
+*                            created lock
+*              == (void *)0  if no event control blocks were available or if called from an ISR
+*
+* Note(s)    : 1) The LEAST significant 8 bits of '.OSEventCnt' hold the number of readers owning the
+*                 lock, or 0xFF if a writer owns the lock.  '.OSEventPtr' points to the writer's OS_TCB.
+*
+*              2) The MOST  significant 8 bits of '.OSEventCnt' hold the number of writers waiting.
+*                 While a writer waits, new readers also wait (writer preference).
+*********************************************************************************************************
+*/
+
+OS_EVENT  *OSRWLockCreate (void)
+{
+    OS_EVENT  *pevent;
+#if OS_CRITICAL_METHOD == 3                                /* Allocate storage for CPU status register */
+    OS_CPU_SR  cpu_sr = 0;
+#endif
+
+
+
+    if (OSIntNesting > 0) {                                /* See if called from ISR ...               */
+        return ((OS_EVENT *)0);                            /* ... can't CREATE from an ISR             */
+    }
+    OS_ENTER_CRITICAL();
+    pevent = OSEventFreeList;                              /* Get next free event control block        */
+    if (OSEventFreeList != (OS_EVENT *)0) {                /* See if pool of free ECB pool was empty   */
+        OSEventFreeList = (OS_EVENT *)OSEventFreeList->OSEventPtr;
+    }
+    OS_EXIT_CRITICAL();
+    if (pevent != (OS_EVENT *)0) {                         /* Get an event control block               */
+        pevent->OSEventType    = OS_EVENT_TYPE_RWLOCK;
+        pevent->OSEventCnt     = 0;                        /* No owner and no writer waiting           */
+        pevent->OSEventPtr     = (void *)0;                /* Unlink from ECB free list                */
+#if OS_EVENT_NAME_SIZE > 1
+        pevent->OSEventName[0] = '?';                      /* Unknown name                             */
+        pevent->OSEventName[1] = OS_ASCII_NUL;
+#endif
+        OS_EventWaitListInit(pevent);                      /* Initialize to 'nobody waiting' on lock   */
+    }
+    return (pevent);
+}
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                     DELETE A READER-WRITER LOCK
+*
+* Description: This function deletes a reader-writer lock and readies all tasks pending on it.
+*
+* Arguments  : pevent        is a pointer to the event control block associated with the desired lock.
+*
+*              opt           determines delete options as follows:
+*                            opt == OS_DEL_NO_PEND   Delete the lock ONLY if no task pending
+*                            opt == OS_DEL_ALWAYS    Deletes the lock even if tasks are waiting.
+*                                                    In this case, all the tasks pending will be readied.
+*
+*              perr          is a pointer to an error code that can contain one of the following values:
+*                            OS_ERR_NONE             The call was successful and the lock was deleted
+*                            OS_ERR_DEL_ISR          If you attempted to delete the lock from an ISR
+*                            OS_ERR_INVALID_OPT      An invalid option was specified
+*                            OS_ERR_TASK_WAITING     One or more tasks were waiting on the lock
+*                            OS_ERR_EVENT_TYPE       If you didn't pass a pointer to a reader-writer lock
+*                            OS_ERR_PEVENT_NULL      If 'pevent' is a NULL pointer.
+*
+* Returns    : pevent        upon error
+*              (OS_EVENT *)0 if the lock was successfully deleted.
+*
+* Note(s)    : 1) This function must be used with care.  Tasks that would normally expect the presence of
+*                 the lock MUST check the return code of OSRWLockPendRd() and OSRWLockPendWr().
+*              2) In the 'OS_DEL_ALWAYS' case, the waiting tasks are readied with OS_ERR_PEND_ABORT.
+*              3) This call can potentially disable interrupts for a long time.  The interrupt disable
+*                 time is directly proportional to the number of tasks waiting on the lock.
+*********************************************************************************************************
+*/
+
+#if OS_RWLOCK_DEL_EN > 0
+OS_EVENT  *OSRWLockDel (OS_EVENT *pevent, INT8U opt, INT8U *perr)
+{
+    BOOLEAN    tasks_waiting;
+    OS_EVENT  *pevent_return;
+#if OS_CRITICAL_METHOD == 3                                /* Allocate storage for CPU status register */
+    OS_CPU_SR  cpu_sr = 0;
+#endif
+
+
+
+#if OS_ARG_CHK_EN > 0
+    if (perr == (INT8U *)0) {                              /* Validate 'perr'                          */
+        return (pevent);
+    }
+    if (pevent == (OS_EVENT *)0) {                         /* Validate 'pevent'                        */
+        *perr = OS_ERR_PEVENT_NULL;
+        return (pevent);
+    }
+#endif
+    if (pevent->OSEventType != OS_EVENT_TYPE_RWLOCK) {     /* Validate event block type                */
+        *perr = OS_ERR_EVENT_TYPE;
+        return (pevent);
+    }
+    if (OSIntNesting > 0) {                                /* See if called from ISR ...               */
+        *perr = OS_ERR_DEL_ISR;                            /* ... can't DELETE from an ISR             */
+        return (pevent);
+    }
+    OS_ENTER_CRITICAL();
+    if (pevent->OSEventGrp != 0) {                         /* See if any tasks waiting on lock         */
+        tasks_waiting = OS_TRUE;                           /* Yes                                      */
+    } else {
+        tasks_waiting = OS_FALSE;                          /* No                                       */
+    }
+    switch (opt) {
+        case OS_DEL_NO_PEND:                               /* Delete lock only if no task waiting      */
+             if (tasks_waiting == OS_FALSE) {
+#if OS_EVENT_NAME_SIZE > 1
+                 pevent->OSEventName[0] = '?';             /* Unknown name                             */
+                 pevent->OSEventName[1] = OS_ASCII_NUL;
+#endif
+                 pevent->OSEventType    = OS_EVENT_TYPE_UNUSED;
+                 pevent->OSEventPtr     = OSEventFreeList; /* Return Event Control Block to free list  */
+                 pevent->OSEventCnt     = 0;
+                 OSEventFreeList        = pevent;          /* Get next free event control block        */
+                 OS_EXIT_CRITICAL();
+                 *perr                  = OS_ERR_NONE;
+                 pevent_return          = (OS_EVENT *)0;   /* Lock has been deleted                    */
+             } else {
+                 OS_EXIT_CRITICAL();
+                 *perr                  = OS_ERR_TASK_WAITING;
+                 pevent_return          = pevent;
+             }
+             break;
+
+        case OS_DEL_ALWAYS:                                /* Always delete the lock                   */
+             while (pevent->OSEventGrp != 0) {             /* Ready ALL tasks waiting for the lock     */
+                 (void)OS_EventTaskRdy(pevent, (void *)0, OS_STAT_RWLOCK, OS_STAT_PEND_ABORT);
+             }
+#if OS_EVENT_NAME_SIZE > 1
+             pevent->OSEventName[0] = '?';                 /* Unknown name                             */
+             pevent->OSEventName[1] = OS_ASCII_NUL;
+#endif
+             pevent->OSEventType    = OS_EVENT_TYPE_UNUSED;
+             pevent->OSEventPtr     = OSEventFreeList;     /* Return Event Control Block to free list  */
+             pevent->OSEventCnt     = 0;
+             OSEventFreeList        = pevent;              /* Get next free event control block        */
+             OS_EXIT_CRITICAL();
+             if (tasks_waiting == OS_TRUE) {               /* Reschedule only if task(s) were waiting  */
+                 OS_Sched();                               /* Find highest priority task ready to run  */
+             }
+             *perr                  = OS_ERR_NONE;
+             pevent_return          = (OS_EVENT *)0;       /* Lock has been deleted                    */
+             break;
+
+        default:
+             OS_EXIT_CRITICAL();
+             *perr                  = OS_ERR_INVALID_OPT;
+             pevent_return          = pevent;
+             break;
+    }
+    return (pevent_return);
+}
+#endif
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                     ACQUIRE A LOCK FOR READING
+*
+* Description: This function waits until the reader-writer lock can be shared with the calling task.
+*
+* Arguments  : pevent        is a pointer to the event control block associated with the desired lock.
+*
+*              timeout       is an optional timeout period (in clock ticks).  If non-zero, your task will
+*                            wait for the lock up to the amount of time specified by this argument.
+*                            If you specify 0, however, your task will wait forever.
+*
+*              perr          is a pointer to where an error message will be deposited.  Possible error
+*                            messages are:
+*
+*                            OS_ERR_NONE         The call was successful and your task shares the lock.
+*                            OS_ERR_TIMEOUT      The lock was not obtained within the specified 'timeout'.
+*                            OS_ERR_PEND_ABORT   The lock was deleted while the task was waiting.
+*                            OS_ERR_EVENT_TYPE   If you didn't pass a pointer to a reader-writer lock.
+*                            OS_ERR_PEND_ISR     If you called this function from an ISR.
+*                            OS_ERR_PEVENT_NULL  If 'pevent' is a NULL pointer.
+*                            OS_ERR_PEND_LOCKED  If you called this function when the scheduler is locked
+*
+* Returns    : none
+*
+* Note(s)    : 1) The task waits while a writer owns the lock OR while a writer is waiting for it.
+*              2) You MUST call OSRWLockPostRd() once for every successful call to OSRWLockPendRd().
+*********************************************************************************************************
+*/
+
+void  OSRWLockPendRd (OS_EVENT *pevent, INT16U timeout, INT8U *perr)
+{
+    INT8U      readers;
+#if OS_CRITICAL_METHOD == 3                           /* Allocate storage for CPU status register      */
+    OS_CPU_SR  cpu_sr = 0;
+#endif
+
+
+
+#if OS_ARG_CHK_EN > 0
+    if (perr == (INT8U *)0) {                         /* Validate 'perr'                               */
+        return;
+    }
+    if (pevent == (OS_EVENT *)0) {                    /* Validate 'pevent'                             */
+        *perr = OS_ERR_PEVENT_NULL;
+        return;
+    }
+#endif
+    if (pevent->OSEventType != OS_EVENT_TYPE_RWLOCK) {/* Validate event block type                     */
+        *perr = OS_ERR_EVENT_TYPE;
+        return;
+    }
+    if (OSIntNesting > 0) {                           /* See if called from ISR ...                    */
+        *perr = OS_ERR_PEND_ISR;                      /* ... can't PEND from an ISR                    */
+        return;
+    }
+    if (OSLockNesting > 0) {                          /* See if called with scheduler locked ...       */
+        *perr = OS_ERR_PEND_LOCKED;                   /* ... can't PEND when locked                    */
+        return;
+    }
+    OS_ENTER_CRITICAL();
+    readers = (INT8U)(pevent->OSEventCnt & OS_RWLOCK_KEEP_LOWER_8);
+    if (((pevent->OSEventCnt & OS_RWLOCK_KEEP_UPPER_8) == 0) &&    /* No writer waiting and ...        */
+        (readers < OS_RWLOCK_READERS_MAX)) {                       /* ... no writer owning the lock    */
+        pevent->OSEventCnt++;                         /* Add one reader                                */
+        OS_EXIT_CRITICAL();
+        *perr = OS_ERR_NONE;
+        return;
+    }
+                                                      /* Otherwise, must wait for the writer(s)        */
+    OSTCBCur->OSTCBStat     |= OS_STAT_RWLOCK;        /* Lock not available, pend on lock              */
+    OSTCBCur->OSTCBStatPend  = OS_STAT_PEND_OK;
+    OSTCBCur->OSTCBRWLockWr  = OS_FALSE;              /* Waiting to read                               */
+    OSTCBCur->OSTCBDly       = timeout;               /* Store pend timeout in TCB                     */
+    OS_EventTaskWait(pevent);                         /* Suspend task until lock granted or timeout    */
+    OS_EXIT_CRITICAL();
+    OS_Sched();                                       /* Find next highest priority task ready         */
+    OS_ENTER_CRITICAL();
+    switch (OSTCBCur->OSTCBStatPend) {                /* See if we timed-out or aborted                */
+        case OS_STAT_PEND_OK:                         /* Reader count was incremented by the granter   */
+             *perr = OS_ERR_NONE;
+             break;
+
+        case OS_STAT_PEND_ABORT:
+             *perr = OS_ERR_PEND_ABORT;               /* Indicate that we aborted                      */
+             break;
+
+        case OS_STAT_PEND_TO:
+        default:
+             OS_EventTaskRemove(OSTCBCur, pevent);
+             *perr = OS_ERR_TIMEOUT;                  /* Indicate that we didn't get lock within TO    */
+             break;
+    }
+    OSTCBCur->OSTCBStat          =  OS_STAT_RDY;      /* Set   task  status to ready                   */
+    OSTCBCur->OSTCBStatPend      =  OS_STAT_PEND_OK;  /* Clear pend  status                            */
+    OSTCBCur->OSTCBEventPtr      = (OS_EVENT  *)0;    /* Clear event pointers                          */
+#if (OS_EVENT_MULTI_EN > 0)
+    OSTCBCur->OSTCBEventMultiPtr = (OS_EVENT **)0;
+#endif
+    OS_EXIT_CRITICAL();
+}
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                     ACQUIRE A LOCK FOR WRITING
+*
+* Description: This function waits until the calling task has exclusive access to the reader-writer lock.
+*
+* Arguments  : pevent        is a pointer to the event control block associated with the desired lock.
+*
+*              timeout       is an optional timeout period (in clock ticks).  If non-zero, your task will
+*                            wait for the lock up to the amount of time specified by this argument.
+*                            If you specify 0, however, your task will wait forever.
+*
+*              perr          is a pointer to where an error message will be deposited.  Possible error
+*                            messages are:
+*
+*                            OS_ERR_NONE         The call was successful and your task owns the lock.
+*                            OS_ERR_TIMEOUT      The lock was not obtained within the specified 'timeout'.
+*                            OS_ERR_PEND_ABORT   The lock was deleted while the task was waiting.
+*                            OS_ERR_EVENT_TYPE   If you didn't pass a pointer to a reader-writer lock.
+*                            OS_ERR_PEND_ISR     If you called this function from an ISR.
+*                            OS_ERR_PEVENT_NULL  If 'pevent' is a NULL pointer.
+*                            OS_ERR_PEND_LOCKED  If you called this function when the scheduler is locked
+*
+* Returns    : none
+*
+* Note(s)    : 1) When several writers wait, the highest priority one gets the lock first.
+*              2) The lock is not recursive: a task MUST NOT pend for writing on a lock it already owns.
+*********************************************************************************************************
+*/
+
+void  OSRWLockPendWr (OS_EVENT *pevent, INT16U timeout, INT8U *perr)
+{
+    BOOLEAN    sched;
+#if OS_CRITICAL_METHOD == 3                           /* Allocate storage for CPU status register      */
+    OS_CPU_SR  cpu_sr = 0;
+#endif
+
+
+
+#if OS_ARG_CHK_EN > 0
+    if (perr == (INT8U *)0) {                         /* Validate 'perr'                               */
+        return;
+    }
+    if (pevent == (OS_EVENT *)0) {                    /* Validate 'pevent'                             */
+        *perr = OS_ERR_PEVENT_NULL;
+        return;
+    }
+#endif
+    if (pevent->OSEventType != OS_EVENT_TYPE_RWLOCK) {/* Validate event block type                     */
+        *perr = OS_ERR_EVENT_TYPE;
+        return;
+    }
+    if (OSIntNesting > 0) {                           /* See if called from ISR ...                    */
+        *perr = OS_ERR_PEND_ISR;                      /* ... can't PEND from an ISR                    */
+        return;
+    }
+    if (OSLockNesting > 0) {                          /* See if called with scheduler locked ...       */
+        *perr = OS_ERR_PEND_LOCKED;                   /* ... can't PEND when locked                    */
+        return;
+    }
+    OS_ENTER_CRITICAL();
+    if ((pevent->OSEventCnt & OS_RWLOCK_KEEP_LOWER_8) == 0) {  /* Lock free?                           */
+        pevent->OSEventCnt |= OS_RWLOCK_WRITER;       /* Yes, take it for writing                      */
+        pevent->OSEventPtr  = (void *)OSTCBCur;
+        OS_EXIT_CRITICAL();
+        *perr = OS_ERR_NONE;
+        return;
+    }
+    pevent->OSEventCnt      += 0x0100u;               /* No,  one more writer waiting                  */
+    OSTCBCur->OSTCBStat     |= OS_STAT_RWLOCK;        /* Pend on lock                                  */
+    OSTCBCur->OSTCBStatPend  = OS_STAT_PEND_OK;
+    OSTCBCur->OSTCBRWLockWr  = OS_TRUE;               /* Waiting to write                              */
+    OSTCBCur->OSTCBDly       = timeout;               /* Store pend timeout in TCB                     */
+    OS_EventTaskWait(pevent);                         /* Suspend task until lock granted or timeout    */
+    OS_EXIT_CRITICAL();
+    OS_Sched();                                       /* Find next highest priority task ready         */
+    OS_ENTER_CRITICAL();
+    sched = OS_FALSE;
+    switch (OSTCBCur->OSTCBStatPend) {                /* See if we timed-out or aborted                */
+        case OS_STAT_PEND_OK:                         /* Lock was handed over by the previous owner    */
+             *perr = OS_ERR_NONE;
+             break;
+
+        case OS_STAT_PEND_ABORT:
+             *perr = OS_ERR_PEND_ABORT;               /* Indicate that we aborted                      */
+             break;
+
+        case OS_STAT_PEND_TO:
+        default:
+             OS_RWLockUnlink(OSTCBCur);               /* Readers may no longer have to wait for us     */
+             OS_EventTaskRemove(OSTCBCur, pevent);
+             if (pevent->OSEventGrp != 0) {
+                 sched = OS_TRUE;
+             }
+             *perr = OS_ERR_TIMEOUT;                  /* Indicate that we didn't get lock within TO    */
+             break;
+    }
+    OSTCBCur->OSTCBStat          =  OS_STAT_RDY;      /* Set   task  status to ready                   */
+    OSTCBCur->OSTCBStatPend      =  OS_STAT_PEND_OK;  /* Clear pend  status                            */
+    OSTCBCur->OSTCBEventPtr      = (OS_EVENT  *)0;    /* Clear event pointers                          */
+#if (OS_EVENT_MULTI_EN > 0)
+    OSTCBCur->OSTCBEventMultiPtr = (OS_EVENT **)0;
+#endif
+    OS_EXIT_CRITICAL();
+    if (sched == OS_TRUE) {                           /* Readers may have been readied                 */
+        OS_Sched();
+    }
+}
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                     RELEASE A LOCK HELD FOR READING
+*
+* Description: This function releases a reader-writer lock acquired with OSRWLockPendRd().  When the last
+*              reader leaves, the lock is handed to the highest priority writer waiting, if any.
+*
+* Arguments  : pevent        is a pointer to the event control block associated with the desired lock.
+*
+* Returns    : OS_ERR_NONE              The call was successful.
+*              OS_ERR_EVENT_TYPE        If you didn't pass a pointer to a reader-writer lock
+*              OS_ERR_PEVENT_NULL       If 'pevent' is a NULL pointer.
+*              OS_ERR_POST_ISR          If you called this function from an ISR
+*              OS_ERR_RWLOCK_NOT_RD     If the lock is not held for reading
+*********************************************************************************************************
+*/
+
+INT8U  OSRWLockPostRd (OS_EVENT *pevent)
+{
+    INT8U      readers;
+#if OS_CRITICAL_METHOD == 3                           /* Allocate storage for CPU status register      */
+    OS_CPU_SR  cpu_sr = 0;
+#endif
+
+
+
+    if (OSIntNesting > 0) {                           /* See if called from ISR ...                    */
+        return (OS_ERR_POST_ISR);                     /* ... can't POST from an ISR                    */
+    }
+#if OS_ARG_CHK_EN > 0
+    if (pevent == (OS_EVENT *)0) {                    /* Validate 'pevent'                             */
+        return (OS_ERR_PEVENT_NULL);
+    }
+#endif
+    if (pevent->OSEventType != OS_EVENT_TYPE_RWLOCK) {/* Validate event block type                     */
+        return (OS_ERR_EVENT_TYPE);
+    }
+    OS_ENTER_CRITICAL();
+    readers = (INT8U)(pevent->OSEventCnt & OS_RWLOCK_KEEP_LOWER_8);
+    if ((readers == 0) || (readers == (INT8U)OS_RWLOCK_WRITER)) {
+        OS_EXIT_CRITICAL();
+        return (OS_ERR_RWLOCK_NOT_RD);
+    }
+    pevent->OSEventCnt--;                             /* One reader less                               */
+    if ((readers == 1) && (pevent->OSEventGrp != 0)) {/* Last reader gone and tasks waiting?           */
+        OSRWLock_Grant(pevent);                       /* Yes, hand the lock to a writer                */
+        OS_EXIT_CRITICAL();
+        OS_Sched();                                   /* Find HPT ready to run                         */
+        return (OS_ERR_NONE);
+    }
+    OS_EXIT_CRITICAL();
+    return (OS_ERR_NONE);
+}
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                     RELEASE A LOCK HELD FOR WRITING
+*
+* Description: This function releases a reader-writer lock acquired with OSRWLockPendWr().  The lock is
+*              handed to the highest priority writer waiting or, if there is none, to ALL the readers
+*              waiting.
+*
+* Arguments  : pevent        is a pointer to the event control block associated with the desired lock.
+*
+* Returns    : OS_ERR_NONE              The call was successful.
+*              OS_ERR_EVENT_TYPE        If you didn't pass a pointer to a reader-writer lock
+*              OS_ERR_PEVENT_NULL       If 'pevent' is a NULL pointer.
+*              OS_ERR_POST_ISR          If you called this function from an ISR
+*              OS_ERR_RWLOCK_NOT_OWNER  If the calling task does not own the lock for writing
+*********************************************************************************************************
+*/
+
+INT8U  OSRWLockPostWr (OS_EVENT *pevent)
+{
+#if OS_CRITICAL_METHOD == 3                           /* Allocate storage for CPU status register      */
+    OS_CPU_SR  cpu_sr = 0;
+#endif
+
+
+
+    if (OSIntNesting > 0) {                           /* See if called from ISR ...                    */
+        return (OS_ERR_POST_ISR);                     /* ... can't POST from an ISR                    */
+    }
+#if OS_ARG_CHK_EN > 0
+    if (pevent == (OS_EVENT *)0) {                    /* Validate 'pevent'                             */
+        return (OS_ERR_PEVENT_NULL);
+    }
+#endif
+    if (pevent->OSEventType != OS_EVENT_TYPE_RWLOCK) {/* Validate event block type                     */
+        return (OS_ERR_EVENT_TYPE);
+    }
+    OS_ENTER_CRITICAL();
+    if (((pevent->OSEventCnt & OS_RWLOCK_KEEP_LOWER_8) != OS_RWLOCK_WRITER) ||
+        (pevent->OSEventPtr != (void *)OSTCBCur)) {   /* See if posting task owns the lock             */
+        OS_EXIT_CRITICAL();
+        return (OS_ERR_RWLOCK_NOT_OWNER);
+    }
+    pevent->OSEventCnt &= OS_RWLOCK_KEEP_UPPER_8;     /* Lock is free ...                              */
+    pevent->OSEventPtr  = (void *)0;
+    if (pevent->OSEventGrp != 0) {                    /* ... unless tasks are waiting for it           */
+        OSRWLock_Grant(pevent);
+        OS_EXIT_CRITICAL();
+        OS_Sched();                                   /* Find HPT ready to run                         */
+        return (OS_ERR_NONE);
+    }
+    OS_EXIT_CRITICAL();
+    return (OS_ERR_NONE);
+}
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                     QUERY A READER-WRITER LOCK
+*
+* Description: This function obtains information about a reader-writer lock.
+*
+* Arguments  : pevent          is a pointer to the event control block associated with the desired lock
+*
+*              p_rwlock_data   is a pointer to a structure that will contain information about the lock
+*
+* Returns    : OS_ERR_NONE          The call was successful
+*              OS_ERR_EVENT_TYPE    If you are attempting to obtain data from a non reader-writer lock
+*              OS_ERR_PEVENT_NULL   If 'pevent'        is a NULL pointer
+*              OS_ERR_PDATA_NULL    If 'p_rwlock_data' is a NULL pointer
+*********************************************************************************************************
+*/
+
+#if OS_RWLOCK_QUERY_EN > 0
+INT8U  OSRWLockQuery (OS_EVENT *pevent, OS_RWLOCK_DATA *p_rwlock_data)
+{
+#if OS_LOWEST_PRIO <= 63
+    INT8U     *psrc;
+    INT8U     *pdest;
+#else
+    INT16U    *psrc;
+    INT16U    *pdest;
+#endif
+    INT8U      i;
+    INT8U      readers;
+#if OS_CRITICAL_METHOD == 3                                /* Allocate storage for CPU status register */
+    OS_CPU_SR  cpu_sr = 0;
+#endif
+
+
+
+#if OS_ARG_CHK_EN > 0
+    if (pevent == (OS_EVENT *)0) {                         /* Validate 'pevent'                        */
+        return (OS_ERR_PEVENT_NULL);
+    }
+    if (p_rwlock_data == (OS_RWLOCK_DATA *)0) {            /* Validate 'p_rwlock_data'                 */
+        return (OS_ERR_PDATA_NULL);
+    }
+#endif
+    if (pevent->OSEventType != OS_EVENT_TYPE_RWLOCK) {     /* Validate event block type                */
+        return (OS_ERR_EVENT_TYPE);
+    }
+    OS_ENTER_CRITICAL();
+    p_rwlock_data->OSEventGrp = pevent->OSEventGrp;        /* Copy wait list                           */
+    psrc                      = &pevent->OSEventTbl[0];
+    pdest                     = &p_rwlock_data->OSEventTbl[0];
+    for (i = 0; i < OS_EVENT_TBL_SIZE; i++) {
+        *pdest++ = *psrc++;
+    }
+    readers = (INT8U)(pevent->OSEventCnt & OS_RWLOCK_KEEP_LOWER_8);
+    if (readers == (INT8U)OS_RWLOCK_WRITER) {              /* Owned by a writer                        */
+        p_rwlock_data->OSNbrReaders = 0;
+        p_rwlock_data->OSWriterPrio = ((OS_TCB *)pevent->OSEventPtr)->OSTCBPrio;
+    } else {
+        p_rwlock_data->OSNbrReaders = readers;
+        p_rwlock_data->OSWriterPrio = 0xFF;                /* No writer                                */
+    }
+    p_rwlock_data->OSNbrWritersWait = (INT8U)(pevent->OSEventCnt >> 8);
+    OS_EXIT_CRITICAL();
+    return (OS_ERR_NONE);
+}
+#endif                                                     /* OS_RWLOCK_QUERY_EN                       */
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                 FORGET A WRITER WAITING ON A LOCK
+*
+* Description: This function is called when a task stops waiting to write-lock a reader-writer lock
+*              without being granted the lock (timeout or task deletion).  If it was the last writer
+*              waiting and no writer owns the lock, the readers that were held back are let in.
+*
+* Arguments  : ptcb          is a pointer to the OS_TCB of the task.
+*
+* Returns    : none
+*
+* Note(s)    : 1) This function is INTERNAL to uC/OS-II and your application should not call it.
+*              2) Interrupts are assumed to be disabled when this function is called.
+*              3) The caller is responsible for removing the task from the wait list and for calling the
+*                 scheduler.
+*********************************************************************************************************
+*/
+
+void  OS_RWLockUnlink (OS_TCB *ptcb)
+{
+    OS_EVENT  *pevent;
+
+
+    pevent = ptcb->OSTCBEventPtr;
+    if ((pevent == (OS_EVENT *)0) || (pevent->OSEventType != OS_EVENT_TYPE_RWLOCK)) {
+        return;
+    }
+    if (ptcb->OSTCBRWLockWr == OS_FALSE) {                 /* Readers are not counted while waiting    */
+        return;
+    }
+    ptcb->OSTCBRWLockWr = OS_FALSE;
+    if ((pevent->OSEventCnt & OS_RWLOCK_KEEP_UPPER_8) != 0) {
+        pevent->OSEventCnt -= 0x0100u;                     /* One writer less waiting                  */
+    }
+    if (((pevent->OSEventCnt & OS_RWLOCK_KEEP_UPPER_8) == 0) &&
+        ((pevent->OSEventCnt & OS_RWLOCK_KEEP_LOWER_8) != OS_RWLOCK_WRITER)) {
+        OSRWLock_GrantReaders(pevent);                     /* Let waiting readers in                   */
+    }
+}
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                   HAND A FREE LOCK TO WAITING TASKS
+*
+* Description: This function is called when a lock becomes free and tasks are waiting.  The lock goes to
+*              the highest priority writer waiting or, if no writer is waiting, to all waiting readers.
+*
+* Arguments  : pevent        is a pointer to the lock.
+*
+* Returns    : none
+*
+* Note(s)    : 1) Interrupts are assumed to be disabled when this function is called.
+*              2) Only the lock's wait list is searched, from its highest priority entry down, so the time
+*                 spent with interrupts disabled depends on the number of tasks waiting, not on the number
+*                 of tasks created.  The first writer found is the highest priority one.
+*********************************************************************************************************
+*/
+
+static  void  OSRWLock_Grant (OS_EVENT *pevent)
+{
+    OS_TCB  *pwr;
+#if OS_LOWEST_PRIO <= 63
+    INT8U    grp;
+    INT8U    row;
+#else
+    INT16U   grp;
+    INT16U   row;
+#endif
+    INT8U    y;
+    INT8U    x;
+
+
+    if ((pevent->OSEventCnt & OS_RWLOCK_KEEP_UPPER_8) == 0) {  /* No writer waiting                    */
+        OSRWLock_GrantReaders(pevent);
+        return;
+    }
+    pwr = (OS_TCB *)0;
+    grp = pevent->OSEventGrp;
+    while ((grp != 0) && (pwr == (OS_TCB *)0)) {           /* Find highest priority writer waiting     */
+        y    = OSRWLock_LowestBit(grp);
+        grp &= ~(1u << y);
+        row  = pevent->OSEventTbl[y];
+        while ((row != 0) && (pwr == (OS_TCB *)0)) {
+            x    = OSRWLock_LowestBit(row);
+            row &= ~(1u << x);
+            pwr  = OSRWLock_WaitFind(pevent, (INT8U)((y << OS_RWLOCK_ROW_SHIFT) + x), OS_TRUE);
+        }
+    }
+    if (pwr == (OS_TCB *)0) {                              /* Count out of sync, let readers in        */
+        pevent->OSEventCnt &= OS_RWLOCK_KEEP_LOWER_8;
+        OSRWLock_GrantReaders(pevent);
+        return;
+    }
+    pevent->OSEventCnt -= 0x0100u;                         /* One writer less waiting ...              */
+    pevent->OSEventCnt |= OS_RWLOCK_WRITER;                /* ... it now owns the lock                 */
+    pevent->OSEventPtr  = (void *)pwr;
+    pwr->OSTCBRWLockWr  = OS_FALSE;
+    OSRWLock_TaskRdy(pwr, pevent);
+}
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                   GRANT A LOCK TO ALL WAITING READERS
+*
+* Description: This function readies every task waiting to read-lock 'pevent' and counts it as a reader.
+*
+* Arguments  : pevent        is a pointer to the lock.
+*
+* Returns    : none
+*
+* Note(s)    : 1) Interrupts are assumed to be disabled when this function is called.
+*              2) The wait list is scanned from a copy of its group bits because readying a task removes
+*                 it from the list.  Readers are admitted in priority order, so if OS_RWLOCK_READERS_MAX
+*                 is reached it is the lowest priority readers that keep waiting.
+*********************************************************************************************************
+*/
+
+static  void  OSRWLock_GrantReaders (OS_EVENT *pevent)
+{
+    OS_TCB  *ptcb;
+#if OS_LOWEST_PRIO <= 63
+    INT8U    grp;
+    INT8U    row;
+#else
+    INT16U   grp;
+    INT16U   row;
+#endif
+    INT8U    y;
+    INT8U    x;
+    INT8U    prio;
+
+
+    grp = pevent->OSEventGrp;                              /* See Note #2                              */
+    while (grp != 0) {
+        y    = OSRWLock_LowestBit(grp);
+        grp &= ~(1u << y);
+        row  = pevent->OSEventTbl[y];
+        while (row != 0) {
+            x    = OSRWLock_LowestBit(row);
+            row &= ~(1u << x);
+            prio = (INT8U)((y << OS_RWLOCK_ROW_SHIFT) + x);
+            ptcb = OSRWLock_WaitFind(pevent, prio, OS_FALSE);
+            while (ptcb != (OS_TCB *)0) {                  /* Every reader waiting at this priority    */
+                if ((pevent->OSEventCnt & OS_RWLOCK_KEEP_LOWER_8) >= OS_RWLOCK_READERS_MAX) {
+                    return;                                /* Remaining readers keep waiting           */
+                }
+                pevent->OSEventCnt++;                      /* One more reader                          */
+                OSRWLock_TaskRdy(ptcb, pevent);
+                ptcb = OSRWLock_WaitFind(pevent, prio, OS_FALSE);
+            }
+        }
+    }
+}
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                    FIND A TASK ON A LOCK'S WAIT LIST
+*
+* Description: OSRWLock_LowestBit() returns the number of the lowest bit set in a wait list group or row.
+*              OSRWLock_WaitFind() returns the task at priority 'prio' that waits on the lock for reading
+*              or for writing, as selected by 'wr'.
+*
+* Arguments  : bits          is the group or row; it MUST not be 0.
+*
+*              pevent        is a pointer to the lock.
+*
+*              prio          is a priority whose bit is set in the lock's wait list.
+*
+*              wr            is OS_TRUE to find a writer, OS_FALSE to find a reader.
+*
+* Returns    : OSRWLock_WaitFind() returns a pointer to the task's OS_TCB, or a NULL pointer if no such
+*              task waits at 'prio'.
+*
+* Note(s)    : 1) Interrupts are assumed to be disabled when these functions are called.
+*              2) With round-robin scheduling several tasks share 'prio'; only their ring is searched.
+*********************************************************************************************************
+*/
+
+static  INT8U  OSRWLock_LowestBit (INT16U bits)
+{
+#if OS_LOWEST_PRIO <= 63
+    return (OSUnMapTbl[bits & 0xFFu]);
+#else
+    if ((bits & 0xFFu) != 0) {
+        return (OSUnMapTbl[bits & 0xFFu]);
+    }
+    return ((INT8U)(OSUnMapTbl[(bits >> 8) & 0xFFu] + 8));
+#endif
+}
+
+
+static  OS_TCB  *OSRWLock_WaitFind (OS_EVENT *pevent, INT8U prio, BOOLEAN wr)
+{
+    OS_TCB  *phead;
+    OS_TCB  *ptcb;
+
+
+    phead = OSTCBPrioTbl[prio];
+    if ((phead == (OS_TCB *)0) || (phead == OS_TCB_RESERVED)) {
+        return ((OS_TCB *)0);
+    }
+    ptcb  = phead;
+    do {
+        if ((ptcb->OSTCBPrio == prio)                           &&
+            ((ptcb->OSTCBStat & OS_STAT_RWLOCK) != OS_STAT_RDY) &&
+            (ptcb->OSTCBEventPtr == pevent)                     &&
+            (ptcb->OSTCBRWLockWr == wr)) {
+            return (ptcb);
+        }
+#if OS_SCHED_RR_EN > 0
+        ptcb = ptcb->OSTCBRRNext;                          /* See Note #2                              */
+#endif
+    } while (ptcb != phead);
+    return ((OS_TCB *)0);
+}
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                 MAKE A TASK WAITING ON A LOCK READY
+*
+* Description: This function readies a specific task waiting on a reader-writer lock.  It is the
+*              equivalent of OS_EventTaskRdy() for a task that is not necessarily the highest priority
+*              task waiting.
+*
+* Arguments  : ptcb          is a pointer to the OS_TCB of the task to ready.
+*
+*              pevent        is a pointer to the lock.
+*
+* Returns    : none
+*
+* Note(s)    : 1) Interrupts are assumed to be disabled when this function is called.
+*********************************************************************************************************
+*/
+
+static  void  OSRWLock_TaskRdy (OS_TCB *ptcb, OS_EVENT *pevent)
+{
+    ptcb->OSTCBDly       =  0;                             /* Prevent OSTimeTick() from readying task  */
+    ptcb->OSTCBStat     &= ~OS_STAT_RWLOCK;                /* Clear bit associated with event type     */
+    ptcb->OSTCBStatPend  =  OS_STAT_PEND_OK;
+    OS_EventTaskRemove(ptcb, pevent);                      /* Remove task from the wait list           */
+    if ((ptcb->OSTCBStat & OS_STAT_SUSPEND) == OS_STAT_RDY) {
+        OSRdyGrp               |= ptcb->OSTCBBitY;         /* Put task in the ready to run list        */
+        OSRdyTbl[ptcb->OSTCBY] |= ptcb->OSTCBBitX;
+#if OS_SCHED_RR_EN > 0
+        OS_SchedRRUpdate(ptcb->OSTCBPrio);
+#endif
+    }
+}
+#endif                                                     /* OS_RWLOCK_EN                             */
@@ -44,6 +44,7 @@
 *              OS_ERR_PRIO            there is no task with the specified OLD priority (i.e. the OLD task does
 *                                     not exist.
 *              OS_ERR_TASK_NOT_EXIST  if the task is assigned to a Mutex PIP.
+*              OS_ERR_TASK_RR_SHARED  if the task shares its priority with other round-robin tasks.
 *********************************************************************************************************
 */
 
@@ -104,6 +105,12 @@ INT8U  OSTaskChangePrio (INT8U oldprio, INT8U newprio)
         OS_EXIT_CRITICAL();                                 /* No, can't change its priority!          */
         return (OS_ERR_TASK_NOT_EXIST);
     }
+#if OS_SCHED_RR_EN > 0
+    if (ptcb->OSTCBRRNext != ptcb) {                        /* Is priority shared with other tasks?    */
+        OS_EXIT_CRITICAL();                                 /* Yes, can't change its priority!         */
+        return (OS_ERR_TASK_RR_SHARED);
+    }
+#endif
 #if OS_LOWEST_PRIO <= 63
     y_new                 = (INT8U)(newprio >> 3);          /* Yes, compute new TCB fields             */
     x_new                 = (INT8U)(newprio & 0x07);
@@ -284,7 +291,8 @@ INT8U  OSTaskCreate (void (*task)(void *p_arg), void *p_arg, OS_STK *ptos, INT8U
 *                        memory locations.  'ptos' MUST point to a valid 'free' data item.
 *
 *              prio      is the task's priority.  A unique priority MUST be assigned to each task and the
-*                        lower the number, the higher the priority.
+*                        lower the number, the higher the priority.  Tasks created with the
+*                        OS_TASK_OPT_SCHED_RR option can however share the same priority (see 'opt').
 *
 *              id        is the task's ID (0..65535)
 *
@@ -314,10 +322,15 @@ INT8U  OSTaskCreate (void (*task)(void *p_arg), void *p_arg, OS_STK *ptos, INT8U
 *                        OS_TASK_OPT_STK_CLR      Clear the stack when the task is created
 *                        OS_TASK_OPT_SAVE_FP      If the CPU has floating-point registers, save them
 *                                                 during a context switch.
+*                        OS_TASK_OPT_SCHED_RR     Allow other tasks created with this option to share
+*                                                 the task's priority.  Tasks sharing a priority run in
+*                                                 turn for OS_SCHED_RR_QUANTA ticks each.  The
+*                                                 priority MUST NOT be the PIP of a mutex.
 *
 * Returns    : OS_ERR_NONE             if the function was successful.
 *              OS_PRIO_EXIT            if the task priority already exist
-*                                      (each task MUST have a unique priority).
+*                                      (each task MUST have a unique priority unless both tasks
+*                                      were created with OS_TASK_OPT_SCHED_RR).
 *              OS_ERR_PRIO_INVALID     if the priority you specify is higher that the maximum allowed
 *                                      (i.e. > OS_LOWEST_PRIO)
 *              OS_ERR_TASK_CREATE_ISR  if you tried to create a task from an ISR.
@@ -337,6 +350,7 @@ INT8U  OSTaskCreateExt (void   (*task)(void *p_arg),
 {
     OS_STK    *psp;
     INT8U      err;
+    OS_TCB    *ptcb;
 #if OS_CRITICAL_METHOD == 3                  /* Allocate storage for CPU status register               */
     OS_CPU_SR  cpu_sr = 0;
 #endif
@@ -353,30 +367,39 @@ INT8U  OSTaskCreateExt (void   (*task)(void *p_arg),
         OS_EXIT_CRITICAL();
         return (OS_ERR_TASK_CREATE_ISR);
     }
-    if (OSTCBPrioTbl[prio] == (OS_TCB *)0) { /* Make sure task doesn't already exist at this priority  */
+    ptcb = OSTCBPrioTbl[prio];
+    if (ptcb == (OS_TCB *)0) {               /* Make sure task doesn't already exist at this priority  */
         OSTCBPrioTbl[prio] = OS_TCB_RESERVED;/* Reserve the priority to prevent others from doing ...  */
                                              /* ... the same thing until task is created.              */
+#if OS_SCHED_RR_EN > 0
+    } else if ((ptcb                    != OS_TCB_RESERVED) &&   /* ... or that the task at this ...   */
+               (ptcb->OSTCBPrio         == prio)            &&   /* ... priority accepts to share it   */
+               ((ptcb->OSTCBOpt & OS_TASK_OPT_SCHED_RR) != 0) &&
+               ((opt            & OS_TASK_OPT_SCHED_RR) != 0)) {
+                                             /* Task will join the round-robin list in OS_TCBInit()    */
+#endif
+    } else {
         OS_EXIT_CRITICAL();
+        return (OS_ERR_PRIO_EXIST);
+    }
+    OS_EXIT_CRITICAL();
 
 #if (OS_TASK_STAT_STK_CHK_EN > 0)
-        OS_TaskStkClr(pbos, stk_size, opt);                    /* Clear the task stack (if needed)     */
+    OS_TaskStkClr(pbos, stk_size, opt);                        /* Clear the task stack (if needed)     */
 #endif
 
-        psp = OSTaskStkInit(task, p_arg, ptos, opt);           /* Initialize the task's stack          */
-        err = OS_TCBInit(prio, psp, pbos, id, stk_size, pext, opt);
-        if (err == OS_ERR_NONE) {
-            if (OSRunning == OS_TRUE) {                        /* Find HPT if multitasking has started */
-                OS_Sched();
-            }
-        } else {
-            OS_ENTER_CRITICAL();
-            OSTCBPrioTbl[prio] = (OS_TCB *)0;                  /* Make this priority avail. to others  */
-            OS_EXIT_CRITICAL();
+    psp = OSTaskStkInit(task, p_arg, ptos, opt);               /* Initialize the task's stack          */
+    err = OS_TCBInit(prio, psp, pbos, id, stk_size, pext, opt);
+    if (err == OS_ERR_NONE) {
+        if (OSRunning == OS_TRUE) {                            /* Find HPT if multitasking has started */
+            OS_Sched();
         }
-        return (err);
+    } else if (ptcb == (OS_TCB *)0) {                          /* Only release priority we reserved    */
+        OS_ENTER_CRITICAL();
+        OSTCBPrioTbl[prio] = (OS_TCB *)0;                      /* Make this priority avail. to others  */
+        OS_EXIT_CRITICAL();
     }
-    OS_EXIT_CRITICAL();
-    return (OS_ERR_PRIO_EXIST);
+    return (err);
 }
 #endif
 /*$PAGE*/
@@ -413,6 +436,8 @@ INT8U  OSTaskCreateExt (void   (*task)(void *p_arg),
 *                 is removed from the ready list.  Incrementing the nesting counter prevents another task
 *                 from being schedule.  This means that an ISR would return to the current task which is
 *                 being deleted.  The rest of the deletion would thus be able to be completed.
+*              5) If round-robin tasks share 'prio', the task that would run next at that priority is
+*                 deleted.  Use OS_PRIO_SELF for a task to delete itself.
 *********************************************************************************************************
 */
 
@@ -465,6 +490,9 @@ INT8U  OSTaskDel (INT8U prio)
     
 #if (OS_EVENT_EN)
     if (ptcb->OSTCBEventPtr != (OS_EVENT *)0) {
+#if OS_RWLOCK_EN > 0
+        OS_RWLockUnlink(ptcb);                          /* Readers may no longer wait for this writer  */
+#endif
         OS_EventTaskRemove(ptcb, ptcb->OSTCBEventPtr);  /* Remove this task from any event   wait list */
     }
 #if (OS_EVENT_MULTI_EN > 0)
@@ -481,6 +509,19 @@ INT8U  OSTaskDel (INT8U prio)
     }
 #endif
 
+#if OS_SCHED_RR_EN > 0
+    if (ptcb->OSTCBRRNext != ptcb) {                    /* Remove from round-robin list                */
+        ptcb->OSTCBRRPrev->OSTCBRRNext = ptcb->OSTCBRRNext;
+        ptcb->OSTCBRRNext->OSTCBRRPrev = ptcb->OSTCBRRPrev;
+        if (OSTCBPrioTbl[prio] == ptcb) {               /* Another task now runs at this priority      */
+            OSTCBPrioTbl[prio] = ptcb->OSTCBRRNext;
+        }
+        ptcb->OSTCBRRNext  = ptcb;
+        ptcb->OSTCBRRPrev  = ptcb;
+        OS_SchedRRUpdate(prio);
+    }
+#endif
+
     ptcb->OSTCBDly      = 0;                            /* Prevent OSTimeTick() from updating          */
     ptcb->OSTCBStat     = OS_STAT_RDY;                  /* Prevent task from being resumed             */
     ptcb->OSTCBStatPend = OS_STAT_PEND_OK;
@@ -495,7 +536,13 @@ INT8U  OSTaskDel (INT8U prio)
     }
     OSTaskDelHook(ptcb);                                /* Call user defined hook                      */
     OSTaskCtr--;                                        /* One less task being managed                 */
+#if OS_SCHED_RR_EN > 0
+    if (OSTCBPrioTbl[prio] == ptcb) {                   /* Clear old priority entry if not shared      */
+        OSTCBPrioTbl[prio] = (OS_TCB *)0;
+    }
+#else
     OSTCBPrioTbl[prio] = (OS_TCB *)0;                   /* Clear old priority entry                    */
+#endif
     if (ptcb->OSTCBPrev == (OS_TCB *)0) {               /* Remove from TCB chain                       */
         ptcb->OSTCBNext->OSTCBPrev = (OS_TCB *)0;
         OSTCBList                  = ptcb->OSTCBNext;
@@ -775,7 +822,8 @@ void  OSTaskNameSet (INT8U prio, INT8U *pname, INT8U *perr)
 * Description: This function is called to resume a previously suspended task.  This is the only call that
 *              will remove an explicit task suspension.
 *
-* Arguments  : prio     is the priority of the task to resume.
+* Arguments  : prio     is the priority of the task to resume.  If round-robin tasks share this
+*                       priority, the first suspended task found among them is resumed.
 *
 * Returns    : OS_ERR_NONE                if the requested task is resumed
 *              OS_ERR_PRIO_INVALID        if the priority you specify is higher that the maximum allowed
@@ -790,6 +838,9 @@ void  OSTaskNameSet (INT8U prio, INT8U *pname, INT8U *perr)
 INT8U  OSTaskResume (INT8U prio)
 {
     OS_TCB    *ptcb;
+#if OS_SCHED_RR_EN > 0
+    OS_TCB    *phead;
+#endif
 #if OS_CRITICAL_METHOD == 3                                   /* Storage for CPU status register       */
     OS_CPU_SR  cpu_sr = 0;
 #endif
@@ -811,12 +862,21 @@ INT8U  OSTaskResume (INT8U prio)
         OS_EXIT_CRITICAL();
         return (OS_ERR_TASK_NOT_EXIST);
     }
+#if OS_SCHED_RR_EN > 0
+    phead = ptcb;                                             /* Find a suspended task sharing prio    */
+    while (((ptcb->OSTCBStat & OS_STAT_SUSPEND) == OS_STAT_RDY) && (ptcb->OSTCBRRNext != phead)) {
+        ptcb = ptcb->OSTCBRRNext;
+    }
+#endif
     if ((ptcb->OSTCBStat & OS_STAT_SUSPEND) != OS_STAT_RDY) { /* Task must be suspended                */
         ptcb->OSTCBStat &= ~(INT8U)OS_STAT_SUSPEND;           /* Remove suspension                     */
         if (ptcb->OSTCBStat == OS_STAT_RDY) {                 /* See if task is now ready              */
             if (ptcb->OSTCBDly == 0) {
                 OSRdyGrp               |= ptcb->OSTCBBitY;    /* Yes, Make task ready to run           */
                 OSRdyTbl[ptcb->OSTCBY] |= ptcb->OSTCBBitX;
+#if OS_SCHED_RR_EN > 0
+                OS_SchedRRUpdate(ptcb->OSTCBPrio);
+#endif
                 OS_EXIT_CRITICAL();
                 if (OSRunning == OS_TRUE) {
                     OS_Sched();                               /* Find new highest priority task        */
@@ -933,7 +993,8 @@ INT8U  OSTaskStkChk (INT8U prio, OS_STK_DATA *p_stk_data)
 *
 * Note       : You should use this function with great care.  If you suspend a task that is waiting for
 *              an event (i.e. a message, a semaphore, a queue ...) you will prevent this task from
-*              running when the event arrives.
+*              running when the event arrives.  If round-robin tasks share 'prio', the task that would
+*              run next at that priority is suspended.
 *********************************************************************************************************
 */
 
@@ -983,6 +1044,9 @@ INT8U  OSTaskSuspend (INT8U prio)
         OSRdyGrp &= ~ptcb->OSTCBBitY;
     }
     ptcb->OSTCBStat |= OS_STAT_SUSPEND;                         /* Status of task is 'SUSPENDED'       */
+#if OS_SCHED_RR_EN > 0
+    OS_SchedRRUpdate(prio);                                     /* Let another task run at this prio   */
+#endif
     OS_EXIT_CRITICAL();
     if (self == OS_TRUE) {                                      /* Context switch only if SELF         */
         OS_Sched();                                             /* Find new highest priority task      */
@@ -61,6 +61,9 @@ void  OSTimeDly (INT16U ticks)
             OSRdyGrp &= ~OSTCBCur->OSTCBBitY;
         }
         OSTCBCur->OSTCBDly = ticks;              /* Load ticks in TCB                                  */
+#if OS_SCHED_RR_EN > 0
+        OS_SchedRRUpdate(OSTCBCur->OSTCBPrio);   /* Priority stays ready if shared with a ready task   */
+#endif
         OS_EXIT_CRITICAL();
         OS_Sched();                              /* Find next task to run!                             */
     }
@@ -153,7 +156,9 @@ INT8U  OSTimeDlyHMSM (INT8U hours, INT8U minutes, INT8U seconds, INT16U ms)
 *
 *                  (10 Minutes * 60 + 55 Seconds + 0.35) * 100 ticks/second.
 *
-* Arguments  : prio                      specifies the priority of the task to resume
+* Arguments  : prio                      specifies the priority of the task to resume.  If round-robin
+*                                        tasks share this priority, the first delayed task found among
+*                                        them is resumed.
 *
 * Returns    : OS_ERR_NONE               Task has been resumed
 *              OS_ERR_PRIO_INVALID       if the priority you specify is higher that the maximum allowed
@@ -167,6 +172,9 @@ INT8U  OSTimeDlyHMSM (INT8U hours, INT8U minutes, INT8U seconds, INT16U ms)
 INT8U  OSTimeDlyResume (INT8U prio)
 {
     OS_TCB    *ptcb;
+#if OS_SCHED_RR_EN > 0
+    OS_TCB    *phead;
+#endif
 #if OS_CRITICAL_METHOD == 3                                    /* Storage for CPU status register      */
     OS_CPU_SR  cpu_sr = 0;
 #endif
@@ -186,6 +194,12 @@ INT8U  OSTimeDlyResume (INT8U prio)
         OS_EXIT_CRITICAL();
         return (OS_ERR_TASK_NOT_EXIST);                        /* The task does not exist              */
     }
+#if OS_SCHED_RR_EN > 0
+    phead = ptcb;                                              /* Find a delayed task sharing prio     */
+    while ((ptcb->OSTCBDly == 0) && (ptcb->OSTCBRRNext != phead)) {
+        ptcb = ptcb->OSTCBRRNext;
+    }
+#endif
     if (ptcb->OSTCBDly == 0) {                                 /* See if task is delayed               */
         OS_EXIT_CRITICAL();
         return (OS_ERR_TIME_NOT_DLY);                          /* Indicate that task was not delayed   */
@@ -201,6 +215,9 @@ INT8U  OSTimeDlyResume (INT8U prio)
     if ((ptcb->OSTCBStat & OS_STAT_SUSPEND) == OS_STAT_RDY) {  /* Is task suspended?                   */
         OSRdyGrp               |= ptcb->OSTCBBitY;             /* No,  Make ready                      */
         OSRdyTbl[ptcb->OSTCBY] |= ptcb->OSTCBBitX;
+#if OS_SCHED_RR_EN > 0
+        OS_SchedRRUpdate(ptcb->OSTCBPrio);
+#endif
         OS_EXIT_CRITICAL();
         OS_Sched();                                            /* See if this is new highest priority  */
     } else {
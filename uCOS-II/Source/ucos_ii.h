@@ -69,11 +69,19 @@ extern "C" {
 
 #define  OS_PRIO_SELF              0xFFu                /* Indicate SELF priority                      */
 
+#if OS_DPC_EN > 0
+#if OS_TASK_STAT_EN > 0
+#define  OS_N_SYS_TASKS               3u                /* Number of system tasks                      */
+#else
+#define  OS_N_SYS_TASKS               2u
+#endif
+#else
 #if OS_TASK_STAT_EN > 0
 #define  OS_N_SYS_TASKS               2u                /* Number of system tasks                      */
 #else
 #define  OS_N_SYS_TASKS               1u
 #endif
+#endif
 
 #define  OS_TASK_STAT_PRIO  (OS_LOWEST_PRIO - 1)        /* Statistic task priority                     */
 #define  OS_TASK_IDLE_PRIO  (OS_LOWEST_PRIO)            /* IDLE      task priority                     */
@@ -89,8 +97,9 @@ extern "C" {
 #define  OS_TASK_IDLE_ID          65535u                /* ID numbers for Idle, Stat and Timer tasks   */
 #define  OS_TASK_STAT_ID          65534u
 #define  OS_TASK_TMR_ID           65533u
+#define  OS_TASK_DPC_ID           65532u
 
-#define  OS_EVENT_EN           (((OS_Q_EN > 0) && (OS_MAX_QS > 0)) || (OS_MBOX_EN > 0) || (OS_SEM_EN > 0) || (OS_MUTEX_EN > 0))
+#define  OS_EVENT_EN           (((OS_Q_EN > 0) && (OS_MAX_QS > 0)) || (OS_MBOX_EN > 0) || (OS_SEM_EN > 0) || (OS_MUTEX_EN > 0) || (OS_RWLOCK_EN > 0))
 
 #define  OS_TCB_RESERVED        ((OS_TCB *)1)
 
@@ -107,9 +116,10 @@ extern "C" {
 #define  OS_STAT_SUSPEND           0x08u    /* Task is suspended                                       */
 #define  OS_STAT_MUTEX             0x10u    /* Pending on mutual exclusion semaphore                   */
 #define  OS_STAT_FLAG              0x20u    /* Pending on event flag group                             */
+#define  OS_STAT_RWLOCK            0x40u    /* Pending on reader-writer lock                           */
 #define  OS_STAT_MULTI             0x80u    /* Pending on multiple events                              */
 
-#define  OS_STAT_PEND_ANY         (OS_STAT_SEM | OS_STAT_MBOX | OS_STAT_Q | OS_STAT_MUTEX | OS_STAT_FLAG)
+#define  OS_STAT_PEND_ANY         (OS_STAT_SEM | OS_STAT_MBOX | OS_STAT_Q | OS_STAT_MUTEX | OS_STAT_FLAG | OS_STAT_RWLOCK)
 
 /*
 *********************************************************************************************************
@@ -131,6 +141,7 @@ extern "C" {
 #define  OS_EVENT_TYPE_SEM            3u
 #define  OS_EVENT_TYPE_MUTEX          4u
 #define  OS_EVENT_TYPE_FLAG           5u
+#define  OS_EVENT_TYPE_RWLOCK         6u
 
 #define  OS_TMR_TYPE                100u    /* Used to identify Timers ...                             */
                                             /* ... (Must be different value than OS_EVENT_TYPE_xxx)    */
@@ -212,6 +223,7 @@ extern "C" {
 #define  OS_TASK_OPT_STK_CHK     0x0001u    /* Enable stack checking for the task                      */
 #define  OS_TASK_OPT_STK_CLR     0x0002u    /* Clear the stack when the task is create                 */
 #define  OS_TASK_OPT_SAVE_FP     0x0004u    /* Save the contents of any floating-point registers       */
+#define  OS_TASK_OPT_SCHED_RR    0x0008u    /* Share the priority with other round-robin tasks         */
 
 /*
 *********************************************************************************************************
@@ -287,6 +299,7 @@ extern "C" {
 #define OS_ERR_TASK_SUSPEND_IDLE     71u
 #define OS_ERR_TASK_SUSPEND_PRIO     72u
 #define OS_ERR_TASK_WAITING          73u
+#define OS_ERR_TASK_RR_SHARED        74u
 
 #define OS_ERR_TIME_NOT_DLY          80u
 #define OS_ERR_TIME_INVALID_MINUTES  81u
@@ -332,6 +345,12 @@ extern "C" {
 #define OS_ERR_TMR_STOPPED          142u
 #define OS_ERR_TMR_NO_CALLBACK      143u
 
+#define OS_ERR_DPC_Q_FULL           150u
+#define OS_ERR_DPC_FNCT_NULL        151u
+
+#define OS_ERR_RWLOCK_NOT_OWNER     160u
+#define OS_ERR_RWLOCK_NOT_RD        161u
+
 /*
 *********************************************************************************************************
 *                                    OLD ERROR CODE NAMES (< V2.84)
@@ -522,6 +541,27 @@ typedef struct os_mutex_data {
 } OS_MUTEX_DATA;
 #endif
 
+/*
+*********************************************************************************************************
+*                                         READER-WRITER LOCK DATA
+*********************************************************************************************************
+*/
+
+#if OS_RWLOCK_EN > 0
+typedef struct os_rwlock_data {
+#if OS_LOWEST_PRIO <= 63
+    INT8U   OSEventTbl[OS_EVENT_TBL_SIZE];  /* List of tasks waiting for event to occur                */
+    INT8U   OSEventGrp;                     /* Group corresponding to tasks waiting for event to occur */
+#else
+    INT16U  OSEventTbl[OS_EVENT_TBL_SIZE];  /* List of tasks waiting for event to occur                */
+    INT16U  OSEventGrp;                     /* Group corresponding to tasks waiting for event to occur */
+#endif
+    INT8U   OSNbrReaders;                   /* Number of tasks holding the lock for reading            */
+    INT8U   OSWriterPrio;                   /* Priority of the writer owning the lock or 0xFF if none  */
+    INT8U   OSNbrWritersWait;               /* Number of tasks waiting to write-lock the lock          */
+} OS_RWLOCK_DATA;
+#endif
+
 /*
 *********************************************************************************************************
 *                                          MESSAGE QUEUE DATA
@@ -645,6 +685,21 @@ typedef struct os_tcb {
     INT8U            OSTCBDelReq;           /* Indicates whether a task needs to delete itself         */
 #endif
 
+#if (OS_MUTEX_EN > 0) && (OS_MUTEX_CEILING_EN > 0)
+    INT8U            OSTCBMutexCtr;         /* Number of mutexes held by the task (priority ceiling)   */
+    INT8U            OSTCBBasePrio;         /* Priority held before acquiring the first mutex          */
+#endif
+
+#if OS_RWLOCK_EN > 0
+    BOOLEAN          OSTCBRWLockWr;         /* Task waits to write-lock (OS_TRUE) or read-lock a lock  */
+#endif
+
+#if OS_SCHED_RR_EN > 0
+    struct os_tcb   *OSTCBRRNext;           /* Pointer to next     TCB sharing the same priority       */
+    struct os_tcb   *OSTCBRRPrev;           /* Pointer to previous TCB sharing the same priority       */
+    INT16U           OSTCBRRCtr;            /* Nbr ticks left in the task's round-robin time quantum   */
+#endif
+
 #if OS_TASK_PROFILE_EN > 0
     INT32U           OSTCBCtxSwCtr;         /* Number of time the task was switched in                 */
     INT32U           OSTCBCyclesTot;        /* Total number of clock cycles the task has been running  */
@@ -658,6 +713,22 @@ typedef struct os_tcb {
 #endif
 } OS_TCB;
 
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                 DEFERRED PROCEDURE CALL DATA TYPES
+*********************************************************************************************************
+*/
+
+#if OS_DPC_EN > 0
+typedef  void (*OS_DPC_FNCT)(void *p_arg);
+
+typedef  struct  os_dpc {
+    OS_DPC_FNCT      OSDPCFnct;             /* Function to call from the DPC task                      */
+    void            *OSDPCArg;              /* Argument to pass to the function                        */
+} OS_DPC;
+#endif
+
 /*$PAGE*/
 /*
 ************************************************************************************************************************
@@ -716,6 +787,15 @@ OS_EXT  OS_FLAG_GRP       OSFlagTbl[OS_MAX_FLAGS];  /* Table containing event fl
 OS_EXT  OS_FLAG_GRP      *OSFlagFreeList;           /* Pointer to free list of event flag groups       */
 #endif
 
+#if OS_DPC_EN > 0
+OS_EXT  OS_DPC            OSDPCTbl[OS_DPC_Q_SIZE];  /* Queue of deferred procedure calls               */
+OS_EXT  volatile  INT8U   OSDPCIn;                  /* Index of next entry to fill  (ISR side)         */
+OS_EXT  volatile  INT8U   OSDPCOut;                 /* Index of next entry to run   (DPC task side)    */
+OS_EXT  INT16U            OSDPCOvfCtr;              /* Number of calls lost because the queue was full */
+OS_EXT  OS_EVENT          OSDPCEvent;               /* DPC task waits here while the queue is empty    */
+OS_EXT  OS_STK            OSTaskDPCStk[OS_TASK_DPC_STK_SIZE];        /* DPC task stack                 */
+#endif
+
 #if OS_TASK_STAT_EN > 0
 OS_EXT  INT8U             OSCPUUsage;               /* Percentage of CPU used                          */
 OS_EXT  INT32U            OSIdleCtrMax;             /* Max. value that idle ctr can take in 1 sec.     */
@@ -755,6 +835,10 @@ OS_EXT  OS_TCB           *OSTCBList;                       /* Pointer to doubly
 OS_EXT  OS_TCB           *OSTCBPrioTbl[OS_LOWEST_PRIO + 1];/* Table of pointers to created TCBs        */
 OS_EXT  OS_TCB            OSTCBTbl[OS_MAX_TASKS + OS_N_SYS_TASKS];   /* Table of TCBs                  */
 
+#if OS_SCHED_RR_EN > 0
+OS_EXT  OS_TCB           *OSTCBEventRdy;                   /* TCB readied by last OS_EventTaskRdy()    */
+#endif
+
 #if OS_TICK_STEP_EN > 0
 OS_EXT  INT8U             OSTickStepState;          /* Indicates the state of the tick step feature    */
 #endif
@@ -994,6 +1078,42 @@ INT8U         OSMutexQuery            (OS_EVENT        *pevent,
 
 #endif
 
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                       READER-WRITER LOCK MANAGEMENT
+*********************************************************************************************************
+*/
+
+#if OS_RWLOCK_EN > 0
+
+OS_EVENT     *OSRWLockCreate          (void);
+
+#if OS_RWLOCK_DEL_EN > 0
+OS_EVENT     *OSRWLockDel             (OS_EVENT        *pevent,
+                                       INT8U            opt,
+                                       INT8U           *perr);
+#endif
+
+void          OSRWLockPendRd          (OS_EVENT        *pevent,
+                                       INT16U           timeout,
+                                       INT8U           *perr);
+
+void          OSRWLockPendWr          (OS_EVENT        *pevent,
+                                       INT16U           timeout,
+                                       INT8U           *perr);
+
+INT8U         OSRWLockPostRd          (OS_EVENT        *pevent);
+
+INT8U         OSRWLockPostWr          (OS_EVENT        *pevent);
+
+#if OS_RWLOCK_QUERY_EN > 0
+INT8U         OSRWLockQuery           (OS_EVENT        *pevent,
+                                       OS_RWLOCK_DATA  *p_rwlock_data);
+#endif
+
+#endif
+
 /*$PAGE*/
 /*
 *********************************************************************************************************
@@ -1248,6 +1368,11 @@ void          OSStatInit              (void);
 
 INT16U        OSVersion               (void);
 
+#if OS_DPC_EN > 0
+INT8U         OSDPCPost               (OS_DPC_FNCT      fnct,
+                                       void            *p_arg);
+#endif
+
 /*$PAGE*/
 /*
 *********************************************************************************************************
@@ -1286,6 +1411,10 @@ void          OS_FlagInit             (void);
 void          OS_FlagUnlink           (OS_FLAG_NODE    *pnode);
 #endif
 
+#if OS_RWLOCK_EN > 0
+void          OS_RWLockUnlink         (OS_TCB          *ptcb);
+#endif
+
 void          OS_MemClr               (INT8U           *pdest,
                                        INT16U           size);
 
@@ -1303,6 +1432,10 @@ void          OS_QInit                (void);
 
 void          OS_Sched                (void);
 
+#if OS_SCHED_RR_EN > 0
+void          OS_SchedRRUpdate        (INT8U            prio);
+#endif
+
 #if (OS_EVENT_NAME_SIZE > 1) || (OS_FLAG_NAME_SIZE > 1) || (OS_MEM_NAME_SIZE > 1) || (OS_TASK_NAME_SIZE > 1)
 INT8U         OS_StrCopy              (INT8U           *pdest,
                                        INT8U           *psrc);
@@ -1310,6 +1443,10 @@ INT8U         OS_StrCopy              (INT8U           *pdest,
 INT8U         OS_StrLen               (INT8U           *psrc);
 #endif
 
+#if OS_DPC_EN > 0
+void          OS_TaskDPC              (void            *p_arg);
+#endif
+
 void          OS_TaskIdle             (void            *p_arg);
 
 #if OS_TASK_STAT_EN > 0
@@ -1549,6 +1686,28 @@ void          OSCtxSw                 (void);
     #ifndef OS_MUTEX_QUERY_EN
     #error  "OS_CFG.H, Missing OS_MUTEX_QUERY_EN: Include code for OSMutexQuery()"
     #endif
+
+    #ifndef OS_MUTEX_CEILING_EN
+    #error  "OS_CFG.H, Missing OS_MUTEX_CEILING_EN: Raise the mutex owner to the PIP when it acquires the mutex"
+    #endif
+#endif
+
+/*
+*********************************************************************************************************
+*                                           READER-WRITER LOCKS
+*********************************************************************************************************
+*/
+
+#ifndef OS_RWLOCK_EN
+#error  "OS_CFG.H, Missing OS_RWLOCK_EN: Enable (1) or Disable (0) code generation for READER-WRITER LOCKS"
+#else
+    #ifndef OS_RWLOCK_DEL_EN
+    #error  "OS_CFG.H, Missing OS_RWLOCK_DEL_EN: Include code for OSRWLockDel()"
+    #endif
+
+    #ifndef OS_RWLOCK_QUERY_EN
+    #error  "OS_CFG.H, Missing OS_RWLOCK_QUERY_EN: Include code for OSRWLockQuery()"
+    #endif
 #endif
 
 /*
@@ -1698,6 +1857,22 @@ void          OSCtxSw                 (void);
 #error  "OS_CFG.H, Missing OS_TASK_QUERY_EN: Include code for OSTaskQuery()"
 #endif
 
+#ifndef OS_SCHED_RR_EN
+#error  "OS_CFG.H, Missing OS_SCHED_RR_EN: Enable (1) round-robin scheduling of tasks sharing a priority"
+#elif   OS_SCHED_RR_EN > 0
+    #if     OS_TASK_CREATE_EXT_EN == 0
+    #error  "OS_CFG.H, OSTaskCreateExt() is required (set OS_TASK_CREATE_EXT_EN to 1) when enabling round-robin."
+    #endif
+
+    #ifndef OS_SCHED_RR_QUANTA
+    #error  "OS_CFG.H, Missing OS_SCHED_RR_QUANTA: Round-robin time quantum (# of ticks, 1 .. 65535)"
+    #else
+        #if OS_SCHED_RR_QUANTA < 1
+        #error  "OS_CFG.H, OS_SCHED_RR_QUANTA should be between 1 and 65535"
+        #endif
+    #endif
+#endif
+
 /*
 *********************************************************************************************************
 *                                             TIME MANAGEMENT
@@ -1720,6 +1895,40 @@ void          OSCtxSw                 (void);
 #error  "OS_CFG.H, Missing OS_TIME_GET_SET_EN: Include code for OSTimeGet() and OSTimeSet()"
 #endif
 
+/*
+*********************************************************************************************************
+*                                       DEFERRED PROCEDURE CALLS
+*********************************************************************************************************
+*/
+
+#ifndef OS_DPC_EN
+#error  "OS_CFG.H, Missing OS_DPC_EN: When (1) enables code generation for Deferred Procedure Calls"
+#elif   OS_DPC_EN > 0
+    #ifndef OS_DPC_Q_SIZE
+    #error  "OS_CFG.H, Missing OS_DPC_Q_SIZE: Determines the number of entries in the DPC queue (2 .. 255)"
+    #else
+        #if OS_DPC_Q_SIZE < 2
+        #error  "OS_CFG.H, OS_DPC_Q_SIZE should be between 2 and 255"
+        #endif
+
+        #if OS_DPC_Q_SIZE > 255
+        #error  "OS_CFG.H, OS_DPC_Q_SIZE should be between 2 and 255"
+        #endif
+    #endif
+
+    #ifndef OS_TASK_DPC_STK_SIZE
+    #error  "OS_CFG.H, Missing OS_TASK_DPC_STK_SIZE: Determines the size of the DPC Task's stack"
+    #endif
+
+    #ifndef OS_TASK_DPC_PRIO
+    #error  "APP_CFG.H, Missing OS_TASK_DPC_PRIO: Sets the priority of the DPC Task (should be the highest)"
+    #endif
+
+    #if !(OS_EVENT_EN)
+    #error  "OS_CFG.H, OS_DPC_EN requires an event service (OS_SEM_EN, OS_MBOX_EN, OS_Q_EN, OS_MUTEX_EN ...)"
+    #endif
+#endif
+
 /*
 *********************************************************************************************************
 *                                             TIMER MANAGEMENT